@@ -7,11 +7,14 @@ deqp_dir := $(LOCAL_PATH)/
 LOCAL_MODULE_TAGS := tests
 LOCAL_MODULE := libdeqp
 LOCAL_SRC_FILES := \
+	execserver/xsCompression.cpp \
 	execserver/xsDefs.cpp \
 	execserver/xsExecutionServer.cpp \
+	execserver/xsIoReactor.cpp \
 	execserver/xsPosixFileReader.cpp \
 	execserver/xsPosixTestProcess.cpp \
 	execserver/xsProtocol.cpp \
+	execserver/xsSendQueue.cpp \
 	execserver/xsTcpServer.cpp \
 	execserver/xsTestDriver.cpp \
 	execserver/xsTestProcess.cpp \
@@ -22,10 +25,13 @@ LOCAL_SRC_FILES := \
 	executor/xeContainerFormatParser.cpp \
 	executor/xeDefs.cpp \
 	executor/xeLocalTcpIpLink.cpp \
+	executor/xeParallelTestLogParser.cpp \
+	executor/xeSampleListFile.cpp \
 	executor/xeTcpIpLink.cpp \
 	executor/xeTestCase.cpp \
 	executor/xeTestCaseListParser.cpp \
 	executor/xeTestCaseResult.cpp \
+	executor/xeTestLogIndex.cpp \
 	executor/xeTestLogParser.cpp \
 	executor/xeTestLogWriter.cpp \
 	executor/xeTestResultParser.cpp \
@@ -63,6 +69,8 @@ LOCAL_SRC_FILES := \
 	framework/common/tcuTextureUtil.cpp \
 	framework/common/tcuTexVerifierUtil.cpp \
 	framework/common/tcuThreadUtil.cpp \
+	framework/common/tcuTiledVerifier.cpp \
+	framework/common/tcuWorkerPool.cpp \
 	framework/delibs/debase/deDefs.c \
 	framework/delibs/debase/deFloat16.c \
 	framework/delibs/debase/deInt32.c \
@@ -94,6 +102,7 @@ LOCAL_SRC_FILES := \
 	framework/delibs/decpp/deThreadLocal.cpp \
 	framework/delibs/decpp/deThreadSafeRingBuffer.cpp \
 	framework/delibs/decpp/deUniquePtr.cpp \
+	framework/delibs/decpp/deWorkerPool.cpp \
 	framework/delibs/deimage/deImage.c \
 	framework/delibs/deimage/deTarga.c \
 	framework/delibs/depool/deMemPool.c \
@@ -466,6 +475,7 @@ LOCAL_SRC_FILES := \
 	modules/glshared/glsShaderExecUtil.cpp \
 	modules/glshared/glsShaderLibraryCase.cpp \
 	modules/glshared/glsShaderLibrary.cpp \
+	modules/glshared/glsShaderLibraryCache.cpp \
 	modules/glshared/glsShaderPerformanceCase.cpp \
 	modules/glshared/glsShaderPerformanceMeasurer.cpp \
 	modules/glshared/glsShaderRenderCase.cpp \
@@ -479,6 +489,7 @@ LOCAL_SRC_FILES := \
 	modules/internal/ditFrameworkTests.cpp \
 	modules/internal/ditImageCompareTests.cpp \
 	modules/internal/ditImageIOTests.cpp \
+	modules/internal/ditReferenceRendererTests.cpp \
 	modules/internal/ditTestCase.cpp \
 	modules/internal/ditTestLogTests.cpp \
 	modules/internal/ditTestPackage.cpp \
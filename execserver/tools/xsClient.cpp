@@ -136,7 +136,10 @@ Message* readMessage (de::Socket& socket)
 class CommandLine
 {
 public:
+						CommandLine		(void) : slot(-1) {}
+
 	de::SocketAddress	address;
+	int					slot;
 	std::string			program;
 	std::string			params;
 	std::string			workingDir;
@@ -178,6 +181,13 @@ void Client::run (void)
 
 	printf("  writing to %s\n", m_cmdLine.dstFileName.c_str());
 
+	// Request specific execution slot.
+	if (m_cmdLine.slot >= 0)
+	{
+		sendMessage(m_socket, SelectSlotMessage(m_cmdLine.slot));
+		printf("  requested execution slot %d.\n", m_cmdLine.slot);
+	}
+
 	// Send execution request.
 	{
 		ExecuteBinaryMessage msg;
@@ -296,6 +306,7 @@ void printHelp (const char* binName)
 	printf("  --workdir=[dir]        Working directory\n");
 	printf("  --caselist=[caselist]  Test case list\n");
 	printf("  --out=filename         Test result file\n");
+	printf("  --slot=[slot]          Use execution slot [slot]\n");
 }
 
 int runClient (int argc, const char* const* argv)
@@ -326,6 +337,8 @@ int runClient (int argc, const char* const* argv)
 			cmdLine.caseList = parseString(arg+11);
 		else if  (deStringBeginsWith(arg, "--out="))
 			cmdLine.dstFileName = parseString(arg+6);
+		else if (deStringBeginsWith(arg, "--slot="))
+			cmdLine.slot = atoi(arg+7);
 		else
 		{
 			printHelp(argv[0]);
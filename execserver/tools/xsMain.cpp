@@ -23,6 +23,7 @@
 
 #include "xsExecutionServer.hpp"
 #include "deString.h"
+#include "deStringUtil.hpp"
 
 #if (DE_OS == DE_OS_WIN32)
 #	include "xsWin32TestProcess.hpp"
@@ -32,17 +33,21 @@
 
 #include <cstdlib>
 #include <cstdio>
+#include <vector>
+
+#if (DE_OS == DE_OS_WIN32)
+typedef xs::Win32TestProcess	PlatformTestProcess;
+#else
+typedef xs::PosixTestProcess	PlatformTestProcess;
+#endif
 
 int main (int argc, const char* const* argv)
 {
 	xs::ExecutionServer::RunMode	runMode		= xs::ExecutionServer::RUNMODE_FOREVER;
 	int								port		= 50016;
-
-#if (DE_OS == DE_OS_WIN32)
-	xs::Win32TestProcess			testProcess;
-#else
-	xs::PosixTestProcess			testProcess;
-#endif
+	int								numSlots	= 1;
+	std::vector<xs::TestProcess*>	testProcesses;
+	int								exitCode	= 0;
 
 	DE_STATIC_ASSERT(sizeof("a") == 2);
 
@@ -60,19 +65,32 @@ int main (int argc, const char* const* argv)
 			port = atoi(arg+sizeof("--port=")-1);
 		else if (deStringEqual(arg, "--single"))
 			runMode = xs::ExecutionServer::RUNMODE_SINGLE_EXEC;
+		else if (deStringBeginsWith(arg, "--slots="))
+			numSlots = de::max(1, atoi(arg+sizeof("--slots=")-1));
 	}
 
 	try
 	{
-		xs::ExecutionServer server(&testProcess, DE_SOCKETFAMILY_INET4, port, runMode);
-		printf("Listening on port %d.\n", port);
+		// Each slot writes its own log file so that slots can share working directory.
+		for (int slotNdx = 0; slotNdx < numSlots; slotNdx++)
+		{
+			const std::string logFileName = slotNdx == 0 ? std::string("TestResults.qpa") : "TestResults-" + de::toString(slotNdx) + ".qpa";
+			testProcesses.push_back(DE_NULL);
+			testProcesses.back() = new PlatformTestProcess(logFileName.c_str());
+		}
+
+		xs::ExecutionServer server(testProcesses, DE_SOCKETFAMILY_INET4, port, runMode);
+		printf("Listening on port %d, %d execution slot(s).\n", port, numSlots);
 		server.runServer();
 	}
 	catch (const std::exception& e)
 	{
 		printf("%s\n", e.what());
-		return -1;
+		exitCode = -1;
 	}
 
-	return 0;
+	for (std::vector<xs::TestProcess*>::iterator i = testProcesses.begin(); i != testProcesses.end(); ++i)
+		delete *i;
+
+	return exitCode;
 }
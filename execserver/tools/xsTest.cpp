@@ -24,6 +24,7 @@
 #include "xsDefs.hpp"
 
 #include "xsProtocol.hpp"
+#include "xsCompression.hpp"
 #include "deSocket.hpp"
 #include "deRingBuffer.hpp"
 #include "deFilePath.hpp"
@@ -134,6 +135,8 @@ Message* readMessage (de::Socket& socket)
 		case MESSAGETYPE_INFO:					return new InfoMessage(&messageBuf[0], (int)messageBuf.size());
 		case MESSAGETYPE_PROCESS_LAUNCH_FAILED:	return new ProcessLaunchFailedMessage(&messageBuf[0], (int)messageBuf.size());
 		case MESSAGETYPE_PROCESS_FINISHED:		return new ProcessFinishedMessage(&messageBuf[0], (int)messageBuf.size());
+		case MESSAGETYPE_HELLO_REPLY:			return new HelloReplyMessage(&messageBuf[0], (int)messageBuf.size());
+		case MESSAGETYPE_COMPRESSED_DATA:		return new CompressedDataMessage(&messageBuf[0], (int)messageBuf.size());
 		default:
 			XS_FAIL("Unknown message");
 	}
@@ -275,7 +278,8 @@ bool TestExecutor::runCase (TestCase* testCase)
 	{
 		if (m_testCtx.startServer)
 		{
-			string cmdLine = m_testCtx.serverPath + " --port=" + de::toString(m_testCtx.address.getPort());
+			// \note Two execution slots are needed by concurrent-exec.
+			string cmdLine = m_testCtx.serverPath + " --port=" + de::toString(m_testCtx.address.getPort()) + " --slots=2";
 			serverProc = deProcess_create();
 			XS_CHECK(serverProc);
 
@@ -710,6 +714,162 @@ public:
 	}
 };
 
+class CompressedLogDataTest : public TestCase
+{
+public:
+	enum
+	{
+		NUM_LINES			= 100000,
+		MAX_MESSAGE_SIZE	= 256*1024,
+		NUM_RANDOM_BYTES	= 3*MAX_MESSAGE_SIZE
+	};
+
+	CompressedLogDataTest (TestContext& testCtx)
+		: TestCase(testCtx, "compressed-logdata")
+	{
+	}
+
+	void runClient (de::Socket& socket)
+	{
+		// Negotiate compression and larger messages.
+		{
+			HelloMessage hello;
+			hello.features			= PROTOCOL_FEATURE_COMPRESSION;
+			hello.maxMessageSize	= MAX_MESSAGE_SIZE;
+			sendMessage(socket, hello);
+		}
+
+		xs::ExecuteBinaryMessage execMsg;
+		execMsg.name		= m_testCtx.testerPath;
+		execMsg.params		= "--program=compressed-logdata";
+		execMsg.caseList	= "";
+		execMsg.workDir		= "";
+
+		sendMessage(socket, execMsg);
+
+		const int			timeout				= 30000; // 30s.
+		TestClock			clock;
+		DataDecompressor	decompressor;
+		vector<deUint8>		decompressed;
+
+		bool				gotHelloReply		= false;
+		bool				gotProcessStarted	= false;
+		bool				gotProcessFinished	= false;
+		std::string			receivedData;
+		int					numCompressedBytes	= 0;
+		int					maxChunkSize		= 0;
+
+		for (;;)
+		{
+			if (clock.getMilliseconds() > timeout)
+				break;
+
+			ScopedMsgPtr msg(readMessage(socket));
+
+			if (msg->type == MESSAGETYPE_HELLO_REPLY)
+			{
+				const HelloReplyMessage* reply = static_cast<const HelloReplyMessage*>(msg.get());
+
+				if ((reply->features & PROTOCOL_FEATURE_COMPRESSION) == 0)
+					XS_FAIL("Server didn't enable compression");
+
+				if (reply->maxMessageSize != MAX_MESSAGE_SIZE)
+					XS_FAIL("Server didn't accept message size");
+
+				gotHelloReply = true;
+			}
+			else if (msg->type == MESSAGETYPE_PROCESS_STARTED)
+				gotProcessStarted = true;
+			else if (msg->type == MESSAGETYPE_PROCESS_LAUNCH_FAILED)
+				XS_FAIL("Got PROCESS_LAUNCH_FAILED");
+			else if (gotProcessStarted && msg->type == MESSAGETYPE_COMPRESSED_DATA)
+			{
+				const CompressedDataMessage* dataMsg = static_cast<const CompressedDataMessage*>(msg.get());
+
+				XS_CHECK(!dataMsg->data.empty());
+				numCompressedBytes += (int)dataMsg->data.size();
+
+				// Compression overhead must not push message over negotiated size.
+				if (CompressedDataMessage::HEADER_SIZE + (int)dataMsg->data.size() > MAX_MESSAGE_SIZE)
+					XS_FAIL("Compressed message exceeds max message size");
+
+				decompressor.decompress(&dataMsg->data[0], (int)dataMsg->data.size(), decompressed);
+
+				// Payload is terminated with 0 like in uncompressed messages.
+				XS_CHECK(!decompressed.empty() && decompressed.back() == 0);
+
+				if (dataMsg->dataType == MESSAGETYPE_PROCESS_LOG_DATA)
+				{
+					receivedData.append((const char*)&decompressed[0], decompressed.size()-1);
+					maxChunkSize = de::max(maxChunkSize, (int)decompressed.size()-1);
+				}
+			}
+			else if (gotProcessStarted && msg->type == MESSAGETYPE_PROCESS_FINISHED)
+			{
+				gotProcessFinished = true;
+				break;
+			}
+			else if (msg->type == MESSAGETYPE_KEEPALIVE)
+			{
+				sendMessage(socket, KeepAliveMessage());
+				continue;
+			}
+			else
+				XS_FAIL((string("Invalid message: ") + de::toString(msg->type)).c_str());
+		}
+
+		if (!gotHelloReply)
+			XS_FAIL("Did't get HELLO_REPLY message");
+
+		if (!gotProcessStarted)
+			XS_FAIL("Did't get PROCESS_STARTED message");
+
+		if (!gotProcessFinished)
+			XS_FAIL("Did't get PROCESS_FINISHED message");
+
+		if (receivedData != getExpectedData())
+			XS_FAIL("Log data doesn't match");
+
+		if (numCompressedBytes >= (int)receivedData.size())
+			XS_FAIL("Log data wasn't compressed");
+
+		printf("  Received %d bytes as %d compressed bytes, largest message %d bytes\n", (int)receivedData.size(), numCompressedBytes, maxChunkSize);
+	}
+
+	void runProgram (void)
+	{
+		deFile* file = deFile_create(m_testCtx.logFileName.c_str(), DE_FILEMODE_OPEN|DE_FILEMODE_CREATE|DE_FILEMODE_TRUNCATE|DE_FILEMODE_WRITE);
+		XS_CHECK(file);
+
+		const std::string	data		= getExpectedData();
+		deInt64				numWritten	= 0;
+
+		XS_CHECK(deFile_write(file, data.c_str(), (deInt64)data.size(), &numWritten) == DE_FILERESULT_SUCCESS);
+		XS_CHECK(numWritten == (deInt64)data.size());
+
+		deFile_destroy(file);
+	}
+
+private:
+	static std::string getExpectedData (void)
+	{
+		std::string data;
+
+		deRandom	rnd;
+
+		for (int lineNdx = 0; lineNdx < NUM_LINES; lineNdx++)
+			data += "<Number Name=\"Value\" Unit=\"us\">" + de::toString(lineNdx) + "</Number>\n";
+
+		// Incompressible data grows when compressed.
+		deRandom_init(&rnd, 0x5a3c);
+
+		for (int ndx = 0; ndx < NUM_RANDOM_BYTES; ndx++)
+			data += (char)(deRandom_getUint32(&rnd) & 0xff);
+
+		return data;
+	}
+};
+
 class KeepAliveTest : public TestCase
 {
 public:
@@ -812,6 +972,78 @@ public:
 	void runProgram (void) { /* nothing */ }
 };
 
+class ConcurrentExecTest : public TestCase
+{
+public:
+	ConcurrentExecTest (TestContext& testCtx)
+		: TestCase(testCtx, "concurrent-exec")
+	{
+	}
+
+	void runClient (de::Socket& socket)
+	{
+		// Second session uses separate connection. Server must have at least two execution slots.
+		de::Socket secondSocket;
+		secondSocket.connect(m_testCtx.address);
+		secondSocket.setFlags(DE_SOCKET_CLOSE_ON_EXEC);
+
+		// First session asks for second slot, other one gets any free slot.
+		sendMessage(socket, SelectSlotMessage(1));
+
+		startProcess(socket);
+		startProcess(secondSocket);
+
+		waitForFinish(socket);
+		waitForFinish(secondSocket);
+
+		secondSocket.shutdown();
+	}
+
+	void runProgram (void)
+	{
+		// Keep both processes running at the same time.
+		deSleep(500);
+	}
+
+private:
+	void startProcess (de::Socket& socket)
+	{
+		xs::ExecuteBinaryMessage execMsg;
+		execMsg.name		= m_testCtx.testerPath;
+		execMsg.params		= "--program=concurrent-exec";
+		execMsg.caseList	= "";
+		execMsg.workDir		= "";
+
+		sendMessage(socket, execMsg);
+	}
+
+	void waitForFinish (de::Socket& socket)
+	{
+		const int		timeout				= 5000; // 5s.
+		TestClock		clock;
+		bool			gotProcessStarted	= false;
+
+		for (;;)
+		{
+			if (clock.getMilliseconds() > timeout)
+				XS_FAIL("Didn't get PROCESS_FINISHED message");
+
+			ScopedMsgPtr msg(readMessage(socket));
+
+			if (msg->type == MESSAGETYPE_PROCESS_STARTED)
+				gotProcessStarted = true;
+			else if (msg->type == MESSAGETYPE_PROCESS_LAUNCH_FAILED)
+				XS_FAIL("Got PROCESS_LAUNCH_FAILED");
+			else if (gotProcessStarted && msg->type == MESSAGETYPE_PROCESS_FINISHED)
+				break;
+			else if (msg->type == MESSAGETYPE_KEEPALIVE || msg->type == MESSAGETYPE_INFO)
+				continue;
+			else
+				XS_FAIL((string("Invalid message: ") + de::toString(msg->type)).c_str());
+		}
+	}
+};
+
 void printHelp (const char* binName)
 {
 	printf("%s:\n", binName);
@@ -897,6 +1129,8 @@ void runExecServerTests (int argc, const char* const* argv)
 	testCases.push_back(new LogDataTest(testCtx));
 	testCases.push_back(new KeepAliveTest(testCtx));
 	testCases.push_back(new BigLogDataTest(testCtx));
+	testCases.push_back(new CompressedLogDataTest(testCtx));
+	testCases.push_back(new ConcurrentExecTest(testCtx));
 
 	try
 	{
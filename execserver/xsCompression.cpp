@@ -0,0 +1,182 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Execution Server
+ * ---------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Compression of protocol data streams.
+ *//*--------------------------------------------------------------------*/
+
+#include "xsCompression.hpp"
+#include "deMemory.h"
+
+#include <zlib.h>
+#include <new>
+
+using std::vector;
+
+namespace xs
+{
+
+enum
+{
+	COMPRESSION_LEVEL	= 1,		//!< Favor speed, log data compresses well even at lowest level.
+	MIN_OUTPUT_SPACE	= 256,
+	MAX_FLUSH_OVERHEAD	= 16		//!< Stream header and sync flush marker.
+};
+
+// DataCompressor
+
+DataCompressor::DataCompressor (void)
+	: m_stream(new z_stream)
+{
+	deMemset(m_stream, 0, sizeof(z_stream));
+
+	if (deflateInit(m_stream, COMPRESSION_LEVEL) != Z_OK)
+	{
+		delete m_stream;
+		throw std::bad_alloc();
+	}
+}
+
+DataCompressor::~DataCompressor (void)
+{
+	deflateEnd(m_stream);
+	delete m_stream;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Compress block of data
+ * \param src		Data to compress
+ * \param srcSize	Number of bytes in src
+ * \param dst		Destination buffer, grown if necessary
+ * \param dstOffset	Offset in dst where compressed data is written
+ * \return End offset of compressed data in dst
+ *//*--------------------------------------------------------------------*/
+int DataCompressor::compress (const deUint8* src, int srcSize, vector<deUint8>& dst, int dstOffset)
+{
+	int pos = dstOffset;
+
+	m_stream->next_in	= (Bytef*)src;
+	m_stream->avail_in	= (uInt)srcSize;
+
+	if ((int)dst.size() < pos + srcSize/2 + MIN_OUTPUT_SPACE)
+		dst.resize(pos + srcSize/2 + MIN_OUTPUT_SPACE);
+
+	for (;;)
+	{
+		m_stream->next_out	= &dst[pos];
+		m_stream->avail_out	= (uInt)(dst.size() - pos);
+
+		const int result = deflate(m_stream, Z_SYNC_FLUSH);
+		XS_CHECK_MSG(result == Z_OK || result == Z_BUF_ERROR, "Compression failed");
+
+		pos = (int)dst.size() - (int)m_stream->avail_out;
+
+		// Flush is complete once output space is left over.
+		if (m_stream->avail_out > 0)
+			break;
+
+		dst.resize(dst.size()*2);
+	}
+
+	DE_ASSERT(m_stream->avail_in == 0);
+	return pos;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get upper bound for size of compressed block
+ *
+ * Incompressible data grows when compressed. Bound is the conservative
+ * one used by deflateBound() plus room for stream header and flush marker.
+ *
+ * \param srcSize	Number of bytes to compress
+ * \return Maximum number of bytes compress() may output for srcSize bytes
+ *//*--------------------------------------------------------------------*/
+int DataCompressor::getMaxCompressedSize (int srcSize)
+{
+	return srcSize + ((srcSize + 7) >> 3) + ((srcSize + 63) >> 6) + 5 + MAX_FLUSH_OVERHEAD;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get largest block that always compresses to given size
+ * \param maxCompressedSize	Space available for compressed data
+ * \return Largest srcSize for which getMaxCompressedSize(srcSize) <= maxCompressedSize
+ *//*--------------------------------------------------------------------*/
+int DataCompressor::getMaxSourceSize (int maxCompressedSize)
+{
+	// Bound grows by 73/64 of srcSize, start from estimate and adjust for rounding.
+	int srcSize = de::max(0, (int)((deInt64)(maxCompressedSize - 5 - MAX_FLUSH_OVERHEAD) * 64 / 73));
+
+	while (srcSize > 0 && getMaxCompressedSize(srcSize) > maxCompressedSize)
+		srcSize -= 1;
+
+	return srcSize;
+}
+
+// DataDecompressor
+
+DataDecompressor::DataDecompressor (void)
+	: m_stream(new z_stream)
+{
+	deMemset(m_stream, 0, sizeof(z_stream));
+
+	if (inflateInit(m_stream) != Z_OK)
+	{
+		delete m_stream;
+		throw std::bad_alloc();
+	}
+}
+
+DataDecompressor::~DataDecompressor (void)
+{
+	inflateEnd(m_stream);
+	delete m_stream;
+}
+
+//! Decompress flushed block into dst, which is resized to exactly fit the data. Returns decompressed size.
+int DataDecompressor::decompress (const deUint8* src, int srcSize, vector<deUint8>& dst)
+{
+	int pos = 0;
+
+	m_stream->next_in	= (Bytef*)src;
+	m_stream->avail_in	= (uInt)srcSize;
+
+	if ((int)dst.size() < srcSize*4 + MIN_OUTPUT_SPACE)
+		dst.resize(srcSize*4 + MIN_OUTPUT_SPACE);
+
+	for (;;)
+	{
+		m_stream->next_out	= &dst[pos];
+		m_stream->avail_out	= (uInt)(dst.size() - pos);
+
+		const int result = inflate(m_stream, Z_SYNC_FLUSH);
+		XS_CHECK_MSG(result == Z_OK || result == Z_BUF_ERROR, "Decompression failed");
+
+		pos = (int)dst.size() - (int)m_stream->avail_out;
+
+		if (m_stream->avail_in == 0 && m_stream->avail_out > 0)
+			break;
+
+		dst.resize(dst.size()*2);
+	}
+
+	dst.resize(pos);
+	return pos;
+}
+
+} // xs
@@ -0,0 +1,77 @@
+#ifndef _XSCOMPRESSION_HPP
+#define _XSCOMPRESSION_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Execution Server
+ * ---------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Compression of protocol data streams.
+ *//*--------------------------------------------------------------------*/
+
+#include "xsDefs.hpp"
+
+#include <vector>
+
+typedef struct z_stream_s z_stream;
+
+namespace xs
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Streaming deflate compressor
+ *
+ * All data compressed by one compressor forms a single deflate stream,
+ * so later blocks can refer to earlier ones. Each block is flushed to
+ * a byte boundary and can be decompressed as soon as it is received.
+ *//*--------------------------------------------------------------------*/
+class DataCompressor
+{
+public:
+							DataCompressor		(void);
+							~DataCompressor		(void);
+
+	int						compress			(const deUint8* src, int srcSize, std::vector<deUint8>& dst, int dstOffset);
+
+	static int				getMaxCompressedSize	(int srcSize);
+	static int				getMaxSourceSize		(int maxCompressedSize);
+
+private:
+							DataCompressor		(const DataCompressor& other);
+	DataCompressor&			operator=			(const DataCompressor& other);
+
+	z_stream*				m_stream;
+};
+
+class DataDecompressor
+{
+public:
+							DataDecompressor	(void);
+							~DataDecompressor	(void);
+
+	int						decompress			(const deUint8* src, int srcSize, std::vector<deUint8>& dst);
+
+private:
+							DataDecompressor	(const DataDecompressor& other);
+	DataDecompressor&		operator=			(const DataDecompressor& other);
+
+	z_stream*				m_stream;
+};
+
+} // xs
+
+#endif // _XSCOMPRESSION_HPP
@@ -41,6 +41,7 @@ enum
 
 	SERVER_IDLE_THRESHOLD		= 10,
 	SERVER_IDLE_SLEEP			= 50,
+	SERVER_IO_WAIT_TIMEOUT		= 100,		//!< Max time to block in IoReactor, bounds latency of timeouts and process exit detection.
 	FILEREADER_IDLE_SLEEP		= 100,
 
 	LOG_BUFFER_BLOCK_SIZE		= 1024,
@@ -49,11 +50,11 @@ enum
 	INFO_BUFFER_BLOCK_SIZE		= 64,
 	INFO_BUFFER_NUM_BLOCKS		= 128,
 
-	SEND_BUFFER_SIZE			= 16*1024,
+	SEND_BUFFER_SIZE			= 64*1024,
 	RECV_BUFFER_SIZE			= 4*1024,
 
 	FILEREADER_TMP_BUFFER_SIZE	= 1024,
-	SEND_RECV_TMP_BUFFER_SIZE	= 4*1024,
+	SEND_RECV_TMP_BUFFER_SIZE	= 16*1024,
 
 	MIN_MSG_PAYLOAD_SIZE		= 32
 };
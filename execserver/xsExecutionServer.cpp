@@ -100,28 +100,89 @@ void MessageBuilder::clear (void)
 
 ExecutionServer::ExecutionServer (xs::TestProcess* testProcess, deSocketFamily family, int port, RunMode runMode)
 	: TcpServer		(family, port)
-	, m_testDriver	(testProcess)	
 	, m_runMode		(runMode)
 {
+	initSlots(vector<xs::TestProcess*>(1, testProcess));
+}
+
+ExecutionServer::ExecutionServer (const vector<xs::TestProcess*>& testProcesses, deSocketFamily family, int port, RunMode runMode)
+	: TcpServer		(family, port)
+	, m_runMode		(runMode)
+{
+	initSlots(testProcesses);
 }
 
 ExecutionServer::~ExecutionServer (void)
 {
+	for (vector<TestDriver*>::iterator i = m_testDrivers.begin(); i != m_testDrivers.end(); ++i)
+		delete *i;
 }
 
-TestDriver* ExecutionServer::acquireTestDriver (void)
+void ExecutionServer::initSlots (const vector<xs::TestProcess*>& testProcesses)
 {
-	if (!m_testDriverLock.tryLock())
-		throw Error("Failed to acquire test driver");
+	XS_CHECK(!testProcesses.empty());
+
+	try
+	{
+		for (vector<xs::TestProcess*>::const_iterator i = testProcesses.begin(); i != testProcesses.end(); ++i)
+			m_testDrivers.push_back(new TestDriver(*i));
+	}
+	catch (...)
+	{
+		for (vector<TestDriver*>::iterator i = m_testDrivers.begin(); i != m_testDrivers.end(); ++i)
+			delete *i;
+		throw;
+	}
 
-	return &m_testDriver;
+	m_slotInUse.resize(m_testDrivers.size(), false);
+}
+
+TestDriver* ExecutionServer::acquireTestDriver (int slot)
+{
+	de::ScopedLock lock(m_testDriverLock);
+
+	if (slot == SLOT_ANY)
+	{
+		for (int slotNdx = 0; slotNdx < (int)m_slotInUse.size(); slotNdx++)
+		{
+			if (!m_slotInUse[slotNdx])
+			{
+				slot = slotNdx;
+				break;
+			}
+		}
+
+		if (slot == SLOT_ANY)
+			throw Error("Failed to acquire test driver: all execution slots are in use");
+	}
+	else
+	{
+		if (!de::inBounds(slot, 0, (int)m_slotInUse.size()))
+			throw Error("Failed to acquire test driver: invalid execution slot");
+
+		if (m_slotInUse[slot])
+			throw Error("Failed to acquire test driver: execution slot is in use");
+	}
+
+	m_slotInUse[slot] = true;
+	return m_testDrivers[slot];
 }
 
 void ExecutionServer::releaseTestDriver (TestDriver* driver)
 {
-	DE_ASSERT(&m_testDriver == driver);
-	DE_UNREF(driver);
-	m_testDriverLock.unlock();
+	de::ScopedLock lock(m_testDriverLock);
+
+	for (int slotNdx = 0; slotNdx < (int)m_testDrivers.size(); slotNdx++)
+	{
+		if (m_testDrivers[slotNdx] == driver)
+		{
+			DE_ASSERT(m_slotInUse[slotNdx]);
+			m_slotInUse[slotNdx] = false;
+			return;
+		}
+	}
+
+	DE_ASSERT(false);
 }
 
 ConnectionHandler* ExecutionServer::createHandler (de::Socket* socket, const de::SocketAddress& clientAddress)
@@ -143,13 +204,16 @@ ExecutionRequestHandler::ExecutionRequestHandler (ExecutionServer* server, de::S
 	, m_execServer		(server)
 	, m_testDriver		(DE_NULL)
 	, m_bufferIn		(RECV_BUFFER_SIZE)
-	, m_bufferOut		(SEND_BUFFER_SIZE)
+	, m_sendQueue		(SEND_BUFFER_SIZE)
 	, m_run				(false)
-	, m_sendRecvTmpBuf	(SEND_RECV_TMP_BUFFER_SIZE)
+	, m_recvTmpBuf		(SEND_RECV_TMP_BUFFER_SIZE)
 {
 	// Set flags.
 	m_socket->setFlags(DE_SOCKET_NONBLOCKING|DE_SOCKET_KEEPALIVE|DE_SOCKET_CLOSE_ON_EXEC);
 
+	if (IoReactor::isSupported())
+		m_reactor.addHandle(m_socket->getHandle(), IoReactor::EVENT_READ, IoReactor::SOURCE_CONNECTION);
+
 	// Init protocol keepalives.
 	initKeepAlives();
 }
@@ -157,7 +221,18 @@ ExecutionRequestHandler::ExecutionRequestHandler (ExecutionServer* server, de::S
 ExecutionRequestHandler::~ExecutionRequestHandler (void)
 {
 	if (m_testDriver)
+	{
+		// Test driver must not refer to m_reactor after this.
+		try
+		{
+			m_testDriver->reset();
+			m_testDriver->setIoReactor(DE_NULL);
+		}
+		catch (...)
+		{
+		}
 		m_execServer->releaseTestDriver(m_testDriver);
+	}
 }
 
 void ExecutionRequestHandler::handle (void)
@@ -182,6 +257,7 @@ void ExecutionRequestHandler::handle (void)
 		try
 		{
 			m_testDriver->reset();
+			m_testDriver->setIoReactor(DE_NULL);
 		}
 		catch (...)
 		{
@@ -195,15 +271,18 @@ void ExecutionRequestHandler::handle (void)
 		m_socket->shutdown();
 }
 
-void ExecutionRequestHandler::acquireTestDriver (void)
+void ExecutionRequestHandler::acquireTestDriver (int slot)
 {
 	DE_ASSERT(!m_testDriver);
 
 	// Try to acquire test driver - may fail.
-	m_testDriver = m_execServer->acquireTestDriver();
+	m_testDriver = m_execServer->acquireTestDriver(slot);
 	DE_ASSERT(m_testDriver);
 	m_testDriver->reset();
 
+	// Process output is multiplexed with connection if possible.
+	if (IoReactor::isSupported())
+		m_testDriver->setIoReactor(&m_reactor);
 }
 
 void ExecutionRequestHandler::processSession (void)
@@ -242,13 +321,15 @@ void ExecutionRequestHandler::processSession (void)
 
 		// Poll test driver for IO.
 		if (m_testDriver)
-			anyIO = getTestDriver()->poll(m_bufferOut) || anyIO;
+			anyIO = getTestDriver()->poll(m_sendQueue, m_dataFormat) || anyIO;
 
 		// If no IO happens in a reasonable amount of time, go to sleep.
 		{
 			deUint64 curTime = deGetMicroseconds();
 			if (anyIO)
 				lastIoTime = curTime;
+			else if (IoReactor::isSupported())
+				waitForIo(); // Block until socket or process has data.
 			else if (curTime-lastIoTime > SERVER_IDLE_THRESHOLD*1000)
 				deSleep(SERVER_IDLE_SLEEP); // Too long since last IO, sleep for a while.
 			else
@@ -264,9 +345,10 @@ void ExecutionRequestHandler::processMessage (MessageType type, const deUint8* d
 		case MESSAGETYPE_HELLO:
 		{
 			HelloMessage msg(data, dataSize);
-			DBG_PRINT(("HelloMessage: version = %d\n", msg.version));
-			if (msg.version != PROTOCOL_VERSION)
+			DBG_PRINT(("HelloMessage: version = %d, features = 0x%x, max message size = %d\n", msg.version, msg.features, msg.maxMessageSize));
+			if (!de::inRange<int>(msg.version, MIN_PROTOCOL_VERSION, PROTOCOL_VERSION))
 				throw ProtocolError("Unsupported protocol version");
+			negotiateProtocol(msg);
 			break;
 		}
 
@@ -285,6 +367,16 @@ void ExecutionRequestHandler::processMessage (MessageType type, const deUint8* d
 			break;
 		}
 
+		case MESSAGETYPE_SELECT_SLOT:
+		{
+			SelectSlotMessage msg(data, dataSize);
+			DBG_PRINT(("SelectSlotMessage: %d\n", msg.slot));
+			if (m_testDriver)
+				throw ProtocolError("Execution slot already selected");
+			acquireTestDriver(msg.slot);
+			break;
+		}
+
 		case MESSAGETYPE_EXECUTE_BINARY:
 		{
 			ExecuteBinaryMessage msg(data, dataSize);
@@ -307,6 +399,30 @@ void ExecutionRequestHandler::processMessage (MessageType type, const deUint8* d
 	}
 }
 
+void ExecutionRequestHandler::negotiateProtocol (const HelloMessage& hello)
+{
+	// Versions before 19 don't know about negotiation.
+	if (hello.version < 19)
+		return;
+
+	const deUint32	supportedFeatures	= PROTOCOL_FEATURE_COMPRESSION;
+	const deUint32	features			= hello.features & supportedFeatures;
+	const int		maxMessageSize		= de::clamp<int>(hello.maxMessageSize, MIN_MAX_MESSAGE_SIZE, MAX_MAX_MESSAGE_SIZE);
+
+	if ((features & PROTOCOL_FEATURE_COMPRESSION) != 0 && !m_compressor)
+		m_compressor = de::MovePtr<DataCompressor>(new DataCompressor());
+
+	m_dataFormat.maxMessageSize	= maxMessageSize;
+	m_dataFormat.compressor		= (features & PROTOCOL_FEATURE_COMPRESSION) != 0 ? m_compressor.get() : DE_NULL;
+
+	// Send queue must fit at least a couple of full messages.
+	m_sendQueue.setMaxSize(de::max<int>(SEND_BUFFER_SIZE, 2*maxMessageSize));
+
+	vector<deUint8> buf;
+	HelloReplyMessage(PROTOCOL_VERSION, features, maxMessageSize).write(buf);
+	m_sendQueue.push(buf);
+}
+
 void ExecutionRequestHandler::initKeepAlives (void)
 {
 	deUint64 curTime = deGetMicroseconds();
@@ -329,29 +445,41 @@ void ExecutionRequestHandler::pollKeepAlives (void)
 
 	// Send some?
 	if (curTime - m_lastKeepAliveSent > KEEPALIVE_SEND_INTERVAL*1000 &&
-		m_bufferOut.getNumFree() >= MESSAGE_HEADER_SIZE)
+		m_sendQueue.getNumFree() >= MESSAGE_HEADER_SIZE)
 	{
 		vector<deUint8> buf;
 		KeepAliveMessage().write(buf);
-		m_bufferOut.pushFront(&buf[0], (int)buf.size());
+		m_sendQueue.push(buf);
 
 		m_lastKeepAliveSent = deGetMicroseconds();
 	}
 }
 
+void ExecutionRequestHandler::waitForIo (void)
+{
+	const deUint32 socketEvents = (m_bufferIn.getNumFree() > 0	? (deUint32)IoReactor::EVENT_READ		: 0u)
+								| (m_sendQueue.getNumElements() > 0	? (deUint32)IoReactor::EVENT_WRITE	: 0u);
+
+	// Process output is not interesting until there is room for it in send buffer.
+	m_reactor.setSourceEnabled(IoReactor::SOURCE_PROCESS, m_sendQueue.getNumFree() >= MESSAGE_HEADER_SIZE + MIN_MSG_PAYLOAD_SIZE);
+	m_reactor.setHandleEvents(m_socket->getHandle(), socketEvents);
+
+	m_reactor.wait(SERVER_IO_WAIT_TIMEOUT);
+}
+
 bool ExecutionRequestHandler::receive (void)
 {
-	int maxLen = de::min<int>((int)m_sendRecvTmpBuf.size(), m_bufferIn.getNumFree());
+	int maxLen = de::min<int>((int)m_recvTmpBuf.size(), m_bufferIn.getNumFree());
 
 	if (maxLen > 0)
 	{
 		int				numRecv;
-		deSocketResult	result	= m_socket->receive(&m_sendRecvTmpBuf[0], maxLen, &numRecv);
+		deSocketResult	result	= m_socket->receive(&m_recvTmpBuf[0], maxLen, &numRecv);
 
 		if (result == DE_SOCKETRESULT_SUCCESS)
 		{
 			DE_ASSERT(numRecv > 0);
-			m_bufferIn.pushFront(&m_sendRecvTmpBuf[0], numRecv);
+			m_bufferIn.pushFront(&m_recvTmpBuf[0], numRecv);
 			return true;
 		}
 		else if (result == DE_SOCKETRESULT_CONNECTION_CLOSED)
@@ -372,19 +500,14 @@ bool ExecutionRequestHandler::receive (void)
 
 bool ExecutionRequestHandler::send (void)
 {
-	int maxLen = de::min<int>((int)m_sendRecvTmpBuf.size(), m_bufferOut.getNumElements());
-
-	if (maxLen > 0)
+	if (m_sendQueue.getNumElements() > 0)
 	{
-		m_bufferOut.peekBack(&m_sendRecvTmpBuf[0], maxLen);
-
 		int				numSent;
-		deSocketResult	result	= m_socket->send(&m_sendRecvTmpBuf[0], maxLen, &numSent);
+		deSocketResult	result	= m_sendQueue.send(*m_socket, &numSent);
 
 		if (result == DE_SOCKETRESULT_SUCCESS)
 		{
 			DE_ASSERT(numSent > 0);
-			m_bufferOut.popBack(numSent);
 			return true;
 		}
 		else if (result == DE_SOCKETRESULT_CONNECTION_CLOSED)
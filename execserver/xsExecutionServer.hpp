@@ -28,6 +28,10 @@
 #include "xsTestDriver.hpp"
 #include "xsProtocol.hpp"
 #include "xsTestProcess.hpp"
+#include "xsIoReactor.hpp"
+#include "xsSendQueue.hpp"
+#include "xsCompression.hpp"
+#include "deUniquePtr.hpp"
 
 #include <vector>
 
@@ -45,20 +49,34 @@ public:
 		RUNMODE_LAST
 	};
 
+	enum
+	{
+		SLOT_ANY			= -1	//!< Acquire any free execution slot.
+	};
+
 							ExecutionServer			(xs::TestProcess* testProcess, deSocketFamily family, int port, RunMode runMode);
+							ExecutionServer			(const std::vector<xs::TestProcess*>& testProcesses, deSocketFamily family, int port, RunMode runMode);
 							~ExecutionServer		(void);
 
 	ConnectionHandler*		createHandler			(de::Socket* socket, const de::SocketAddress& clientAddress);
 
-	TestDriver*				acquireTestDriver		(void);
+	int						getNumSlots				(void) const { return (int)m_testDrivers.size(); }
+
+	TestDriver*				acquireTestDriver		(int slot = SLOT_ANY);
 	void					releaseTestDriver		(TestDriver* driver);
 
 	void					connectionDone			(ConnectionHandler* handler);
 
 private:
-	TestDriver				m_testDriver;
-	de::Mutex				m_testDriverLock;
-	RunMode					m_runMode;
+							ExecutionServer			(const ExecutionServer& other);
+	ExecutionServer&		operator=				(const ExecutionServer& other);
+
+	void					initSlots				(const std::vector<xs::TestProcess*>& testProcesses);
+
+	std::vector<TestDriver*>	m_testDrivers;		//!< One test driver per execution slot.
+	std::vector<bool>			m_slotInUse;
+	de::Mutex					m_testDriverLock;	//!< Protects m_slotInUse.
+	RunMode						m_runMode;
 };
 
 class MessageBuilder
@@ -97,9 +115,10 @@ private:
 
 	void						processSession					(void);
 	void						processMessage					(MessageType type, const deUint8* data, int dataSize);
+	void						negotiateProtocol				(const HelloMessage& hello);
 
-	inline TestDriver*			getTestDriver					(void) { if (!m_testDriver) acquireTestDriver(); return m_testDriver; }
-	void						acquireTestDriver				(void);
+	inline TestDriver*			getTestDriver					(void) { if (!m_testDriver) acquireTestDriver(ExecutionServer::SLOT_ANY); return m_testDriver; }
+	void						acquireTestDriver				(int slot);
 
 	void						initKeepAlives					(void);
 	void						keepAliveReceived				(void);
@@ -108,11 +127,18 @@ private:
 	bool						receive							(void);
 	bool						send							(void);
 
+	void						waitForIo						(void);
+
 	ExecutionServer*			m_execServer;
 	TestDriver*					m_testDriver;
 
+	IoReactor					m_reactor;						//!< Used for waiting when IoReactor::isSupported().
+
 	ByteBuffer					m_bufferIn;
-	ByteBuffer					m_bufferOut;
+	SendQueue					m_sendQueue;
+
+	DataMessageFormat			m_dataFormat;
+	de::MovePtr<DataCompressor>	m_compressor;
 
 	bool						m_run;
 	MessageBuilder				m_msgBuilder;
@@ -121,7 +147,7 @@ private:
 	deUint64					m_lastKeepAliveSent;
 	deUint64					m_lastKeepAliveReceived;
 
-	std::vector<deUint8>		m_sendRecvTmpBuf;
+	std::vector<deUint8>		m_recvTmpBuf;
 };
 
 } // xs
@@ -0,0 +1,266 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Execution Server
+ * ---------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief IO readiness multiplexer.
+ *//*--------------------------------------------------------------------*/
+
+#include "xsIoReactor.hpp"
+#include "deMemory.h"
+
+#if (DE_OS == DE_OS_UNIX) || (DE_OS == DE_OS_ANDROID)
+#	define XS_USE_EPOLL 1
+#	include <sys/epoll.h>
+#	include <sys/inotify.h>
+#	include <unistd.h>
+#	include <errno.h>
+#	include <string.h>
+#else
+#	define XS_USE_EPOLL 0
+#endif
+
+namespace xs
+{
+
+enum
+{
+	MAX_EVENTS_PER_WAIT		= 16,
+	FILE_EVENT_BUFFER_SIZE	= 4096
+};
+
+IoReactor::IoReactor (void)
+	: m_epollFd		(-1)
+	, m_inotifyFd	(-1)
+	, m_watchDesc	(-1)
+{
+	for (int ndx = 0; ndx < SOURCE_LAST; ndx++)
+		m_sourceEnabled[ndx] = true;
+
+#if XS_USE_EPOLL
+	m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+	XS_CHECK_MSG(m_epollFd >= 0, "Failed to create epoll instance");
+
+	m_inotifyFd = inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
+	if (m_inotifyFd < 0)
+	{
+		close(m_epollFd);
+		XS_FAIL("Failed to create inotify instance");
+	}
+
+	try
+	{
+		addHandle((deUintptr)m_inotifyFd, EVENT_READ, SOURCE_PROCESS);
+	}
+	catch (...)
+	{
+		close(m_inotifyFd);
+		close(m_epollFd);
+		throw;
+	}
+#endif
+}
+
+IoReactor::~IoReactor (void)
+{
+#if XS_USE_EPOLL
+	close(m_inotifyFd);
+	close(m_epollFd);
+#endif
+}
+
+bool IoReactor::isSupported (void)
+{
+	return XS_USE_EPOLL != 0;
+}
+
+void IoReactor::addHandle (deUintptr handle, deUint32 events, Source source)
+{
+	DE_ASSERT(m_handles.find(handle) == m_handles.end());
+
+	HandleInfo& info = m_handles[handle];
+	info.events	= events;
+	info.source	= source;
+
+	updateHandle(handle, info);
+}
+
+void IoReactor::setHandleEvents (deUintptr handle, deUint32 events)
+{
+	HandleMap::iterator pos = m_handles.find(handle);
+	DE_ASSERT(pos != m_handles.end());
+
+	if (pos->second.events != events)
+	{
+		pos->second.events = events;
+		updateHandle(handle, pos->second);
+	}
+}
+
+void IoReactor::removeHandle (deUintptr handle)
+{
+	HandleMap::iterator pos = m_handles.find(handle);
+	DE_ASSERT(pos != m_handles.end());
+
+	pos->second.events = 0;
+	updateHandle(handle, pos->second);
+
+	m_handles.erase(pos);
+}
+
+void IoReactor::setSourceEnabled (Source source, bool enabled)
+{
+	if (m_sourceEnabled[source] == enabled)
+		return;
+
+	m_sourceEnabled[source] = enabled;
+
+	for (HandleMap::iterator iter = m_handles.begin(); iter != m_handles.end(); ++iter)
+	{
+		if (iter->second.source == source)
+			updateHandle(iter->first, iter->second);
+	}
+}
+
+void IoReactor::updateHandle (deUintptr handle, HandleInfo& info)
+{
+#if XS_USE_EPOLL
+	// \note Disabled handles are removed from epoll set, since hangup is reported regardless of requested events.
+	const bool	shouldRegister	= m_sourceEnabled[info.source] && info.events != 0;
+	const int	fd				= (int)handle;
+
+	if (shouldRegister)
+	{
+		struct epoll_event event;
+		deMemset(&event, 0, sizeof(event));
+
+		event.events	= ((info.events & EVENT_READ) ? EPOLLIN : 0u) | ((info.events & EVENT_WRITE) ? EPOLLOUT : 0u);
+		event.data.fd	= fd;
+
+		if (epoll_ctl(m_epollFd, info.isRegistered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &event) != 0)
+			XS_FAIL("epoll_ctl() failed");
+	}
+	else if (info.isRegistered)
+	{
+		struct epoll_event event;
+		deMemset(&event, 0, sizeof(event));
+
+		// Handle may have been closed already, which removes it from epoll set implicitly.
+		if (epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, &event) != 0 && errno != EBADF && errno != ENOENT)
+			XS_FAIL("epoll_ctl() failed");
+	}
+
+	info.isRegistered = shouldRegister;
+#else
+	DE_UNREF(handle);
+	DE_UNREF(info);
+#endif
+}
+
+void IoReactor::watchFile (const char* path)
+{
+	unwatchFile();
+
+#if XS_USE_EPOLL
+	// Parent directory is watched since file may not exist yet.
+	const std::string	pathStr	= path;
+	const size_t		sepPos	= pathStr.rfind('/');
+	const std::string	dirName	= sepPos == std::string::npos ? std::string(".") : sepPos == 0 ? std::string("/") : pathStr.substr(0, sepPos);
+
+	// \note Failure is not fatal, file is still read once wait() times out.
+	m_watchDesc = inotify_add_watch(m_inotifyFd, dirName.c_str(), IN_CREATE|IN_MODIFY|IN_MOVED_TO|IN_CLOSE_WRITE);
+	if (m_watchDesc < 0)
+		return;
+
+	m_watchedName = sepPos == std::string::npos ? pathStr : pathStr.substr(sepPos+1);
+#else
+	DE_UNREF(path);
+#endif
+}
+
+void IoReactor::unwatchFile (void)
+{
+#if XS_USE_EPOLL
+	if (m_watchDesc >= 0)
+		inotify_rm_watch(m_inotifyFd, m_watchDesc);
+#endif
+
+	m_watchDesc = -1;
+	m_watchedName.clear();
+}
+
+bool IoReactor::readFileEvents (void)
+{
+	bool gotWatchedEvent = false;
+
+#if XS_USE_EPOLL
+	// Drain all events, only events for the watched file are reported.
+	for (;;)
+	{
+		deUint32		buf[FILE_EVENT_BUFFER_SIZE/sizeof(deUint32)];	//!< \note deUint32 for inotify_event alignment.
+		const deUint8*	bytes	= (const deUint8*)&buf[0];
+		const ssize_t	numRead	= read(m_inotifyFd, buf, sizeof(buf));
+
+		if (numRead <= 0)
+			break;
+
+		for (ssize_t pos = 0; pos < numRead;)
+		{
+			const struct inotify_event* event = (const struct inotify_event*)(bytes + pos);
+
+			if (event->wd == m_watchDesc && event->len > 0 && m_watchedName == event->name)
+				gotWatchedEvent = true;
+
+			pos += (ssize_t)sizeof(struct inotify_event) + event->len;
+		}
+	}
+#endif
+
+	return gotWatchedEvent;
+}
+
+bool IoReactor::wait (int timeoutMs)
+{
+#if XS_USE_EPOLL
+	struct epoll_event	events[MAX_EVENTS_PER_WAIT];
+	const int			numEvents	= epoll_wait(m_epollFd, &events[0], DE_LENGTH_OF_ARRAY(events), timeoutMs);
+	bool				gotEvent	= false;
+
+	if (numEvents < 0)
+	{
+		if (errno == EINTR)
+			return false;
+		XS_FAIL("epoll_wait() failed");
+	}
+
+	for (int ndx = 0; ndx < numEvents; ndx++)
+	{
+		if (events[ndx].data.fd == m_inotifyFd)
+			gotEvent = readFileEvents() || gotEvent;
+		else
+			gotEvent = true;
+	}
+
+	return gotEvent;
+#else
+	DE_UNREF(timeoutMs);
+	return false;
+#endif
+}
+
+} // xs
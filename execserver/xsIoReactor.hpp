@@ -0,0 +1,106 @@
+#ifndef _XSIOREACTOR_HPP
+#define _XSIOREACTOR_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Execution Server
+ * ---------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief IO readiness multiplexer.
+ *//*--------------------------------------------------------------------*/
+
+#include "xsDefs.hpp"
+
+#include <map>
+#include <string>
+
+namespace xs
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Waits until any of a set of native handles or a file changes
+ *
+ * Implemented with epoll and inotify on Linux and Android. On other
+ * platforms isSupported() returns false and callers must poll.
+ *
+ * Handles are grouped by source. Disabling a source stops wakeups from
+ * its handles without unregistering them, which is used to ignore
+ * process output while there is no room to forward it.
+ *//*--------------------------------------------------------------------*/
+class IoReactor
+{
+public:
+	enum EventFlags
+	{
+		EVENT_READ		= (1<<0),
+		EVENT_WRITE		= (1<<1)
+	};
+
+	enum Source
+	{
+		SOURCE_CONNECTION = 0,		//!< Client connection.
+		SOURCE_PROCESS,				//!< Test process output and log file.
+
+		SOURCE_LAST
+	};
+
+							IoReactor			(void);
+							~IoReactor			(void);
+
+	static bool				isSupported			(void);
+
+	void					addHandle			(deUintptr handle, deUint32 events, Source source);
+	void					setHandleEvents		(deUintptr handle, deUint32 events);
+	void					removeHandle		(deUintptr handle);
+
+	void					watchFile			(const char* path);		//!< Wake up when file is created or modified.
+	void					unwatchFile			(void);
+
+	void					setSourceEnabled	(Source source, bool enabled);
+
+	bool					wait				(int timeoutMs);		//!< Returns true if any event occurred before timeout.
+
+private:
+							IoReactor			(const IoReactor& other);
+	IoReactor&				operator=			(const IoReactor& other);
+
+	struct HandleInfo
+	{
+		HandleInfo (void) : events(0), source(SOURCE_LAST), isRegistered(false) {}
+
+		deUint32	events;
+		Source		source;
+		bool		isRegistered;	//!< Handle is in epoll set.
+	};
+
+	void					updateHandle		(deUintptr handle, HandleInfo& info);
+	bool					readFileEvents		(void);
+
+	typedef std::map<deUintptr, HandleInfo> HandleMap;
+
+	HandleMap				m_handles;
+	bool					m_sourceEnabled[SOURCE_LAST];
+
+	int						m_epollFd;
+	int						m_inotifyFd;
+	int						m_watchDesc;
+	std::string				m_watchedName;
+};
+
+} // xs
+
+#endif // _XSIOREACTOR_HPP
@@ -22,6 +22,7 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xsPosixTestProcess.hpp"
+#include "xsIoReactor.hpp"
 #include "deFilePath.hpp"
 #include "deClock.h"
 
@@ -168,10 +169,24 @@ void PipeReader::stop (void)
 
 } // unix
 
-PosixTestProcess::PosixTestProcess (void)
+//! Read whatever is available without blocking. isEnd is set if file has reached end or is in error state.
+static int readAvailable (deFile* file, deUint8* dst, int numBytes, bool* isEnd)
+{
+	deInt64				numRead	= 0;
+	const deFileResult	result	= deFile_read(file, dst, (deInt64)numBytes, &numRead);
+
+	*isEnd = result != DE_FILERESULT_SUCCESS && result != DE_FILERESULT_WOULD_BLOCK;
+
+	return result == DE_FILERESULT_SUCCESS ? (int)numRead : 0;
+}
+
+PosixTestProcess::PosixTestProcess (const char* logFileName)
 	: m_process				(DE_NULL)
 	, m_processStartTime	(0)
+	, m_logBaseName			(logFileName)
 	, m_infoBuffer			(INFO_BUFFER_BLOCK_SIZE, INFO_BUFFER_NUM_BLOCKS)
+	, m_reactor				(DE_NULL)
+	, m_logFile				(DE_NULL)
 	, m_stdOutReader		(&m_infoBuffer)
 	, m_stdErrReader		(&m_infoBuffer)
 	, m_logReader			(LOG_BUFFER_BLOCK_SIZE, LOG_BUFFER_NUM_BLOCKS)
@@ -189,7 +204,7 @@ void PosixTestProcess::start (const char* name, const char* params, const char*
 
 	XS_CHECK(!m_process);
 
-	de::FilePath logFilePath = de::FilePath::join(workingDir, "TestResults.qpa");
+	de::FilePath logFilePath = de::FilePath::join(workingDir, m_logBaseName);
 	m_logFileName = logFilePath.getPath();
 
 	// Remove old file if such exists.
@@ -209,6 +224,10 @@ void PosixTestProcess::start (const char* name, const char* params, const char*
 	if (strlen(params) > 0)
 		cmdLine += string(" ") + params;
 
+	// Watch log file before process can create it.
+	if (m_reactor)
+		m_reactor->watchFile(m_logFileName.c_str());
+
 	DE_ASSERT(!m_process);
 	m_process = new de::Process();
 
@@ -226,11 +245,30 @@ void PosixTestProcess::start (const char* name, const char* params, const char*
 	m_processStartTime = deGetMicroseconds();
 
 	// Create stdout & stderr readers.
-	if (m_process->getStdOut())
-		m_stdOutReader.start(m_process->getStdOut());
+	if (m_reactor)
+	{
+		try
+		{
+			if (m_process->getStdOut())
+				addOutputPipe(m_process->getStdOut());
 
-	if (m_process->getStdErr())
-		m_stdErrReader.start(m_process->getStdErr());
+			if (m_process->getStdErr())
+				addOutputPipe(m_process->getStdErr());
+		}
+		catch (const std::exception& e)
+		{
+			cleanup();
+			throw TestProcessException(e.what());
+		}
+	}
+	else
+	{
+		if (m_process->getStdOut())
+			m_stdOutReader.start(m_process->getStdOut());
+
+		if (m_process->getStdErr())
+			m_stdErrReader.start(m_process->getStdErr());
+	}
 
 	// Start case list writer.
 	if (hasCaseList)
@@ -261,11 +299,45 @@ void PosixTestProcess::terminate (void)
 	}
 }
 
+void PosixTestProcess::addOutputPipe (deFile* pipe)
+{
+	DE_ASSERT(m_reactor);
+
+	if (!deFile_setFlags(pipe, DE_FILE_NONBLOCKING))
+		XS_FAIL("Failed to set non-blocking mode");
+
+	m_reactor->addHandle(deFile_getHandle(pipe), IoReactor::EVENT_READ, IoReactor::SOURCE_PROCESS);
+	m_outputPipes.push_back(pipe);
+}
+
+void PosixTestProcess::setIoReactor (IoReactor* reactor)
+{
+	XS_CHECK(!m_process);
+	m_reactor = reactor;
+}
+
 void PosixTestProcess::cleanup (void)
 {
 	m_caseListWriter.stop();
 	m_logReader.stop();
 
+	if (m_reactor)
+	{
+		// \note Pipes are owned by m_process.
+		for (std::vector<deFile*>::const_iterator pipeIter = m_outputPipes.begin(); pipeIter != m_outputPipes.end(); ++pipeIter)
+			m_reactor->removeHandle(deFile_getHandle(*pipeIter));
+
+		m_reactor->unwatchFile();
+	}
+
+	m_outputPipes.clear();
+
+	if (m_logFile)
+	{
+		deFile_destroy(m_logFile);
+		m_logFile = DE_NULL;
+	}
+
 	// \note Info buffer must be canceled before stopping pipe readers.
 	m_infoBuffer.cancel();
 
@@ -313,7 +385,9 @@ int PosixTestProcess::getExitCode (void) const
 
 int PosixTestProcess::readTestLog (deUint8* dst, int numBytes)
 {
-	if (!m_logReader.isRunning())
+	const bool isLogOpen = m_reactor ? (m_logFile != DE_NULL) : m_logReader.isRunning();
+
+	if (!isLogOpen)
 	{
 		if (deGetMicroseconds() - m_processStartTime > LOG_FILE_TIMEOUT*1000)
 		{
@@ -326,11 +400,51 @@ int PosixTestProcess::readTestLog (deUint8* dst, int numBytes)
 			return 0;
 
 		// Start reader.
-		m_logReader.start(m_logFileName.c_str());
+		if (m_reactor)
+		{
+			m_logFile = deFile_create(m_logFileName.c_str(), DE_FILEMODE_OPEN|DE_FILEMODE_READ);
+			if (!m_logFile)
+				return 0;
+		}
+		else
+			m_logReader.start(m_logFileName.c_str());
+	}
+
+	if (m_reactor)
+	{
+		// \note End of file only means that process hasn't written more yet.
+		bool isEnd = false;
+		return readAvailable(m_logFile, dst, numBytes, &isEnd);
 	}
 
 	DE_ASSERT(m_logReader.isRunning());
 	return m_logReader.read(dst, numBytes);
 }
 
+int PosixTestProcess::readInfoLog (deUint8* dst, int numBytes)
+{
+	if (!m_reactor)
+		return m_infoBuffer.tryRead(numBytes, dst);
+
+	int numRead = 0;
+
+	for (size_t pipeNdx = 0; pipeNdx < m_outputPipes.size() && numRead < numBytes;)
+	{
+		bool isEnd = false;
+
+		numRead += readAvailable(m_outputPipes[pipeNdx], dst+numRead, numBytes-numRead, &isEnd);
+
+		if (isEnd)
+		{
+			// Closed pipe would wake up reactor constantly.
+			m_reactor->removeHandle(deFile_getHandle(m_outputPipes[pipeNdx]));
+			m_outputPipes.erase(m_outputPipes.begin()+pipeNdx);
+		}
+		else
+			pipeNdx += 1;
+	}
+
+	return numRead;
+}
+
 } // xs
@@ -75,7 +75,7 @@ private:
 class PosixTestProcess : public TestProcess
 {
 public:
-							PosixTestProcess		(void);
+	explicit				PosixTestProcess		(const char* logFileName = "TestResults.qpa");
 	virtual					~PosixTestProcess		(void);
 
 	virtual void			start					(const char* name, const char* params, const char* workingDir, const char* caseList);
@@ -87,18 +87,28 @@ public:
 	virtual int				getExitCode				(void) const;
 
 	virtual int				readTestLog				(deUint8* dst, int numBytes);
-	virtual int				readInfoLog				(deUint8* dst, int numBytes) { return m_infoBuffer.tryRead(numBytes, dst); }
+	virtual int				readInfoLog				(deUint8* dst, int numBytes);
+
+	virtual void			setIoReactor			(IoReactor* reactor);
 
 private:
 							PosixTestProcess		(const PosixTestProcess& other);
 	PosixTestProcess&		operator=				(const PosixTestProcess& other);
 
+	void					addOutputPipe			(deFile* pipe);
+
 	de::Process*			m_process;
 	deUint64				m_processStartTime;		//!< Used for determining log file timeout.
+	std::string				m_logBaseName;			//!< Log file name relative to working directory.
 	std::string				m_logFileName;
 	ThreadedByteBuffer		m_infoBuffer;
 
-	// Threads.
+	// Direct reading, used when IoReactor is set.
+	IoReactor*				m_reactor;
+	std::vector<deFile*>	m_outputPipes;			//!< Open stdout & stderr pipes.
+	deFile*					m_logFile;
+
+	// Threads, used when IoReactor is not set.
 	posix::CaseListWriter	m_caseListWriter;
 	posix::PipeReader		m_stdOutReader;
 	posix::PipeReader		m_stdErrReader;
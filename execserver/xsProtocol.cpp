@@ -44,6 +44,9 @@ template <typename T> T hostToNetwork (T value);
 template <> int networkToHost (int value) { return (int)swapEndianess((deUint32)value); }
 template <> int hostToNetwork (int value) { return (int)swapEndianess((deUint32)value); }
 
+template <> deUint32 networkToHost (deUint32 value) { return swapEndianess(value); }
+template <> deUint32 hostToNetwork (deUint32 value) { return swapEndianess(value); }
+
 class MessageParser
 {
 public:
@@ -76,6 +79,17 @@ public:
 		m_pos += 1;
 	}
 
+	bool isEnd (void) const
+	{
+		return m_pos >= m_size;
+	}
+
+	void getBytes (std::vector<deUint8>& dst)
+	{
+		dst.assign(m_data + m_pos, m_data + m_size);
+		m_pos = m_size;
+	}
+
 	void assumEnd (void)
 	{
 		if (m_pos != m_size)
@@ -161,10 +175,20 @@ void Message::writeNoData (vector<deUint8>& buf) const
 }
 
 HelloMessage::HelloMessage (const deUint8* data, int dataSize)
-	: Message(MESSAGETYPE_HELLO)
+	: Message			(MESSAGETYPE_HELLO)
+	, features			(0)
+	, maxMessageSize	(DEFAULT_MAX_MESSAGE_SIZE)
 {
 	MessageParser parser(data, dataSize);
 	version = parser.get<int>();
+
+	// Older clients send only version.
+	if (!parser.isEnd())
+	{
+		features		= parser.get<deUint32>();
+		maxMessageSize	= parser.get<int>();
+	}
+
 	parser.assumEnd();
 }
 
@@ -172,6 +196,44 @@ void HelloMessage::write (vector<deUint8>& buf) const
 {
 	MessageWriter writer(type, buf);
 	writer.put(version);
+
+	if (version >= 19)
+	{
+		writer.put(features);
+		writer.put(maxMessageSize);
+	}
+}
+
+HelloReplyMessage::HelloReplyMessage (const deUint8* data, int dataSize)
+	: Message(MESSAGETYPE_HELLO_REPLY)
+{
+	MessageParser parser(data, dataSize);
+	version			= parser.get<int>();
+	features		= parser.get<deUint32>();
+	maxMessageSize	= parser.get<int>();
+	parser.assumEnd();
+}
+
+void HelloReplyMessage::write (vector<deUint8>& buf) const
+{
+	MessageWriter writer(type, buf);
+	writer.put(version);
+	writer.put(features);
+	writer.put(maxMessageSize);
+}
+
+SelectSlotMessage::SelectSlotMessage (const deUint8* data, int dataSize)
+	: Message(MESSAGETYPE_SELECT_SLOT)
+{
+	MessageParser parser(data, dataSize);
+	slot = parser.get<int>();
+	parser.assumEnd();
+}
+
+void SelectSlotMessage::write (vector<deUint8>& buf) const
+{
+	MessageWriter writer(type, buf);
+	writer.put(slot);
 }
 
 TestMessage::TestMessage (const deUint8* data, int dataSize)
@@ -222,6 +284,36 @@ void ProcessLogDataMessage::write (vector<deUint8>& buf) const
 	writer.put(logData.c_str());
 }
 
+CompressedDataMessage::CompressedDataMessage (const deUint8* data_, int dataSize)
+	: Message(MESSAGETYPE_COMPRESSED_DATA)
+{
+	MessageParser parser(data_, dataSize);
+	dataType = (MessageType)parser.get<int>();
+	parser.getBytes(data);
+}
+
+void CompressedDataMessage::write (vector<deUint8>& buf) const
+{
+	MessageWriter writer(type, buf);
+	writer.put((int)dataType);
+
+	if (!data.empty())
+	{
+		const size_t curPos = buf.size();
+		buf.resize(curPos + data.size());
+		deMemcpy(&buf[curPos], &data[0], data.size());
+	}
+}
+
+void CompressedDataMessage::writeHeader (MessageType dataType, int messageSize, deUint8* dst, int bufSize)
+{
+	XS_CHECK_MSG(bufSize >= HEADER_SIZE, "Incomplete header");
+	Message::writeHeader(MESSAGETYPE_COMPRESSED_DATA, messageSize, dst, bufSize);
+
+	int netType = hostToNetwork((int)dataType);
+	deMemcpy(dst+MESSAGE_HEADER_SIZE, &netType, sizeof(netType));
+}
+
 ProcessLaunchFailedMessage::ProcessLaunchFailedMessage (const deUint8* data, int dataSize)
 	: Message(MESSAGETYPE_PROCESS_LAUNCH_FAILED)
 {
@@ -34,9 +34,14 @@ namespace xs
 
 enum
 {
-	PROTOCOL_VERSION			= 18,
+	PROTOCOL_VERSION			= 19,
+	MIN_PROTOCOL_VERSION		= 18,		//!< Oldest client version accepted. Versions before 19 don't negotiate features.
 	MESSAGE_HEADER_SIZE			= 8,
 
+	DEFAULT_MAX_MESSAGE_SIZE	= 16*1024,	//!< Max size of data messages unless negotiated otherwise.
+	MIN_MAX_MESSAGE_SIZE		= 1024,
+	MAX_MAX_MESSAGE_SIZE		= 1024*1024,
+
 	// Times are in milliseconds.
 	KEEPALIVE_SEND_INTERVAL		= 5000,
 	KEEPALIVE_TIMEOUT			= 30000,
@@ -51,6 +56,7 @@ enum MessageType
 	MESSAGETYPE_TEST					= 101,	//!< Debug only
 	MESSAGETYPE_EXECUTE_BINARY			= 111,	//!< Request execution of a test package binary.
 	MESSAGETYPE_STOP_EXECUTION			= 112,	//!< Request cancellation of the currently executing binary.
+	MESSAGETYPE_SELECT_SLOT				= 113,	//!< Request specific execution slot. Must be sent before EXECUTE_BINARY.
 
 	// Responses (from ExecServer to Client)
 	MESSAGETYPE_PROCESS_STARTED			= 200,	//!< Requested process has started.
@@ -58,10 +64,18 @@ enum MessageType
 	MESSAGETYPE_PROCESS_FINISHED		= 202,	//!< Requested process has finished (for any reason).
 	MESSAGETYPE_PROCESS_LOG_DATA		= 203,	//!< Unprocessed log data from TestResults.qpa.
 	MESSAGETYPE_INFO					= 204,	//!< Generic info message from ExecServer (for debugging purposes).
+	MESSAGETYPE_HELLO_REPLY				= 205,	//!< Negotiated protocol parameters, sent in response to HELLO from version 19 onwards.
+	MESSAGETYPE_COMPRESSED_DATA			= 206,	//!< PROCESS_LOG_DATA or INFO payload compressed with connection's deflate stream.
 
 	MESSAGETYPE_KEEPALIVE				= 102	//!< Keep-alive packet
 };
 
+//! Optional protocol features, negotiated with HELLO from version 19 onwards.
+enum ProtocolFeature
+{
+	PROTOCOL_FEATURE_COMPRESSION		= (1<<0)	//!< Log and info data is sent as COMPRESSED_DATA messages.
+};
+
 class MessageWriter;
 
 class Message
@@ -104,14 +118,42 @@ class HelloMessage : public Message
 {
 public:
 	int				version;
+	deUint32		features;			//!< Requested ProtocolFeature bits. Not present before version 19.
+	int				maxMessageSize;		//!< Largest message client accepts. Not present before version 19.
 
 					HelloMessage	(const deUint8* data, int dataSize);
-					HelloMessage	(void) : Message(MESSAGETYPE_HELLO), version(PROTOCOL_VERSION) {}
+					HelloMessage	(void) : Message(MESSAGETYPE_HELLO), version(PROTOCOL_VERSION), features(0), maxMessageSize(DEFAULT_MAX_MESSAGE_SIZE) {}
 					~HelloMessage	(void) {}
 
 	void			write			(std::vector<deUint8>& buf) const;
 };
 
+class HelloReplyMessage : public Message
+{
+public:
+	int				version;
+	deUint32		features;			//!< Enabled ProtocolFeature bits.
+	int				maxMessageSize;		//!< Largest message server will send.
+
+					HelloReplyMessage	(const deUint8* data, int dataSize);
+					HelloReplyMessage	(int version_, deUint32 features_, int maxMessageSize_) : Message(MESSAGETYPE_HELLO_REPLY), version(version_), features(features_), maxMessageSize(maxMessageSize_) {}
+					~HelloReplyMessage	(void) {}
+
+	void			write				(std::vector<deUint8>& buf) const;
+};
+
+class SelectSlotMessage : public Message
+{
+public:
+	int				slot;
+
+					SelectSlotMessage	(const deUint8* data, int dataSize);
+					SelectSlotMessage	(int slot_) : Message(MESSAGETYPE_SELECT_SLOT), slot(slot_) {}
+					~SelectSlotMessage	(void) {}
+
+	void			write				(std::vector<deUint8>& buf) const;
+};
+
 class ExecuteBinaryMessage : public Message
 {
 public:
@@ -138,6 +180,32 @@ public:
 	void			write						(std::vector<deUint8>& buf) const;
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Compressed log or info data
+ *
+ * Payload is the type of the original message followed by a block of
+ * a per-connection deflate stream. Each block is flushed so that it
+ * decompresses to the complete payload of the original message.
+ *//*--------------------------------------------------------------------*/
+class CompressedDataMessage : public Message
+{
+public:
+	enum
+	{
+		HEADER_SIZE		= MESSAGE_HEADER_SIZE + 4	//!< Message header and original type.
+	};
+
+	MessageType				dataType;
+	std::vector<deUint8>	data;
+
+							CompressedDataMessage	(const deUint8* data, int dataSize);
+							~CompressedDataMessage	(void) {}
+
+	void					write					(std::vector<deUint8>& buf) const;
+
+	static void				writeHeader				(MessageType dataType, int messageSize, deUint8* dst, int bufSize);
+};
+
 class ProcessLaunchFailedMessage : public Message
 {
 public:
@@ -0,0 +1,122 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Execution Server
+ * ---------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Outgoing message queue.
+ *//*--------------------------------------------------------------------*/
+
+#include "xsSendQueue.hpp"
+
+using std::vector;
+
+namespace xs
+{
+
+enum
+{
+	MAX_FREE_BUFFERS	= 8
+};
+
+SendQueue::SendQueue (int maxSize)
+	: m_maxSize		(maxSize)
+	, m_numBytes	(0)
+	, m_frontOffset	(0)
+{
+}
+
+SendQueue::~SendQueue (void)
+{
+}
+
+//! Swap a previously sent buffer into dst. Contents are undefined.
+void SendQueue::getBuffer (vector<deUint8>& dst)
+{
+	if (m_freeBuffers.empty())
+		return;
+
+	dst.swap(m_freeBuffers.back());
+	m_freeBuffers.pop_back();
+}
+
+//! Take ownership of first size bytes of message. message is left with unspecified contents.
+void SendQueue::push (vector<deUint8>& message, int size)
+{
+	DE_ASSERT(de::inRange(size, 1, (int)message.size()));
+
+	m_messages.push_back(Entry());
+	m_messages.back().data.swap(message);
+	m_messages.back().size = size;
+
+	m_numBytes += size;
+}
+
+deSocketResult SendQueue::send (de::Socket& socket, int* numSentPtr)
+{
+	deSocketBuffer	buffers[DE_SOCKET_MAX_SEND_BUFFERS];
+	int				numBuffers	= 0;
+	int				numSent		= 0;
+
+	DE_ASSERT(!m_messages.empty());
+
+	for (std::deque<Entry>::const_iterator iter = m_messages.begin(); iter != m_messages.end() && numBuffers < DE_SOCKET_MAX_SEND_BUFFERS; ++iter)
+	{
+		const int offset = numBuffers == 0 ? m_frontOffset : 0;
+
+		buffers[numBuffers].data	= &iter->data[offset];
+		buffers[numBuffers].size	= iter->size - offset;
+		numBuffers += 1;
+	}
+
+	const deSocketResult result = socket.sendv(&buffers[0], numBuffers, &numSent);
+
+	if (numSentPtr)
+		*numSentPtr = numSent;
+
+	if (result != DE_SOCKETRESULT_SUCCESS)
+		return result;
+
+	m_numBytes -= numSent;
+
+	// Release sent messages.
+	numSent += m_frontOffset;
+	while (!m_messages.empty() && numSent >= m_messages.front().size)
+	{
+		numSent -= m_messages.front().size;
+
+		if (m_freeBuffers.size() < MAX_FREE_BUFFERS)
+		{
+			m_freeBuffers.push_back(vector<deUint8>());
+			m_freeBuffers.back().swap(m_messages.front().data);
+		}
+
+		m_messages.pop_front();
+	}
+	m_frontOffset = numSent;
+
+	return result;
+}
+
+void SendQueue::clear (void)
+{
+	m_messages.clear();
+	m_numBytes		= 0;
+	m_frontOffset	= 0;
+}
+
+} // xs
@@ -0,0 +1,83 @@
+#ifndef _XSSENDQUEUE_HPP
+#define _XSSENDQUEUE_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Execution Server
+ * ---------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Outgoing message queue.
+ *//*--------------------------------------------------------------------*/
+
+#include "xsDefs.hpp"
+#include "deSocket.hpp"
+
+#include <vector>
+#include <deque>
+
+namespace xs
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Queue of encoded messages waiting to be sent
+ *
+ * Each message stays in the buffer it was encoded into. Buffers are
+ * handed over by swapping and sent with a single gather write, so
+ * message payload is not copied again after it has been written.
+ * Sent buffers are kept for reuse by getBuffer().
+ *//*--------------------------------------------------------------------*/
+class SendQueue
+{
+public:
+	explicit				SendQueue			(int maxSize);
+							~SendQueue			(void);
+
+	int						getNumElements		(void) const { return m_numBytes;								}
+	int						getNumFree			(void) const { return de::max(m_maxSize - m_numBytes, 0);	}
+
+	void					setMaxSize			(int maxSize) { m_maxSize = maxSize;							}
+
+	void					getBuffer			(std::vector<deUint8>& dst);
+	void					push				(std::vector<deUint8>& message, int size);
+	void					push				(std::vector<deUint8>& message) { push(message, (int)message.size()); }
+
+	deSocketResult			send				(de::Socket& socket, int* numSent);
+	void					clear				(void);
+
+private:
+							SendQueue			(const SendQueue& other);
+	SendQueue&				operator=			(const SendQueue& other);
+
+	struct Entry
+	{
+		std::vector<deUint8>	data;
+		int						size;			//!< Message size, data may be larger.
+
+		Entry (void) : size(0) {}
+	};
+
+	int									m_maxSize;
+	int									m_numBytes;
+	int									m_frontOffset;		//!< Bytes of first message already sent.
+
+	std::deque<Entry>					m_messages;
+	std::vector<std::vector<deUint8> >	m_freeBuffers;
+};
+
+} // xs
+
+#endif // _XSSENDQUEUE_HPP
@@ -22,6 +22,7 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xsTestDriver.hpp"
+#include "xsCompression.hpp"
 #include "deClock.h"
 
 #include <string>
@@ -45,7 +46,6 @@ TestDriver::TestDriver (xs::TestProcess* testProcess)
 	, m_lastExitCode		(0)
 	, m_process				(testProcess)
 	, m_lastProcessDataTime	(0)
-	, m_dataMsgTmpBuf		(SEND_RECV_TMP_BUFFER_SIZE)
 {
 }
 
@@ -81,7 +81,7 @@ void TestDriver::stopProcess (void)
 	m_process->terminate();
 }
 
-bool TestDriver::poll (ByteBuffer& messageBuffer)
+bool TestDriver::poll (SendQueue& sendQueue, const DataMessageFormat& format)
 {
 	switch (m_state)
 	{
@@ -90,7 +90,7 @@ bool TestDriver::poll (ByteBuffer& messageBuffer)
 
 		case STATE_PROCESS_LAUNCH_FAILED:
 			DBG_PRINT(("  STATE_PROCESS_LAUNCH_FAILED\n"));
-			if (writeMessage(messageBuffer, ProcessLaunchFailedMessage(m_lastLaunchFailure.c_str())))
+			if (writeMessage(sendQueue, ProcessLaunchFailedMessage(m_lastLaunchFailure.c_str())))
 			{
 				m_state				= STATE_NOT_STARTED;
 				m_lastLaunchFailure	= "";
@@ -101,7 +101,7 @@ bool TestDriver::poll (ByteBuffer& messageBuffer)
 
 		case STATE_PROCESS_STARTED:
 			DBG_PRINT(("  STATE_PROCESS_STARTED\n"));
-			if (writeMessage(messageBuffer, ProcessStartedMessage()))
+			if (writeMessage(sendQueue, ProcessStartedMessage()))
 			{
 				m_state = STATE_PROCESS_RUNNING;
 				return true;
@@ -114,9 +114,10 @@ bool TestDriver::poll (ByteBuffer& messageBuffer)
 			DBG_PRINT(("  STATE_PROCESS_RUNNING\n"));
 			bool gotProcessData = false;
 
-			// Poll log file and info buffer.
-			gotProcessData = pollLogFile(messageBuffer)	|| gotProcessData;
-			gotProcessData = pollInfo(messageBuffer)	|| gotProcessData;
+			// Drain log file as far as message buffer allows, and poll info buffer.
+			while (pollLogFile(sendQueue, format))
+				gotProcessData = true;
+			gotProcessData = pollInfo(sendQueue, format)	|| gotProcessData;
 
 			if (gotProcessData)
 				return true; // Got IO.
@@ -139,9 +140,10 @@ bool TestDriver::poll (ByteBuffer& messageBuffer)
 			DBG_PRINT(("  STATE_READING_DATA\n"));
 			bool gotProcessData = false;
 
-			// Poll log file and info buffer.
-			gotProcessData = pollLogFile(messageBuffer)	|| gotProcessData;
-			gotProcessData = pollInfo(messageBuffer)	|| gotProcessData;
+			// Drain log file as far as message buffer allows, and poll info buffer.
+			while (pollLogFile(sendQueue, format))
+				gotProcessData = true;
+			gotProcessData = pollInfo(sendQueue, format)	|| gotProcessData;
 
 			if (gotProcessData)
 			{
@@ -161,7 +163,7 @@ bool TestDriver::poll (ByteBuffer& messageBuffer)
 
 		case STATE_PROCESS_FINISHED:
 			DBG_PRINT(("  STATE_PROCESS_FINISHED\n"));
-			if (writeMessage(messageBuffer, ProcessFinishedMessage(m_lastExitCode)))
+			if (writeMessage(sendQueue, ProcessFinishedMessage(m_lastExitCode)))
 			{
 				// Signal TestProcess to clean up any remaining resources.
 				m_process->cleanup();
@@ -179,31 +181,44 @@ bool TestDriver::poll (ByteBuffer& messageBuffer)
 	}
 }
 
-bool TestDriver::pollLogFile (ByteBuffer& messageBuffer)
+bool TestDriver::pollLogFile (SendQueue& sendQueue, const DataMessageFormat& format)
 {
-	return pollBuffer(messageBuffer, MESSAGETYPE_PROCESS_LOG_DATA);
+	return pollBuffer(sendQueue, format, MESSAGETYPE_PROCESS_LOG_DATA);
 }
 
-bool TestDriver::pollInfo (ByteBuffer& messageBuffer)
+bool TestDriver::pollInfo (SendQueue& sendQueue, const DataMessageFormat& format)
 {
-	return pollBuffer(messageBuffer, MESSAGETYPE_INFO);
+	return pollBuffer(sendQueue, format, MESSAGETYPE_INFO);
 }
 
-bool TestDriver::pollBuffer (ByteBuffer& messageBuffer, MessageType msgType)
+bool TestDriver::pollBuffer (SendQueue& sendQueue, const DataMessageFormat& format, MessageType msgType)
 {
 	const int minBytesAvailable = MESSAGE_HEADER_SIZE + MIN_MSG_PAYLOAD_SIZE;
 
-	if (messageBuffer.getNumFree() < minBytesAvailable)
-		return false; // Not enough space in message buffer.
+	if (sendQueue.getNumFree() < minBytesAvailable)
+		return false; // Not enough space in send queue.
 
-	const int	maxMsgSize	= de::min((int)m_dataMsgTmpBuf.size(), messageBuffer.getNumFree());
-	int			numRead		= 0;
-	int			msgSize		= MESSAGE_HEADER_SIZE+1; // One byte is reserved for terminating 0.
+	const int	maxMsgSize		= de::min(format.maxMessageSize, sendQueue.getNumFree());
+	// Compressed data may be larger than original, read less so that message still fits.
+	const int	maxPayloadSize	= format.compressor ? DataCompressor::getMaxSourceSize(maxMsgSize - CompressedDataMessage::HEADER_SIZE)
+												: maxMsgSize - MESSAGE_HEADER_SIZE;
+	int			numRead			= 0;
+	int			msgSize			= MESSAGE_HEADER_SIZE+1; // One byte is reserved for terminating 0.
+
+	if (maxPayloadSize < 2)
+		return false; // Not enough space for compressed message.
+
+	// Data is read directly into message buffer which is then queued as is.
+	if (m_dataMsgBuf.empty())
+		sendQueue.getBuffer(m_dataMsgBuf);
+
+	if ((int)m_dataMsgBuf.size() < MESSAGE_HEADER_SIZE+maxPayloadSize)
+		m_dataMsgBuf.resize(MESSAGE_HEADER_SIZE+maxPayloadSize);
 
 	// Fill in data \note Last byte is reserved for 0.
 	numRead = msgType == MESSAGETYPE_PROCESS_LOG_DATA
-			? m_process->readTestLog(&m_dataMsgTmpBuf[MESSAGE_HEADER_SIZE], maxMsgSize-MESSAGE_HEADER_SIZE-1)
-			: m_process->readInfoLog(&m_dataMsgTmpBuf[MESSAGE_HEADER_SIZE], maxMsgSize-MESSAGE_HEADER_SIZE-1);
+			? m_process->readTestLog(&m_dataMsgBuf[MESSAGE_HEADER_SIZE], maxPayloadSize-1)
+			: m_process->readInfoLog(&m_dataMsgBuf[MESSAGE_HEADER_SIZE], maxPayloadSize-1);
 
 	if (numRead <= 0)
 		return false; // Didn't get any data.
@@ -211,28 +226,49 @@ bool TestDriver::pollBuffer (ByteBuffer& messageBuffer, MessageType msgType)
 	msgSize += numRead;
 
 	// Terminate with 0.
-	m_dataMsgTmpBuf[msgSize-1] = 0;
+	m_dataMsgBuf[msgSize-1] = 0;
+
+	if (format.compressor)
+	{
+		// Compressed message is built in separate buffer, data buffer is kept for next read.
+		if (m_compressedMsgBuf.empty())
+			sendQueue.getBuffer(m_compressedMsgBuf);
+
+		const int compressedSize = format.compressor->compress(&m_dataMsgBuf[MESSAGE_HEADER_SIZE], msgSize-MESSAGE_HEADER_SIZE, m_compressedMsgBuf, CompressedDataMessage::HEADER_SIZE);
 
-	// Write header.
-	Message::writeHeader(msgType, msgSize, &m_dataMsgTmpBuf[0], MESSAGE_HEADER_SIZE);
+		DE_ASSERT(compressedSize <= maxMsgSize);
 
-	// Write to messagebuffer.
-	messageBuffer.pushFront(&m_dataMsgTmpBuf[0], msgSize);
+		CompressedDataMessage::writeHeader(msgType, compressedSize, &m_compressedMsgBuf[0], CompressedDataMessage::HEADER_SIZE);
 
-	DBG_PRINT(("  wrote %d bytes of %s data\n", msgSize, msgType == MESSAGETYPE_INFO ? "info" : "log"));
+		sendQueue.push(m_compressedMsgBuf, compressedSize);
+		m_compressedMsgBuf.clear();
+
+		DBG_PRINT(("  wrote %d bytes of %s data, %d compressed\n", msgSize, msgType == MESSAGETYPE_INFO ? "info" : "log", compressedSize));
+	}
+	else
+	{
+		// Write header.
+		Message::writeHeader(msgType, msgSize, &m_dataMsgBuf[0], MESSAGE_HEADER_SIZE);
+
+		// Hand over to send queue.
+		sendQueue.push(m_dataMsgBuf, msgSize);
+		m_dataMsgBuf.clear();
+
+		DBG_PRINT(("  wrote %d bytes of %s data\n", msgSize, msgType == MESSAGETYPE_INFO ? "info" : "log"));
+	}
 
 	return true;
 }
 
-bool TestDriver::writeMessage (ByteBuffer& messageBuffer, const Message& message)
+bool TestDriver::writeMessage (SendQueue& sendQueue, const Message& message)
 {
 	vector<deUint8> buf;
 	message.write(buf);
 
-	if (messageBuffer.getNumFree() < (int)buf.size())
+	if (sendQueue.getNumFree() < (int)buf.size())
 		return false;
 
-	messageBuffer.pushFront(&buf[0], (int)buf.size());
+	sendQueue.push(buf);
 	return true;
 }
 
@@ -26,12 +26,24 @@
 #include "xsDefs.hpp"
 #include "xsProtocol.hpp"
 #include "xsTestProcess.hpp"
+#include "xsSendQueue.hpp"
 
 #include <vector>
 
 namespace xs
 {
 
+class DataCompressor;
+
+//! Encoding of log and info data messages, negotiated per connection.
+struct DataMessageFormat
+{
+	int					maxMessageSize;
+	DataCompressor*		compressor;			//!< Data is sent as COMPRESSED_DATA messages if not null.
+
+	DataMessageFormat (void) : maxMessageSize(DEFAULT_MAX_MESSAGE_SIZE), compressor(DE_NULL) {}
+};
+
 class TestDriver
 {
 public:
@@ -43,7 +55,9 @@ public:
 	void					startProcess		(const char* name, const char* params, const char* workingDir, const char* caseList);
 	void					stopProcess			(void);
 
-	bool					poll				(ByteBuffer& messageBuffer);
+	bool					poll				(SendQueue& sendQueue, const DataMessageFormat& format);
+
+	void					setIoReactor		(IoReactor* reactor) { m_process->setIoReactor(reactor); }
 
 private:
 	enum State
@@ -58,11 +72,11 @@ private:
 		STATE_LAST
 	};
 
-	bool					pollLogFile			(ByteBuffer& messageBuffer);
-	bool					pollInfo			(ByteBuffer& messageBuffer);
-	bool					pollBuffer			(ByteBuffer& messageBuffer, MessageType msgType);
+	bool					pollLogFile			(SendQueue& sendQueue, const DataMessageFormat& format);
+	bool					pollInfo			(SendQueue& sendQueue, const DataMessageFormat& format);
+	bool					pollBuffer			(SendQueue& sendQueue, const DataMessageFormat& format, MessageType msgType);
 
-	bool					writeMessage		(ByteBuffer& messageBuffer, const Message& message);
+	bool					writeMessage		(SendQueue& sendQueue, const Message& message);
 
 	State					m_state;
 
@@ -72,7 +86,8 @@ private:
 	xs::TestProcess*		m_process;
 	deUint64				m_lastProcessDataTime;
 
-	std::vector<deUint8>	m_dataMsgTmpBuf;
+	std::vector<deUint8>	m_dataMsgBuf;			//!< Buffer for next data message, handed over to send queue once filled.
+	std::vector<deUint8>	m_compressedMsgBuf;
 };
 
 } // xs
@@ -30,6 +30,8 @@
 namespace xs
 {
 
+class IoReactor;
+
 class TestProcessException : public std::runtime_error
 {
 public:
@@ -51,6 +53,9 @@ public:
 	virtual int				readTestLog				(deUint8* dst, int numBytes)	= DE_NULL;
 	virtual int				readInfoLog				(deUint8* dst, int numBytes)	= DE_NULL;
 
+	//! Read process output directly when reactor signals data instead of using reader threads. Must not be called while process is running.
+	virtual void			setIoReactor			(IoReactor* reactor)			{ DE_UNREF(reactor); }
+
 protected:
 							TestProcess				(void) {}
 };
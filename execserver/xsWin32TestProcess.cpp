@@ -626,9 +626,10 @@ void Process::kill (void)
 
 } // win32
 
-Win32TestProcess::Win32TestProcess (void)
+Win32TestProcess::Win32TestProcess (const char* logFileName)
 	: m_process				(DE_NULL)
 	, m_processStartTime	(0)
+	, m_logBaseName			(logFileName)
 	, m_infoBuffer			(INFO_BUFFER_BLOCK_SIZE, INFO_BUFFER_NUM_BLOCKS)
 	, m_stdOutReader		(&m_infoBuffer)
 	, m_stdErrReader		(&m_infoBuffer)
@@ -646,7 +647,7 @@ void Win32TestProcess::start (const char* name, const char* params, const char*
 
 	XS_CHECK(!m_process);
 
-	de::FilePath logFilePath = de::FilePath::join(workingDir, "TestResults.qpa");
+	de::FilePath logFilePath = de::FilePath::join(workingDir, m_logBaseName);
 	m_logFileName = logFilePath.getPath();
 
 	// Remove old file if such exists.
@@ -21,17 +21,21 @@
  * \brief Batch result to JUnit report conversion tool.
  *//*--------------------------------------------------------------------*/
 
-#include "xeTestLogParser.hpp"
+#include "xeTestLogIndex.hpp"
 #include "xeTestResultParser.hpp"
 #include "xeXMLWriter.hpp"
 #include "deFilePath.hpp"
 #include "deString.h"
 #include "deStringUtil.hpp"
+#include "deString.h"
+#include "deWorkerPool.hpp"
+#include "deSharedPtr.hpp"
 
 #include <vector>
 #include <string>
 #include <map>
 #include <cstdio>
+#include <cstdlib>
 #include <fstream>
 
 using std::vector;
@@ -41,114 +45,118 @@ using std::map;
 struct CommandLine
 {
 	CommandLine (void)
+		: numThreads(0)
 	{
 	}
 
 	std::string		batchResultFile;
 	std::string		outputFile;
+	int				numThreads;
 };
 
 static void printHelp (const char* binName)
 {
-	printf("%s: [testlog] [output file]\n", binName);
+	printf("%s: [--threads=<n>] [testlog] [output file]\n", binName);
+	printf(" --threads=<n>    Number of worker threads (1 = no threads, 0 = number of CPU cores).\n");
 }
 
 static void parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
 {
-	if (argc != 3)
-		throw xe::Error("Expected input and output paths");
-
-	cmdLine.batchResultFile	= argv[argc-2];
-	cmdLine.outputFile		= argv[argc-1];
-}
-
-static void parseBatchResult (xe::TestLogParser& parser, const char* filename)
-{
-	std::ifstream	in			(filename, std::ios_base::binary);
-	deUint8			buf[2048];
+	vector<string> paths;
 
-	for (;;)
+	for (int argNdx = 1; argNdx < argc; argNdx++)
 	{
-		in.read((char*)&buf[0], sizeof(buf));
-		int numRead = (int)in.gcount();
+		const char* arg = argv[argNdx];
+
+		if (deStringBeginsWith(arg, "--threads="))
+			cmdLine.numThreads = atoi(arg+10);
+		else if (!deStringBeginsWith(arg, "--"))
+			paths.push_back(arg);
+		else
+			throw xe::Error(string("Unknown option '") + arg + "'");
+	}
 
-		if (numRead > 0)
-			parser.parse(&buf[0], numRead);
+	if (paths.size() != 2)
+		throw xe::Error("Expected input and output paths");
 
-		if (numRead < (int)sizeof(buf))
-			break;
-	}
+	cmdLine.batchResultFile	= paths[0];
+	cmdLine.outputFile		= paths[1];
 }
 
-class ResultToJUnitHandler : public xe::TestLogHandler
+class ResultHeaderParseJob : public de::WorkerPool::Job
 {
 public:
-	ResultToJUnitHandler (xe::xml::Writer& writer)
-		: m_writer(writer)
+	ResultHeaderParseJob (const xe::TestLogIndex& index, vector<xe::TestCaseResultHeader>& headers, int numWorkers)
+		: m_index	(index)
+		, m_headers	(headers)
 	{
+		for (int ndx = 0; ndx < numWorkers; ndx++)
+			m_parsers.push_back(de::SharedPtr<xe::TestResultParser>(new xe::TestResultParser()));
 	}
 
-	void setSessionInfo (const xe::SessionInfo&)
+	void execute (int caseNdx, int workerNdx)
 	{
-	}
+		xe::TestCaseResult result;
 
-	xe::TestCaseResultPtr startTestCaseResult (const char* casePath)
-	{
-		return xe::TestCaseResultPtr(new xe::TestCaseResultData(casePath));
-	}
+		m_index.parseCaseResult(caseNdx, *m_parsers[workerNdx], result);
 
-	void testCaseResultUpdated (const xe::TestCaseResultPtr&)
-	{
+		m_headers[caseNdx] = xe::TestCaseResultHeader(result);
 	}
 
-	void testCaseResultComplete (const xe::TestCaseResultPtr& resultData)
-	{
-		using xe::xml::Writer;
-
-		xe::TestCaseResult result;
-
-		xe::parseTestCaseResultFromData(&m_resultParser, &result, *resultData.get());
+private:
+	const xe::TestLogIndex&								m_index;
+	vector<xe::TestCaseResultHeader>&					m_headers;
+	vector<de::SharedPtr<xe::TestResultParser> >		m_parsers;
+};
 
-		// Split group and case names.
-		size_t			sepPos		= result.casePath.find_last_of('.');
-		std::string		caseName	= result.casePath.substr(sepPos+1);
-		std::string		groupName	= result.casePath.substr(0, sepPos);
+static void writeTestCaseResult (xe::xml::Writer& writer, const xe::TestCaseResultHeader& result)
+{
+	using xe::xml::Writer;
 
-		// Write result.
-		m_writer << Writer::BeginElement("testcase")
-				 << Writer::Attribute("name", caseName)
-				 << Writer::Attribute("classname", groupName);
+	// Split group and case names.
+	size_t			sepPos		= result.casePath.find_last_of('.');
+	std::string		caseName	= result.casePath.substr(sepPos+1);
+	std::string		groupName	= result.casePath.substr(0, sepPos);
 
-		if (result.statusCode != xe::TESTSTATUSCODE_PASS)
-			m_writer << Writer::BeginElement("failure")
-					 << Writer::Attribute("type", xe::getTestStatusCodeName(result.statusCode))
-					 << result.statusDetails
-					 << Writer::EndElement;
+	// Write result.
+	writer << Writer::BeginElement("testcase")
+		   << Writer::Attribute("name", caseName)
+		   << Writer::Attribute("classname", groupName);
 
-		m_writer << Writer::EndElement;
-	}
+	if (result.statusCode != xe::TESTSTATUSCODE_PASS)
+		writer << Writer::BeginElement("failure")
+			   << Writer::Attribute("type", xe::getTestStatusCodeName(result.statusCode))
+			   << result.statusDetails
+			   << Writer::EndElement;
 
-private:
-	xe::xml::Writer&		m_writer;
-	xe::TestResultParser	m_resultParser;
-};
+	writer << Writer::EndElement;
+}
 
-static void batchResultToJUnitReport (const char* batchResultFilename, const char* dstFileName)
+static void batchResultToJUnitReport (const char* batchResultFilename, const char* dstFileName, int numThreads)
 {
-	std::ofstream				out			(dstFileName, std::ios_base::binary);
-	xe::xml::Writer				writer		(out);
-	ResultToJUnitHandler		handler		(writer);
-	xe::TestLogParser			parser		(&handler);
+	const xe::TestLogIndex				index		(batchResultFilename);
+	vector<xe::TestCaseResultHeader>	results		(index.getNumCases());
+	std::ofstream						out			(dstFileName, std::ios_base::binary);
+	xe::xml::Writer						writer		(out);
 
 	XE_CHECK(out.good());
 
+	// Parse individual cases in parallel
+	{
+		de::WorkerPool			workerPool	(xe::getNumWorkerThreads(numThreads));
+		ResultHeaderParseJob	job			(index, results, workerPool.getNumWorkers());
+
+		workerPool.execute(job, index.getNumCases());
+	}
+
 	out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
 
 	writer << xe::xml::Writer::BeginElement("testsuites")
 		   << xe::xml::Writer::BeginElement("testsuite");
 
-	// Parse and write individual cases
-	parseBatchResult(parser, batchResultFilename);
+	// Write individual cases in log order
+	for (vector<xe::TestCaseResultHeader>::const_iterator result = results.begin(); result != results.end(); ++result)
+		writeTestCaseResult(writer, *result);
 
 	writer << xe::xml::Writer::EndElement << xe::xml::Writer::EndElement;
 }
@@ -168,7 +176,7 @@ int main (int argc, const char* const* argv)
 
 	try
 	{
-		batchResultToJUnitReport(cmdLine.batchResultFile.c_str(), cmdLine.outputFile.c_str());
+		batchResultToJUnitReport(cmdLine.batchResultFile.c_str(), cmdLine.outputFile.c_str(), cmdLine.numThreads);
 	}
 	catch (const std::exception& e)
 	{
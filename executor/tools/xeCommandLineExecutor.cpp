@@ -29,6 +29,7 @@
 #include "xeTestLogWriter.hpp"
 #include "deDirectoryIterator.hpp"
 #include "deCommandLine.hpp"
+#include "deSharedPtr.hpp"
 #include "deString.h"
 
 #include <vector>
@@ -46,8 +47,12 @@ namespace opt
 {
 
 DE_DECLARE_COMMAND_LINE_OPT(StartServer,	std::string);
-DE_DECLARE_COMMAND_LINE_OPT(Host,			std::string);
+DE_DECLARE_COMMAND_LINE_OPT(Host,			std::vector<std::string>);
 DE_DECLARE_COMMAND_LINE_OPT(Port,			int);
+DE_DECLARE_COMMAND_LINE_OPT(NumShards,		int);
+DE_DECLARE_COMMAND_LINE_OPT(DurationFile,	std::string);
+DE_DECLARE_COMMAND_LINE_OPT(Compress,		bool);
+DE_DECLARE_COMMAND_LINE_OPT(MaxMessageSize,	int);
 DE_DECLARE_COMMAND_LINE_OPT(CaseListDir,	std::string);
 DE_DECLARE_COMMAND_LINE_OPT(TestSet,		std::vector<std::string>);
 DE_DECLARE_COMMAND_LINE_OPT(ExcludeSet,		std::vector<std::string>);
@@ -82,12 +87,16 @@ void registerOptions (de::cmdline::Parser& parser)
 	};
 
 	parser << Option<StartServer>	("s",		"start-server",	"Start local execserver",								"")
-		   << Option<Host>			("c",		"connect",		"Connect to host",										"127.0.0.1")
+		   << Option<Host>			("c",		"connect",		"Connect to host, comma-separated list of host[:port]",	parseCommaSeparatedList,	"127.0.0.1")
 		   << Option<Port>			("p",		"port",			"Select TCP port to use",								"50016")
+		   << Option<NumShards>		(DE_NULL,	"shards",		"Number of parallel execution shards",					"1")
+		   << Option<DurationFile>	(DE_NULL,	"durations",	"Test case duration history for balancing shards, updated after run",	"")
+		   << Option<Compress>		(DE_NULL,	"compress",		"Request compressed log data from remote execserver",	s_yesNo,	"no")
+		   << Option<MaxMessageSize>	(DE_NULL,	"max-message-size",	"Largest log data message requested from remote execserver",	"16384")
 		   << Option<CaseListDir>	("cd",		"caselistdir",	"Path to test case XML files",							".")
 		   << Option<TestSet>		("t",		"testset",		"Test set",												parseCommaSeparatedList,	"")
 		   << Option<ExcludeSet>	("e",		"exclude",		"Comma-separated list of exclude filters",				parseCommaSeparatedList,	"")
-		   << Option<ContinueFile>	(DE_NULL,	"continue",		"Continue execution by initializing results from existing test log")
+		   << Option<ContinueFile>	(DE_NULL,	"continue",		"Continue execution by initializing results from existing test log",	"")
 		   << Option<TestLogFile>	("o",		"out",			"Output test log filename",								"")
 		   << Option<InfoLogFile>	("i",		"info",			"Output info log filename",								"")
 		   << Option<Summary>		(DE_NULL,	"summary",		"Print summary at the end",								s_yesNo,	"yes")
@@ -104,15 +113,22 @@ using std::string;
 struct CommandLine
 {
 	CommandLine (void)
-		: port		(0)
-		, summary	(false)
+		: port				(0)
+		, numShards			(1)
+		, compress			(false)
+		, maxMessageSize	(xs::DEFAULT_MAX_MESSAGE_SIZE)
+		, summary			(false)
 	{
 	}
 
 	xe::TargetConfiguration		targetCfg;
 	std::string					serverBin;
-	std::string					host;
+	std::vector<std::string>	hosts;
 	int							port;
+	int							numShards;
+	std::string					durationFile;
+	bool						compress;
+	int							maxMessageSize;
 	std::string					caseListDir;
 	std::vector<std::string>	testset;
 	std::vector<std::string>	exclude;
@@ -139,8 +155,12 @@ static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const*
 	}
 
 	cmdLine.serverBin				= opts.getOption<opt::StartServer>();
-	cmdLine.host					= opts.getOption<opt::Host>();
+	cmdLine.hosts					= opts.getOption<opt::Host>();
 	cmdLine.port					= opts.getOption<opt::Port>();
+	cmdLine.numShards				= opts.getOption<opt::NumShards>();
+	cmdLine.durationFile			= opts.getOption<opt::DurationFile>();
+	cmdLine.compress				= opts.getOption<opt::Compress>();
+	cmdLine.maxMessageSize			= opts.getOption<opt::MaxMessageSize>();
 	cmdLine.caseListDir				= opts.getOption<opt::CaseListDir>();
 	cmdLine.testset					= opts.getOption<opt::TestSet>();
 	cmdLine.exclude					= opts.getOption<opt::ExcludeSet>();
@@ -152,6 +172,13 @@ static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const*
 	cmdLine.targetCfg.workingDir	= opts.getOption<opt::WorkingDir>();
 	cmdLine.targetCfg.cmdLineArgs	= opts.getOption<opt::CmdLineArgs>();
 
+	if (cmdLine.numShards < 1 || cmdLine.hosts.empty())
+	{
+		std::cout << argv[0] << " [options]\n";
+		parser.help(std::cout);
+		return false;
+	}
+
 	return true;
 }
 
@@ -398,41 +425,87 @@ static void writeInfoLog (const xe::InfoLog& log, const char* filename)
 	out.close();
 }
 
-static xe::CommLink* createCommLink (const CommandLine& cmdLine)
+static void readCaseDurations (xe::CaseDurationMap& durations, const char* filename)
+{
+	std::ifstream	in		(filename);
+	std::string		line;
+
+	// Missing file is not an error, history is simply empty.
+	while (std::getline(in, line))
+	{
+		const size_t sepPos = line.rfind(' ');
+
+		if (sepPos != std::string::npos && sepPos > 0)
+			durations[line.substr(0, sepPos)] = (deUint64)strtoull(line.c_str()+sepPos+1, DE_NULL, 10);
+	}
+}
+
+static void writeCaseDurations (const xe::CaseDurationMap& durations, const char* filename)
+{
+	std::ofstream out(filename);
+	XE_CHECK(out.good());
+
+	for (xe::CaseDurationMap::const_iterator iter = durations.begin(); iter != durations.end(); ++iter)
+		out << iter->first << " " << iter->second << "\n";
+
+	out.close();
+}
+
+static xe::CommLink* createTcpIpLink (const CommandLine& cmdLine, const char* host, int port)
+{
+	de::SocketAddress address;
+	address.setFamily(DE_SOCKETFAMILY_INET4);
+	address.setProtocol(DE_SOCKETPROTOCOL_TCP);
+	address.setHost(host);
+	address.setPort(port);
+
+	xe::TcpIpLink* link = new xe::TcpIpLink();
+	try
+	{
+		link->setProtocolOptions(cmdLine.compress ? (deUint32)xs::PROTOCOL_FEATURE_COMPRESSION : 0u, cmdLine.maxMessageSize);
+		link->connect(address);
+		return link;
+	}
+	catch (...)
+	{
+		delete link;
+		throw;
+	}
+}
+
+static xe::CommLink* createCommLink (const CommandLine& cmdLine, int linkNdx)
 {
 	if (!cmdLine.serverBin.empty())
 	{
-		xe::LocalTcpIpLink* link = new xe::LocalTcpIpLink();
-		try
-		{
-			link->start(cmdLine.serverBin.c_str(), DE_NULL, cmdLine.port);
-			return link;
-		}
-		catch (...)
+		// First link starts local execserver with one execution slot per shard. Each slot
+		// writes its own log file, so shards don't clobber each other's results.
+		if (linkNdx == 0)
 		{
-			delete link;
-			throw;
+			xe::LocalTcpIpLink* link = new xe::LocalTcpIpLink();
+			try
+			{
+				link->start(cmdLine.serverBin.c_str(), DE_NULL, cmdLine.port, cmdLine.numShards);
+				return link;
+			}
+			catch (...)
+			{
+				delete link;
+				throw;
+			}
 		}
+		else
+			return createTcpIpLink(cmdLine, "127.0.0.1", cmdLine.port);
 	}
 	else
 	{
-		de::SocketAddress address;
-		address.setFamily(DE_SOCKETFAMILY_INET4);
-		address.setProtocol(DE_SOCKETPROTOCOL_TCP);
-		address.setHost(cmdLine.host.c_str());
-		address.setPort(cmdLine.port);
-
-		xe::TcpIpLink* link = new xe::TcpIpLink();
-		try
-		{
-			link->connect(address);
-			return link;
-		}
-		catch (...)
-		{
-			delete link;
-			throw;
-		}
+		// Links are distributed over hosts in round-robin order. Multiple links to
+		// same host require an execserver with multiple execution slots.
+		const std::string&	hostStr	= cmdLine.hosts[linkNdx % (int)cmdLine.hosts.size()];
+		const size_t		sepPos	= hostStr.find(':');
+		const std::string	host	= hostStr.substr(0, sepPos);
+		const int			port	= sepPos != std::string::npos ? atoi(hostStr.c_str()+sepPos+1) : cmdLine.port;
+
+		return createTcpIpLink(cmdLine, host.c_str(), port);
 	}
 }
 
@@ -462,13 +535,48 @@ static void runExecutor (const CommandLine& cmdLine)
 	if (!cmdLine.inFile.empty())
 		readLogFile(&batchResult, cmdLine.inFile.c_str());
 
-	// Initialize commLink.
-	std::auto_ptr<xe::CommLink> commLink(createCommLink(cmdLine));
+	const int numLinks = !cmdLine.serverBin.empty() ? cmdLine.numShards : de::max(cmdLine.numShards, (int)cmdLine.hosts.size());
+
+	if (numLinks == 1 && cmdLine.durationFile.empty())
+	{
+		// Initialize commLink.
+		std::auto_ptr<xe::CommLink> commLink(createCommLink(cmdLine, 0));
+
+		xe::BatchExecutor executor(cmdLine.targetCfg, commLink.get(), &root, testSet, &batchResult, &infoLog);
+		executor.run();
+
+		commLink.reset();
+	}
+	else
+	{
+		std::vector<de::SharedPtr<xe::CommLink> >	commLinks;
+		std::vector<xe::CommLink*>					commLinkPtrs;
+		xe::CaseDurationMap							durations;
+
+		if (!cmdLine.durationFile.empty())
+			readCaseDurations(durations, cmdLine.durationFile.c_str());
+
+		// Initialize commLinks.
+		for (int linkNdx = 0; linkNdx < numLinks; linkNdx++)
+		{
+			commLinks.push_back(de::SharedPtr<xe::CommLink>(createCommLink(cmdLine, linkNdx)));
+			commLinkPtrs.push_back(commLinks.back().get());
+		}
 
-	xe::BatchExecutor executor(cmdLine.targetCfg, commLink.get(), &root, testSet, &batchResult, &infoLog);
-	executor.run();
+		{
+			xe::ShardedBatchExecutor executor(cmdLine.targetCfg, commLinkPtrs, &root, testSet, &batchResult, &infoLog, &durations);
+			executor.run();
+		}
 
-	commLink.reset();
+		commLinkPtrs.clear();
+
+		// Local execserver is owned by first link, disconnect others before stopping it.
+		while (!commLinks.empty())
+			commLinks.pop_back();
+
+		if (!cmdLine.durationFile.empty())
+			writeCaseDurations(durations, cmdLine.durationFile.c_str());
+	}
 
 	if (!cmdLine.outFile.empty())
 	{
@@ -23,6 +23,7 @@
 
 #include "xeTestLogParser.hpp"
 #include "xeTestResultParser.hpp"
+#include "xeSampleListFile.hpp"
 #include "deFilePath.hpp"
 #include "deString.h"
 #include "deStringUtil.hpp"
@@ -40,7 +41,24 @@ using std::string;
 using std::set;
 using std::map;
 
-void writeSampleList (const char* casePath, int listNdx, const xe::ri::SampleList& sampleList)
+enum OutputFormat
+{
+	OUTPUTFORMAT_CSV = 0,
+	OUTPUTFORMAT_BINARY,		//!< Columnar binary, see xeSampleListFile.hpp
+
+	OUTPUTFORMAT_LAST
+};
+
+struct CommandLine
+{
+	CommandLine (void) : format(OUTPUTFORMAT_CSV), compression(xe::samplelist::COMPRESSION_NONE) {}
+
+	string							filename;
+	OutputFormat					format;
+	xe::samplelist::Compression		compression;
+};
+
+void writeSampleListCsv (const char* casePath, int listNdx, const xe::ri::SampleList& sampleList)
 {
 	const string	filename	= string(casePath) + "." + de::toString(listNdx) + ".csv";
 	std::ofstream	out			(filename.c_str(), std::ios_base::binary);
@@ -58,49 +76,60 @@ void writeSampleList (const char* casePath, int listNdx, const xe::ri::SampleLis
 	out << "\n";
 
 	// Samples
-	for (int sampleNdx = 0; sampleNdx < sampleList.samples.getNumItems(); sampleNdx++)
+	for (int sampleNdx = 0; sampleNdx < sampleList.getNumSamples(); sampleNdx++)
 	{
-		const xe::ri::Sample&	sample	= static_cast<const xe::ri::Sample&>(sampleList.samples.getItem(sampleNdx));
+		const xe::ri::NumericValue*	values		= sampleList.getValues(sampleNdx);
+		const int					numValues	= sampleList.getNumValues(sampleNdx);
 
-		for (int valNdx = 0; valNdx < sample.values.getNumItems(); valNdx++)
+		for (int valNdx = 0; valNdx < numValues; valNdx++)
 		{
-			const xe::ri::SampleValue&	value	= static_cast<const xe::ri::SampleValue&>(sample.values.getItem(valNdx));
-
 			if (valNdx != 0)
 				out << ",";
 
-			out << value.value;
+			out << values[valNdx];
 		}
 		out << "\n";
 	}
 }
 
-void extractSampleLists (const char* casePath, int* listNdx, const xe::ri::List& items)
+void writeSampleList (const CommandLine& cmdLine, const char* casePath, int listNdx, const xe::ri::SampleList& sampleList)
+{
+	if (cmdLine.format == OUTPUTFORMAT_BINARY)
+	{
+		const string filename = string(casePath) + "." + de::toString(listNdx) + ".samples";
+		xe::samplelist::writeSampleListFile(filename.c_str(), sampleList, cmdLine.compression);
+	}
+	else
+		writeSampleListCsv(casePath, listNdx, sampleList);
+}
+
+void extractSampleLists (const CommandLine& cmdLine, const char* casePath, int* listNdx, const xe::ri::List& items)
 {
 	for (int itemNdx = 0; itemNdx < items.getNumItems(); itemNdx++)
 	{
 		const xe::ri::Item& child = items.getItem(itemNdx);
 
 		if (child.getType() == xe::ri::TYPE_SECTION)
-			extractSampleLists(casePath, listNdx, static_cast<const xe::ri::Section&>(child).items);
+			extractSampleLists(cmdLine, casePath, listNdx, static_cast<const xe::ri::Section&>(child).items);
 		else if (child.getType() == xe::ri::TYPE_SAMPLELIST)
 		{
-			writeSampleList(casePath, *listNdx, static_cast<const xe::ri::SampleList&>(child));
+			writeSampleList(cmdLine, casePath, *listNdx, static_cast<const xe::ri::SampleList&>(child));
 			*listNdx += 1;
 		}
 	}
 }
 
-void extractSampleLists (const xe::TestCaseResult& result)
+void extractSampleLists (const CommandLine& cmdLine, const xe::TestCaseResult& result)
 {
 	int listNdx = 0;
-	extractSampleLists(result.casePath.c_str(), &listNdx, result.resultItems);
+	extractSampleLists(cmdLine, result.casePath.c_str(), &listNdx, result.resultItems);
 }
 
 class SampleListParser : public xe::TestLogHandler
 {
 public:
-	SampleListParser (void)
+	SampleListParser (const CommandLine& cmdLine)
+		: m_cmdLine(cmdLine)
 	{
 	}
 
@@ -123,17 +152,19 @@ public:
 	{
 		xe::TestCaseResult result;
 		xe::parseTestCaseResultFromData(&m_testResultParser, &result, *caseData.get());
-		extractSampleLists(result);
+		extractSampleLists(m_cmdLine, result);
 	}
 
 private:
+	const CommandLine&		m_cmdLine;
 	xe::TestResultParser	m_testResultParser;
 };
 
-static void processLogFile (const char* filename)
+static void processLogFile (const CommandLine& cmdLine)
 {
+	const char*			filename		= cmdLine.filename.c_str();
 	std::ifstream		in				(filename, std::ifstream::binary|std::ifstream::in);
-	SampleListParser	resultHandler;
+	SampleListParser	resultHandler	(cmdLine);
 	xe::TestLogParser	parser			(&resultHandler);
 	deUint8				buf				[1024];
 	int					numRead			= 0;
@@ -155,17 +186,57 @@ static void processLogFile (const char* filename)
 	in.close();
 }
 
+static void printHelp (const char* binName)
+{
+	printf("%s: [--format=csv|binary] [--compress] [filename]\n", binName);
+}
+
+static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
+{
+	for (int argNdx = 1; argNdx < argc; argNdx++)
+	{
+		const char* arg = argv[argNdx];
+
+		if (!deStringBeginsWith(arg, "--"))
+		{
+			if (cmdLine.filename.empty())
+				cmdLine.filename = arg;
+			else
+				return false;
+		}
+		else if (deStringEqual(arg, "--format=csv"))
+			cmdLine.format = OUTPUTFORMAT_CSV;
+		else if (deStringEqual(arg, "--format=binary"))
+			cmdLine.format = OUTPUTFORMAT_BINARY;
+		else if (deStringEqual(arg, "--compress"))
+			cmdLine.compression = xe::samplelist::COMPRESSION_DEFLATE;
+		else
+			return false;
+	}
+
+	if (cmdLine.filename.empty())
+		return false;
+
+	// Compression is only supported by binary format.
+	if (cmdLine.compression != xe::samplelist::COMPRESSION_NONE && cmdLine.format != OUTPUTFORMAT_BINARY)
+		return false;
+
+	return true;
+}
+
 int main (int argc, const char* const* argv)
 {
-	if (argc != 2)
+	CommandLine cmdLine;
+
+	if (!parseCommandLine(cmdLine, argc, argv))
 	{
-		printf("%s: [filename]\n", de::FilePath(argv[0]).getBaseName().c_str());
+		printHelp(de::FilePath(argv[0]).getBaseName().c_str());
 		return -1;
 	}
 
 	try
 	{
-		processLogFile(argv[1]);
+		processLogFile(cmdLine);
 	}
 	catch (const std::exception& e)
 	{
@@ -21,7 +21,8 @@
  * \brief Extract shader programs from log.
  *//*--------------------------------------------------------------------*/
 
-#include "xeTestLogParser.hpp"
+#include "xeTestLogIndex.hpp"
+#include "xeParallelTestLogParser.hpp"
 #include "xeTestResultParser.hpp"
 #include "deFilePath.hpp"
 #include "deStringUtil.hpp"
@@ -43,11 +44,14 @@ using std::map;
 struct CommandLine
 {
 	CommandLine (void)
+		: numThreads(0)
 	{
 	}
 
 	string		filename;
 	string		dstPath;
+	string		casePath;
+	int			numThreads;
 };
 
 static const char* getShaderTypeSuffix (const xe::ri::Shader::ShaderType shaderType)
@@ -128,7 +132,7 @@ static void extractShaderPrograms (const CommandLine& cmdLine, const std::string
 		std::cout << "WARNING: no shader programs found in '" << casePath << "'\n";
 }
 
-class ShaderProgramExtractHandler : public xe::TestLogHandler
+class ShaderProgramExtractHandler : public xe::ParallelTestLogHandler
 {
 public:
 	ShaderProgramExtractHandler (const CommandLine& cmdLine)
@@ -141,64 +145,47 @@ public:
 		// Ignored.
 	}
 
-	xe::TestCaseResultPtr startTestCaseResult (const char* casePath)
-	{
-		return xe::TestCaseResultPtr(new xe::TestCaseResultData(casePath));
-	}
-
-	void testCaseResultUpdated (const xe::TestCaseResultPtr&)
-	{
-		// Ignored.
-	}
-
-	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData)
+	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData, const xe::TestCaseResult& fullResult, xe::TestResultParser::ParseResult)
 	{
 		if (caseData->getDataSize() > 0)
-		{
-			xe::TestCaseResult					fullResult;
-			xe::TestResultParser::ParseResult	parseResult;
-
-			m_testResultParser.init(&fullResult);
-			parseResult = m_testResultParser.parse(caseData->getData(), caseData->getDataSize());
-			DE_UNREF(parseResult);
-
 			extractShaderPrograms(m_cmdLine, caseData->getTestCasePath(), fullResult);
-		}
 	}
 
 private:
 	const CommandLine&		m_cmdLine;
-	xe::TestResultParser	m_testResultParser;
 };
 
-static void extractShaderProgramsFromLogFile (const CommandLine& cmdLine)
+static void extractShaderProgramsFromCase (const CommandLine& cmdLine)
 {
-	std::ifstream					in				(cmdLine.filename.c_str(), std::ifstream::binary|std::ifstream::in);
-	ShaderProgramExtractHandler		resultHandler	(cmdLine);
-	xe::TestLogParser				parser			(&resultHandler);
-	deUint8							buf				[1024];
-	int								numRead			= 0;
+	// Single case lookups use sidecar index to avoid re-scanning large logs.
+	const xe::TestLogIndex	index		(cmdLine.filename.c_str(), xe::TestLogIndex::INDEXMODE_SIDECAR);
+	const int				caseNdx		= index.findCase(cmdLine.casePath.c_str());
 
-	if (!in.good())
-		throw std::runtime_error(string("Failed to open '") + cmdLine.filename + "'");
+	if (caseNdx < 0)
+		throw std::runtime_error(string("Test case '") + cmdLine.casePath + "' not found in '" + cmdLine.filename + "'");
 
-	for (;;)
+	if (index.getCase(caseNdx).dataSize > 0)
 	{
-		in.read((char*)&buf[0], DE_LENGTH_OF_ARRAY(buf));
-		numRead = (int)in.gcount();
+		xe::TestResultParser	testResultParser;
+		xe::TestCaseResult		fullResult;
 
-		if (numRead <= 0)
-			break;
+		index.parseCaseResult(caseNdx, testResultParser, fullResult);
 
-		parser.parse(&buf[0], numRead);
+		extractShaderPrograms(cmdLine, cmdLine.casePath, fullResult);
 	}
+}
 
-	in.close();
+static void extractShaderProgramsFromLogFile (const CommandLine& cmdLine)
+{
+	ShaderProgramExtractHandler		resultHandler	(cmdLine);
+	xe::ParallelTestLogParser		parser			(&resultHandler, xe::getNumWorkerThreads(cmdLine.numThreads));
+
+	parser.parseFile(cmdLine.filename.c_str());
 }
 
 static void printHelp (const char* binName)
 {
-	printf("%s: [filename] [dst path (optional)]\n", binName);
+	printf("%s: [--case=<test case path>] [--threads=<n>] [filename] [dst path (optional)]\n", binName);
 }
 
 static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
@@ -216,6 +203,10 @@ static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const*
 			else
 				return false;
 		}
+		else if (deStringBeginsWith(arg, "--case="))
+			cmdLine.casePath = arg+7;
+		else if (deStringBeginsWith(arg, "--threads="))
+			cmdLine.numThreads = atoi(arg+10);
 		else
 			return false;
 	}
@@ -238,7 +229,10 @@ int main (int argc, const char* const* argv)
 			return -1;
 		}
 
-		extractShaderProgramsFromLogFile(cmdLine);
+		if (!cmdLine.casePath.empty())
+			extractShaderProgramsFromCase(cmdLine);
+		else
+			extractShaderProgramsFromLogFile(cmdLine);
 	}
 	catch (const std::exception& e)
 	{
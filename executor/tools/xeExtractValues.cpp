@@ -21,7 +21,7 @@
  * \brief Extract values by name from logs.
  *//*--------------------------------------------------------------------*/
 
-#include "xeTestLogParser.hpp"
+#include "xeParallelTestLogParser.hpp"
 #include "xeTestResultParser.hpp"
 #include "deFilePath.hpp"
 #include "deString.h"
@@ -30,7 +30,6 @@
 #include <string>
 #include <cstdio>
 #include <cstdlib>
-#include <fstream>
 #include <iostream>
 #include <stdexcept>
 
@@ -42,13 +41,15 @@ using std::map;
 struct CommandLine
 {
 	CommandLine (void)
-		: statusCode(false)
+		: statusCode	(false)
+		, numThreads	(0)
 	{
 	}
 
 	string			filename;
 	vector<string>	tagNames;
 	bool			statusCode;
+	int				numThreads;
 };
 
 typedef xe::ri::NumericValue Value;
@@ -123,7 +124,7 @@ static Value findValueByTag (const xe::ri::List& items, const string& tagName)
 	return Value();
 }
 
-class TagParser : public xe::TestLogHandler
+class TagParser : public xe::ParallelTestLogHandler
 {
 public:
 	TagParser (BatchResultValues& result)
@@ -136,17 +137,7 @@ public:
 		// Ignored.
 	}
 
-	xe::TestCaseResultPtr startTestCaseResult (const char* casePath)
-	{
-		return xe::TestCaseResultPtr(new xe::TestCaseResultData(casePath));
-	}
-
-	void testCaseResultUpdated (const xe::TestCaseResultPtr&)
-	{
-		// Ignored.
-	}
-
-	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData)
+	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData, const xe::TestCaseResult& fullResult, xe::TestResultParser::ParseResult parseResult)
 	{
 		const vector<string>&	tagNames	= m_result.getTagNames();
 		CaseValues				tagResult;
@@ -159,24 +150,9 @@ public:
 
 		if (caseData->getDataSize() > 0 && caseData->getStatusCode() == xe::TESTSTATUSCODE_LAST)
 		{
-			xe::TestCaseResult					fullResult;
-			xe::TestResultParser::ParseResult	parseResult;
-
-			m_testResultParser.init(&fullResult);
-			parseResult = m_testResultParser.parse(caseData->getData(), caseData->getDataSize());
-
-			if ((parseResult != xe::TestResultParser::PARSERESULT_ERROR && fullResult.statusCode != xe::TESTSTATUSCODE_LAST) ||
-				(tagResult.statusCode == xe::TESTSTATUSCODE_LAST && fullResult.statusCode != xe::TESTSTATUSCODE_LAST))
-			{
-				tagResult.statusCode	= fullResult.statusCode;
-				tagResult.statusDetails	= fullResult.statusDetails;
-			}
-			else if (tagResult.statusCode == xe::TESTSTATUSCODE_LAST)
-			{
-				DE_ASSERT(parseResult == xe::TestResultParser::PARSERESULT_ERROR);
-				tagResult.statusCode	= xe::TESTSTATUSCODE_INTERNAL_ERROR;
-				tagResult.statusDetails	= "Test case result parsing failed";
-			}
+			// \note Status code is already resolved by parseTestCaseResultFromData().
+			tagResult.statusCode	= fullResult.statusCode;
+			tagResult.statusDetails	= fullResult.statusDetails;
 
 			if (parseResult != xe::TestResultParser::PARSERESULT_ERROR)
 			{
@@ -190,39 +166,21 @@ public:
 
 private:
 	BatchResultValues&		m_result;
-	xe::TestResultParser	m_testResultParser;
 };
 
-static void readLogFile (BatchResultValues& batchResult, const char* filename)
+static void readLogFile (BatchResultValues& batchResult, const char* filename, int numThreads)
 {
-	std::ifstream		in				(filename, std::ifstream::binary|std::ifstream::in);
-	TagParser			resultHandler	(batchResult);
-	xe::TestLogParser	parser			(&resultHandler);
-	deUint8				buf				[1024];
-	int					numRead			= 0;
-
-	if (!in.good())
-		throw std::runtime_error(string("Failed to open '") + filename + "'");
-
-	for (;;)
-	{
-		in.read((char*)&buf[0], DE_LENGTH_OF_ARRAY(buf));
-		numRead = (int)in.gcount();
-
-		if (numRead <= 0)
-			break;
-
-		parser.parse(&buf[0], numRead);
-	}
+	TagParser					resultHandler	(batchResult);
+	xe::ParallelTestLogParser	parser			(&resultHandler, xe::getNumWorkerThreads(numThreads));
 
-	in.close();
+	parser.parseFile(filename);
 }
 
 static void printTaggedValues (const CommandLine& cmdLine, std::ostream& dst)
 {
 	BatchResultValues values(cmdLine.tagNames);
 
-	readLogFile(values, cmdLine.filename.c_str());
+	readLogFile(values, cmdLine.filename.c_str(), cmdLine.numThreads);
 
 	// Header
 	{
@@ -255,6 +213,7 @@ static void printHelp (const char* binName)
 {
 	printf("%s: [filename] [name 1] [[name 2]...]\n", binName);
 	printf(" --statuscode     Include status code as first entry.\n");
+	printf(" --threads=<n>    Number of worker threads (1 = no threads, 0 = number of CPU cores).\n");
 }
 
 static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const* argv)
@@ -265,6 +224,8 @@ static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const*
 
 		if (deStringEqual(arg, "--statuscode"))
 			cmdLine.statusCode = true;
+		else if (deStringBeginsWith(arg, "--threads="))
+			cmdLine.numThreads = atoi(arg+10);
 		else if (!deStringBeginsWith(arg, "--"))
 		{
 			if (cmdLine.filename.empty())
@@ -23,7 +23,7 @@
  * \todo [2013-11-08 pyry] Write variant that can operate with less memory.
  *//*--------------------------------------------------------------------*/
 
-#include "xeTestLogParser.hpp"
+#include "xeParallelTestLogParser.hpp"
 #include "xeTestResultParser.hpp"
 #include "xeTestLogWriter.hpp"
 #include "deString.h"
@@ -32,7 +32,6 @@
 #include <string>
 #include <cstdio>
 #include <cstdlib>
-#include <fstream>
 #include <iostream>
 #include <stdexcept>
 
@@ -58,7 +57,7 @@ struct CommandLine
 	deUint32		flags;
 };
 
-class LogHandler : public xe::TestLogHandler
+class LogHandler : public xe::ParallelTestLogHandler
 {
 public:
 	LogHandler (xe::BatchResult* batchResult, deUint32 flags)
@@ -93,26 +92,14 @@ public:
 		}
 	}
 
-	xe::TestCaseResultPtr startTestCaseResult (const char* casePath)
+	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData, const xe::TestCaseResult&, xe::TestResultParser::ParseResult)
 	{
-		if (m_batchResult->hasTestCaseResult(casePath))
-		{
-			xe::TestCaseResultPtr existingResult = m_batchResult->getTestCaseResult(casePath);
-			existingResult->clear();
-			return existingResult;
-		}
-		else
-			return m_batchResult->createTestCaseResult(casePath);
-	}
-
-	void testCaseResultUpdated (const xe::TestCaseResultPtr&)
-	{
-		// Ignored.
+		m_batchResult->setTestCaseResult(caseData);
 	}
 
-	void testCaseResultComplete (const xe::TestCaseResultPtr&)
+	void testCaseResultIncomplete (const xe::TestCaseResultPtr& caseData)
 	{
-		// Ignored.
+		m_batchResult->setTestCaseResult(caseData);
 	}
 
 private:
@@ -122,27 +109,11 @@ private:
 
 static void readLogFile (xe::BatchResult* dstResult, const char* filename, deUint32 flags)
 {
-	std::ifstream		in				(filename, std::ifstream::binary|std::ifstream::in);
-	LogHandler			resultHandler	(dstResult, flags);
-	xe::TestLogParser	parser			(&resultHandler);
-	deUint8				buf				[2048];
-	int					numRead			= 0;
-
-	if (!in.good())
-		throw std::runtime_error(string("Failed to open '") + filename + "'");
-
-	for (;;)
-	{
-		in.read((char*)&buf[0], DE_LENGTH_OF_ARRAY(buf));
-		numRead = (int)in.gcount();
-
-		if (numRead <= 0)
-			break;
-
-		parser.parse(&buf[0], numRead);
-	}
+	// \note Results are merged as is, so only reading and splitting is offloaded to another thread.
+	LogHandler					resultHandler	(dstResult, flags);
+	xe::ParallelTestLogParser	parser			(&resultHandler, 1, false);
 
-	in.close();
+	parser.parseFile(filename);
 }
 
 static void mergeTestLogs (const CommandLine& cmdLine)
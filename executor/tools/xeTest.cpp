@@ -0,0 +1,597 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Test Executor Tests.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeDefs.hpp"
+#include "xeTestLogParser.hpp"
+#include "xeParallelTestLogParser.hpp"
+#include "xeTestResultParser.hpp"
+#include "xeBatchExecutor.hpp"
+#include "deStringUtil.hpp"
+#include "deString.h"
+#include "deMemory.h"
+
+#include <vector>
+#include <string>
+#include <map>
+#include <sstream>
+#include <cstdio>
+#include <cstring>
+#include <set>
+
+using std::string;
+using std::vector;
+
+namespace xe
+{
+
+// Records handler calls in a comparable form.
+class EventLog
+{
+public:
+	EventLog (int maxCompleteResults)
+		: m_numCompleteResultsLeft(maxCompleteResults)
+	{
+	}
+
+	void setSessionInfo (const SessionInfo& sessionInfo)
+	{
+		m_events.push_back("session " + sessionInfo.releaseName + " " + sessionInfo.targetName);
+	}
+
+	void testCaseResultComplete (const TestCaseResult& result, TestResultParser::ParseResult parseResult)
+	{
+		// Simulates handler failing in the middle of log.
+		if (m_numCompleteResultsLeft-- == 0)
+			throw Error("Handler failed at " + result.casePath);
+
+		m_events.push_back(string("complete ") + result.casePath
+						   + " " + de::toString((int)parseResult)
+						   + " " + getTestStatusCodeName(result.statusCode)
+						   + " " + result.statusDetails
+						   + " " + de::toString(result.resultItems.getNumItems()));
+	}
+
+	void testCaseResultIncomplete (const TestCaseResultData& data)
+	{
+		m_events.push_back(string("incomplete ") + data.getTestCasePath());
+	}
+
+	void setError (const string& error)
+	{
+		m_events.push_back("error " + error);
+	}
+
+	const vector<string>& getEvents (void) const { return m_events; }
+
+private:
+	int				m_numCompleteResultsLeft;
+	vector<string>	m_events;
+};
+
+// Reference: TestLogParser with results parsed in handler.
+class ReferenceHandler : public TestLogHandler
+{
+public:
+	ReferenceHandler (EventLog& log)
+		: m_log(log)
+	{
+	}
+
+	void setSessionInfo (const SessionInfo& sessionInfo)
+	{
+		m_log.setSessionInfo(sessionInfo);
+	}
+
+	TestCaseResultPtr startTestCaseResult (const char* casePath)
+	{
+		flushIncomplete();
+
+		m_curResult = TestCaseResultPtr(new TestCaseResultData(casePath));
+		return m_curResult;
+	}
+
+	void testCaseResultUpdated (const TestCaseResultPtr&)
+	{
+	}
+
+	void testCaseResultComplete (const TestCaseResultPtr& data)
+	{
+		TestCaseResult					result;
+		TestResultParser::ParseResult	parseResult;
+
+		m_curResult.clear();
+
+		parseResult = parseTestCaseResultFromData(&m_resultParser, &result, *data);
+		m_log.testCaseResultComplete(result, parseResult);
+	}
+
+	void flushIncomplete (void)
+	{
+		if (m_curResult)
+		{
+			const TestCaseResultPtr data = m_curResult;
+			m_curResult.clear();
+			m_log.testCaseResultIncomplete(*data);
+		}
+	}
+
+private:
+	EventLog&			m_log;
+	TestResultParser	m_resultParser;
+	TestCaseResultPtr	m_curResult;
+};
+
+class ParallelHandler : public ParallelTestLogHandler
+{
+public:
+	ParallelHandler (EventLog& log)
+		: m_log(log)
+	{
+	}
+
+	void setSessionInfo (const SessionInfo& sessionInfo)
+	{
+		m_log.setSessionInfo(sessionInfo);
+	}
+
+	void testCaseResultComplete (const TestCaseResultPtr&, const TestCaseResult& result, TestResultParser::ParseResult parseResult)
+	{
+		m_log.testCaseResultComplete(result, parseResult);
+	}
+
+	void testCaseResultIncomplete (const TestCaseResultPtr& data)
+	{
+		m_log.testCaseResultIncomplete(*data);
+	}
+
+private:
+	EventLog&	m_log;
+};
+
+enum
+{
+	NO_HANDLER_FAILURE	= -1
+};
+
+static vector<string> parseReference (const string& log, int maxCompleteResults)
+{
+	EventLog			events		(maxCompleteResults);
+	ReferenceHandler	handler		(events);
+	TestLogParser		parser		(&handler);
+
+	try
+	{
+		parser.parse((const deUint8*)log.c_str(), (int)log.size());
+		handler.flushIncomplete();
+	}
+	catch (const std::exception& e)
+	{
+		events.setError(e.what());
+	}
+
+	return events.getEvents();
+}
+
+static vector<string> parseParallel (const string& log, int maxCompleteResults, int numWorkers)
+{
+	EventLog				events		(maxCompleteResults);
+	ParallelHandler			handler		(events);
+	ParallelTestLogParser	parser		(&handler, numWorkers);
+	std::istringstream		in			(log);
+
+	try
+	{
+		parser.parse(in);
+	}
+	catch (const std::exception& e)
+	{
+		events.setError(e.what());
+	}
+
+	return events.getEvents();
+}
+
+static string genTestCaseResult (const string& casePath, const char* statusCode)
+{
+	return "#beginTestCaseResult " + casePath + "\n"
+		   "<TestCaseResult Version=\"0.3.3\" CasePath=\"" + casePath + "\" CaseType=\"SelfValidate\">\n"
+		   "<Text>Hello</Text>\n"
+		   "<Number Name=\"Value\" Description=\"Value\" Tag=\"Quality\" Unit=\"\">" + de::toString(casePath.size()) + "</Number>\n"
+		   "<Result StatusCode=\"" + statusCode + "\">Details</Result>\n"
+		   "</TestCaseResult>\n"
+		   "#endTestCaseResult\n";
+}
+
+// Log with all kinds of results: passing, failing, crashed, malformed, incomplete and unparseable.
+static string genTestLog (int numCases, const string& tail)
+{
+	string log = "#sessionInfo releaseName test\n"
+				 "#sessionInfo targetName default\n"
+				 "#beginSession\n";
+
+	for (int caseNdx = 0; caseNdx < numCases; caseNdx++)
+	{
+		const string casePath = "dEQP-TEST.group" + de::toString(caseNdx/10) + ".case" + de::toString(caseNdx);
+
+		switch (caseNdx % 7)
+		{
+			case 0:	log += genTestCaseResult(casePath, "Pass");											break;
+			case 1:	log += genTestCaseResult(casePath, "Fail");											break;
+			case 2:	log += "#beginTestCaseResult " + casePath + "\n<TestCaseResult Version=\"0.3.3\" CasePath=\"" + casePath + "\" CaseType=\"SelfValidate\">\n#terminateTestCaseResult Crash\n";	break;
+			case 3:	log += "#beginTestCaseResult " + casePath + "\n<TestCaseResult Version=\"0.3.3\" <Result\n#endTestCaseResult\n";	break;
+			case 4:	log += "#beginTestCaseResult " + casePath + "\n<TestCaseResult Version=\"0.3.3\"\n";	break; // Never finished.
+			case 5:	log += "#beginTestCaseResult " + casePath + "\n#endTestCaseResult\n";				break;
+			case 6:	log += genTestCaseResult(casePath, "QualityWarning");								break;
+			default:
+				DE_ASSERT(false);
+		}
+	}
+
+	return log + tail;
+}
+
+static void checkParallelParser (const string& log, int maxCompleteResults)
+{
+	const vector<string>	reference		= parseReference(log, maxCompleteResults);
+	const int				numWorkers[]	= { 1, 2, 4, 7 };
+
+	XE_CHECK(!reference.empty());
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(numWorkers); ndx++)
+	{
+		const vector<string> result = parseParallel(log, maxCompleteResults, numWorkers[ndx]);
+
+		for (int eventNdx = 0; eventNdx < (int)de::min(reference.size(), result.size()); eventNdx++)
+		{
+			if (reference[eventNdx] != result[eventNdx])
+				throw Error("Event " + de::toString(eventNdx) + " with " + de::toString(numWorkers[ndx]) + " workers: got '" + result[eventNdx] + "', expected '" + reference[eventNdx] + "'");
+		}
+
+		if (reference.size() != result.size())
+			throw Error("Got " + de::toString(result.size()) + " events with " + de::toString(numWorkers[ndx]) + " workers, expected " + de::toString(reference.size()));
+	}
+}
+
+static void testParallelParserOrder (void)
+{
+	checkParallelParser(genTestLog(3, "#endSession\n"), NO_HANDLER_FAILURE);
+	checkParallelParser(genTestLog(500, "#endSession\n"), NO_HANDLER_FAILURE);
+}
+
+static void testParallelParserLogError (void)
+{
+	// Second #beginSession makes TestLogParser throw.
+	const string			log			= genTestLog(100, "#beginSession\n");
+	const vector<string>	reference	= parseReference(log, NO_HANDLER_FAILURE);
+
+	XE_CHECK(deStringBeginsWith(reference.back().c_str(), "error "));
+	checkParallelParser(log, NO_HANDLER_FAILURE);
+}
+
+static void testParallelParserResultError (void)
+{
+	// Empty case path makes parseTestCaseResultFromData() throw.
+	const string			log			= genTestLog(40, genTestCaseResult("", "Pass") + genTestCaseResult("dEQP-TEST.last", "Pass") + "#endSession\n");
+	const vector<string>	reference	= parseReference(log, NO_HANDLER_FAILURE);
+
+	XE_CHECK(reference.back() == "error Empty test case path in result");
+	checkParallelParser(log, NO_HANDLER_FAILURE);
+}
+
+static void testParallelParserHandlerError (void)
+{
+	const string log = genTestLog(200, "#endSession\n");
+
+	checkParallelParser(log, 0);
+	checkParallelParser(log, 1);
+	checkParallelParser(log, 37);
+}
+
+static TestResultParser::ParseResult parseResultString (TestCaseResult* result, const string& data)
+{
+	TestResultParser parser;
+
+	// \note Terminating null marks end of data.
+	return parseTestCaseResultFromData(&parser, result, "dEQP-TEST.images", TESTSTATUSCODE_LAST, "", (const deUint8*)data.c_str(), (int)data.size()+1);
+}
+
+static string genImage (const string& name, const string& extraAttribs, const string& data)
+{
+	return "<Image Name=\"" + name + "\" Description=\"\" Width=\"1\" Height=\"1\" Format=\"RGBA8888\" CompressionMode=\"None\"" + extraAttribs + ">" + data + "</Image>\n";
+}
+
+static void testImageDuplicateOf (void)
+{
+	const string header	= "<TestCaseResult Version=\"0.3.3\" CasePath=\"dEQP-TEST.images\" CaseType=\"SelfValidate\">\n";
+	const string footer	= "<Result StatusCode=\"Pass\">Details</Result>\n</TestCaseResult>\n";
+
+	// Duplicate gets data of image with matching ContentHash.
+	{
+		TestCaseResult result;
+
+		XE_CHECK(parseResultString(&result, header
+										   + genImage("A", " ContentHash=\"00000000000000aa\"", "AQIDBA==")
+										   + genImage("B", " ContentHash=\"00000000000000bb\"", "BQYHCA==")
+										   + genImage("A2", " DuplicateOf=\"00000000000000aa\"", "")
+										   + footer) == TestResultParser::PARSERESULT_COMPLETE);
+		XE_CHECK(result.statusCode == TESTSTATUSCODE_PASS);
+		XE_CHECK(result.resultItems.getNumItems() == 4);
+
+		{
+			const ri::Image& image		= static_cast<const ri::Image&>(result.resultItems.getItem(0));
+			const ri::Image& duplicate	= static_cast<const ri::Image&>(result.resultItems.getItem(2));
+
+			XE_CHECK(duplicate.getType() == ri::TYPE_IMAGE);
+			XE_CHECK(duplicate.data.size() == 4 && image.data.size() == 4);
+			XE_CHECK(deMemCmp(duplicate.data.getPtr(), image.data.getPtr(), 4) == 0);
+			XE_CHECK(duplicate.data[0] == 1 && duplicate.data[3] == 4);
+		}
+	}
+
+	// Reference to image that is not in the same result is an error.
+	{
+		TestCaseResult result;
+
+		XE_CHECK(parseResultString(&result, header
+										   + genImage("A", " DuplicateOf=\"00000000000000aa\"", "")
+										   + footer) == TestResultParser::PARSERESULT_ERROR);
+		XE_CHECK(result.statusCode == TESTSTATUSCODE_INTERNAL_ERROR);
+	}
+}
+
+// Returns case paths in case list string written by executor.
+static void parseCaseList (vector<string>& dst, const string& prefix, const char*& pos)
+{
+	XE_CHECK(*pos == '{');
+	pos += 1;
+
+	while (*pos != '}')
+	{
+		const char*		nameEnd	= pos + strcspn(pos, "{,}");
+		const string	path	= prefix + string(pos, nameEnd);
+
+		pos = nameEnd;
+
+		if (*pos == '{')
+			parseCaseList(dst, prefix.empty() && path.empty() ? string() : path + ".", pos);
+		else
+			dst.push_back(path);
+
+		if (*pos == ',')
+			pos += 1;
+	}
+
+	pos += 1;
+}
+
+// Simulated test process. Crashes in cases listed in crashCases and
+// fails to launch if launchFails is set.
+class FakeCommLink : public CommLink
+{
+public:
+	FakeCommLink (const std::set<string>& crashCases, std::map<string, int>& numExecutions, bool launchFails)
+		: m_crashCases		(crashCases)
+		, m_numExecutions	(numExecutions)
+		, m_launchFails		(launchFails)
+		, m_state			(COMMLINKSTATE_READY)
+		, m_stateChanged	(DE_NULL)
+		, m_testLogData		(DE_NULL)
+		, m_userPtr			(DE_NULL)
+	{
+	}
+
+	void reset (void)
+	{
+		m_state = COMMLINKSTATE_READY;
+	}
+
+	CommLinkState getState (void) const
+	{
+		return m_state;
+	}
+
+	CommLinkState getState (string& error) const
+	{
+		error.clear();
+		return m_state;
+	}
+
+	void setCallbacks (StateChangedFunc stateChangedCallback, LogDataFunc testLogDataCallback, LogDataFunc, void* userPtr)
+	{
+		m_stateChanged	= stateChangedCallback;
+		m_testLogData	= testLogDataCallback;
+		m_userPtr		= userPtr;
+	}
+
+	void startTestProcess (const char*, const char*, const char*, const char* caseList)
+	{
+		vector<string>	casePaths;
+		const char*		pos			= caseList;
+		string			log			= "#sessionInfo releaseName test\n#beginSession\n";
+
+		XE_CHECK(m_state == COMMLINKSTATE_READY);
+
+		if (m_launchFails)
+		{
+			setState(COMMLINKSTATE_TEST_PROCESS_LAUNCH_FAILED, "Launch failed");
+			return;
+		}
+
+		parseCaseList(casePaths, "", pos);
+
+		for (vector<string>::const_iterator caseIter = casePaths.begin(); caseIter != casePaths.end(); ++caseIter)
+		{
+			m_numExecutions[*caseIter] += 1;
+
+			if (m_crashCases.find(*caseIter) != m_crashCases.end())
+			{
+				log += "#beginTestCaseResult " + *caseIter + "\n<TestCaseResult Version=\"0.3.3\" CasePath=\"" + *caseIter + "\" CaseType=\"SelfValidate\">\n#terminateTestCaseResult Crash\n";
+				break;
+			}
+
+			log += genTestCaseResult(*caseIter, "Pass");
+		}
+
+		setState(COMMLINKSTATE_TEST_PROCESS_RUNNING, "");
+		m_testLogData(m_userPtr, (const deUint8*)log.c_str(), (int)log.size());
+		setState(COMMLINKSTATE_TEST_PROCESS_FINISHED, "");
+	}
+
+	void stopTestProcess (void)
+	{
+	}
+
+private:
+	void setState (CommLinkState state, const char* message)
+	{
+		m_state = state;
+		m_stateChanged(m_userPtr, state, message);
+	}
+
+	const std::set<string>&		m_crashCases;
+	std::map<string, int>&		m_numExecutions;
+	const bool					m_launchFails;
+	CommLinkState				m_state;
+
+	StateChangedFunc			m_stateChanged;
+	LogDataFunc					m_testLogData;
+	void*						m_userPtr;
+};
+
+static void testShardedBatchExecutor (void)
+{
+	TestRoot				root;
+	vector<string>			casePaths;
+	std::set<string>		crashCases;
+	std::map<string, int>	numExecutions;
+	TestSet					testSet;
+	BatchResult				batchResult;
+	CaseDurationMap			durations;
+
+	{
+		TestHierarchyBuilder builder(&root);
+
+		for (int caseNdx = 0; caseNdx < 40; caseNdx++)
+		{
+			casePaths.push_back("dEQP-TEST.group" + de::toString(caseNdx/10) + ".case" + de::toString(caseNdx));
+			builder.createCase(casePaths.back().c_str(), TESTCASETYPE_SELF_VALIDATE);
+		}
+	}
+
+	testSet.add(&root);
+
+	// Crashes leave rest of session unexecuted, remaining cases must be requeued.
+	crashCases.insert(casePaths[3]);
+	crashCases.insert(casePaths[17]);
+	crashCases.insert(casePaths[18]);
+
+	// Previously executed case is not run again.
+	batchResult.createTestCaseResult(casePaths[0].c_str())->setTestResult(TESTSTATUSCODE_PASS, "Continued");
+
+	{
+		FakeCommLink			link0		(crashCases, numExecutions, false);
+		FakeCommLink			link1		(crashCases, numExecutions, true);
+		FakeCommLink			link2		(crashCases, numExecutions, false);
+		vector<CommLink*>		commLinks;
+		TargetConfiguration		config;
+
+		commLinks.push_back(&link0);
+		commLinks.push_back(&link1);
+		commLinks.push_back(&link2);
+		config.maxCasesPerSession = 7;
+
+		ShardedBatchExecutor executor(config, commLinks, &root, testSet, &batchResult, DE_NULL, &durations);
+		executor.run();
+	}
+
+	// Every case is executed once and results are merged in canonical order.
+	XE_CHECK(batchResult.getNumTestCaseResults() == (int)casePaths.size());
+	XE_CHECK(numExecutions.find(casePaths[0]) == numExecutions.end());
+
+	for (int caseNdx = 0; caseNdx < (int)casePaths.size(); caseNdx++)
+	{
+		const TestCaseResultPtr		data		= batchResult.getTestCaseResult(caseNdx);
+		const bool					isCrash		= crashCases.find(casePaths[caseNdx]) != crashCases.end();
+		TestResultParser			parser;
+		TestCaseResult				result;
+
+		XE_CHECK(casePaths[caseNdx] == data->getTestCasePath());
+
+		parseTestCaseResultFromData(&parser, &result, *data);
+		XE_CHECK(isCrash ? result.statusCode == TESTSTATUSCODE_CRASH : result.statusCode == TESTSTATUSCODE_PASS);
+
+		if (caseNdx > 0)
+		{
+			XE_CHECK(numExecutions[casePaths[caseNdx]] == 1);
+			XE_CHECK(durations.find(casePaths[caseNdx]) != durations.end());
+		}
+	}
+}
+
+static void testNumWorkerThreads (void)
+{
+	XE_CHECK(getNumWorkerThreads(1) == 1);
+	XE_CHECK(getNumWorkerThreads(5) == 5);
+	XE_CHECK(getNumWorkerThreads(0) >= 1);
+}
+
+} // xe
+
+int main (void)
+{
+	struct
+	{
+		const char*	name;
+		void		(*func)	(void);
+	} tests[] =
+	{
+		{ "num_worker_threads",				xe::testNumWorkerThreads			},
+		{ "parallel_parser_order",			xe::testParallelParserOrder			},
+		{ "parallel_parser_log_error",		xe::testParallelParserLogError		},
+		{ "parallel_parser_result_error",	xe::testParallelParserResultError	},
+		{ "parallel_parser_handler_error",	xe::testParallelParserHandlerError	},
+		{ "image_duplicate_of",				xe::testImageDuplicateOf			},
+		{ "sharded_batch_executor",			xe::testShardedBatchExecutor		},
+	};
+	int numFailed = 0;
+
+	for (int testNdx = 0; testNdx < DE_LENGTH_OF_ARRAY(tests); testNdx++)
+	{
+		printf("%s: ", tests[testNdx].name);
+
+		try
+		{
+			tests[testNdx].func();
+			printf("OK\n");
+		}
+		catch (const std::exception& e)
+		{
+			printf("FAIL: %s\n", e.what());
+			numFailed += 1;
+		}
+	}
+
+	printf("%d/%d tests passed\n", DE_LENGTH_OF_ARRAY(tests)-numFailed, DE_LENGTH_OF_ARRAY(tests));
+
+	return numFailed == 0 ? 0 : -1;
+}
@@ -21,18 +21,18 @@
  * \brief Test log compare utility.
  *//*--------------------------------------------------------------------*/
 
-#include "xeTestLogParser.hpp"
+#include "xeTestLogIndex.hpp"
 #include "xeTestResultParser.hpp"
 #include "deFilePath.hpp"
 #include "deString.h"
-#include "deThread.hpp"
+#include "deWorkerPool.hpp"
+#include "deSharedPtr.hpp"
 #include "deCommandLine.hpp"
 
 #include <vector>
 #include <string>
 #include <cstdio>
 #include <cstdlib>
-#include <fstream>
 #include <iostream>
 #include <set>
 #include <map>
@@ -72,6 +72,7 @@ namespace opt
 DE_DECLARE_COMMAND_LINE_OPT(OutMode,	OutputMode);
 DE_DECLARE_COMMAND_LINE_OPT(OutFormat,	OutputFormat);
 DE_DECLARE_COMMAND_LINE_OPT(OutValue,	OutputValue);
+DE_DECLARE_COMMAND_LINE_OPT(Threads,	int);
 
 static void registerOptions (de::cmdline::Parser& parser)
 {
@@ -96,7 +97,8 @@ static void registerOptions (de::cmdline::Parser& parser)
 
 	parser << Option<OutFormat>		("f",	"format",		"Output format",	s_outputFormats,	"csv")
 		   << Option<OutMode>		("m",	"mode",			"Output mode",		s_outputModes,		"all")
-		   << Option<OutValue>		("v",	"value",		"Value to extract",	s_outputValues,		"code");
+		   << Option<OutValue>		("v",	"value",		"Value to extract",	s_outputValues,		"code")
+		   << Option<Threads>		("j",	"threads",		"Number of worker threads (1 = no threads, 0 = number of CPU cores)",	"0");
 }
 
 } // opt
@@ -107,12 +109,14 @@ struct CommandLine
 		: outMode	(OUTPUTMODE_ALL)
 		, outFormat	(OUTPUTFORMAT_CSV)
 		, outValue	(OUTPUTVALUE_STATUS_CODE)
+		, numThreads(0)
 	{
 	}
 
 	OutputMode			outMode;
 	OutputFormat		outFormat;
 	OutputValue			outValue;
+	int					numThreads;
 	vector<string>		filenames;
 };
 
@@ -122,99 +126,58 @@ struct ShortBatchResult
 	map<string, int>					resultMap;
 };
 
-class ShortResultHandler : public xe::TestLogHandler
+class ResultHeaderParseJob : public de::WorkerPool::Job
 {
 public:
-	ShortResultHandler (ShortBatchResult& result)
-		: m_result(result)
+	ResultHeaderParseJob (const xe::TestLogIndex& index, vector<xe::TestCaseResultHeader>& headers, int numWorkers)
+		: m_index	(index)
+		, m_headers	(headers)
 	{
+		for (int ndx = 0; ndx < numWorkers; ndx++)
+			m_parsers.push_back(de::SharedPtr<xe::TestResultParser>(new xe::TestResultParser()));
 	}
 
-	void setSessionInfo (const xe::SessionInfo&)
+	void execute (int caseNdx, int workerNdx)
 	{
-		// Ignored.
-	}
-
-	xe::TestCaseResultPtr startTestCaseResult (const char* casePath)
-	{
-		return xe::TestCaseResultPtr(new xe::TestCaseResultData(casePath));
-	}
-
-	void testCaseResultUpdated (const xe::TestCaseResultPtr&)
-	{
-		// Ignored.
-	}
-
-	void testCaseResultComplete (const xe::TestCaseResultPtr& caseData)
-	{
-		xe::TestCaseResultHeader	header;
-		int							caseNdx	= (int)m_result.resultHeaders.size();
+		const xe::TestLogIndex::CaseEntry&	entry	= m_index.getCase(caseNdx);
+		xe::TestCaseResultHeader&			header	= m_headers[caseNdx];
 
-		header.casePath			= caseData->getTestCasePath();
-		header.caseType			= xe::TESTCASETYPE_SELF_VALIDATE;
-		header.statusCode		= caseData->getStatusCode();
-		header.statusDetails	= caseData->getStatusDetails();
-
-		if (header.statusCode == xe::TESTSTATUSCODE_LAST)
+		if (entry.terminated)
+		{
+			header.casePath			= entry.casePath;
+			header.caseType			= xe::TESTCASETYPE_SELF_VALIDATE;
+			header.statusCode		= entry.statusCode;
+			header.statusDetails	= entry.statusDetails;
+		}
+		else
 		{
 			xe::TestCaseResult fullResult;
 
-			xe::parseTestCaseResultFromData(&m_testResultParser, &fullResult, *caseData.get());
+			m_index.parseCaseResult(caseNdx, *m_parsers[workerNdx], fullResult);
 
 			header = xe::TestCaseResultHeader(fullResult);
 		}
-
-		// Insert into result list & map.
-		m_result.resultHeaders.push_back(header);
-		m_result.resultMap[header.casePath] = caseNdx;
 	}
 
 private:
-	ShortBatchResult&		m_result;
-	xe::TestResultParser	m_testResultParser;
+	const xe::TestLogIndex&								m_index;
+	vector<xe::TestCaseResultHeader>&					m_headers;
+	vector<de::SharedPtr<xe::TestResultParser> >		m_parsers;
 };
 
-static void readLogFile (ShortBatchResult& batchResult, const char* filename)
+static void readLogFile (ShortBatchResult& batchResult, const char* filename, de::WorkerPool& workerPool)
 {
-	std::ifstream		in				(filename, std::ifstream::binary|std::ifstream::in);
-	ShortResultHandler	resultHandler	(batchResult);
-	xe::TestLogParser	parser			(&resultHandler);
-	deUint8				buf				[1024];
-	int					numRead			= 0;
-
-	for (;;)
-	{
-		in.read((char*)&buf[0], DE_LENGTH_OF_ARRAY(buf));
-		numRead = (int)in.gcount();
+	const xe::TestLogIndex	index	(filename);
+	ResultHeaderParseJob	job		(index, batchResult.resultHeaders, workerPool.getNumWorkers());
 
-		if (numRead <= 0)
-			break;
+	// Cases are parsed in parallel, each into its own slot.
+	batchResult.resultHeaders.resize(index.getNumCases());
+	workerPool.execute(job, index.getNumCases());
 
-		parser.parse(&buf[0], numRead);
-	}
-
-	in.close();
+	for (int caseNdx = 0; caseNdx < index.getNumCases(); caseNdx++)
+		batchResult.resultMap[batchResult.resultHeaders[caseNdx].casePath] = caseNdx;
 }
 
-class LogFileReader : public de::Thread
-{
-public:
-	LogFileReader (ShortBatchResult& batchResult, const char* filename)
-		: m_batchResult	(batchResult)
-		, m_filename	(filename)
-	{
-	}
-
-	void run (void)
-	{
-		readLogFile(m_batchResult, m_filename.c_str());
-	}
-
-private:
-	ShortBatchResult&	m_batchResult;
-	std::string			m_filename;
-};
-
 static void computeCaseList (vector<string>& cases, const vector<ShortBatchResult>& batchResults)
 {
 	// \todo [2012-07-10 pyry] Do proper case ordering (eg. handle missing cases nicely).
@@ -274,17 +237,11 @@ static bool runCompare (const CommandLine& cmdLine, std::ostream& dst)
 		// Read in batch results
 		results.resize(cmdLine.filenames.size());
 		{
-			std::vector<de::SharedPtr<LogFileReader> > readers;
-
-			for (int ndx = 0; ndx < (int)cmdLine.filenames.size(); ndx++)
-			{
-				readers.push_back(de::SharedPtr<LogFileReader>(new LogFileReader(results[ndx], cmdLine.filenames[ndx].c_str())));
-				readers.back()->start();
-			}
+			de::WorkerPool workerPool (xe::getNumWorkerThreads(cmdLine.numThreads));
 
 			for (int ndx = 0; ndx < (int)cmdLine.filenames.size(); ndx++)
 			{
-				readers[ndx]->join();
+				readLogFile(results[ndx], cmdLine.filenames[ndx].c_str(), workerPool);
 
 				// Use file name as batch name.
 				batchNames.push_back(de::FilePath(cmdLine.filenames[ndx].c_str()).getBaseName());
@@ -384,6 +341,7 @@ static bool parseCommandLine (CommandLine& cmdLine, int argc, const char* const*
 	cmdLine.outFormat	= opts.getOption<opt::OutFormat>();
 	cmdLine.outMode		= opts.getOption<opt::OutMode>();
 	cmdLine.outValue	= opts.getOption<opt::OutValue>();
+	cmdLine.numThreads	= opts.getOption<opt::Threads>();
 	cmdLine.filenames	= opts.getArgs();
 
 	return true;
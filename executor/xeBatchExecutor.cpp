@@ -23,6 +23,7 @@
 
 #include "xeBatchExecutor.hpp"
 #include "xeTestResultParser.hpp"
+#include "deClock.h"
 
 #include <sstream>
 #include <cstdio>
@@ -36,21 +37,25 @@ using std::vector;
 enum
 {
 	TEST_LOG_TMP_BUFFER_SIZE	= 1024,
-	INFO_LOG_TMP_BUFFER_SIZE	= 256
+	INFO_LOG_TMP_BUFFER_SIZE	= 256,
+
+	SHARD_BATCH_SPLIT_FACTOR	= 2		//!< Shard batch is at most 1/(numShards*SHARD_BATCH_SPLIT_FACTOR) of remaining work.
 };
 
 // \todo [2012-11-01 pyry] Update execute set in handler.
 
+static inline bool isExecuted (const TestCaseResultData& data)
+{
+	return data.getStatusCode() != TESTSTATUSCODE_PENDING && data.getStatusCode() != TESTSTATUSCODE_RUNNING;
+}
+
 static inline bool isExecutedInBatch (const BatchResult* batchResult, const TestCase* testCase)
 {
 	std::string fullPath;
 	testCase->getFullPath(fullPath);
 
 	if (batchResult->hasTestCaseResult(fullPath.c_str()))
-	{
-		ConstTestCaseResultPtr data = batchResult->getTestCaseResult(fullPath.c_str());
-		return data->getStatusCode() != TESTSTATUSCODE_PENDING && data->getStatusCode() != TESTSTATUSCODE_RUNNING;
-	}
+		return isExecuted(*batchResult->getTestCaseResult(fullPath.c_str()));
 	else
 		return false;
 }
@@ -331,14 +336,20 @@ static void writeCaseListNode (std::ostream& str, const TestNode* node, const Te
 	}
 }
 
-void BatchExecutor::launchTestSet (const TestSet& testSet)
+static std::string getCaseListString (const TestNode* root, const TestSet& testSet)
 {
 	std::ostringstream caseList;
-	XE_CHECK(testSet.hasNode(m_root));
-	XE_CHECK(m_root->getNodeType() == TESTNODETYPE_ROOT);
-	writeCaseListNode(caseList, m_root, testSet);
+	XE_CHECK(testSet.hasNode(root));
+	XE_CHECK(root->getNodeType() == TESTNODETYPE_ROOT);
+	writeCaseListNode(caseList, root, testSet);
+	return caseList.str();
+}
+
+void BatchExecutor::launchTestSet (const TestSet& testSet)
+{
+	const std::string caseList = getCaseListString(m_root, testSet);
 
-	m_commLink->startTestProcess(m_config.binaryName.c_str(), m_config.cmdLineArgs.c_str(), m_config.workingDir.c_str(), caseList.str().c_str());
+	m_commLink->startTestProcess(m_config.binaryName.c_str(), m_config.cmdLineArgs.c_str(), m_config.workingDir.c_str(), caseList.c_str());
 }
 
 void BatchExecutor::enqueueStateChanged (void* userPtr, CommLinkState state, const char* message)
@@ -412,4 +423,504 @@ void BatchExecutor::dispatchInfoLogData (CallReader data)
 	executor->onInfoLogData(data.getDataBlock(numBytes), numBytes);
 }
 
+// ShardedBatchExecutor
+
+class ShardedBatchExecutor::Shard : public TestLogHandler
+{
+public:
+	enum State
+	{
+		STATE_IDLE,
+		STATE_RUNNING,
+		STATE_DISABLED,
+
+		STATE_LAST
+	};
+
+	Shard (ShardedBatchExecutor* executor_, int shardNdx_, CommLink* commLink_, CaseDurationMap* caseDurations)
+		: executor			(executor_)
+		, shardNdx			(shardNdx_)
+		, commLink			(commLink_)
+		, state				(STATE_IDLE)
+		, testLogParser		(this)
+		, m_caseDurations	(caseDurations)
+		, m_caseStartTime	(0)
+	{
+	}
+
+	void setSessionInfo (const SessionInfo& sessionInfo)
+	{
+		batchResult.getSessionInfo() = sessionInfo;
+	}
+
+	TestCaseResultPtr startTestCaseResult (const char* casePath)
+	{
+		m_caseStartTime = deGetMicroseconds();
+
+		if (batchResult.hasTestCaseResult(casePath))
+			return batchResult.getTestCaseResult(casePath);
+		else
+			return batchResult.createTestCaseResult(casePath);
+	}
+
+	void testCaseResultUpdated (const TestCaseResultPtr&)
+	{
+	}
+
+	void testCaseResultComplete (const TestCaseResultPtr& result)
+	{
+		if (m_caseDurations)
+			(*m_caseDurations)[result->getTestCasePath()] = deGetMicroseconds() - m_caseStartTime;
+
+		printf("%s\n", result->getTestCasePath());
+	}
+
+	ShardedBatchExecutor* const	executor;
+	const int					shardNdx;
+	CommLink* const				commLink;
+
+	State						state;
+	std::vector<int>			batch;			//!< Indices to executor->m_cases in current session.
+	BatchResult					batchResult;
+	InfoLog						infoLog;
+	TestLogParser				testLogParser;
+
+private:
+	CaseDurationMap* const		m_caseDurations;
+	deUint64					m_caseStartTime;
+};
+
+ShardedBatchExecutor::ShardedBatchExecutor (const TargetConfiguration& config, const std::vector<CommLink*>& commLinks, const TestNode* root, const TestSet& testSet, BatchResult* batchResult, InfoLog* infoLog, CaseDurationMap* caseDurations)
+	: m_config			(config)
+	, m_root			(root)
+	, m_testSet			(testSet)
+	, m_batchResult		(batchResult)
+	, m_infoLog			(infoLog)
+	, m_caseDurations	(caseDurations)
+{
+	try
+	{
+		for (int shardNdx = 0; shardNdx < (int)commLinks.size(); shardNdx++)
+			m_shards.push_back(new Shard(this, shardNdx, commLinks[shardNdx], caseDurations));
+	}
+	catch (...)
+	{
+		for (std::vector<Shard*>::iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+			delete *shardIter;
+		throw;
+	}
+}
+
+ShardedBatchExecutor::~ShardedBatchExecutor (void)
+{
+	for (std::vector<Shard*>::iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+		delete *shardIter;
+}
+
+void ShardedBatchExecutor::run (void)
+{
+	XE_CHECK(!m_shards.empty());
+	XE_CHECK(m_cases.empty());
+
+	// Check commlink states.
+	for (std::vector<Shard*>::const_iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+	{
+		std::string			stateStr	= "";
+		const CommLinkState	commState	= (*shardIter)->commLink->getState(stateStr);
+
+		if (commState == COMMLINKSTATE_ERROR)
+			XE_FAIL((string("CommLink error: '") + stateStr + "'").c_str());
+		else if (commState != COMMLINKSTATE_READY)
+			XE_FAIL("CommLink is not ready");
+	}
+
+	// Compute initial execute set in canonical order.
+	{
+		TestSet executeSet;
+		computeExecuteSet(executeSet, m_root, m_testSet, m_batchResult);
+
+		for (ConstTestNodeIterator iter = ConstTestNodeIterator::begin(m_root); iter != ConstTestNodeIterator::end(m_root); ++iter)
+		{
+			if ((*iter)->getNodeType() == TESTNODETYPE_TEST_CASE && executeSet.hasNode(*iter))
+			{
+				m_pendingCases.insert(m_pendingCases.end(), (int)m_cases.size());
+				m_cases.push_back(static_cast<const TestCase*>(*iter));
+			}
+		}
+	}
+
+	initCaseCosts();
+
+	// Register callbacks.
+	for (std::vector<Shard*>::iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+		(*shardIter)->commLink->setCallbacks(enqueueStateChanged, enqueueTestLogData, enqueueInfoLogData, *shardIter);
+
+	try
+	{
+		scheduleIdleShards();
+
+		// Run handler loop until all shards are finished.
+		while (isAnyShardRunning())
+			m_dispatcher.callNext();
+	}
+	catch (...)
+	{
+		for (std::vector<Shard*>::iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+			(*shardIter)->commLink->setCallbacks(DE_NULL, DE_NULL, DE_NULL, DE_NULL);
+		throw;
+	}
+
+	// De-register callbacks.
+	for (std::vector<Shard*>::iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+		(*shardIter)->commLink->setCallbacks(DE_NULL, DE_NULL, DE_NULL, DE_NULL);
+
+	mergeResults();
+}
+
+void ShardedBatchExecutor::initCaseCosts (void)
+{
+	deUint64	totalKnownCost	= 0;
+	int			numKnown		= 0;
+
+	m_caseCosts.resize(m_cases.size(), 0);
+
+	if (m_caseDurations)
+	{
+		for (int caseNdx = 0; caseNdx < (int)m_cases.size(); caseNdx++)
+		{
+			const CaseDurationMap::const_iterator pos = m_caseDurations->find(m_cases[caseNdx]->getFullPath());
+
+			if (pos != m_caseDurations->end())
+			{
+				m_caseCosts[caseNdx]	 = de::max<deUint64>(pos->second, 1);
+				totalKnownCost			+= m_caseCosts[caseNdx];
+				numKnown				+= 1;
+			}
+		}
+	}
+
+	// Cases without history are assumed to take average time.
+	{
+		const deUint64 defaultCost = numKnown > 0 ? de::max<deUint64>(totalKnownCost / (deUint64)numKnown, 1) : 1;
+
+		for (int caseNdx = 0; caseNdx < (int)m_cases.size(); caseNdx++)
+		{
+			if (m_caseCosts[caseNdx] == 0)
+				m_caseCosts[caseNdx] = defaultCost;
+		}
+	}
+}
+
+bool ShardedBatchExecutor::isAnyShardRunning (void) const
+{
+	for (std::vector<Shard*>::const_iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+	{
+		if ((*shardIter)->state == Shard::STATE_RUNNING)
+			return true;
+	}
+
+	return false;
+}
+
+bool ShardedBatchExecutor::computeShardBatch (std::vector<int>& batch)
+{
+	int			numActiveShards	= 0;
+	deUint64	remainingCost	= 0;
+
+	DE_ASSERT(batch.empty());
+
+	if (m_pendingCases.empty())
+		return false;
+
+	for (std::vector<Shard*>::const_iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+	{
+		if ((*shardIter)->state != Shard::STATE_DISABLED)
+			numActiveShards += 1;
+	}
+
+	for (std::set<int>::const_iterator caseIter = m_pendingCases.begin(); caseIter != m_pendingCases.end(); ++caseIter)
+		remainingCost += m_caseCosts[*caseIter];
+
+	DE_ASSERT(numActiveShards > 0);
+
+	// Take contiguous run of pending cases until target cost is reached.
+	{
+		const deUint64	targetCost	= de::max<deUint64>(remainingCost / (deUint64)(numActiveShards*SHARD_BATCH_SPLIT_FACTOR), 1);
+		deUint64		batchCost	= 0;
+
+		while (!m_pendingCases.empty() && (int)batch.size() < m_config.maxCasesPerSession && (batch.empty() || batchCost < targetCost))
+		{
+			const int caseNdx = *m_pendingCases.begin();
+
+			batch.push_back(caseNdx);
+			batchCost += m_caseCosts[caseNdx];
+			m_pendingCases.erase(m_pendingCases.begin());
+		}
+	}
+
+	return true;
+}
+
+void ShardedBatchExecutor::scheduleIdleShards (void)
+{
+	for (std::vector<Shard*>::iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+	{
+		Shard* const shard = *shardIter;
+
+		if (shard->state != Shard::STATE_IDLE)
+			continue;
+
+		if (!computeShardBatch(shard->batch))
+			break;
+
+		launchShardBatch(shard);
+	}
+}
+
+void ShardedBatchExecutor::launchShardBatch (Shard* shard)
+{
+	TestSet testSet;
+
+	for (std::vector<int>::const_iterator caseIter = shard->batch.begin(); caseIter != shard->batch.end(); ++caseIter)
+		testSet.addCase(m_cases[*caseIter]);
+
+	{
+		const std::string caseList = getCaseListString(m_root, testSet);
+
+		shard->state = Shard::STATE_RUNNING;
+		shard->commLink->startTestProcess(m_config.binaryName.c_str(), m_config.cmdLineArgs.c_str(), m_config.workingDir.c_str(), caseList.c_str());
+	}
+}
+
+int ShardedBatchExecutor::requeueShardBatch (Shard* shard)
+{
+	int numRequeued = 0;
+
+	for (std::vector<int>::const_iterator caseIter = shard->batch.begin(); caseIter != shard->batch.end(); ++caseIter)
+	{
+		if (!isExecutedInBatch(&shard->batchResult, m_cases[*caseIter]))
+		{
+			m_pendingCases.insert(*caseIter);
+			numRequeued += 1;
+		}
+	}
+
+	shard->batch.clear();
+
+	return numRequeued;
+}
+
+void ShardedBatchExecutor::mergeResults (void)
+{
+	// Executed cases in canonical order.
+	for (std::vector<const TestCase*>::const_iterator caseIter = m_cases.begin(); caseIter != m_cases.end(); ++caseIter)
+	{
+		const std::string	casePath	= (*caseIter)->getFullPath();
+		TestCaseResultPtr	result;
+
+		for (std::vector<Shard*>::const_iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+		{
+			if ((*shardIter)->batchResult.hasTestCaseResult(casePath.c_str()))
+			{
+				const TestCaseResultPtr shardResult = (*shardIter)->batchResult.getTestCaseResult(casePath.c_str());
+
+				// Prefer result from session where case was completed.
+				if (!result || (!isExecuted(*result) && isExecuted(*shardResult)))
+					result = shardResult;
+			}
+		}
+
+		if (result)
+			m_batchResult->setTestCaseResult(result);
+	}
+
+	// Results reported for cases that were not requested.
+	for (std::vector<Shard*>::const_iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+	{
+		BatchResult& shardResults = (*shardIter)->batchResult;
+
+		for (int resultNdx = 0; resultNdx < shardResults.getNumTestCaseResults(); resultNdx++)
+		{
+			const TestCaseResultPtr result = shardResults.getTestCaseResult(resultNdx);
+
+			if (!m_batchResult->hasTestCaseResult(result->getTestCasePath()))
+				m_batchResult->setTestCaseResult(result);
+		}
+	}
+
+	// Session info from first shard that reported it.
+	for (std::vector<Shard*>::const_iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+	{
+		if (!(*shardIter)->batchResult.getSessionInfo().releaseName.empty())
+		{
+			m_batchResult->getSessionInfo() = (*shardIter)->batchResult.getSessionInfo();
+			break;
+		}
+	}
+
+	// Info logs are concatenated in shard order.
+	if (m_infoLog)
+	{
+		for (std::vector<Shard*>::const_iterator shardIter = m_shards.begin(); shardIter != m_shards.end(); ++shardIter)
+		{
+			if ((*shardIter)->infoLog.getSize() > 0)
+				m_infoLog->append((*shardIter)->infoLog.getBytes(), (*shardIter)->infoLog.getSize());
+		}
+	}
+}
+
+void ShardedBatchExecutor::onStateChanged (Shard* shard, CommLinkState state, const char* message)
+{
+	// Late notifications from disabled shards are ignored.
+	if (shard->state != Shard::STATE_RUNNING)
+		return;
+
+	switch (state)
+	{
+		case COMMLINKSTATE_READY:
+		case COMMLINKSTATE_TEST_PROCESS_LAUNCHING:
+		case COMMLINKSTATE_TEST_PROCESS_RUNNING:
+			break; // Ignore.
+
+		case COMMLINKSTATE_TEST_PROCESS_FINISHED:
+		{
+			// Feed end of string to parser. This terminates open test case if such exists.
+			{
+				deUint8 eos = 0;
+				onTestLogData(shard, &eos, 1);
+			}
+
+			const int numBatchCases	= (int)shard->batch.size();
+			const int numExecuted	= numBatchCases - requeueShardBatch(shard);
+
+			// \note Shard is not used anymore if no cases were executed in last session. Otherwise executor
+			//       could end up in infinite loop.
+			if (numExecuted > 0)
+			{
+				shard->testLogParser.reset();
+
+				shard->commLink->reset();
+				XE_CHECK(shard->commLink->getState() == COMMLINKSTATE_READY);
+
+				shard->state = Shard::STATE_IDLE;
+			}
+			else
+			{
+				printf("Shard %d: no test cases executed in last session, disabling shard\n", shard->shardNdx);
+				shard->state = Shard::STATE_DISABLED;
+			}
+
+			scheduleIdleShards();
+			break;
+		}
+
+		case COMMLINKSTATE_TEST_PROCESS_LAUNCH_FAILED:
+			printf("Shard %d: Failed to start test process: '%s'\n", shard->shardNdx, message);
+			requeueShardBatch(shard);
+			shard->state = Shard::STATE_DISABLED;
+			scheduleIdleShards();
+			break;
+
+		case COMMLINKSTATE_ERROR:
+			printf("Shard %d: CommLink error: '%s'\n", shard->shardNdx, message);
+			requeueShardBatch(shard);
+			shard->state = Shard::STATE_DISABLED;
+			scheduleIdleShards();
+			break;
+
+		default:
+			XE_FAIL("Unknown state");
+	}
+}
+
+void ShardedBatchExecutor::onTestLogData (Shard* shard, const deUint8* bytes, int numBytes)
+{
+	try
+	{
+		shard->testLogParser.parse(bytes, numBytes);
+	}
+	catch (const ParseError& e)
+	{
+		// \todo [2012-07-06 pyry] Log error.
+		DE_UNREF(e);
+	}
+}
+
+void ShardedBatchExecutor::onInfoLogData (Shard* shard, const deUint8* bytes, int numBytes)
+{
+	if (numBytes > 0)
+		shard->infoLog.append(bytes, numBytes);
+}
+
+void ShardedBatchExecutor::enqueueStateChanged (void* userPtr, CommLinkState state, const char* message)
+{
+	Shard*		shard	= static_cast<Shard*>(userPtr);
+	CallWriter	writer	(&shard->executor->m_dispatcher, ShardedBatchExecutor::dispatchStateChanged);
+
+	writer << shard
+		   << state
+		   << message;
+
+	writer.enqueue();
+}
+
+void ShardedBatchExecutor::enqueueTestLogData (void* userPtr, const deUint8* bytes, int numBytes)
+{
+	Shard*		shard	= static_cast<Shard*>(userPtr);
+	CallWriter	writer	(&shard->executor->m_dispatcher, ShardedBatchExecutor::dispatchTestLogData);
+
+	writer << shard
+		   << numBytes;
+
+	writer.write(bytes, numBytes);
+	writer.enqueue();
+}
+
+void ShardedBatchExecutor::enqueueInfoLogData (void* userPtr, const deUint8* bytes, int numBytes)
+{
+	Shard*		shard	= static_cast<Shard*>(userPtr);
+	CallWriter	writer	(&shard->executor->m_dispatcher, ShardedBatchExecutor::dispatchInfoLogData);
+
+	writer << shard
+		   << numBytes;
+
+	writer.write(bytes, numBytes);
+	writer.enqueue();
+}
+
+void ShardedBatchExecutor::dispatchStateChanged (CallReader data)
+{
+	Shard*			shard	= DE_NULL;
+	CommLinkState	state	= COMMLINKSTATE_LAST;
+	std::string		message;
+
+	data >> shard
+		 >> state
+		 >> message;
+
+	shard->executor->onStateChanged(shard, state, message.c_str());
+}
+
+void ShardedBatchExecutor::dispatchTestLogData (CallReader data)
+{
+	Shard*	shard		= DE_NULL;
+	int		numBytes;
+
+	data >> shard
+		 >> numBytes;
+
+	shard->executor->onTestLogData(shard, data.getDataBlock(numBytes), numBytes);
+}
+
+void ShardedBatchExecutor::dispatchInfoLogData (CallReader data)
+{
+	Shard*	shard		= DE_NULL;
+	int		numBytes;
+
+	data >> shard
+		 >> numBytes;
+
+	shard->executor->onInfoLogData(shard, data.getDataBlock(numBytes), numBytes);
+}
+
 } // xe
@@ -31,6 +31,8 @@
 
 #include <string>
 #include <vector>
+#include <set>
+#include <map>
 
 namespace xe
 {
@@ -122,6 +124,74 @@ private:
 	CallQueue				m_dispatcher;
 };
 
+//! Historical test case execution times in microseconds, keyed by full case path.
+typedef std::map<std::string, deUint64> CaseDurationMap;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Test batch executor using multiple CommLinks in parallel.
+ *
+ * Cases are handed out to shards in contiguous runs of canonical case
+ * order. Run length is chosen based on estimated remaining work so that
+ * shards get large runs first and small runs towards the end. Estimates
+ * come from caseDurations, which is also updated with measured times.
+ *
+ * Cases that were not executed in a session (for example after a crash)
+ * are put back to the queue and may be picked up by any shard. Results
+ * are merged into batchResult in canonical case order once all shards
+ * have finished.
+ *//*--------------------------------------------------------------------*/
+class ShardedBatchExecutor
+{
+public:
+							ShardedBatchExecutor	(const TargetConfiguration& config, const std::vector<CommLink*>& commLinks, const TestNode* root, const TestSet& testSet, BatchResult* batchResult, InfoLog* infoLog, CaseDurationMap* caseDurations);
+							~ShardedBatchExecutor	(void);
+
+	void					run						(void);
+
+private:
+							ShardedBatchExecutor	(const ShardedBatchExecutor& other);
+	ShardedBatchExecutor&	operator=				(const ShardedBatchExecutor& other);
+
+	class Shard;
+
+	void					initCaseCosts			(void);
+	void					scheduleIdleShards		(void);
+	bool					computeShardBatch		(std::vector<int>& batch);
+	void					launchShardBatch		(Shard* shard);
+	int						requeueShardBatch		(Shard* shard);
+	bool					isAnyShardRunning		(void) const;
+	void					mergeResults			(void);
+
+	void					onStateChanged			(Shard* shard, CommLinkState state, const char* message);
+	void					onTestLogData			(Shard* shard, const deUint8* bytes, int numBytes);
+	void					onInfoLogData			(Shard* shard, const deUint8* bytes, int numBytes);
+
+	// Callbacks for CommLink.
+	static void				enqueueStateChanged		(void* userPtr, CommLinkState state, const char* message);
+	static void				enqueueTestLogData		(void* userPtr, const deUint8* bytes, int numBytes);
+	static void				enqueueInfoLogData		(void* userPtr, const deUint8* bytes, int numBytes);
+
+	// Called in CallQueue dispatch.
+	static void				dispatchStateChanged	(CallReader data);
+	static void				dispatchTestLogData		(CallReader data);
+	static void				dispatchInfoLogData		(CallReader data);
+
+	TargetConfiguration		m_config;
+	const TestNode*			m_root;
+	const TestSet&			m_testSet;
+
+	BatchResult*			m_batchResult;
+	InfoLog*				m_infoLog;
+	CaseDurationMap*		m_caseDurations;
+
+	std::vector<const TestCase*>	m_cases;			//!< Cases to execute in canonical order.
+	std::vector<deUint64>			m_caseCosts;		//!< Estimated cost for each case in m_cases.
+	std::set<int>					m_pendingCases;		//!< Indices to m_cases that are not assigned to any shard.
+	std::vector<Shard*>				m_shards;
+
+	CallQueue				m_dispatcher;
+};
+
 } // xe
 
 #endif // _XEBATCHEXECUTOR_HPP
@@ -113,4 +113,19 @@ TestCaseResultPtr BatchResult::createTestCaseResult (const char* casePath)
 	return caseResult;
 }
 
+void BatchResult::setTestCaseResult (const TestCaseResultPtr& result)
+{
+	const char*							casePath	= result->getTestCasePath();
+	map<string, int>::const_iterator	pos			= m_resultMap.find(casePath);
+
+	if (pos != m_resultMap.end())
+		m_testCaseResults[pos->second] = result;
+	else
+	{
+		m_testCaseResults.reserve(m_testCaseResults.size()+1);
+		m_resultMap[casePath] = (int)m_testCaseResults.size();
+		m_testCaseResults.push_back(result);
+	}
+}
+
 } // xe
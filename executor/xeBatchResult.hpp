@@ -117,6 +117,7 @@ public:
 	TestCaseResultPtr					getTestCaseResult		(const char* casePath);
 
 	TestCaseResultPtr					createTestCaseResult	(const char* casePath);
+	void								setTestCaseResult		(const TestCaseResultPtr& result);	//!< Add result or replace existing result for same case.
 
 private:
 										BatchResult				(const BatchResult& other);
@@ -22,6 +22,7 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xeDefs.hpp"
+#include "deThread.h"
 
 #include <sstream>
 
@@ -43,4 +44,12 @@ Error::Error (const char* message, const char* expr, const char* file, int line)
 {
 }
 
+int getNumWorkerThreads (int numThreads)
+{
+	if (numThreads > 0)
+		return numThreads;
+	else
+		return de::max(1, (int)deGetNumAvailableLogicalCores());
+}
+
 } // xe
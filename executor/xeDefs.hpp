@@ -44,6 +44,9 @@ public:
 	ParseError (const std::string& message) : Error(message) {}
 };
 
+//! Get number of worker threads for tools. Positive numThreads is used as is (1 = no threads), 0 selects number of CPU cores.
+int		getNumWorkerThreads		(int numThreads);
+
 } // xe
 
 #define XE_FAIL(MSG)			throw xe::Error(MSG, "", __FILE__, __LINE__)
@@ -46,12 +46,18 @@ LocalTcpIpLink::~LocalTcpIpLink (void)
 	stop();
 }
 
-void LocalTcpIpLink::start (const char* execServerPath, const char* workDir, int port)
+void LocalTcpIpLink::start (const char* execServerPath, const char* workDir, int port, int numSlots)
 {
 	XE_CHECK(!m_process);
 
 	std::ostringstream cmdLine;
-	cmdLine << execServerPath << " --single --port=" << port;
+	cmdLine << execServerPath << " --port=" << port;
+
+	// Server with multiple slots accepts other connections too and lives until stop().
+	if (numSlots > 1)
+		cmdLine << " --slots=" << numSlots;
+	else
+		cmdLine << " --single";
 
 	m_process = deProcess_create();
 	XE_CHECK(m_process);
@@ -120,7 +126,7 @@ void LocalTcpIpLink::stop (void)
 		}
 
 		// \note --single flag is used so execserver should kill itself once one connection is handled.
-		//		 This is here to make sure it dies even in case of hang.
+		//		 This is here to make sure it dies even in case of hang, or if it has multiple slots.
 		deProcess_terminate		(m_process);
 		deProcess_waitForFinish	(m_process);
 		deProcess_destroy		(m_process);
@@ -0,0 +1,413 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Parallel test log parser.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeParallelTestLogParser.hpp"
+#include "xeTestLogParser.hpp"
+#include "deThread.hpp"
+#include "deSemaphore.hpp"
+
+#include <fstream>
+
+using std::string;
+using std::vector;
+
+namespace xe
+{
+
+enum
+{
+	MIN_PENDING_ITEMS			= 16,	//!< Minimum number of results parsed in one batch.
+	PENDING_ITEMS_PER_WORKER	= 4,
+	READ_BUFFER_SIZE			= 4096
+};
+
+static int getMaxPendingItems (int numWorkers, bool parseResults)
+{
+	// Without parallel parsing there is nothing to gain from batching or pipelining.
+	if (!parseResults || numWorkers <= 1)
+		return 1;
+
+	return de::max<int>(MIN_PENDING_ITEMS, numWorkers*PENDING_ITEMS_PER_WORKER);
+}
+
+struct ParallelTestLogParser::Item
+{
+	enum Type
+	{
+		TYPE_SESSION_INFO = 0,
+		TYPE_COMPLETE,
+		TYPE_INCOMPLETE,
+
+		TYPE_LAST
+	};
+
+	Item (Type type_)
+		: type			(type_)
+		, parseResult	(TestResultParser::PARSERESULT_NOT_CHANGED)
+	{
+	}
+
+	const Type						type;
+	SessionInfo						sessionInfo;
+	TestCaseResultPtr				data;
+	TestCaseResult					result;
+	TestResultParser::ParseResult	parseResult;
+	string							error;
+};
+
+// Receives results from TestLogParser.
+class ParallelTestLogParser::SplitHandler : public TestLogHandler
+{
+public:
+	SplitHandler (ParallelTestLogParser& parser)
+		: m_parser(parser)
+	{
+	}
+
+	void setSessionInfo (const SessionInfo& sessionInfo)
+	{
+		ItemPtr item(new Item(Item::TYPE_SESSION_INFO));
+		item->sessionInfo = sessionInfo;
+		m_parser.submit(item);
+	}
+
+	TestCaseResultPtr startTestCaseResult (const char* casePath)
+	{
+		flushIncomplete();
+
+		// \note Each result gets new data object as previous ones may still be waiting to be parsed.
+		m_curResult = TestCaseResultPtr(new TestCaseResultData(casePath));
+		return m_curResult;
+	}
+
+	void testCaseResultUpdated (const TestCaseResultPtr&)
+	{
+	}
+
+	void testCaseResultComplete (const TestCaseResultPtr& data)
+	{
+		ItemPtr item(new Item(Item::TYPE_COMPLETE));
+		item->data = data;
+		m_curResult.clear();
+		m_parser.submit(item);
+	}
+
+	void flushIncomplete (void)
+	{
+		if (m_curResult)
+		{
+			ItemPtr item(new Item(Item::TYPE_INCOMPLETE));
+			item->data = m_curResult;
+			m_curResult.clear();
+			m_parser.submit(item);
+		}
+	}
+
+private:
+	ParallelTestLogParser&	m_parser;
+	TestCaseResultPtr		m_curResult;
+};
+
+class ParallelTestLogParser::ParseJob : public de::WorkerPool::Job
+{
+public:
+	ParseJob (const vector<ItemPtr>& items, const vector<de::SharedPtr<TestResultParser> >& resultParsers)
+		: m_items			(items)
+		, m_resultParsers	(resultParsers)
+	{
+	}
+
+	void execute (int itemNdx, int workerNdx)
+	{
+		Item& item = *m_items[itemNdx];
+
+		if (item.type != Item::TYPE_COMPLETE)
+			return;
+
+		// Errors are reported only when the item is reached in log order.
+		try
+		{
+			item.parseResult = parseTestCaseResultFromData(m_resultParsers[workerNdx].get(), &item.result, *item.data);
+		}
+		catch (const std::exception& e)
+		{
+			item.error = e.what();
+		}
+	}
+
+private:
+	const vector<ItemPtr>&								m_items;
+	const vector<de::SharedPtr<TestResultParser> >&	m_resultParsers;
+};
+
+// Parses one batch at a time on worker pool, while thread calling parse() splits the next batch.
+class ParallelTestLogParser::ParseThread : public de::Thread
+{
+public:
+	ParseThread (de::WorkerPool& workerPool, const vector<de::SharedPtr<TestResultParser> >& resultParsers)
+		: m_workerPool		(workerPool)
+		, m_resultParsers	(resultParsers)
+		, m_items			(DE_NULL)
+		, m_start			(0)
+		, m_finished		(0)
+		, m_quit			(false)
+	{
+	}
+
+	//! Start parsing items. Items must not be accessed until waitBatch() returns.
+	void startBatch (const vector<ItemPtr>& items)
+	{
+		m_items = &items;
+		m_start.increment();
+	}
+
+	void waitBatch (void)
+	{
+		m_finished.decrement();
+		m_items = DE_NULL;
+
+		if (!m_error.empty())
+		{
+			const string error = m_error;
+			m_error.clear();
+			throw Error(error);
+		}
+	}
+
+	void stop (void)
+	{
+		m_quit = true;
+		m_start.increment();
+		join();
+	}
+
+	void run (void)
+	{
+		for (;;)
+		{
+			m_start.decrement();
+
+			if (m_quit)
+				break;
+
+			// \note Item parse errors are stored in items, this catches only failures of the pool itself.
+			try
+			{
+				ParseJob job (*m_items, m_resultParsers);
+				m_workerPool.execute(job, (int)m_items->size());
+			}
+			catch (const std::exception& e)
+			{
+				m_error = e.what();
+			}
+			catch (...)
+			{
+				m_error = "Unknown error while parsing test case results";
+			}
+
+			m_finished.increment();
+		}
+	}
+
+private:
+	de::WorkerPool&										m_workerPool;
+	const vector<de::SharedPtr<TestResultParser> >&	m_resultParsers;
+	const vector<ItemPtr>*								m_items;
+	de::Semaphore										m_start;
+	de::Semaphore										m_finished;
+	volatile bool										m_quit;
+	string												m_error;
+};
+
+ParallelTestLogParser::ParallelTestLogParser (ParallelTestLogHandler* handler, int numWorkers, bool parseResults)
+	: m_handler			(handler)
+	, m_parseResults	(parseResults)
+	, m_maxPendingItems	(getMaxPendingItems(numWorkers, parseResults))
+	, m_workerPool		(parseResults ? numWorkers : 1)
+	, m_parseThread		(m_maxPendingItems > 1 ? new ParseThread(m_workerPool, m_resultParsers) : DE_NULL)
+	, m_isParsing		(false)
+{
+	DE_ASSERT(numWorkers >= 1);
+
+	for (int ndx = 0; ndx < m_workerPool.getNumWorkers(); ndx++)
+		m_resultParsers.push_back(de::SharedPtr<TestResultParser>(new TestResultParser()));
+
+	if (m_parseThread)
+		m_parseThread->start();
+}
+
+ParallelTestLogParser::~ParallelTestLogParser (void)
+{
+	DE_ASSERT(!m_isParsing);
+
+	if (m_parseThread)
+		m_parseThread->stop();
+}
+
+void ParallelTestLogParser::submit (const ItemPtr& item)
+{
+	m_pendingItems.push_back(item);
+
+	if ((int)m_pendingItems.size() >= m_maxPendingItems)
+	{
+		if (m_parseThread)
+		{
+			// Report previous batch, and parse this one while next one is being read.
+			finishParse();
+			startParse();
+		}
+		else
+			flush();
+	}
+}
+
+void ParallelTestLogParser::startParse (void)
+{
+	DE_ASSERT(!m_isParsing && m_parsingItems.empty());
+
+	m_parsingItems.swap(m_pendingItems);
+	m_parseThread->startBatch(m_parsingItems);
+	m_isParsing = true;
+}
+
+//! Wait for batch being parsed in background and pass it to handler.
+void ParallelTestLogParser::finishParse (void)
+{
+	vector<ItemPtr> items;
+
+	if (!m_isParsing)
+		return;
+
+	m_isParsing = false;
+
+	try
+	{
+		m_parseThread->waitBatch();
+
+		items.swap(m_parsingItems);
+		dispatchItems(items);
+	}
+	catch (...)
+	{
+		// Later items must not be reported after an error.
+		m_parsingItems.clear();
+		m_pendingItems.clear();
+		throw;
+	}
+}
+
+//! Parse and report all items, including batch being parsed in background.
+void ParallelTestLogParser::flush (void)
+{
+	vector<ItemPtr> items;
+
+	finishParse();
+
+	if (m_parseResults && !m_pendingItems.empty())
+	{
+		ParseJob job(m_pendingItems, m_resultParsers);
+		m_workerPool.execute(job, (int)m_pendingItems.size());
+	}
+
+	// \note Pending items are cleared before calling handler so that parser is left in a clean state if handler throws.
+	items.swap(m_pendingItems);
+	dispatchItems(items);
+}
+
+void ParallelTestLogParser::dispatchItems (const vector<ItemPtr>& items)
+{
+	for (vector<ItemPtr>::const_iterator item = items.begin(); item != items.end(); ++item)
+	{
+		if (!(*item)->error.empty())
+			throw Error((*item)->error);
+
+		dispatch(**item);
+	}
+}
+
+void ParallelTestLogParser::dispatch (const Item& item)
+{
+	switch (item.type)
+	{
+		case Item::TYPE_SESSION_INFO:
+			m_handler->setSessionInfo(item.sessionInfo);
+			break;
+
+		case Item::TYPE_COMPLETE:
+			m_handler->testCaseResultComplete(item.data, item.result, item.parseResult);
+			break;
+
+		case Item::TYPE_INCOMPLETE:
+			m_handler->testCaseResultIncomplete(item.data);
+			break;
+
+		default:
+			DE_ASSERT(false);
+	}
+}
+
+void ParallelTestLogParser::parse (std::istream& in)
+{
+	SplitHandler	splitHandler	(*this);
+	TestLogParser	logParser		(&splitHandler);
+	deUint8			buf				[READ_BUFFER_SIZE];
+
+	DE_ASSERT(!m_isParsing);
+	m_pendingItems.clear();
+
+	try
+	{
+		for (;;)
+		{
+			in.read((char*)&buf[0], DE_LENGTH_OF_ARRAY(buf));
+			const int numRead = (int)in.gcount();
+
+			if (numRead <= 0)
+				break;
+
+			logParser.parse(&buf[0], numRead);
+		}
+
+		splitHandler.flushIncomplete();
+	}
+	catch (...)
+	{
+		// Results preceding the error are reported before the error, as with TestLogParser.
+		flush();
+		throw;
+	}
+
+	flush();
+}
+
+void ParallelTestLogParser::parseFile (const char* filename)
+{
+	std::ifstream in(filename, std::ifstream::binary|std::ifstream::in);
+
+	if (!in.good())
+		throw Error(string("Failed to open '") + filename + "'");
+
+	parse(in);
+}
+
+} // xe
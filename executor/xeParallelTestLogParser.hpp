@@ -0,0 +1,110 @@
+#ifndef _XEPARALLELTESTLOGPARSER_HPP
+#define _XEPARALLELTESTLOGPARSER_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Parallel test log parser.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeDefs.hpp"
+#include "xeTestCaseResult.hpp"
+#include "xeTestResultParser.hpp"
+#include "xeBatchResult.hpp"
+#include "deSharedPtr.hpp"
+#include "deUniquePtr.hpp"
+#include "deWorkerPool.hpp"
+
+#include <vector>
+#include <istream>
+
+namespace xe
+{
+
+class ParallelTestLogHandler
+{
+public:
+	virtual			~ParallelTestLogHandler		(void) {}
+
+	virtual void	setSessionInfo				(const SessionInfo& sessionInfo) = DE_NULL;
+
+	//! Called in log order. result is empty if results are not parsed.
+	virtual void	testCaseResultComplete		(const TestCaseResultPtr& data, const TestCaseResult& result, TestResultParser::ParseResult parseResult) = DE_NULL;
+
+	//! Called in log order for results that were started but never finished.
+	virtual void	testCaseResultIncomplete	(const TestCaseResultPtr& data) { DE_UNREF(data); }
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Parallel test log parser
+ *
+ * Log is read and split into test case results in the thread calling
+ * parse(). Results are collected into batches and test case data in each
+ * batch is parsed into TestCaseResult using a worker pool. Batches are
+ * double-buffered: while one batch is being parsed by a separate thread
+ * and the pool, the next one is read and split. Handler is called only
+ * from the thread calling parse(), in the same order as TestLogParser
+ * would report the results.
+ *
+ * Test case results are parsed with parseTestCaseResultFromData(). With
+ * one worker, or if result parsing is disabled, each result is passed to
+ * handler as soon as it has been read.
+ *//*--------------------------------------------------------------------*/
+class ParallelTestLogParser
+{
+public:
+							ParallelTestLogParser	(ParallelTestLogHandler* handler, int numWorkers, bool parseResults = true);
+							~ParallelTestLogParser	(void);
+
+	void					parse					(std::istream& in);
+	void					parseFile				(const char* filename);
+
+private:
+							ParallelTestLogParser	(const ParallelTestLogParser& other);
+	ParallelTestLogParser&	operator=				(const ParallelTestLogParser& other);
+
+	struct Item;
+	class SplitHandler;
+	class ParseJob;
+	class ParseThread;
+
+	typedef de::SharedPtr<Item>	ItemPtr;
+
+	void					submit					(const ItemPtr& item);
+	void					startParse				(void);
+	void					finishParse				(void);
+	void					flush					(void);
+	void					dispatchItems			(const std::vector<ItemPtr>& items);
+	void					dispatch				(const Item& item);
+
+	ParallelTestLogHandler*							m_handler;
+	const bool										m_parseResults;
+	const int										m_maxPendingItems;
+
+	de::WorkerPool									m_workerPool;
+	std::vector<de::SharedPtr<TestResultParser> >	m_resultParsers;	//!< One per worker.
+	de::UniquePtr<ParseThread>						m_parseThread;		//!< Parses batches in background, or null if batches are parsed by caller.
+	std::vector<ItemPtr>							m_pendingItems;		//!< Items in log order, waiting to be parsed and passed to handler.
+	std::vector<ItemPtr>							m_parsingItems;		//!< Batch being parsed by m_parseThread, preceding m_pendingItems in log order.
+	bool											m_isParsing;
+};
+
+} // xe
+
+#endif // _XEPARALLELTESTLOGPARSER_HPP
@@ -0,0 +1,533 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Columnar binary sample list file.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeSampleListFile.hpp"
+#include "xsCompression.hpp"
+#include "deMemory.h"
+#include "deMath.h"
+
+#include <fstream>
+#include <algorithm>
+
+using std::string;
+using std::vector;
+
+namespace xe
+{
+namespace samplelist
+{
+
+static const char	s_fileMagic[]	= "xesample";
+
+enum
+{
+	MAGIC_SIZE			= 8,
+	FILE_HEADER_SIZE	= 40,
+	COLUMN_HEADER_SIZE	= 112,
+	DATA_ALIGNMENT		= 8,
+	VALUE_SIZE			= 8
+};
+
+namespace
+{
+
+inline void putU32 (deUint8* dst, deUint32 value)
+{
+	for (int ndx = 0; ndx < 4; ndx++)
+		dst[ndx] = (deUint8)(value >> (ndx*8));
+}
+
+inline void putU64 (deUint8* dst, deUint64 value)
+{
+	putU32(dst, (deUint32)value);
+	putU32(dst+4, (deUint32)(value >> 32));
+}
+
+inline void putF64 (deUint8* dst, double value)
+{
+	deUint64 bits;
+	deMemcpy(&bits, &value, sizeof(bits));
+	putU64(dst, bits);
+}
+
+inline deUint32 getU32 (const deUint8* src)
+{
+	deUint32 value = 0;
+	for (int ndx = 0; ndx < 4; ndx++)
+		value |= (deUint32)src[ndx] << (ndx*8);
+	return value;
+}
+
+inline deUint64 getU64 (const deUint8* src)
+{
+	return (deUint64)getU32(src) | ((deUint64)getU32(src+4) << 32);
+}
+
+inline double getF64 (const deUint8* src)
+{
+	const deUint64	bits	= getU64(src);
+	double			value;
+	deMemcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+inline deUint64 alignOffset (deUint64 offset)
+{
+	return (offset + DATA_ALIGNMENT-1) & ~(deUint64)(DATA_ALIGNMENT-1);
+}
+
+inline double toDouble (const ri::NumericValue& value)
+{
+	return value.getType() == ri::NumericValue::TYPE_INT64 ? (double)value.getInt64() : value.getFloat64();
+}
+
+ColumnType getColumnType (const vector<ri::NumericValue>& values)
+{
+	ri::NumericValue::Type	commonType	= ri::NumericValue::TYPE_LAST;
+
+	for (vector<ri::NumericValue>::const_iterator value = values.begin(); value != values.end(); ++value)
+	{
+		if (value->getType() == ri::NumericValue::TYPE_EMPTY)
+			return COLUMNTYPE_MIXED;
+		else if (commonType == ri::NumericValue::TYPE_LAST)
+			commonType = value->getType();
+		else if (value->getType() != commonType)
+			return COLUMNTYPE_MIXED;
+	}
+
+	return commonType == ri::NumericValue::TYPE_FLOAT64 ? COLUMNTYPE_FLOAT64 : COLUMNTYPE_INT64;
+}
+
+ColumnStats computeStats (const vector<ri::NumericValue>& values)
+{
+	ColumnStats		stats;
+	vector<double>	numbers;
+
+	numbers.reserve(values.size());
+
+	for (vector<ri::NumericValue>::const_iterator value = values.begin(); value != values.end(); ++value)
+	{
+		if (value->getType() != ri::NumericValue::TYPE_EMPTY)
+			numbers.push_back(toDouble(*value));
+	}
+
+	if (numbers.empty())
+		return stats;
+
+	{
+		double sum = 0.0;
+
+		stats.numValues	= (int)numbers.size();
+		stats.min		= numbers[0];
+		stats.max		= numbers[0];
+
+		for (vector<double>::const_iterator num = numbers.begin(); num != numbers.end(); ++num)
+		{
+			stats.min	 = de::min(stats.min, *num);
+			stats.max	 = de::max(stats.max, *num);
+			sum			+= *num;
+		}
+
+		stats.mean = sum / (double)numbers.size();
+	}
+
+	{
+		double sumSqDiff = 0.0;
+
+		for (vector<double>::const_iterator num = numbers.begin(); num != numbers.end(); ++num)
+			sumSqDiff += (*num - stats.mean) * (*num - stats.mean);
+
+		stats.stdDev = deSqrt(sumSqDiff / (double)numbers.size());
+	}
+
+	{
+		const size_t mid = numbers.size() / 2;
+
+		std::nth_element(numbers.begin(), numbers.begin() + mid, numbers.end());
+		stats.median = numbers[mid];
+
+		if (numbers.size() % 2 == 0)
+			stats.median = (stats.median + *std::max_element(numbers.begin(), numbers.begin() + mid)) / 2.0;
+	}
+
+	return stats;
+}
+
+void encodeColumn (const vector<ri::NumericValue>& values, ColumnType type, vector<deUint8>& dst)
+{
+	const int numSamples = (int)values.size();
+
+	dst.resize(numSamples*VALUE_SIZE + (type == COLUMNTYPE_MIXED ? numSamples : 0));
+
+	for (int sampleNdx = 0; sampleNdx < numSamples; sampleNdx++)
+	{
+		const ri::NumericValue&	value	= values[sampleNdx];
+		deUint8* const			valPtr	= &dst[sampleNdx*VALUE_SIZE];
+
+		switch (value.getType())
+		{
+			case ri::NumericValue::TYPE_INT64:		putU64(valPtr, (deUint64)value.getInt64());	break;
+			case ri::NumericValue::TYPE_FLOAT64:	putF64(valPtr, value.getFloat64());			break;
+			default:								putU64(valPtr, 0);							break;
+		}
+
+		if (type == COLUMNTYPE_MIXED)
+			dst[numSamples*VALUE_SIZE + sampleNdx] = (deUint8)value.getType();
+	}
+}
+
+class StringTable
+{
+public:
+	StringTable (deUint64 baseOffset) : m_baseOffset(baseOffset) {}
+
+	//! Append string to table and write its (offset, length) reference to dst.
+	void add (deUint8* dst, const char* str, int length)
+	{
+		putU32(dst, (deUint32)(m_baseOffset + m_data.size()));
+		putU32(dst+4, (deUint32)length);
+		m_data.append(str, (size_t)length);
+	}
+
+	void add (deUint8* dst, const ri::String& str) { add(dst, str.c_str(), str.size()); }
+
+	const string&	getData		(void) const { return m_data; }
+
+private:
+	const deUint64	m_baseOffset;
+	string			m_data;
+};
+
+string getString (const deUint8* data, deUint64 size, const deUint8* ref)
+{
+	const deUint32 offset = getU32(ref);
+	const deUint32 length = getU32(ref+4);
+
+	if (offset > size || size - offset < length)
+		throw ParseError("Invalid string in sample list file");
+
+	return string((const char*)data + offset, length);
+}
+
+} // anonymous
+
+void writeSampleListFile (const char* filename, const ri::SampleList& sampleList, Compression compression)
+{
+	const int	numSamples		= sampleList.getNumSamples();
+	int			numColumns		= sampleList.sampleInfo.valueInfos.getNumItems();
+
+	// Samples may have more values than there are ValueInfos.
+	for (int sampleNdx = 0; sampleNdx < numSamples; sampleNdx++)
+		numColumns = de::max(numColumns, sampleList.getNumValues(sampleNdx));
+
+	vector<deUint8>				headers		(FILE_HEADER_SIZE + numColumns*COLUMN_HEADER_SIZE, 0);
+	StringTable					strings		((deUint64)headers.size());
+	vector<vector<deUint8> >	blocks		(numColumns);
+
+	deMemcpy(&headers[0], s_fileMagic, MAGIC_SIZE);
+	putU32(&headers[8], FILE_VERSION);
+	putU32(&headers[12], (deUint32)numColumns);
+	putU64(&headers[16], (deUint64)numSamples);
+	strings.add(&headers[24], sampleList.name);
+	strings.add(&headers[32], sampleList.description);
+
+	for (int columnNdx = 0; columnNdx < numColumns; columnNdx++)
+	{
+		deUint8* const				colHeader	= &headers[FILE_HEADER_SIZE + columnNdx*COLUMN_HEADER_SIZE];
+		const ri::ValueInfo*		valueInfo	= columnNdx < sampleList.sampleInfo.valueInfos.getNumItems()
+												? &static_cast<const ri::ValueInfo&>(sampleList.sampleInfo.valueInfos.getItem(columnNdx))
+												: DE_NULL;
+		vector<ri::NumericValue>	values		(numSamples);
+
+		for (int sampleNdx = 0; sampleNdx < numSamples; sampleNdx++)
+		{
+			if (columnNdx < sampleList.getNumValues(sampleNdx))
+				values[sampleNdx] = sampleList.getValue(sampleNdx, columnNdx);
+		}
+
+		const ColumnType	type	= getColumnType(values);
+		const ColumnStats	stats	= computeStats(values);
+		Compression			usedCompression	= COMPRESSION_NONE;
+		vector<deUint8>		data;
+
+		encodeColumn(values, type, data);
+
+		if (compression == COMPRESSION_DEFLATE && !data.empty())
+		{
+			xs::DataCompressor	compressor;
+			vector<deUint8>		compressed;
+			const int			compressedSize	= compressor.compress(&data[0], (int)data.size(), compressed, 0);
+
+			if (compressedSize < (int)data.size())
+			{
+				compressed.resize(compressedSize);
+				putU64(colHeader+56, (deUint64)data.size());
+				data.swap(compressed);
+				usedCompression = COMPRESSION_DEFLATE;
+			}
+		}
+
+		if (usedCompression == COMPRESSION_NONE)
+			putU64(colHeader+56, (deUint64)data.size());
+
+		strings.add(colHeader+0,	valueInfo ? valueInfo->name			: ri::String());
+		strings.add(colHeader+8,	valueInfo ? valueInfo->description	: ri::String());
+		strings.add(colHeader+16,	valueInfo ? valueInfo->unit			: ri::String());
+
+		putU32(colHeader+24, (deUint32)(valueInfo ? valueInfo->tag : ri::ValueInfo::VALUETAG_LAST));
+		putU32(colHeader+28, (deUint32)type);
+		putU32(colHeader+32, (deUint32)usedCompression);
+		putU64(colHeader+48, (deUint64)data.size());
+
+		putU64(colHeader+64, (deUint64)stats.numValues);
+		putF64(colHeader+72, stats.min);
+		putF64(colHeader+80, stats.max);
+		putF64(colHeader+88, stats.mean);
+		putF64(colHeader+96, stats.median);
+		putF64(colHeader+104, stats.stdDev);
+
+		blocks[columnNdx].swap(data);
+	}
+
+	// Place column data after strings.
+	{
+		deUint64 offset = alignOffset(headers.size() + strings.getData().size());
+
+		for (int columnNdx = 0; columnNdx < numColumns; columnNdx++)
+		{
+			putU64(&headers[FILE_HEADER_SIZE + columnNdx*COLUMN_HEADER_SIZE + 40], offset);
+			offset = alignOffset(offset + blocks[columnNdx].size());
+		}
+	}
+
+	{
+		std::ofstream		out			(filename, std::ios_base::binary);
+		const char			padding[DATA_ALIGNMENT]	= { 0 };
+		deUint64			offset		= 0;
+
+		if (!out.good())
+			throw Error(string("Failed to open '") + filename + "'");
+
+		out.write((const char*)&headers[0], (std::streamsize)headers.size());
+		out.write(strings.getData().c_str(), (std::streamsize)strings.getData().size());
+		offset = headers.size() + strings.getData().size();
+
+		for (int columnNdx = 0; columnNdx < numColumns; columnNdx++)
+		{
+			out.write(padding, (std::streamsize)(alignOffset(offset) - offset));
+			offset = alignOffset(offset);
+
+			if (!blocks[columnNdx].empty())
+				out.write((const char*)&blocks[columnNdx][0], (std::streamsize)blocks[columnNdx].size());
+			offset += blocks[columnNdx].size();
+		}
+
+		if (!out.good())
+			throw Error(string("Failed to write '") + filename + "'");
+	}
+}
+
+SampleListFile::SampleListFile (const char* filename)
+	: m_mapping		(DE_NULL)
+	, m_numSamples	(0)
+{
+	{
+		deFile* file = deFile_create(filename, DE_FILEMODE_OPEN|DE_FILEMODE_READ);
+
+		if (!file)
+			throw Error(string("Failed to open '") + filename + "'");
+
+		m_mapping = deFileMapping_create(file);
+		deFile_destroy(file);
+
+		if (!m_mapping)
+			throw Error(string("Failed to map '") + filename + "'");
+	}
+
+	try
+	{
+		load((const deUint8*)deFileMapping_getData(m_mapping), (deUint64)deFileMapping_getSize(m_mapping));
+	}
+	catch (...)
+	{
+		deFileMapping_destroy(m_mapping);
+		throw;
+	}
+}
+
+SampleListFile::~SampleListFile (void)
+{
+	deFileMapping_destroy(m_mapping);
+}
+
+void SampleListFile::load (const deUint8* data, deUint64 size)
+{
+	if (size < FILE_HEADER_SIZE || deMemCmp(data, s_fileMagic, MAGIC_SIZE) != 0)
+		throw ParseError("Not a sample list file");
+
+	if (getU32(data+8) != FILE_VERSION)
+		throw ParseError("Unsupported sample list file version");
+
+	const deUint32	numColumns	= getU32(data+12);
+	const deUint64	numSamples	= getU64(data+16);
+
+	if (numSamples > (deUint64)0x7fffffff || (size - FILE_HEADER_SIZE) / COLUMN_HEADER_SIZE < numColumns)
+		throw ParseError("Invalid sample list file header");
+
+	m_numSamples = (int)numSamples;
+
+	m_name			= getString(data, size, data+24);
+	m_description	= getString(data, size, data+32);
+
+	m_columns.resize(numColumns);
+	m_columnData.resize(numColumns, DE_NULL);
+	m_decodedData.resize(numColumns);
+
+	for (deUint32 columnNdx = 0; columnNdx < numColumns; columnNdx++)
+	{
+		const deUint8* const	colHeader	= data + FILE_HEADER_SIZE + columnNdx*COLUMN_HEADER_SIZE;
+		ColumnInfo&				column		= m_columns[columnNdx];
+
+		column.name			= getString(data, size, colHeader+0);
+		column.description	= getString(data, size, colHeader+8);
+		column.unit			= getString(data, size, colHeader+16);
+
+		column.tag			= (ri::ValueInfo::ValueTag)getU32(colHeader+24);
+		column.type			= (ColumnType)getU32(colHeader+28);
+		column.compression	= (Compression)getU32(colHeader+32);
+
+		column.stats.numValues	= (int)getU64(colHeader+64);
+		column.stats.min		= getF64(colHeader+72);
+		column.stats.max		= getF64(colHeader+80);
+		column.stats.mean		= getF64(colHeader+88);
+		column.stats.median		= getF64(colHeader+96);
+		column.stats.stdDev		= getF64(colHeader+104);
+
+		if (!de::inBounds<int>(column.tag, 0, ri::ValueInfo::VALUETAG_LAST+1) ||
+			!de::inBounds<int>(column.type, 0, COLUMNTYPE_LAST) ||
+			!de::inBounds<int>(column.compression, 0, COMPRESSION_LAST))
+			throw ParseError("Invalid column in sample list file");
+
+		{
+			const deUint64	dataOffset		= getU64(colHeader+40);
+			const deUint64	dataSize		= getU64(colHeader+48);
+			const deUint64	decodedSize		= getU64(colHeader+56);
+			const deUint64	expectedSize	= numSamples*VALUE_SIZE + (column.type == COLUMNTYPE_MIXED ? numSamples : 0);
+			bool			needsSwap		= DE_ENDIANNESS != DE_LITTLE_ENDIAN;
+
+			if (dataOffset > size || size - dataOffset < dataSize || dataOffset % DATA_ALIGNMENT != 0 || decodedSize != expectedSize)
+				throw ParseError("Invalid column data in sample list file");
+
+			if (column.compression == COMPRESSION_DEFLATE)
+			{
+				xs::DataDecompressor	decompressor;
+				vector<deUint8>&		decoded			= m_decodedData[columnNdx];
+				int						numDecoded		= 0;
+
+				try
+				{
+					numDecoded = decompressor.decompress(data + dataOffset, (int)dataSize, decoded);
+				}
+				catch (const xs::Error&)
+				{
+					numDecoded = -1;
+				}
+
+				if (numDecoded != (int)decodedSize)
+					throw ParseError("Invalid compressed column data in sample list file");
+			}
+			else
+			{
+				if (dataSize != decodedSize)
+					throw ParseError("Invalid column data in sample list file");
+
+				if (needsSwap)
+					m_decodedData[columnNdx].assign(data + dataOffset, data + dataOffset + dataSize);
+				else
+					m_columnData[columnNdx] = data + dataOffset;
+			}
+
+			if (!m_decodedData[columnNdx].empty())
+			{
+				vector<deUint8>& decoded = m_decodedData[columnNdx];
+
+				// Convert values to host byte order.
+				if (needsSwap)
+				{
+					for (int sampleNdx = 0; sampleNdx < m_numSamples; sampleNdx++)
+						std::reverse(decoded.begin() + sampleNdx*VALUE_SIZE, decoded.begin() + (sampleNdx+1)*VALUE_SIZE);
+				}
+
+				m_columnData[columnNdx] = &decoded[0];
+			}
+		}
+	}
+}
+
+ri::NumericValue SampleListFile::getValue (int columnNdx, int sampleNdx) const
+{
+	const ColumnInfo&				column		= m_columns[columnNdx];
+	const deUint8* const			values		= m_columnData[columnNdx];
+	ri::NumericValue::Type			type		= ri::NumericValue::TYPE_LAST;
+
+	DE_ASSERT(de::inBounds(sampleNdx, 0, m_numSamples));
+
+	switch (column.type)
+	{
+		case COLUMNTYPE_INT64:		type = ri::NumericValue::TYPE_INT64;									break;
+		case COLUMNTYPE_FLOAT64:	type = ri::NumericValue::TYPE_FLOAT64;									break;
+		case COLUMNTYPE_MIXED:		type = (ri::NumericValue::Type)values[m_numSamples*VALUE_SIZE + sampleNdx];	break;
+		default:
+			DE_ASSERT(false);
+	}
+
+	if (type == ri::NumericValue::TYPE_INT64)
+	{
+		deInt64 value;
+		deMemcpy(&value, values + sampleNdx*VALUE_SIZE, sizeof(value));
+		return ri::NumericValue(value);
+	}
+	else if (type == ri::NumericValue::TYPE_FLOAT64)
+	{
+		double value;
+		deMemcpy(&value, values + sampleNdx*VALUE_SIZE, sizeof(value));
+		return ri::NumericValue(value);
+	}
+	else
+		return ri::NumericValue();
+}
+
+const deInt64* SampleListFile::getInt64Values (int columnNdx) const
+{
+	DE_ASSERT(m_columns[columnNdx].type == COLUMNTYPE_INT64);
+	return reinterpret_cast<const deInt64*>(m_columnData[columnNdx]);
+}
+
+const double* SampleListFile::getFloat64Values (int columnNdx) const
+{
+	DE_ASSERT(m_columns[columnNdx].type == COLUMNTYPE_FLOAT64);
+	return reinterpret_cast<const double*>(m_columnData[columnNdx]);
+}
+
+} // samplelist
+} // xe
@@ -0,0 +1,146 @@
+#ifndef _XESAMPLELISTFILE_HPP
+#define _XESAMPLELISTFILE_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Columnar binary sample list file.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeDefs.hpp"
+#include "xeTestCaseResult.hpp"
+#include "deFile.h"
+
+#include <string>
+#include <vector>
+
+namespace xe
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Columnar binary sample list file
+ *
+ * Sample list file stores one ri::SampleList with one column per value.
+ * All integers are little-endian and all offsets are from start of file.
+ *
+ *  FileHeader		magic "xesample", version, number of columns and
+ *					samples, list name and description
+ *  ColumnHeader[]	value name, description, unit, tag, column type,
+ *					compression, data location and statistics
+ *  string data
+ *  column data		each block starts at 8-byte aligned offset
+ *
+ * Column data contains a 64-bit integer or double for each sample.
+ * COLUMNTYPE_MIXED columns contain samples of different types or missing
+ * values, and store ri::NumericValue::Type of each sample as a byte after
+ * the values. Column data may be deflate-compressed. Uncompressed columns
+ * can be accessed in place from a memory-mapped file.
+ *//*--------------------------------------------------------------------*/
+namespace samplelist
+{
+
+enum
+{
+	FILE_VERSION	= 1
+};
+
+enum ColumnType
+{
+	COLUMNTYPE_INT64 = 0,
+	COLUMNTYPE_FLOAT64,
+	COLUMNTYPE_MIXED,		//!< Per-sample type follows values.
+
+	COLUMNTYPE_LAST
+};
+
+enum Compression
+{
+	COMPRESSION_NONE = 0,
+	COMPRESSION_DEFLATE,
+
+	COMPRESSION_LAST
+};
+
+//! Statistics of non-empty values in column, converted to double.
+struct ColumnStats
+{
+	int						numValues;
+	double					min;
+	double					max;
+	double					mean;
+	double					median;
+	double					stdDev;
+
+	ColumnStats (void) : numValues(0), min(0.0), max(0.0), mean(0.0), median(0.0), stdDev(0.0) {}
+};
+
+struct ColumnInfo
+{
+	std::string				name;
+	std::string				description;
+	std::string				unit;
+	ri::ValueInfo::ValueTag	tag;
+	ColumnType				type;
+	Compression				compression;
+	ColumnStats				stats;
+
+	ColumnInfo (void) : tag(ri::ValueInfo::VALUETAG_LAST), type(COLUMNTYPE_LAST), compression(COMPRESSION_LAST) {}
+};
+
+//! Write sample list to file. Compressed column is stored as is if compression does not reduce size.
+void	writeSampleListFile		(const char* filename, const ri::SampleList& sampleList, Compression compression);
+
+class SampleListFile
+{
+public:
+	explicit				SampleListFile		(const char* filename);
+							~SampleListFile		(void);
+
+	const std::string&		getName				(void) const	{ return m_name;						}
+	const std::string&		getDescription		(void) const	{ return m_description;					}
+
+	int						getNumColumns		(void) const	{ return (int)m_columns.size();			}
+	int						getNumSamples		(void) const	{ return m_numSamples;					}
+	const ColumnInfo&		getColumnInfo		(int columnNdx) const	{ return m_columns[columnNdx];	}
+
+	ri::NumericValue		getValue			(int columnNdx, int sampleNdx) const;
+
+	const deInt64*			getInt64Values		(int columnNdx) const;	//!< Only for COLUMNTYPE_INT64 columns.
+	const double*			getFloat64Values	(int columnNdx) const;	//!< Only for COLUMNTYPE_FLOAT64 columns.
+
+private:
+							SampleListFile		(const SampleListFile& other);
+	SampleListFile&			operator=			(const SampleListFile& other);
+
+	void					load				(const deUint8* data, deUint64 size);
+
+	deFileMapping*							m_mapping;
+
+	std::string								m_name;
+	std::string								m_description;
+	int										m_numSamples;
+	std::vector<ColumnInfo>					m_columns;
+	std::vector<const deUint8*>				m_columnData;	//!< Values in host byte order, points to mapping or m_decodedData.
+	std::vector<std::vector<deUint8> >		m_decodedData;	//!< Decompressed or byte-swapped columns.
+};
+
+} // samplelist
+} // xe
+
+#endif // _XESAMPLELISTFILE_HPP
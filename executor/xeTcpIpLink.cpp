@@ -50,6 +50,19 @@ static void writeKeepalive (de::BlockBuffer<deUint8>& dst)
 	dst.flush();
 }
 
+static void writeHello (de::BlockBuffer<deUint8>& dst, deUint32 features, int maxMessageSize)
+{
+	xs::HelloMessage		msg;
+	std::vector<deUint8>	buf;
+
+	msg.features		= features;
+	msg.maxMessageSize	= maxMessageSize;
+	msg.write(buf);
+
+	dst.write((int)buf.size(), &buf[0]);
+	dst.flush();
+}
+
 static void writeExecuteBinary (de::BlockBuffer<deUint8>& dst, const char* name, const char* params, const char* workDir, const char* caseList)
 {
 	int		nameSize			= (int)strlen(name)		+ 1;
@@ -278,6 +291,7 @@ void TcpIpRecvThread::start (void)
 
 	// Reset state.
 	m_curMsgPos = 0;
+	m_decompressor.clear();
 	m_isRunning = true;
 
 	de::Thread::start();
@@ -389,6 +403,26 @@ void TcpIpRecvThread::handleMessage (xs::MessageType messageType, const deUint8*
 			break;
 		}
 
+		case xs::MESSAGETYPE_HELLO_REPLY:
+		{
+			xs::HelloReplyMessage msg(data, dataSize);
+			XE_CHECK_MSG(msg.version == xs::PROTOCOL_VERSION, "Unexpected protocol version");
+			break;
+		}
+
+		case xs::MESSAGETYPE_COMPRESSED_DATA:
+		{
+			xs::CompressedDataMessage msg(data, dataSize);
+			XE_CHECK_MSG(msg.dataType == xs::MESSAGETYPE_PROCESS_LOG_DATA || msg.dataType == xs::MESSAGETYPE_INFO, "Invalid COMPRESSED_DATA message");
+
+			if (!m_decompressor)
+				m_decompressor = de::MovePtr<xs::DataDecompressor>(new xs::DataDecompressor());
+
+			if (m_decompressor->decompress(msg.data.empty() ? DE_NULL : &msg.data[0], (int)msg.data.size(), m_decompressedBuf) > 0)
+				handleMessage(msg.dataType, &m_decompressedBuf[0], (int)m_decompressedBuf.size());
+			break;
+		}
+
 		case xs::MESSAGETYPE_PROCESS_LOG_DATA:
 		case xs::MESSAGETYPE_INFO:
 			// Ignore leading \0 if such is present. \todo [2012-06-19 pyry] Improve protocol.
@@ -416,6 +450,8 @@ TcpIpLink::TcpIpLink (void)
 	, m_sendThread		(m_socket, m_state)
 	, m_recvThread		(m_socket, m_state)
 	, m_keepaliveTimer	(DE_NULL)
+	, m_features		(0)
+	, m_maxMessageSize	(xs::DEFAULT_MAX_MESSAGE_SIZE)
 {
 	m_keepaliveTimer = deTimer_create(keepaliveTimerCallback, this);
 	XE_CHECK(m_keepaliveTimer);
@@ -455,6 +491,21 @@ void TcpIpLink::closeConnection (void)
 		m_socket.close();
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Set protocol options requested on connect
+ * \param features			xs::ProtocolFeature bits
+ * \param maxMessageSize	Largest message that server may send
+ *
+ * HELLO is only sent if options differ from defaults, since servers
+ * older than protocol version 19 don't accept it.
+ *//*--------------------------------------------------------------------*/
+void TcpIpLink::setProtocolOptions (deUint32 features, int maxMessageSize)
+{
+	XE_CHECK(m_socket.getState() == DE_SOCKETSTATE_CLOSED);
+	m_features			= features;
+	m_maxMessageSize	= maxMessageSize;
+}
+
 void TcpIpLink::connect (const de::SocketAddress& address)
 {
 	XE_CHECK(m_socket.getState() == DE_SOCKETSTATE_CLOSED);
@@ -474,6 +525,9 @@ void TcpIpLink::connect (const de::SocketAddress& address)
 		m_sendThread.start();
 		m_recvThread.start();
 
+		if (m_features != 0 || m_maxMessageSize != xs::DEFAULT_MAX_MESSAGE_SIZE)
+			writeHello(m_sendThread.getBuffer(), m_features, m_maxMessageSize);
+
 		XE_CHECK(deTimer_scheduleInterval(m_keepaliveTimer, xs::KEEPALIVE_SEND_INTERVAL));
 	}
 	catch (const std::exception& e)
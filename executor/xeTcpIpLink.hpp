@@ -29,8 +29,10 @@
 #include "deRingBuffer.hpp"
 #include "deBlockBuffer.hpp"
 #include "xsProtocol.hpp"
+#include "xsCompression.hpp"
 #include "deThread.hpp"
 #include "deTimer.h"
+#include "deUniquePtr.hpp"
 
 #include <vector>
 
@@ -112,6 +114,9 @@ private:
 	std::vector<deUint8>		m_curMsgBuf;
 	int							m_curMsgPos;
 
+	de::MovePtr<xs::DataDecompressor>	m_decompressor;		//!< Created for each connection, since compressed data is single stream.
+	std::vector<deUint8>		m_decompressedBuf;
+
 	bool						m_isRunning;
 };
 
@@ -122,6 +127,7 @@ public:
 								~TcpIpLink				(void);
 
 	// TcpIpLink -specific API
+	void						setProtocolOptions		(deUint32 features, int maxMessageSize);
 	void						connect					(const de::SocketAddress& address);
 	void						disconnect				(void);
 
@@ -148,6 +154,9 @@ private:
 	TcpIpRecvThread				m_recvThread;
 
 	deTimer*					m_keepaliveTimer;
+
+	deUint32					m_features;				//!< Requested xs::ProtocolFeature bits.
+	int							m_maxMessageSize;
 };
 
 } // xe
@@ -22,9 +22,12 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xeTestCaseResult.hpp"
+#include "deMemory.h"
+#include "deString.h"
 
 #include <iomanip>
 #include <limits>
+#include <cstring>
 
 namespace xe
 {
@@ -56,15 +59,131 @@ const char* getTestStatusCodeName (TestStatusCode code)
 namespace ri
 {
 
-List::List (void)
+enum
 {
+	MAX_INTERNED_STRING_LENGTH	= 256,	//!< Longer strings are only copied.
+	INITIAL_INTERN_TABLE_SIZE	= 64
+};
+
+bool operator== (const String& a, const String& b)
+{
+	return a.size() == b.size() && deMemCmp(a.c_str(), b.c_str(), a.size()) == 0;
 }
 
-List::~List (void)
+bool operator== (const String& a, const char* b)
 {
-	for (std::vector<Item*>::iterator i = m_items.begin(); i != m_items.end(); i++)
-		delete *i;
-	m_items.clear();
+	return (int)strlen(b) == a.size() && deMemCmp(a.c_str(), b, a.size()) == 0;
+}
+
+std::ostream& operator<< (std::ostream& str, const String& string)
+{
+	return str.write(string.c_str(), string.size());
+}
+
+Arena::Arena (void)
+	: m_pool			(DE_NULL)
+	, m_internTable		(DE_NULL)
+	, m_internTableSize	(0)
+	, m_numInterned		(0)
+{
+}
+
+Arena::~Arena (void)
+{
+	delete m_pool;
+}
+
+void* Arena::alloc (int numBytes)
+{
+	if (!m_pool)
+		m_pool = new de::MemPool();
+
+	return m_pool->alignedAlloc((deUintptr)numBytes, ALLOC_ALIGNMENT);
+}
+
+deUintptr Arena::getNumAllocatedBytes (void) const
+{
+	return m_pool ? m_pool->getNumAllocatedBytes(false) : 0;
+}
+
+String Arena::copyString (const char* str, int length)
+{
+	if (length == 0)
+		return String();
+
+	char* const dst = static_cast<char*>(alloc(length+1));
+
+	deMemcpy(dst, str, length);
+	dst[length] = 0;
+
+	return String(dst, length);
+}
+
+void Arena::growInternTable (void)
+{
+	const int		newSize		= m_internTableSize > 0 ? m_internTableSize*2 : INITIAL_INTERN_TABLE_SIZE;
+	InternEntry*	newTable	= static_cast<InternEntry*>(alloc((int)sizeof(InternEntry)*newSize));
+
+	for (int ndx = 0; ndx < newSize; ndx++)
+	{
+		new (&newTable[ndx]) InternEntry();
+		newTable[ndx].string	= String(DE_NULL, 0);
+		newTable[ndx].hash		= 0;
+	}
+
+	for (int ndx = 0; ndx < m_internTableSize; ndx++)
+	{
+		const InternEntry& entry = m_internTable[ndx];
+
+		if (entry.string.m_str)
+		{
+			int slot = (int)(entry.hash & (deUint32)(newSize-1));
+
+			while (newTable[slot].string.m_str)
+				slot = (slot+1) & (newSize-1);
+
+			newTable[slot] = entry;
+		}
+	}
+
+	m_internTable		= newTable;
+	m_internTableSize	= newSize;
+}
+
+String Arena::internString (const char* str)
+{
+	const int length = (int)strlen(str);
+
+	if (length == 0)
+		return String();
+	else if (length > MAX_INTERNED_STRING_LENGTH)
+		return copyString(str, length);
+
+	if ((m_numInterned+1)*2 > m_internTableSize)
+		growInternTable();
+
+	{
+		const deUint32	hash	= deMemoryHash(str, length);
+		int				slot	= (int)(hash & (deUint32)(m_internTableSize-1));
+
+		for (;;)
+		{
+			InternEntry& entry = m_internTable[slot];
+
+			if (!entry.string.m_str)
+			{
+				entry.string	= copyString(str, length);
+				entry.hash		= hash;
+				m_numInterned	+= 1;
+
+				return entry.string;
+			}
+			else if (entry.hash == hash && entry.string.m_length == length && deMemCmp(entry.string.m_str, str, length) == 0)
+				return entry.string;
+
+			slot = (slot+1) & (m_internTableSize-1);
+		}
+	}
 }
 
 std::ostream& operator<< (std::ostream& str, const NumericValue& value)
@@ -25,10 +25,11 @@
 
 #include "xeDefs.hpp"
 #include "xeTestCase.hpp"
+#include "deMemPool.hpp"
 
 #include <string>
-#include <vector>
 #include <ostream>
+#include <new>
 
 namespace xe
 {
@@ -80,31 +81,175 @@ class ValueInfo;
 class Sample;
 class SampleValue;
 
+class Arena;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Immutable string stored in Arena
+ *//*--------------------------------------------------------------------*/
+class String
+{
+public:
+						String			(void) : m_str(""), m_length(0) {}
+
+	const char*			c_str			(void) const	{ return m_str;				}
+	int					size			(void) const	{ return m_length;			}
+	bool				empty			(void) const	{ return m_length == 0;		}
+
+						operator std::string	(void) const	{ return std::string(m_str, m_str+m_length);	}
+
+private:
+	friend class Arena;
+
+						String			(const char* str, int length) : m_str(str), m_length(length) {}
+
+	const char*			m_str;			//!< Null-terminated.
+	int					m_length;
+};
+
+bool			operator==		(const String& a, const String& b);
+bool			operator==		(const String& a, const char* b);
+std::ostream&	operator<<		(std::ostream& str, const String& string);
+
+inline bool		operator!=		(const String& a, const String& b)	{ return !(a == b); }
+inline bool		operator!=		(const String& a, const char* b)	{ return !(a == b); }
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Storage for result items
+ *
+ * All result items, strings and arrays of a TestCaseResult are allocated
+ * from its arena and released at once when the arena is destroyed.
+ * Destructors of objects allocated from the arena are never called.
+ *
+ * Short strings such as names and units are interned; repeated values
+ * share the same storage.
+ *//*--------------------------------------------------------------------*/
+class Arena
+{
+public:
+	enum
+	{
+		ALLOC_ALIGNMENT = 8		//!< Alignment of all allocations.
+	};
+
+						Arena			(void);
+						~Arena			(void);
+
+	void*				alloc			(int numBytes);
+
+	String				copyString		(const char* str, int length);
+	String				copyString		(const std::string& str)	{ return copyString(str.c_str(), (int)str.size());	}
+	String				internString	(const char* str);
+
+	deUintptr			getNumAllocatedBytes	(void) const;
+
+private:
+						Arena			(const Arena& other);
+	Arena&				operator=		(const Arena& other);
+
+	struct InternEntry
+	{
+		String			string;
+		deUint32		hash;
+	};
+
+	void				growInternTable	(void);
+
+	de::MemPool*		m_pool;				//!< Created on first allocation.
+	InternEntry*		m_internTable;		//!< Open addressing hash table, empty entries have null c_str().
+	int					m_internTableSize;
+	int					m_numInterned;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Growable array stored in Arena
+ *
+ * T must be trivially destructible. Storage is reallocated from the arena
+ * when array grows and previous storage is left unused until the arena is
+ * destroyed.
+ *//*--------------------------------------------------------------------*/
+template <typename T>
+class ArenaArray
+{
+public:
+						ArenaArray		(void) : m_elements(DE_NULL), m_size(0), m_capacity(0) {}
+
+	int					size			(void) const		{ return m_size;						}
+	bool				empty			(void) const		{ return m_size == 0;					}
+
+	const T&			operator[]		(int ndx) const		{ DE_ASSERT(de::inBounds(ndx, 0, m_size)); return m_elements[ndx];	}
+	T&					operator[]		(int ndx)			{ DE_ASSERT(de::inBounds(ndx, 0, m_size)); return m_elements[ndx];	}
+
+	const T*			getPtr			(void) const		{ return m_elements;					}
+
+	void				pushBack		(Arena& arena, const T& value);
+	void				append			(Arena& arena, const T* values, int numValues);
+
+private:
+	void				reserve			(Arena& arena, int capacity);
+
+	T*					m_elements;
+	int					m_size;
+	int					m_capacity;
+};
+
+template <typename T>
+void ArenaArray<T>::reserve (Arena& arena, int capacity)
+{
+	if (capacity > m_capacity)
+	{
+		const int	newCapacity	= de::max(capacity, de::max(4, m_capacity*2));
+		T*			newElements	= static_cast<T*>(arena.alloc((int)sizeof(T)*newCapacity));
+
+		for (int ndx = 0; ndx < m_size; ndx++)
+			new (&newElements[ndx]) T(m_elements[ndx]);
+
+		m_elements	= newElements;
+		m_capacity	= newCapacity;
+	}
+}
+
+template <typename T>
+inline void ArenaArray<T>::pushBack (Arena& arena, const T& value)
+{
+	if (m_size == m_capacity)
+		reserve(arena, m_size+1);
+
+	new (&m_elements[m_size]) T(value);
+	m_size += 1;
+}
+
+template <typename T>
+void ArenaArray<T>::append (Arena& arena, const T* values, int numValues)
+{
+	reserve(arena, m_size+numValues);
+
+	for (int ndx = 0; ndx < numValues; ndx++)
+		new (&m_elements[m_size+ndx]) T(values[ndx]);
+
+	m_size += numValues;
+}
+
 // \todo [2014-02-28 pyry] Make List<T> for items that have only specific subitems.
 
 class List
 {
 public:
-							List			(void);
-							~List			(void);
-
-	int						getNumItems		(void) const	{ return (int)m_items.size();	}
-	const Item&				getItem			(int ndx) const	{ return *m_items[ndx];			}
-	Item&					getItem			(int ndx)		{ return *m_items[ndx];			}
+	int						getNumItems		(void) const	{ return m_items.size();	}
+	const Item&				getItem			(int ndx) const	{ return *m_items[ndx];		}
+	Item&					getItem			(int ndx)		{ return *m_items[ndx];		}
 
 	template <typename T>
-	T*						allocItem		(void);
+	T*						allocItem		(Arena& arena);
 
 private:
-	std::vector<Item*>		m_items;
+	ArenaArray<Item*>		m_items;
 };
 
 template <typename T>
-T* List::allocItem (void)
+T* List::allocItem (Arena& arena)
 {
-	m_items.reserve(m_items.size()+1);
-	T* item = new T();
-	m_items.push_back(static_cast<ri::Item*>(item));
+	T* item = new (arena.alloc((int)sizeof(T))) T();
+	m_items.pushBack(arena, static_cast<ri::Item*>(item));
 	return item;
 }
 
@@ -124,6 +269,7 @@ public:
 class TestCaseResult : public TestCaseResultHeader
 {
 public:
+	ri::Arena			arena;					//!< Storage for result items.
 	ri::List			resultItems;			//!< Test log items.
 };
 
@@ -188,6 +334,7 @@ private:
 
 std::ostream& operator<< (std::ostream& str, const NumericValue& value);
 
+//! Result item base class. Items are allocated from Arena and never destroyed.
 class Item
 {
 public:
@@ -213,7 +360,7 @@ public:
 						~Result			(void) {}
 
 	TestStatusCode		statusCode;
-	std::string			details;
+	String				details;
 };
 
 class Text : public Item
@@ -222,7 +369,7 @@ public:
 						Text			(void) : Item(TYPE_TEXT) {}
 						~Text			(void) {}
 
-	std::string			text;
+	String				text;
 };
 
 class Number : public Item
@@ -231,10 +378,10 @@ public:
 						Number			(void) : Item(TYPE_NUMBER) {}
 						~Number			(void) {}
 
-	std::string			name;
-	std::string			description;
-	std::string			unit;
-	std::string			tag;
+	String				name;
+	String				description;
+	String				unit;
+	String				tag;
 	NumericValue		value;
 };
 
@@ -260,13 +407,13 @@ public:
 							Image		(void) : Item(TYPE_IMAGE), width(0), height(0), format(FORMAT_LAST), compression(COMPRESSION_LAST) {}
 							~Image		(void) {}
 
-	std::string				name;
-	std::string				description;
+	String					name;
+	String					description;
 	int						width;
 	int						height;
 	Format					format;
 	Compression				compression;
-	std::vector<deUint8>	data;
+	ArenaArray<deUint8>		data;
 };
 
 class ImageSet : public Item
@@ -275,8 +422,8 @@ public:
 						ImageSet		(void) : Item(TYPE_IMAGESET) {}
 						~ImageSet		(void) {}
 
-	std::string			name;
-	std::string			description;
+	String				name;
+	String				description;
 	List				images;
 };
 
@@ -286,7 +433,7 @@ public:
 						ShaderSource		(void) : Item(TYPE_SHADERSOURCE) {}
 						~ShaderSource		(void) {}
 
-	std::string			source;
+	String				source;
 };
 
 class InfoLog : public Item
@@ -295,7 +442,7 @@ public:
 						InfoLog				(void) : Item(TYPE_INFOLOG) {}
 						~InfoLog			(void) {}
 
-	std::string			log;
+	String				log;
 };
 
 class Shader : public Item
@@ -348,10 +495,10 @@ public:
 	int					alphaMaskSize;
 	bool				bindToTextureRGB;
 	bool				bindToTextureRGBA;
-	std::string			colorBufferType;
-	std::string			configCaveat;
+	String				colorBufferType;
+	String				configCaveat;
 	int					configID;
-	std::string			conformant;
+	String				conformant;
 	int					depthSize;
 	int					level;
 	int					maxPBufferWidth;
@@ -360,12 +507,12 @@ public:
 	int					maxSwapInterval;
 	int					minSwapInterval;
 	bool				nativeRenderable;
-	std::string			renderableType;
+	String				renderableType;
 	int					sampleBuffers;
 	int					samples;
 	int					stencilSize;
-	std::string			surfaceTypes;
-	std::string			transparentType;
+	String				surfaceTypes;
+	String				transparentType;
 	int					transparentRedValue;
 	int					transparentGreenValue;
 	int					transparentBlueValue;
@@ -406,8 +553,8 @@ public:
 						EglConfigSet		(void) : Item(TYPE_EGLCONFIGSET) {}
 						~EglConfigSet		(void) {}
 
-	std::string			name;
-	std::string			description;
+	String				name;
+	String				description;
 	List				configs;
 };
 
@@ -417,8 +564,8 @@ public:
 						Section			(void) : Item(TYPE_SECTION) {}
 						~Section		(void) {}
 
-	std::string			name;
-	std::string			description;
+	String				name;
+	String				description;
 	List				items;
 };
 
@@ -428,7 +575,7 @@ public:
 						KernelSource	(void) : Item(TYPE_KERNELSOURCE) {}
 						~KernelSource	(void) {}
 
-	std::string			source;
+	String				source;
 };
 
 class CompileInfo : public Item
@@ -437,8 +584,8 @@ public:
 						CompileInfo		(void) : Item(TYPE_COMPILEINFO), compileStatus(false) {}
 						~CompileInfo	(void) {}
 
-	std::string			name;
-	std::string			description;
+	String				name;
+	String				description;
 	bool				compileStatus;
 	InfoLog				infoLog;
 };
@@ -457,9 +604,9 @@ public:
 						ValueInfo		(void) : Item(TYPE_VALUEINFO), tag(VALUETAG_LAST) {}
 						~ValueInfo		(void) {}
 
-	std::string			name;
-	std::string			description;
-	std::string			unit;
+	String				name;
+	String				description;
+	String				unit;
 	ValueTag			tag;
 };
 
@@ -472,36 +619,57 @@ public:
 	List				valueInfos;
 };
 
+//! Placeholder for <Value> while parsing, values are stored in SampleList.
 class SampleValue : public Item
 {
 public:
 						SampleValue		(void) : Item(TYPE_SAMPLEVALUE) {}
 						~SampleValue	(void) {}
-
-	NumericValue		value;
 };
 
+//! Placeholder for <Sample> while parsing, values are stored in SampleList.
 class Sample : public Item
 {
 public:
 						Sample			(void) : Item(TYPE_SAMPLE) {}
 						~Sample			(void) {}
-
-	List				values;
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Sample list
+ *
+ * Values of all samples are stored in a single array instead of separate
+ * Sample and SampleValue items.
+ *//*--------------------------------------------------------------------*/
 class SampleList : public Item
 {
 public:
-						SampleList		(void) : Item(TYPE_SAMPLELIST) {}
-						~SampleList		(void) {}
+								SampleList		(void) : Item(TYPE_SAMPLELIST) {}
+								~SampleList		(void) {}
+
+	int							getNumSamples	(void) const	{ return m_sampleOffsets.size();	}
+	int							getNumValues	(int sampleNdx) const;
+	const NumericValue&			getValue		(int sampleNdx, int valueNdx) const	{ return m_values[m_sampleOffsets[sampleNdx]+valueNdx];	}
+	const NumericValue*			getValues		(int sampleNdx) const				{ return m_values.getPtr()+m_sampleOffsets[sampleNdx];	}
+
+	void						addSample		(Arena& arena)								{ m_sampleOffsets.pushBack(arena, m_values.size());	}
+	void						addValue		(Arena& arena, const NumericValue& value)	{ DE_ASSERT(!m_sampleOffsets.empty()); m_values.pushBack(arena, value);	}
+
+	String						name;
+	String						description;
+	SampleInfo					sampleInfo;
 
-	std::string			name;
-	std::string			description;
-	SampleInfo			sampleInfo;
-	List				samples;
+private:
+	ArenaArray<int>				m_sampleOffsets;	//!< Index of first value of each sample in m_values.
+	ArenaArray<NumericValue>	m_values;
 };
 
+inline int SampleList::getNumValues (int sampleNdx) const
+{
+	const int end = sampleNdx+1 < m_sampleOffsets.size() ? m_sampleOffsets[sampleNdx+1] : m_values.size();
+	return end - m_sampleOffsets[sampleNdx];
+}
+
 } // ri
 } // xe
 
@@ -0,0 +1,520 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Indexed random access reader for test log files.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeTestLogIndex.hpp"
+#include "xeContainerFormatParser.hpp"
+#include "xeTestResultParser.hpp"
+#include "deString.h"
+#include "deMemory.h"
+
+#include <fstream>
+#include <cstring>
+
+using std::string;
+using std::vector;
+using std::map;
+
+namespace xe
+{
+
+namespace
+{
+
+enum
+{
+	SIDECAR_VERSION				= 1,
+	FINGERPRINT_BLOCK_SIZE		= 64*1024	//!< Bytes hashed from both ends of log file.
+};
+
+static const char	s_sidecarMagic[]	= "qpaindex";
+static const char	s_sidecarSuffix[]	= ".index";
+
+//! Find status code of last <Result> element in test case data.
+TestStatusCode findResultStatusCode (const deUint8* data, int dataSize)
+{
+	static const char	s_resultTag[]	= "<Result StatusCode=\"";
+	const int			tagLen			= DE_LENGTH_OF_ARRAY(s_resultTag)-1;
+
+	// \note <Result> is normally written last, so search backwards.
+	for (int pos = dataSize-tagLen; pos >= 0; pos--)
+	{
+		if (data[pos] == '<' && deMemCmp(data+pos, s_resultTag, tagLen) == 0)
+		{
+			const char*	valueStart	= (const char*)data + pos + tagLen;
+			const char*	valueEnd	= (const char*)memchr(valueStart, '"', (size_t)(dataSize-pos-tagLen));
+
+			if (!valueEnd)
+				break;
+
+			try
+			{
+				return getTestStatusCode(string(valueStart, valueEnd).c_str());
+			}
+			catch (const ParseError&)
+			{
+				break;
+			}
+		}
+	}
+
+	return TESTSTATUSCODE_LAST;
+}
+
+class SidecarWriter
+{
+public:
+	SidecarWriter (vector<deUint8>& buf) : m_buf(buf) {}
+
+	void putU32 (deUint32 value)
+	{
+		for (int ndx = 0; ndx < 4; ndx++)
+			m_buf.push_back((deUint8)(value >> (ndx*8)));
+	}
+
+	void putU64 (deUint64 value)
+	{
+		putU32((deUint32)value);
+		putU32((deUint32)(value >> 32));
+	}
+
+	void putString (const string& str)
+	{
+		putU32((deUint32)str.size());
+		m_buf.insert(m_buf.end(), str.begin(), str.end());
+	}
+
+private:
+	vector<deUint8>&	m_buf;
+};
+
+class SidecarReader
+{
+public:
+	SidecarReader (const vector<deUint8>& buf) : m_buf(buf), m_pos(0) {}
+
+	bool	isEnd		(void) const	{ return m_pos == m_buf.size();	}
+
+	deUint32 getU32 (void)
+	{
+		deUint32 value = 0;
+
+		if (m_buf.size() - m_pos < 4)
+			throw ParseError("Truncated index");
+
+		for (int ndx = 0; ndx < 4; ndx++)
+			value |= (deUint32)m_buf[m_pos++] << (ndx*8);
+
+		return value;
+	}
+
+	deUint64 getU64 (void)
+	{
+		const deUint64 lo = getU32();
+		const deUint64 hi = getU32();
+		return lo | (hi << 32);
+	}
+
+	void getString (string& dst)
+	{
+		const deUint32 len = getU32();
+
+		if (m_buf.size() - m_pos < len)
+			throw ParseError("Truncated index");
+
+		dst.assign((const char*)&m_buf[0] + m_pos, len);
+		m_pos += len;
+	}
+
+private:
+	const vector<deUint8>&	m_buf;
+	size_t					m_pos;
+};
+
+string* getSessionInfoField (SessionInfo& info, int ndx)
+{
+	switch (ndx)
+	{
+		case 0:	return &info.releaseName;
+		case 1:	return &info.releaseId;
+		case 2:	return &info.targetName;
+		case 3:	return &info.candyTargetName;
+		case 4:	return &info.configName;
+		case 5:	return &info.resultName;
+		case 6:	return &info.timestamp;
+		default:
+			return DE_NULL;
+	}
+}
+
+} // anonymous
+
+TestLogIndex::TestLogIndex (const char* filename, IndexMode mode)
+	: m_mapping	(DE_NULL)
+	, m_data	(DE_NULL)
+	, m_size	(0)
+{
+	{
+		deFile* file = deFile_create(filename, DE_FILEMODE_OPEN|DE_FILEMODE_READ);
+
+		if (!file)
+			throw Error(string("Failed to open '") + filename + "'");
+
+		m_mapping = deFileMapping_create(file);
+		deFile_destroy(file);
+
+		if (!m_mapping)
+			throw Error(string("Failed to map '") + filename + "'");
+
+		m_data	= (const deUint8*)deFileMapping_getData(m_mapping);
+		m_size	= (deUint64)deFileMapping_getSize(m_mapping);
+	}
+
+	try
+	{
+		if (mode == INDEXMODE_SIDECAR)
+		{
+			const string indexFilename = getSidecarFilename(filename);
+
+			if (!readSidecar(indexFilename.c_str()))
+			{
+				build();
+				writeSidecar(indexFilename.c_str());
+			}
+		}
+		else
+			build();
+
+		buildCaseMap();
+	}
+	catch (...)
+	{
+		deFileMapping_destroy(m_mapping);
+		throw;
+	}
+}
+
+TestLogIndex::~TestLogIndex (void)
+{
+	deFileMapping_destroy(m_mapping);
+}
+
+string TestLogIndex::getSidecarFilename (const char* filename)
+{
+	return string(filename) + s_sidecarSuffix;
+}
+
+int TestLogIndex::findCase (const char* casePath) const
+{
+	const map<string, int>::const_iterator pos = m_caseMap.find(casePath);
+	return pos != m_caseMap.end() ? pos->second : -1;
+}
+
+const deUint8* TestLogIndex::getCaseData (int caseNdx) const
+{
+	return m_data + (size_t)m_cases[caseNdx].dataOffset;
+}
+
+TestCaseResultPtr TestLogIndex::getCaseResultData (int caseNdx) const
+{
+	const CaseEntry&	entry	= m_cases[caseNdx];
+	TestCaseResultPtr	data	(new TestCaseResultData(entry.casePath.c_str()));
+
+	// Status as reported by TestLogParser: only termination sets status, the rest is parsed from data.
+	data->setTestResult(entry.terminated ? entry.statusCode : TESTSTATUSCODE_LAST, entry.statusDetails.c_str());
+	data->setDataSize(entry.dataSize);
+
+	if (entry.dataSize > 0)
+		deMemcpy(data->getData(), getCaseData(caseNdx), entry.dataSize);
+
+	return data;
+}
+
+void TestLogIndex::parseCaseResult (int caseNdx, TestResultParser& parser, TestCaseResult& dst) const
+{
+	const CaseEntry& entry = m_cases[caseNdx];
+
+	parseTestCaseResultFromData(&parser, &dst, entry.casePath.c_str(),
+								entry.terminated ? entry.statusCode : TESTSTATUSCODE_LAST, entry.statusDetails.c_str(),
+								getCaseData(caseNdx), entry.dataSize);
+}
+
+deUint32 TestLogIndex::computeFingerprint (void) const
+{
+	const int	headSize	= (int)de::min<deUint64>(m_size, FINGERPRINT_BLOCK_SIZE);
+	const int	tailSize	= (int)de::min<deUint64>(m_size-headSize, FINGERPRINT_BLOCK_SIZE);
+	deUint32	hash		= deMemoryHash(m_data, headSize);
+
+	if (tailSize > 0)
+		hash = hash*31 + deMemoryHash(m_data + (size_t)(m_size-tailSize), tailSize);
+
+	return hash;
+}
+
+void TestLogIndex::build (void)
+{
+	ContainerFormatParser	lineParser;
+	CaseEntry				curCase;
+	bool					inCase		= false;
+	bool					inSession	= false;
+	deUint64				pos			= 0;
+
+	m_sessionInfo = SessionInfo();
+	m_cases.clear();
+
+	while (pos < m_size)
+	{
+		// \note Only lines starting with '#' can be container lines. Data lines are skipped over.
+		const deUint64	lineStart	= pos;
+		const deUint8*	lineEndPtr	= (const deUint8*)memchr(m_data + (size_t)lineStart, '\n', (size_t)(m_size-lineStart));
+
+		if (!lineEndPtr)
+			break; // Container line is not complete until newline, and data is only attached to complete cases.
+
+		pos = (deUint64)(lineEndPtr - m_data) + 1;
+
+		if (m_data[(size_t)lineStart] != '#')
+			continue;
+
+		lineParser.clear();
+		lineParser.feed(m_data + (size_t)lineStart, (int)(pos-lineStart));
+
+		for (;;)
+		{
+			const ContainerElement element = lineParser.getElement();
+
+			if (element == CONTAINERELEMENT_INCOMPLETE)
+				break;
+
+			switch (element)
+			{
+				case CONTAINERELEMENT_BEGIN_SESSION:
+					if (inSession)
+						throw Error("Unexpected #beginSession");
+					inSession = true;
+					break;
+
+				case CONTAINERELEMENT_END_SESSION:
+					if (!inSession)
+						throw Error("Unexpected #endSession");
+					inSession = false;
+					break;
+
+				case CONTAINERELEMENT_SESSION_INFO:
+				{
+					if (inSession)
+						throw Error("Unexpected #sessionInfo");
+
+					const char*		attribute	= lineParser.getSessionInfoAttribute();
+					const char*		value		= lineParser.getSessionInfoValue();
+
+					if (deStringEqual(attribute, "releaseName"))
+						m_sessionInfo.releaseName = value;
+					else if (deStringEqual(attribute, "releaseId"))
+						m_sessionInfo.releaseId = value;
+					else if (deStringEqual(attribute, "targetName"))
+						m_sessionInfo.targetName = value;
+					else if (deStringEqual(attribute, "candyTargetName"))
+						m_sessionInfo.candyTargetName = value;
+					else if (deStringEqual(attribute, "configName"))
+						m_sessionInfo.configName = value;
+					else if (deStringEqual(attribute, "resultName"))
+						m_sessionInfo.resultName = value;
+					else if (deStringEqual(attribute, "timestamp"))
+						m_sessionInfo.timestamp = value;
+					break;
+				}
+
+				case CONTAINERELEMENT_BEGIN_TEST_CASE_RESULT:
+					if (!inSession)
+						throw Error("Unexpected #beginTestCaseResult");
+
+					// Previous unfinished case, if any, is discarded.
+					curCase				= CaseEntry();
+					curCase.casePath	= lineParser.getTestCasePath();
+					curCase.dataOffset	= pos;
+					inCase				= true;
+					break;
+
+				case CONTAINERELEMENT_END_TEST_CASE_RESULT:
+				case CONTAINERELEMENT_TERMINATE_TEST_CASE_RESULT:
+					if (inCase)
+					{
+						const deUint64 dataSize = lineStart - curCase.dataOffset;
+
+						if (dataSize > (deUint64)0x7fffffff)
+							throw Error("Too large test case result '" + curCase.casePath + "'");
+
+						curCase.dataSize = (int)dataSize;
+
+						if (element == CONTAINERELEMENT_TERMINATE_TEST_CASE_RESULT)
+						{
+							const char* reason = lineParser.getTerminateReason();
+
+							curCase.terminated		= true;
+							curCase.statusCode		= TESTSTATUSCODE_CRASH;
+							curCase.statusDetails	= reason;
+
+							try
+							{
+								curCase.statusCode = getTestStatusCode(reason);
+							}
+							catch (const ParseError&)
+							{
+								// Could not map status code.
+							}
+						}
+						else
+							curCase.statusCode = findResultStatusCode(m_data + (size_t)curCase.dataOffset, curCase.dataSize);
+
+						m_cases.push_back(curCase);
+					}
+					inCase = false;
+					break;
+
+				default:
+					// Data lines starting with '#'.
+					break;
+			}
+
+			lineParser.advance();
+		}
+	}
+}
+
+bool TestLogIndex::readSidecar (const char* indexFilename)
+{
+	vector<deUint8> buf;
+
+	{
+		std::ifstream in(indexFilename, std::ios_base::binary);
+
+		if (!in.good())
+			return false;
+
+		in.seekg(0, std::ios_base::end);
+		const std::streamoff size = in.tellg();
+		in.seekg(0, std::ios_base::beg);
+
+		if (size <= 0)
+			return false;
+
+		buf.resize((size_t)size);
+		in.read((char*)&buf[0], (std::streamsize)size);
+
+		if (in.gcount() != size)
+			return false;
+	}
+
+	try
+	{
+		SidecarReader	reader	(buf);
+		string			magic;
+		SessionInfo		sessionInfo;
+
+		reader.getString(magic);
+
+		if (magic != s_sidecarMagic ||
+			reader.getU32() != SIDECAR_VERSION ||
+			reader.getU64() != m_size ||
+			reader.getU32() != computeFingerprint())
+			return false;
+
+		for (int ndx = 0; getSessionInfoField(sessionInfo, ndx); ndx++)
+			reader.getString(*getSessionInfoField(sessionInfo, ndx));
+
+		const deUint32		numCases	= reader.getU32();
+		vector<CaseEntry>	cases		(numCases);
+
+		for (deUint32 caseNdx = 0; caseNdx < numCases; caseNdx++)
+		{
+			CaseEntry& entry = cases[caseNdx];
+
+			entry.dataOffset	= reader.getU64();
+			entry.dataSize		= (int)reader.getU32();
+			entry.terminated	= reader.getU32() != 0;
+			entry.statusCode	= (TestStatusCode)reader.getU32();
+			reader.getString(entry.casePath);
+			reader.getString(entry.statusDetails);
+
+			if (entry.dataSize < 0 || entry.dataOffset > m_size || m_size - entry.dataOffset < (deUint64)entry.dataSize ||
+				!de::inRange<int>(entry.statusCode, 0, TESTSTATUSCODE_LAST))
+				return false;
+		}
+
+		if (!reader.isEnd())
+			return false;
+
+		m_sessionInfo	= sessionInfo;
+		m_cases.swap(cases);
+
+		return true;
+	}
+	catch (const ParseError&)
+	{
+		return false;
+	}
+}
+
+void TestLogIndex::writeSidecar (const char* indexFilename) const
+{
+	vector<deUint8>	buf;
+	SidecarWriter	writer	(buf);
+	SessionInfo		sessionInfo	= m_sessionInfo;
+
+	writer.putString(s_sidecarMagic);
+	writer.putU32(SIDECAR_VERSION);
+	writer.putU64(m_size);
+	writer.putU32(computeFingerprint());
+
+	for (int ndx = 0; getSessionInfoField(sessionInfo, ndx); ndx++)
+		writer.putString(*getSessionInfoField(sessionInfo, ndx));
+
+	writer.putU32((deUint32)m_cases.size());
+
+	for (vector<CaseEntry>::const_iterator entry = m_cases.begin(); entry != m_cases.end(); ++entry)
+	{
+		writer.putU64(entry->dataOffset);
+		writer.putU32((deUint32)entry->dataSize);
+		writer.putU32(entry->terminated ? 1u : 0u);
+		writer.putU32((deUint32)entry->statusCode);
+		writer.putString(entry->casePath);
+		writer.putString(entry->statusDetails);
+	}
+
+	// \note Index is only a cache, so failing to write it (read-only directory etc.) is not an error.
+	std::ofstream out(indexFilename, std::ios_base::binary);
+
+	if (out.good())
+		out.write((const char*)&buf[0], (std::streamsize)buf.size());
+}
+
+void TestLogIndex::buildCaseMap (void)
+{
+	m_caseMap.clear();
+
+	// \note Later results override earlier ones with same path, like when results are read into BatchResult.
+	for (int caseNdx = 0; caseNdx < (int)m_cases.size(); caseNdx++)
+		m_caseMap[m_cases[caseNdx].casePath] = caseNdx;
+}
+
+} // xe
@@ -0,0 +1,115 @@
+#ifndef _XETESTLOGINDEX_HPP
+#define _XETESTLOGINDEX_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Test Executor
+ * ------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Indexed random access reader for test log files.
+ *//*--------------------------------------------------------------------*/
+
+#include "xeDefs.hpp"
+#include "xeTestCaseResult.hpp"
+#include "xeBatchResult.hpp"
+#include "deFile.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace xe
+{
+
+class TestResultParser;
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Memory-mapped test log with an index of test case results
+ *
+ * TestLogIndex maps the whole log file into memory and records the
+ * location of each complete test case result (#beginTestCaseResult ..
+ * #endTestCaseResult or #terminateTestCaseResult). Case data can then be
+ * accessed in any order without parsing the rest of the log, and
+ * different cases can be parsed concurrently from multiple threads.
+ *
+ * Cases are reported the same way TestLogParser reports them: results
+ * that are not complete at the end of the log are not indexed.
+ *
+ * In INDEXMODE_SIDECAR the index is loaded from <log>.index if it matches
+ * the log file, and otherwise built and written there for later use.
+ * Failure to write the sidecar file is not an error.
+ *//*--------------------------------------------------------------------*/
+class TestLogIndex
+{
+public:
+	enum IndexMode
+	{
+		INDEXMODE_BUILD = 0,	//!< Always build index by scanning the log.
+		INDEXMODE_SIDECAR,		//!< Load index from sidecar file if up to date, otherwise build and write it.
+
+		INDEXMODE_LAST
+	};
+
+	struct CaseEntry
+	{
+		std::string			casePath;
+		deUint64			dataOffset;		//!< Offset of test log data in file.
+		int					dataSize;		//!< Size of test log data in bytes.
+		bool				terminated;		//!< Result was terminated with #terminateTestCaseResult.
+		TestStatusCode		statusCode;		//!< Status code from termination or <Result> element, TESTSTATUSCODE_LAST if not known.
+		std::string			statusDetails;	//!< Termination reason.
+
+		CaseEntry (void) : dataOffset(0), dataSize(0), terminated(false), statusCode(TESTSTATUSCODE_LAST) {}
+	};
+
+							TestLogIndex		(const char* filename, IndexMode mode = INDEXMODE_BUILD);
+							~TestLogIndex		(void);
+
+	const SessionInfo&		getSessionInfo		(void) const	{ return m_sessionInfo;					}
+
+	int						getNumCases			(void) const	{ return (int)m_cases.size();			}
+	const CaseEntry&		getCase				(int caseNdx) const	{ return m_cases[caseNdx];		}
+	int						findCase			(const char* casePath) const;
+
+	const deUint8*			getCaseData			(int caseNdx) const;
+	TestCaseResultPtr		getCaseResultData	(int caseNdx) const;
+	void					parseCaseResult		(int caseNdx, TestResultParser& parser, TestCaseResult& dst) const;
+
+	static std::string		getSidecarFilename	(const char* filename);
+
+private:
+							TestLogIndex		(const TestLogIndex& other);
+	TestLogIndex&			operator=			(const TestLogIndex& other);
+
+	deUint32				computeFingerprint	(void) const;
+	void					build				(void);
+	bool					readSidecar			(const char* indexFilename);
+	void					writeSidecar		(const char* indexFilename) const;
+	void					buildCaseMap		(void);
+
+	deFileMapping*				m_mapping;
+	const deUint8*				m_data;
+	deUint64					m_size;
+
+	SessionInfo					m_sessionInfo;
+	std::vector<CaseEntry>		m_cases;
+	std::map<std::string, int>	m_caseMap;
+};
+
+} // xe
+
+#endif // _XETESTLOGINDEX_HPP
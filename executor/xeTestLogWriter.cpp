@@ -270,7 +270,7 @@ static void writeResultItem (const ri::Item& item, xml::Writer& dst)
 				<< Writer::Attribute("Height",			de::toString(image.height))
 				<< Writer::Attribute("Format",			getImageFormatName(image.format))
 				<< Writer::Attribute("CompressionMode",	getImageCompressionName(image.compression))
-				<< toBase64(&image.data[0], (int)image.data.size())
+				<< toBase64(image.data.getPtr(), image.data.size())
 				<< Writer::EndElement;
 			break;
 		}
@@ -432,8 +432,13 @@ static void writeResultItem (const ri::Item& item, xml::Writer& dst)
 
 			writeResultItem(list.sampleInfo, dst);
 
-			for (int ndx = 0; ndx < list.samples.getNumItems(); ndx++)
-				writeResultItem(list.samples.getItem(ndx), dst);
+			for (int sampleNdx = 0; sampleNdx < list.getNumSamples(); sampleNdx++)
+			{
+				dst << Writer::BeginElement("Sample");
+				for (int valueNdx = 0; valueNdx < list.getNumValues(sampleNdx); valueNdx++)
+					dst << Writer::BeginElement("Value") << list.getValue(sampleNdx, valueNdx) << Writer::EndElement;
+				dst << Writer::EndElement;
+			}
 
 			dst << Writer::EndElement;
 			break;
@@ -462,25 +467,6 @@ static void writeResultItem (const ri::Item& item, xml::Writer& dst)
 			break;
 		}
 
-		case ri::TYPE_SAMPLE:
-		{
-			const ri::Sample& sample = static_cast<const ri::Sample&>(item);
-			dst << Writer::BeginElement("Sample");
-			for (int ndx = 0; ndx < sample.values.getNumItems(); ndx++)
-				writeResultItem(sample.values.getItem(ndx), dst);
-			dst << Writer::EndElement;
-			break;
-		}
-
-		case ri::TYPE_SAMPLEVALUE:
-		{
-			const ri::SampleValue& value = static_cast<const ri::SampleValue&>(item);
-			dst << Writer::BeginElement("Value")
-				<< value.value
-				<< Writer::EndElement;
-			break;
-		}
-
 		default:
 			XE_FAIL("Unsupported result item");
 	}
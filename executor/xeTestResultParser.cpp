@@ -290,6 +290,7 @@ TestResultParser::TestResultParser (void)
 	, m_logVersion			(TESTLOGVERSION_LAST)
 	, m_curItemList			(DE_NULL)
 	, m_base64DecodeOffset	(0)
+	, m_curImageSource		(DE_NULL)
 {
 }
 
@@ -307,7 +308,11 @@ void TestResultParser::clear (void)
 	m_logVersion			= TESTLOGVERSION_LAST;
 	m_curItemList			= DE_NULL;
 	m_base64DecodeOffset	= 0;
-	m_curNumValue.clear();
+	m_curItemData.clear();
+	m_curImageData.clear();
+	m_curImageHash.clear();
+	m_curImageSource		= DE_NULL;
+	m_imagesByHash.clear();
 }
 
 void TestResultParser::init (TestCaseResult* dstResult)
@@ -350,6 +355,10 @@ TestResultParser::ParseResult TestResultParser::parse (const deUint8* bytes, int
 			m_xmlParser.advance();
 		}
 
+		// Make data received so far visible in current item.
+		if (resultChanged && getCurrentItem())
+			storeItemData(getCurrentItem());
+
 		if (m_xmlParser.getElement() == xml::ELEMENT_END_OF_STRING)
 		{
 			if (m_state != STATE_TEST_CASE_RESULT_ENDED)
@@ -467,6 +476,7 @@ void TestResultParser::handleElementStart (void)
 	}
 	else
 	{
+		ri::Arena&	arena		= m_result->arena;
 		ri::List*	curList		= getCurrentItemList();
 		ri::Type	itemType	= getResultItemType(elemName);
 		ri::Item*	item		= DE_NULL;
@@ -477,66 +487,78 @@ void TestResultParser::handleElementStart (void)
 		{
 			case ri::TYPE_RESULT:
 			{
-				ri::Result* result = curList->allocItem<ri::Result>();
+				ri::Result* result = curList->allocItem<ri::Result>(arena);
 				result->statusCode = getTestStatusCode(getAttribute("StatusCode"));
 				item = result;
 				break;
 			}
 
 			case ri::TYPE_TEXT:
-				item = curList->allocItem<ri::Text>();
+				item = curList->allocItem<ri::Text>(arena);
 				break;
 
 			case ri::TYPE_SECTION:
 			{
-				ri::Section* section = curList->allocItem<ri::Section>();
-				section->name			= getAttribute("Name");
-				section->description	= getAttribute("Description");
+				ri::Section* section = curList->allocItem<ri::Section>(arena);
+				section->name			= arena.internString(getAttribute("Name"));
+				section->description	= arena.internString(getAttribute("Description"));
 				item = section;
 				break;
 			}
 
 			case ri::TYPE_NUMBER:
 			{
-				ri::Number* number = curList->allocItem<ri::Number>();
-				number->name		= getAttribute("Name");
-				number->description	= getAttribute("Description");
-				number->unit		= getAttribute("Unit");
+				ri::Number* number = curList->allocItem<ri::Number>(arena);
+				number->name		= arena.internString(getAttribute("Name"));
+				number->description	= arena.internString(getAttribute("Description"));
+				number->unit		= arena.internString(getAttribute("Unit"));
 
 				if (m_xmlParser.hasAttribute("Tag"))
-					number->tag = m_xmlParser.getAttribute("Tag");
+					number->tag = arena.internString(m_xmlParser.getAttribute("Tag"));
 
 				item = number;
-
-				m_curNumValue.clear();
 				break;
 			}
 
 			case ri::TYPE_IMAGESET:
 			{
-				ri::ImageSet* imageSet = curList->allocItem<ri::ImageSet>();
-				imageSet->name			= getAttribute("Name");
-				imageSet->description	= getAttribute("Description");
+				ri::ImageSet* imageSet = curList->allocItem<ri::ImageSet>(arena);
+				imageSet->name			= arena.internString(getAttribute("Name"));
+				imageSet->description	= arena.internString(getAttribute("Description"));
 				item = imageSet;
 				break;
 			}
 
 			case ri::TYPE_IMAGE:
 			{
-				ri::Image* image = curList->allocItem<ri::Image>();
-				image->name			= getAttribute("Name");
-				image->description	= getAttribute("Description");
+				ri::Image* image = curList->allocItem<ri::Image>(arena);
+				image->name			= arena.internString(getAttribute("Name"));
+				image->description	= arena.internString(getAttribute("Description"));
 				image->width		= toInt(getAttribute("Width"));
 				image->height		= toInt(getAttribute("Height"));
 				image->format		= getImageFormat(getAttribute("Format"));
 				image->compression	= getImageCompression(getAttribute("CompressionMode"));
 				item = image;
+
+				m_curImageHash		= m_xmlParser.hasAttribute("ContentHash") ? m_xmlParser.getAttribute("ContentHash") : "";
+				m_curImageSource	= DE_NULL;
+
+				// Image data is written only once per case, repeated images refer to it.
+				if (m_xmlParser.hasAttribute("DuplicateOf"))
+				{
+					const std::map<string, const ri::Image*>::const_iterator source = m_imagesByHash.find(m_xmlParser.getAttribute("DuplicateOf"));
+
+					if (source == m_imagesByHash.end())
+						throw TestResultParseError(string("<Image> refers to unknown image '") + m_xmlParser.getAttribute("DuplicateOf") + "'");
+
+					m_curImageSource = source->second;
+				}
 				break;
 			}
 
 			case ri::TYPE_SHADERPROGRAM:
 			{
-				ri::ShaderProgram* shaderProgram = curList->allocItem<ri::ShaderProgram>();
+				ri::ShaderProgram* shaderProgram = curList->allocItem<ri::ShaderProgram>(arena);
 				shaderProgram->linkStatus = toBool(getAttribute("LinkStatus"));
 				item = shaderProgram;
 				break;
@@ -547,7 +569,7 @@ void TestResultParser::handleElementStart (void)
 				if (parentType != ri::TYPE_SHADERPROGRAM)
 					throw TestResultParseError("<VertexShader> outside of <ShaderProgram>");
 
-				ri::Shader* shader = curList->allocItem<ri::Shader>();
+				ri::Shader* shader = curList->allocItem<ri::Shader>(arena);
 
 				shader->shaderType		= getShaderTypeFromTagName(elemName);
 				shader->compileStatus	= toBool(getAttribute("CompileStatus"));
@@ -575,14 +597,14 @@ void TestResultParser::handleElementStart (void)
 				break;
 
 			case ri::TYPE_KERNELSOURCE:
-				item = curList->allocItem<ri::KernelSource>();
+				item = curList->allocItem<ri::KernelSource>(arena);
 				break;
 
 			case ri::TYPE_COMPILEINFO:
 			{
-				ri::CompileInfo* info = curList->allocItem<ri::CompileInfo>();
-				info->name			= getAttribute("Name");
-				info->description	= getAttribute("Description");
+				ri::CompileInfo* info = curList->allocItem<ri::CompileInfo>(arena);
+				info->name			= arena.internString(getAttribute("Name"));
+				info->description	= arena.internString(getAttribute("Description"));
 				info->compileStatus	= toBool(getAttribute("CompileStatus"));
 				item = info;
 				break;
@@ -590,16 +612,16 @@ void TestResultParser::handleElementStart (void)
 
 			case ri::TYPE_EGLCONFIGSET:
 			{
-				ri::EglConfigSet* set = curList->allocItem<ri::EglConfigSet>();
-				set->name			= getAttribute("Name");
-				set->description	= m_xmlParser.hasAttribute("Description") ? m_xmlParser.getAttribute("Description") : "";
+				ri::EglConfigSet* set = curList->allocItem<ri::EglConfigSet>(arena);
+				set->name			= arena.internString(getAttribute("Name"));
+				set->description	= arena.internString(m_xmlParser.hasAttribute("Description") ? m_xmlParser.getAttribute("Description") : "");
 				item = set;
 				break;
 			}
 
 			case ri::TYPE_EGLCONFIG:
 			{
-				ri::EglConfig* config = curList->allocItem<ri::EglConfig>();
+				ri::EglConfig* config = curList->allocItem<ri::EglConfig>(arena);
 				config->bufferSize				= toInt(getAttribute("BufferSize"));
 				config->redSize					= toInt(getAttribute("RedSize"));
 				config->greenSize				= toInt(getAttribute("GreenSize"));
@@ -609,10 +631,10 @@ void TestResultParser::handleElementStart (void)
 				config->alphaMaskSize			= toInt(getAttribute("AlphaMaskSize"));
 				config->bindToTextureRGB		= toBool(getAttribute("BindToTextureRGB"));
 				config->bindToTextureRGBA		= toBool(getAttribute("BindToTextureRGBA"));
-				config->colorBufferType			= getAttribute("ColorBufferType");
-				config->configCaveat			= getAttribute("ConfigCaveat");
+				config->colorBufferType			= arena.internString(getAttribute("ColorBufferType"));
+				config->configCaveat			= arena.internString(getAttribute("ConfigCaveat"));
 				config->configID				= toInt(getAttribute("ConfigID"));
-				config->conformant				= getAttribute("Conformant");
+				config->conformant				= arena.internString(getAttribute("Conformant"));
 				config->depthSize				= toInt(getAttribute("DepthSize"));
 				config->level					= toInt(getAttribute("Level"));
 				config->maxPBufferWidth			= toInt(getAttribute("MaxPBufferWidth"));
@@ -621,12 +643,12 @@ void TestResultParser::handleElementStart (void)
 				config->maxSwapInterval			= toInt(getAttribute("MaxSwapInterval"));
 				config->minSwapInterval			= toInt(getAttribute("MinSwapInterval"));
 				config->nativeRenderable		= toBool(getAttribute("NativeRenderable"));
-				config->renderableType			= getAttribute("RenderableType");
+				config->renderableType			= arena.internString(getAttribute("RenderableType"));
 				config->sampleBuffers			= toInt(getAttribute("SampleBuffers"));
 				config->samples					= toInt(getAttribute("Samples"));
 				config->stencilSize				= toInt(getAttribute("StencilSize"));
-				config->surfaceTypes			= getAttribute("SurfaceTypes");
-				config->transparentType			= getAttribute("TransparentType");
+				config->surfaceTypes			= arena.internString(getAttribute("SurfaceTypes"));
+				config->transparentType			= arena.internString(getAttribute("TransparentType"));
 				config->transparentRedValue		= toInt(getAttribute("TransparentRedValue"));
 				config->transparentGreenValue	= toInt(getAttribute("TransparentGreenValue"));
 				config->transparentBlueValue	= toInt(getAttribute("TransparentBlueValue"));
@@ -636,9 +658,9 @@ void TestResultParser::handleElementStart (void)
 
 			case ri::TYPE_SAMPLELIST:
 			{
-				ri::SampleList* list = curList->allocItem<ri::SampleList>();
-				list->name			= getAttribute("Name");
-				list->description	= getAttribute("Description");
+				ri::SampleList* list = curList->allocItem<ri::SampleList>(arena);
+				list->name			= arena.internString(getAttribute("Name"));
+				list->description	= arena.internString(getAttribute("Description"));
 				item = list;
 				break;
 			}
@@ -661,14 +683,14 @@ void TestResultParser::handleElementStart (void)
 					throw TestResultParseError("<ValueInfo> outside of <SampleInfo>");
 
 				ri::SampleInfo*	sampleInfo	= static_cast<ri::SampleInfo*>(parentItem);
-				ri::ValueInfo*	valueInfo	= sampleInfo->valueInfos.allocItem<ri::ValueInfo>();
+				ri::ValueInfo*	valueInfo	= sampleInfo->valueInfos.allocItem<ri::ValueInfo>(arena);
 
-				valueInfo->name			= getAttribute("Name");
-				valueInfo->description	= getAttribute("Description");
+				valueInfo->name			= arena.internString(getAttribute("Name"));
+				valueInfo->description	= arena.internString(getAttribute("Description"));
 				valueInfo->tag			= getSampleValueTag(getAttribute("Tag"));
 
 				if (m_xmlParser.hasAttribute("Unit"))
-					valueInfo->unit = getAttribute("Unit");
+					valueInfo->unit = arena.internString(getAttribute("Unit"));
 
 				item = valueInfo;
 				break;
@@ -679,10 +701,9 @@ void TestResultParser::handleElementStart (void)
 				if (parentType != ri::TYPE_SAMPLELIST)
 					throw TestResultParseError("<Sample> outside of <SampleList>");
 
-				ri::SampleList*	list	= static_cast<ri::SampleList*>(parentItem);
-				ri::Sample*		sample	= list->samples.allocItem<ri::Sample>();
+				static_cast<ri::SampleList*>(parentItem)->addSample(arena);
 
-				item = sample;
+				item = &m_sampleItem;
 				break;
 			}
 
@@ -691,10 +712,7 @@ void TestResultParser::handleElementStart (void)
 				if (parentType != ri::TYPE_SAMPLE)
 					throw TestResultParseError("<Value> outside of <Sample>");
 
-				ri::Sample*			sample	= static_cast<ri::Sample*>(parentItem);
-				ri::SampleValue*	value	= sample->values.allocItem<ri::SampleValue>();
-
-				item = value;
+				item = &m_sampleValueItem;
 				break;
 			}
 
@@ -705,7 +723,9 @@ void TestResultParser::handleElementStart (void)
 		DE_ASSERT(item);
 		pushItem(item);
 
-		// Reset base64 decoding offset.
+		// Reset item data and base64 decoding offset.
+		m_curItemData.clear();
+		m_curImageData.clear();
 		m_base64DecodeOffset = 0;
 	}
 }
@@ -733,6 +753,8 @@ void TestResultParser::handleElementEnd (void)
 		if (!curItem || itemType != curItem->getType())
 			throw TestResultParseError(string("Unexpected </") + elemName + ">");
 
+		storeItemData(curItem);
+
 		if (itemType == ri::TYPE_RESULT)
 		{
 			ri::Result* result = static_cast<ri::Result*>(curItem);
@@ -743,16 +765,27 @@ void TestResultParser::handleElementEnd (void)
 		{
 			// Parse value for number.
 			ri::Number*	number	= static_cast<ri::Number*>(curItem);
-			number->value = getNumericValue(m_curNumValue);
-			m_curNumValue.clear();
+			number->value = getNumericValue(m_curItemData);
+		}
+		else if (itemType == ri::TYPE_IMAGE)
+		{
+			if (!m_curImageHash.empty())
+				m_imagesByHash[m_curImageHash] = static_cast<const ri::Image*>(curItem);
+
+			m_curImageHash.clear();
+			m_curImageSource = DE_NULL;
 		}
 		else if (itemType == ri::TYPE_SAMPLEVALUE)
 		{
-			ri::SampleValue* value = static_cast<ri::SampleValue*>(curItem);
-			value->value = getNumericValue(m_curNumValue);
-			m_curNumValue.clear();
+			// <Value> is always inside <Sample> inside <SampleList>.
+			DE_ASSERT(m_itemStack.size() >= 3 && m_itemStack[m_itemStack.size()-3]->getType() == ri::TYPE_SAMPLELIST);
+			ri::SampleList* list = static_cast<ri::SampleList*>(m_itemStack[m_itemStack.size()-3]);
+			list->addValue(m_result->arena, getNumericValue(m_curItemData));
 		}
 
+		m_curItemData.clear();
+		m_curImageData.clear();
+
 		popItem();
 	}
 }
@@ -765,40 +798,27 @@ void TestResultParser::handleData (void)
 	switch (type)
 	{
 		case ri::TYPE_RESULT:
-			m_xmlParser.appendDataStr(static_cast<ri::Result*>(curItem)->details);
-			break;
-
 		case ri::TYPE_TEXT:
-			m_xmlParser.appendDataStr(static_cast<ri::Text*>(curItem)->text);
-			break;
-
 		case ri::TYPE_SHADERSOURCE:
-			m_xmlParser.appendDataStr(static_cast<ri::ShaderSource*>(curItem)->source);
-			break;
-
 		case ri::TYPE_INFOLOG:
-			m_xmlParser.appendDataStr(static_cast<ri::InfoLog*>(curItem)->log);
-			break;
-
 		case ri::TYPE_KERNELSOURCE:
-			m_xmlParser.appendDataStr(static_cast<ri::KernelSource*>(curItem)->source);
-			break;
-
 		case ri::TYPE_NUMBER:
 		case ri::TYPE_SAMPLEVALUE:
-			m_xmlParser.appendDataStr(m_curNumValue);
+			// Stored to item in storeItemData().
+			m_xmlParser.appendDataStr(m_curItemData);
 			break;
 
 		case ri::TYPE_IMAGE:
 		{
-			ri::Image* image = static_cast<ri::Image*>(curItem);
+			std::vector<deUint8>& imageData = m_curImageData;
 
 			// Base64 decode.
-			int numBytesIn = m_xmlParser.getDataSize();
+			const int		numBytesIn	= m_xmlParser.getDataSize();
+			const deUint8*	dataIn		= m_xmlParser.getDataPtr();
 
 			for (int inNdx = 0; inNdx < numBytesIn; inNdx++)
 			{
-				deUint8		byte		= m_xmlParser.getDataByte(inNdx);
+				deUint8		byte		= dataIn[inNdx];
 				deUint8		decodedBits	= 0;
 
 				if (de::inRange<deInt8>(byte, 'A', 'Z'))
@@ -814,9 +834,9 @@ void TestResultParser::handleData (void)
 				else if (byte == '=')
 				{
 					// Padding at end - remove last byte.
-					if (image->data.empty())
+					if (imageData.empty())
 						throw TestResultParseError("Malformed base64 data");
-					image->data.pop_back();
+					imageData.pop_back();
 					continue;
 				}
 				else
@@ -825,11 +845,11 @@ void TestResultParser::handleData (void)
 				int phase = m_base64DecodeOffset % 4;
 
 				if (phase == 0)
-					image->data.resize(image->data.size()+3, 0);
+					imageData.resize(imageData.size()+3, 0);
 
-				if ((int)image->data.size() < (m_base64DecodeOffset>>2)*3 + 3)
+				if ((int)imageData.size() < (m_base64DecodeOffset>>2)*3 + 3)
 					throw TestResultParseError("Malformed base64 data");
-				deUint8* outPtr = &image->data[(m_base64DecodeOffset>>2)*3];
+				deUint8* outPtr = &imageData[(m_base64DecodeOffset>>2)*3];
 
 				switch (phase)
 				{
@@ -853,22 +873,63 @@ void TestResultParser::handleData (void)
 	}
 }
 
+void TestResultParser::storeItemData (ri::Item* item)
+{
+	ri::Arena& arena = m_result->arena;
+
+	switch (item->getType())
+	{
+		case ri::TYPE_RESULT:		static_cast<ri::Result*>(item)->details			= arena.copyString(m_curItemData);	break;
+		case ri::TYPE_TEXT:			static_cast<ri::Text*>(item)->text				= arena.copyString(m_curItemData);	break;
+		case ri::TYPE_SHADERSOURCE:	static_cast<ri::ShaderSource*>(item)->source	= arena.copyString(m_curItemData);	break;
+		case ri::TYPE_INFOLOG:		static_cast<ri::InfoLog*>(item)->log			= arena.copyString(m_curItemData);	break;
+		case ri::TYPE_KERNELSOURCE:	static_cast<ri::KernelSource*>(item)->source	= arena.copyString(m_curItemData);	break;
+
+		case ri::TYPE_IMAGE:
+		{
+			ri::Image* image = static_cast<ri::Image*>(item);
+
+			// \note Data stored earlier for incomplete image is left unused in arena.
+			image->data = ri::ArenaArray<deUint8>();
+
+			if (m_curImageSource && !m_curImageSource->data.empty())
+				image->data.append(arena, m_curImageSource->data.getPtr(), m_curImageSource->data.size());
+			else if (!m_curImageData.empty())
+				image->data.append(arena, &m_curImageData[0], (int)m_curImageData.size());
+
+			break;
+		}
+
+		default:
+			// No data or value is parsed at element end.
+			break;
+	}
+}
+
 //! Helper for parsing TestCaseResult from TestCaseResultData.
-void parseTestCaseResultFromData (TestResultParser* parser, TestCaseResult* result, const TestCaseResultData& data)
+TestResultParser::ParseResult parseTestCaseResultFromData (TestResultParser* parser, TestCaseResult* result, const TestCaseResultData& data)
 {
+	return parseTestCaseResultFromData(parser, result, data.getTestCasePath(), data.getStatusCode(), data.getStatusDetails(), data.getData(), data.getDataSize());
+}
+
+//! Helper for parsing TestCaseResult from raw test log data.
+TestResultParser::ParseResult parseTestCaseResultFromData (TestResultParser* parser, TestCaseResult* result, const char* casePath, TestStatusCode statusCode, const char* statusDetails, const deUint8* data, int dataSize)
+{
+	TestResultParser::ParseResult parseResult = TestResultParser::PARSERESULT_NOT_CHANGED;
+
 	DE_ASSERT(result->resultItems.getNumItems() == 0);
 
 	// Initialize status codes etc. from data.
-	result->casePath		= data.getTestCasePath();
+	result->casePath		= casePath;
 	result->caseType		= TESTCASETYPE_SELF_VALIDATE;
-	result->statusCode		= data.getStatusCode();
-	result->statusDetails	= data.getStatusDetails();
+	result->statusCode		= statusCode;
+	result->statusDetails	= statusDetails;
 
-	if (data.getDataSize() > 0)
+	if (dataSize > 0)
 	{
 		parser->init(result);
 
-		const TestResultParser::ParseResult parseResult = parser->parse(data.getData(), data.getDataSize());
+		parseResult = parser->parse(data, dataSize);
 
 		if (result->statusCode == TESTSTATUSCODE_LAST)
 		{
@@ -895,6 +956,8 @@ void parseTestCaseResultFromData (TestResultParser* parser, TestCaseResult* resu
 		throw Error("Invalid test case type in result");
 
 	DE_ASSERT(result->statusCode != TESTSTATUSCODE_LAST);
+
+	return parseResult;
 }
 
 } // xe
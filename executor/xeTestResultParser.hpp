@@ -28,6 +28,7 @@
 #include "xeTestCaseResult.hpp"
 
 #include <vector>
+#include <map>
 
 namespace xe
 {
@@ -85,6 +86,7 @@ private:
 	void					pushItem					(ri::Item* item);
 	void					popItem						(void);
 	void					updateCurrentItemList		(void);
+	void					storeItemData				(ri::Item* item);
 
 	enum State
 	{
@@ -107,7 +109,15 @@ private:
 
 	int						m_base64DecodeOffset;
 
-	std::string				m_curNumValue;
+	std::string				m_curItemData;		//!< Data of current text or number item.
+	std::vector<deUint8>	m_curImageData;		//!< Decoded data of current image.
+	std::string				m_curImageHash;		//!< ContentHash of current image.
+	const ri::Image*		m_curImageSource;	//!< Image that current image is DuplicateOf.
+
+	std::map<std::string, const ri::Image*>	m_imagesByHash;	//!< Images with ContentHash in current result.
+
+	ri::Sample				m_sampleItem;		//!< Placeholder for current <Sample>.
+	ri::SampleValue			m_sampleValueItem;	//!< Placeholder for current <Value>.
 };
 
 // Helpers exposed to other parsers.
@@ -117,7 +127,8 @@ TestStatusCode	getTestStatusCode			(const char* statusCode);
 
 class TestCaseResultData;
 
-void			parseTestCaseResultFromData	(TestResultParser* parser, TestCaseResult* result, const TestCaseResultData& data);
+TestResultParser::ParseResult	parseTestCaseResultFromData	(TestResultParser* parser, TestCaseResult* result, const TestCaseResultData& data);
+TestResultParser::ParseResult	parseTestCaseResultFromData	(TestResultParser* parser, TestCaseResult* result, const char* casePath, TestStatusCode statusCode, const char* statusDetails, const deUint8* data, int dataSize);
 
 } // xe
 
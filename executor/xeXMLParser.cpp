@@ -23,6 +23,7 @@
 
 #include "xeXMLParser.hpp"
 #include "deInt32.h"
+#include "deMemory.h"
 
 namespace xe
 {
@@ -54,11 +55,56 @@ static int getNextBufferSize (int curSize, int minNewSize)
 	return de::max(curSize*2, 1<<deLog2Ceil32(minNewSize));
 }
 
+static inline bool hasZeroByte (deUint64 word)
+{
+	return ((word - 0x0101010101010101ull) & ~word & 0x8080808080808080ull) != 0;
+}
+
+static inline deUint64 broadcastByte (deUint8 value)
+{
+	return 0x0101010101010101ull * value;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Find first occurrence of any of three byte values
+ *
+ * Compares 8 bytes at a time in a 64-bit word. The exact position of
+ * the match within the word is then found bytewise.
+ *
+ * \return Pointer to first matching byte, or end if none was found
+ *//*--------------------------------------------------------------------*/
+static const deUint8* findFirstOf (const deUint8* begin, const deUint8* end, deUint8 a, deUint8 b, deUint8 c)
+{
+	const deUint64	patternA	= broadcastByte(a);
+	const deUint64	patternB	= broadcastByte(b);
+	const deUint64	patternC	= broadcastByte(c);
+	const deUint8*	cur			= begin;
+
+	for (; cur + sizeof(deUint64) <= end; cur += sizeof(deUint64))
+	{
+		deUint64 word;
+		deMemcpy(&word, cur, sizeof(word));
+
+		if (hasZeroByte(word ^ patternA) || hasZeroByte(word ^ patternB) || hasZeroByte(word ^ patternC))
+			break;
+	}
+
+	for (; cur < end; cur++)
+	{
+		if (*cur == a || *cur == b || *cur == c)
+			break;
+	}
+
+	return cur;
+}
+
 Tokenizer::Tokenizer (void)
 	: m_curToken	(TOKEN_INCOMPLETE)
 	, m_curTokenLen	(0)
 	, m_state		(STATE_DATA)
 	, m_buf			(TOKENIZER_INITIAL_BUFFER_SIZE)
+	, m_bufBegin	(0)
+	, m_bufEnd		(0)
 {
 }
 
@@ -71,7 +117,8 @@ void Tokenizer::clear (void)
 	m_curToken		= TOKEN_INCOMPLETE;
 	m_curTokenLen	= 0;
 	m_state			= STATE_DATA;
-	m_buf.clear();
+	m_bufBegin		= 0;
+	m_bufEnd		= 0;
 }
 
 void Tokenizer::error (const std::string& what)
@@ -81,14 +128,31 @@ void Tokenizer::error (const std::string& what)
 
 void Tokenizer::feed (const deUint8* bytes, int numBytes)
 {
-	// Grow buffer if necessary.
-	if (m_buf.getNumFree() < numBytes)
+	if (m_bufEnd + numBytes > (int)m_buf.size())
 	{
-		m_buf.resize(getNextBufferSize(m_buf.getSize(), m_buf.getNumElements()+numBytes));
+		const int numUnparsed = m_bufEnd - m_bufBegin;
+
+		// Move unparsed data to beginning of buffer.
+		if (m_bufBegin > 0)
+		{
+			if (numUnparsed > 0)
+				deMemmove(&m_buf[0], &m_buf[m_bufBegin], numUnparsed);
+
+			m_bufBegin	= 0;
+			m_bufEnd	= numUnparsed;
+		}
+
+		// Grow buffer if necessary.
+		if (m_bufEnd + numBytes > (int)m_buf.size())
+			m_buf.resize(getNextBufferSize((int)m_buf.size(), m_bufEnd + numBytes));
 	}
 
-	// Append to front.
-	m_buf.pushFront(bytes, numBytes);
+	// Append to end.
+	if (numBytes > 0)
+	{
+		deMemcpy(&m_buf[m_bufEnd], bytes, numBytes);
+		m_bufEnd += numBytes;
+	}
 
 	// If we haven't parsed complete token, re-try after data feed.
 	if (m_curToken == TOKEN_INCOMPLETE)
@@ -97,10 +161,10 @@ void Tokenizer::feed (const deUint8* bytes, int numBytes)
 
 int Tokenizer::getChar (int offset) const
 {
-	DE_ASSERT(de::inRange(offset, 0, m_buf.getNumElements()));
+	DE_ASSERT(de::inRange(offset, 0, m_bufEnd-m_bufBegin));
 
-	if (offset < m_buf.getNumElements())
-		return m_buf.peekBack(offset);
+	if (m_bufBegin+offset < m_bufEnd)
+		return m_buf[m_bufBegin+offset];
 	else
 		return END_OF_BUFFER;
 }
@@ -121,7 +185,7 @@ void Tokenizer::advance (void)
 			m_state = STATE_DATA;
 
 		// Advance buffer by length of last token.
-		m_buf.popBack(m_curTokenLen);
+		m_bufBegin += m_curTokenLen;
 
 		// Reset state.
 		m_curToken		= TOKEN_INCOMPLETE;
@@ -142,6 +206,16 @@ void Tokenizer::advance (void)
 	{
 		if (m_state == STATE_DATA)
 		{
+			// Skip over plain data in bulk.
+			if (curChar != END_OF_STRING && curChar != (int)END_OF_BUFFER && curChar != '<' && curChar != '&')
+			{
+				const deUint8* const	begin	= &m_buf[0] + m_bufBegin + m_curTokenLen;
+				const deUint8* const	end		= &m_buf[0] + m_bufEnd;
+
+				m_curTokenLen	+= (int)(findFirstOf(begin, end, '<', '&', END_OF_STRING) - begin);
+				curChar			 = getChar(m_curTokenLen);
+			}
+
 			// Advance until we hit end of buffer or tag start and treat that as data token.
 			if (curChar == END_OF_STRING || curChar == (int)END_OF_BUFFER || curChar == '<' || curChar == '&')
 			{
@@ -175,7 +249,7 @@ void Tokenizer::advance (void)
 			{
 				while (isWhitespaceChar(curChar))
 				{
-					m_buf.popBack();
+					m_bufBegin += 1;
 					curChar = getChar(0);
 				}
 			}
@@ -225,6 +299,21 @@ void Tokenizer::advance (void)
 			}
 			else if (m_state == STATE_VALUE)
 			{
+				// Skip over string contents in bulk.
+				if (curChar != '\'' && curChar != '"')
+				{
+					const deUint8* const	begin	= &m_buf[0] + m_bufBegin + m_curTokenLen;
+					const deUint8* const	end		= &m_buf[0] + m_bufEnd;
+
+					m_curTokenLen	+= (int)(findFirstOf(begin, end, '\'', '"', END_OF_STRING) - begin);
+					curChar			 = getChar(m_curTokenLen);
+
+					if (curChar == END_OF_STRING)
+						error("Unexpected end of string");
+					else if (curChar == (int)END_OF_BUFFER)
+						return;
+				}
+
 				// \todo [2012-06-07 pyry] Escapes.
 				if (curChar == '\'' || curChar == '"')
 				{
@@ -338,9 +427,8 @@ void Tokenizer::advance (void)
 void Tokenizer::getString (std::string& dst) const
 {
 	DE_ASSERT(m_curToken == TOKEN_STRING);
-	dst.resize(m_curTokenLen-2);
-	for (int ndx = 0; ndx < m_curTokenLen-2; ndx++)
-		dst[ndx] = m_buf.peekBack(ndx+1);
+	const char* const str = (const char*)getTokenPtr() + 1;
+	dst.assign(str, str+m_curTokenLen-2);
 }
 
 Parser::Parser (void)
@@ -30,9 +30,9 @@
  *//*--------------------------------------------------------------------*/
 
 #include "xeDefs.hpp"
-#include "deRingBuffer.hpp"
 
 #include <string>
+#include <vector>
 #include <map>
 
 namespace xe
@@ -80,6 +80,14 @@ public:
 	ParseError (const std::string& message) : xe::ParseError(message) {}
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Incremental XML tokenizer
+ *
+ * Unparsed data is kept in a contiguous buffer so that runs of plain
+ * data and attribute values can be scanned in bulk, and so that the
+ * current token can be accessed in place with getTokenPtr(). Token
+ * pointers are valid until next call to feed(), advance() or clear().
+ *//*--------------------------------------------------------------------*/
 class Tokenizer
 {
 public:
@@ -93,7 +101,8 @@ public:
 
 	Token				getToken			(void) const		{ return m_curToken;	}
 	int					getTokenLen			(void) const		{ return m_curTokenLen;	}
-	deUint8				getTokenByte		(int offset) const	{ DE_ASSERT(m_curToken != TOKEN_INCOMPLETE && m_curToken != TOKEN_END_OF_STRING); return m_buf.peekBack(offset); }
+	deUint8				getTokenByte		(int offset) const	{ DE_ASSERT(m_curToken != TOKEN_INCOMPLETE && m_curToken != TOKEN_END_OF_STRING); return m_buf[m_bufBegin+offset]; }
+	const deUint8*		getTokenPtr			(void) const		{ DE_ASSERT(m_curToken != TOKEN_INCOMPLETE && m_curToken != TOKEN_END_OF_STRING); return &m_buf[m_bufBegin]; }
 	void				getTokenStr			(std::string& dst) const;
 	void				appendTokenStr		(std::string& dst) const;
 
@@ -130,7 +139,9 @@ private:
 
 	State						m_state;			//!< Tokenization state.
 
-	de::RingBuffer<deUint8>		m_buf;
+	std::vector<deUint8>		m_buf;				//!< Unparsed data is in [m_bufBegin, m_bufEnd).
+	int							m_bufBegin;
+	int							m_bufEnd;
 };
 
 class Parser
@@ -160,6 +171,7 @@ public:
 	// For ELEMENT_DATA.
 	int					getDataSize			(void) const;
 	deUint8				getDataByte			(int offset) const;
+	const deUint8*		getDataPtr			(void) const;		//!< Valid until next call to feed() or advance().
 	void				getDataStr			(std::string& dst) const;
 	void				appendDataStr		(std::string& dst) const;
 
@@ -202,21 +214,14 @@ private:
 
 inline void Tokenizer::getTokenStr (std::string& dst) const
 {
-	DE_ASSERT(m_curToken != TOKEN_INCOMPLETE && m_curToken != TOKEN_END_OF_STRING);
-	dst.resize(m_curTokenLen);
-	for (int ndx = 0; ndx < m_curTokenLen; ndx++)
-		dst[ndx] = m_buf.peekBack(ndx);
+	const char* const token = (const char*)getTokenPtr();
+	dst.assign(token, token+m_curTokenLen);
 }
 
 inline void Tokenizer::appendTokenStr (std::string& dst) const
 {
-	DE_ASSERT(m_curToken != TOKEN_INCOMPLETE && m_curToken != TOKEN_END_OF_STRING);
-
-	size_t oldLen = dst.size();
-	dst.resize(oldLen+m_curTokenLen);
-
-	for (int ndx = 0; ndx < m_curTokenLen; ndx++)
-		dst[oldLen+ndx] = m_buf.peekBack(ndx);
+	const char* const token = (const char*)getTokenPtr();
+	dst.append(token, token+m_curTokenLen);
 }
 
 inline int Parser::getDataSize (void) const
@@ -235,6 +240,14 @@ inline deUint8 Parser::getDataByte (int offset) const
 		return (deUint8)m_entityValue[offset];
 }
 
+inline const deUint8* Parser::getDataPtr (void) const
+{
+	if (m_state != STATE_ENTITY)
+		return m_tokenizer.getTokenPtr();
+	else
+		return (const deUint8*)m_entityValue.c_str();
+}
+
 inline void Parser::getDataStr (std::string& dst) const
 {
 	if (m_state != STATE_ENTITY)
@@ -27,6 +27,7 @@
 #include "tcuTestExecutor.hpp"
 #include "tcuCommandLine.hpp"
 #include "tcuTestLog.hpp"
+#include "tcuWorkerPool.hpp"
 #include "qpInfo.h"
 #include "qpDebugOut.h"
 #include "deMath.h"
@@ -69,6 +70,8 @@ App::App (Platform& platform, Archive& archive, TestLog& log, const CommandLine&
 	if (!deSetRoundingMode(DE_ROUNDINGMODE_TO_NEAREST))
 		qpPrintf("WARNING: Failed to set floating-point rounding mode!\n");
 
+	setMaxWorkerThreads(cmdLine.getWorkerThreadCount());
+
 	try
 	{
 		// Initialize watchdog
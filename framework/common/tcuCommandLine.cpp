@@ -26,6 +26,7 @@
 #include "tcuTestCase.hpp"
 #include "deFilePath.hpp"
 #include "deStringUtil.hpp"
+#include "deMemPool.hpp"
 #include "deString.h"
 #include "deInt32.h"
 #include "deCommandLine.h"
@@ -80,7 +81,13 @@ DE_DECLARE_COMMAND_LINE_OPT(EGLDisplayType,		std::string);
 DE_DECLARE_COMMAND_LINE_OPT(EGLWindowType,		std::string);
 DE_DECLARE_COMMAND_LINE_OPT(EGLPixmapType,		std::string);
 DE_DECLARE_COMMAND_LINE_OPT(LogImages,			bool);
+DE_DECLARE_COMMAND_LINE_OPT(LogAsync,			bool);
+DE_DECLARE_COMMAND_LINE_OPT(LogImageCompressionLevel,	int);
+DE_DECLARE_COMMAND_LINE_OPT(LogImageFilter,		qpImageFilter);
+DE_DECLARE_COMMAND_LINE_OPT(LogImageDedup,		bool);
 DE_DECLARE_COMMAND_LINE_OPT(TestOOM,			bool);
+DE_DECLARE_COMMAND_LINE_OPT(ShaderLibraryCacheDir,	std::string);
+DE_DECLARE_COMMAND_LINE_OPT(WorkerThreads,		int);
 
 static void parseIntList (const char* src, std::vector<int>* dst)
 {
@@ -124,6 +131,15 @@ void registerOptions (de::cmdline::Parser& parser)
 		{ "pbuffer",		SURFACETYPE_OFFSCREEN_GENERIC	},
 		{ "fbo",			SURFACETYPE_FBO					}
 	};
+	static const NamedValue<qpImageFilter> s_imageFilters[] =
+	{
+		{ "default",		QP_IMAGE_FILTER_DEFAULT		},
+		{ "none",			QP_IMAGE_FILTER_NONE		},
+		{ "sub",			QP_IMAGE_FILTER_SUB			},
+		{ "up",				QP_IMAGE_FILTER_UP			},
+		{ "average",		QP_IMAGE_FILTER_AVERAGE		},
+		{ "paeth",			QP_IMAGE_FILTER_PAETH		}
+	};
 	static const NamedValue<tcu::ScreenRotation> s_screenRotations[] =
 	{
 		{ "0",				SCREENROTATION_0			},
@@ -160,7 +176,13 @@ void registerOptions (de::cmdline::Parser& parser)
 		<< Option<EGLWindowType>		(DE_NULL,	"deqp-egl-window-type",			"EGL native window type")
 		<< Option<EGLPixmapType>		(DE_NULL,	"deqp-egl-pixmap-type",			"EGL native pixmap type")
 		<< Option<LogImages>			(DE_NULL,	"deqp-log-images",				"Enable or disable logging of result images",		s_enableNames,		"enable")
-		<< Option<TestOOM>				(DE_NULL,	"deqp-test-oom",				"Run tests that exhaust memory on purpose",			s_enableNames,		TEST_OOM_DEFAULT);
+		<< Option<LogAsync>				(DE_NULL,	"deqp-log-async",				"Compress and write test log in separate thread",	s_enableNames,		"disable")
+		<< Option<LogImageCompressionLevel>	(DE_NULL,	"deqp-log-image-compression-level",	"zlib level (0-9) for PNG images, -1 for default",						"-1")
+		<< Option<LogImageFilter>		(DE_NULL,	"deqp-log-image-filter",		"PNG row filter for logged images",					s_imageFilters,		"default")
+		<< Option<LogImageDedup>		(DE_NULL,	"deqp-log-image-dedup",			"Log data of identical images only once per case",	s_enableNames,		"disable")
+		<< Option<TestOOM>				(DE_NULL,	"deqp-test-oom",				"Run tests that exhaust memory on purpose",			s_enableNames,		TEST_OOM_DEFAULT)
+		<< Option<ShaderLibraryCacheDir>	(DE_NULL,	"deqp-shader-library-cache-dir",	"Cache parsed shader library (.test) files in given directory")
+		<< Option<WorkerThreads>		(DE_NULL,	"deqp-worker-threads",			"Max threads for image comparison and other framework utilities (1 = no threads, 0 = number of CPU cores)",	"0");
 }
 
 void registerLegacyOptions (de::cmdline::Parser& parser)
@@ -232,103 +254,272 @@ void DebugOutStreambuf::flushLine (void)
 	m_curLine.str("");
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Case list tree node
+ *
+ * Node names are interned in CaseTree. Children are searched linearly
+ * while there are only few of them, and through a hash table of child
+ * indices after that.
+ *
+ * Node name may contain *-wildcards that match within a single path
+ * component. Node named "**" matches zero or more whole path components.
+ *//*--------------------------------------------------------------------*/
 class CaseTreeNode
 {
 public:
-										CaseTreeNode		(const std::string& name) : m_name(name) {}
-										~CaseTreeNode		(void);
+										CaseTreeNode			(const char* name);
+										~CaseTreeNode			(void);
+
+	const char*							getName					(void) const { return m_name;									}
+	bool								hasChildren				(void) const { return !m_children.empty();						}
+	bool								isWildcard				(void) const { return m_isWildcard;								}
+	bool								isRecursiveWildcard		(void) const { return deStringEqual(m_name, "**") == DE_TRUE;	}
 
-	const std::string&					getName				(void) const { return m_name;				}
-	bool								hasChildren			(void) const { return !m_children.empty();	}
+	const CaseTreeNode*					findChild				(const char* name, int nameLen) const;
+	CaseTreeNode*						findChild				(const char* name, int nameLen);
 
-	bool								hasChild			(const std::string& name) const;
-	const CaseTreeNode*					getChild			(const std::string& name) const;
-	CaseTreeNode*						getChild			(const std::string& name);
+	int									getNumWildcardChildren	(void) const	{ return (int)m_wildcardChildren.size();	}
+	const CaseTreeNode*					getWildcardChild		(int ndx) const	{ return m_wildcardChildren[ndx];			}
 
-	void								addChild			(CaseTreeNode* child) { m_children.push_back(child); }
+	void								addChild				(CaseTreeNode* child);
 
 private:
-										CaseTreeNode		(const CaseTreeNode&);
-	CaseTreeNode&						operator=			(const CaseTreeNode&);
+										CaseTreeNode			(const CaseTreeNode&);
+	CaseTreeNode&						operator=				(const CaseTreeNode&);
 
-	enum { NOT_FOUND = -1 };
+	enum
+	{
+		NOT_FOUND					= -1,
+		MAX_LINEAR_SEARCH_CHILDREN	= 8
+	};
 
-	// \todo [2014-10-30 pyry] Speed up with hash / sorting
-	int									findChildNdx		(const std::string& name) const;
+	bool								nameEquals				(const char* name, int nameLen, deUint32 nameHash) const;
+	int									findChildNdx			(const char* name, int nameLen) const;
+	void								insertChildIndex		(int childNdx);
+	void								rebuildChildIndex		(void);
 
-	std::string							m_name;
+	const char* const					m_name;				//!< Interned in CaseTree.
+	const int							m_nameLen;
+	const deUint32						m_nameHash;
+	const bool							m_isWildcard;
 	std::vector<CaseTreeNode*>			m_children;
+	std::vector<CaseTreeNode*>			m_wildcardChildren;	//!< Children with wildcards in name, also in m_children.
+	std::vector<int>					m_childIndex;		//!< Open-addressing hash table of indices to m_children, empty if only few children.
 };
 
+CaseTreeNode::CaseTreeNode (const char* name)
+	: m_name		(name)
+	, m_nameLen		((int)strlen(name))
+	, m_nameHash	(deStringHash(name))
+	, m_isWildcard	(strchr(name, '*') != DE_NULL)
+{
+}
+
 CaseTreeNode::~CaseTreeNode (void)
 {
 	for (vector<CaseTreeNode*>::const_iterator i = m_children.begin(); i != m_children.end(); ++i)
 		delete *i;
 }
 
-int CaseTreeNode::findChildNdx (const std::string& name) const
+inline bool CaseTreeNode::nameEquals (const char* name, int nameLen, deUint32 nameHash) const
 {
-	for (int ndx = 0; ndx < (int)m_children.size(); ++ndx)
+	return m_nameHash == nameHash && m_nameLen == nameLen && deMemoryEqual(m_name, name, nameLen);
+}
+
+int CaseTreeNode::findChildNdx (const char* name, int nameLen) const
+{
+	const deUint32 nameHash = deStringHashLeading(name, nameLen);
+
+	if (m_childIndex.empty())
 	{
-		if (m_children[ndx]->getName() == name)
-			return ndx;
+		for (int ndx = 0; ndx < (int)m_children.size(); ++ndx)
+		{
+			if (m_children[ndx]->nameEquals(name, nameLen, nameHash))
+				return ndx;
+		}
 	}
+	else
+	{
+		const deUint32 mask = (deUint32)m_childIndex.size() - 1u;
+
+		for (deUint32 slot = nameHash & mask; m_childIndex[slot] != NOT_FOUND; slot = (slot + 1u) & mask)
+		{
+			if (m_children[m_childIndex[slot]]->nameEquals(name, nameLen, nameHash))
+				return m_childIndex[slot];
+		}
+	}
+
 	return NOT_FOUND;
 }
 
-inline bool CaseTreeNode::hasChild (const std::string& name) const
+inline const CaseTreeNode* CaseTreeNode::findChild (const char* name, int nameLen) const
 {
-	return findChildNdx(name) != NOT_FOUND;
+	const int ndx = findChildNdx(name, nameLen);
+	return ndx == NOT_FOUND ? DE_NULL : m_children[ndx];
 }
 
-inline const CaseTreeNode* CaseTreeNode::getChild (const std::string& name) const
+inline CaseTreeNode* CaseTreeNode::findChild (const char* name, int nameLen)
 {
-	const int ndx = findChildNdx(name);
+	const int ndx = findChildNdx(name, nameLen);
 	return ndx == NOT_FOUND ? DE_NULL : m_children[ndx];
 }
 
-inline CaseTreeNode* CaseTreeNode::getChild (const std::string& name)
+void CaseTreeNode::insertChildIndex (int childNdx)
 {
-	const int ndx = findChildNdx(name);
-	return ndx == NOT_FOUND ? DE_NULL : m_children[ndx];
+	const deUint32	mask	= (deUint32)m_childIndex.size() - 1u;
+	deUint32		slot	= m_children[childNdx]->m_nameHash & mask;
+
+	while (m_childIndex[slot] != NOT_FOUND)
+		slot = (slot + 1u) & mask;
+
+	m_childIndex[slot] = childNdx;
 }
 
-static int getCurrentComponentLen (const char* path)
+void CaseTreeNode::rebuildChildIndex (void)
 {
-	int ndx = 0;
-	for (; path[ndx] != 0 && path[ndx] != '.'; ++ndx);
-	return ndx;
+	int size = MAX_LINEAR_SEARCH_CHILDREN*4;
+
+	// Keep load factor at most 1/2
+	while (size < (int)m_children.size()*4)
+		size *= 2;
+
+	m_childIndex.assign(size, NOT_FOUND);
+
+	for (int ndx = 0; ndx < (int)m_children.size(); ++ndx)
+		insertChildIndex(ndx);
 }
 
-static const CaseTreeNode* findNode (const CaseTreeNode* root, const char* path)
+void CaseTreeNode::addChild (CaseTreeNode* child)
 {
-	const CaseTreeNode*	curNode		= root;
-	const char*			curPath		= path;
-	int					curLen		= getCurrentComponentLen(curPath);
+	m_children.push_back(child);
 
-	for (;;)
+	try
 	{
-		curNode = curNode->getChild(std::string(curPath, curPath+curLen));
+		if (child->isWildcard())
+			m_wildcardChildren.push_back(child);
 
-		if (!curNode)
-			break;
+		if (!m_childIndex.empty() && (int)m_children.size()*2 <= (int)m_childIndex.size())
+			insertChildIndex((int)m_children.size()-1);
+		else if ((int)m_children.size() > MAX_LINEAR_SEARCH_CHILDREN)
+			rebuildChildIndex();
+	}
+	catch (...)
+	{
+		if (!m_wildcardChildren.empty() && m_wildcardChildren.back() == child)
+			m_wildcardChildren.pop_back();
 
-		curPath	+= curLen;
+		m_children.pop_back();
+		m_childIndex.clear();
+		throw;
+	}
+}
 
-		if (curPath[0] == 0)
-			break;
-		else
+/*--------------------------------------------------------------------*//*!
+ * \brief Case list tree
+ *
+ * Owns the root node and the storage for node names. Names are interned
+ * so that names repeated in many groups (such as "vertex" or "highp")
+ * are stored only once.
+ *//*--------------------------------------------------------------------*/
+class CaseTree
+{
+public:
+										CaseTree				(void);
+										~CaseTree				(void);
+
+	CaseTreeNode*						getRoot					(void)			{ return m_root;	}
+	const CaseTreeNode*					getRoot					(void) const	{ return m_root;	}
+
+	const char*							internName				(const std::string& name);
+
+private:
+										CaseTree				(const CaseTree&);
+	CaseTree&							operator=				(const CaseTree&);
+
+	enum
+	{
+		INITIAL_NAME_TABLE_SIZE		= 64
+	};
+
+	void								insertName				(const char* name);
+
+	de::MemPool							m_namePool;
+	std::vector<const char*>			m_nameTable;		//!< Open-addressing hash table of interned names.
+	int									m_numNames;
+	CaseTreeNode*						m_root;
+};
+
+CaseTree::CaseTree (void)
+	: m_nameTable	(INITIAL_NAME_TABLE_SIZE, DE_NULL)
+	, m_numNames	(0)
+	, m_root		(DE_NULL)
+{
+	m_root = new CaseTreeNode(internName(""));
+}
+
+CaseTree::~CaseTree (void)
+{
+	delete m_root;
+}
+
+void CaseTree::insertName (const char* name)
+{
+	const deUint32	mask	= (deUint32)m_nameTable.size() - 1u;
+	deUint32		slot	= deStringHash(name) & mask;
+
+	while (m_nameTable[slot])
+		slot = (slot + 1u) & mask;
+
+	m_nameTable[slot] = name;
+}
+
+const char* CaseTree::internName (const std::string& name)
+{
+	const deUint32	mask	= (deUint32)m_nameTable.size() - 1u;
+	deUint32		slot	= deStringHash(name.c_str()) & mask;
+
+	for (; m_nameTable[slot]; slot = (slot + 1u) & mask)
+	{
+		if (name == m_nameTable[slot])
+			return m_nameTable[slot];
+	}
+
+	if ((m_numNames+1)*2 > (int)m_nameTable.size())
+	{
+		vector<const char*> oldTable (m_nameTable.size()*2, DE_NULL);
+
+		m_nameTable.swap(oldTable);
+
+		for (vector<const char*>::const_iterator oldName = oldTable.begin(); oldName != oldTable.end(); ++oldName)
 		{
-			DE_ASSERT(curPath[0] == '.');
-			curPath		+= 1;
-			curLen		 = getCurrentComponentLen(curPath);
+			if (*oldName)
+				insertName(*oldName);
 		}
 	}
 
-	return curNode;
+	{
+		const char* const interned = de::copyToPool(&m_namePool, name.c_str());
+
+		insertName(interned);
+		m_numNames += 1;
+
+		return interned;
+	}
+}
+
+static inline bool isValidCaseListNameChar (char c)
+{
+	return isValidTestCaseNameChar(c) || c == '*';
 }
 
-static void parseCaseTrie (CaseTreeNode* root, std::istream& in)
+static int getCurrentComponentLen (const char* path)
+{
+	int ndx = 0;
+	for (; path[ndx] != 0 && path[ndx] != '.'; ++ndx);
+	return ndx;
+}
+
+static void parseCaseTrie (CaseTree& tree, std::istream& in)
 {
 	vector<CaseTreeNode*>	nodeStack;
 	string					curName;
@@ -337,7 +528,7 @@ static void parseCaseTrie (CaseTreeNode* root, std::istream& in)
 	if (in.get() != '{')
 		throw std::invalid_argument("Malformed case trie");
 
-	nodeStack.push_back(root);
+	nodeStack.push_back(tree.getRoot());
 
 	while (!nodeStack.empty())
 	{
@@ -350,7 +541,7 @@ static void parseCaseTrie (CaseTreeNode* root, std::istream& in)
 		{
 			if (!curName.empty() && expectNode)
 			{
-				CaseTreeNode* const newChild = new CaseTreeNode(curName);
+				CaseTreeNode* const newChild = new CaseTreeNode(tree.internName(curName));
 
 				try
 				{
@@ -387,14 +578,14 @@ static void parseCaseTrie (CaseTreeNode* root, std::istream& in)
 			else
 				expectNode = true;
 		}
-		else if (isValidTestCaseNameChar((char)curChr))
+		else if (isValidCaseListNameChar((char)curChr))
 			curName += (char)curChr;
 		else
 			throw std::invalid_argument("Illegal character in node name");
 	}
 }
 
-static void parseCaseList (CaseTreeNode* root, std::istream& in)
+static void parseCaseList (CaseTree& tree, std::istream& in)
 {
 	// \note Algorithm assumes that cases are sorted by groups, but will
 	//		 function fine, albeit more slowly, if that is not the case.
@@ -404,7 +595,7 @@ static void parseCaseList (CaseTreeNode* root, std::istream& in)
 
 	nodeStack.resize(8, DE_NULL);
 
-	nodeStack[0] = root;
+	nodeStack[0] = tree.getRoot();
 
 	for (;;)
 	{
@@ -415,10 +606,10 @@ static void parseCaseList (CaseTreeNode* root, std::istream& in)
 			if (curName.empty())
 				throw std::invalid_argument("Empty test case name");
 
-			if (nodeStack[stackPos]->hasChild(curName))
+			if (nodeStack[stackPos]->findChild(curName.c_str(), (int)curName.size()))
 				throw std::invalid_argument("Duplicate test case");
 
-			CaseTreeNode* const newChild = new CaseTreeNode(curName);
+			CaseTreeNode* const newChild = new CaseTreeNode(tree.internName(curName));
 
 			try
 			{
@@ -451,13 +642,13 @@ static void parseCaseList (CaseTreeNode* root, std::istream& in)
 			if ((int)nodeStack.size() <= stackPos+1)
 				nodeStack.resize(nodeStack.size()*2, DE_NULL);
 
-			if (!nodeStack[stackPos+1] || nodeStack[stackPos+1]->getName() != curName)
+			if (!nodeStack[stackPos+1] || curName != nodeStack[stackPos+1]->getName())
 			{
-				CaseTreeNode* curGroup = nodeStack[stackPos]->getChild(curName);
+				CaseTreeNode* curGroup = nodeStack[stackPos]->findChild(curName.c_str(), (int)curName.size());
 
 				if (!curGroup)
 				{
-					curGroup = new CaseTreeNode(curName);
+					curGroup = new CaseTreeNode(tree.internName(curName));
 
 					try
 					{
@@ -476,27 +667,27 @@ static void parseCaseList (CaseTreeNode* root, std::istream& in)
 					nodeStack[stackPos+2] = DE_NULL; // Invalidate rest of entries
 			}
 
-			DE_ASSERT(nodeStack[stackPos+1]->getName() == curName);
+			DE_ASSERT(curName == nodeStack[stackPos+1]->getName());
 
 			curName.clear();
 			stackPos += 1;
 		}
-		else if (isValidTestCaseNameChar((char)curChr))
+		else if (isValidCaseListNameChar((char)curChr))
 			curName += (char)curChr;
 		else
 			throw std::invalid_argument("Illegal character in test case name");
 	}
 }
 
-static CaseTreeNode* parseCaseList (std::istream& in)
+static CaseTree* parseCaseList (std::istream& in)
 {
-	CaseTreeNode* const root = new CaseTreeNode("");
+	CaseTree* const tree = new CaseTree();
 	try
 	{
 		if (in.peek() == '{')
-			parseCaseTrie(root, in);
+			parseCaseTrie(*tree, in);
 		else
-			parseCaseList(root, in);
+			parseCaseList(*tree, in);
 
 		{
 			const int curChr = in.get();
@@ -504,11 +695,11 @@ static CaseTreeNode* parseCaseList (std::istream& in)
 				throw std::invalid_argument("Trailing characters at end of case list");
 		}
 
-		return root;
+		return tree;
 	}
 	catch (...)
 	{
-		delete root;
+		delete tree;
 		throw;
 	}
 }
@@ -529,14 +720,15 @@ CasePaths::CasePaths (const string& pathList)
 }
 
 // Match a single path component against a pattern component that may contain *-wildcards.
-static bool matchWildcards(string::const_iterator	patternStart,
-						   string::const_iterator	patternEnd,
-						   string::const_iterator	pathStart,
-						   string::const_iterator	pathEnd,
-						   bool						allowPrefix)
+template<typename Iterator>
+static bool matchWildcards(Iterator	patternStart,
+						   Iterator	patternEnd,
+						   Iterator	pathStart,
+						   Iterator	pathEnd,
+						   bool		allowPrefix)
 {
-	string::const_iterator	pattern	= patternStart;
-	string::const_iterator	path	= pathStart;
+	Iterator	pattern	= patternStart;
+	Iterator	path	= pathStart;
 
 	while (pattern != patternEnd && path != pathEnd && *pattern == *path)
 	{
@@ -703,6 +895,19 @@ bool CommandLine::parse (int argc, const char* const* argv)
 	if (!m_cmdLine.getOption<opt::LogImages>())
 		m_logFlags |= QP_TEST_LOG_EXCLUDE_IMAGES;
 
+	if (m_cmdLine.getOption<opt::LogAsync>())
+		m_logFlags |= QP_TEST_LOG_ASYNC;
+
+	if (m_cmdLine.getOption<opt::LogImageDedup>())
+		m_logFlags |= QP_TEST_LOG_DEDUPLICATE_IMAGES;
+
+	if (!de::inRange(m_cmdLine.getOption<opt::LogImageCompressionLevel>(), -1, 9))
+	{
+		debugOut << "ERROR: image compression level must be between -1 and 9!\n" << std::endl;
+		clear();
+		return false;
+	}
+
 	if ((m_cmdLine.hasOption<opt::CasePath>()?1:0) +
 		(m_cmdLine.hasOption<opt::CaseList>()?1:0) +
 		(m_cmdLine.hasOption<opt::CaseListFile>()?1:0) +
@@ -775,12 +980,15 @@ bool CommandLine::parse (const std::string& cmdLine)
 
 const char*				CommandLine::getLogFileName				(void) const	{ return m_cmdLine.getOption<opt::LogFilename>().c_str();		}
 deUint32				CommandLine::getLogFlags				(void) const	{ return m_logFlags;											}
+int						CommandLine::getLogImageCompressionLevel	(void) const	{ return m_cmdLine.getOption<opt::LogImageCompressionLevel>();	}
+qpImageFilter			CommandLine::getLogImageFilter			(void) const	{ return m_cmdLine.getOption<opt::LogImageFilter>();			}
 RunMode					CommandLine::getRunMode					(void) const	{ return m_cmdLine.getOption<opt::RunMode>();					}
 WindowVisibility		CommandLine::getVisibility				(void) const	{ return m_cmdLine.getOption<opt::Visibility>();				}
 bool					CommandLine::isWatchDogEnabled			(void) const	{ return m_cmdLine.getOption<opt::WatchDog>();					}
 bool					CommandLine::isCrashHandlingEnabled		(void) const	{ return m_cmdLine.getOption<opt::CrashHandler>();				}
 int						CommandLine::getBaseSeed				(void) const	{ return m_cmdLine.getOption<opt::BaseSeed>();					}
 int						CommandLine::getTestIterationCount		(void) const	{ return m_cmdLine.getOption<opt::TestIterationCount>();		}
+int						CommandLine::getWorkerThreadCount		(void) const	{ return m_cmdLine.getOption<opt::WorkerThreads>();				}
 int						CommandLine::getSurfaceWidth			(void) const	{ return m_cmdLine.getOption<opt::SurfaceWidth>();				}
 int						CommandLine::getSurfaceHeight			(void) const	{ return m_cmdLine.getOption<opt::SurfaceHeight>();				}
 SurfaceType				CommandLine::getSurfaceType				(void) const	{ return m_cmdLine.getOption<opt::SurfaceType>();				}
@@ -845,16 +1053,74 @@ const char* CommandLine::getEGLPixmapType (void) const
 		return DE_NULL;
 }
 
-static bool checkTestGroupName (const CaseTreeNode* root, const char* groupPath)
+const char* CommandLine::getShaderLibraryCacheDir (void) const
+{
+	if (m_cmdLine.hasOption<opt::ShaderLibraryCacheDir>())
+		return m_cmdLine.getOption<opt::ShaderLibraryCacheDir>().c_str();
+	else
+		return DE_NULL;
+}
+
+static const char* getNextComponent (const char* path)
+{
+	const char* const end = path + getCurrentComponentLen(path);
+	return end[0] == '.' ? end+1 : end;
+}
+
+// Match remaining components of path against subtree of node. Group path
+// matches if there may be cases matching the tree within the group.
+static bool matchCaseTree (const CaseTreeNode* node, const char* path, bool isGroup)
+{
+	const int			compLen		= getCurrentComponentLen(path);
+	const char* const	nextPath	= getNextComponent(path);
+
+	if (path[0] == 0)
+	{
+		if (isGroup ? (node->hasChildren() || node->isRecursiveWildcard()) : !node->hasChildren())
+			return true;
+	}
+	else
+	{
+		const CaseTreeNode* const child = node->findChild(path, compLen);
+
+		if (child && matchCaseTree(child, nextPath, isGroup))
+			return true;
+	}
+
+	for (int ndx = 0; ndx < node->getNumWildcardChildren(); ndx++)
+	{
+		const CaseTreeNode* const	child	= node->getWildcardChild(ndx);
+		const char* const			pattern	= child->getName();
+
+		if (child->isRecursiveWildcard())
+		{
+			// "**" may consume any number of components
+			for (const char* rest = path;; rest = getNextComponent(rest))
+			{
+				if (matchCaseTree(child, rest, isGroup))
+					return true;
+
+				if (rest[0] == 0)
+					break;
+			}
+		}
+		else if (path[0] != 0 &&
+				 matchWildcards(pattern, pattern + strlen(pattern), path, path + compLen, false) &&
+				 matchCaseTree(child, nextPath, isGroup))
+			return true;
+	}
+
+	return false;
+}
+
+static bool checkTestGroupName (const CaseTree* tree, const char* groupPath)
 {
-	const CaseTreeNode* node = findNode(root, groupPath);
-	return node && node->hasChildren();
+	return matchCaseTree(tree->getRoot(), groupPath, true);
 }
 
-static bool checkTestCaseName (const CaseTreeNode* root, const char* casePath)
+static bool checkTestCaseName (const CaseTree* tree, const char* casePath)
 {
-	const CaseTreeNode* node = findNode(root, casePath);
-	return node && !node->hasChildren();
+	return matchCaseTree(tree->getRoot(), casePath, false);
 }
 
 bool CommandLine::checkTestGroupName (const char* groupName) const
@@ -26,6 +26,7 @@
 #include "tcuDefs.hpp"
 #include "deCommandLine.hpp"
 #include "deUniquePtr.hpp"
+#include "qpTestLog.h"
 
 #include <string>
 #include <vector>
@@ -84,7 +85,7 @@ enum ScreenRotation
 	SCREENROTATION_LAST
 };
 
-class CaseTreeNode;
+class CaseTree;
 class CasePaths;
 
 /*--------------------------------------------------------------------*//*!
@@ -110,6 +111,12 @@ public:
 	//! Get logging flags
 	deUint32						getLogFlags					(void) const;
 
+	//! Get PNG compression level for logged images (--deqp-log-image-compression-level)
+	int								getLogImageCompressionLevel	(void) const;
+
+	//! Get PNG row filter for logged images (--deqp-log-image-filter)
+	qpImageFilter					getLogImageFilter			(void) const;
+
 	//! Get run mode (--deqp-runmode)
 	RunMode							getRunMode					(void) const;
 
@@ -174,6 +181,12 @@ public:
 	//! Should we run tests that exhaust memory (--deqp-test-oom)
 	bool							isOutOfMemoryTestEnabled(void) const;
 
+	//! Get shader library cache directory (--deqp-shader-library-cache-dir)
+	const char*						getShaderLibraryCacheDir	(void) const;
+
+	//! Get max number of worker threads for framework utilities (--deqp-worker-threads)
+	int								getWorkerThreadCount		(void) const;
+
 	//! Check if test group is in supplied test case list.
 	bool							checkTestGroupName			(const char* groupName) const;
 
@@ -188,7 +201,7 @@ private:
 
 	de::cmdline::CommandLine		m_cmdLine;
 	deUint32						m_logFlags;
-	CaseTreeNode*					m_caseTree;
+	CaseTree*						m_caseTree;
 	de::MovePtr<const CasePaths>	m_casePaths;
 };
 
@@ -23,8 +23,13 @@
 
 #include "tcuCompressedTexture.hpp"
 #include "tcuTextureUtil.hpp"
+#include "tcuWorkerPool.hpp"
 #include "deStringUtil.hpp"
 #include "deFloat16.h"
+#include "deMutex.hpp"
+#include "deUniquePtr.hpp"
+#include "deRandom.hpp"
+#include "deMemory.h"
 
 #include <algorithm>
 
@@ -2311,17 +2316,28 @@ static void interpolateWeights (TexelWeightPair* dst, const deUint32* unquantize
 	const int		numWeightsPerTexel	= blockMode.isDualPlane ? 2 : 1;
 	const deUint32	scaleX				= (1024 + blockWidth/2) / (blockWidth-1);
 	const deUint32	scaleY				= (1024 + blockHeight/2) / (blockHeight-1);
+	deUint32		jXs[ASTC_MAX_BLOCK_WIDTH];
+	deUint32		fXs[ASTC_MAX_BLOCK_WIDTH];
+
+	// Grid column and fraction only depend on texel column.
+	for (int texelX = 0; texelX < blockWidth; texelX++)
+	{
+		const deUint32 gX	= (scaleX*texelX*(blockMode.weightGridWidth-1) + 32) >> 6;
+
+		jXs[texelX] = gX >> 4;
+		fXs[texelX] = gX & 0xf;
+	}
 
 	for (int texelY = 0; texelY < blockHeight; texelY++)
 	{
+		const deUint32 gY	= (scaleY*texelY*(blockMode.weightGridHeight-1) + 32) >> 6;
+		const deUint32 jY	= gY >> 4;
+		const deUint32 fY	= gY & 0xf;
+
 		for (int texelX = 0; texelX < blockWidth; texelX++)
 		{
-			const deUint32 gX	= (scaleX*texelX*(blockMode.weightGridWidth-1) + 32) >> 6;
-			const deUint32 gY	= (scaleY*texelY*(blockMode.weightGridHeight-1) + 32) >> 6;
-			const deUint32 jX	= gX >> 4;
-			const deUint32 jY	= gY >> 4;
-			const deUint32 fX	= gX & 0xf;
-			const deUint32 fY	= gY & 0xf;
+			const deUint32 jX	= jXs[texelX];
+			const deUint32 fX	= fXs[texelX];
 			const deUint32 w11	= (fX*fY + 8) >> 4;
 			const deUint32 w10	= fY - w11;
 			const deUint32 w01	= fX - w11;
@@ -2418,10 +2434,20 @@ static void setTexelColors (void* dst, ColorEndpointPair* colorEndpoints, TexelW
 {
 	const bool	smallBlock = blockWidth*blockHeight < 31;
 	bool		isHDREndpoint[4];
+	deUint32	ldrC0[4][4];	//!< Endpoint 0 expanded to 16 bits for LDR interpolation, per partition and channel.
+	deUint32	ldrC1[4][4];	//!< Endpoint 1 expanded to 16 bits for LDR interpolation, per partition and channel.
 
 	for (int i = 0; i < numPartitions; i++)
+	{
 		isHDREndpoint[i] = isColorEndpointModeHDR(colorEndpointModes[i]);
 
+		for (int channelNdx = 0; channelNdx < 4; channelNdx++)
+		{
+			ldrC0[i][channelNdx] = (colorEndpoints[i].e0[channelNdx] << 8) | (isSRGB ? 0x80 : colorEndpoints[i].e0[channelNdx]);
+			ldrC1[i][channelNdx] = (colorEndpoints[i].e1[channelNdx] << 8) | (isSRGB ? 0x80 : colorEndpoints[i].e1[channelNdx]);
+		}
+	}
+
 	for (int texelY = 0; texelY < blockHeight; texelY++)
 	for (int texelX = 0; texelX < blockWidth; texelX++)
 	{
@@ -2455,8 +2481,8 @@ static void setTexelColors (void* dst, ColorEndpointPair* colorEndpoints, TexelW
 			{
 				if (!isHDREndpoint[colorEndpointNdx] || (channelNdx == 3 && colorEndpointModes[colorEndpointNdx] == 14)) // \note Alpha for mode 14 is treated the same as LDR.
 				{
-					const deUint32 c0	= (e0[channelNdx] << 8) | (isSRGB ? 0x80 : e0[channelNdx]);
-					const deUint32 c1	= (e1[channelNdx] << 8) | (isSRGB ? 0x80 : e1[channelNdx]);
+					const deUint32 c0	= ldrC0[colorEndpointNdx][channelNdx];
+					const deUint32 c1	= ldrC1[colorEndpointNdx][channelNdx];
 					const deUint32 w	= weight.w[ccs == channelNdx ? 1 : 0];
 					const deUint32 c	= (c0*(64-w) + c1*w + 32) / 64;
 
@@ -2633,48 +2659,411 @@ static void decompressASTC (const tcu::PixelBufferAccess& dst, int width, int he
 	}
 }
 
+static void decompressBlocks (CompressedTexture::Format format, const tcu::PixelBufferAccess& dst, int width, int height, const deUint8* data, bool isASTCModeLDR)
+{
+	if (isEtcFormat(format))
+	{
+		switch (format)
+		{
+			case CompressedTexture::ETC1_RGB8:							decompressETC1								(dst, width, height, data);			break;
+			case CompressedTexture::EAC_R11:							decompressEAC_R11							(dst, width, height, data, false);	break;
+			case CompressedTexture::EAC_SIGNED_R11:						decompressEAC_R11							(dst, width, height, data, true);	break;
+			case CompressedTexture::EAC_RG11:							decompressEAC_RG11							(dst, width, height, data, false);	break;
+			case CompressedTexture::EAC_SIGNED_RG11:					decompressEAC_RG11							(dst, width, height, data, true);	break;
+			case CompressedTexture::ETC2_RGB8:							decompressETC2								(dst, width, height, data);			break;
+			case CompressedTexture::ETC2_SRGB8:							decompressETC2								(dst, width, height, data);			break;
+			case CompressedTexture::ETC2_RGB8_PUNCHTHROUGH_ALPHA1:		decompressETC2_RGB8_PUNCHTHROUGH_ALPHA1		(dst, width, height, data);			break;
+			case CompressedTexture::ETC2_SRGB8_PUNCHTHROUGH_ALPHA1:		decompressETC2_RGB8_PUNCHTHROUGH_ALPHA1		(dst, width, height, data);			break;
+			case CompressedTexture::ETC2_EAC_RGBA8:						decompressETC2_EAC_RGBA8					(dst, width, height, data);			break;
+			case CompressedTexture::ETC2_EAC_SRGB8_ALPHA8:				decompressETC2_EAC_RGBA8					(dst, width, height, data);			break;
+
+			default:
+				DE_ASSERT(false);
+				break;
+		}
+	}
+	else if (isASTCFormat(format))
+	{
+		const tcu::IVec3	blockSize		= getASTCBlockSize(format);
+		const bool			isSRGBFormat	= isASTCSRGBFormat(format);
+
+		decompressASTC(dst, width, height, data, blockSize.x(), blockSize.y(), isSRGBFormat, isSRGBFormat || isASTCModeLDR);
+	}
+	else
+		DE_ASSERT(false);
+}
+
+enum
+{
+	MIN_DECOMPRESS_BLOCKS_PER_BAND	= 256		//!< Smaller levels are decoded on calling thread.
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Block row band decompression job
+ *
+ * Compressed blocks are stored in row-major order, so a band of block
+ * rows maps to a contiguous range of compressed data and a horizontal
+ * slice of the destination.
+ *//*--------------------------------------------------------------------*/
+class DecompressBandJob : public de::WorkerPool::Job
+{
+public:
+	DecompressBandJob (CompressedTexture::Format format, const tcu::PixelBufferAccess& dst, const deUint8* data, int dataSize, int blockHeight, int numBands, bool isASTCModeLDR)
+		: m_format			(format)
+		, m_dst				(dst)
+		, m_data			(data)
+		, m_blockHeight		(blockHeight)
+		, m_numBlockRows	(divRoundUp(dst.getHeight(), blockHeight))
+		, m_blockRowSize	(dataSize / m_numBlockRows)
+		, m_numBands		(numBands)
+		, m_isASTCModeLDR	(isASTCModeLDR)
+		, m_errorBandNdx	(-1)
+	{
+		DE_ASSERT(dataSize % m_numBlockRows == 0);
+	}
+
+	//! Rethrow decoding error from the first failed band, if any.
+	void throwIfError (void) const
+	{
+		if (m_errorBandNdx >= 0)
+			throw tcu::InternalError(m_errorMessage);
+	}
+
+	void execute (int bandNdx, int workerNdx)
+	{
+		const int	firstRow	= bandNdx*m_numBlockRows / m_numBands;
+		const int	endRow		= (bandNdx+1)*m_numBlockRows / m_numBands;
+		const int	y			= firstRow*m_blockHeight;
+		const int	height		= de::min(endRow*m_blockHeight, m_dst.getHeight()) - y;
+
+		DE_UNREF(workerNdx);
+
+		try
+		{
+			decompressBlocks(m_format, tcu::getSubregion(m_dst, 0, y, m_dst.getWidth(), height), m_dst.getWidth(), height,
+							 m_data + firstRow*m_blockRowSize, m_isASTCModeLDR);
+		}
+		catch (const tcu::InternalError& e)
+		{
+			// \note Keep error from first band in order to report same error regardless of scheduling.
+			de::ScopedLock lock(m_errorLock);
+
+			if (m_errorBandNdx < 0 || bandNdx < m_errorBandNdx)
+			{
+				m_errorBandNdx	= bandNdx;
+				m_errorMessage	= e.getMessage();
+			}
+		}
+	}
+
+private:
+	const CompressedTexture::Format		m_format;
+	const tcu::PixelBufferAccess		m_dst;
+	const deUint8* const				m_data;
+	const int							m_blockHeight;
+	const int							m_numBlockRows;
+	const int							m_blockRowSize;
+	const int							m_numBands;
+	const bool							m_isASTCModeLDR;
+
+	de::Mutex							m_errorLock;
+	int									m_errorBandNdx;
+	std::string							m_errorMessage;
+};
+
+static deUint32 computeDataHash (const CompressedTexture& texture)
+{
+	// FNV-1a
+	const deUint8* const	data	= (const deUint8*)texture.getData();
+	deUint32				hash	= 2166136261u;
+
+	for (int ndx = 0; ndx < texture.getDataSize(); ndx++)
+		hash = (hash ^ data[ndx]) * 16777619u;
+
+	return hash;
+}
+
+struct DecompressionCache::Entry
+{
+	deUint32					hash;
+	CompressedTexture::Format	format;
+	int							width;
+	int							height;
+	bool						isASTCModeLDR;
+	std::vector<deUint8>		data;
+	tcu::TextureLevel			decoded;
+
+	bool matches (const CompressedTexture& texture, bool isASTCModeLDR_) const
+	{
+		return format			== texture.getFormat()					&&
+			   width			== texture.getWidth()					&&
+			   height			== texture.getHeight()					&&
+			   isASTCModeLDR	== isASTCModeLDR_						&&
+			   (int)data.size()	== texture.getDataSize()				&&
+			   deMemCmp(&data[0], texture.getData(), (int)data.size()) == 0;
+	}
+
+	int getSize (void) const
+	{
+		return (int)data.size() + decoded.getWidth()*decoded.getHeight()*decoded.getFormat().getPixelSize();
+	}
+};
+
+DecompressionCache::DecompressionCache (int maxTotalSize)
+	: m_maxTotalSize	(maxTotalSize)
+	, m_totalSize		(0)
+{
+}
+
+DecompressionCache::~DecompressionCache (void)
+{
+	for (std::list<Entry*>::iterator iter = m_entries.begin(); iter != m_entries.end(); ++iter)
+		delete *iter;
+}
+
+bool DecompressionCache::lookup (const CompressedTexture& texture, bool isASTCModeLDR, const PixelBufferAccess& dst)
+{
+	const deUint32					hash	= computeDataHash(texture);
+	de::ScopedLock					lock	(m_lock);
+	const EntryMap::const_iterator	end		= m_entriesByHash.upper_bound(hash);
+
+	for (EntryMap::const_iterator iter = m_entriesByHash.lower_bound(hash); iter != end; ++iter)
+	{
+		if (iter->second->matches(texture, isASTCModeLDR))
+		{
+			tcu::copy(dst, iter->second->decoded.getAccess());
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void DecompressionCache::insert (const CompressedTexture& texture, bool isASTCModeLDR, const ConstPixelBufferAccess& decoded)
+{
+	de::MovePtr<Entry> entry (new Entry());
+
+	entry->hash				= computeDataHash(texture);
+	entry->format			= texture.getFormat();
+	entry->width			= texture.getWidth();
+	entry->height			= texture.getHeight();
+	entry->isASTCModeLDR	= isASTCModeLDR;
+	entry->data.assign((const deUint8*)texture.getData(), (const deUint8*)texture.getData() + texture.getDataSize());
+	entry->decoded.setStorage(decoded.getFormat(), decoded.getWidth(), decoded.getHeight());
+	tcu::copy(entry->decoded.getAccess(), decoded);
+
+	if (entry->getSize() > m_maxTotalSize)
+		return;
+
+	{
+		de::ScopedLock lock (m_lock);
+
+		while (m_totalSize + entry->getSize() > m_maxTotalSize)
+			evictOldest();
+
+		m_entriesByHash.insert(std::make_pair(entry->hash, entry.get()));
+		m_entries.push_back(entry.get());
+		m_totalSize += entry->getSize();
+		entry.release();
+	}
+}
+
+void DecompressionCache::evictOldest (void)
+{
+	Entry* const				entry	= m_entries.front();
+	const EntryMap::iterator	end		= m_entriesByHash.upper_bound(entry->hash);
+
+	for (EntryMap::iterator iter = m_entriesByHash.lower_bound(entry->hash); iter != end; ++iter)
+	{
+		if (iter->second == entry)
+		{
+			m_entriesByHash.erase(iter);
+			break;
+		}
+	}
+
+	m_entries.pop_front();
+	m_totalSize -= entry->getSize();
+	delete entry;
+}
+
+int DecompressionCache::getNumEntries (void) const
+{
+	de::ScopedLock lock (m_lock);
+	return (int)m_entries.size();
+}
+
+int DecompressionCache::getTotalSize (void) const
+{
+	de::ScopedLock lock (m_lock);
+	return m_totalSize;
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief Decode to uncompressed pixel data
  * \param dst Destination buffer
+ *
+ * Large levels are decoded in bands of block rows using multiple threads.
+ * If params.cache is given, decoded level is looked up from and stored
+ * into the cache.
  *//*--------------------------------------------------------------------*/
 void CompressedTexture::decompress (const tcu::PixelBufferAccess& dst, const DecompressionParams& params) const
 {
 	DE_ASSERT(dst.getWidth() == m_width && dst.getHeight() == m_height && dst.getDepth() == 1);
 	DE_ASSERT(dst.getFormat() == getUncompressedFormat());
 
-	if (isEtcFormat(m_format))
+	if (isASTCFormat(m_format) && getASTCBlockSize(m_format).z() > 1)
+		throw tcu::InternalError("3D ASTC textures not currently supported");
+
+	if (m_width == 0 || m_height == 0)
+		return;
+
+	const bool		isASTCModeLDR	= isASTCFormat(m_format) && params.isASTCModeLDR;
+	const IVec2		blockSize		= isASTCFormat(m_format) ? getASTCBlockSize(m_format).swizzle(0, 1) : IVec2(4, 4);
+	const int		numBlocks		= divRoundUp(m_width, blockSize.x()) * divRoundUp(m_height, blockSize.y());
+
+	if (params.cache && params.cache->lookup(*this, isASTCModeLDR, dst))
+		return;
+
 	{
-		switch (m_format)
+		SharedWorkerPool	pool		(de::min(divRoundUp(m_height, blockSize.y()), numBlocks / MIN_DECOMPRESS_BLOCKS_PER_BAND));
+		const int			numBands	= pool.getNumWorkers();
+
+		if (numBands > 1)
 		{
-			case ETC1_RGB8:							decompressETC1								(dst, m_width, m_height, &m_data[0]);			break;
-			case EAC_R11:							decompressEAC_R11							(dst, m_width, m_height, &m_data[0], false);	break;
-			case EAC_SIGNED_R11:					decompressEAC_R11							(dst, m_width, m_height, &m_data[0], true);		break;
-			case EAC_RG11:							decompressEAC_RG11							(dst, m_width, m_height, &m_data[0], false);	break;
-			case EAC_SIGNED_RG11:					decompressEAC_RG11							(dst, m_width, m_height, &m_data[0], true);		break;
-			case ETC2_RGB8:							decompressETC2								(dst, m_width, m_height, &m_data[0]);			break;
-			case ETC2_SRGB8:						decompressETC2								(dst, m_width, m_height, &m_data[0]);			break;
-			case ETC2_RGB8_PUNCHTHROUGH_ALPHA1:		decompressETC2_RGB8_PUNCHTHROUGH_ALPHA1		(dst, m_width, m_height, &m_data[0]);			break;
-			case ETC2_SRGB8_PUNCHTHROUGH_ALPHA1:	decompressETC2_RGB8_PUNCHTHROUGH_ALPHA1		(dst, m_width, m_height, &m_data[0]);			break;
-			case ETC2_EAC_RGBA8:					decompressETC2_EAC_RGBA8					(dst, m_width, m_height, &m_data[0]);			break;
-			case ETC2_EAC_SRGB8_ALPHA8:				decompressETC2_EAC_RGBA8					(dst, m_width, m_height, &m_data[0]);			break;
+			DecompressBandJob job (m_format, dst, &m_data[0], (int)m_data.size(), blockSize.y(), numBands, isASTCModeLDR);
 
-			default:
-				DE_ASSERT(false);
-				break;
+			pool.execute(job, numBands);
+			job.throwIfError();
 		}
+		else
+			decompressBlocks(m_format, dst, m_width, m_height, &m_data[0], isASTCModeLDR);
 	}
-	else if (isASTCFormat(m_format))
+
+	if (params.cache)
+		params.cache->insert(*this, isASTCModeLDR, dst);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Compressed texture decoding self-test
+ *
+ * Checks that decoding in bands of block rows gives the same result and
+ * error as decoding the whole level at once, for each format, and that
+ * DecompressionCache only returns levels decoded from identical data.
+ *//*--------------------------------------------------------------------*/
+void CompressedTexture_selfTest (void)
+{
+	de::Random		rnd		(0x7ac4d1e3u);
+	de::WorkerPool	pool	(3);
+
+	// Banded decoding, with random data to cover also error blocks.
+	for (int formatNdx = 0; formatNdx < CompressedTexture::FORMAT_LAST; formatNdx++)
+	for (int isASTCModeLDR = 0; isASTCModeLDR < 2; isASTCModeLDR++)
 	{
-		const tcu::IVec3	blockSize		= getASTCBlockSize(m_format);
-		const bool			isSRGBFormat	= isASTCSRGBFormat(m_format);
+		const CompressedTexture::Format	format			= (CompressedTexture::Format)formatNdx;
 
-		if (blockSize.z() > 1)
-			throw tcu::InternalError("3D ASTC textures not currently supported");
+		if (isASTCModeLDR && !isASTCFormat(format))
+			continue;
+
+		CompressedTexture				texture			(format, 37, 29);
+		const int						blockHeight		= isASTCFormat(format) ? getASTCBlockSize(format).y() : 4;
+		const int						numBlockRows	= divRoundUp(texture.getHeight(), blockHeight);
+		const int						numBands[]		= { 2, 3, 7 };
+		TextureLevel					reference		(texture.getUncompressedFormat(), texture.getWidth(), texture.getHeight());
+		std::string						referenceError;
+
+		for (int ndx = 0; ndx < texture.getDataSize(); ndx++)
+			((deUint8*)texture.getData())[ndx] = rnd.getUint8();
+
+		// \note Overflow in ETC1 differential mode is undefined, use individual mode only.
+		if (format == CompressedTexture::ETC1_RGB8)
+		{
+			for (int blockNdx = 0; blockNdx < texture.getDataSize()/8; blockNdx++)
+				((deUint8*)texture.getData())[blockNdx*8 + 3] &= ~0x02u;
+		}
 
-		decompressASTC(dst, m_width, m_height, &m_data[0], blockSize.x(), blockSize.y(), isSRGBFormat, isSRGBFormat || params.isASTCModeLDR);
+		try
+		{
+			decompressBlocks(format, reference.getAccess(), texture.getWidth(), texture.getHeight(), (const deUint8*)texture.getData(), isASTCModeLDR != 0);
+		}
+		catch (const tcu::InternalError& e)
+		{
+			referenceError = e.getMessage();
+		}
+
+		for (int bandNdx = 0; bandNdx < DE_LENGTH_OF_ARRAY(numBands); bandNdx++)
+		{
+			const int			curNumBands	= de::min(numBands[bandNdx], numBlockRows);
+			TextureLevel		result		(texture.getUncompressedFormat(), texture.getWidth(), texture.getHeight());
+			DecompressBandJob	job			(format, result.getAccess(), (const deUint8*)texture.getData(), texture.getDataSize(), blockHeight, curNumBands, isASTCModeLDR != 0);
+			std::string			error;
+
+			pool.execute(job, curNumBands);
+
+			try
+			{
+				job.throwIfError();
+			}
+			catch (const tcu::InternalError& e)
+			{
+				error = e.getMessage();
+			}
+
+			DE_TEST_ASSERT(error == referenceError);
+
+			if (referenceError.empty())
+				DE_TEST_ASSERT(deMemCmp(result.getAccess().getDataPtr(), reference.getAccess().getDataPtr(),
+										texture.getWidth()*texture.getHeight()*reference.getFormat().getPixelSize()) == 0);
+		}
+	}
+
+	// Cache.
+	{
+		const CompressedTexture::Format	format		= CompressedTexture::ETC2_EAC_RGBA8;
+		const int						size		= 16;
+		const int						entrySize	= (size/4)*(size/4)*16 + size*size*4;
+		DecompressionCache				cache		(2*entrySize);
+		CompressedTexture				textures[3];
+
+		for (int texNdx = 0; texNdx < DE_LENGTH_OF_ARRAY(textures); texNdx++)
+		{
+			textures[texNdx].setStorage(format, size, size);
+
+			for (int ndx = 0; ndx < textures[texNdx].getDataSize(); ndx++)
+				((deUint8*)textures[texNdx].getData())[ndx] = rnd.getUint8();
+		}
+
+		// Differs from first texture only in last byte.
+		deMemcpy(textures[1].getData(), textures[0].getData(), textures[0].getDataSize() - 1);
+
+		for (int texNdx = 0; texNdx < DE_LENGTH_OF_ARRAY(textures); texNdx++)
+		{
+			const CompressedTexture&	texture		= textures[texNdx];
+			TextureLevel				reference	(texture.getUncompressedFormat(), size, size);
+			TextureLevel				result		(texture.getUncompressedFormat(), size, size);
+
+			texture.decompress(reference.getAccess());
+
+			// First call decodes, second one comes from cache.
+			for (int callNdx = 0; callNdx < 2; callNdx++)
+			{
+				tcu::clear(result.getAccess(), Vec4(0.0f));
+				texture.decompress(result.getAccess(), CompressedTexture::DecompressionParams(false, &cache));
+
+				DE_TEST_ASSERT(deMemCmp(result.getAccess().getDataPtr(), reference.getAccess().getDataPtr(), size*size*4) == 0);
+				DE_TEST_ASSERT(cache.getNumEntries() == de::min(texNdx+1, 2));
+			}
+		}
+
+		// First texture has been evicted.
+		{
+			TextureLevel result (textures[0].getUncompressedFormat(), size, size);
+
+			DE_TEST_ASSERT(cache.getTotalSize() == 2*entrySize);
+			DE_TEST_ASSERT(!cache.lookup(textures[0], false, result.getAccess()));
+			DE_TEST_ASSERT(cache.lookup(textures[2], false, result.getAccess()));
+		}
 	}
-	else
-		DE_ASSERT(false);
 }
 
 } // tcu
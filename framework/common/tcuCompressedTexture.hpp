@@ -25,12 +25,17 @@
 
 #include "tcuDefs.hpp"
 #include "tcuTexture.hpp"
+#include "deMutex.hpp"
 
 #include <vector>
+#include <list>
+#include <map>
 
 namespace tcu
 {
 
+class DecompressionCache;
+
 /*--------------------------------------------------------------------*//*!
  * \brief Compressed texture
  *
@@ -88,9 +93,10 @@ public:
 
 	struct DecompressionParams
 	{
-		bool isASTCModeLDR; //!< \note Ignored if not ASTC format.
+		bool				isASTCModeLDR;	//!< \note Ignored if not ASTC format.
+		DecompressionCache*	cache;			//!< Optional cache of decoded levels, owned by caller.
 
-		DecompressionParams (bool isASTCModeLDR_) : isASTCModeLDR(isASTCModeLDR_) {}
+		DecompressionParams (bool isASTCModeLDR_, DecompressionCache* cache_ = DE_NULL) : isASTCModeLDR(isASTCModeLDR_), cache(cache_) {}
 	};
 
 
@@ -118,6 +124,49 @@ private:
 	std::vector<deUint8>	m_data;
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Cache of decoded compressed texture levels
+ *
+ * Test cases that decode the same compressed data several times can pass
+ * a cache in CompressedTexture::DecompressionParams to decode it only once.
+ * TestContext::getDecompressionCache() returns a cache shared by all cases.
+ * Levels are looked up by hash of compressed data, and the data is compared
+ * in full on hit. Oldest entries are evicted first once the total size of
+ * cached data would exceed maxTotalSize. Cache can be shared between threads.
+ *//*--------------------------------------------------------------------*/
+class DecompressionCache
+{
+public:
+	enum
+	{
+		DEFAULT_MAX_TOTAL_SIZE	= 64<<20	//!< Default max total size of compressed and decoded data in bytes.
+	};
+
+	explicit				DecompressionCache			(int maxTotalSize = DEFAULT_MAX_TOTAL_SIZE);
+							~DecompressionCache			(void);
+
+	bool					lookup						(const CompressedTexture& texture, bool isASTCModeLDR, const PixelBufferAccess& dst);
+	void					insert						(const CompressedTexture& texture, bool isASTCModeLDR, const ConstPixelBufferAccess& decoded);
+
+	int						getNumEntries				(void) const;
+	int						getTotalSize				(void) const;
+
+private:
+							DecompressionCache			(const DecompressionCache&);
+	DecompressionCache&		operator=					(const DecompressionCache&);
+
+	struct Entry;
+	typedef std::multimap<deUint32, Entry*> EntryMap;
+
+	void					evictOldest					(void);
+
+	const int				m_maxTotalSize;
+	mutable de::Mutex		m_lock;
+	std::list<Entry*>		m_entries;					//!< Oldest entry first.
+	EntryMap				m_entriesByHash;
+	int						m_totalSize;
+};
+
 bool						isEtcFormat					(CompressedTexture::Format fmt);
 bool						isASTCFormat				(CompressedTexture::Format fmt);
 bool						isASTCSRGBFormat			(CompressedTexture::Format fmt);
@@ -125,6 +174,8 @@ bool						isASTCSRGBFormat			(CompressedTexture::Format fmt);
 IVec3						getASTCBlockSize			(CompressedTexture::Format fmt);
 CompressedTexture::Format	getASTCFormatByBlockSize	(int width, int height, int depth, bool isSRGB);
 
+void						CompressedTexture_selfTest	(void);
+
 } // tcu
 
 #endif // _TCUCOMPRESSEDTEXTURE_HPP
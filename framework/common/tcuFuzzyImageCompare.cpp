@@ -24,6 +24,7 @@
 #include "tcuFuzzyImageCompare.hpp"
 #include "tcuTexture.hpp"
 #include "tcuTextureUtil.hpp"
+#include "tcuWorkerPool.hpp"
 #include "deMath.h"
 #include "deRandom.hpp"
 
@@ -50,21 +51,11 @@ static inline deUint32 setChannel (deUint32 color, int channel, deUint8 val)
 	return (color & ~(0xffu << (8*channel))) | (val << (8*channel));
 }
 
-static inline Vec4 toFloatVec (deUint32 color)
-{
-	return Vec4((float)getChannel<0>(color), (float)getChannel<1>(color), (float)getChannel<2>(color), (float)getChannel<3>(color));
-}
-
 static inline deUint8 roundToUint8Sat (float v)
 {
 	return (deUint8)de::clamp((int)(v + 0.5f), 0, 255);
 }
 
-static inline deUint32 toColor (Vec4 v)
-{
-	return roundToUint8Sat(v[0]) | (roundToUint8Sat(v[1]) << 8) | (roundToUint8Sat(v[2]) << 16) | (roundToUint8Sat(v[3]) << 24);
-}
-
 template<int NumChannels>
 static inline deUint32 readUnorm8 (const tcu::ConstPixelBufferAccess& src, int x, int y)
 {
@@ -88,23 +79,6 @@ inline deUint32 readUnorm8<4> (const tcu::ConstPixelBufferAccess& src, int x, in
 }
 #endif
 
-template<int NumChannels>
-static inline void writeUnorm8 (const tcu::PixelBufferAccess& dst, int x, int y, deUint32 val)
-{
-	deUint8* ptr = (deUint8*)dst.getDataPtr() + dst.getRowPitch()*y + x*NumChannels;
-
-	for (int c = 0; c < NumChannels; c++)
-		ptr[c] = getChannel(val, c);
-}
-
-#if (DE_ENDIANNESS == DE_LITTLE_ENDIAN)
-template<>
-inline void writeUnorm8<4> (const tcu::PixelBufferAccess& dst, int x, int y, deUint32 val)
-{
-	*(deUint32*)((deUint8*)dst.getDataPtr() + dst.getRowPitch()*y + x*4) = val;
-}
-#endif
-
 static inline float compareColors (deUint32 pa, deUint32 pb, int minErrThreshold)
 {
 	int r = de::max<int>(de::abs((int)getChannel<0>(pa) - (int)getChannel<0>(pb)) - minErrThreshold, 0);
@@ -156,93 +130,256 @@ inline deUint32 bilinearSample (const ConstPixelBufferAccess& src, float u, floa
 	return dst;
 }
 
-template<int DstChannels, int SrcChannels>
-static void separableConvolve (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src, int shiftX, int shiftY, const std::vector<float>& kernelX, const std::vector<float>& kernelY)
+enum
 {
-	DE_ASSERT(dst.getWidth() == src.getWidth() && dst.getHeight() == src.getHeight());
+	MIN_PIXELS_PER_WORKER	= 32*1024	//!< Smaller images are processed on calling thread.
+};
 
-	TextureLevel		tmp			(dst.getFormat(), dst.getHeight(), dst.getWidth());
-	PixelBufferAccess	tmpAccess	= tmp.getAccess();
-
-	int kw = (int)kernelX.size();
-	int kh = (int)kernelY.size();
+/*--------------------------------------------------------------------*//*!
+ * \brief Convolve packed pixels
+ *
+ * dst[i] = sum of taps[k][i]*weights[k] for all k. Taps point to packed
+ * SrcChannels-channel UNORM8 pixels and missing alpha reads as 1.0. dst is
+ * packed RGBA8. Sums are accumulated one tap at a time into sum, which
+ * must have room for numPixels*4 floats.
+ *//*--------------------------------------------------------------------*/
+template<int SrcChannels>
+static void convolvePixels (deUint8* dst, float* sum, const deUint8* const* taps, const float* weights, int numTaps, int numPixels)
+{
+	for (int i = 0; i < numPixels*4; i++)
+		sum[i] = 0.0f;
 
-	// Horizontal pass
-	// \note Temporary surface is written in column-wise order
-	for (int j = 0; j < src.getHeight(); j++)
+	for (int k = 0; k < numTaps; k++)
 	{
-		for (int i = 0; i < src.getWidth(); i++)
-		{
-			Vec4 sum(0);
+		const deUint8* const	src		= taps[k];
+		const float				weight	= weights[k];
 
-			for (int kx = 0; kx < kw; kx++)
+		if (SrcChannels == 4)
+		{
+			for (int i = 0; i < numPixels*4; i++)
+				sum[i] += (float)src[i] * weight;
+		}
+		else
+		{
+			for (int i = 0; i < numPixels; i++)
 			{
-				float		f = kernelX[kw-kx-1];
-				deUint32	p = readUnorm8<SrcChannels>(src, de::clamp(i+kx-shiftX, 0, src.getWidth()-1), j);
-
-				sum += toFloatVec(p)*f;
+				for (int c = 0; c < 4; c++)
+					sum[i*4 + c] += (float)(c < SrcChannels ? src[i*SrcChannels + c] : 0xff) * weight;
 			}
-
-			writeUnorm8<DstChannels>(tmpAccess, j, i, toColor(sum));
 		}
 	}
 
-	// Vertical pass
-	for (int j = 0; j < src.getHeight(); j++)
+	for (int i = 0; i < numPixels*4; i++)
+		dst[i] = roundToUint8Sat(sum[i]);
+}
+
+template<int SrcChannels>
+static void convolvePixelClamped (deUint8* dst, float* sum, const deUint8* src, int width, int x, int shift, const vector<float>& weights, vector<const deUint8*>& taps)
+{
+	for (int k = 0; k < (int)weights.size(); k++)
+		taps[k] = src + de::clamp(x + k - shift, 0, width-1)*SrcChannels;
+
+	convolvePixels<SrcChannels>(dst + x*4, sum, &taps[0], &weights[0], (int)weights.size(), 1);
+}
+
+template<int SrcChannels>
+static void convolveRowHorizontal (deUint8* dst, float* sum, const deUint8* src, int width, int shift, const vector<float>& weights)
+{
+	const int				numTaps		= (int)weights.size();
+	const int				interiorX0	= de::min(shift, width);
+	const int				interiorX1	= de::max(interiorX0, width - (numTaps - 1 - shift));
+	vector<const deUint8*>	taps		(numTaps);
+
+	for (int x = 0; x < interiorX0; x++)
+		convolvePixelClamped<SrcChannels>(dst, sum, src, width, x, shift, weights, taps);
+
+	// No clamping needed in interior, convolve it at once.
+	if (interiorX0 < interiorX1)
 	{
-		for (int i = 0; i < src.getWidth(); i++)
-		{
-			Vec4 sum(0.0f);
+		for (int k = 0; k < numTaps; k++)
+			taps[k] = src + (interiorX0 + k - shift)*SrcChannels;
 
-			for (int ky = 0; ky < kh; ky++)
-			{
-				float		f = kernelY[kh-ky-1];
-				deUint32	p = readUnorm8<DstChannels>(tmpAccess, de::clamp(j+ky-shiftY, 0, tmp.getWidth()-1), i);
+		convolvePixels<SrcChannels>(dst + interiorX0*4, sum, &taps[0], &weights[0], numTaps, interiorX1 - interiorX0);
+	}
 
-				sum += toFloatVec(p)*f;
-			}
+	for (int x = interiorX1; x < width; x++)
+		convolvePixelClamped<SrcChannels>(dst, sum, src, width, x, shift, weights, taps);
+}
 
-			writeUnorm8<DstChannels>(dst, i, j, toColor(sum));
-		}
+static inline deUint32 computeSqDiff (const deUint8* a, const deUint8* b, int minErrThreshold)
+{
+	deUint32 sqDiff = 0;
+
+	for (int c = 0; c < 4; c++)
+	{
+		const int d = de::max<int>(de::abs((int)a[c] - (int)b[c]) - minErrThreshold, 0);
+		sqDiff += (deUint32)(d*d);
 	}
+
+	return sqDiff;
 }
 
-template<int NumChannels>
-static float compareToNeighbor (const FuzzyCompareParams& params, de::Random& rnd, deUint32 pixel, const ConstPixelBufferAccess& surface, int x, int y)
+//! Smallest squared thresholded color difference between each pixel of a and its 3x3 neighborhood in b. Packed RGBA8 rows, edge pixels are skipped.
+static void computeNeighborhoodSqDiffRow (deUint32* dst, const deUint8* a, const deUint8* const* bRows, int width, int minErrThreshold)
 {
-	float minErr = +100.f;
+	for (int x = 1; x < width-1; x++)
+	{
+		// Matching center is the common case, check it first.
+		deUint32 minSqDiff = computeSqDiff(a + x*4, bRows[1] + x*4, minErrThreshold);
 
-	// (x, y) + (0, 0)
-	minErr = deFloatMin(minErr, compareColors(pixel, readUnorm8<NumChannels>(surface, x, y), params.minErrThreshold));
-	if (minErr == 0.0f)
-		return minErr;
+		for (int dy = 0; dy < 3 && minSqDiff != 0; dy++)
+		{
+			for (int dx = -1; dx <= 1; dx++)
+				minSqDiff = de::min(minSqDiff, computeSqDiff(a + x*4, bRows[dy] + (x+dx)*4, minErrThreshold));
+		}
+
+		dst[x] = minSqDiff;
+	}
+}
 
-	// Area around (x, y)
-	static const int s_coords[][2] =
+/*--------------------------------------------------------------------*//*!
+ * \brief Row-parallel preprocessing for fuzzy compare
+ *
+ * Blurs both images with a separable kernel and computes for each pixel the
+ * smallest color difference to the 3x3 neighborhood in the other image.
+ * These don't depend on random sampling, so rows are processed in
+ * parallel in three passes. Random sampling remains sequential.
+ *//*--------------------------------------------------------------------*/
+class FuzzyCompareRowJob : public de::WorkerPool::Job
+{
+public:
+	enum Pass
 	{
-		{-1, -1},
-		{ 0, -1},
-		{+1, -1},
-		{-1,  0},
-		{+1,  0},
-		{-1, +1},
-		{ 0, +1},
-		{+1, +1}
+		PASS_HORIZONTAL = 0,	//!< Horizontal blur of source images into temporary images
+		PASS_VERTICAL,			//!< Vertical blur of temporary images into filtered images
+		PASS_NEIGHBORHOOD,		//!< Neighborhood differences of filtered images
+
+		PASS_LAST
 	};
 
-	for (int d = 0; d < (int)DE_LENGTH_OF_ARRAY(s_coords); d++)
+	FuzzyCompareRowJob (const ConstPixelBufferAccess& ref, const ConstPixelBufferAccess& cmp, const vector<float>& kernel, int minErrThreshold)
+		: m_width				(ref.getWidth())
+		, m_height				(ref.getHeight())
+		, m_shift				((int)(kernel.size() - 1) / 2)
+		, m_minErrThreshold		(minErrThreshold)
+		, m_weights				(kernel.rbegin(), kernel.rend())
+		, m_pool				((int)de::min<deInt64>(m_height, (deInt64)m_width*m_height / MIN_PIXELS_PER_WORKER))
+		, m_numWorkers			(m_pool.getNumWorkers())
+		, m_sumRows				(m_numWorkers, vector<float>(de::max(m_width, 1)*4))
+		, m_pass				(PASS_LAST)
 	{
-		int dx = x + s_coords[d][0];
-		int dy = y + s_coords[d][1];
+		const TextureFormat format (TextureFormat::RGBA, TextureFormat::UNORM_INT8);
 
-		if (!deInBounds32(dx, 0, surface.getWidth()) || !deInBounds32(dy, 0, surface.getHeight()))
-			continue;
+		m_src[0] = ref;
+		m_src[1] = cmp;
 
-		minErr = deFloatMin(minErr, compareColors(pixel, readUnorm8<NumChannels>(surface, dx, dy), params.minErrThreshold));
-		if (minErr == 0.0f)
-			return minErr;
+		for (int ndx = 0; ndx < 2; ndx++)
+		{
+			m_tmp[ndx].setStorage(format, m_width, m_height);
+			m_filtered[ndx].setStorage(format, m_width, m_height);
+			m_neighborhoodSqDiff[ndx].resize(m_width*m_height);
+		}
+	}
+
+	void run (void)
+	{
+		for (int pass = 0; pass < PASS_LAST; pass++)
+		{
+			m_pass = (Pass)pass;
+			m_pool.execute(*this, m_height);
+		}
 	}
 
+	void execute (int y, int workerNdx)
+	{
+		float* const sum = &m_sumRows[workerNdx][0];
+
+		for (int ndx = 0; ndx < 2; ndx++)
+		{
+			switch (m_pass)
+			{
+				case PASS_HORIZONTAL:
+				{
+					const deUint8*	src	= getRowPtr(m_src[ndx], y);
+					deUint8*		dst	= getRowPtr(m_tmp[ndx].getAccess(), y);
+
+					if (m_src[ndx].getFormat().order == TextureFormat::RGBA)
+						convolveRowHorizontal<4>(dst, sum, src, m_width, m_shift, m_weights);
+					else
+						convolveRowHorizontal<3>(dst, sum, src, m_width, m_shift, m_weights);
+					break;
+				}
+
+				case PASS_VERTICAL:
+				{
+					const int				numTaps	= (int)m_weights.size();
+					vector<const deUint8*>	taps	(numTaps);
+
+					for (int k = 0; k < numTaps; k++)
+						taps[k] = getRowPtr(m_tmp[ndx].getAccess(), de::clamp(y + k - m_shift, 0, m_height-1));
+
+					convolvePixels<4>(getRowPtr(m_filtered[ndx].getAccess(), y), sum, &taps[0], &m_weights[0], numTaps, m_width);
+					break;
+				}
+
+				case PASS_NEIGHBORHOOD:
+				{
+					if (y > 0 && y < m_height-1)
+					{
+						const ConstPixelBufferAccess	other		= m_filtered[1-ndx].getAccess();
+						const deUint8* const			rows[]		= { getRowPtr(other, y-1), getRowPtr(other, y), getRowPtr(other, y+1) };
+
+						computeNeighborhoodSqDiffRow(&m_neighborhoodSqDiff[ndx][y*m_width], getRowPtr(m_filtered[ndx].getAccess(), y), rows, m_width, m_minErrThreshold);
+					}
+					break;
+				}
+
+				default:
+					DE_ASSERT(false);
+			}
+		}
+	}
+
+	ConstPixelBufferAccess	getFilteredRef				(void) const		{ return m_filtered[0].getAccess();	}
+	ConstPixelBufferAccess	getFilteredCmp				(void) const		{ return m_filtered[1].getAccess();	}
+
+	//! Smallest squared difference of filtered reference pixel to 3x3 neighborhood in filtered result.
+	deUint32				getRefNeighborhoodSqDiff	(int x, int y) const	{ return m_neighborhoodSqDiff[0][y*m_width + x];	}
+	//! Smallest squared difference of filtered result pixel to 3x3 neighborhood in filtered reference.
+	deUint32				getCmpNeighborhoodSqDiff	(int x, int y) const	{ return m_neighborhoodSqDiff[1][y*m_width + x];	}
+
+private:
+	static const deUint8*	getRowPtr	(const ConstPixelBufferAccess& access, int y)	{ return (const deUint8*)access.getDataPtr() + access.getRowPitch()*y;	}
+	static deUint8*			getRowPtr	(const PixelBufferAccess& access, int y)		{ return (deUint8*)access.getDataPtr() + access.getRowPitch()*y;		}
+
+	const int				m_width;
+	const int				m_height;
+	const int				m_shift;
+	const int				m_minErrThreshold;
+	const vector<float>		m_weights;			//!< Kernel in reverse order, i.e. weight of each tap.
+	SharedWorkerPool		m_pool;
+	const int				m_numWorkers;
+	vector<vector<float> >	m_sumRows;			//!< Per-worker convolution sums.
+
+	ConstPixelBufferAccess	m_src[2];
+	TextureLevel			m_tmp[2];
+	TextureLevel			m_filtered[2];
+	vector<deUint32>		m_neighborhoodSqDiff[2];
+
+	Pass					m_pass;
+};
+
+template<int NumChannels>
+static float compareToNeighbor (const FuzzyCompareParams& params, de::Random& rnd, deUint32 neighborhoodSqDiff, deUint32 pixel, const ConstPixelBufferAccess& surface, int x, int y)
+{
+	// (x, y) and area around it
+	// \note Square root is monotonic, so taking it from the smallest squared difference gives the smallest error.
+	const float	scale	= 1.0f/(255-params.minErrThreshold);
+	float		minErr	= deFloatMin(+100.f, deFloatSqrt((float)neighborhoodSqDiff * (scale*scale)));
+
+	if (minErr == 0.0f)
+		return minErr;
+
 	// Random bilinear-interpolated samples around (x, y)
 	for (int s = 0; s < 32; s++)
 	{
@@ -281,30 +418,13 @@ float fuzzyCompare (const FuzzyCompareParams& params, const ConstPixelBufferAcce
 	int			height	= ref.getHeight();
 	de::Random	rnd		(667);
 
-	// Filtered
-	TextureLevel refFiltered(TextureFormat(TextureFormat::RGBA, TextureFormat::UNORM_INT8), width, height);
-	TextureLevel cmpFiltered(TextureFormat(TextureFormat::RGBA, TextureFormat::UNORM_INT8), width, height);
-
 	// Kernel = {0.15, 0.7, 0.15}
 	vector<float> kernel(3);
 	kernel[0] = kernel[2] = 0.1f; kernel[1]= 0.8f;
-	int shift = (int)(kernel.size() - 1) / 2;
 
-	switch (ref.getFormat().order)
-	{
-		case TextureFormat::RGBA:	separableConvolve<4, 4>(refFiltered, ref, shift, shift, kernel, kernel);	break;
-		case TextureFormat::RGB:	separableConvolve<4, 3>(refFiltered, ref, shift, shift, kernel, kernel);	break;
-		default:
-			DE_ASSERT(DE_FALSE);
-	}
-
-	switch (cmp.getFormat().order)
-	{
-		case TextureFormat::RGBA:	separableConvolve<4, 4>(cmpFiltered, cmp, shift, shift, kernel, kernel);	break;
-		case TextureFormat::RGB:	separableConvolve<4, 3>(cmpFiltered, cmp, shift, shift, kernel, kernel);	break;
-		default:
-			DE_ASSERT(DE_FALSE);
-	}
+	// Filter and compare to neighborhoods
+	FuzzyCompareRowJob rowJob (ref, cmp, kernel, params.minErrThreshold);
+	rowJob.run();
 
 	int		numSamples	= 0;
 	float	errSum		= 0.0f;
@@ -312,15 +432,15 @@ float fuzzyCompare (const FuzzyCompareParams& params, const ConstPixelBufferAcce
 	// Clear error mask to green.
 	clear(errorMask, Vec4(0.0f, 1.0f, 0.0f, 1.0f));
 
-	ConstPixelBufferAccess refAccess = refFiltered.getAccess();
-	ConstPixelBufferAccess cmpAccess = cmpFiltered.getAccess();
+	ConstPixelBufferAccess refAccess = rowJob.getFilteredRef();
+	ConstPixelBufferAccess cmpAccess = rowJob.getFilteredCmp();
 
 	for (int y = 1; y < height-1; y++)
 	{
 		for (int x = 1; x < width-1; x += params.maxSampleSkip > 0 ? (int)rnd.getInt(0, params.maxSampleSkip) : 1)
 		{
-			float err = deFloatMin(compareToNeighbor<4>(params, rnd, readUnorm8<4>(refAccess, x, y), cmpAccess, x, y),
-								   compareToNeighbor<4>(params, rnd, readUnorm8<4>(cmpAccess, x, y), refAccess, x, y));
+			float err = deFloatMin(compareToNeighbor<4>(params, rnd, rowJob.getRefNeighborhoodSqDiff(x, y), readUnorm8<4>(refAccess, x, y), cmpAccess, x, y),
+								   compareToNeighbor<4>(params, rnd, rowJob.getCmpNeighborhoodSqDiff(x, y), readUnorm8<4>(cmpAccess, x, y), refAccess, x, y));
 
 			err = deFloatPow(err, params.errExp);
 
@@ -31,7 +31,11 @@
 #include "tcuRGBA.hpp"
 #include "tcuTexture.hpp"
 #include "tcuTextureUtil.hpp"
+#include "tcuWorkerPool.hpp"
+#include "deRandom.hpp"
+#include "deMemory.h"
 
+#include <vector>
 #include <string.h>
 
 namespace tcu
@@ -87,92 +91,653 @@ void computeScaleAndBias (const ConstPixelBufferAccess& reference, const ConstPi
 	}
 }
 
-static int findNumPositionDeviationFailingPixels (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const tcu::IVec3& maxPositionDeviation, bool acceptOutOfBoundsAsAnyValue)
+enum
 {
-	const int	width				= reference.getWidth();
-	const int	height				= reference.getHeight();
-	const int	depth				= reference.getDepth();
-	int			numFailingPixels	= 0;
+	MIN_COMPARE_PIXELS_PER_WORKER	= 32*1024,	//!< Smaller images are compared on calling thread.
+	COMPARE_BANDS_PER_WORKER		= 4			//!< Bands are handed out dynamically, more bands than workers balances load.
+};
 
-	TCU_CHECK_INTERNAL(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
+inline bool isRGBA8Format (const TextureFormat& format)
+{
+	return format == TextureFormat(TextureFormat::RGBA, TextureFormat::UNORM_INT8);
+}
+
+inline const deUint8* getRowPtr (const ConstPixelBufferAccess& access, int y, int z)
+{
+	return (const deUint8*)access.getDataPtr() + z*access.getSlicePitch() + y*access.getRowPitch();
+}
+
+inline deUint8* getRowPtr (const PixelBufferAccess& access, int y, int z)
+{
+	return (deUint8*)access.getDataPtr() + z*access.getSlicePitch() + y*access.getRowPitch();
+}
+
+//! Set error mask pixel. Error masks are always RGB UNORM_INT8.
+inline void setMaskPixel (deUint8* dst, bool isOk)
+{
+	dst[0] = isOk ? 0x00 : 0xff;
+	dst[1] = isOk ? 0xff : 0x00;
+	dst[2] = 0x00;
+}
+
+inline bool isWithinThreshold (const IVec4& a, const IVec4& b, const UVec4& threshold)
+{
+	const UVec4 diff = abs(a - b).cast<deUint32>();
+	return boolAll(lessThanEqual(diff, threshold));
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Row-parallel image compare job
+ *
+ * Rows of all slices are split into contiguous bands that are compared on
+ * the shared worker pool. Jobs accumulate results per band and combine them in band
+ * order afterwards, so that results don't depend on scheduling. Small
+ * images are compared on the calling thread.
+ *
+ * Row kernels work on whole rows of pixels: RGBA8 data is used directly
+ * and other formats are converted with readRow() into per-worker scratch
+ * rows first.
+ *//*--------------------------------------------------------------------*/
+class RowCompareJob : public de::WorkerPool::Job
+{
+public:
+	RowCompareJob (int width, int height, int depth)
+		: m_width		(width)
+		, m_height		(height)
+		, m_numRows		(height*depth)
+		, m_pool		((int)de::min<deInt64>(m_numRows, (deInt64)width*m_numRows / MIN_COMPARE_PIXELS_PER_WORKER))
+		, m_numWorkers	(m_pool.getNumWorkers())
+		, m_numBands	(m_numWorkers > 1 ? de::min(m_numWorkers*COMPARE_BANDS_PER_WORKER, m_numRows) : 1)
+	{
+	}
+
+	void run (void)
+	{
+		m_pool.execute(*this, m_numBands);
+	}
 
-	for (int z = 0; z < depth; z++)
+	void execute (int bandNdx, int workerNdx)
 	{
-		for (int y = 0; y < height; y++)
+		const int firstRow	= bandNdx*m_numRows / m_numBands;
+		const int endRow	= (bandNdx+1)*m_numRows / m_numBands;
+
+		for (int rowNdx = firstRow; rowNdx < endRow; rowNdx++)
+			compareRow(bandNdx, workerNdx, rowNdx % m_height, rowNdx / m_height);
+	}
+
+protected:
+	virtual void	compareRow	(int bandNdx, int workerNdx, int y, int z) = 0;
+
+	const int			m_width;
+	const int			m_height;
+	const int			m_numRows;
+	SharedWorkerPool	m_pool;
+	const int			m_numWorkers;
+	const int			m_numBands;
+};
+
+//! Per-channel integer threshold compare of a row of RGBA values.
+template<typename T>
+void intThresholdCompareRow (deUint8* mask, const T* ref, const T* cmp, int width, const UVec4& threshold, UVec4& maxDiff)
+{
+	const deUint32	thr[4]		= { threshold[0], threshold[1], threshold[2], threshold[3] };
+	deUint32		rowMax[4]	= { maxDiff[0], maxDiff[1], maxDiff[2], maxDiff[3] };
+
+	for (int x = 0; x < width; x++)
+	{
+		bool isOk = true;
+
+		for (int c = 0; c < 4; c++)
+		{
+			const deUint32 diff = (deUint32)de::abs((int)ref[x*4+c] - (int)cmp[x*4+c]);
+
+			isOk		&= diff <= thr[c];
+			rowMax[c]	 = de::max(rowMax[c], diff);
+		}
+
+		setMaskPixel(mask + x*3, isOk);
+	}
+
+	maxDiff = UVec4(rowMax[0], rowMax[1], rowMax[2], rowMax[3]);
+}
+
+//! Per-channel float threshold compare of a row of RGBA values.
+void floatThresholdCompareRow (deUint8* mask, const float* ref, const float* cmp, int width, const Vec4& threshold, Vec4& maxDiff)
+{
+	const float	thr[4]		= { threshold[0], threshold[1], threshold[2], threshold[3] };
+	float		rowMax[4]	= { maxDiff[0], maxDiff[1], maxDiff[2], maxDiff[3] };
+
+	for (int x = 0; x < width; x++)
+	{
+		bool isOk = true;
+
+		for (int c = 0; c < 4; c++)
 		{
-			for (int x = 0; x < width; x++)
+			const float diff = de::abs(ref[x*4+c] - cmp[x*4+c]);
+
+			isOk		&= diff <= thr[c];
+			rowMax[c]	 = de::max(rowMax[c], diff);
+		}
+
+		setMaskPixel(mask + x*3, isOk);
+	}
+
+	maxDiff = Vec4(rowMax[0], rowMax[1], rowMax[2], rowMax[3]);
+}
+
+//! Per-channel ULP threshold compare of a row of RGBA values.
+void floatUlpThresholdCompareRow (deUint8* mask, const float* ref, const float* cmp, int width, const UVec4& threshold, UVec4& maxDiff)
+{
+	const deUint32	thr[4]		= { threshold[0], threshold[1], threshold[2], threshold[3] };
+	deUint32		rowMax[4]	= { maxDiff[0], maxDiff[1], maxDiff[2], maxDiff[3] };
+
+	for (int x = 0; x < width; x++)
+	{
+		bool isOk = true;
+
+		for (int c = 0; c < 4; c++)
+		{
+			deUint32 refBits;
+			deUint32 cmpBits;
+
+			// memcpy() is the way to do float->uint32 reinterpretation.
+			memcpy(&refBits, &ref[x*4+c], sizeof(deUint32));
+			memcpy(&cmpBits, &cmp[x*4+c], sizeof(deUint32));
+
 			{
-				const IVec4	refPix = reference.getPixelInt(x, y, z);
-				const IVec4	cmpPix = result.getPixelInt(x, y, z);
-
-				// Exact match
-				{
-					const UVec4	diff = abs(refPix - cmpPix).cast<deUint32>();
-					const bool	isOk = boolAll(lessThanEqual(diff, threshold));
-
-					if (isOk)
-					{
-						errorMask.setPixel(IVec4(0, 0xff, 0, 0xff), x, y, z);
-						continue;
-					}
-				}
-
-				// Accept over the image bounds pixels since they could be anything
-
-				if (acceptOutOfBoundsAsAnyValue &&
-					(x < maxPositionDeviation.x() || x + maxPositionDeviation.x() >= width  ||
-					 y < maxPositionDeviation.y() || y + maxPositionDeviation.y() >= height ||
-					 z < maxPositionDeviation.z() || z + maxPositionDeviation.z() >= depth))
-				{
-					errorMask.setPixel(IVec4(0, 0xff, 0, 0xff), x, y, z);
-					continue;
-				}
-
-				// Find matching pixels for both result and reference pixel
-
-				{
-					bool pixelFoundForReference = false;
-					bool pixelFoundForResult	= false;
-
-					// Find deviated result pixel for reference
-
-					for (int sz = de::max(0, z - maxPositionDeviation.z()); sz <= de::min(depth  - 1, z + maxPositionDeviation.z()) && !pixelFoundForReference; ++sz)
-					for (int sy = de::max(0, y - maxPositionDeviation.y()); sy <= de::min(height - 1, y + maxPositionDeviation.y()) && !pixelFoundForReference; ++sy)
-					for (int sx = de::max(0, x - maxPositionDeviation.x()); sx <= de::min(width  - 1, x + maxPositionDeviation.x()) && !pixelFoundForReference; ++sx)
-					{
-						const IVec4	deviatedCmpPix	= result.getPixelInt(sx, sy, sz);
-						const UVec4	diff			= abs(refPix - deviatedCmpPix).cast<deUint32>();
-						const bool	isOk			= boolAll(lessThanEqual(diff, threshold));
-
-						pixelFoundForReference		|= isOk;
-					}
-
-					// Find deviated reference pixel for result
-
-					for (int sz = de::max(0, z - maxPositionDeviation.z()); sz <= de::min(depth  - 1, z + maxPositionDeviation.z()) && !pixelFoundForResult; ++sz)
-					for (int sy = de::max(0, y - maxPositionDeviation.y()); sy <= de::min(height - 1, y + maxPositionDeviation.y()) && !pixelFoundForResult; ++sy)
-					for (int sx = de::max(0, x - maxPositionDeviation.x()); sx <= de::min(width  - 1, x + maxPositionDeviation.x()) && !pixelFoundForResult; ++sx)
-					{
-						const IVec4	deviatedRefPix	= reference.getPixelInt(sx, sy, sz);
-						const UVec4	diff			= abs(cmpPix - deviatedRefPix).cast<deUint32>();
-						const bool	isOk			= boolAll(lessThanEqual(diff, threshold));
-
-						pixelFoundForResult			|= isOk;
-					}
-
-					if (pixelFoundForReference && pixelFoundForResult)
-						errorMask.setPixel(IVec4(0, 0xff, 0, 0xff), x, y, z);
-					else
-					{
-						errorMask.setPixel(IVec4(0xff, 0, 0, 0xff), x, y, z);
-						++numFailingPixels;
-					}
-				}
+				const deUint32 diff = (deUint32)de::abs((int)refBits - (int)cmpBits);
+
+				isOk		&= diff <= thr[c];
+				rowMax[c]	 = de::max(rowMax[c], diff);
 			}
 		}
+
+		setMaskPixel(mask + x*3, isOk);
 	}
 
-	return numFailingPixels;
+	maxDiff = UVec4(rowMax[0], rowMax[1], rowMax[2], rowMax[3]);
+}
+
+//! Squared difference sum of a row of RGBA values. Difference mask is written to mask.
+template<typename T>
+deInt64 squaredDiffSumRow (deUint8* mask, const T* ref, const T* cmp, int width, int diffFactor)
+{
+	deInt64 diffSum = 0;
+
+	for (int x = 0; x < width; x++)
+	{
+		int sum		= 0;
+		int sqSum	= 0;
+
+		for (int c = 0; c < 4; c++)
+		{
+			const int diff = de::abs((int)ref[x*4+c] - (int)cmp[x*4+c]);
+
+			sum		+= diff;
+			sqSum	+= diff*diff;
+		}
+
+		mask[x*3+0] = (deUint8)deClamp32(sum*diffFactor, 0, 255);
+		mask[x*3+1] = (deUint8)deClamp32(255-sum*diffFactor, 0, 255);
+		mask[x*3+2] = 0;
+
+		diffSum += (deInt64)sqSum;
+	}
+
+	return diffSum;
+}
+
+class IntThresholdCompareJob : public RowCompareJob
+{
+public:
+	IntThresholdCompareJob (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold)
+		: RowCompareJob		(reference.getWidth(), reference.getHeight(), reference.getDepth())
+		, m_errorMask		(errorMask)
+		, m_reference		(reference)
+		, m_result			(result)
+		, m_threshold		(threshold)
+		, m_isRGBA8			(isRGBA8Format(reference.getFormat()) && isRGBA8Format(result.getFormat()))
+		, m_refRows			(m_isRGBA8 ? 0 : m_numWorkers, std::vector<IVec4>(de::max(m_width, 1)))
+		, m_cmpRows			(m_isRGBA8 ? 0 : m_numWorkers, std::vector<IVec4>(de::max(m_width, 1)))
+		, m_bandMaxDiff		(m_numBands, UVec4(0))
+	{
+	}
+
+	UVec4 getMaxDiff (void) const
+	{
+		UVec4 maxDiff (0);
+
+		for (int bandNdx = 0; bandNdx < m_numBands; bandNdx++)
+			maxDiff = max(maxDiff, m_bandMaxDiff[bandNdx]);
+
+		return maxDiff;
+	}
+
+protected:
+	void compareRow (int bandNdx, int workerNdx, int y, int z)
+	{
+		deUint8* const mask = getRowPtr(m_errorMask, y, z);
+
+		if (m_isRGBA8)
+			intThresholdCompareRow(mask, getRowPtr(m_reference, y, z), getRowPtr(m_result, y, z), m_width, m_threshold, m_bandMaxDiff[bandNdx]);
+		else
+		{
+			IVec4* const refRow = &m_refRows[workerNdx][0];
+			IVec4* const cmpRow = &m_cmpRows[workerNdx][0];
+
+			m_reference.readRow(refRow, 0, y, z, m_width);
+			m_result.readRow(cmpRow, 0, y, z, m_width);
+
+			intThresholdCompareRow(mask, refRow->getPtr(), cmpRow->getPtr(), m_width, m_threshold, m_bandMaxDiff[bandNdx]);
+		}
+	}
+
+private:
+	const PixelBufferAccess					m_errorMask;
+	const ConstPixelBufferAccess			m_reference;
+	const ConstPixelBufferAccess			m_result;
+	const UVec4								m_threshold;
+	const bool								m_isRGBA8;
+
+	std::vector<std::vector<IVec4> >		m_refRows;
+	std::vector<std::vector<IVec4> >		m_cmpRows;
+	std::vector<UVec4>						m_bandMaxDiff;
+};
+
+class FloatThresholdCompareJob : public RowCompareJob
+{
+public:
+	enum Metric
+	{
+		METRIC_ABS_DIFF = 0,	//!< Absolute difference of values
+		METRIC_ULP_DIFF			//!< Difference of float bit patterns
+	};
+
+	//! Compare result to reference image.
+	FloatThresholdCompareJob (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, Metric metric)
+		: RowCompareJob		(result.getWidth(), result.getHeight(), result.getDepth())
+		, m_errorMask		(errorMask)
+		, m_reference		(reference)
+		, m_result			(result)
+		, m_metric			(metric)
+		, m_isConstRef		(false)
+		, m_refRows			(m_numWorkers, std::vector<Vec4>(de::max(m_width, 1)))
+		, m_cmpRows			(m_numWorkers, std::vector<Vec4>(de::max(m_width, 1)))
+		, m_bandMaxDiff		(m_numBands, Vec4(0.0f))
+		, m_bandMaxUlpDiff	(m_numBands, UVec4(0))
+	{
+	}
+
+	//! Compare result to constant reference color.
+	FloatThresholdCompareJob (const PixelBufferAccess& errorMask, const Vec4& reference, const ConstPixelBufferAccess& result)
+		: RowCompareJob		(result.getWidth(), result.getHeight(), result.getDepth())
+		, m_errorMask		(errorMask)
+		, m_result			(result)
+		, m_metric			(METRIC_ABS_DIFF)
+		, m_isConstRef		(true)
+		, m_refRows			(1, std::vector<Vec4>(de::max(m_width, 1), reference))
+		, m_cmpRows			(m_numWorkers, std::vector<Vec4>(de::max(m_width, 1)))
+		, m_bandMaxDiff		(m_numBands, Vec4(0.0f))
+		, m_bandMaxUlpDiff	(m_numBands, UVec4(0))
+	{
+	}
+
+	void setThreshold (const Vec4& threshold)		{ DE_ASSERT(m_metric == METRIC_ABS_DIFF); m_threshold = threshold;		}
+	void setThreshold (const UVec4& threshold)		{ DE_ASSERT(m_metric == METRIC_ULP_DIFF); m_ulpThreshold = threshold;	}
+
+	Vec4 getMaxDiff (void) const
+	{
+		Vec4 maxDiff (0.0f);
+
+		for (int bandNdx = 0; bandNdx < m_numBands; bandNdx++)
+			maxDiff = max(maxDiff, m_bandMaxDiff[bandNdx]);
+
+		return maxDiff;
+	}
+
+	UVec4 getMaxUlpDiff (void) const
+	{
+		UVec4 maxDiff (0);
+
+		for (int bandNdx = 0; bandNdx < m_numBands; bandNdx++)
+			maxDiff = max(maxDiff, m_bandMaxUlpDiff[bandNdx]);
+
+		return maxDiff;
+	}
+
+protected:
+	void compareRow (int bandNdx, int workerNdx, int y, int z)
+	{
+		Vec4* const		refRow		= &m_refRows[m_isConstRef ? 0 : workerNdx][0];
+		Vec4* const		cmpRow		= &m_cmpRows[workerNdx][0];
+		deUint8* const	mask		= getRowPtr(m_errorMask, y, z);
+
+		if (!m_isConstRef)
+			m_reference.readRow(refRow, 0, y, z, m_width);
+		m_result.readRow(cmpRow, 0, y, z, m_width);
+
+		if (m_metric == METRIC_ULP_DIFF)
+			floatUlpThresholdCompareRow(mask, refRow->getPtr(), cmpRow->getPtr(), m_width, m_ulpThreshold, m_bandMaxUlpDiff[bandNdx]);
+		else
+			floatThresholdCompareRow(mask, refRow->getPtr(), cmpRow->getPtr(), m_width, m_threshold, m_bandMaxDiff[bandNdx]);
+	}
+
+private:
+	const PixelBufferAccess					m_errorMask;
+	const ConstPixelBufferAccess			m_reference;
+	const ConstPixelBufferAccess			m_result;
+	const Metric							m_metric;
+	const bool								m_isConstRef;
+	Vec4									m_threshold;
+	UVec4									m_ulpThreshold;
+
+	std::vector<std::vector<Vec4> >			m_refRows;			//!< Single shared row if reference is a constant color.
+	std::vector<std::vector<Vec4> >			m_cmpRows;
+	std::vector<Vec4>						m_bandMaxDiff;
+	std::vector<UVec4>						m_bandMaxUlpDiff;
+};
+
+class SquaredDiffSumJob : public RowCompareJob
+{
+public:
+	SquaredDiffSumJob (const PixelBufferAccess& diffMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, int diffFactor)
+		: RowCompareJob		(reference.getWidth(), reference.getHeight(), 1)
+		, m_diffMask		(diffMask)
+		, m_reference		(reference)
+		, m_result			(result)
+		, m_diffFactor		(diffFactor)
+		, m_isRGBA8			(isRGBA8Format(reference.getFormat()) && isRGBA8Format(result.getFormat()))
+		, m_refRows			(m_isRGBA8 ? 0 : m_numWorkers, std::vector<IVec4>(de::max(m_width, 1)))
+		, m_cmpRows			(m_isRGBA8 ? 0 : m_numWorkers, std::vector<IVec4>(de::max(m_width, 1)))
+		, m_bandDiffSum		(m_numBands, 0)
+	{
+	}
+
+	deInt64 getDiffSum (void) const
+	{
+		deInt64 diffSum = 0;
+
+		for (int bandNdx = 0; bandNdx < m_numBands; bandNdx++)
+			diffSum += m_bandDiffSum[bandNdx];
+
+		return diffSum;
+	}
+
+protected:
+	void compareRow (int bandNdx, int workerNdx, int y, int z)
+	{
+		deUint8* const mask = getRowPtr(m_diffMask, y, z);
+
+		if (m_isRGBA8)
+			m_bandDiffSum[bandNdx] += squaredDiffSumRow(mask, getRowPtr(m_reference, y, z), getRowPtr(m_result, y, z), m_width, m_diffFactor);
+		else
+		{
+			IVec4* const refRow = &m_refRows[workerNdx][0];
+			IVec4* const cmpRow = &m_cmpRows[workerNdx][0];
+
+			m_reference.readRow(refRow, 0, y, z, m_width);
+			m_result.readRow(cmpRow, 0, y, z, m_width);
+
+			m_bandDiffSum[bandNdx] += squaredDiffSumRow(mask, refRow->getPtr(), cmpRow->getPtr(), m_width, m_diffFactor);
+		}
+	}
+
+private:
+	const PixelBufferAccess					m_diffMask;
+	const ConstPixelBufferAccess			m_reference;
+	const ConstPixelBufferAccess			m_result;
+	const int								m_diffFactor;
+	const bool								m_isRGBA8;
+
+	std::vector<std::vector<IVec4> >		m_refRows;
+	std::vector<std::vector<IVec4> >		m_cmpRows;
+	std::vector<deInt64>					m_bandDiffSum;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Conservative value range of x-windows of a row
+ *
+ * Row is split into blocks of window size, and per-block prefix and suffix
+ * minimums and maximums are computed. Any window of at most block size
+ * pixels is covered by suffix of one block and prefix of the next (or the
+ * same) block, so the range is found in constant time. Range may include
+ * values from outside the window, but never excludes any value in it.
+ *//*--------------------------------------------------------------------*/
+class RowWindowRange
+{
+public:
+	void compute (const IVec4* row, int width, int radius)
+	{
+		const int blockSize = 2*de::min(radius, width) + 1;
+
+		m_prefixMin.resize(width);
+		m_prefixMax.resize(width);
+		m_suffixMin.resize(width);
+		m_suffixMax.resize(width);
+
+		for (int x = 0; x < width; x++)
+		{
+			const bool isBlockStart = x % blockSize == 0;
+
+			m_prefixMin[x] = isBlockStart ? row[x] : min(m_prefixMin[x-1], row[x]);
+			m_prefixMax[x] = isBlockStart ? row[x] : max(m_prefixMax[x-1], row[x]);
+		}
+
+		for (int x = width-1; x >= 0; x--)
+		{
+			const bool isBlockEnd = x == width-1 || (x+1) % blockSize == 0;
+
+			m_suffixMin[x] = isBlockEnd ? row[x] : min(m_suffixMin[x+1], row[x]);
+			m_suffixMax[x] = isBlockEnd ? row[x] : max(m_suffixMax[x+1], row[x]);
+		}
+	}
+
+	//! Returns true if no value in window [x0, x1] can be within threshold of value.
+	bool canReject (const IVec4& value, int x0, int x1, const UVec4& threshold) const
+	{
+		const IVec4 minVal = min(m_suffixMin[x0], m_prefixMin[x1]);
+		const IVec4 maxVal = max(m_suffixMax[x0], m_prefixMax[x1]);
+
+		for (int c = 0; c < 4; c++)
+		{
+			const deInt64	v			= value[c];
+			const deInt64	maxAbsDiff	= de::max(de::abs(v - minVal[c]), de::abs(v - maxVal[c]));
+			const deInt64	distance	= v < minVal[c] ? minVal[c] - v : v > maxVal[c] ? v - maxVal[c] : 0;
+
+			// \note Actual compare computes differences in 32-bit ints. Channels where they could overflow are not used.
+			if (maxAbsDiff <= 0x7fffffff && distance > (deInt64)threshold[c])
+				return true;
+		}
+
+		return false;
+	}
+
+private:
+	std::vector<IVec4>	m_prefixMin;
+	std::vector<IVec4>	m_prefixMax;
+	std::vector<IVec4>	m_suffixMin;
+	std::vector<IVec4>	m_suffixMax;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Position deviation compare job
+ *
+ * Pixels that fail exact compare are searched for a matching pixel in the
+ * search volume. Rows in the search volume are converted once and cached
+ * per worker, and whole rows are skipped using value ranges of their
+ * search windows.
+ *//*--------------------------------------------------------------------*/
+class PositionDeviationCompareJob : public RowCompareJob
+{
+public:
+	PositionDeviationCompareJob (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const IVec3& maxPositionDeviation, bool acceptOutOfBoundsAsAnyValue)
+		: RowCompareJob						(reference.getWidth(), reference.getHeight(), reference.getDepth())
+		, m_errorMask						(errorMask)
+		, m_reference						(reference)
+		, m_result							(result)
+		, m_threshold						(threshold)
+		, m_maxPositionDeviation			(maxPositionDeviation)
+		, m_acceptOutOfBoundsAsAnyValue		(acceptOutOfBoundsAsAnyValue)
+		, m_depth							(reference.getDepth())
+		, m_numCachedRowsY					(de::min(2*de::min(maxPositionDeviation.y(), m_height) + 1, m_height))
+		, m_numCachedRowsZ					(de::min(2*de::min(maxPositionDeviation.z(), m_depth) + 1, m_depth))
+		, m_workers							(m_numWorkers)
+		, m_bandNumFailingPixels			(m_numBands, 0)
+	{
+	}
+
+	int getNumFailingPixels (void) const
+	{
+		int numFailingPixels = 0;
+
+		for (int bandNdx = 0; bandNdx < m_numBands; bandNdx++)
+			numFailingPixels += m_bandNumFailingPixels[bandNdx];
+
+		return numFailingPixels;
+	}
+
+protected:
+	void compareRow (int bandNdx, int workerNdx, int y, int z)
+	{
+		WorkerData&		worker	= m_workers[workerNdx];
+		deUint8* const	mask	= getRowPtr(m_errorMask, y, z);
+
+		if (worker.refRow.empty())
+		{
+			worker.refRow.resize(m_width);
+			worker.cmpRow.resize(m_width);
+			worker.cachedRows.resize(m_numCachedRowsY*m_numCachedRowsZ);
+		}
+
+		m_reference.readRow(&worker.refRow[0], 0, y, z, m_width);
+		m_result.readRow(&worker.cmpRow[0], 0, y, z, m_width);
+
+		for (int x = 0; x < m_width; x++)
+		{
+			const IVec4&	refPix = worker.refRow[x];
+			const IVec4&	cmpPix = worker.cmpRow[x];
+
+			// Exact match
+			if (isWithinThreshold(refPix, cmpPix, m_threshold))
+			{
+				setMaskPixel(mask + x*3, true);
+				continue;
+			}
+
+			// Accept over the image bounds pixels since they could be anything
+
+			if (m_acceptOutOfBoundsAsAnyValue &&
+				(x < m_maxPositionDeviation.x() || x + m_maxPositionDeviation.x() >= m_width  ||
+				 y < m_maxPositionDeviation.y() || y + m_maxPositionDeviation.y() >= m_height ||
+				 z < m_maxPositionDeviation.z() || z + m_maxPositionDeviation.z() >= m_depth))
+			{
+				setMaskPixel(mask + x*3, true);
+				continue;
+			}
+
+			// Find matching pixels for both result and reference pixel
+
+			{
+				const bool pixelFoundForReference	= findMatchingPixel(worker, refPix, x, y, z, true);
+				const bool pixelFoundForResult		= pixelFoundForReference && findMatchingPixel(worker, cmpPix, x, y, z, false);
+
+				setMaskPixel(mask + x*3, pixelFoundForResult);
+
+				if (!pixelFoundForResult)
+					m_bandNumFailingPixels[bandNdx] += 1;
+			}
+		}
+	}
+
+private:
+	struct CachedRow
+	{
+		CachedRow (void) : rowNdx(-1) {}
+
+		int					rowNdx;
+		std::vector<IVec4>	refRow;
+		std::vector<IVec4>	cmpRow;
+		RowWindowRange		refRange;
+		RowWindowRange		cmpRange;
+	};
+
+	struct WorkerData
+	{
+		std::vector<IVec4>		refRow;
+		std::vector<IVec4>		cmpRow;
+		std::vector<CachedRow>	cachedRows;		//!< Indexed by (y mod cached rows in y, z mod cached rows in z).
+	};
+
+	const CachedRow& getCachedRow (WorkerData& worker, int y, int z) const
+	{
+		CachedRow&	row		= worker.cachedRows[(y % m_numCachedRowsY) + (z % m_numCachedRowsZ)*m_numCachedRowsY];
+		const int	rowNdx	= z*m_height + y;
+
+		if (row.rowNdx != rowNdx)
+		{
+			row.refRow.resize(m_width);
+			row.cmpRow.resize(m_width);
+
+			m_reference.readRow(&row.refRow[0], 0, y, z, m_width);
+			m_result.readRow(&row.cmpRow[0], 0, y, z, m_width);
+
+			row.refRange.compute(&row.refRow[0], m_width, m_maxPositionDeviation.x());
+			row.cmpRange.compute(&row.cmpRow[0], m_width, m_maxPositionDeviation.x());
+
+			row.rowNdx = rowNdx;
+		}
+
+		return row;
+	}
+
+	//! Find pixel within threshold of value from result (or reference) image in search volume around (x, y, z).
+	bool findMatchingPixel (WorkerData& worker, const IVec4& value, int x, int y, int z, bool searchResult) const
+	{
+		const int x0 = de::max(0, x - m_maxPositionDeviation.x());
+		const int x1 = de::min(m_width - 1, x + m_maxPositionDeviation.x());
+
+		for (int sz = de::max(0, z - m_maxPositionDeviation.z()); sz <= de::min(m_depth  - 1, z + m_maxPositionDeviation.z()); ++sz)
+		for (int sy = de::max(0, y - m_maxPositionDeviation.y()); sy <= de::min(m_height - 1, y + m_maxPositionDeviation.y()); ++sy)
+		{
+			const CachedRow&			row		= getCachedRow(worker, sy, sz);
+			const std::vector<IVec4>&	pixels	= searchResult ? row.cmpRow		: row.refRow;
+			const RowWindowRange&		range	= searchResult ? row.cmpRange	: row.refRange;
+
+			if (range.canReject(value, x0, x1, m_threshold))
+				continue;
+
+			for (int sx = x0; sx <= x1; ++sx)
+			{
+				if (isWithinThreshold(value, pixels[sx], m_threshold))
+					return true;
+			}
+		}
+
+		return false;
+	}
+
+	const PixelBufferAccess			m_errorMask;
+	const ConstPixelBufferAccess	m_reference;
+	const ConstPixelBufferAccess	m_result;
+	const UVec4						m_threshold;
+	const IVec3						m_maxPositionDeviation;
+	const bool						m_acceptOutOfBoundsAsAnyValue;
+	const int						m_depth;
+	const int						m_numCachedRowsY;
+	const int						m_numCachedRowsZ;
+
+	std::vector<WorkerData>			m_workers;
+	std::vector<int>				m_bandNumFailingPixels;
+};
+
+static int findNumPositionDeviationFailingPixels (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const tcu::IVec3& maxPositionDeviation, bool acceptOutOfBoundsAsAnyValue)
+{
+	TCU_CHECK_INTERNAL(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight() && result.getDepth() == reference.getDepth());
+
+	PositionDeviationCompareJob job (errorMask, reference, result, threshold, maxPositionDeviation, acceptOutOfBoundsAsAnyValue);
+	job.run();
+
+	return job.getNumFailingPixels();
 }
 
 } // anonymous
@@ -286,25 +851,12 @@ static deInt64 computeSquaredDiffSum (const ConstPixelBufferAccess& ref, const C
 	DE_ASSERT(ref.getWidth() == cmp.getWidth() && ref.getWidth() == diffMask.getWidth());
 	DE_ASSERT(ref.getHeight() == cmp.getHeight() && ref.getHeight() == diffMask.getHeight());
 
-	deInt64 diffSum = 0;
-
-	for (int y = 0; y < cmp.getHeight(); y++)
-	{
-		for (int x = 0; x < cmp.getWidth(); x++)
-		{
-			IVec4	a		= ref.getPixelInt(x, y);
-			IVec4	b		= cmp.getPixelInt(x, y);
-			IVec4	diff	= abs(a - b);
-			int		sum		= diff.x() + diff.y() + diff.z() + diff.w();
-			int		sqSum	= diff.x()*diff.x() + diff.y()*diff.y() + diff.z()*diff.z() + diff.w()*diff.w();
-
-			diffMask.setPixel(tcu::RGBA(deClamp32(sum*diffFactor, 0, 255), deClamp32(255-sum*diffFactor, 0, 255), 0, 255).toVec(), x, y);
+	DE_ASSERT(diffMask.getFormat() == TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8));
 
-			diffSum += (deInt64)sqSum;
-		}
-	}
+	SquaredDiffSumJob job (diffMask, ref, cmp, diffFactor);
+	job.run();
 
-	return diffSum;
+	return job.getDiffSum();
 }
 
 /*--------------------------------------------------------------------*//*!
@@ -420,29 +972,11 @@ bool floatUlpThresholdCompare (TestLog& log, const char* imageSetName, const cha
 
 	TCU_CHECK(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
 
-	for (int z = 0; z < depth; z++)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				Vec4	refPix		= reference.getPixel(x, y, z);
-				Vec4	cmpPix		= result.getPixel(x, y, z);
-				UVec4	refBits;
-				UVec4	cmpBits;
-
-				// memcpy() is the way to do float->uint32 reinterpretation.
-				memcpy(refBits.getPtr(), refPix.getPtr(), 4*sizeof(deUint32));
-				memcpy(cmpBits.getPtr(), cmpPix.getPtr(), 4*sizeof(deUint32));
-
-				UVec4	diff		= abs(refBits.cast<int>() - cmpBits.cast<int>()).cast<deUint32>();
-				bool	isOk		= boolAll(lessThanEqual(diff, threshold));
-
-				maxDiff = max(maxDiff, diff);
-
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
+		FloatThresholdCompareJob job (errorMask, reference, result, FloatThresholdCompareJob::METRIC_ULP_DIFF);
+		job.setThreshold(threshold);
+		job.run();
+		maxDiff = job.getMaxUlpDiff();
 	}
 
 	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
@@ -513,23 +1047,11 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
 
 	TCU_CHECK_INTERNAL(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
 
-	for (int z = 0; z < depth; z++)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				Vec4	refPix		= reference.getPixel(x, y, z);
-				Vec4	cmpPix		= result.getPixel(x, y, z);
-
-				Vec4	diff		= abs(refPix - cmpPix);
-				bool	isOk		= boolAll(lessThanEqual(diff, threshold));
-
-				maxDiff = max(maxDiff, diff);
-
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
+		FloatThresholdCompareJob job (errorMask, reference, result, FloatThresholdCompareJob::METRIC_ABS_DIFF);
+		job.setThreshold(threshold);
+		job.run();
+		maxDiff = job.getMaxDiff();
 	}
 
 	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
@@ -599,21 +1121,11 @@ bool floatThresholdCompare (TestLog& log, const char* imageSetName, const char*
 	Vec4				pixelBias			(0.0f, 0.0f, 0.0f, 0.0f);
 	Vec4				pixelScale			(1.0f, 1.0f, 1.0f, 1.0f);
 
-	for (int z = 0; z < depth; z++)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				const Vec4	cmpPix		= result.getPixel(x, y, z);
-				const Vec4	diff		= abs(reference - cmpPix);
-				const bool	isOk		= boolAll(lessThanEqual(diff, threshold));
-
-				maxDiff = max(maxDiff, diff);
-
-				errorMask.setPixel(isOk ? Vec4(0.0f, 1.0f, 0.0f, 1.0f) : Vec4(1.0f, 0.0f, 0.0f, 1.0f), x, y, z);
-			}
-		}
+		FloatThresholdCompareJob job (errorMask, reference, result);
+		job.setThreshold(threshold);
+		job.run();
+		maxDiff = job.getMaxDiff();
 	}
 
 	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
@@ -682,23 +1194,10 @@ bool intThresholdCompare (TestLog& log, const char* imageSetName, const char* im
 
 	TCU_CHECK_INTERNAL(result.getWidth() == width && result.getHeight() == height && result.getDepth() == depth);
 
-	for (int z = 0; z < depth; z++)
 	{
-		for (int y = 0; y < height; y++)
-		{
-			for (int x = 0; x < width; x++)
-			{
-				IVec4	refPix		= reference.getPixelInt(x, y, z);
-				IVec4	cmpPix		= result.getPixelInt(x, y, z);
-
-				UVec4	diff		= abs(refPix - cmpPix).cast<deUint32>();
-				bool	isOk		= boolAll(lessThanEqual(diff, threshold));
-
-				maxDiff = max(maxDiff, diff);
-
-				errorMask.setPixel(isOk ? IVec4(0, 0xff, 0, 0xff) : IVec4(0xff, 0, 0, 0xff), x, y, z);
-			}
-		}
+		IntThresholdCompareJob job (errorMask, reference, result, threshold);
+		job.run();
+		maxDiff = job.getMaxDiff();
 	}
 
 	bool compareOk = boolAll(lessThanEqual(maxDiff, threshold));
@@ -967,4 +1466,418 @@ bool bilinearCompare (TestLog& log, const char* imageSetName, const char* imageS
 	return isOk;
 }
 
+
+namespace
+{
+
+// Self-test helpers. References compute the same per-pixel results one pixel at a time.
+
+enum
+{
+	SELF_TEST_INT_SCALE	= 9973	//!< Scale of test values in signed integer images.
+};
+
+void setTestPixel (const PixelBufferAccess& dst, const IVec4& value, int x, int y, int z)
+{
+	switch (getTextureChannelClass(dst.getFormat().type))
+	{
+		case TEXTURECHANNELCLASS_FLOATING_POINT:		dst.setPixel(value.asFloat() / 64.0f, x, y, z);								break;
+		case TEXTURECHANNELCLASS_UNSIGNED_FIXED_POINT:	dst.setPixel(value.asFloat() / 255.0f, x, y, z);							break;
+		case TEXTURECHANNELCLASS_SIGNED_INTEGER:		dst.setPixel(value*(int)SELF_TEST_INT_SCALE - IVec4(128*SELF_TEST_INT_SCALE), x, y, z);	break;
+		default:
+			DE_ASSERT(false);
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Generate reference and result images for self-test
+ *
+ * Values are in [0, 255] before scaling to format. Most result pixels
+ * match, rest are slightly perturbed, copied from previous pixel in row
+ * (to pass position deviation compares) or far off. Gradient content
+ * lets RowWindowRange reject most search rows, random content doesn't.
+ *//*--------------------------------------------------------------------*/
+void generateSelfTestImages (TextureLevel& reference, TextureLevel& result, const TextureFormat& format, const IVec3& size, bool isGradient, deUint32 seed)
+{
+	de::Random rnd (seed);
+
+	reference.setStorage(format, size.x(), size.y(), size.z());
+	result.setStorage(format, size.x(), size.y(), size.z());
+
+	for (int z = 0; z < size.z(); z++)
+	for (int y = 0; y < size.y(); y++)
+	{
+		IVec4 prevValue;
+
+		for (int x = 0; x < size.x(); x++)
+		{
+			IVec4		refValue;
+			IVec4		cmpValue;
+			const int	choice		= rnd.getInt(0, 99);
+
+			for (int c = 0; c < 4; c++)
+				refValue[c] = isGradient ? ((x + 2*y + 3*z)/2 + c*50) % 256 : rnd.getInt(0, 255);
+
+			cmpValue = refValue;
+
+			if (choice >= 95)
+			{
+				for (int c = 0; c < 4; c++)
+					cmpValue[c] = (refValue[c] + 128) % 256;
+			}
+			else if (choice >= 85 && x > 0)
+				cmpValue = prevValue;
+			else if (choice >= 70)
+			{
+				for (int c = 0; c < 4; c++)
+					cmpValue[c] = de::clamp(refValue[c] + rnd.getInt(-3, 3), 0, 255);
+			}
+
+			setTestPixel(reference.getAccess(), refValue, x, y, z);
+			setTestPixel(result.getAccess(), cmpValue, x, y, z);
+
+			prevValue = refValue;
+		}
+	}
+}
+
+bool isMaskEqual (const TextureLevel& a, const TextureLevel& b)
+{
+	DE_ASSERT(a.getWidth() == b.getWidth() && a.getHeight() == b.getHeight() && a.getDepth() == b.getDepth());
+	return deMemCmp(a.getAccess().getDataPtr(), b.getAccess().getDataPtr(), a.getWidth()*a.getHeight()*a.getDepth()*3) == 0;
+}
+
+int countFailingPixels (const TextureLevel& mask)
+{
+	const deUint8* const	data		= (const deUint8*)mask.getAccess().getDataPtr();
+	const int				numPixels	= mask.getWidth()*mask.getHeight()*mask.getDepth();
+	int						numFailing	= 0;
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		numFailing += data[ndx*3] != 0 ? 1 : 0;
+
+	return numFailing;
+}
+
+UVec4 referenceIntThresholdCompare (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold)
+{
+	UVec4 maxDiff (0);
+
+	for (int z = 0; z < reference.getDepth(); z++)
+	for (int y = 0; y < reference.getHeight(); y++)
+	for (int x = 0; x < reference.getWidth(); x++)
+	{
+		const UVec4 diff = abs(reference.getPixelInt(x, y, z) - result.getPixelInt(x, y, z)).cast<deUint32>();
+
+		setMaskPixel(getRowPtr(errorMask, y, z) + x*3, boolAll(lessThanEqual(diff, threshold)));
+		maxDiff = max(maxDiff, diff);
+	}
+
+	return maxDiff;
+}
+
+Vec4 referenceFloatThresholdCompare (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const Vec4& threshold)
+{
+	Vec4 maxDiff (0.0f);
+
+	for (int z = 0; z < result.getDepth(); z++)
+	for (int y = 0; y < result.getHeight(); y++)
+	for (int x = 0; x < result.getWidth(); x++)
+	{
+		const Vec4 diff = abs(reference.getPixel(x, y, z) - result.getPixel(x, y, z));
+
+		setMaskPixel(getRowPtr(errorMask, y, z) + x*3, boolAll(lessThanEqual(diff, threshold)));
+		maxDiff = max(maxDiff, diff);
+	}
+
+	return maxDiff;
+}
+
+UVec4 referenceFloatUlpThresholdCompare (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold)
+{
+	UVec4 maxDiff (0);
+
+	for (int z = 0; z < result.getDepth(); z++)
+	for (int y = 0; y < result.getHeight(); y++)
+	for (int x = 0; x < result.getWidth(); x++)
+	{
+		const Vec4	refPix	= reference.getPixel(x, y, z);
+		const Vec4	cmpPix	= result.getPixel(x, y, z);
+		UVec4		diff;
+
+		for (int c = 0; c < 4; c++)
+		{
+			deUint32 refBits;
+			deUint32 cmpBits;
+
+			memcpy(&refBits, &refPix[c], sizeof(deUint32));
+			memcpy(&cmpBits, &cmpPix[c], sizeof(deUint32));
+
+			diff[c] = (deUint32)de::abs((int)refBits - (int)cmpBits);
+		}
+
+		setMaskPixel(getRowPtr(errorMask, y, z) + x*3, boolAll(lessThanEqual(diff, threshold)));
+		maxDiff = max(maxDiff, diff);
+	}
+
+	return maxDiff;
+}
+
+deInt64 referenceSquaredDiffSum (const PixelBufferAccess& diffMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, int diffFactor)
+{
+	deInt64 diffSum = 0;
+
+	for (int y = 0; y < reference.getHeight(); y++)
+	for (int x = 0; x < reference.getWidth(); x++)
+	{
+		const IVec4		diff	= abs(reference.getPixelInt(x, y) - result.getPixelInt(x, y));
+		const int		sum		= diff.x() + diff.y() + diff.z() + diff.w();
+		deUint8* const	mask	= getRowPtr(diffMask, y, 0) + x*3;
+
+		mask[0] = (deUint8)deClamp32(sum*diffFactor, 0, 255);
+		mask[1] = (deUint8)deClamp32(255-sum*diffFactor, 0, 255);
+		mask[2] = 0;
+
+		diffSum += (deInt64)dot(diff, diff);
+	}
+
+	return diffSum;
+}
+
+//! Search volume around (x, y, z) in image for pixel within threshold of value, without any prefiltering.
+bool referenceFindMatchingPixel (const ConstPixelBufferAccess& image, const IVec4& value, int x, int y, int z, const IVec3& maxPositionDeviation, const UVec4& threshold)
+{
+	for (int sz = de::max(0, z - maxPositionDeviation.z()); sz <= de::min(image.getDepth()  - 1, z + maxPositionDeviation.z()); ++sz)
+	for (int sy = de::max(0, y - maxPositionDeviation.y()); sy <= de::min(image.getHeight() - 1, y + maxPositionDeviation.y()); ++sy)
+	for (int sx = de::max(0, x - maxPositionDeviation.x()); sx <= de::min(image.getWidth()  - 1, x + maxPositionDeviation.x()); ++sx)
+	{
+		if (isWithinThreshold(value, image.getPixelInt(sx, sy, sz), threshold))
+			return true;
+	}
+
+	return false;
+}
+
+int referencePositionDeviationCompare (const PixelBufferAccess& errorMask, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const UVec4& threshold, const IVec3& maxPositionDeviation, bool acceptOutOfBoundsAsAnyValue)
+{
+	const IVec3	size				(reference.getWidth(), reference.getHeight(), reference.getDepth());
+	int			numFailingPixels	= 0;
+
+	for (int z = 0; z < size.z(); z++)
+	for (int y = 0; y < size.y(); y++)
+	for (int x = 0; x < size.x(); x++)
+	{
+		const IVec4	refPix		= reference.getPixelInt(x, y, z);
+		const IVec4	cmpPix		= result.getPixelInt(x, y, z);
+		const IVec3	pos			(x, y, z);
+		const bool	isNearEdge	= boolAny(lessThan(pos, maxPositionDeviation)) || boolAny(greaterThanEqual(pos + maxPositionDeviation, size));
+		const bool	isOk		= isWithinThreshold(refPix, cmpPix, threshold)										||
+								  (acceptOutOfBoundsAsAnyValue && isNearEdge)										||
+								  (referenceFindMatchingPixel(result, refPix, x, y, z, maxPositionDeviation, threshold) &&
+								   referenceFindMatchingPixel(reference, cmpPix, x, y, z, maxPositionDeviation, threshold));
+
+		setMaskPixel(getRowPtr(errorMask, y, z) + x*3, isOk);
+
+		if (!isOk)
+			numFailingPixels += 1;
+	}
+
+	return numFailingPixels;
+}
+
+void checkThresholdCompares (const TextureFormat& format, const IVec3& size, deUint32 seed)
+{
+	const TextureFormat	maskFormat	(TextureFormat::RGB, TextureFormat::UNORM_INT8);
+	const int			numPixels	= size.x()*size.y()*size.z();
+	const bool			isFloat		= getTextureChannelClass(format.type) == TEXTURECHANNELCLASS_FLOATING_POINT;
+	const int			scale		= getTextureChannelClass(format.type) == TEXTURECHANNELCLASS_SIGNED_INTEGER ? (int)SELF_TEST_INT_SCALE : 1;
+	const int			numThreads[]	= { 1, 3 };
+	TextureLevel		reference;
+	TextureLevel		result;
+	TextureLevel		constReference	(format, size.x(), size.y(), size.z());
+	TextureLevel		refMask			(maskFormat, size.x(), size.y(), size.z());
+	TextureLevel		refUlpMask		(maskFormat, size.x(), size.y(), size.z());
+	TextureLevel		refConstMask	(maskFormat, size.x(), size.y(), size.z());
+	TextureLevel		mask			(maskFormat, size.x(), size.y(), size.z());
+	const Vec4			constColor		(2.0f, 1.0f, 3.0f, 0.5f);
+	const Vec4			threshold		(3.0f / 64.0f);
+	const UVec4			ulpThreshold	(1u<<17);
+	const UVec4			intThreshold	(2u*scale);
+	UVec4				refMaxDiff		(0);
+	Vec4				refMaxFloatDiff	(0.0f);
+	UVec4				refMaxUlpDiff	(0);
+	Vec4				refMaxConstDiff	(0.0f);
+
+	generateSelfTestImages(reference, result, format, size, false, seed);
+
+	if (isFloat)
+	{
+		clear(constReference.getAccess(), constColor);
+
+		refMaxFloatDiff	= referenceFloatThresholdCompare(refMask.getAccess(), reference, result, threshold);
+		refMaxUlpDiff	= referenceFloatUlpThresholdCompare(refUlpMask.getAccess(), reference, result, ulpThreshold);
+		refMaxConstDiff	= referenceFloatThresholdCompare(refConstMask.getAccess(), constReference, result, threshold);
+	}
+	else
+		refMaxDiff = referenceIntThresholdCompare(refMask.getAccess(), reference, result, intThreshold);
+
+	// Test data must have both passing and failing pixels.
+	DE_TEST_ASSERT(de::inRange(countFailingPixels(refMask), 1, numPixels-1));
+
+	for (int threadNdx = 0; threadNdx < DE_LENGTH_OF_ARRAY(numThreads); threadNdx++)
+	{
+		const ScopedMaxWorkerThreads maxThreads (numThreads[threadNdx]);
+
+		if (isFloat)
+		{
+			{
+				FloatThresholdCompareJob job (mask.getAccess(), reference, result, FloatThresholdCompareJob::METRIC_ABS_DIFF);
+				job.setThreshold(threshold);
+				job.run();
+				DE_TEST_ASSERT(job.getMaxDiff() == refMaxFloatDiff);
+				DE_TEST_ASSERT(isMaskEqual(mask, refMask));
+			}
+
+			{
+				FloatThresholdCompareJob job (mask.getAccess(), reference, result, FloatThresholdCompareJob::METRIC_ULP_DIFF);
+				job.setThreshold(ulpThreshold);
+				job.run();
+				DE_TEST_ASSERT(job.getMaxUlpDiff() == refMaxUlpDiff);
+				DE_TEST_ASSERT(isMaskEqual(mask, refUlpMask));
+			}
+
+			{
+				FloatThresholdCompareJob job (mask.getAccess(), constColor, result);
+				job.setThreshold(threshold);
+				job.run();
+				DE_TEST_ASSERT(job.getMaxDiff() == refMaxConstDiff);
+				DE_TEST_ASSERT(isMaskEqual(mask, refConstMask));
+			}
+		}
+		else
+		{
+			IntThresholdCompareJob job (mask.getAccess(), reference, result, intThreshold);
+			job.run();
+			DE_TEST_ASSERT(job.getMaxDiff() == refMaxDiff);
+			DE_TEST_ASSERT(isMaskEqual(mask, refMask));
+		}
+	}
+}
+
+void checkSquaredDiffSum (const TextureFormat& format, const IVec2& size, deUint32 seed)
+{
+	const TextureFormat	maskFormat		(TextureFormat::RGB, TextureFormat::UNORM_INT8);
+	const int			numThreads[]	= { 1, 3 };
+	const int			diffFactor		= 8;
+	TextureLevel		reference;
+	TextureLevel		result;
+	TextureLevel		refMask			(maskFormat, size.x(), size.y());
+	TextureLevel		mask			(maskFormat, size.x(), size.y());
+
+	generateSelfTestImages(reference, result, format, IVec3(size.x(), size.y(), 1), false, seed);
+
+	{
+		const deInt64 refDiffSum = referenceSquaredDiffSum(refMask.getAccess(), reference, result, diffFactor);
+
+		for (int threadNdx = 0; threadNdx < DE_LENGTH_OF_ARRAY(numThreads); threadNdx++)
+		{
+			const ScopedMaxWorkerThreads maxThreads (numThreads[threadNdx]);
+
+			DE_TEST_ASSERT(computeSquaredDiffSum(reference, result, mask.getAccess(), diffFactor) == refDiffSum);
+			DE_TEST_ASSERT(isMaskEqual(mask, refMask));
+		}
+	}
+}
+
+void checkPositionDeviationCompare (const TextureFormat& format, const IVec3& size, bool isGradient, const IVec3& maxPositionDeviation, bool acceptOutOfBoundsAsAnyValue, deUint32 seed)
+{
+	const TextureFormat	maskFormat		(TextureFormat::RGB, TextureFormat::UNORM_INT8);
+	const int			scale			= getTextureChannelClass(format.type) == TEXTURECHANNELCLASS_SIGNED_INTEGER ? (int)SELF_TEST_INT_SCALE : 1;
+	const UVec4			threshold		(2u*scale);
+	const int			numThreads[]	= { 1, 3 };
+	TextureLevel		reference;
+	TextureLevel		result;
+	TextureLevel		refMask			(maskFormat, size.x(), size.y(), size.z());
+	TextureLevel		mask			(maskFormat, size.x(), size.y(), size.z());
+
+	generateSelfTestImages(reference, result, format, size, isGradient, seed);
+
+	{
+		const int refNumFailing = referencePositionDeviationCompare(refMask.getAccess(), reference, result, threshold, maxPositionDeviation, acceptOutOfBoundsAsAnyValue);
+
+		DE_TEST_ASSERT(refNumFailing > 0);
+
+		for (int threadNdx = 0; threadNdx < DE_LENGTH_OF_ARRAY(numThreads); threadNdx++)
+		{
+			const ScopedMaxWorkerThreads maxThreads (numThreads[threadNdx]);
+
+			DE_TEST_ASSERT(findNumPositionDeviationFailingPixels(mask.getAccess(), reference, result, threshold, maxPositionDeviation, acceptOutOfBoundsAsAnyValue) == refNumFailing);
+			DE_TEST_ASSERT(isMaskEqual(mask, refMask));
+		}
+	}
+}
+
+} // anonymous
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Image compare self-test
+ *
+ * Compares the row-parallel compare jobs to per-pixel reference
+ * implementations. Large images are compared in several bands when 3
+ * workers are allowed, and results must be identical with 1 worker.
+ * pixelThresholdCompare() and intThresholdCompare() use the RGBA8 and
+ * converted-row paths of the integer compare tested here.
+ *//*--------------------------------------------------------------------*/
+void ImageCompare_selfTest (void)
+{
+	const TextureFormat	rgba8		(TextureFormat::RGBA,	TextureFormat::UNORM_INT8);
+	const TextureFormat	rgb8		(TextureFormat::RGB,	TextureFormat::UNORM_INT8);
+	const TextureFormat	rgba32i		(TextureFormat::RGBA,	TextureFormat::SIGNED_INT32);
+	const TextureFormat	rgba32f		(TextureFormat::RGBA,	TextureFormat::FLOAT);
+	const IVec3			large2D		(131, 751, 1);
+	const IVec3			large3D		(47, 47, 45);
+	const IVec3			small2D		(7, 5, 1);
+	const IVec3			small3D		(5, 3, 3);
+
+	// Large images must be split between 3 workers.
+	DE_TEST_ASSERT(large2D.x()*large2D.y() >= 3*MIN_COMPARE_PIXELS_PER_WORKER);
+	DE_TEST_ASSERT(large3D.x()*large3D.y()*large3D.z() >= 3*MIN_COMPARE_PIXELS_PER_WORKER);
+
+	// Threshold compares.
+	{
+		const TextureFormat	formats[]	= { rgba8, rgb8, rgba32i, rgba32f };
+		const IVec3			sizes[]		= { large2D, large3D, small2D };
+
+		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(formats); formatNdx++)
+		for (int sizeNdx = 0; sizeNdx < DE_LENGTH_OF_ARRAY(sizes); sizeNdx++)
+			checkThresholdCompares(formats[formatNdx], sizes[sizeNdx], (deUint32)(formatNdx*17 + sizeNdx));
+	}
+
+	// Squared difference sum.
+	{
+		checkSquaredDiffSum(rgba8,	large2D.swizzle(0, 1),	1u);
+		checkSquaredDiffSum(rgb8,	large2D.swizzle(0, 1),	2u);
+		checkSquaredDiffSum(rgba8,	small2D.swizzle(0, 1),	3u);
+	}
+
+	// Position deviation compare. Gradient images let the row range prefilter skip rows, random images mostly don't.
+	{
+		const TextureFormat formats[] = { rgba8, rgba32i };
+
+		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(formats); formatNdx++)
+		for (int gradientNdx = 0; gradientNdx < 2; gradientNdx++)
+		{
+			const TextureFormat&	format		= formats[formatNdx];
+			const bool				isGradient	= gradientNdx == 1;
+			const deUint32			seed		= (deUint32)(formatNdx*2 + gradientNdx);
+
+			checkPositionDeviationCompare(format, large2D, isGradient, IVec3(1, 1, 0), false,		seed);
+			checkPositionDeviationCompare(format, large2D, isGradient, IVec3(3, 2, 0), true,		seed);
+			checkPositionDeviationCompare(format, large3D, isGradient, IVec3(1, 1, 1), isGradient,	seed);
+			checkPositionDeviationCompare(format, small2D, isGradient, IVec3(0, 1, 0), false,		seed);
+			checkPositionDeviationCompare(format, small3D, isGradient, IVec3(1, 1, 1), false,		seed);
+		}
+	}
+}
+
 } // tcu
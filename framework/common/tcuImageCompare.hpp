@@ -58,6 +58,8 @@ bool	intThresholdPositionDeviationErrorThresholdCompare	(TestLog& log, const cha
 int		measurePixelDiffAccuracy							(TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, int bestScoreDiff, int worstScoreDiff, CompareLogMode logMode);
 bool	bilinearCompare										(TestLog& log, const char* imageSetName, const char* imageSetDesc, const ConstPixelBufferAccess& reference, const ConstPixelBufferAccess& result, const RGBA threshold, CompareLogMode logMode);
 
+void	ImageCompare_selfTest								(void);
+
 } // tcu
 
 #endif // _TCUIMAGECOMPARE_HPP
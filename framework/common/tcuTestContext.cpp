@@ -24,6 +24,7 @@
 #include "tcuTestContext.hpp"
 
 #include "tcuTestLog.hpp"
+#include "tcuCompressedTexture.hpp"
 
 namespace tcu
 {
@@ -42,10 +43,16 @@ TestContext::TestContext (
 	, m_curArchive		(DE_NULL)
 	, m_testResult		(QP_TEST_RESULT_LAST)
 	, m_terminateAfter	(false)
+	, m_decompressionCache	(new DecompressionCache())
 {
 	setCurrentArchive(m_rootArchive);
 }
 
+TestContext::~TestContext (void)
+{
+	delete m_decompressionCache;
+}
+
 void TestContext::touchWatchdog (void)
 {
 	if (m_watchDog)
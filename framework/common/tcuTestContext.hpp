@@ -36,12 +36,14 @@ class Archive;
 class Platform;
 class CommandLine;
 class TestLog;
+class DecompressionCache;
 
 /*--------------------------------------------------------------------*//*!
  * \brief Test context
  *
  * Test context holds common resources that are available to test cases.
- * This includes test log and resource archive.
+ * This includes test log, resource archive and cache of decoded compressed
+ * texture data.
  *
  * Test case can write to test log and must set test result to test context.
  *//*--------------------------------------------------------------------*/
@@ -49,7 +51,7 @@ class TestContext
 {
 public:
 							TestContext			(Platform& platform, Archive& rootArchive, TestLog& log, const CommandLine& cmdLine, qpWatchDog* watchDog);
-							~TestContext		(void) {}
+							~TestContext		(void);
 
 	// API for test cases
 	TestLog&				getLog				(void)			{ return m_log;			}
@@ -58,6 +60,7 @@ public:
 	void					setTestResult		(qpTestResult result, const char* description);
 	void					touchWatchdog		(void);
 	const CommandLine&		getCommandLine		(void) const	{ return m_cmdLine;		}
+	DecompressionCache&		getDecompressionCache	(void)		{ return *m_decompressionCache;	} //!< Shared by cases that decode the same compressed data.
 
 	// API for test framework
 	qpTestResult			getTestResult		(void) const	{ return m_testResult;				}
@@ -80,6 +83,11 @@ protected:
 	qpTestResult			m_testResult;		//!< Latest test result.
 	std::string				m_testResultDesc;	//!< Latest test result description.
 	bool					m_terminateAfter;	//!< Should tester terminate after execution of the current test
+	DecompressionCache*		m_decompressionCache;	//!< Decoded compressed texture levels.
+
+private:
+							TestContext			(const TestContext&);
+	TestContext&			operator=			(const TestContext&);
 };
 
 /*--------------------------------------------------------------------*//*!
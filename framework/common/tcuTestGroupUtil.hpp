@@ -0,0 +1,183 @@
+#ifndef _TCUTESTGROUPUTIL_HPP
+#define _TCUTESTGROUPUTIL_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Test case group utilities.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+#include "tcuTestCase.hpp"
+
+#include <string>
+
+namespace tcu
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Test case group with lazily created children
+ *
+ * Group only stores name, description and a function (with arguments)
+ * that creates the children. The function is called in init(), i.e. only
+ * when TestExecutor enters the group after it has matched the case filter,
+ * and children are destroyed again in deinit().
+ *
+ * Large generated hierarchies can use these to declare subgroups cheaply
+ * instead of generating all cases of all subgroups in the parent init().
+ * Use createTestGroup() to create the groups.
+ *//*--------------------------------------------------------------------*/
+class TestGroupHelper0 : public TestCaseGroup
+{
+public:
+	typedef void (*CreateChildrenFunc) (TestCaseGroup* testGroup);
+
+								TestGroupHelper0	(TestContext& testCtx, const std::string& name, const std::string& description, CreateChildrenFunc createChildren)
+									: TestCaseGroup		(testCtx, name.c_str(), description.c_str())
+									, m_createChildren	(createChildren)
+								{
+								}
+
+	void						init				(void) { m_createChildren(this); }
+
+private:
+	const CreateChildrenFunc	m_createChildren;
+};
+
+template<typename Arg0>
+class TestGroupHelper1 : public TestCaseGroup
+{
+public:
+	typedef void (*CreateChildrenFunc) (TestCaseGroup* testGroup, Arg0 arg0);
+
+								TestGroupHelper1	(TestContext& testCtx, const std::string& name, const std::string& description, CreateChildrenFunc createChildren, const Arg0& arg0)
+									: TestCaseGroup		(testCtx, name.c_str(), description.c_str())
+									, m_createChildren	(createChildren)
+									, m_arg0			(arg0)
+								{
+								}
+
+	void						init				(void) { m_createChildren(this, m_arg0); }
+
+private:
+	const CreateChildrenFunc	m_createChildren;
+	const Arg0					m_arg0;
+};
+
+template<typename Arg0, typename Arg1>
+class TestGroupHelper2 : public TestCaseGroup
+{
+public:
+	typedef void (*CreateChildrenFunc) (TestCaseGroup* testGroup, Arg0 arg0, Arg1 arg1);
+
+								TestGroupHelper2	(TestContext& testCtx, const std::string& name, const std::string& description, CreateChildrenFunc createChildren, const Arg0& arg0, const Arg1& arg1)
+									: TestCaseGroup		(testCtx, name.c_str(), description.c_str())
+									, m_createChildren	(createChildren)
+									, m_arg0			(arg0)
+									, m_arg1			(arg1)
+								{
+								}
+
+	void						init				(void) { m_createChildren(this, m_arg0, m_arg1); }
+
+private:
+	const CreateChildrenFunc	m_createChildren;
+	const Arg0					m_arg0;
+	const Arg1					m_arg1;
+};
+
+template<typename Arg0, typename Arg1, typename Arg2>
+class TestGroupHelper3 : public TestCaseGroup
+{
+public:
+	typedef void (*CreateChildrenFunc) (TestCaseGroup* testGroup, Arg0 arg0, Arg1 arg1, Arg2 arg2);
+
+								TestGroupHelper3	(TestContext& testCtx, const std::string& name, const std::string& description, CreateChildrenFunc createChildren, const Arg0& arg0, const Arg1& arg1, const Arg2& arg2)
+									: TestCaseGroup		(testCtx, name.c_str(), description.c_str())
+									, m_createChildren	(createChildren)
+									, m_arg0			(arg0)
+									, m_arg1			(arg1)
+									, m_arg2			(arg2)
+								{
+								}
+
+	void						init				(void) { m_createChildren(this, m_arg0, m_arg1, m_arg2); }
+
+private:
+	const CreateChildrenFunc	m_createChildren;
+	const Arg0					m_arg0;
+	const Arg1					m_arg1;
+	const Arg2					m_arg2;
+};
+
+namespace detail
+{
+
+//! Prevents deducing template argument from function argument.
+template<typename T>
+struct NonDeduced
+{
+	typedef T Type;
+};
+
+} // detail
+
+// \note Arguments are stored by value. Argument types are deduced from createChildren only.
+
+inline TestCaseGroup* createTestGroup (TestContext& testCtx, const std::string& name, const std::string& description, void (*createChildren)(TestCaseGroup*))
+{
+	return new TestGroupHelper0(testCtx, name, description, createChildren);
+}
+
+template<typename Arg0>
+TestCaseGroup* createTestGroup (TestContext&									testCtx,
+								const std::string&								name,
+								const std::string&								description,
+								void											(*createChildren)(TestCaseGroup*, Arg0),
+								const typename detail::NonDeduced<Arg0>::Type&	arg0)
+{
+	return new TestGroupHelper1<Arg0>(testCtx, name, description, createChildren, arg0);
+}
+
+template<typename Arg0, typename Arg1>
+TestCaseGroup* createTestGroup (TestContext&									testCtx,
+								const std::string&								name,
+								const std::string&								description,
+								void											(*createChildren)(TestCaseGroup*, Arg0, Arg1),
+								const typename detail::NonDeduced<Arg0>::Type&	arg0,
+								const typename detail::NonDeduced<Arg1>::Type&	arg1)
+{
+	return new TestGroupHelper2<Arg0, Arg1>(testCtx, name, description, createChildren, arg0, arg1);
+}
+
+template<typename Arg0, typename Arg1, typename Arg2>
+TestCaseGroup* createTestGroup (TestContext&									testCtx,
+								const std::string&								name,
+								const std::string&								description,
+								void											(*createChildren)(TestCaseGroup*, Arg0, Arg1, Arg2),
+								const typename detail::NonDeduced<Arg0>::Type&	arg0,
+								const typename detail::NonDeduced<Arg1>::Type&	arg1,
+								const typename detail::NonDeduced<Arg2>::Type&	arg2)
+{
+	return new TestGroupHelper3<Arg0, Arg1, Arg2>(testCtx, name, description, createChildren, arg0, arg1, arg2);
+}
+
+} // tcu
+
+#endif // _TCUTESTGROUPUTIL_HPP
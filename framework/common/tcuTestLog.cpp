@@ -285,6 +285,11 @@ void TestLog::writeImage (const char* name, const char* description, qpImageComp
 		throw LogWriteFailedError();
 }
 
+void TestLog::setImageEncoding (int compressionLevel, qpImageFilter filter)
+{
+	qpTestLog_setImageEncoding(m_log, compressionLevel, filter);
+}
+
 void TestLog::startSection (const char* name, const char* description)
 {
 	if (qpTestLog_startSection(m_log, name, description) == DE_FALSE)
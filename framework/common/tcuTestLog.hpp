@@ -136,6 +136,7 @@ public:
 	void				endImageSet				(void);
 	void				writeImage				(const char* name, const char* description, const ConstPixelBufferAccess& surface, const Vec4& scale, const Vec4& bias, qpImageCompressionMode compressionMode = QP_IMAGE_COMPRESSION_MODE_BEST);
 	void				writeImage				(const char* name, const char* description, qpImageCompressionMode compressionMode, qpImageFormat format, int width, int height, int stride, const void* data);
+	void				setImageEncoding		(int compressionLevel, qpImageFilter filter);
 
 	void				startSection			(const char* name, const char* description);
 	void				endSection				(void);
@@ -31,8 +31,10 @@
 #include "tcuFloat.hpp"
 #include "tcuTextureUtil.hpp"
 #include "deStringUtil.hpp"
+#include "deRandom.hpp"
 
 #include <limits>
+#include <vector>
 
 namespace tcu
 {
@@ -520,87 +522,16 @@ int TextureFormat::getPixelSize (void) const
 	}
 }
 
-ConstPixelBufferAccess::ConstPixelBufferAccess (void)
-	: m_width		(0)
-	, m_height		(0)
-	, m_depth		(0)
-	, m_rowPitch	(0)
-	, m_slicePitch	(0)
-	, m_data		(DE_NULL)
-{
-}
-
-ConstPixelBufferAccess::ConstPixelBufferAccess (const TextureFormat& format, int width, int height, int depth, const void* data)
-	: m_format		(format)
-	, m_width		(width)
-	, m_height		(height)
-	, m_depth		(depth)
-	, m_rowPitch	(width*format.getPixelSize())
-	, m_slicePitch	(m_rowPitch*height)
-	, m_data		((void*)data)
-{
-}
-
-ConstPixelBufferAccess::ConstPixelBufferAccess (const TextureFormat& format, int width, int height, int depth, int rowPitch, int slicePitch, const void* data)
-	: m_format		(format)
-	, m_width		(width)
-	, m_height		(height)
-	, m_depth		(depth)
-	, m_rowPitch	(rowPitch)
-	, m_slicePitch	(slicePitch)
-	, m_data		((void*)data)
-{
-}
-
-ConstPixelBufferAccess::ConstPixelBufferAccess (const TextureLevel& level)
-	: m_format		(level.getFormat())
-	, m_width		(level.getWidth())
-	, m_height		(level.getHeight())
-	, m_depth		(level.getDepth())
-	, m_rowPitch	(m_width*m_format.getPixelSize())
-	, m_slicePitch	(m_rowPitch*m_height)
-	, m_data		((void*)level.getPtr())
-{
-}
-
-PixelBufferAccess::PixelBufferAccess (const TextureFormat& format, int width, int height, int depth, void* data)
-	: ConstPixelBufferAccess(format, width, height, depth, data)
-{
-}
-
-PixelBufferAccess::PixelBufferAccess (const TextureFormat& format, int width, int height, int depth, int rowPitch, int slicePitch, void* data)
-	: ConstPixelBufferAccess(format, width, height, depth, rowPitch, slicePitch, data)
+namespace
 {
-}
 
-PixelBufferAccess::PixelBufferAccess (TextureLevel& level)
-	: ConstPixelBufferAccess(level)
-{
-}
+// Generic pixel access paths, used for formats without a specialized access path.
 
-void PixelBufferAccess::setPixels (const void* buf, int bufSize) const
-{
-	DE_ASSERT(bufSize == getDataSize());
-	deMemcpy(getDataPtr(), buf, bufSize);
-}
-
-Vec4 ConstPixelBufferAccess::getPixel (int x, int y, int z) const
+Vec4 readPixelGeneric (const ConstPixelBufferAccess& access, int x, int y, int z)
 {
-	DE_ASSERT(de::inBounds(x, 0, m_width));
-	DE_ASSERT(de::inBounds(y, 0, m_height));
-	DE_ASSERT(de::inBounds(z, 0, m_depth));
-
-	// Optimized fomats.
-	if (m_format.type == TextureFormat::UNORM_INT8)
-	{
-		if (m_format.order == TextureFormat::RGBA)
-			return readRGBA8888Float((const deUint8*)getDataPtr() + z*m_slicePitch + y*m_rowPitch + x*4);
-		else if (m_format.order == TextureFormat::RGB)
-			return readRGB888Float((const deUint8*)getDataPtr() + z*m_slicePitch + y*m_rowPitch + x*3);
-	}
-
-	int				pixelSize		= m_format.getPixelSize();
-	const deUint8*	pixelPtr		= (const deUint8*)getDataPtr() + z*m_slicePitch + y*m_rowPitch + x*pixelSize;
+	const TextureFormat&	format		= access.getFormat();
+	int				pixelSize		= format.getPixelSize();
+	const deUint8*	pixelPtr		= (const deUint8*)access.getDataPtr() + z*access.getSlicePitch() + y*access.getRowPitch() + x*pixelSize;
 
 #define UB16(OFFS, COUNT)		((*((const deUint16*)pixelPtr) >> (OFFS)) & ((1<<(COUNT))-1))
 #define UB32(OFFS, COUNT)		((*((const deUint32*)pixelPtr) >> (OFFS)) & ((1<<(COUNT))-1))
@@ -608,7 +539,7 @@ Vec4 ConstPixelBufferAccess::getPixel (int x, int y, int z) const
 #define NB32(OFFS, COUNT)		channelToNormFloat(UB32(OFFS, COUNT), (COUNT))
 
 	// Packed formats.
-	switch (m_format.type)
+	switch (format.type)
 	{
 		case TextureFormat::UNORM_SHORT_565:			return Vec4(NB16(11,  5), NB16( 5,  6), NB16( 0,  5), 1.0f);
 		case TextureFormat::UNORM_SHORT_555:			return Vec4(NB16(10,  5), NB16( 5,  5), NB16( 0,  5), 1.0f);
@@ -620,7 +551,7 @@ Vec4 ConstPixelBufferAccess::getPixel (int x, int y, int z) const
 		case TextureFormat::UNSIGNED_INT_999_E5_REV:	return unpackRGB999E5(*((const deUint32*)pixelPtr));
 
 		case TextureFormat::UNSIGNED_INT_24_8:
-			switch (m_format.order)
+			switch (format.order)
 			{
 				// \note Stencil is always ignored.
 				case TextureFormat::D:	return Vec4(NB32(8, 24), 0.0f, 0.0f, 1.0f);
@@ -631,7 +562,7 @@ Vec4 ConstPixelBufferAccess::getPixel (int x, int y, int z) const
 
 		case TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV:
 		{
-			DE_ASSERT(m_format.order == TextureFormat::DS);
+			DE_ASSERT(format.order == TextureFormat::DS);
 			float	d	= *((const float*)pixelPtr);
 			// \note Stencil is ignored.
 //			deUint8	s	= *((const deUint32*)(pixelPtr+4)) & 0xff;
@@ -652,8 +583,8 @@ Vec4 ConstPixelBufferAccess::getPixel (int x, int y, int z) const
 
 	// Generic path.
 	Vec4			result;
-	const Channel*	channelMap	= getChannelReadMap(m_format.order);
-	int				channelSize	= getChannelSize(m_format.type);
+	const Channel*	channelMap	= getChannelReadMap(format.order);
+	int				channelSize	= getChannelSize(format.type);
 
 	for (int c = 0; c < 4; c++)
 	{
@@ -663,33 +594,23 @@ Vec4 ConstPixelBufferAccess::getPixel (int x, int y, int z) const
 		else if (map == CHANNEL_ONE)
 			result[c] = 1.0f;
 		else
-			result[c] = channelToFloat(pixelPtr + channelSize*((int)map), m_format.type);
+			result[c] = channelToFloat(pixelPtr + channelSize*((int)map), format.type);
 	}
 
 	return result;
 }
 
-IVec4 ConstPixelBufferAccess::getPixelInt (int x, int y, int z) const
+IVec4 readPixelIntGeneric (const ConstPixelBufferAccess& access, int x, int y, int z)
 {
-	DE_ASSERT(de::inBounds(x, 0, m_width));
-	DE_ASSERT(de::inBounds(y, 0, m_height));
-	DE_ASSERT(de::inBounds(z, 0, m_depth));
-
-	int				pixelSize		= m_format.getPixelSize();
-	const deUint8*	pixelPtr		= (const deUint8*)getDataPtr() + z*m_slicePitch + y*m_rowPitch + x*pixelSize;
+	const TextureFormat&	format		= access.getFormat();
+	int				pixelSize		= format.getPixelSize();
+	const deUint8*	pixelPtr		= (const deUint8*)access.getDataPtr() + z*access.getSlicePitch() + y*access.getRowPitch() + x*pixelSize;
 	IVec4			result;
 
-	// Optimized fomats.
-	if (m_format.type == TextureFormat::UNORM_INT8)
-	{
-		if (m_format.order == TextureFormat::RGBA)		return readRGBA8888Int(pixelPtr);
-		else if (m_format.order == TextureFormat::RGB)	return readRGB888Int(pixelPtr);
-	}
-
 #define U16(OFFS, COUNT)		((*((const deUint16*)pixelPtr) >> (OFFS)) & ((1<<(COUNT))-1))
 #define U32(OFFS, COUNT)		((*((const deUint32*)pixelPtr) >> (OFFS)) & ((1<<(COUNT))-1))
 
-	switch (m_format.type)
+	switch (format.type)
 	{
 		case TextureFormat::UNORM_SHORT_565:			return UVec4(U16(11,  5), U16( 5,  6), U16( 0,  5), 1).cast<int>();
 		case TextureFormat::UNORM_SHORT_555:			return UVec4(U16(10,  5), U16( 5,  5), U16( 0,  5), 1).cast<int>();
@@ -700,7 +621,7 @@ IVec4 ConstPixelBufferAccess::getPixelInt (int x, int y, int z) const
 		case TextureFormat::UNSIGNED_INT_1010102_REV:	return UVec4(U32( 0, 10), U32(10, 10), U32(20, 10), U32(30, 2)).cast<int>();
 
 		case TextureFormat::UNSIGNED_INT_24_8:
-			switch (m_format.order)
+			switch (format.order)
 			{
 				case TextureFormat::D:	return UVec4(U32(8, 24), 0, 0, 1).cast<int>();
 				case TextureFormat::S:	return UVec4(0, 0, 0, U32(8, 24)).cast<int>();
@@ -711,7 +632,7 @@ IVec4 ConstPixelBufferAccess::getPixelInt (int x, int y, int z) const
 
 		case TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV:
 		{
-			DE_ASSERT(m_format.order == TextureFormat::DS);
+			DE_ASSERT(format.order == TextureFormat::DS);
 			float	d	= *((const float*)pixelPtr);
 			deUint8	s	= *((const deUint32*)(pixelPtr+4)) & 0xffu;
 			// \note Returns bit-representation of depth floating-point value.
@@ -726,8 +647,8 @@ IVec4 ConstPixelBufferAccess::getPixelInt (int x, int y, int z) const
 #undef U32
 
 	// Generic path.
-	const Channel*	channelMap	= getChannelReadMap(m_format.order);
-	int				channelSize	= getChannelSize(m_format.type);
+	const Channel*	channelMap	= getChannelReadMap(format.order);
+	int				channelSize	= getChannelSize(format.type);
 
 	for (int c = 0; c < 4; c++)
 	{
@@ -737,108 +658,563 @@ IVec4 ConstPixelBufferAccess::getPixelInt (int x, int y, int z) const
 		else if (map == CHANNEL_ONE)
 			result[c] = 1;
 		else
-			result[c] = channelToInt(pixelPtr + channelSize*((int)map), m_format.type);
+			result[c] = channelToInt(pixelPtr + channelSize*((int)map), format.type);
 	}
 
 	return result;
 }
 
-template<>
-Vec4 ConstPixelBufferAccess::getPixelT (int x, int y, int z) const
-{
-	return getPixel(x, y, z);
-}
-
-template<>
-IVec4 ConstPixelBufferAccess::getPixelT (int x, int y, int z) const
+void writePixelGeneric (const PixelBufferAccess& access, const Vec4& color, int x, int y, int z)
 {
-	return getPixelInt(x, y, z);
-}
+	const TextureFormat&	format		= access.getFormat();
+	const int		pixelSize	= format.getPixelSize();
+	deUint8* const	pixelPtr	= (deUint8*)access.getDataPtr() + z*access.getSlicePitch() + y*access.getRowPitch() + x*pixelSize;
 
-template<>
-UVec4 ConstPixelBufferAccess::getPixelT (int x, int y, int z) const
-{
-	return getPixelUint(x, y, z);
-}
+#define PN(VAL, OFFS, BITS)		(normFloatToChannel((VAL), (BITS)) << (OFFS))
+#define PU(VAL, OFFS, BITS)		(uintToChannel((VAL), (BITS)) << (OFFS))
 
-float ConstPixelBufferAccess::getPixDepth (int x, int y, int z) const
-{
-	DE_ASSERT(de::inBounds(x, 0, getWidth()));
-	DE_ASSERT(de::inBounds(y, 0, getHeight()));
-	DE_ASSERT(de::inBounds(z, 0, getDepth()));
+	switch (format.type)
+	{
+		case TextureFormat::UNORM_SHORT_565:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 11, 5) | PN(color[1], 5, 6) | PN(color[2], 0, 5));							break;
+		case TextureFormat::UNORM_SHORT_555:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 10, 5) | PN(color[1], 5, 5) | PN(color[2], 0, 5));							break;
+		case TextureFormat::UNORM_SHORT_4444:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 12, 4) | PN(color[1], 8, 4) | PN(color[2], 4, 4) | PN(color[3], 0, 4));	break;
+		case TextureFormat::UNORM_SHORT_5551:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 11, 5) | PN(color[1], 6, 5) | PN(color[2], 1, 5) | PN(color[3], 0, 1));	break;
+		case TextureFormat::UNORM_INT_101010:		*((deUint32*)pixelPtr) = PN(color[0], 22, 10) | PN(color[1], 12, 10) | PN(color[2], 2, 10);									break;
+		case TextureFormat::UNORM_INT_1010102_REV:	*((deUint32*)pixelPtr) = PN(color[0],  0, 10) | PN(color[1], 10, 10) | PN(color[2], 20, 10) | PN(color[3], 30, 2);			break;
 
-	int			pixelSize	= m_format.getPixelSize();
-	deUint8*	pixelPtr	= (deUint8*)getDataPtr() + z*m_slicePitch + y*m_rowPitch + x*pixelSize;
+		case TextureFormat::UNSIGNED_INT_1010102_REV:
+		{
+			UVec4 u = color.cast<deUint32>();
+			*((deUint32*)pixelPtr) = PU(u[0], 0, 10) | PU(u[1], 10, 10) |PU(u[2], 20, 10) | PU(u[3], 30, 2);
+			break;
+		}
 
-#define UB32(OFFS, COUNT) ((*((const deUint32*)pixelPtr) >> (OFFS)) & ((1<<(COUNT))-1))
-#define NB32(OFFS, COUNT) channelToNormFloat(UB32(OFFS, COUNT), (COUNT))
+		case TextureFormat::UNSIGNED_INT_11F_11F_10F_REV:
+			*((deUint32*)pixelPtr) = Float11(color[0]).bits() | (Float11(color[1]).bits() << 11) | (Float10(color[2]).bits() << 22);
+			break;
 
-	DE_ASSERT(m_format.order == TextureFormat::DS || m_format.order == TextureFormat::D);
+		case TextureFormat::UNSIGNED_INT_999_E5_REV:
+			*((deUint32*)pixelPtr) = packRGB999E5(color);
+			break;
 
-	switch (m_format.type)
-	{
 		case TextureFormat::UNSIGNED_INT_24_8:
-			switch (m_format.order)
+			switch (format.order)
 			{
-				case TextureFormat::D:
-				case TextureFormat::DS: // \note Fall-through.
-					return NB32(8, 24);
+				case TextureFormat::D:		*((deUint32*)pixelPtr) = PN(color[0], 8, 24);									break;
+				case TextureFormat::S:		*((deUint32*)pixelPtr) = PN(color[3], 8, 24);									break;
+				case TextureFormat::DS:		*((deUint32*)pixelPtr) = PN(color[0], 8, 24) | PU((deUint32)color[3], 0, 8);	break;
 				default:
 					DE_ASSERT(false);
-					return 0.0f;
 			}
+			break;
 
 		case TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV:
-			DE_ASSERT(m_format.order == TextureFormat::DS);
-			return *((const float*)pixelPtr);
+			DE_ASSERT(format.order == TextureFormat::DS);
+			*((float*)pixelPtr)			= color[0];
+			*((deUint32*)(pixelPtr+4))	= PU((deUint32)color[3], 0, 8);
+			break;
+
+		case TextureFormat::FLOAT:
+			if (format.order == TextureFormat::D)
+			{
+				*((float*)pixelPtr) = color[0];
+				break;
+			}
+			// else fall-through to default case!
 
 		default:
-			DE_ASSERT(m_format.order == TextureFormat::D || m_format.order == TextureFormat::DS);
-			return channelToFloat(pixelPtr, m_format.type);
+		{
+			// Generic path.
+			int			numChannels	= getNumUsedChannels(format.order);
+			const int*	map			= getChannelWriteMap(format.order);
+			int			channelSize	= getChannelSize(format.type);
+
+			for (int c = 0; c < numChannels; c++)
+				floatToChannel(pixelPtr + channelSize*c, color[map[c]], format.type);
+
+			break;
+		}
 	}
 
-#undef UB32
-#undef NB32
+#undef PN
+#undef PU
 }
 
-int ConstPixelBufferAccess::getPixStencil (int x, int y, int z) const
+void writePixelIntGeneric (const PixelBufferAccess& access, const IVec4& color, int x, int y, int z)
 {
-	DE_ASSERT(de::inBounds(x, 0, getWidth()));
-	DE_ASSERT(de::inBounds(y, 0, getHeight()));
-	DE_ASSERT(de::inBounds(z, 0, getDepth()));
+	const TextureFormat&	format		= access.getFormat();
+	int			pixelSize	= format.getPixelSize();
+	deUint8*	pixelPtr	= (deUint8*)access.getDataPtr() + z*access.getSlicePitch() + y*access.getRowPitch() + x*pixelSize;
 
-	int			pixelSize	= m_format.getPixelSize();
-	deUint8*	pixelPtr	= (deUint8*)getDataPtr() + z*m_slicePitch + y*m_rowPitch + x*pixelSize;
+#define PU(VAL, OFFS, BITS)		(uintToChannel((deUint32)(VAL), (BITS)) << (OFFS))
 
-	switch (m_format.type)
+	switch (format.type)
 	{
+		case TextureFormat::UNORM_SHORT_565:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 11, 5) | PU(color[1], 5, 6) | PU(color[2], 0, 5));							break;
+		case TextureFormat::UNORM_SHORT_555:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 10, 5) | PU(color[1], 5, 5) | PU(color[2], 0, 5));							break;
+		case TextureFormat::UNORM_SHORT_4444:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 12, 4) | PU(color[1], 8, 4) | PU(color[2], 4, 4) | PU(color[3], 0, 4));	break;
+		case TextureFormat::UNORM_SHORT_5551:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 11, 5) | PU(color[1], 6, 5) | PU(color[2], 1, 5) | PU(color[3], 0, 1));	break;
+		case TextureFormat::UNORM_INT_101010:			*((deUint32*)pixelPtr) = PU(color[0], 22, 10) | PU(color[1], 12, 10) | PU(color[2], 2, 10);									break;
+		case TextureFormat::UNORM_INT_1010102_REV:		*((deUint32*)pixelPtr) = PU(color[0],  0, 10) | PU(color[1], 10, 10) | PU(color[2], 20, 10) | PU(color[3], 30, 2);			break;
+		case TextureFormat::UNSIGNED_INT_1010102_REV:	*((deUint32*)pixelPtr) = PU(color[0],  0, 10) | PU(color[1], 10, 10) | PU(color[2], 20, 10) | PU(color[3], 30, 2);			break;
+
 		case TextureFormat::UNSIGNED_INT_24_8:
-			switch (m_format.order)
+			switch (format.order)
 			{
-				case TextureFormat::S:		return (int)(*((const deUint32*)pixelPtr) >> 8);
-				case TextureFormat::DS:		return (int)(*((const deUint32*)pixelPtr) & 0xff);
-
+				case TextureFormat::D:		*((deUint32*)pixelPtr) = PU(color[0], 8, 24);										break;
+				case TextureFormat::S:		*((deUint32*)pixelPtr) = PU(color[3], 8, 24);										break;
+				case TextureFormat::DS:		*((deUint32*)pixelPtr) = PU(color[0], 8, 24) | PU((deUint32)color[3], 0, 8);		break;
 				default:
 					DE_ASSERT(false);
-					return 0;
 			}
+			break;
 
 		case TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV:
-			DE_ASSERT(m_format.order == TextureFormat::DS);
-			return *((const deUint32*)(pixelPtr+4)) & 0xff;
+			DE_ASSERT(format.order == TextureFormat::DS);
+			*((deUint32*)pixelPtr)		= color[0];
+			*((deUint32*)(pixelPtr+4))	= PU((deUint32)color[3], 0, 8);
+			break;
 
 		default:
 		{
-			if (m_format.order == TextureFormat::S)
-				return channelToInt(pixelPtr, m_format.type);
-			else
-			{
-				DE_ASSERT(m_format.order == TextureFormat::DS);
-				const int stencilChannelIndex = 3;
-				return channelToInt(pixelPtr + getChannelSize(m_format.type)*stencilChannelIndex, m_format.type);
-			}
+			// Generic path.
+			int			numChannels	= getNumUsedChannels(format.order);
+			const int*	map			= getChannelWriteMap(format.order);
+			int			channelSize	= getChannelSize(format.type);
+
+			for (int c = 0; c < numChannels; c++)
+				intToChannel(pixelPtr + channelSize*c, color[map[c]], format.type);
+
+			break;
 		}
 	}
+
+#undef PU
+}
+
+void readRowGeneric (const ConstPixelBufferAccess& access, Vec4* dst, int x, int y, int z, int numPixels)
+{
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		dst[ndx] = readPixelGeneric(access, x+ndx, y, z);
+}
+
+void readRowIntGeneric (const ConstPixelBufferAccess& access, IVec4* dst, int x, int y, int z, int numPixels)
+{
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		dst[ndx] = readPixelIntGeneric(access, x+ndx, y, z);
+}
+
+void writeRowGeneric (const PixelBufferAccess& access, const Vec4* src, int x, int y, int z, int numPixels)
+{
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		writePixelGeneric(access, src[ndx], x+ndx, y, z);
+}
+
+void writeRowIntGeneric (const PixelBufferAccess& access, const IVec4* src, int x, int y, int z, int numPixels)
+{
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		writePixelIntGeneric(access, src[ndx], x+ndx, y, z);
+}
+
+// Specialized access paths for common formats. Each access type implements
+// exactly the same conversions as the generic path for that format, except
+// that RGB888 integer reads return 0xff alpha.
+
+struct RGBA8888Access
+{
+	enum { PIXEL_SIZE = 4 };
+
+	static Vec4		readFloat	(const deUint8* ptr)					{ return readRGBA8888Float(ptr);	}
+	static IVec4	readInt		(const deUint8* ptr)					{ return readRGBA8888Int(ptr);		}
+	static void		writeFloat	(deUint8* ptr, const Vec4& color)		{ writeRGBA8888Float(ptr, color);	}
+	static void		writeInt	(deUint8* ptr, const IVec4& color)		{ writeRGBA8888Int(ptr, color);		}
+};
+
+struct RGB888Access
+{
+	enum { PIXEL_SIZE = 3 };
+
+	static Vec4		readFloat	(const deUint8* ptr)					{ return readRGB888Float(ptr);		}
+	static IVec4	readInt		(const deUint8* ptr)					{ return readRGB888Int(ptr);		}
+	static void		writeFloat	(deUint8* ptr, const Vec4& color)		{ writeRGB888Float(ptr, color);		}
+	static void		writeInt	(deUint8* ptr, const IVec4& color)		{ writeRGB888Int(ptr, color);		}
+};
+
+struct RGBAFloatAccess
+{
+	enum { PIXEL_SIZE = 16 };
+
+	static Vec4 readFloat (const deUint8* ptr)
+	{
+		const float* const p = (const float*)ptr;
+		return Vec4(p[0], p[1], p[2], p[3]);
+	}
+
+	static IVec4 readInt (const deUint8* ptr)
+	{
+		const float* const p = (const float*)ptr;
+		return IVec4((int)p[0], (int)p[1], (int)p[2], (int)p[3]);
+	}
+
+	static void writeFloat (deUint8* ptr, const Vec4& color)
+	{
+		float* const p = (float*)ptr;
+		p[0] = color[0];
+		p[1] = color[1];
+		p[2] = color[2];
+		p[3] = color[3];
+	}
+
+	static void writeInt (deUint8* ptr, const IVec4& color)
+	{
+		float* const p = (float*)ptr;
+		p[0] = (float)color[0];
+		p[1] = (float)color[1];
+		p[2] = (float)color[2];
+		p[3] = (float)color[3];
+	}
+};
+
+struct RGBAHalfFloatAccess
+{
+	enum { PIXEL_SIZE = 8 };
+
+	static Vec4 readFloat (const deUint8* ptr)
+	{
+		const deFloat16* const p = (const deFloat16*)ptr;
+		return Vec4(deFloat16To32(p[0]), deFloat16To32(p[1]), deFloat16To32(p[2]), deFloat16To32(p[3]));
+	}
+
+	static IVec4 readInt (const deUint8* ptr)
+	{
+		return readFloat(ptr).cast<int>();
+	}
+
+	static void writeFloat (deUint8* ptr, const Vec4& color)
+	{
+		deFloat16* const p = (deFloat16*)ptr;
+		p[0] = deFloat32To16(color[0]);
+		p[1] = deFloat32To16(color[1]);
+		p[2] = deFloat32To16(color[2]);
+		p[3] = deFloat32To16(color[3]);
+	}
+
+	static void writeInt (deUint8* ptr, const IVec4& color)
+	{
+		writeFloat(ptr, color.cast<float>());
+	}
+};
+
+struct DepthFloatAccess
+{
+	enum { PIXEL_SIZE = 4 };
+
+	static Vec4		readFloat	(const deUint8* ptr)					{ return Vec4(*(const float*)ptr, 0.0f, 0.0f, 1.0f);		}
+	static IVec4	readInt		(const deUint8* ptr)					{ return IVec4((int)*(const float*)ptr, 0, 0, 1);			}
+	static void		writeFloat	(deUint8* ptr, const Vec4& color)		{ *(float*)ptr = color[0];									}
+	static void		writeInt	(deUint8* ptr, const IVec4& color)		{ *(float*)ptr = (float)color[0];							}
+};
+
+struct Depth24Stencil8Access
+{
+	enum { PIXEL_SIZE = 4 };
+
+	// \note Stencil is ignored in float reads, like in the generic path.
+	static Vec4 readFloat (const deUint8* ptr)
+	{
+		return Vec4(channelToNormFloat((*(const deUint32*)ptr >> 8) & 0xffffffu, 24), 0.0f, 0.0f, 1.0f);
+	}
+
+	static IVec4 readInt (const deUint8* ptr)
+	{
+		const deUint32 v = *(const deUint32*)ptr;
+		return UVec4((v >> 8) & 0xffffffu, 0, 0, v & 0xffu).cast<int>();
+	}
+
+	static void writeFloat (deUint8* ptr, const Vec4& color)
+	{
+		*(deUint32*)ptr = (normFloatToChannel(color[0], 24) << 8) | uintToChannel((deUint32)color[3], 8);
+	}
+
+	static void writeInt (deUint8* ptr, const IVec4& color)
+	{
+		*(deUint32*)ptr = (uintToChannel((deUint32)color[0], 24) << 8) | uintToChannel((deUint32)color[3], 8);
+	}
+};
+
+template<class Access>
+inline const deUint8* getPixelPtr (const ConstPixelBufferAccess& access, int x, int y, int z)
+{
+	return (const deUint8*)access.getDataPtr() + z*access.getSlicePitch() + y*access.getRowPitch() + x*(int)Access::PIXEL_SIZE;
+}
+
+template<class Access>
+inline deUint8* getPixelPtr (const PixelBufferAccess& access, int x, int y, int z)
+{
+	return (deUint8*)access.getDataPtr() + z*access.getSlicePitch() + y*access.getRowPitch() + x*(int)Access::PIXEL_SIZE;
+}
+
+template<class Access>
+Vec4 readPixel (const ConstPixelBufferAccess& access, int x, int y, int z)
+{
+	return Access::readFloat(getPixelPtr<Access>(access, x, y, z));
+}
+
+template<class Access>
+IVec4 readPixelInt (const ConstPixelBufferAccess& access, int x, int y, int z)
+{
+	return Access::readInt(getPixelPtr<Access>(access, x, y, z));
+}
+
+template<class Access>
+void writePixel (const PixelBufferAccess& access, const Vec4& color, int x, int y, int z)
+{
+	Access::writeFloat(getPixelPtr<Access>(access, x, y, z), color);
+}
+
+template<class Access>
+void writePixelInt (const PixelBufferAccess& access, const IVec4& color, int x, int y, int z)
+{
+	Access::writeInt(getPixelPtr<Access>(access, x, y, z), color);
+}
+
+template<class Access>
+void readRow (const ConstPixelBufferAccess& access, Vec4* dst, int x, int y, int z, int numPixels)
+{
+	const deUint8* const ptr = getPixelPtr<Access>(access, x, y, z);
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		dst[ndx] = Access::readFloat(ptr + ndx*(int)Access::PIXEL_SIZE);
+}
+
+template<class Access>
+void readRowInt (const ConstPixelBufferAccess& access, IVec4* dst, int x, int y, int z, int numPixels)
+{
+	const deUint8* const ptr = getPixelPtr<Access>(access, x, y, z);
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		dst[ndx] = Access::readInt(ptr + ndx*(int)Access::PIXEL_SIZE);
+}
+
+template<class Access>
+void writeRow (const PixelBufferAccess& access, const Vec4* src, int x, int y, int z, int numPixels)
+{
+	deUint8* const ptr = getPixelPtr<Access>(access, x, y, z);
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		Access::writeFloat(ptr + ndx*(int)Access::PIXEL_SIZE, src[ndx]);
+}
+
+template<class Access>
+void writeRowInt (const PixelBufferAccess& access, const IVec4* src, int x, int y, int z, int numPixels)
+{
+	deUint8* const ptr = getPixelPtr<Access>(access, x, y, z);
+
+	for (int ndx = 0; ndx < numPixels; ndx++)
+		Access::writeInt(ptr + ndx*(int)Access::PIXEL_SIZE, src[ndx]);
+}
+
+} // anonymous
+
+struct PixelAccessFuncs
+{
+	Vec4	(*readPixel)		(const ConstPixelBufferAccess& access, int x, int y, int z);
+	IVec4	(*readPixelInt)		(const ConstPixelBufferAccess& access, int x, int y, int z);
+	void	(*writePixel)		(const PixelBufferAccess& access, const Vec4& color, int x, int y, int z);
+	void	(*writePixelInt)	(const PixelBufferAccess& access, const IVec4& color, int x, int y, int z);
+
+	void	(*readRow)			(const ConstPixelBufferAccess& access, Vec4* dst, int x, int y, int z, int numPixels);
+	void	(*readRowInt)		(const ConstPixelBufferAccess& access, IVec4* dst, int x, int y, int z, int numPixels);
+	void	(*writeRow)			(const PixelBufferAccess& access, const Vec4* src, int x, int y, int z, int numPixels);
+	void	(*writeRowInt)		(const PixelBufferAccess& access, const IVec4* src, int x, int y, int z, int numPixels);
+};
+
+namespace
+{
+
+template<class Access>
+struct SpecializedAccessFuncs
+{
+	static const PixelAccessFuncs funcs;
+};
+
+template<class Access>
+const PixelAccessFuncs SpecializedAccessFuncs<Access>::funcs =
+{
+	readPixel<Access>,
+	readPixelInt<Access>,
+	writePixel<Access>,
+	writePixelInt<Access>,
+	readRow<Access>,
+	readRowInt<Access>,
+	writeRow<Access>,
+	writeRowInt<Access>
+};
+
+const PixelAccessFuncs s_genericAccessFuncs =
+{
+	readPixelGeneric,
+	readPixelIntGeneric,
+	writePixelGeneric,
+	writePixelIntGeneric,
+	readRowGeneric,
+	readRowIntGeneric,
+	writeRowGeneric,
+	writeRowIntGeneric
+};
+
+const PixelAccessFuncs* getPixelAccessFuncs (const TextureFormat& format)
+{
+	if (format.type == TextureFormat::UNORM_INT8)
+	{
+		if (format.order == TextureFormat::RGBA)
+			return &SpecializedAccessFuncs<RGBA8888Access>::funcs;
+		else if (format.order == TextureFormat::RGB)
+			return &SpecializedAccessFuncs<RGB888Access>::funcs;
+	}
+	else if (format.type == TextureFormat::FLOAT)
+	{
+		if (format.order == TextureFormat::RGBA)
+			return &SpecializedAccessFuncs<RGBAFloatAccess>::funcs;
+		else if (format.order == TextureFormat::D)
+			return &SpecializedAccessFuncs<DepthFloatAccess>::funcs;
+	}
+	else if (format.type == TextureFormat::HALF_FLOAT && format.order == TextureFormat::RGBA)
+		return &SpecializedAccessFuncs<RGBAHalfFloatAccess>::funcs;
+	else if (format.type == TextureFormat::UNSIGNED_INT_24_8 && format.order == TextureFormat::DS)
+		return &SpecializedAccessFuncs<Depth24Stencil8Access>::funcs;
+
+	return &s_genericAccessFuncs;
+}
+
+} // anonymous
+
+ConstPixelBufferAccess::ConstPixelBufferAccess (void)
+	: m_width		(0)
+	, m_height		(0)
+	, m_depth		(0)
+	, m_rowPitch	(0)
+	, m_slicePitch	(0)
+	, m_data		(DE_NULL)
+	, m_accessFuncs	(&s_genericAccessFuncs)
+{
+}
+
+ConstPixelBufferAccess::ConstPixelBufferAccess (const TextureFormat& format, int width, int height, int depth, const void* data)
+	: m_format		(format)
+	, m_width		(width)
+	, m_height		(height)
+	, m_depth		(depth)
+	, m_rowPitch	(width*format.getPixelSize())
+	, m_slicePitch	(m_rowPitch*height)
+	, m_data		((void*)data)
+	, m_accessFuncs	(getPixelAccessFuncs(format))
+{
+}
+
+ConstPixelBufferAccess::ConstPixelBufferAccess (const TextureFormat& format, int width, int height, int depth, int rowPitch, int slicePitch, const void* data)
+	: m_format		(format)
+	, m_width		(width)
+	, m_height		(height)
+	, m_depth		(depth)
+	, m_rowPitch	(rowPitch)
+	, m_slicePitch	(slicePitch)
+	, m_data		((void*)data)
+	, m_accessFuncs	(getPixelAccessFuncs(format))
+{
+}
+
+ConstPixelBufferAccess::ConstPixelBufferAccess (const TextureLevel& level)
+	: m_format		(level.getFormat())
+	, m_width		(level.getWidth())
+	, m_height		(level.getHeight())
+	, m_depth		(level.getDepth())
+	, m_rowPitch	(m_width*m_format.getPixelSize())
+	, m_slicePitch	(m_rowPitch*m_height)
+	, m_data		((void*)level.getPtr())
+	, m_accessFuncs	(getPixelAccessFuncs(m_format))
+{
+}
+
+PixelBufferAccess::PixelBufferAccess (const TextureFormat& format, int width, int height, int depth, void* data)
+	: ConstPixelBufferAccess(format, width, height, depth, data)
+{
+}
+
+PixelBufferAccess::PixelBufferAccess (const TextureFormat& format, int width, int height, int depth, int rowPitch, int slicePitch, void* data)
+	: ConstPixelBufferAccess(format, width, height, depth, rowPitch, slicePitch, data)
+{
+}
+
+PixelBufferAccess::PixelBufferAccess (TextureLevel& level)
+	: ConstPixelBufferAccess(level)
+{
+}
+
+void PixelBufferAccess::setPixels (const void* buf, int bufSize) const
+{
+	DE_ASSERT(bufSize == getDataSize());
+	deMemcpy(getDataPtr(), buf, bufSize);
+}
+
+template<>
+Vec4 ConstPixelBufferAccess::getPixelT (int x, int y, int z) const
+{
+	return getPixel(x, y, z);
+}
+
+template<>
+IVec4 ConstPixelBufferAccess::getPixelT (int x, int y, int z) const
+{
+	return getPixelInt(x, y, z);
+}
+
+template<>
+UVec4 ConstPixelBufferAccess::getPixelT (int x, int y, int z) const
+{
+	return getPixelUint(x, y, z);
+}
+
+Vec4 ConstPixelBufferAccess::getPixel (int x, int y, int z) const
+{
+	DE_ASSERT(de::inBounds(x, 0, m_width));
+	DE_ASSERT(de::inBounds(y, 0, m_height));
+	DE_ASSERT(de::inBounds(z, 0, m_depth));
+
+	return m_accessFuncs->readPixel(*this, x, y, z);
+}
+
+IVec4 ConstPixelBufferAccess::getPixelInt (int x, int y, int z) const
+{
+	DE_ASSERT(de::inBounds(x, 0, m_width));
+	DE_ASSERT(de::inBounds(y, 0, m_height));
+	DE_ASSERT(de::inBounds(z, 0, m_depth));
+
+	return m_accessFuncs->readPixelInt(*this, x, y, z);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Read consecutive pixels from a row
+ *
+ * Equivalent to calling getPixel() for pixels (x, y, z) ... (x+numPixels-1, y, z),
+ * but format dispatch is done only once per row.
+ *//*--------------------------------------------------------------------*/
+void ConstPixelBufferAccess::readRow (Vec4* dst, int x, int y, int z, int numPixels) const
+{
+	DE_ASSERT(numPixels >= 0 && x >= 0 && x+numPixels <= m_width);
+	DE_ASSERT(de::inBounds(y, 0, m_height));
+	DE_ASSERT(de::inBounds(z, 0, m_depth));
+
+	m_accessFuncs->readRow(*this, dst, x, y, z, numPixels);
+}
+
+void ConstPixelBufferAccess::readRow (IVec4* dst, int x, int y, int z, int numPixels) const
+{
+	DE_ASSERT(numPixels >= 0 && x >= 0 && x+numPixels <= m_width);
+	DE_ASSERT(de::inBounds(y, 0, m_height));
+	DE_ASSERT(de::inBounds(z, 0, m_depth));
+
+	m_accessFuncs->readRowInt(*this, dst, x, y, z, numPixels);
 }
 
 void PixelBufferAccess::setPixel (const Vec4& color, int x, int y, int z) const
@@ -847,97 +1223,83 @@ void PixelBufferAccess::setPixel (const Vec4& color, int x, int y, int z) const
 	DE_ASSERT(de::inBounds(y, 0, getHeight()));
 	DE_ASSERT(de::inBounds(z, 0, getDepth()));
 
-	// Optimized fomats.
-	if (m_format.type == TextureFormat::UNORM_INT8)
-	{
-		if (m_format.order == TextureFormat::RGBA)
-		{
-			deUint8* const ptr = (deUint8*)getDataPtr() + z*m_slicePitch + y*m_rowPitch + x*4;
-			writeRGBA8888Float(ptr, color);
-			return;
-		}
-		else if (m_format.order == TextureFormat::RGB)
-		{
-			deUint8* const ptr = (deUint8*)getDataPtr() + z*m_slicePitch + y*m_rowPitch + x*3;
-			writeRGB888Float(ptr, color);
-			return;
-		}
-	}
+	m_accessFuncs->writePixel(*this, color, x, y, z);
+}
 
-	const int		pixelSize	= m_format.getPixelSize();
-	deUint8* const	pixelPtr	= (deUint8*)getDataPtr() + z*m_slicePitch + y*m_rowPitch + x*pixelSize;
+void PixelBufferAccess::setPixel (const IVec4& color, int x, int y, int z) const
+{
+	DE_ASSERT(de::inBounds(x, 0, getWidth()));
+	DE_ASSERT(de::inBounds(y, 0, getHeight()));
+	DE_ASSERT(de::inBounds(z, 0, getDepth()));
 
-#define PN(VAL, OFFS, BITS)		(normFloatToChannel((VAL), (BITS)) << (OFFS))
-#define PU(VAL, OFFS, BITS)		(uintToChannel((VAL), (BITS)) << (OFFS))
+	m_accessFuncs->writePixelInt(*this, color, x, y, z);
+}
 
-	switch (m_format.type)
-	{
-		case TextureFormat::UNORM_SHORT_565:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 11, 5) | PN(color[1], 5, 6) | PN(color[2], 0, 5));							break;
-		case TextureFormat::UNORM_SHORT_555:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 10, 5) | PN(color[1], 5, 5) | PN(color[2], 0, 5));							break;
-		case TextureFormat::UNORM_SHORT_4444:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 12, 4) | PN(color[1], 8, 4) | PN(color[2], 4, 4) | PN(color[3], 0, 4));	break;
-		case TextureFormat::UNORM_SHORT_5551:		*((deUint16*)pixelPtr) = (deUint16)(PN(color[0], 11, 5) | PN(color[1], 6, 5) | PN(color[2], 1, 5) | PN(color[3], 0, 1));	break;
-		case TextureFormat::UNORM_INT_101010:		*((deUint32*)pixelPtr) = PN(color[0], 22, 10) | PN(color[1], 12, 10) | PN(color[2], 2, 10);									break;
-		case TextureFormat::UNORM_INT_1010102_REV:	*((deUint32*)pixelPtr) = PN(color[0],  0, 10) | PN(color[1], 10, 10) | PN(color[2], 20, 10) | PN(color[3], 30, 2);			break;
+/*--------------------------------------------------------------------*//*!
+ * \brief Write consecutive pixels to a row
+ *
+ * Equivalent to calling setPixel() for pixels (x, y, z) ... (x+numPixels-1, y, z),
+ * but format dispatch is done only once per row.
+ *//*--------------------------------------------------------------------*/
+void PixelBufferAccess::writeRow (const Vec4* src, int x, int y, int z, int numPixels) const
+{
+	DE_ASSERT(numPixels >= 0 && x >= 0 && x+numPixels <= getWidth());
+	DE_ASSERT(de::inBounds(y, 0, getHeight()));
+	DE_ASSERT(de::inBounds(z, 0, getDepth()));
 
-		case TextureFormat::UNSIGNED_INT_1010102_REV:
-		{
-			UVec4 u = color.cast<deUint32>();
-			*((deUint32*)pixelPtr) = PU(u[0], 0, 10) | PU(u[1], 10, 10) |PU(u[2], 20, 10) | PU(u[3], 30, 2);
-			break;
-		}
+	m_accessFuncs->writeRow(*this, src, x, y, z, numPixels);
+}
+
+void PixelBufferAccess::writeRow (const IVec4* src, int x, int y, int z, int numPixels) const
+{
+	DE_ASSERT(numPixels >= 0 && x >= 0 && x+numPixels <= getWidth());
+	DE_ASSERT(de::inBounds(y, 0, getHeight()));
+	DE_ASSERT(de::inBounds(z, 0, getDepth()));
+
+	m_accessFuncs->writeRowInt(*this, src, x, y, z, numPixels);
+}
+
+float ConstPixelBufferAccess::getPixDepth (int x, int y, int z) const
+{
+	DE_ASSERT(de::inBounds(x, 0, getWidth()));
+	DE_ASSERT(de::inBounds(y, 0, getHeight()));
+	DE_ASSERT(de::inBounds(z, 0, getDepth()));
+
+	int			pixelSize	= m_format.getPixelSize();
+	deUint8*	pixelPtr	= (deUint8*)getDataPtr() + z*m_slicePitch + y*m_rowPitch + x*pixelSize;
 
-		case TextureFormat::UNSIGNED_INT_11F_11F_10F_REV:
-			*((deUint32*)pixelPtr) = Float11(color[0]).bits() | (Float11(color[1]).bits() << 11) | (Float10(color[2]).bits() << 22);
-			break;
+#define UB32(OFFS, COUNT) ((*((const deUint32*)pixelPtr) >> (OFFS)) & ((1<<(COUNT))-1))
+#define NB32(OFFS, COUNT) channelToNormFloat(UB32(OFFS, COUNT), (COUNT))
 
-		case TextureFormat::UNSIGNED_INT_999_E5_REV:
-			*((deUint32*)pixelPtr) = packRGB999E5(color);
-			break;
+	DE_ASSERT(m_format.order == TextureFormat::DS || m_format.order == TextureFormat::D);
 
+	switch (m_format.type)
+	{
 		case TextureFormat::UNSIGNED_INT_24_8:
 			switch (m_format.order)
 			{
-				case TextureFormat::D:		*((deUint32*)pixelPtr) = PN(color[0], 8, 24);									break;
-				case TextureFormat::S:		*((deUint32*)pixelPtr) = PN(color[3], 8, 24);									break;
-				case TextureFormat::DS:		*((deUint32*)pixelPtr) = PN(color[0], 8, 24) | PU((deUint32)color[3], 0, 8);	break;
+				case TextureFormat::D:
+				case TextureFormat::DS: // \note Fall-through.
+					return NB32(8, 24);
 				default:
 					DE_ASSERT(false);
+					return 0.0f;
 			}
-			break;
 
 		case TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV:
 			DE_ASSERT(m_format.order == TextureFormat::DS);
-			*((float*)pixelPtr)			= color[0];
-			*((deUint32*)(pixelPtr+4))	= PU((deUint32)color[3], 0, 8);
-			break;
-
-		case TextureFormat::FLOAT:
-			if (m_format.order == TextureFormat::D)
-			{
-				*((float*)pixelPtr) = color[0];
-				break;
-			}
-			// else fall-through to default case!
+			return *((const float*)pixelPtr);
 
 		default:
-		{
-			// Generic path.
-			int			numChannels	= getNumUsedChannels(m_format.order);
-			const int*	map			= getChannelWriteMap(m_format.order);
-			int			channelSize	= getChannelSize(m_format.type);
-
-			for (int c = 0; c < numChannels; c++)
-				floatToChannel(pixelPtr + channelSize*c, color[map[c]], m_format.type);
-
-			break;
-		}
+			DE_ASSERT(m_format.order == TextureFormat::D || m_format.order == TextureFormat::DS);
+			return channelToFloat(pixelPtr, m_format.type);
 	}
 
-#undef PN
-#undef PU
+#undef UB32
+#undef NB32
 }
 
-void PixelBufferAccess::setPixel (const IVec4& color, int x, int y, int z) const
+int ConstPixelBufferAccess::getPixStencil (int x, int y, int z) const
 {
 	DE_ASSERT(de::inBounds(x, 0, getWidth()));
 	DE_ASSERT(de::inBounds(y, 0, getHeight()));
@@ -946,57 +1308,35 @@ void PixelBufferAccess::setPixel (const IVec4& color, int x, int y, int z) const
 	int			pixelSize	= m_format.getPixelSize();
 	deUint8*	pixelPtr	= (deUint8*)getDataPtr() + z*m_slicePitch + y*m_rowPitch + x*pixelSize;
 
-	// Optimized fomats.
-	if (m_format.type == TextureFormat::UNORM_INT8)
-	{
-		if (m_format.order == TextureFormat::RGBA)		{ writeRGBA8888Int(pixelPtr, color);	return; }
-		else if (m_format.order == TextureFormat::RGB)	{ writeRGB888Int(pixelPtr, color);		return; }
-	}
-
-#define PU(VAL, OFFS, BITS)		(uintToChannel((deUint32)(VAL), (BITS)) << (OFFS))
-
 	switch (m_format.type)
 	{
-		case TextureFormat::UNORM_SHORT_565:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 11, 5) | PU(color[1], 5, 6) | PU(color[2], 0, 5));							break;
-		case TextureFormat::UNORM_SHORT_555:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 10, 5) | PU(color[1], 5, 5) | PU(color[2], 0, 5));							break;
-		case TextureFormat::UNORM_SHORT_4444:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 12, 4) | PU(color[1], 8, 4) | PU(color[2], 4, 4) | PU(color[3], 0, 4));	break;
-		case TextureFormat::UNORM_SHORT_5551:			*((deUint16*)pixelPtr) = (deUint16)(PU(color[0], 11, 5) | PU(color[1], 6, 5) | PU(color[2], 1, 5) | PU(color[3], 0, 1));	break;
-		case TextureFormat::UNORM_INT_101010:			*((deUint32*)pixelPtr) = PU(color[0], 22, 10) | PU(color[1], 12, 10) | PU(color[2], 2, 10);									break;
-		case TextureFormat::UNORM_INT_1010102_REV:		*((deUint32*)pixelPtr) = PU(color[0],  0, 10) | PU(color[1], 10, 10) | PU(color[2], 20, 10) | PU(color[3], 30, 2);			break;
-		case TextureFormat::UNSIGNED_INT_1010102_REV:	*((deUint32*)pixelPtr) = PU(color[0],  0, 10) | PU(color[1], 10, 10) | PU(color[2], 20, 10) | PU(color[3], 30, 2);			break;
-
 		case TextureFormat::UNSIGNED_INT_24_8:
 			switch (m_format.order)
 			{
-				case TextureFormat::D:		*((deUint32*)pixelPtr) = PU(color[0], 8, 24);										break;
-				case TextureFormat::S:		*((deUint32*)pixelPtr) = PU(color[3], 8, 24);										break;
-				case TextureFormat::DS:		*((deUint32*)pixelPtr) = PU(color[0], 8, 24) | PU((deUint32)color[3], 0, 8);		break;
+				case TextureFormat::S:		return (int)(*((const deUint32*)pixelPtr) >> 8);
+				case TextureFormat::DS:		return (int)(*((const deUint32*)pixelPtr) & 0xff);
+
 				default:
 					DE_ASSERT(false);
+					return 0;
 			}
-			break;
 
 		case TextureFormat::FLOAT_UNSIGNED_INT_24_8_REV:
 			DE_ASSERT(m_format.order == TextureFormat::DS);
-			*((deUint32*)pixelPtr)		= color[0];
-			*((deUint32*)(pixelPtr+4))	= PU((deUint32)color[3], 0, 8);
-			break;
+			return *((const deUint32*)(pixelPtr+4)) & 0xff;
 
 		default:
 		{
-			// Generic path.
-			int			numChannels	= getNumUsedChannels(m_format.order);
-			const int*	map			= getChannelWriteMap(m_format.order);
-			int			channelSize	= getChannelSize(m_format.type);
-
-			for (int c = 0; c < numChannels; c++)
-				intToChannel(pixelPtr + channelSize*c, color[map[c]], m_format.type);
-
-			break;
+			if (m_format.order == TextureFormat::S)
+				return channelToInt(pixelPtr, m_format.type);
+			else
+			{
+				DE_ASSERT(m_format.order == TextureFormat::DS);
+				const int stencilChannelIndex = 3;
+				return channelToInt(pixelPtr + getChannelSize(m_format.type)*stencilChannelIndex, m_format.type);
+			}
 		}
 	}
-
-#undef PU
 }
 
 void PixelBufferAccess::setPixDepth (float depth, int x, int y, int z) const
@@ -2019,6 +2359,139 @@ Vec4 sampleLevelArray2DOffset (const ConstPixelBufferAccess* levels, int numLeve
 	}
 }
 
+namespace
+{
+
+enum
+{
+	SAMPLE_BATCH_CHUNK_SIZE	= 64	//!< Number of coordinates unnormalized at a time in batch sampling.
+};
+
+//! Unnormalize coordinates like unnormalize() does, but in a plain loop the compiler can vectorize.
+void unnormalizeBatch (const Sampler& sampler, Sampler::WrapMode mode, int size, const float* src, float* dst, int numCoords)
+{
+	if (!sampler.normalizedCoords)
+	{
+		for (int ndx = 0; ndx < numCoords; ndx++)
+			dst[ndx] = src[ndx];
+	}
+	else if (mode == Sampler::REPEAT_CL || mode == Sampler::MIRRORED_REPEAT_CL)
+	{
+		for (int ndx = 0; ndx < numCoords; ndx++)
+			dst[ndx] = unnormalize(mode, src[ndx], size);
+	}
+	else
+	{
+		const float scale = (float)size;
+
+		for (int ndx = 0; ndx < numCoords; ndx++)
+			dst[ndx] = scale*src[ndx];
+	}
+}
+
+//! Sample single level with fixed filter. Equivalent to ConstPixelBufferAccess::sample2D() for each coordinate.
+template<Sampler::FilterMode Filter>
+void sampleLevel2DBatch (const ConstPixelBufferAccess& level, const Sampler& sampler, int depth, const float* s, const float* t, Vec4* dst, int numSamples)
+{
+	float	u[SAMPLE_BATCH_CHUNK_SIZE];
+	float	v[SAMPLE_BATCH_CHUNK_SIZE];
+
+	for (int chunkStart = 0; chunkStart < numSamples; chunkStart += SAMPLE_BATCH_CHUNK_SIZE)
+	{
+		const int chunkSize = de::min((int)SAMPLE_BATCH_CHUNK_SIZE, numSamples - chunkStart);
+
+		unnormalizeBatch(sampler, sampler.wrapS, level.getWidth(), s + chunkStart, u, chunkSize);
+		unnormalizeBatch(sampler, sampler.wrapT, level.getHeight(), t + chunkStart, v, chunkSize);
+
+		for (int ndx = 0; ndx < chunkSize; ndx++)
+			dst[chunkStart+ndx] = (Filter == Sampler::LINEAR) ? sampleLinear2D(level, sampler, u[ndx], v[ndx], depth)
+															  : sampleNearest2D(level, sampler, u[ndx], v[ndx], depth);
+	}
+}
+
+//! Sample single level with fixed filter. Equivalent to ConstPixelBufferAccess::sample3D() for each coordinate.
+template<Sampler::FilterMode Filter>
+void sampleLevel3DBatch (const ConstPixelBufferAccess& level, const Sampler& sampler, const float* s, const float* t, const float* r, Vec4* dst, int numSamples)
+{
+	float	u[SAMPLE_BATCH_CHUNK_SIZE];
+	float	v[SAMPLE_BATCH_CHUNK_SIZE];
+	float	w[SAMPLE_BATCH_CHUNK_SIZE];
+
+	for (int chunkStart = 0; chunkStart < numSamples; chunkStart += SAMPLE_BATCH_CHUNK_SIZE)
+	{
+		const int chunkSize = de::min((int)SAMPLE_BATCH_CHUNK_SIZE, numSamples - chunkStart);
+
+		unnormalizeBatch(sampler, sampler.wrapS, level.getWidth(), s + chunkStart, u, chunkSize);
+		unnormalizeBatch(sampler, sampler.wrapT, level.getHeight(), t + chunkStart, v, chunkSize);
+		unnormalizeBatch(sampler, sampler.wrapR, level.getDepth(), r + chunkStart, w, chunkSize);
+
+		for (int ndx = 0; ndx < chunkSize; ndx++)
+			dst[chunkStart+ndx] = (Filter == Sampler::LINEAR) ? sampleLinear3D(level, sampler, u[ndx], v[ndx], w[ndx])
+															  : sampleNearest3D(level, sampler, u[ndx], v[ndx], w[ndx]);
+	}
+}
+
+//! Filter mode is the same for all lods, and only the base level is accessed.
+inline bool hasLodIndependentFilter (const Sampler& sampler)
+{
+	return sampler.minFilter == sampler.magFilter && (sampler.minFilter == Sampler::NEAREST || sampler.minFilter == Sampler::LINEAR);
+}
+
+} // anonymous
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Sample level array with multiple coordinates
+ *
+ * Equivalent to calling sampleLevelArray2D() for each (s[i], t[i], lod[i]).
+ * When the filter does not depend on lod, filter selection is done once per
+ * batch and lod may be null.
+ *//*--------------------------------------------------------------------*/
+void sampleLevelArray2DBatch (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, int depth, const float* s, const float* t, const float* lod, Vec4* dst, int numSamples)
+{
+	DE_ASSERT(numLevels > 0);
+
+	if (hasLodIndependentFilter(sampler))
+	{
+		if (sampler.minFilter == Sampler::LINEAR)
+			sampleLevel2DBatch<Sampler::LINEAR>(levels[0], sampler, depth, s, t, dst, numSamples);
+		else
+			sampleLevel2DBatch<Sampler::NEAREST>(levels[0], sampler, depth, s, t, dst, numSamples);
+	}
+	else
+	{
+		DE_ASSERT(lod);
+
+		for (int ndx = 0; ndx < numSamples; ndx++)
+			dst[ndx] = sampleLevelArray2D(levels, numLevels, sampler, s[ndx], t[ndx], depth, lod[ndx]);
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Sample 3D level array with multiple coordinates
+ *
+ * Equivalent to calling sampleLevelArray3D() for each coordinate, see
+ * sampleLevelArray2DBatch().
+ *//*--------------------------------------------------------------------*/
+void sampleLevelArray3DBatch (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, const float* s, const float* t, const float* r, const float* lod, Vec4* dst, int numSamples)
+{
+	DE_ASSERT(numLevels > 0);
+
+	if (hasLodIndependentFilter(sampler))
+	{
+		if (sampler.minFilter == Sampler::LINEAR)
+			sampleLevel3DBatch<Sampler::LINEAR>(levels[0], sampler, s, t, r, dst, numSamples);
+		else
+			sampleLevel3DBatch<Sampler::NEAREST>(levels[0], sampler, s, t, r, dst, numSamples);
+	}
+	else
+	{
+		DE_ASSERT(lod);
+
+		for (int ndx = 0; ndx < numSamples; ndx++)
+			dst[ndx] = sampleLevelArray3D(levels, numLevels, sampler, s[ndx], t[ndx], r[ndx], lod[ndx]);
+	}
+}
+
 Vec4 sampleLevelArray3D (const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float r, float lod)
 {
 	bool					magnified	= lod <= sampler.lodThreshold;
@@ -3582,6 +4055,291 @@ void TextureCubeArray::allocLevel (int levelNdx)
 	TextureLevelPyramid::allocLevel(levelNdx, size, size, m_depth);
 }
 
+namespace
+{
+
+template<typename T>
+bool isBitwiseEqual (const std::vector<T>& a, const std::vector<T>& b)
+{
+	DE_ASSERT(a.size() == b.size());
+	return deMemCmp(&a[0], &b[0], (int)(a.size()*sizeof(T))) == 0;
+}
+
+void checkPixelBufferAccess (const TextureFormat& format, deUint32 seed)
+{
+	// Row access is checked in the middle of a padded buffer, so that any
+	// access past the row ends would show up as a difference in data.
+	const int				width		= 13;
+	const int				height		= 3;
+	const int				pixelSize	= format.getPixelSize();
+	const int				rowPitch	= width*pixelSize + 5;
+	const int				x			= 1;
+	const int				numPixels	= width-2;
+	const bool				isFloat		= format.type == TextureFormat::FLOAT || format.type == TextureFormat::HALF_FLOAT;
+	de::Random				rnd			(seed);
+	std::vector<deUint8>	srcData		(rowPitch*height);
+	const PixelBufferAccess	src			(format, width, height, 1, rowPitch, 0, &srcData[0]);
+
+	// Random source data. Float formats are filled with finite values only.
+	if (isFloat)
+	{
+		for (int y = 0; y < height; y++)
+		for (int px = 0; px < width; px++)
+			writePixelGeneric(src, Vec4(rnd.getFloat(-100.0f, 100.0f), rnd.getFloat(-100.0f, 100.0f), rnd.getFloat(-100.0f, 100.0f), rnd.getFloat(-100.0f, 100.0f)), px, y, 0);
+	}
+	else
+	{
+		for (int ndx = 0; ndx < (int)srcData.size(); ndx++)
+			srcData[ndx] = rnd.getUint8();
+	}
+
+	// Reads.
+	for (int y = 0; y < height; y++)
+	{
+		std::vector<Vec4>	rowFloat		(numPixels);
+		std::vector<Vec4>	pixelFloat		(numPixels);
+		std::vector<Vec4>	genericFloat	(numPixels);
+		std::vector<IVec4>	rowInt			(numPixels);
+		std::vector<IVec4>	pixelInt		(numPixels);
+		std::vector<IVec4>	genericInt		(numPixels);
+
+		src.readRow(&rowFloat[0], x, y, 0, numPixels);
+		src.readRow(&rowInt[0], x, y, 0, numPixels);
+
+		for (int ndx = 0; ndx < numPixels; ndx++)
+		{
+			pixelFloat[ndx]		= src.getPixel(x+ndx, y);
+			genericFloat[ndx]	= readPixelGeneric(src, x+ndx, y, 0);
+			pixelInt[ndx]		= src.getPixelInt(x+ndx, y);
+			genericInt[ndx]		= readPixelIntGeneric(src, x+ndx, y, 0);
+
+			// \note RGB888 integer reads have always returned 0xff alpha, unlike the generic path.
+			if (format == TextureFormat(TextureFormat::RGB, TextureFormat::UNORM_INT8))
+				genericInt[ndx].w() = 0xff;
+		}
+
+		DE_TEST_ASSERT(isBitwiseEqual(rowFloat, pixelFloat));
+		DE_TEST_ASSERT(isBitwiseEqual(rowFloat, genericFloat));
+		DE_TEST_ASSERT(isBitwiseEqual(rowInt, pixelInt));
+		DE_TEST_ASSERT(isBitwiseEqual(rowInt, genericInt));
+	}
+
+	// Writes.
+	for (int isInt = 0; isInt < 2; isInt++)
+	{
+		std::vector<deUint8>	rowData			(srcData);
+		std::vector<deUint8>	pixelData		(srcData);
+		std::vector<deUint8>	genericData		(srcData);
+		const PixelBufferAccess	rowAccess		(format, width, height, 1, rowPitch, 0, &rowData[0]);
+		const PixelBufferAccess	pixelAccess		(format, width, height, 1, rowPitch, 0, &pixelData[0]);
+		const PixelBufferAccess	genericAccess	(format, width, height, 1, rowPitch, 0, &genericData[0]);
+
+		for (int y = 0; y < height; y++)
+		{
+			if (isInt)
+			{
+				std::vector<IVec4> colors (numPixels);
+
+				for (int ndx = 0; ndx < numPixels; ndx++)
+					colors[ndx] = IVec4(rnd.getInt(0, 255), rnd.getInt(0, 255), rnd.getInt(0, 255), rnd.getInt(0, 255));
+
+				rowAccess.writeRow(&colors[0], x, y, 0, numPixels);
+
+				for (int ndx = 0; ndx < numPixels; ndx++)
+				{
+					pixelAccess.setPixel(colors[ndx], x+ndx, y);
+					writePixelIntGeneric(genericAccess, colors[ndx], x+ndx, y, 0);
+				}
+			}
+			else
+			{
+				// \note Alpha is integer-valued since it holds stencil in DS formats.
+				std::vector<Vec4> colors (numPixels);
+
+				for (int ndx = 0; ndx < numPixels; ndx++)
+					colors[ndx] = Vec4(rnd.getFloat(-0.5f, 1.5f), rnd.getFloat(-0.5f, 1.5f), rnd.getFloat(-0.5f, 1.5f), (float)rnd.getInt(0, 255));
+
+				rowAccess.writeRow(&colors[0], x, y, 0, numPixels);
+
+				for (int ndx = 0; ndx < numPixels; ndx++)
+				{
+					pixelAccess.setPixel(colors[ndx], x+ndx, y);
+					writePixelGeneric(genericAccess, colors[ndx], x+ndx, y, 0);
+				}
+			}
+		}
+
+		DE_TEST_ASSERT(rowData == pixelData);
+		DE_TEST_ASSERT(rowData == genericData);
+	}
+}
+
+void fillWithRandomColors (const PixelBufferAccess& access, de::Random& rnd)
+{
+	for (int z = 0; z < access.getDepth(); z++)
+	for (int y = 0; y < access.getHeight(); y++)
+	for (int x = 0; x < access.getWidth(); x++)
+		access.setPixel(Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat()), x, y, z);
+}
+
+std::vector<Sampler> getBatchTestSamplers (void)
+{
+	const Sampler::WrapMode wrapModes[] =
+	{
+		Sampler::CLAMP_TO_EDGE,
+		Sampler::CLAMP_TO_BORDER,
+		Sampler::REPEAT_GL,
+		Sampler::REPEAT_CL,
+		Sampler::MIRRORED_REPEAT_GL,
+		Sampler::MIRRORED_REPEAT_CL
+	};
+	const Sampler::FilterMode minFilters[] =
+	{
+		Sampler::NEAREST,
+		Sampler::LINEAR,
+		Sampler::NEAREST_MIPMAP_NEAREST,
+		Sampler::NEAREST_MIPMAP_LINEAR,
+		Sampler::LINEAR_MIPMAP_NEAREST,
+		Sampler::LINEAR_MIPMAP_LINEAR
+	};
+	const Sampler::FilterMode magFilters[] =
+	{
+		Sampler::NEAREST,
+		Sampler::LINEAR
+	};
+	std::vector<Sampler> samplers;
+
+	for (int wrapNdx = 0; wrapNdx < DE_LENGTH_OF_ARRAY(wrapModes); wrapNdx++)
+	for (int minNdx = 0; minNdx < DE_LENGTH_OF_ARRAY(minFilters); minNdx++)
+	for (int magNdx = 0; magNdx < DE_LENGTH_OF_ARRAY(magFilters); magNdx++)
+	for (int normalized = 0; normalized < 2; normalized++)
+	{
+		const Sampler::WrapMode wrapMode = wrapModes[wrapNdx];
+
+		// CL wrap modes are only defined for normalized coordinates.
+		if (!normalized && (wrapMode == Sampler::REPEAT_CL || wrapMode == Sampler::MIRRORED_REPEAT_CL))
+			continue;
+
+		samplers.push_back(Sampler(wrapMode, wrapMode, wrapMode, minFilters[minNdx], magFilters[magNdx], 0.0f, normalized != 0,
+								   Sampler::COMPAREMODE_NONE, 0, Vec4(0.25f, 0.5f, 0.75f, 1.0f)));
+	}
+
+	return samplers;
+}
+
+//! Random coordinates, covering wrapping on both sides of the texture.
+void genBatchTestCoords (de::Random& rnd, const Sampler& sampler, int size, std::vector<float>& dst)
+{
+	const float scale = sampler.normalizedCoords ? 1.0f : (float)size;
+
+	for (int ndx = 0; ndx < (int)dst.size(); ndx++)
+		dst[ndx] = rnd.getFloat(-1.5f, 2.5f) * scale;
+}
+
+void checkBatchSampling2D (const TextureFormat& format, deUint32 seed)
+{
+	const int				numSamples	= 150; // Covers several unnormalization chunks.
+	de::Random				rnd			(seed);
+	Texture2D				texture		(format, 13, 9);
+	std::vector<Sampler>	samplers	= getBatchTestSamplers();
+
+	for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+	{
+		texture.allocLevel(levelNdx);
+		fillWithRandomColors(texture.getLevel(levelNdx), rnd);
+	}
+
+	for (int samplerNdx = 0; samplerNdx < (int)samplers.size(); samplerNdx++)
+	{
+		const Sampler&			sampler		= samplers[samplerNdx];
+		std::vector<float>		s			(numSamples);
+		std::vector<float>		t			(numSamples);
+		std::vector<float>		lod			(numSamples);
+		std::vector<Vec4>		result		(numSamples);
+		std::vector<Vec4>		reference	(numSamples);
+
+		genBatchTestCoords(rnd, sampler, texture.getWidth(), s);
+		genBatchTestCoords(rnd, sampler, texture.getHeight(), t);
+
+		for (int ndx = 0; ndx < numSamples; ndx++)
+			lod[ndx] = rnd.getFloat(-1.0f, 5.0f);
+
+		texture.sampleBatch(sampler, &s[0], &t[0], &lod[0], &result[0], numSamples);
+
+		for (int ndx = 0; ndx < numSamples; ndx++)
+			reference[ndx] = texture.sample(sampler, s[ndx], t[ndx], lod[ndx]);
+
+		DE_TEST_ASSERT(isBitwiseEqual(result, reference));
+	}
+}
+
+void checkBatchSampling3D (const TextureFormat& format, deUint32 seed)
+{
+	const int				numSamples	= 150;
+	de::Random				rnd			(seed);
+	Texture3D				texture		(format, 7, 5, 6);
+	std::vector<Sampler>	samplers	= getBatchTestSamplers();
+
+	for (int levelNdx = 0; levelNdx < texture.getNumLevels(); levelNdx++)
+	{
+		texture.allocLevel(levelNdx);
+		fillWithRandomColors(texture.getLevel(levelNdx), rnd);
+	}
+
+	for (int samplerNdx = 0; samplerNdx < (int)samplers.size(); samplerNdx++)
+	{
+		const Sampler&			sampler		= samplers[samplerNdx];
+		std::vector<float>		s			(numSamples);
+		std::vector<float>		t			(numSamples);
+		std::vector<float>		r			(numSamples);
+		std::vector<float>		lod			(numSamples);
+		std::vector<Vec4>		result		(numSamples);
+		std::vector<Vec4>		reference	(numSamples);
+
+		genBatchTestCoords(rnd, sampler, texture.getWidth(), s);
+		genBatchTestCoords(rnd, sampler, texture.getHeight(), t);
+		genBatchTestCoords(rnd, sampler, texture.getDepth(), r);
+
+		for (int ndx = 0; ndx < numSamples; ndx++)
+			lod[ndx] = rnd.getFloat(-1.0f, 4.0f);
+
+		texture.sampleBatch(sampler, &s[0], &t[0], &r[0], &lod[0], &result[0], numSamples);
+
+		for (int ndx = 0; ndx < numSamples; ndx++)
+			reference[ndx] = texture.sample(sampler, s[ndx], t[ndx], r[ndx], lod[ndx]);
+
+		DE_TEST_ASSERT(isBitwiseEqual(result, reference));
+	}
+}
+
+} // anonymous
+
+void PixelBufferAccess_selfTest (void)
+{
+	// Formats with specialized access paths.
+	const TextureFormat formats[] =
+	{
+		TextureFormat(TextureFormat::RGBA,	TextureFormat::UNORM_INT8),
+		TextureFormat(TextureFormat::RGB,	TextureFormat::UNORM_INT8),
+		TextureFormat(TextureFormat::RGBA,	TextureFormat::FLOAT),
+		TextureFormat(TextureFormat::RGBA,	TextureFormat::HALF_FLOAT),
+		TextureFormat(TextureFormat::D,		TextureFormat::FLOAT),
+		TextureFormat(TextureFormat::DS,	TextureFormat::UNSIGNED_INT_24_8),
+	};
+
+	for (int ndx = 0; ndx < DE_LENGTH_OF_ARRAY(formats); ndx++)
+		checkPixelBufferAccess(formats[ndx], 0x1234u + (deUint32)ndx);
+}
+
+void TextureBatchSampling_selfTest (void)
+{
+	checkBatchSampling2D(TextureFormat(TextureFormat::RGBA,	TextureFormat::UNORM_INT8),	0x4321u);
+	checkBatchSampling2D(TextureFormat(TextureFormat::sRGBA,	TextureFormat::UNORM_INT8),	0x4322u);
+	checkBatchSampling2D(TextureFormat(TextureFormat::RGBA,	TextureFormat::HALF_FLOAT),	0x4323u);
+	checkBatchSampling3D(TextureFormat(TextureFormat::RGBA,	TextureFormat::UNORM_INT8),	0x4324u);
+	checkBatchSampling3D(TextureFormat(TextureFormat::RGB,	TextureFormat::FLOAT),		0x4325u);
+}
+
 std::ostream& operator<< (std::ostream& str, TextureFormat::ChannelOrder order)
 {
 	switch (order)
@@ -229,6 +229,7 @@ public:
 };
 
 class TextureLevel;
+struct PixelAccessFuncs;
 
 /*--------------------------------------------------------------------*//*!
  * \brief Read-only pixel data access
@@ -239,6 +240,10 @@ class TextureLevel;
  *
  * Access objects are like iterators or pointers. They can be passed around
  * as values and are valid as long as the storage doesn't change.
+ *
+ * Pixel access routines are selected based on format when access object
+ * is created. Common formats use specialized routines, and readRow() can
+ * be used to convert a whole row of pixels with a single dispatch.
  *//*--------------------------------------------------------------------*/
 class ConstPixelBufferAccess
 {
@@ -265,6 +270,9 @@ public:
 	template<typename T>
 	Vector<T, 4>			getPixelT					(int x, int y, int z = 0) const;
 
+	void					readRow						(Vec4* dst, int x, int y, int z, int numPixels) const;
+	void					readRow						(IVec4* dst, int x, int y, int z, int numPixels) const;
+
 	float					getPixDepth					(int x, int y, int z = 0) const;
 	int						getPixStencil				(int x, int y, int z = 0) const;
 
@@ -287,6 +295,7 @@ protected:
 	int						m_rowPitch;
 	int						m_slicePitch;
 	mutable void*			m_data;
+	const PixelAccessFuncs*	m_accessFuncs;				//!< Pixel access routines for m_format.
 };
 
 /*--------------------------------------------------------------------*//*!
@@ -313,6 +322,9 @@ public:
 	void					setPixel					(const tcu::IVec4& color, int x, int y, int z = 0) const;
 	void					setPixel					(const tcu::UVec4& color, int x, int y, int z = 0) const { setPixel(color.cast<int>(), x, y, z); }
 
+	void					writeRow					(const Vec4* src, int x, int y, int z, int numPixels) const;
+	void					writeRow					(const IVec4* src, int x, int y, int z, int numPixels) const;
+
 	void					setPixDepth					(float depth, int x, int y, int z = 0) const;
 	void					setPixStencil				(int stencil, int x, int y, int z = 0) const;
 };
@@ -359,7 +371,9 @@ private:
 
 Vec4	sampleLevelArray1D				(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, int level, float lod);
 Vec4	sampleLevelArray2D				(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, int depth, float lod);
+void	sampleLevelArray2DBatch			(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, int depth, const float* s, const float* t, const float* lod, Vec4* dst, int numSamples);
 Vec4	sampleLevelArray3D				(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float r, float lod);
+void	sampleLevelArray3DBatch			(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, const float* s, const float* t, const float* r, const float* lod, Vec4* dst, int numSamples);
 
 Vec4	sampleLevelArray1DOffset		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float lod, const IVec2& offset);
 Vec4	sampleLevelArray2DOffset		(const ConstPixelBufferAccess* levels, int numLevels, const Sampler& sampler, float s, float t, float lod, const IVec3& offset);
@@ -470,6 +484,7 @@ public:
 	const ConstPixelBufferAccess*	getLevels			(void) const	{ return m_levels;											}
 
 	Vec4							sample				(const Sampler& sampler, float s, float t, float lod) const;
+	void							sampleBatch			(const Sampler& sampler, const float* s, const float* t, const float* lod, Vec4* dst, int numSamples) const;
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float lod, const IVec2& offset) const;
 	float							sampleCompare		(const Sampler& sampler, float ref, float s, float t, float lod) const;
 	float							sampleCompareOffset	(const Sampler& sampler, float ref, float s, float t, float lod, const IVec2& offset) const;
@@ -494,6 +509,11 @@ inline Vec4 Texture2DView::sample (const Sampler& sampler, float s, float t, flo
 	return sampleLevelArray2D(m_levels, m_numLevels, sampler, s, t, 0 /* depth */, lod);
 }
 
+inline void Texture2DView::sampleBatch (const Sampler& sampler, const float* s, const float* t, const float* lod, Vec4* dst, int numSamples) const
+{
+	sampleLevelArray2DBatch(m_levels, m_numLevels, sampler, 0 /* depth */, s, t, lod, dst, numSamples);
+}
+
 inline Vec4 Texture2DView::sampleOffset (const Sampler& sampler, float s, float t, float lod, const IVec2& offset) const
 {
 	return sampleLevelArray2DOffset(m_levels, m_numLevels, sampler, s, t, lod, IVec3(offset.x(), offset.y(), 0));
@@ -614,6 +634,7 @@ public:
 
 	// Sampling
 	Vec4							sample				(const Sampler& sampler, float s, float t, float lod) const;
+	void							sampleBatch			(const Sampler& sampler, const float* s, const float* t, const float* lod, Vec4* dst, int numSamples) const;
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float lod, const IVec2& offset) const;
 	float							sampleCompare		(const Sampler& sampler, float ref, float s, float t, float lod) const;
 	float							sampleCompareOffset	(const Sampler& sampler, float ref, float s, float t, float lod, const IVec2& offset) const;
@@ -642,6 +663,11 @@ inline Vec4 Texture2D::sample (const Sampler& sampler, float s, float t, float l
 	return m_view.sample(sampler, s, t, lod);
 }
 
+inline void Texture2D::sampleBatch (const Sampler& sampler, const float* s, const float* t, const float* lod, Vec4* dst, int numSamples) const
+{
+	m_view.sampleBatch(sampler, s, t, lod, dst, numSamples);
+}
+
 inline Vec4 Texture2D::sampleOffset (const Sampler& sampler, float s, float t, float lod, const IVec2& offset) const
 {
 	return m_view.sampleOffset(sampler, s, t, lod, offset);
@@ -952,6 +978,7 @@ public:
 	const ConstPixelBufferAccess*	getLevels			(void) const	{ return m_levels;											}
 
 	Vec4							sample				(const Sampler& sampler, float s, float t, float r, float lod) const;
+	void							sampleBatch			(const Sampler& sampler, const float* s, const float* t, const float* r, const float* lod, Vec4* dst, int numSamples) const;
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset) const;
 
 protected:
@@ -964,6 +991,11 @@ inline Vec4 Texture3DView::sample (const Sampler& sampler, float s, float t, flo
 	return sampleLevelArray3D(m_levels, m_numLevels, sampler, s, t, r, lod);
 }
 
+inline void Texture3DView::sampleBatch (const Sampler& sampler, const float* s, const float* t, const float* r, const float* lod, Vec4* dst, int numSamples) const
+{
+	sampleLevelArray3DBatch(m_levels, m_numLevels, sampler, s, t, r, lod, dst, numSamples);
+}
+
 inline Vec4 Texture3DView::sampleOffset (const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset) const
 {
 	return sampleLevelArray3DOffset(m_levels, m_numLevels, sampler, s, t, r, lod, offset);
@@ -992,6 +1024,7 @@ public:
 	using TextureLevelPyramid::isLevelEmpty;
 
 	Vec4							sample				(const Sampler& sampler, float s, float t, float r, float lod) const;
+	void							sampleBatch			(const Sampler& sampler, const float* s, const float* t, const float* r, const float* lod, Vec4* dst, int numSamples) const;
 	Vec4							sampleOffset		(const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset) const;
 
 	Texture3D&						operator=			(const Texture3D& other);
@@ -1010,6 +1043,11 @@ inline Vec4 Texture3D::sample (const Sampler& sampler, float s, float t, float r
 	return m_view.sample(sampler, s, t, r, lod);
 }
 
+inline void Texture3D::sampleBatch (const Sampler& sampler, const float* s, const float* t, const float* r, const float* lod, Vec4* dst, int numSamples) const
+{
+	m_view.sampleBatch(sampler, s, t, r, lod, dst, numSamples);
+}
+
 inline Vec4 Texture3D::sampleOffset (const Sampler& sampler, float s, float t, float r, float lod, const IVec3& offset) const
 {
 	return m_view.sampleOffset(sampler, s, t, r, lod, offset);
@@ -1098,6 +1136,9 @@ inline float TextureCubeArray::sampleCompareOffset (const Sampler& sampler, floa
 	return m_view.sampleCompareOffset(sampler, ref, s, t, r, q, lod, offset);
 }
 
+void				PixelBufferAccess_selfTest		(void);
+void				TextureBatchSampling_selfTest	(void);
+
 // Stream operators.
 std::ostream&		operator<<		(std::ostream& str, TextureFormat::ChannelOrder order);
 std::ostream&		operator<<		(std::ostream& str, TextureFormat::ChannelType type);
@@ -28,6 +28,7 @@
 #include "deMemory.h"
 
 #include <limits>
+#include <vector>
 
 namespace tcu
 {
@@ -782,6 +783,9 @@ void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 
 	DE_ASSERT(src.getWidth() == width && src.getHeight() == height && src.getDepth() == depth);
 
+	if (width == 0)
+		return;
+
 	if (src.getFormat() == dst.getFormat())
 	{
 		// Fast-path for matching formats.
@@ -800,19 +804,28 @@ void copy (const PixelBufferAccess& dst, const ConstPixelBufferAccess& src)
 		bool					srcIsInt	= srcClass == TEXTURECHANNELCLASS_SIGNED_INTEGER || srcClass == TEXTURECHANNELCLASS_UNSIGNED_INTEGER;
 		bool					dstIsInt	= dstClass == TEXTURECHANNELCLASS_SIGNED_INTEGER || dstClass == TEXTURECHANNELCLASS_UNSIGNED_INTEGER;
 
+		// Convert one row at a time to avoid per-pixel format dispatch.
 		if (srcIsInt && dstIsInt)
 		{
+			std::vector<IVec4> row(width);
+
 			for (int z = 0; z < depth; z++)
 			for (int y = 0; y < height; y++)
-			for (int x = 0; x < width; x++)
-				dst.setPixel(src.getPixelInt(x, y, z), x, y, z);
+			{
+				src.readRow(&row[0], 0, y, z, width);
+				dst.writeRow(&row[0], 0, y, z, width);
+			}
 		}
 		else
 		{
+			std::vector<Vec4> row(width);
+
 			for (int z = 0; z < depth; z++)
 			for (int y = 0; y < height; y++)
-			for (int x = 0; x < width; x++)
-				dst.setPixel(src.getPixel(x, y, z), x, y, z);
+			{
+				src.readRow(&row[0], 0, y, z, width);
+				dst.writeRow(&row[0], 0, y, z, width);
+			}
 		}
 	}
 }
@@ -0,0 +1,310 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Parallel tiled per-pixel result verification.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuTiledVerifier.hpp"
+#include "tcuTextureUtil.hpp"
+#include "tcuRGBA.hpp"
+#include "tcuWorkerPool.hpp"
+#include "deMutex.hpp"
+#include "deAtomic.h"
+
+#include <vector>
+
+namespace tcu
+{
+namespace
+{
+
+enum
+{
+	VERIFY_TILE_SIZE		= 32	//!< Tile width and height in pixels.
+};
+
+int getNumTilesForSize (int size)
+{
+	return (size + VERIFY_TILE_SIZE - 1) / VERIFY_TILE_SIZE;
+}
+
+IVec4 getTileRect (int width, int height, int tileNdx)
+{
+	const int numTilesX	= getNumTilesForSize(width);
+	const int x			= (tileNdx % numTilesX) * VERIFY_TILE_SIZE;
+	const int y			= (tileNdx / numTilesX) * VERIFY_TILE_SIZE;
+
+	return IVec4(x, y, de::min((int)VERIFY_TILE_SIZE, width-x), de::min((int)VERIFY_TILE_SIZE, height-y));
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Tile verification job
+ *
+ * Tiles are numbered in raster order. Once the tiles 0..N that have
+ * been completed contain at least maxFailedPixels failures, tiles after
+ * N are not started anymore. Since the stop point only depends on the
+ * results of a completed tile prefix, the final result is made
+ * independent of thread scheduling by discarding all tiles after the
+ * first tile where failure budget was reached.
+ *//*--------------------------------------------------------------------*/
+class TileVerifyJob : public de::WorkerPool::Job
+{
+public:
+	TileVerifyJob (const PixelVerifier& verifier, const PixelBufferAccess& errorMask, int maxFailedPixels, qpWatchDog* watchDog)
+		: m_verifier		(verifier)
+		, m_errorMask		(errorMask)
+		, m_maxFailedPixels	(maxFailedPixels)
+		, m_watchDog		(watchDog)
+		, m_numTiles		(getNumTilesForSize(errorMask.getWidth())*getNumTilesForSize(errorMask.getHeight()))
+		, m_tileResults		(m_numTiles, -1)
+		, m_prefixEnd		(0)
+		, m_prefixFailed	(0)
+		, m_stopAfterTile	(-1)
+	{
+	}
+
+	int getNumTiles (void) const
+	{
+		return m_numTiles;
+	}
+
+	void execute (int tileNdx, int workerNdx)
+	{
+		// \note m_stopAfterTile is only written once, under lock. Seeing a stale value just causes extra work.
+		const int stopAfterTile = m_stopAfterTile;
+
+		if (stopAfterTile >= 0 && tileNdx > stopAfterTile)
+			return;
+
+		const IVec4	rect		= getTileRect(m_errorMask.getWidth(), m_errorMask.getHeight(), tileNdx);
+		const Vec4	red			= RGBA::red.toVec();
+		int			numFailed	= 0;
+
+		for (int y = rect.y(); y < rect.y()+rect.w(); y++)
+		for (int x = rect.x(); x < rect.x()+rect.z(); x++)
+		{
+			if (!m_verifier.isPixelValid(x, y))
+			{
+				m_errorMask.setPixel(red, x, y);
+				numFailed += 1;
+			}
+		}
+
+		// Only the calling thread may touch watchdog.
+		if (workerNdx == 0 && m_watchDog)
+			qpWatchDog_touch(m_watchDog);
+
+		{
+			de::ScopedLock lock(m_lock);
+
+			m_tileResults[tileNdx] = numFailed;
+
+			while (m_prefixEnd < m_numTiles && m_tileResults[m_prefixEnd] >= 0)
+			{
+				m_prefixFailed += m_tileResults[m_prefixEnd];
+				m_prefixEnd += 1;
+
+				if (m_stopAfterTile < 0 && m_maxFailedPixels != VERIFY_ALL_PIXELS && m_prefixFailed >= m_maxFailedPixels)
+					m_stopAfterTile = m_prefixEnd-1;
+			}
+		}
+	}
+
+	//! Discard tiles after the stop point and return number of failed pixels.
+	int finish (void)
+	{
+		const Vec4	green		= RGBA::green.toVec();
+		const int	lastTile	= m_stopAfterTile >= 0 ? m_stopAfterTile : m_numTiles-1;
+		int			numFailed	= 0;
+
+		for (int tileNdx = 0; tileNdx <= lastTile; tileNdx++)
+		{
+			DE_ASSERT(m_tileResults[tileNdx] >= 0);
+			numFailed += m_tileResults[tileNdx];
+		}
+
+		for (int tileNdx = lastTile+1; tileNdx < m_numTiles; tileNdx++)
+		{
+			const IVec4 rect = getTileRect(m_errorMask.getWidth(), m_errorMask.getHeight(), tileNdx);
+			clear(getSubregion(m_errorMask, rect.x(), rect.y(), rect.z(), rect.w()), green);
+		}
+
+		return numFailed;
+	}
+
+private:
+	const PixelVerifier&		m_verifier;
+	const PixelBufferAccess		m_errorMask;
+	const int					m_maxFailedPixels;
+	qpWatchDog* const			m_watchDog;
+	const int					m_numTiles;
+
+	de::Mutex					m_lock;
+	std::vector<int>			m_tileResults;		//!< Number of failed pixels per tile, or -1 if not completed.
+	int							m_prefixEnd;		//!< Tiles [0, m_prefixEnd) are completed.
+	int							m_prefixFailed;		//!< Number of failed pixels in tiles [0, m_prefixEnd).
+	volatile int				m_stopAfterTile;	//!< Last tile to verify, or -1 if budget has not been reached.
+};
+
+} // anonymous
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Verify pixels using multiple threads
+ * \param verifier			Per-pixel verifier
+ * \param errorMask			Error mask, also defines verified area
+ * \param maxFailedPixels	Stop verification once at least this many
+ *							invalid pixels have been found, or
+ *							VERIFY_ALL_PIXELS
+ * \param watchDog			Watchdog to touch during verification, or DE_NULL
+ * \return Number of invalid pixels found
+ *
+ * Area is verified in tiles. Error mask is cleared to green and invalid
+ * pixels are marked red. If verification is stopped early, only tiles
+ * up to and including the one where maxFailedPixels was reached (in
+ * raster order) are included in the error mask and the result. Thus the
+ * result is deterministic regardless of number of threads.
+ *//*--------------------------------------------------------------------*/
+int verifyPixelsTiled (const PixelVerifier& verifier, const PixelBufferAccess& errorMask, int maxFailedPixels, qpWatchDog* watchDog)
+{
+	TileVerifyJob		job		(verifier, errorMask, maxFailedPixels, watchDog);
+	SharedWorkerPool	pool	(job.getNumTiles());
+
+	DE_ASSERT(maxFailedPixels == VERIFY_ALL_PIXELS || maxFailedPixels > 0);
+
+	clear(errorMask, RGBA::green.toVec());
+	pool.execute(job, job.getNumTiles());
+
+	return job.finish();
+}
+
+// Self-test
+
+namespace
+{
+
+class PatternVerifier : public PixelVerifier
+{
+public:
+	PatternVerifier (void)
+		: m_numCalls(0)
+	{
+	}
+
+	bool isPixelValid (int x, int y) const
+	{
+		deAtomicIncrement32(&m_numCalls);
+		return isValid(x, y);
+	}
+
+	static bool isValid (int x, int y)
+	{
+		// Sparse failures in every tile row, and a dense block.
+		return ((x*7 + y*13) % 31 != 0) && !(de::inBounds(x, 40, 60) && de::inBounds(y, 35, 50));
+	}
+
+	int getNumCalls (void) const
+	{
+		return m_numCalls;
+	}
+
+private:
+	mutable volatile deInt32	m_numCalls;
+};
+
+//! Compute expected result by visiting tiles in raster order on one thread.
+int verifyReference (const PixelBufferAccess& errorMask, int maxFailedPixels, int& numVerifiedPixels)
+{
+	const int	numTiles	= getNumTilesForSize(errorMask.getWidth())*getNumTilesForSize(errorMask.getHeight());
+	int			numFailed	= 0;
+
+	clear(errorMask, RGBA::green.toVec());
+	numVerifiedPixels = 0;
+
+	for (int tileNdx = 0; tileNdx < numTiles; tileNdx++)
+	{
+		const IVec4 rect = getTileRect(errorMask.getWidth(), errorMask.getHeight(), tileNdx);
+
+		for (int y = rect.y(); y < rect.y()+rect.w(); y++)
+		for (int x = rect.x(); x < rect.x()+rect.z(); x++)
+		{
+			if (!PatternVerifier::isValid(x, y))
+			{
+				errorMask.setPixel(RGBA::red.toVec(), x, y);
+				numFailed += 1;
+			}
+		}
+
+		numVerifiedPixels += rect.z()*rect.w();
+
+		if (maxFailedPixels != VERIFY_ALL_PIXELS && numFailed >= maxFailedPixels)
+			break;
+	}
+
+	return numFailed;
+}
+
+bool masksEqual (const ConstPixelBufferAccess& a, const ConstPixelBufferAccess& b)
+{
+	for (int y = 0; y < a.getHeight(); y++)
+	for (int x = 0; x < a.getWidth(); x++)
+	{
+		if (a.getPixel(x, y) != b.getPixel(x, y))
+			return false;
+	}
+
+	return true;
+}
+
+} // anonymous
+
+void TiledVerifier_selfTest (void)
+{
+	const TextureFormat	format				(TextureFormat::RGBA, TextureFormat::UNORM_INT8);
+	const int			width				= 150;	// Partial tiles on both axes
+	const int			height				= 100;
+	const int			maxFailedPixels[]	= { VERIFY_ALL_PIXELS, 1, 40, 300, width*height };
+	const int			numThreads[]		= { 1, 4 };
+	TextureLevel		reference			(format, width, height);
+	TextureLevel		result				(format, width, height);
+
+	for (int budgetNdx = 0; budgetNdx < DE_LENGTH_OF_ARRAY(maxFailedPixels); budgetNdx++)
+	{
+		int			numVerifiedPixels	= 0;
+		const int	expectedNumFailed	= verifyReference(reference.getAccess(), maxFailedPixels[budgetNdx], numVerifiedPixels);
+
+		for (int threadNdx = 0; threadNdx < DE_LENGTH_OF_ARRAY(numThreads); threadNdx++)
+		{
+			const ScopedMaxWorkerThreads	maxThreads	(numThreads[threadNdx]);
+			const PatternVerifier			verifier;
+			const int						numFailed	= verifyPixelsTiled(verifier, result.getAccess(), maxFailedPixels[budgetNdx], DE_NULL);
+
+			DE_TEST_ASSERT(numFailed == expectedNumFailed);
+			DE_TEST_ASSERT(masksEqual(result.getAccess(), reference.getAccess()));
+
+			// Tiles after the stop point are not verified on a single thread. Other workers may have started a few more.
+			if (numThreads[threadNdx] == 1)
+				DE_TEST_ASSERT(verifier.getNumCalls() == numVerifiedPixels);
+			else
+				DE_TEST_ASSERT(de::inRange(verifier.getNumCalls(), numVerifiedPixels, width*height));
+		}
+	}
+}
+
+} // tcu
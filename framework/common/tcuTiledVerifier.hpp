@@ -0,0 +1,57 @@
+#ifndef _TCUTILEDVERIFIER_HPP
+#define _TCUTILEDVERIFIER_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Parallel tiled per-pixel result verification.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+#include "tcuTexture.hpp"
+#include "qpWatchDog.h"
+
+namespace tcu
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Per-pixel verifier
+ *
+ * isPixelValid() is called concurrently from multiple threads and thus
+ * must not modify any shared state.
+ *//*--------------------------------------------------------------------*/
+class PixelVerifier
+{
+public:
+	virtual			~PixelVerifier	(void) {}
+	virtual bool	isPixelValid	(int x, int y) const = 0;
+};
+
+enum
+{
+	VERIFY_ALL_PIXELS	= -1	//!< Don't stop verification early.
+};
+
+int		verifyPixelsTiled		(const PixelVerifier& verifier, const PixelBufferAccess& errorMask, int maxFailedPixels, qpWatchDog* watchDog);
+
+void	TiledVerifier_selfTest	(void);
+
+} // tcu
+
+#endif // _TCUTILEDVERIFIER_HPP
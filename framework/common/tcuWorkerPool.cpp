@@ -0,0 +1,218 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Shared worker pool for framework utilities.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuWorkerPool.hpp"
+#include "deMutex.hpp"
+#include "deThread.h"
+
+#include <vector>
+
+namespace tcu
+{
+namespace
+{
+
+enum
+{
+	MAX_DEFAULT_WORKER_THREADS	= 16
+};
+
+struct PoolState
+{
+	de::Mutex			lock;			//!< Held while pool is borrowed.
+	volatile deInt32	maxThreads;		//!< Limit from setMaxWorkerThreads(), or 0 for default.
+	de::WorkerPool*		pool;
+
+	PoolState (void)
+		: maxThreads	(0)
+		, pool			(DE_NULL)
+	{
+	}
+
+	~PoolState (void)
+	{
+		delete pool;
+	}
+};
+
+PoolState s_poolState;
+
+} // anonymous
+
+int getMaxWorkerThreads (void)
+{
+	const int maxThreads = s_poolState.maxThreads;
+
+	if (maxThreads > 0)
+		return maxThreads;
+	else
+		return de::max(1, de::min((int)deGetNumAvailableLogicalCores(), (int)MAX_DEFAULT_WORKER_THREADS));
+}
+
+void setMaxWorkerThreads (int numThreads)
+{
+	// \note Pool is re-created with new size when it is borrowed next time.
+	s_poolState.maxThreads = de::max(numThreads, 0);
+}
+
+ScopedMaxWorkerThreads::ScopedMaxWorkerThreads (int numThreads)
+	: m_prevMaxThreads	(s_poolState.maxThreads)
+{
+	setMaxWorkerThreads(numThreads);
+}
+
+ScopedMaxWorkerThreads::~ScopedMaxWorkerThreads (void)
+{
+	setMaxWorkerThreads(m_prevMaxThreads);
+}
+
+SharedWorkerPool::SharedWorkerPool (int maxWorkers)
+	: m_pool		(DE_NULL)
+	, m_numWorkers	(1)
+{
+	const int poolSize = getMaxWorkerThreads();
+
+	if (de::min(maxWorkers, poolSize) > 1 && s_poolState.lock.tryLock())
+	{
+		try
+		{
+			if (!s_poolState.pool || s_poolState.pool->getNumWorkers() != poolSize)
+			{
+				delete s_poolState.pool;
+				s_poolState.pool = DE_NULL;
+				s_poolState.pool = new de::WorkerPool(poolSize);
+			}
+		}
+		catch (...)
+		{
+			s_poolState.lock.unlock();
+			throw;
+		}
+
+		m_pool			= s_poolState.pool;
+		m_numWorkers	= de::min(maxWorkers, poolSize);
+	}
+}
+
+SharedWorkerPool::~SharedWorkerPool (void)
+{
+	if (m_pool)
+		s_poolState.lock.unlock();
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Execute job
+ *
+ * Items are processed by at most getNumWorkers() workers, and workerNdx
+ * passed to job is in [0, getNumWorkers()).
+ *//*--------------------------------------------------------------------*/
+void SharedWorkerPool::execute (de::WorkerPool::Job& job, int numItems)
+{
+	if (m_pool)
+		m_pool->execute(job, numItems, m_numWorkers);
+	else
+	{
+		for (int itemNdx = 0; itemNdx < numItems; itemNdx++)
+			job.execute(itemNdx, 0);
+	}
+}
+
+namespace
+{
+
+class CountJob : public de::WorkerPool::Job
+{
+public:
+	CountJob (std::vector<int>& dst, int numWorkers)
+		: m_dst			(dst)
+		, m_numWorkers	(numWorkers)
+	{
+	}
+
+	void execute (int itemNdx, int workerNdx)
+	{
+		DE_TEST_ASSERT(de::inBounds(workerNdx, 0, m_numWorkers));
+		m_dst[itemNdx] += 1;
+	}
+
+private:
+	std::vector<int>&	m_dst;
+	const int			m_numWorkers;
+};
+
+void checkPool (SharedWorkerPool& pool, int expectedNumWorkers)
+{
+	std::vector<int>	counts	(1000, 0);
+	CountJob			job		(counts, pool.getNumWorkers());
+
+	DE_TEST_ASSERT(pool.getNumWorkers() == expectedNumWorkers);
+
+	pool.execute(job, (int)counts.size());
+
+	for (int ndx = 0; ndx < (int)counts.size(); ndx++)
+		DE_TEST_ASSERT(counts[ndx] == 1);
+}
+
+} // anonymous
+
+void SharedWorkerPool_selfTest (void)
+{
+	// Explicit limit, and nested use falls back to calling thread.
+	{
+		const ScopedMaxWorkerThreads maxThreads (4);
+
+		DE_TEST_ASSERT(getMaxWorkerThreads() == 4);
+
+		{
+			SharedWorkerPool outer (8);
+			checkPool(outer, 4);
+
+			{
+				SharedWorkerPool inner (8);
+				checkPool(inner, 1);
+			}
+		}
+
+		// Requested worker count limits workers.
+		{
+			SharedWorkerPool pool (3);
+			checkPool(pool, 3);
+		}
+	}
+
+	// Threading disabled.
+	{
+		const ScopedMaxWorkerThreads	maxThreads	(1);
+		SharedWorkerPool				pool		(8);
+
+		checkPool(pool, 1);
+	}
+
+	// Default is based on number of cores.
+	{
+		const ScopedMaxWorkerThreads maxThreads (0);
+		DE_TEST_ASSERT(de::inRange(getMaxWorkerThreads(), 1, (int)MAX_DEFAULT_WORKER_THREADS));
+	}
+}
+
+} // tcu
@@ -0,0 +1,86 @@
+#ifndef _TCUWORKERPOOL_HPP
+#define _TCUWORKERPOOL_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program Tester Core
+ * ----------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Shared worker pool for framework utilities.
+ *//*--------------------------------------------------------------------*/
+
+#include "tcuDefs.hpp"
+#include "deWorkerPool.hpp"
+
+namespace tcu
+{
+
+void	SharedWorkerPool_selfTest	(void);
+
+//! Get maximum number of threads used by data-parallel framework utilities.
+int		getMaxWorkerThreads		(void);
+
+//! Set maximum number of threads. 1 disables threading, 0 selects default based on number of CPU cores.
+void	setMaxWorkerThreads		(int numThreads);
+
+//! Override maximum number of threads for the lifetime of this object, for example to test threaded paths on single-core machines.
+class ScopedMaxWorkerThreads
+{
+public:
+	explicit				ScopedMaxWorkerThreads	(int numThreads);
+							~ScopedMaxWorkerThreads	(void);
+
+private:
+							ScopedMaxWorkerThreads	(const ScopedMaxWorkerThreads& other); // Not allowed!
+	ScopedMaxWorkerThreads&	operator=				(const ScopedMaxWorkerThreads& other); // Not allowed!
+
+	const int				m_prevMaxThreads;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Scoped access to shared worker pool
+ *
+ * Framework utilities that split work into independent items, such as
+ * image comparison and texture decompression, borrow a process-wide
+ * de::WorkerPool for the lifetime of this object. The pool is created
+ * on first use with getMaxWorkerThreads() workers and reused afterwards.
+ *
+ * If threading is disabled, or the pool is already borrowed (by another
+ * thread or by a job executing on the pool), jobs are executed on the
+ * calling thread and getNumWorkers() returns 1.
+ *//*--------------------------------------------------------------------*/
+class SharedWorkerPool
+{
+public:
+	explicit			SharedWorkerPool	(int maxWorkers);
+						~SharedWorkerPool	(void);
+
+	int					getNumWorkers		(void) const { return m_numWorkers; }
+
+	void				execute				(de::WorkerPool::Job& job, int numItems);
+
+private:
+						SharedWorkerPool	(const SharedWorkerPool& other); // Not allowed!
+	SharedWorkerPool&	operator=			(const SharedWorkerPool& other); // Not allowed!
+
+	de::WorkerPool*		m_pool;				//!< Borrowed pool, or DE_NULL if executing on calling thread.
+	int					m_numWorkers;
+};
+
+} // tcu
+
+#endif // _TCUWORKERPOOL_HPP
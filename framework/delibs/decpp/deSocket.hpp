@@ -93,9 +93,12 @@ public:
 	bool				isSendOpen			(void)							{ return (deSocket_getOpenChannels(m_socket) & DE_SOCKETCHANNEL_SEND	) != 0;	}
 	bool				isReceiveOpen		(void)							{ return (deSocket_getOpenChannels(m_socket) & DE_SOCKETCHANNEL_RECEIVE	) != 0;	}
 
+	deUintptr			getHandle			(void) const					{ return deSocket_getHandle(m_socket);				}
+
 	void				close				(void);
 
 	deSocketResult		send				(const void* buf, int bufSize, int* numSent)	{ return deSocket_send(m_socket, buf, bufSize, numSent);	}
+	deSocketResult		sendv				(const deSocketBuffer* buffers, int numBuffers, int* numSent)	{ return deSocket_sendv(m_socket, buffers, numBuffers, numSent);	}
 	deSocketResult		receive				(void* buf, int bufSize, int* numRecv)			{ return deSocket_receive(m_socket, buf, bufSize, numRecv);	}
 
 private:
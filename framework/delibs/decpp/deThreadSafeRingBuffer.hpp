@@ -38,7 +38,7 @@ class ThreadSafeRingBuffer
 {
 public:
 				ThreadSafeRingBuffer	(int size);
-				~ThreadSafeRingBuffer	(void) {}
+				~ThreadSafeRingBuffer	(void) { delete[] m_buffer; }
 
 	void		pushFront				(const T& elem);
 	bool		tryPushFront			(const T& elem);
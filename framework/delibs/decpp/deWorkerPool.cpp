@@ -0,0 +1,359 @@
+/*-------------------------------------------------------------------------
+ * drawElements C++ Base Library
+ * -----------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Worker thread pool for data-parallel jobs.
+ *//*--------------------------------------------------------------------*/
+
+#include "deWorkerPool.hpp"
+#include "deThread.hpp"
+#include "deAtomic.h"
+#include "deRandom.hpp"
+
+#include <stdexcept>
+#include <exception>
+#include <string>
+
+#if (__cplusplus >= 201103L) || (DE_COMPILER == DE_COMPILER_MSC && _MSC_VER >= 1600)
+#	define DE_WORKER_POOL_HAS_EXCEPTION_PTR 1
+#else
+#	define DE_WORKER_POOL_HAS_EXCEPTION_PTR 0
+#endif
+
+namespace de
+{
+
+struct WorkerPool::Error
+{
+#if DE_WORKER_POOL_HAS_EXCEPTION_PTR
+	std::exception_ptr	exception;
+#endif
+	std::string			message;
+};
+
+class WorkerPool::WorkerThread : public Thread
+{
+public:
+	WorkerThread (WorkerPool& pool, int workerNdx)
+		: m_pool		(pool)
+		, m_workerNdx	(workerNdx)
+		, m_start		(0)
+	{
+	}
+
+	void signalStart (void)
+	{
+		m_start.increment();
+	}
+
+	void run (void)
+	{
+		for (;;)
+		{
+			m_start.decrement();
+
+			if (m_pool.m_quit)
+				break;
+
+			m_pool.processItems(m_workerNdx);
+			m_pool.m_finished.increment();
+		}
+	}
+
+private:
+	WorkerPool&		m_pool;
+	const int		m_workerNdx;
+	Semaphore		m_start;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Create worker pool
+ * \param numWorkers Number of workers, including the thread calling
+ *					 execute(). With numWorkers == 1 no threads are
+ *					 created and jobs are executed by the caller.
+ *//*--------------------------------------------------------------------*/
+WorkerPool::WorkerPool (int numWorkers)
+	: m_numWorkers		(de::max(numWorkers, 1))
+	, m_finished		(0)
+	, m_job				(DE_NULL)
+	, m_numItems		(0)
+	, m_nextItem		(0)
+	, m_quit			(false)
+	, m_error			(DE_NULL)
+{
+	try
+	{
+		for (int workerNdx = 1; workerNdx < m_numWorkers; workerNdx++)
+		{
+			m_threads.push_back(new WorkerThread(*this, workerNdx));
+			m_threads.back()->start();
+		}
+	}
+	catch (...)
+	{
+		m_quit = true;
+
+		for (std::vector<WorkerThread*>::iterator i = m_threads.begin(); i != m_threads.end(); ++i)
+		{
+			if ((*i)->isStarted())
+			{
+				(*i)->signalStart();
+				(*i)->join();
+			}
+			delete *i;
+		}
+
+		throw;
+	}
+}
+
+WorkerPool::~WorkerPool (void)
+{
+	m_quit = true;
+
+	for (std::vector<WorkerThread*>::iterator i = m_threads.begin(); i != m_threads.end(); ++i)
+		(*i)->signalStart();
+
+	for (std::vector<WorkerThread*>::iterator i = m_threads.begin(); i != m_threads.end(); ++i)
+	{
+		(*i)->join();
+		delete *i;
+	}
+}
+
+void WorkerPool::processItems (int workerNdx)
+{
+	for (;;)
+	{
+		const int itemNdx = (int)deAtomicIncrement32(&m_nextItem) - 1;
+
+		if (itemNdx >= m_numItems)
+			break;
+
+		try
+		{
+			m_job->execute(itemNdx, workerNdx);
+		}
+		catch (const std::exception& e)
+		{
+			setError(e.what());
+		}
+		catch (...)
+		{
+			setError("Unknown exception in worker thread");
+		}
+	}
+}
+
+//! Record current exception if it is the first one. Must be called from a catch block.
+void WorkerPool::setError (const char* message)
+{
+	ScopedLock lock(m_errorLock);
+
+	if (!m_error)
+	{
+		Error* const error = new Error();
+
+		error->message		= message;
+#if DE_WORKER_POOL_HAS_EXCEPTION_PTR
+		error->exception	= std::current_exception();
+#endif
+		m_error = error;
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Execute job
+ * \param job		Job to execute
+ * \param numItems	Number of work items. job.execute() is called exactly
+ *					once for each item in [0, numItems).
+ *
+ * Blocks until all items have been processed. Only one execute() call
+ * may be active at a time.
+ *//*--------------------------------------------------------------------*/
+void WorkerPool::execute (Job& job, int numItems)
+{
+	execute(job, numItems, m_numWorkers);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Execute job on subset of workers
+ * \param job			Job to execute
+ * \param numItems		Number of work items
+ * \param maxWorkers	Maximum number of workers to use. workerNdx passed
+ *						to job is in [0, min(maxWorkers, getNumWorkers())).
+ *//*--------------------------------------------------------------------*/
+void WorkerPool::execute (Job& job, int numItems, int maxWorkers)
+{
+	const int numThreadsToWake = de::min(de::min((int)m_threads.size(), maxWorkers-1), numItems-1);
+
+	if (numItems <= 0)
+		return;
+
+	m_job			= &job;
+	m_numItems		= numItems;
+	m_nextItem		= 0;
+	m_error			= DE_NULL;
+
+	// \note Semaphore operations act as memory barriers for the state above.
+	for (int threadNdx = 0; threadNdx < numThreadsToWake; threadNdx++)
+		m_threads[threadNdx]->signalStart();
+
+	processItems(0);
+
+	for (int threadNdx = 0; threadNdx < numThreadsToWake; threadNdx++)
+		m_finished.decrement();
+
+	m_job = DE_NULL;
+
+	if (m_error)
+	{
+		const Error error = *m_error;
+
+		delete m_error;
+		m_error = DE_NULL;
+
+#if DE_WORKER_POOL_HAS_EXCEPTION_PTR
+		std::rethrow_exception(error.exception);
+#else
+		throw std::runtime_error(error.message);
+#endif
+	}
+}
+
+namespace
+{
+
+class SumJob : public WorkerPool::Job
+{
+public:
+	SumJob (std::vector<deUint32>& dst, int numWorkers)
+		: m_dst			(dst)
+		, m_numWorkers	(numWorkers)
+	{
+	}
+
+	void execute (int itemNdx, int workerNdx)
+	{
+		DE_TEST_ASSERT(de::inBounds(workerNdx, 0, m_numWorkers));
+		m_dst[itemNdx] += (deUint32)itemNdx + 1u;
+	}
+
+private:
+	std::vector<deUint32>&	m_dst;
+	const int				m_numWorkers;
+};
+
+class ThrowingJobError : public std::runtime_error
+{
+public:
+	ThrowingJobError (void) : std::runtime_error("Expected error") {}
+};
+
+class ThrowingJob : public WorkerPool::Job
+{
+public:
+	ThrowingJob (int throwNdx)
+		: m_throwNdx(throwNdx)
+	{
+	}
+
+	void execute (int itemNdx, int workerNdx)
+	{
+		DE_UNREF(workerNdx);
+
+		if (itemNdx == m_throwNdx)
+			throw ThrowingJobError();
+	}
+
+private:
+	const int	m_throwNdx;
+};
+
+} // anonymous
+
+void WorkerPool_selfTest (void)
+{
+	// Every item is processed exactly once.
+	for (int iterNdx = 0; iterNdx < 16; iterNdx++)
+	{
+		Random		rnd			(iterNdx);
+		const int	numWorkers	= rnd.getInt(1, 8);
+		WorkerPool	pool		(numWorkers);
+
+		DE_TEST_ASSERT(pool.getNumWorkers() == numWorkers);
+
+		for (int jobNdx = 0; jobNdx < 4; jobNdx++)
+		{
+			const int				numItems	= rnd.getInt(0, 5000);
+			std::vector<deUint32>	result		(numItems, 0u);
+			SumJob					job			(result, numWorkers);
+
+			pool.execute(job, numItems);
+
+			for (int ndx = 0; ndx < numItems; ndx++)
+				DE_TEST_ASSERT(result[ndx] == (deUint32)ndx + 1u);
+		}
+
+		// Worker indices stay within given limit.
+		{
+			const int				maxWorkers	= rnd.getInt(1, numWorkers);
+			const int				numItems	= rnd.getInt(0, 5000);
+			std::vector<deUint32>	result		(numItems, 0u);
+			SumJob					job			(result, maxWorkers);
+
+			pool.execute(job, numItems, maxWorkers);
+
+			for (int ndx = 0; ndx < numItems; ndx++)
+				DE_TEST_ASSERT(result[ndx] == (deUint32)ndx + 1u);
+		}
+	}
+
+	// Errors are propagated to caller and pool stays usable.
+	for (int throwNdx = 0; throwNdx < 100; throwNdx += 33)
+	{
+		WorkerPool				pool		(4);
+		ThrowingJob				throwingJob	(throwNdx);
+		std::vector<deUint32>	result		(100, 0u);
+		SumJob					sumJob		(result, 4);
+		bool					caught		= false;
+
+		try
+		{
+			pool.execute(throwingJob, 100);
+		}
+#if DE_WORKER_POOL_HAS_EXCEPTION_PTR
+		catch (const ThrowingJobError&)
+#else
+		catch (const std::runtime_error&)
+#endif
+		{
+			caught = true;
+		}
+
+		DE_TEST_ASSERT(caught);
+
+		pool.execute(sumJob, (int)result.size());
+
+		for (int ndx = 0; ndx < (int)result.size(); ndx++)
+			DE_TEST_ASSERT(result[ndx] == (deUint32)ndx + 1u);
+	}
+}
+
+} // de
@@ -0,0 +1,101 @@
+#ifndef _DEWORKERPOOL_HPP
+#define _DEWORKERPOOL_HPP
+/*-------------------------------------------------------------------------
+ * drawElements C++ Base Library
+ * -----------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Worker thread pool for data-parallel jobs.
+ *//*--------------------------------------------------------------------*/
+
+#include "deDefs.hpp"
+#include "deSemaphore.hpp"
+#include "deMutex.hpp"
+
+#include <vector>
+
+namespace de
+{
+
+void WorkerPool_selfTest (void);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Worker thread pool
+ *
+ * WorkerPool executes jobs consisting of numItems independent work items
+ * on a fixed set of worker threads. The calling thread participates in
+ * the work as worker 0, and execute() returns only after all items have
+ * been processed.
+ *
+ * Items are handed out dynamically in increasing order, but they may
+ * complete in any order. Any ordering requirements between items must be
+ * handled by the job, for example by writing results into per-item slots.
+ *
+ * If a job throws an exception, remaining items are still processed and
+ * execute() rethrows the first exception once all workers have finished.
+ * The original exception type is preserved when the compiler supports
+ * std::exception_ptr, otherwise std::runtime_error with the message of
+ * the original exception is thrown.
+ *//*--------------------------------------------------------------------*/
+class WorkerPool
+{
+public:
+	class Job
+	{
+	public:
+		virtual			~Job		(void) {}
+
+		//! Process item itemNdx. workerNdx is in [0, getNumWorkers()) and is unique among concurrently running calls.
+		virtual void	execute		(int itemNdx, int workerNdx) = 0;
+	};
+
+	explicit			WorkerPool		(int numWorkers);
+						~WorkerPool		(void);
+
+	int					getNumWorkers	(void) const { return m_numWorkers; }
+
+	void				execute			(Job& job, int numItems);
+	void				execute			(Job& job, int numItems, int maxWorkers);
+
+private:
+	class WorkerThread;
+	struct Error;
+
+						WorkerPool		(const WorkerPool& other); // Not allowed!
+	WorkerPool&			operator=		(const WorkerPool& other); // Not allowed!
+
+	void				processItems	(int workerNdx);
+	void				setError		(const char* message);
+
+	const int					m_numWorkers;
+	std::vector<WorkerThread*>	m_threads;
+	Semaphore					m_finished;
+
+	// Per-execute() state
+	Job*						m_job;
+	int							m_numItems;
+	volatile deInt32			m_nextItem;
+	volatile bool				m_quit;
+
+	Mutex						m_errorLock;
+	Error*						m_error;		//!< First error during current execute(), or DE_NULL.
+};
+
+} // de
+
+#endif // _DEWORKERPOOL_HPP
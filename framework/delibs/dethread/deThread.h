@@ -56,6 +56,8 @@ typedef struct deThreadAttributes_s
 void			deSleep					(deUint32 milliseconds);
 void			deYield					(void);
 
+deUint32		deGetNumAvailableLogicalCores	(void);
+
 deThread		deThread_create			(deThreadFunc func, void* arg, const deThreadAttributes* attributes);
 deBool			deThread_join			(deThread thread);
 void			deThread_destroy		(deThread thread);
@@ -88,6 +88,9 @@ void deThread_selfTest (void)
 	deSleep(0);
 	deSleep(100);
 	deYield();
+
+	/* Test core count query. */
+	DE_TEST_ASSERT(deGetNumAvailableLogicalCores() >= 1);
 	
 	/* Thread test 1. */
 	{
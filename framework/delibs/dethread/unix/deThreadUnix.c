@@ -147,4 +147,11 @@ void deYield (void)
 	sched_yield();
 }
 
+deUint32 deGetNumAvailableLogicalCores (void)
+{
+	const long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return (count > 0) ? (deUint32)count : 1u;
+}
+
 #endif /* DE_OS */
@@ -115,4 +115,13 @@ void deYield (void)
 	SwitchToThread();	
 }
 
+deUint32 deGetNumAvailableLogicalCores (void)
+{
+	SYSTEM_INFO sysInfo;
+
+	GetSystemInfo(&sysInfo);
+
+	return (sysInfo.dwNumberOfProcessors > 0) ? (deUint32)sysInfo.dwNumberOfProcessors : 1u;
+}
+
 #endif /* DE_OS */
@@ -28,6 +28,7 @@
 
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
@@ -37,6 +38,12 @@ struct deFile_s
 	int fd;
 };
 
+struct deFileMapping_s
+{
+	void*	data;
+	deInt64	size;
+};
+
 deBool deFileExists (const char* filename)
 {
 	struct stat st;
@@ -112,6 +119,11 @@ void deFile_destroy (deFile* file)
 	deFree(file);
 }
 
+deUintptr deFile_getHandle (const deFile* file)
+{
+	return (deUintptr)file->fd;
+}
+
 deBool deFile_setFlags (deFile* file, deUint32 flags)
 {
 	/* Non-blocking. */
@@ -203,6 +215,42 @@ deFileResult deFile_write (deFile* file, const void* buf, deInt64 bufSize, deInt
 	return mapReadWriteResult(numWritten);
 }
 
+deFileMapping* deFileMapping_create (const deFile* file)
+{
+	deFileMapping*	mapping	= DE_NULL;
+	struct stat		st;
+
+	if (fstat(file->fd, &st) != 0 || (deInt64)(size_t)st.st_size != (deInt64)st.st_size)
+		return DE_NULL;
+
+	mapping = (deFileMapping*)deCalloc(sizeof(deFileMapping));
+	if (!mapping)
+		return DE_NULL;
+
+	mapping->size = (deInt64)st.st_size;
+
+	/* Zero-sized files can't be mapped. */
+	if (mapping->size > 0)
+	{
+		mapping->data = mmap(DE_NULL, (size_t)mapping->size, PROT_READ, MAP_PRIVATE, file->fd, 0);
+
+		if (mapping->data == MAP_FAILED)
+		{
+			deFree(mapping);
+			return DE_NULL;
+		}
+	}
+
+	return mapping;
+}
+
+void deFileMapping_destroy (deFileMapping* mapping)
+{
+	if (mapping->data)
+		munmap(mapping->data, (size_t)mapping->size);
+	deFree(mapping);
+}
+
 #elif (DE_OS == DE_OS_WIN32)
 
 #define VC_EXTRALEAN
@@ -214,6 +262,12 @@ struct deFile_s
 	HANDLE handle;
 };
 
+struct deFileMapping_s
+{
+	void*	data;
+	deInt64	size;
+};
+
 deBool deFileExists (const char* filename)
 {
 	return GetFileAttributes(filename) != INVALID_FILE_ATTRIBUTES;
@@ -296,6 +350,11 @@ void deFile_destroy (deFile* file)
 	deFree(file);
 }
 
+deUintptr deFile_getHandle (const deFile* file)
+{
+	return (deUintptr)file->handle;
+}
+
 deBool deFile_setFlags (deFile* file, deUint32 flags)
 {
 	/* Non-blocking. */
@@ -395,6 +454,60 @@ deFileResult deFile_write (deFile* file, const void* buf, deInt64 bufSize, deInt
 	return mapReadWriteResult(result, numWritten32);
 }
 
+deFileMapping* deFileMapping_create (const deFile* file)
+{
+	deFileMapping*	mapping		= DE_NULL;
+	HANDLE			mapHandle	= DE_NULL;
+	deInt64			size		= deFile_getSize(file);
+
+	if (size < 0 || (deInt64)(SIZE_T)size != size)
+		return DE_NULL;
+
+	mapping = (deFileMapping*)deCalloc(sizeof(deFileMapping));
+	if (!mapping)
+		return DE_NULL;
+
+	mapping->size = size;
+
+	/* Zero-sized files can't be mapped. */
+	if (size > 0)
+	{
+		mapHandle = CreateFileMapping(file->handle, DE_NULL, PAGE_READONLY, 0, 0, DE_NULL);
+
+		if (mapHandle)
+		{
+			/* View keeps the mapping object alive. */
+			mapping->data = MapViewOfFile(mapHandle, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapHandle);
+		}
+
+		if (!mapping->data)
+		{
+			deFree(mapping);
+			return DE_NULL;
+		}
+	}
+
+	return mapping;
+}
+
+void deFileMapping_destroy (deFileMapping* mapping)
+{
+	if (mapping->data)
+		UnmapViewOfFile(mapping->data);
+	deFree(mapping);
+}
+
 #else
 #	error Implement deFile for your OS.
 #endif
+
+const void* deFileMapping_getData (const deFileMapping* mapping)
+{
+	return mapping->data;
+}
+
+deInt64 deFileMapping_getSize (const deFileMapping* mapping)
+{
+	return mapping->size;
+}
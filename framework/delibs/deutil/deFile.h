@@ -29,6 +29,7 @@ DE_BEGIN_EXTERN_C
 
 /* File types. */
 typedef struct deFile_s deFile;
+typedef struct deFileMapping_s deFileMapping;
 
 typedef enum deFileMode_e
 {
@@ -73,6 +74,8 @@ deFile*			deFile_create			(const char* filename, deUint32 mode);
 deFile*			deFile_createFromHandle	(deUintptr handle);
 void			deFile_destroy			(deFile* file);
 
+deUintptr		deFile_getHandle		(const deFile* file);
+
 deBool			deFile_setFlags			(deFile* file, deUint32 flags);
 
 deInt64			deFile_getPosition		(const deFile* file);
@@ -82,6 +85,14 @@ deInt64			deFile_getSize			(const deFile* file);
 deFileResult	deFile_read				(deFile* file, void* buf, deInt64 bufSize, deInt64* numRead);
 deFileResult	deFile_write			(deFile* file, const void* buf, deInt64 bufSize, deInt64* numWritten);
 
+/* Read-only memory mapping of whole file. Mapping stays valid after file is destroyed. */
+
+deFileMapping*	deFileMapping_create	(const deFile* file);
+void			deFileMapping_destroy	(deFileMapping* mapping);
+
+const void*		deFileMapping_getData	(const deFileMapping* mapping);
+deInt64			deFileMapping_getSize	(const deFileMapping* mapping);
+
 DE_END_EXTERN_C
 
 #endif /* _DEFILE_H */
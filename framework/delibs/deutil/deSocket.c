@@ -24,6 +24,7 @@
 #include "deSocket.h"
 #include "deMemory.h"
 #include "deMutex.h"
+#include "deInt32.h"
 
 #if (DE_OS == DE_OS_WIN32)
 #	define DE_USE_WINSOCK
@@ -174,6 +175,7 @@ static deBool initWinsock (void)
 
 	/* Berkeley Socket includes. */
 #	include <sys/socket.h>
+#	include <sys/uio.h>
 #	include <netinet/in.h>
 #	include <netinet/tcp.h>
 #	include <arpa/inet.h>
@@ -372,6 +374,11 @@ deUint32 deSocket_getOpenChannels (const deSocket* sock)
 	return sock->openChannels;
 }
 
+deUintptr deSocket_getHandle (const deSocket* sock)
+{
+	return (deUintptr)sock->handle;
+}
+
 deBool deSocket_setFlags (deSocket* sock, deUint32 flags)
 {
 	deSocketHandle fd = sock->handle;
@@ -708,6 +715,60 @@ deSocketResult deSocket_send (deSocket* sock, const void* buf, int bufSize, int*
 	return result;
 }
 
+deSocketResult deSocket_sendv (deSocket* sock, const deSocketBuffer* buffers, int numBuffers, int* numSentPtr)
+{
+	int				numSent		= 0;
+	deSocketResult	result;
+	int				ndx;
+
+	numBuffers = deMin32(numBuffers, DE_SOCKET_MAX_SEND_BUFFERS);
+
+#if defined(DE_USE_WINSOCK)
+	{
+		WSABUF	wsaBuffers[DE_SOCKET_MAX_SEND_BUFFERS];
+		DWORD	numSentDw	= 0;
+
+		for (ndx = 0; ndx < numBuffers; ndx++)
+		{
+			wsaBuffers[ndx].buf	= (char*)buffers[ndx].data;
+			wsaBuffers[ndx].len	= (ULONG)buffers[ndx].size;
+		}
+
+		numSent = WSASend(sock->handle, &wsaBuffers[0], (DWORD)numBuffers, &numSentDw, 0, DE_NULL, DE_NULL) == 0 ? (int)numSentDw : -1;
+	}
+#else
+	{
+		struct iovec	iov[DE_SOCKET_MAX_SEND_BUFFERS];
+		struct msghdr	msg;
+
+		for (ndx = 0; ndx < numBuffers; ndx++)
+		{
+			iov[ndx].iov_base	= (void*)buffers[ndx].data;
+			iov[ndx].iov_len	= (size_t)buffers[ndx].size;
+		}
+
+		deMemset(&msg, 0, sizeof(msg));
+		msg.msg_iov		= &iov[0];
+		msg.msg_iovlen	= numBuffers;
+
+		numSent = (int)sendmsg(sock->handle, &msg, 0);
+	}
+#endif
+
+	result = mapSendRecvResult(numSent);
+
+	if (numSentPtr)
+		*numSentPtr = numSent;
+
+	/* Update state. */
+	if (result == DE_SOCKETRESULT_CONNECTION_CLOSED)
+		deSocket_setChannelsClosed(sock, DE_SOCKETCHANNEL_SEND);
+	else if (result == DE_SOCKETRESULT_CONNECTION_TERMINATED)
+		deSocket_setChannelsClosed(sock, DE_SOCKETCHANNEL_BOTH);
+
+	return result;
+}
+
 deSocketResult deSocket_receive (deSocket* sock, void* buf, int bufSize, int* numReceivedPtr)
 {
 	int				numRecv	= (int)recv(sock->handle, (char*)buf, bufSize, 0);
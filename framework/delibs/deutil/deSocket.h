@@ -99,6 +99,18 @@ typedef enum deSocketChannel_e
 	DE_SOCKETCHANNEL_BOTH		= DE_SOCKETCHANNEL_RECEIVE|DE_SOCKETCHANNEL_SEND
 } deSocketChannel;
 
+/* Buffer for scatter/gather send. */
+typedef struct deSocketBuffer_s
+{
+	const void*	data;
+	int			size;
+} deSocketBuffer;
+
+enum
+{
+	DE_SOCKET_MAX_SEND_BUFFERS	= 16	/*!< Max number of buffers sent in single deSocket_sendv() call, rest are ignored. */
+};
+
 /* Socket API, similar to Berkeley sockets. */
 
 deSocketAddress*	deSocketAddress_create		(void);
@@ -120,6 +132,7 @@ void				deSocket_destroy			(deSocket* socket);
 
 deSocketState		deSocket_getState			(const deSocket* socket);
 deUint32			deSocket_getOpenChannels	(const deSocket* socket);
+deUintptr			deSocket_getHandle			(const deSocket* socket);
 
 deBool				deSocket_setFlags			(deSocket* socket, deUint32 flags);
 
@@ -132,6 +145,7 @@ deBool				deSocket_shutdown			(deSocket* socket, deUint32 channels);
 deBool				deSocket_close				(deSocket* socket);
 
 deSocketResult		deSocket_send				(deSocket* socket, const void* buf, int bufSize, int* numSent);
+deSocketResult		deSocket_sendv				(deSocket* socket, const deSocketBuffer* buffers, int numBuffers, int* numSent);
 deSocketResult		deSocket_receive			(deSocket* socket, void* buf, int bufSize, int* numReceived);
 
 /* Utilities. */
@@ -211,7 +211,7 @@ void Texture2D::loadCompressed (int numLevels, const tcu::CompressedTexture* lev
 	GLU_EXPECT_NO_ERROR(gl.getError(), "Texture upload failed");
 }
 
-Texture2D* Texture2D::create (const RenderContext& context, const ContextInfo& contextInfo, const tcu::Archive& archive, int numLevels, const char* const* levelFileNames)
+Texture2D* Texture2D::create (const RenderContext& context, const ContextInfo& contextInfo, const tcu::Archive& archive, int numLevels, const char* const* levelFileNames, const tcu::CompressedTexture::DecompressionParams& decompressionParams)
 {
 	DE_ASSERT(numLevels > 0);
 
@@ -266,13 +266,13 @@ Texture2D* Texture2D::create (const RenderContext& context, const ContextInfo& c
 		for (int ndx = 0; ndx < numLevels; ndx++)
 			tcu::ImageIO::loadPKM(levels[ndx], archive, levelFileNames[ndx]);
 
-		return new Texture2D(context, contextInfo, numLevels, &levels[0]);
+		return new Texture2D(context, contextInfo, numLevels, &levels[0], decompressionParams);
 	}
 	else
 		TCU_FAIL("Unsupported file format");
 }
 
-Texture2D* Texture2D::create (const RenderContext& context, const ContextInfo& contextInfo, const tcu::Archive& archive, int numLevels, const std::vector<std::string>& filenames)
+Texture2D* Texture2D::create (const RenderContext& context, const ContextInfo& contextInfo, const tcu::Archive& archive, int numLevels, const std::vector<std::string>& filenames, const tcu::CompressedTexture::DecompressionParams& decompressionParams)
 {
 	TCU_CHECK(numLevels == (int)filenames.size());
 
@@ -280,7 +280,7 @@ Texture2D* Texture2D::create (const RenderContext& context, const ContextInfo& c
 	for (int ndx = 0; ndx < (int)filenames.size(); ndx++)
 		charPtrs[ndx] = filenames[ndx].c_str();
 
-	return Texture2D::create(context, contextInfo, archive, numLevels, &charPtrs[0]);
+	return Texture2D::create(context, contextInfo, archive, numLevels, &charPtrs[0], decompressionParams);
 }
 
 // TextureCube
@@ -418,7 +418,7 @@ void TextureCube::loadCompressed (int numLevels, const tcu::CompressedTexture* l
 	GLU_EXPECT_NO_ERROR(gl.getError(), "Texture upload failed");
 }
 
-TextureCube* TextureCube::create (const RenderContext& context, const ContextInfo& contextInfo, const tcu::Archive& archive, int numLevels, const char* const* filenames)
+TextureCube* TextureCube::create (const RenderContext& context, const ContextInfo& contextInfo, const tcu::Archive& archive, int numLevels, const char* const* filenames, const tcu::CompressedTexture::DecompressionParams& decompressionParams)
 {
 	DE_ASSERT(numLevels > 0);
 
@@ -434,13 +434,13 @@ TextureCube* TextureCube::create (const RenderContext& context, const ContextInf
 		for (int ndx = 0; ndx < numImages; ndx++)
 			tcu::ImageIO::loadPKM(levels[ndx], archive, filenames[ndx]);
 
-		return new TextureCube(context, contextInfo, numLevels, &levels[0]);
+		return new TextureCube(context, contextInfo, numLevels, &levels[0], decompressionParams);
 	}
 	else
 		TCU_FAIL("Unsupported file format");
 }
 
-TextureCube* TextureCube::create (const RenderContext& context, const ContextInfo& contextInfo, const tcu::Archive& archive, int numLevels, const std::vector<std::string>& filenames)
+TextureCube* TextureCube::create (const RenderContext& context, const ContextInfo& contextInfo, const tcu::Archive& archive, int numLevels, const std::vector<std::string>& filenames, const tcu::CompressedTexture::DecompressionParams& decompressionParams)
 {
 	DE_STATIC_ASSERT(tcu::CUBEFACE_LAST == 6);
 	TCU_CHECK(numLevels*tcu::CUBEFACE_LAST == (int)filenames.size());
@@ -449,7 +449,7 @@ TextureCube* TextureCube::create (const RenderContext& context, const ContextInf
 	for (int ndx = 0; ndx < (int)filenames.size(); ndx++)
 		charPtrs[ndx] = filenames[ndx].c_str();
 
-	return TextureCube::create(context, contextInfo, archive, numLevels, &charPtrs[0]);
+	return TextureCube::create(context, contextInfo, archive, numLevels, &charPtrs[0], decompressionParams);
 }
 
 // Texture1DArray
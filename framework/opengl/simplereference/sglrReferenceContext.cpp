@@ -28,6 +28,7 @@
 #include "tcuMatrix.hpp"
 #include "tcuMatrixUtil.hpp"
 #include "tcuVectorUtil.hpp"
+#include "tcuWorkerPool.hpp"
 #include "gluDefs.hpp"
 #include "gluTextureUtil.hpp"
 #include "glwFunctions.hpp"
@@ -384,6 +385,8 @@ ReferenceContext::ReferenceContext (const ReferenceContextLimits& limits, const
 	, m_primitiveRestartIndex			(0)
 
 	, m_lastError						(GL_NO_ERROR)
+
+	, m_renderer						(tcu::getMaxWorkerThreads())
 {
 	// Create empty textures to be used when texture objects are incomplete.
 	m_emptyTex1D.getSampler().wrapS		= tcu::Sampler::CLAMP_TO_EDGE;
@@ -4313,7 +4316,7 @@ void ReferenceContext::drawWithReference (const rr::PrimitiveList& primitives, i
 													 (m_currentProgram->m_program->m_hasGeometryShader) ? (m_currentProgram->m_program->getGeometryShader()) : (DE_NULL));
 	rr::RenderState						state		((rr::ViewportState)(colorBuf0));
 
-	const rr::Renderer					referenceRenderer;
+	const rr::Renderer&					referenceRenderer	= m_currentProgram->m_program->isThreadSafe() ? m_renderer : m_serialRenderer;
 	std::vector<rr::VertexAttrib>		vertexAttribs;
 
 	// Gen state
@@ -959,6 +959,9 @@ private:
 	rr::FragmentProcessor						m_fragmentProcessor;
 	std::vector<rr::Fragment>					m_fragmentBuffer;
 	std::vector<float>							m_fragmentDepths;
+
+	const rr::Renderer							m_renderer;			//!< Borrows threads from tcu::SharedWorkerPool, used for thread-safe programs.
+	const rr::Renderer							m_serialRenderer;	//!< Used for programs that are not thread-safe.
 };
 
 } // sglr
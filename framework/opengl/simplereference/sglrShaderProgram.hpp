@@ -235,6 +235,9 @@ public:
 	inline const rr::FragmentShader*		getFragmentShader	(void) const { return static_cast<const rr::FragmentShader*>(this); }
 	inline const rr::GeometryShader*		getGeometryShader	(void) const { return static_cast<const rr::GeometryShader*>(this); }
 
+	//! Returns true if shadeVertices() and shadeFragments() may be called from several threads at once. Only such programs are drawn with multithreaded renderer.
+	virtual bool							isThreadSafe		(void) const { return false; }
+
 private:
 	virtual void							shadeVertices		(const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const = 0;
 	virtual void							shadeFragments		(rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const = 0;
@@ -46,6 +46,9 @@ int main (int argc, const char* argv[])
 		tcu::CommandLine				cmdLine		(argc, argv);
 		tcu::DirArchive					archive		(".");
 		tcu::TestLog					log			(cmdLine.getLogFileName(), cmdLine.getLogFlags());
+
+		log.setImageEncoding(cmdLine.getLogImageCompressionLevel(), cmdLine.getLogImageFilter());
+
 		de::UniquePtr<tcu::Platform>	platform	(createPlatform());
 		de::UniquePtr<tcu::App>			app			(new tcu::App(*platform, archive, log, cmdLine));
 
@@ -31,6 +31,8 @@
 #include "deString.h"
 
 #include "deMutex.h"
+#include "deSemaphore.h"
+#include "deThread.h"
 
 #if defined(QP_SUPPORT_PNG)
 #	include <png.h>
@@ -119,6 +121,216 @@ DE_INLINE ContainerType ContainerStack_getTop (const ContainerStack* stack)
 
 #endif
 
+typedef struct Buffer_s
+{
+	int			capacity;
+	int			size;
+	deUint8*	data;
+} Buffer;
+
+void Buffer_init (Buffer* buffer)
+{
+	buffer->capacity	= 0;
+	buffer->size		= 0;
+	buffer->data		= DE_NULL;
+}
+
+void Buffer_deinit (Buffer* buffer)
+{
+	deFree(buffer->data);
+	Buffer_init(buffer);
+}
+
+deBool Buffer_resize (Buffer* buffer, int newSize)
+{
+	/* Grow buffer if necessary. */
+	if (newSize > buffer->capacity)
+	{
+		int			newCapacity	= deAlign32(deMax32(2*buffer->capacity, newSize), 512);
+		deUint8*	newData		= (deUint8*)deMalloc(newCapacity);
+		if (!newData)
+			return DE_FALSE;
+
+		memcpy(newData, buffer->data, buffer->size);
+		deFree(buffer->data);
+		buffer->data		= newData;
+		buffer->capacity	= newCapacity;
+	}
+
+	buffer->size = newSize;
+	return DE_TRUE;
+}
+
+deBool Buffer_append (Buffer* buffer, const deUint8* data, int numBytes)
+{
+	int offset = buffer->size;
+
+	if (!Buffer_resize(buffer, buffer->size + numBytes))
+		return DE_FALSE;
+
+	/* Append bytes. */
+	memcpy(&buffer->data[offset], data, numBytes);
+	return DE_TRUE;
+}
+
+/* Records passed to asynchronous writer thread. */
+
+typedef enum LogRecordType_e
+{
+	LOG_RECORD_TEXT = 0,		/*!< Text to be written as-is.							*/
+	LOG_RECORD_IMAGE,			/*!< Image data to be compressed and base64 encoded.	*/
+	LOG_RECORD_FENCE,			/*!< Flush file and signal test thread.					*/
+	LOG_RECORD_QUIT,			/*!< Terminate writer thread.							*/
+
+	LOG_RECORD_LAST
+} LogRecordType;
+
+typedef struct LogRecord_s
+{
+	LogRecordType			type;
+	Buffer					data;				/*!< Text, or tightly packed pixel data.	*/
+
+	/* Image parameters. */
+	qpImageCompressionMode	compressionMode;
+	qpImageFormat			imageFormat;
+	int						width;
+	int						height;
+	int						elementDepth;		/*!< Element depth for indenting image data.	*/
+	int						compressionLevel;
+	qpImageFilter			filter;
+} LogRecord;
+
+enum
+{
+	ASYNC_QUEUE_SIZE		= 64
+};
+
+/* Image logged in current test case, kept for deduplication. */
+typedef struct LoggedImage_s
+{
+	deUint64		hash;				/*!< Content hash, zero marks an empty slot.	*/
+	qpImageFormat	imageFormat;
+	int				width;
+	int				height;
+	deUint8*		pixels;				/*!< Packed copy of pixel data.					*/
+} LoggedImage;
+
+/* Set of logged images keyed by content hash. */
+typedef struct LoggedImageSet_s
+{
+	int				capacity;
+	int				size;
+	LoggedImage*	slots;
+} LoggedImageSet;
+
+static void LoggedImageSet_init (LoggedImageSet* set)
+{
+	set->capacity	= 0;
+	set->size		= 0;
+	set->slots		= DE_NULL;
+}
+
+static void LoggedImageSet_deinit (LoggedImageSet* set)
+{
+	int ndx;
+
+	for (ndx = 0; ndx < set->capacity; ndx++)
+		deFree(set->slots[ndx].pixels);
+
+	deFree(set->slots);
+	LoggedImageSet_init(set);
+}
+
+static void LoggedImageSet_insertSlot (LoggedImage* slots, int capacity, const LoggedImage* image)
+{
+	int ndx = (int)(image->hash & (deUint64)(capacity-1));
+
+	while (slots[ndx].hash != 0)
+		ndx = (ndx + 1) & (capacity-1);
+
+	slots[ndx] = *image;
+}
+
+static const LoggedImage* LoggedImageSet_find (const LoggedImageSet* set, deUint64 hash)
+{
+	int ndx;
+
+	if (set->capacity == 0)
+		return DE_NULL;
+
+	for (ndx = (int)(hash & (deUint64)(set->capacity-1)); set->slots[ndx].hash != 0; ndx = (ndx + 1) & (set->capacity-1))
+	{
+		if (set->slots[ndx].hash == hash)
+			return &set->slots[ndx];
+	}
+
+	return DE_NULL;
+}
+
+/* Compare pixels, matching hash alone does not prove images are identical. */
+static deBool LoggedImage_equals (const LoggedImage* image, qpImageFormat imageFormat, int width, int height, int stride, const void* data)
+{
+	const int	packedStride	= (imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4) * width;
+	int			row;
+
+	if (image->imageFormat != imageFormat || image->width != width || image->height != height)
+		return DE_FALSE;
+
+	for (row = 0; row < height; row++)
+	{
+		if (memcmp(&image->pixels[packedStride*row], &((const deUint8*)data)[row*stride], packedStride) != 0)
+			return DE_FALSE;
+	}
+
+	return DE_TRUE;
+}
+
+static deBool LoggedImageSet_insert (LoggedImageSet* set, deUint64 hash, qpImageFormat imageFormat, int width, int height, int stride, const void* data)
+{
+	const int	packedStride	= (imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4) * width;
+	LoggedImage	image;
+	int			row;
+
+	DE_ASSERT(hash != 0 && !LoggedImageSet_find(set, hash));
+
+	/* Keep load factor below 1/2. */
+	if (2*(set->size+1) > set->capacity)
+	{
+		const int		newCapacity	= deMax32(2*set->capacity, 16);
+		LoggedImage*	newSlots	= (LoggedImage*)deCalloc(newCapacity * (int)sizeof(LoggedImage));
+		int				ndx;
+
+		if (!newSlots)
+			return DE_FALSE;
+
+		for (ndx = 0; ndx < set->capacity; ndx++)
+		{
+			if (set->slots[ndx].hash != 0)
+				LoggedImageSet_insertSlot(newSlots, newCapacity, &set->slots[ndx]);
+		}
+
+		deFree(set->slots);
+		set->slots		= newSlots;
+		set->capacity	= newCapacity;
+	}
+
+	image.hash			= hash;
+	image.imageFormat	= imageFormat;
+	image.width			= width;
+	image.height		= height;
+	image.pixels		= (deUint8*)deMalloc(packedStride*height);
+
+	if (!image.pixels)
+		return DE_FALSE;
+
+	for (row = 0; row < height; row++)
+		memcpy(&image.pixels[packedStride*row], &((const deUint8*)data)[row*stride], packedStride);
+
+	LoggedImageSet_insertSlot(set->slots, set->capacity, &image);
+	set->size += 1;
+	return DE_TRUE;
+}
+
 /* qpTestLog instance */
 struct qpTestLog_s
 {
@@ -128,13 +340,31 @@ struct qpTestLog_s
 
 	/* State protected by lock. */
 	FILE*					outputFile;
-	qpXmlWriter*			writer;
+	qpXmlWriter*			writer;				/*!< Buffer writer in async mode.		*/
 	deBool					isSessionOpen;
 	deBool					isCaseOpen;
 
 #if defined(DE_DEBUG)
 	ContainerStack			containerStack;		/*!< For container usage verification.	*/
 #endif
+
+	/* Asynchronous mode. Test thread enqueues records while holding lock,
+	 * writer thread is the only consumer. Semaphores order accesses to
+	 * queue slots so that head and tail need no further locking. */
+	deThread				writerThread;
+	deSemaphore				numFreeSlots;
+	deSemaphore				numQueuedRecords;
+	deSemaphore				fenceReached;
+	LogRecord*				queue[ASYNC_QUEUE_SIZE];
+	int						queueHead;			/*!< Next slot to write, owned by test thread.	*/
+	int						queueTail;			/*!< Next slot to read, owned by writer thread.	*/
+	Buffer					pendingText;		/*!< Text not yet enqueued, owned by test thread.	*/
+	qpXmlWriter*			fileWriter;			/*!< Writer for image data, owned by writer thread.	*/
+
+	/* Image encoding. */
+	int						imageCompressionLevel;
+	qpImageFilter			imageFilter;
+	LoggedImageSet			loggedImages;		/*!< Images logged in current case.		*/
 };
 
 /* Maps integer to string. */
@@ -258,6 +488,245 @@ static void qpTestLog_flushFile (qpTestLog* log)
 #endif
 }
 
+#if defined(QP_SUPPORT_PNG)
+static deBool compressImagePNG (Buffer* buffer, qpImageFormat imageFormat, int width, int height, int rowStride, const void* data, int compressionLevel, qpImageFilter filter);
+#endif
+
+/* Asynchronous writer. */
+
+/* True if records are passed to writer thread. */
+DE_INLINE deBool isAsync (const qpTestLog* log)
+{
+	return log->writerThread != 0;
+}
+
+static LogRecord* LogRecord_create (LogRecordType type)
+{
+	LogRecord* record = (LogRecord*)deCalloc(sizeof(LogRecord));
+	if (!record)
+		return DE_NULL;
+
+	record->type = type;
+	Buffer_init(&record->data);
+
+	return record;
+}
+
+static void LogRecord_destroy (LogRecord* record)
+{
+	Buffer_deinit(&record->data);
+	deFree(record);
+}
+
+static void writeImageRecord (qpTestLog* log, const LogRecord* record)
+{
+	const deUint8*	writeDataPtr	= record->data.data;
+	int				writeDataBytes	= record->data.size;
+	Buffer			compressedBuffer;
+
+	Buffer_init(&compressedBuffer);
+
+#if defined(QP_SUPPORT_PNG)
+	if (record->compressionMode == QP_IMAGE_COMPRESSION_MODE_PNG)
+	{
+		const int pixelSize = record->imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4;
+
+		if (compressImagePNG(&compressedBuffer, record->imageFormat, record->width, record->height, pixelSize*record->width, record->data.data, record->compressionLevel, record->filter))
+		{
+			writeDataPtr	= compressedBuffer.data;
+			writeDataBytes	= compressedBuffer.size;
+		}
+		else
+		{
+			/* Compression mode has already been written, image data can only be omitted. */
+			qpPrintf("WARNING: PNG compression failed -- image data omitted.\n");
+			writeDataBytes	= 0;
+		}
+	}
+#endif
+
+	if (writeDataBytes > 0 && !qpXmlWriter_writeBase64AtDepth(log->fileWriter, record->elementDepth, writeDataPtr, writeDataBytes))
+		qpPrintf("ERROR: Writing image data failed.\n");
+
+	Buffer_deinit(&compressedBuffer);
+}
+
+static void writerThreadMain (void* arg)
+{
+	qpTestLog*	log		= (qpTestLog*)arg;
+	deBool		quit	= DE_FALSE;
+
+	while (!quit)
+	{
+		LogRecord* record;
+
+		deSemaphore_decrement(log->numQueuedRecords);
+		record			= log->queue[log->queueTail];
+		log->queueTail	= (log->queueTail + 1) % ASYNC_QUEUE_SIZE;
+		deSemaphore_increment(log->numFreeSlots);
+
+		switch (record->type)
+		{
+			case LOG_RECORD_TEXT:
+				fwrite(record->data.data, 1, (size_t)record->data.size, log->outputFile);
+				break;
+
+			case LOG_RECORD_IMAGE:
+				writeImageRecord(log, record);
+				break;
+
+			case LOG_RECORD_FENCE:
+				qpTestLog_flushFile(log);
+				deSemaphore_increment(log->fenceReached);
+				break;
+
+			case LOG_RECORD_QUIT:
+				quit = DE_TRUE;
+				break;
+
+			default:
+				DE_ASSERT(DE_FALSE);
+		}
+
+		LogRecord_destroy(record);
+	}
+}
+
+/* Hand record over to writer thread. Must be called while holding log->lock. */
+static void enqueueRecord (qpTestLog* log, LogRecord* record)
+{
+	deSemaphore_decrement(log->numFreeSlots);
+	log->queue[log->queueHead]	= record;
+	log->queueHead				= (log->queueHead + 1) % ASYNC_QUEUE_SIZE;
+	deSemaphore_increment(log->numQueuedRecords);
+}
+
+/* Move XML written so far into pending text. */
+static void collectPendingXml (qpTestLog* log)
+{
+	const int numBytes = qpXmlWriter_getBufferSize(log->writer);
+
+	if (numBytes > 0)
+	{
+		if (!Buffer_append(&log->pendingText, qpXmlWriter_getBufferData(log->writer), numBytes))
+			qpPrintf("ERROR: Out of memory in async test log.\n");
+
+		qpXmlWriter_clearBuffer(log->writer);
+	}
+}
+
+/* Enqueue all pending text for writing. */
+static void submitPendingText (qpTestLog* log)
+{
+	collectPendingXml(log);
+
+	if (log->pendingText.size > 0)
+	{
+		LogRecord* record = LogRecord_create(LOG_RECORD_TEXT);
+
+		if (record)
+		{
+			/* Transfer ownership of pending data. */
+			record->data = log->pendingText;
+			Buffer_init(&log->pendingText);
+			enqueueRecord(log, record);
+		}
+		else
+			qpPrintf("ERROR: Out of memory in async test log.\n");
+	}
+}
+
+/* Write text outside XML document, such as #beginTestCaseResult. */
+static void writeRawText (qpTestLog* log, const char* str)
+{
+	if (isAsync(log))
+	{
+		collectPendingXml(log);
+
+		if (!Buffer_append(&log->pendingText, (const deUint8*)str, (int)strlen(str)))
+			qpPrintf("ERROR: Out of memory in async test log.\n");
+	}
+	else
+		fputs(str, log->outputFile);
+}
+
+/* Make sure everything written so far is in the file. In async mode this
+ * waits until writer thread has processed all queued records. */
+static void syncFile (qpTestLog* log)
+{
+	if (isAsync(log))
+	{
+		LogRecord* fence = LogRecord_create(LOG_RECORD_FENCE);
+
+		submitPendingText(log);
+
+		if (fence)
+		{
+			enqueueRecord(log, fence);
+			deSemaphore_decrement(log->fenceReached);
+		}
+		else
+			qpPrintf("ERROR: Out of memory in async test log.\n");
+	}
+	else
+		qpTestLog_flushFile(log);
+}
+
+static deBool startAsyncWriter (qpTestLog* log)
+{
+	log->numFreeSlots		= deSemaphore_create(ASYNC_QUEUE_SIZE, DE_NULL);
+	log->numQueuedRecords	= deSemaphore_create(0, DE_NULL);
+	log->fenceReached		= deSemaphore_create(0, DE_NULL);
+	log->fileWriter			= qpXmlWriter_createFileWriter(log->outputFile, 0);
+
+	if (!log->numFreeSlots || !log->numQueuedRecords || !log->fenceReached || !log->fileWriter)
+		return DE_FALSE;
+
+	log->writerThread = deThread_create(writerThreadMain, log, DE_NULL);
+
+	return log->writerThread != 0;
+}
+
+static void stopAsyncWriter (qpTestLog* log)
+{
+	if (log->writerThread)
+	{
+		LogRecord* quit = LogRecord_create(LOG_RECORD_QUIT);
+
+		submitPendingText(log);
+
+		if (quit)
+		{
+			enqueueRecord(log, quit);
+			deThread_join(log->writerThread);
+		}
+		else
+			qpPrintf("ERROR: Out of memory, unable to stop async log writer.\n");
+
+		deThread_destroy(log->writerThread);
+		log->writerThread = 0;
+	}
+
+	if (log->fileWriter)
+		qpXmlWriter_destroy(log->fileWriter);
+
+	if (log->fenceReached)
+		deSemaphore_destroy(log->fenceReached);
+
+	if (log->numQueuedRecords)
+		deSemaphore_destroy(log->numQueuedRecords);
+
+	if (log->numFreeSlots)
+		deSemaphore_destroy(log->numFreeSlots);
+
+	Buffer_deinit(&log->pendingText);
+
+	log->fileWriter			= DE_NULL;
+	log->fenceReached		= 0;
+	log->numQueuedRecords	= 0;
+	log->numFreeSlots		= 0;
+}
+
 #define QP_LOOKUP_STRING(KEYMAP, KEY)	qpLookupString(KEYMAP, DE_LENGTH_OF_ARRAY(KEYMAP), (int)(KEY))
 
 static const char* qpLookupString (const qpKeyStringMap* keyMap, int keyMapSize, int key)
@@ -315,8 +784,8 @@ static deBool endSession (qpTestLog* log)
     qpXmlWriter_flush(log->writer);
 
     /* Write out #endSession. */
-	fprintf(log->outputFile, "\n#endSession\n");
-	qpTestLog_flushFile(log);
+	writeRawText(log, "\n#endSession\n");
+	syncFile(log);
 
 	log->isSessionOpen = DE_FALSE;
 
@@ -350,11 +819,15 @@ qpTestLog* qpTestLog_createFileLog (const char* fileName, deUint32 flags)
 	}
 
 	log->flags			= flags;
-	log->writer			= qpXmlWriter_createFileWriter(log->outputFile, 0);
+	log->writer			= (flags & QP_TEST_LOG_ASYNC) ? qpXmlWriter_createBufferWriter() : qpXmlWriter_createFileWriter(log->outputFile, 0);
 	log->lock			= deMutex_create(DE_NULL);
 	log->isSessionOpen	= DE_FALSE;
 	log->isCaseOpen		= DE_FALSE;
 
+	log->imageCompressionLevel	= QP_IMAGE_COMPRESSION_LEVEL_DEFAULT;
+	log->imageFilter			= QP_IMAGE_FILTER_DEFAULT;
+	LoggedImageSet_init(&log->loggedImages);
+
 	if (!log->writer)
 	{
 		qpPrintf("ERROR: Unable to create output XML writer to file '%s'.\n", fileName);
@@ -371,6 +844,28 @@ qpTestLog* qpTestLog_createFileLog (const char* fileName, deUint32 flags)
 
 	beginSession(log);
 
+	/* \note Session start is written synchronously, writer thread is only started after that. */
+	if ((flags & QP_TEST_LOG_ASYNC) && !startAsyncWriter(log))
+	{
+		qpXmlWriter* fileWriter;
+
+		qpPrintf("WARNING: Unable to start asynchronous log writer, writing log synchronously.\n");
+		stopAsyncWriter(log);
+		log->flags &= ~(deUint32)QP_TEST_LOG_ASYNC;
+
+		/* Nothing has been written to buffer writer yet, replace it with file writer. */
+		fileWriter = qpXmlWriter_createFileWriter(log->outputFile, 0);
+		if (!fileWriter)
+		{
+			qpPrintf("ERROR: Unable to create output XML writer to file '%s'.\n", fileName);
+			qpTestLog_destroy(log);
+			return DE_NULL;
+		}
+
+		qpXmlWriter_destroy(log->writer);
+		log->writer = fileWriter;
+	}
+
 	return log;
 }
 
@@ -385,6 +880,9 @@ void qpTestLog_destroy (qpTestLog* log)
 	if (log->isSessionOpen)
 		endSession(log);
 
+	if (log->flags & QP_TEST_LOG_ASYNC)
+		stopAsyncWriter(log);
+
 	if (log->writer)
 		qpXmlWriter_destroy(log->writer);
 
@@ -394,9 +892,34 @@ void qpTestLog_destroy (qpTestLog* log)
 	if (log->lock)
 		deMutex_destroy(log->lock);
 
+	LoggedImageSet_deinit(&log->loggedImages);
+
 	deFree(log);
 }
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Set image encoding parameters
+ * \param log				qpTestLog instance
+ * \param compressionLevel	zlib compression level (0-9) for PNG images,
+ *							or QP_IMAGE_COMPRESSION_LEVEL_DEFAULT
+ * \param filter			PNG row filter
+ *
+ * Low compression level and a fixed filter speed up logging of large
+ * images at the cost of log size. Parameters apply to images written
+ * after the call.
+ *//*--------------------------------------------------------------------*/
+void qpTestLog_setImageEncoding (qpTestLog* log, int compressionLevel, qpImageFilter filter)
+{
+	DE_ASSERT(log);
+	DE_ASSERT(compressionLevel == QP_IMAGE_COMPRESSION_LEVEL_DEFAULT || deInRange32(compressionLevel, 0, 9));
+	DE_ASSERT(deInBounds32(filter, 0, QP_IMAGE_FILTER_LAST));
+
+	deMutex_lock(log->lock);
+	log->imageCompressionLevel	= compressionLevel;
+	log->imageFilter			= filter;
+	deMutex_unlock(log->lock);
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief Log start of test case
  * \param log qpTestLog instance
@@ -418,11 +941,16 @@ deBool qpTestLog_startCase (qpTestLog* log, const char* testCasePath, qpTestCase
 
 	/* Flush XML and write out #beginTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#beginTestCaseResult %s\n", testCasePath);
-	qpTestLog_flushFile(log);
+	writeRawText(log, "\n#beginTestCaseResult ");
+	writeRawText(log, testCasePath);
+	writeRawText(log, "\n");
+	syncFile(log);
 
 	log->isCaseOpen = DE_TRUE;
 
+	/* DuplicateOf may only refer to images within same <TestCaseResult>. */
+	LoggedImageSet_deinit(&log->loggedImages);
+
 	/* Fill in attributes. */
 	resultAttribs[numResultAttribs++] = qpSetStringAttrib("Version", LOG_FORMAT_VERSION);
 	resultAttribs[numResultAttribs++] = qpSetStringAttrib("CasePath", testCasePath);
@@ -472,8 +1000,8 @@ deBool qpTestLog_endCase (qpTestLog* log, qpTestResult result, const char* resul
 
 	/* Flush XML and write #endTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#endTestCaseResult\n");
-	qpTestLog_flushFile(log);
+	writeRawText(log, "\n#endTestCaseResult\n");
+	syncFile(log);
 
 	log->isCaseOpen = DE_FALSE;
 
@@ -504,8 +1032,10 @@ deBool qpTestLog_terminateCase (qpTestLog* log, qpTestResult result)
 
 	/* Flush XML and write #terminateTestCaseResult. */
 	qpXmlWriter_flush(log->writer);
-	fprintf(log->outputFile, "\n#terminateTestCaseResult %s\n", resultStr);
-	qpTestLog_flushFile(log);
+	writeRawText(log, "\n#terminateTestCaseResult ");
+	writeRawText(log, resultStr);
+	writeRawText(log, "\n");
+	syncFile(log);
 
 	log->isCaseOpen = DE_FALSE;
 
@@ -625,58 +1155,6 @@ deBool qpTestLog_writeFloat (qpTestLog* log, const char* name, const char* descr
 	return qpTestLog_writeKeyValuePair(log, "Number", name, description, unit, tag, tmpString);
 }
 
-typedef struct Buffer_s
-{
-	int			capacity;
-	int			size;
-	deUint8*	data;
-} Buffer;
-
-void Buffer_init (Buffer* buffer)
-{
-	buffer->capacity	= 0;
-	buffer->size		= 0;
-	buffer->data		= DE_NULL;
-}
-
-void Buffer_deinit (Buffer* buffer)
-{
-	deFree(buffer->data);
-	Buffer_init(buffer);
-}
-
-deBool Buffer_resize (Buffer* buffer, int newSize)
-{
-	/* Grow buffer if necessary. */
-	if (newSize > buffer->capacity)
-	{
-		int			newCapacity	= deAlign32(deMax32(2*buffer->capacity, newSize), 512);
-		deUint8*	newData		= (deUint8*)deMalloc(newCapacity);
-		if (!newData)
-			return DE_FALSE;
-
-		memcpy(newData, buffer->data, buffer->size);
-		deFree(buffer->data);
-		buffer->data		= newData;
-		buffer->capacity	= newCapacity;
-	}
-
-	buffer->size = newSize;
-	return DE_TRUE;
-}
-
-deBool Buffer_append (Buffer* buffer, const deUint8* data, int numBytes)
-{
-	int offset = buffer->size;
-
-	if (!Buffer_resize(buffer, buffer->size + numBytes))
-		return DE_FALSE;
-
-	/* Append bytes. */
-	memcpy(&buffer->data[offset], data, numBytes);
-	return DE_TRUE;
-}
-
 #if defined(QP_SUPPORT_PNG)
 void pngWriteData (png_structp png, png_bytep dataPtr, png_size_t numBytes)
 {
@@ -712,7 +1190,22 @@ static deBool writeCompressedPNG (png_structp png, png_infop info, png_byte** ro
 		return DE_FALSE;
 }
 
-static deBool compressImagePNG (Buffer* buffer, qpImageFormat imageFormat, int width, int height, int rowStride, const void* data)
+static int getPNGFilterMask (qpImageFilter filter)
+{
+	switch (filter)
+	{
+		case QP_IMAGE_FILTER_NONE:		return PNG_FILTER_NONE;
+		case QP_IMAGE_FILTER_SUB:		return PNG_FILTER_SUB;
+		case QP_IMAGE_FILTER_UP:		return PNG_FILTER_UP;
+		case QP_IMAGE_FILTER_AVERAGE:	return PNG_FILTER_AVG;
+		case QP_IMAGE_FILTER_PAETH:		return PNG_FILTER_PAETH;
+		default:
+			DE_ASSERT(DE_FALSE);
+			return PNG_ALL_FILTERS;
+	}
+}
+
+static deBool compressImagePNG (Buffer* buffer, qpImageFormat imageFormat, int width, int height, int rowStride, const void* data, int compressionLevel, qpImageFilter filter)
 {
 	deBool			compressOk		= DE_FALSE;
 	png_structp		png				= DE_NULL;
@@ -740,6 +1233,12 @@ static deBool compressImagePNG (Buffer* buffer, qpImageFormat imageFormat, int w
 		/* Set our own write function. */
 		png_set_write_fn(png, buffer, pngWriteData, pngFlushData);
 
+		if (compressionLevel != QP_IMAGE_COMPRESSION_LEVEL_DEFAULT)
+			png_set_compression_level(png, compressionLevel);
+
+		if (filter != QP_IMAGE_FILTER_DEFAULT)
+			png_set_filter(png, PNG_FILTER_TYPE_BASE, getPNGFilterMask(filter));
+
 		compressOk = writeCompressedPNG(png, info, rowPointers, width, height,
 										hasAlpha ? PNG_COLOR_TYPE_RGBA : PNG_COLOR_TYPE_RGB);
 	}
@@ -815,6 +1314,178 @@ deBool qpTestLog_endImageSet (qpTestLog* log)
 	return DE_TRUE;
 }
 
+/* Attributes of <Image> element. */
+typedef struct ImageAttribs_s
+{
+	char			widthStr[32];
+	char			heightStr[32];
+	qpXmlAttribute	attribs[8];
+	int				numAttribs;
+} ImageAttribs;
+
+static void ImageAttribs_init (ImageAttribs* attribs, const char* name, const char* description, qpImageCompressionMode compressionMode, qpImageFormat imageFormat, int width, int height)
+{
+	int32ToString(width, attribs->widthStr);
+	int32ToString(height, attribs->heightStr);
+
+	attribs->numAttribs = 0;
+	attribs->attribs[attribs->numAttribs++] = qpSetStringAttrib("Name", name);
+	attribs->attribs[attribs->numAttribs++] = qpSetStringAttrib("Width", attribs->widthStr);
+	attribs->attribs[attribs->numAttribs++] = qpSetStringAttrib("Height", attribs->heightStr);
+	attribs->attribs[attribs->numAttribs++] = qpSetStringAttrib("Format", QP_LOOKUP_STRING(s_qpImageFormatMap, imageFormat));
+	attribs->attribs[attribs->numAttribs++] = qpSetStringAttrib("CompressionMode", QP_LOOKUP_STRING(s_qpImageCompressionModeMap, compressionMode));
+	if (description) attribs->attribs[attribs->numAttribs++] = qpSetStringAttrib("Description", description);
+}
+
+static void ImageAttribs_add (ImageAttribs* attribs, const char* name, const char* value)
+{
+	DE_ASSERT(attribs->numAttribs < DE_LENGTH_OF_ARRAY(attribs->attribs));
+	attribs->attribs[attribs->numAttribs++] = qpSetStringAttrib(name, value);
+}
+
+/* Hash image dimensions and pixel contents. Never returns 0. */
+static deUint64 hashImage (qpImageFormat imageFormat, int width, int height, int stride, const void* data)
+{
+	const deUint64	fnvPrime	= ((deUint64)0x00000100u << 32) | 0x000001b3u;
+	const deUint64	wordMul		= ((deUint64)0x9e3779b9u << 32) | 0x7f4a7c15u;
+	const int		rowSize		= (imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4) * width;
+	deUint64		hash		= ((deUint64)0xcbf29ce4u << 32) | 0x84222325u;
+	int				y;
+
+	hash = (hash ^ (deUint64)imageFormat) * fnvPrime;
+	hash = (hash ^ (deUint64)width) * fnvPrime;
+	hash = (hash ^ (deUint64)height) * fnvPrime;
+
+	for (y = 0; y < height; y++)
+	{
+		const deUint8*	row	= (const deUint8*)data + y*stride;
+		int				x	= 0;
+
+		/* Mix in 8 bytes at a time. */
+		for (; x + 8 <= rowSize; x += 8)
+		{
+			deUint64 word;
+			deMemcpy(&word, row + x, 8);
+			hash	= (hash ^ word) * wordMul;
+			hash	^= hash >> 29;
+		}
+
+		for (; x < rowSize; x++)
+			hash = (hash ^ row[x]) * fnvPrime;
+	}
+
+	return hash != 0 ? hash : 1;
+}
+
+static void hashToString (deUint64 hash, char buf[17])
+{
+	static const char	s_hexDigits[]	= "0123456789abcdef";
+	int					ndx;
+
+	for (ndx = 0; ndx < 16; ndx++)
+		buf[ndx] = s_hexDigits[(hash >> (60 - 4*ndx)) & 0xf];
+
+	buf[16] = 0;
+}
+
+/* Remember successfully written image so that later identical images can refer to it. */
+static void addLoggedImage (qpTestLog* log, deUint64 hash, qpImageFormat imageFormat, int width, int height, int stride, const void* data)
+{
+	deMutex_lock(log->lock);
+
+	/* Identical image may have been written concurrently. */
+	if (!LoggedImageSet_find(&log->loggedImages, hash) &&
+		!LoggedImageSet_insert(&log->loggedImages, hash, imageFormat, width, height, stride, data))
+		qpPrintf("WARNING: Failed to store logged image -- identical images will be logged again.\n");
+
+	deMutex_unlock(log->lock);
+}
+
+/* Write <Image> without data that refers to earlier image with same contents. */
+static deBool writeDuplicateImage (qpTestLog* log, ImageAttribs* attribs, const char* contentHash)
+{
+	ImageAttribs_add(attribs, "DuplicateOf", contentHash);
+
+	deMutex_lock(log->lock);
+
+	if (!qpXmlWriter_startElement(log->writer, "Image", attribs->numAttribs, attribs->attribs) ||
+		!qpXmlWriter_endElement(log->writer, "Image"))
+	{
+		qpPrintf("qpTestLog_writeImage(): Writing XML failed\n");
+		deMutex_unlock(log->lock);
+		return DE_FALSE;
+	}
+
+	deMutex_unlock(log->lock);
+	return DE_TRUE;
+}
+
+static deBool writeImageAsync (qpTestLog* log, const ImageAttribs* attribs, qpImageCompressionMode compressionMode, qpImageFormat imageFormat, int width, int height, int stride, const void* data)
+{
+	const int		pixelSize		= imageFormat == QP_IMAGE_FORMAT_RGB888 ? 3 : 4;
+	const int		packedStride	= pixelSize*width;
+	LogRecord*		record			= DE_NULL;
+	int				row;
+
+#if defined(QP_SUPPORT_PNG)
+	if (compressionMode != QP_IMAGE_COMPRESSION_MODE_NONE && compressionMode != QP_IMAGE_COMPRESSION_MODE_PNG)
+#else
+	if (compressionMode != QP_IMAGE_COMPRESSION_MODE_NONE)
+#endif
+	{
+		qpPrintf("qpTestLog_writeImage(): Unknown compression mode: %s\n", QP_LOOKUP_STRING(s_qpImageCompressionModeMap, compressionMode));
+		return DE_FALSE;
+	}
+
+	/* Copy pixels, caller may free data as soon as we return. */
+	record = LogRecord_create(LOG_RECORD_IMAGE);
+	if (!record || !Buffer_resize(&record->data, packedStride*height))
+	{
+		qpPrintf("ERROR: Failed to copy pixels for writing.\n");
+		if (record)
+			LogRecord_destroy(record);
+		return DE_FALSE;
+	}
+
+	for (row = 0; row < height; row++)
+		memcpy(&record->data.data[packedStride*row], &((const deUint8*)data)[row*stride], packedStride);
+
+	record->compressionMode	= compressionMode;
+	record->imageFormat		= imageFormat;
+	record->width			= width;
+	record->height			= height;
+
+	deMutex_lock(log->lock);
+
+	record->compressionLevel	= log->imageCompressionLevel;
+	record->filter				= log->imageFilter;
+
+	/* Start tag is written here and data by writer thread. Start tag must be closed before data. */
+	if (!qpXmlWriter_startElement(log->writer, "Image", attribs->numAttribs, attribs->attribs))
+	{
+		qpPrintf("qpTestLog_writeImage(): Writing XML failed\n");
+		deMutex_unlock(log->lock);
+		LogRecord_destroy(record);
+		return DE_FALSE;
+	}
+
+	qpXmlWriter_flush(log->writer);
+	submitPendingText(log);
+
+	record->elementDepth = qpXmlWriter_getElementDepth(log->writer);
+	enqueueRecord(log, record);
+
+	if (!qpXmlWriter_endElement(log->writer, "Image"))
+	{
+		qpPrintf("qpTestLog_writeImage(): Writing XML failed\n");
+		deMutex_unlock(log->lock);
+		return DE_FALSE;
+	}
+
+	deMutex_unlock(log->lock);
+	return DE_TRUE;
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief Write base64 encoded raw image data into log
  * \param log				qpTestLog instance
@@ -839,13 +1510,16 @@ deBool qpTestLog_writeImage	(
 	int						stride,
 	const void*				data)
 {
-	char			widthStr[32];
-	char			heightStr[32];
-	qpXmlAttribute	attribs[8];
-	int				numAttribs			= 0;
+	ImageAttribs	attribs;
 	Buffer			compressedBuffer;
 	const void*		writeDataPtr		= DE_NULL;
 	int				writeDataBytes		= -1;
+	deUint64		hash				= 0;
+	char			contentHash[17];
+	deBool			isDuplicate			= DE_FALSE;
+	deBool			addContentHash		= DE_FALSE;
+	int				compressionLevel;
+	qpImageFilter	filter;
 
 	DE_ASSERT(log && name);
 	DE_ASSERT(deInRange32(width, 1, 16384));
@@ -867,11 +1541,58 @@ deBool qpTestLog_writeImage	(
 #endif
 	}
 
+	/* Hash contents before taking lock, hashing large images is not free either. */
+	if (log->flags & QP_TEST_LOG_DEDUPLICATE_IMAGES)
+	{
+		hash = hashImage(imageFormat, width, height, stride, data);
+		hashToString(hash, contentHash);
+	}
+
+	deMutex_lock(log->lock);
+
+	compressionLevel	= log->imageCompressionLevel;
+	filter				= log->imageFilter;
+
+	if (log->flags & QP_TEST_LOG_DEDUPLICATE_IMAGES)
+	{
+		const LoggedImage* loggedImage = LoggedImageSet_find(&log->loggedImages, hash);
+
+		/* On hash collision image is logged in full without ContentHash. */
+		if (loggedImage)
+			isDuplicate = LoggedImage_equals(loggedImage, imageFormat, width, height, stride, data);
+		else
+			addContentHash = DE_TRUE;
+	}
+
+	deMutex_unlock(log->lock);
+
+	if (isDuplicate)
+	{
+		ImageAttribs_init(&attribs, name, description, compressionMode, imageFormat, width, height);
+		return writeDuplicateImage(log, &attribs, contentHash);
+	}
+
+	/* Compression and encoding is done in writer thread in async mode. */
+	if (isAsync(log))
+	{
+		ImageAttribs_init(&attribs, name, description, compressionMode, imageFormat, width, height);
+		if (addContentHash)
+			ImageAttribs_add(&attribs, "ContentHash", contentHash);
+
+		if (!writeImageAsync(log, &attribs, compressionMode, imageFormat, width, height, stride, data))
+			return DE_FALSE;
+
+		if (addContentHash)
+			addLoggedImage(log, hash, imageFormat, width, height, stride, data);
+
+		return DE_TRUE;
+	}
+
 #if defined(QP_SUPPORT_PNG)
 	/* Try storing with PNG compression. */
 	if (compressionMode == QP_IMAGE_COMPRESSION_MODE_PNG)
 	{
-		deBool compressOk = compressImagePNG(&compressedBuffer, imageFormat, width, height, stride, data);
+		deBool compressOk = compressImagePNG(&compressedBuffer, imageFormat, width, height, stride, data, compressionLevel, filter);
 		if (compressOk)
 		{
 			writeDataPtr	= compressedBuffer.data;
@@ -904,6 +1625,7 @@ deBool qpTestLog_writeImage	(
 					int row;
 					for (row = 0; row < height; row++)
 						memcpy(&compressedBuffer.data[packedStride*row], &((const deUint8*)data)[row*stride], pixelSize*width);
+					writeDataPtr = compressedBuffer.data;
 				}
 				else
 				{
@@ -930,20 +1652,15 @@ deBool qpTestLog_writeImage	(
 	}
 
 	/* Fill in attributes. */
-	int32ToString(width, widthStr);
-	int32ToString(height, heightStr);
-	attribs[numAttribs++] = qpSetStringAttrib("Name", name);
-	attribs[numAttribs++] = qpSetStringAttrib("Width", widthStr);
-	attribs[numAttribs++] = qpSetStringAttrib("Height", heightStr);
-	attribs[numAttribs++] = qpSetStringAttrib("Format", QP_LOOKUP_STRING(s_qpImageFormatMap, imageFormat));
-	attribs[numAttribs++] = qpSetStringAttrib("CompressionMode", QP_LOOKUP_STRING(s_qpImageCompressionModeMap, compressionMode));
-	if (description) attribs[numAttribs++] = qpSetStringAttrib("Description", description);
+	ImageAttribs_init(&attribs, name, description, compressionMode, imageFormat, width, height);
+	if (addContentHash)
+		ImageAttribs_add(&attribs, "ContentHash", contentHash);
 
 	/* \note Log lock is acquired after compression! */
 	deMutex_lock(log->lock);
 
 	/* <Image ID="result" Name="Foobar" Width="640" Height="480" Format="RGB888" CompressionMode="None">base64 data</Image> */
-	if (!qpXmlWriter_startElement(log->writer, "Image", numAttribs, attribs) ||
+	if (!qpXmlWriter_startElement(log->writer, "Image", attribs.numAttribs, attribs.attribs) ||
 		!qpXmlWriter_writeBase64(log->writer, (const deUint8*)writeDataPtr, writeDataBytes) ||
 		!qpXmlWriter_endElement(log->writer, "Image"))
 	{
@@ -955,6 +1672,9 @@ deBool qpTestLog_writeImage	(
 
 	deMutex_unlock(log->lock);
 
+	if (addContentHash)
+		addLoggedImage(log, hash, imageFormat, width, height, stride, data);
+
 	/* Free compressed data if allocated. */
 	Buffer_deinit(&compressedBuffer);
 
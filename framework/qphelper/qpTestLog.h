@@ -132,9 +132,36 @@ typedef enum qpImageFormat_e
 /* Test log flags. */
 typedef enum qpTestLogFlag_e
 {
-	QP_TEST_LOG_EXCLUDE_IMAGES	= (1<<0)		/*!< Do not log images. This reduces log size considerably.		*/
+	QP_TEST_LOG_EXCLUDE_IMAGES		= (1<<0),	/*!< Do not log images. This reduces log size considerably.		*/
+	QP_TEST_LOG_ASYNC				= (1<<1),	/*!< Compress and write log data in separate thread. Log is
+													 still flushed to file at test case boundaries.				*/
+	QP_TEST_LOG_DEDUPLICATE_IMAGES	= (1<<2)	/*!< Write data of identical images only once per test case.
+													 Repeated images refer to first one with DuplicateOf.		*/
 } qpTestLogFlag;
 
+/*--------------------------------------------------------------------*//*!
+ * \brief PNG row filter used for image compression
+ *
+ * Adaptive filtering (default) gives smallest images, a fixed filter
+ * is considerably faster to encode.
+ *//*--------------------------------------------------------------------*/
+typedef enum qpImageFilter_e
+{
+	QP_IMAGE_FILTER_DEFAULT = 0,	/*!< Encoder default (adaptive).	*/
+	QP_IMAGE_FILTER_NONE,
+	QP_IMAGE_FILTER_SUB,
+	QP_IMAGE_FILTER_UP,
+	QP_IMAGE_FILTER_AVERAGE,
+	QP_IMAGE_FILTER_PAETH,
+
+	QP_IMAGE_FILTER_LAST
+} qpImageFilter;
+
+enum
+{
+	QP_IMAGE_COMPRESSION_LEVEL_DEFAULT	= -1	/*!< Use zlib default compression level.	*/
+};
+
 /* Shader type. */
 typedef enum qpShaderType_e
 {
@@ -189,6 +216,8 @@ typedef struct qpEglConfigInfo_s
 qpTestLog*		qpTestLog_createFileLog			(const char* fileName, deUint32 flags);
 void			qpTestLog_destroy				(qpTestLog* log);
 
+void			qpTestLog_setImageEncoding		(qpTestLog* log, int compressionLevel, qpImageFilter filter);
+
 deBool			qpTestLog_startCase				(qpTestLog* log, const char* testCasePath, qpTestCaseType testCaseType);
 deBool			qpTestLog_endCase				(qpTestLog* log, qpTestResult result, const char* description);
 deBool			qpTestLog_terminateCase			(qpTestLog* log, qpTestResult result);
@@ -35,13 +35,50 @@
 
 struct qpXmlWriter_s
 {
-	FILE*				outputFile;
+	FILE*				outputFile;			/*!< Output file, or DE_NULL if writing to buffer.	*/
+
+	deUint8*			buffer;				/*!< Output buffer, used if outputFile is DE_NULL.	*/
+	int					bufferSize;
+	int					bufferCapacity;
 
 	deBool				xmlPrevIsStartElement;
 	deBool				xmlIsWriting;
 	int					xmlElementDepth;
 };
 
+static deBool writeBytes (qpXmlWriter* writer, const char* data, int numBytes)
+{
+	if (writer->outputFile)
+		return fwrite(data, 1, (size_t)numBytes, writer->outputFile) == (size_t)numBytes;
+
+	/* Grow buffer if necessary. */
+	if (writer->bufferSize + numBytes > writer->bufferCapacity)
+	{
+		int			newCapacity	= deAlign32(deMax32(2*writer->bufferCapacity, writer->bufferSize + numBytes), 512);
+		deUint8*	newBuffer	= (deUint8*)deMalloc(newCapacity);
+
+		if (!newBuffer)
+			return DE_FALSE;
+
+		if (writer->buffer)
+			memcpy(newBuffer, writer->buffer, writer->bufferSize);
+
+		deFree(writer->buffer);
+		writer->buffer			= newBuffer;
+		writer->bufferCapacity	= newCapacity;
+	}
+
+	memcpy(&writer->buffer[writer->bufferSize], data, numBytes);
+	writer->bufferSize += numBytes;
+
+	return DE_TRUE;
+}
+
+static deBool writeStr (qpXmlWriter* writer, const char* str)
+{
+	return writeBytes(writer, str, (int)strlen(str));
+}
+
 static deBool writeEscaped (qpXmlWriter* writer, const char* str)
 {
 	char		buf[256 + 10];
@@ -109,12 +146,14 @@ static deBool writeEscaped (qpXmlWriter* writer, const char* str)
 		if (isEOS || ((d - &buf[0]) >= 4))
 		{
 			*d = 0;
-			fprintf(writer->outputFile, "%s", buf);
+			writeStr(writer, buf);
 			d = &buf[0];
 		}
 	} while (!isEOS);
 
-	fflush(writer->outputFile);
+	if (writer->outputFile)
+		fflush(writer->outputFile);
+
 	DE_ASSERT(d == &buf[0]); /* buffer must be empty */
 	return DE_TRUE;
 }
@@ -132,18 +171,49 @@ qpXmlWriter* qpXmlWriter_createFileWriter (FILE* outputFile, deBool useCompressi
 	return writer;
 }
 
+qpXmlWriter* qpXmlWriter_createBufferWriter (void)
+{
+	/* \note outputFile and buffer are left null, buffer is allocated on first write. */
+	return (qpXmlWriter*)deCalloc(sizeof(qpXmlWriter));
+}
+
 void qpXmlWriter_destroy (qpXmlWriter* writer)
 {
 	DE_ASSERT(writer);
 
+	deFree(writer->buffer);
 	deFree(writer);
 }
 
+const deUint8* qpXmlWriter_getBufferData (const qpXmlWriter* writer)
+{
+	DE_ASSERT(writer && !writer->outputFile);
+	return writer->buffer;
+}
+
+int qpXmlWriter_getBufferSize (const qpXmlWriter* writer)
+{
+	DE_ASSERT(writer && !writer->outputFile);
+	return writer->bufferSize;
+}
+
+void qpXmlWriter_clearBuffer (qpXmlWriter* writer)
+{
+	DE_ASSERT(writer && !writer->outputFile);
+	writer->bufferSize = 0;
+}
+
+int qpXmlWriter_getElementDepth (const qpXmlWriter* writer)
+{
+	DE_ASSERT(writer);
+	return writer->xmlElementDepth;
+}
+
 static deBool closePending (qpXmlWriter* writer)
 {
 	if (writer->xmlPrevIsStartElement)
 	{
-		fprintf(writer->outputFile, ">\n");
+		writeStr(writer, ">\n");
 		writer->xmlPrevIsStartElement = DE_FALSE;
 	}
 
@@ -161,7 +231,7 @@ deBool qpXmlWriter_startDocument (qpXmlWriter* writer)
 	writer->xmlIsWriting			= DE_TRUE;
 	writer->xmlElementDepth			= 0;
 	writer->xmlPrevIsStartElement	= DE_FALSE;
-	fprintf(writer->outputFile, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+	writeStr(writer, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
 	return DE_TRUE;
 }
 
@@ -186,7 +256,7 @@ deBool qpXmlWriter_writeString (qpXmlWriter* writer, const char* str)
 {
 	if (writer->xmlPrevIsStartElement)
 	{
-		fprintf(writer->outputFile, ">");
+		writeStr(writer, ">");
 		writer->xmlPrevIsStartElement = DE_FALSE;
 	}
 
@@ -199,12 +269,16 @@ deBool qpXmlWriter_startElement(qpXmlWriter* writer, const char* elementName, in
 
 	closePending(writer);
 
-	fprintf(writer->outputFile, "%s<%s", getIndentStr(writer->xmlElementDepth), elementName);
+	writeStr(writer, getIndentStr(writer->xmlElementDepth));
+	writeStr(writer, "<");
+	writeStr(writer, elementName);
 
 	for (ndx = 0; ndx < numAttribs; ndx++)
 	{
 		const qpXmlAttribute* attrib = &attribs[ndx];
-		fprintf(writer->outputFile, " %s=\"", attrib->name);
+		writeStr(writer, " ");
+		writeStr(writer, attrib->name);
+		writeStr(writer, "=\"");
 		switch (attrib->type)
 		{
 			case QP_XML_ATTRIBUTE_STRING:
@@ -226,7 +300,7 @@ deBool qpXmlWriter_startElement(qpXmlWriter* writer, const char* elementName, in
 			default:
 				DE_ASSERT(DE_FALSE);
 		}
-		fprintf(writer->outputFile, "\"");
+		writeStr(writer, "\"");
 	}
 
 	writer->xmlElementDepth++;
@@ -241,16 +315,20 @@ deBool qpXmlWriter_endElement (qpXmlWriter* writer, const char* elementName)
 
 	if (writer->xmlPrevIsStartElement) /* leave flag as-is */
 	{
-		fprintf(writer->outputFile, " />\n");
+		writeStr(writer, " />\n");
 		writer->xmlPrevIsStartElement = DE_FALSE;
 	}
 	else
-		fprintf(writer->outputFile, "</%s>\n", /*getIndentStr(writer->xmlElementDepth),*/ elementName);
+	{
+		writeStr(writer, "</");
+		writeStr(writer, /*getIndentStr(writer->xmlElementDepth),*/ elementName);
+		writeStr(writer, ">\n");
+	}
 
 	return DE_TRUE;
 }
 
-deBool qpXmlWriter_writeBase64 (qpXmlWriter* writer, const deUint8* data, int numBytes)
+deBool qpXmlWriter_writeBase64AtDepth (qpXmlWriter* writer, int elementDepth, const deUint8* data, int numBytes)
 {
 	static const char s_base64Table[64] =
 	{
@@ -261,62 +339,80 @@ deBool qpXmlWriter_writeBase64 (qpXmlWriter* writer, const deUint8* data, int nu
 		'0','1','2','3','4','5','6','7','8','9','+','/'
 	};
 
-	int			numWritten	= 0;
+	enum
+	{
+		BYTES_PER_LINE		= 48,		/*!< 64 characters per line. */
+		MAX_LINE_LENGTH		= 32 + 64 + 1,
+		CHUNK_SIZE			= 4096
+	};
+
+	const char*	indentStr	= getIndentStr(elementDepth);
+	const int	indentLen	= (int)strlen(indentStr);
+	char		chunk[CHUNK_SIZE];
+	int			chunkSize	= 0;
 	int			srcNdx		= 0;
-	deBool		writeIndent	= DE_TRUE;
-	const char*	indentStr	= getIndentStr(writer->xmlElementDepth);
 
 	DE_ASSERT(writer && data && (numBytes > 0));
 
-	/* Close and pending writes. */
-	closePending(writer);
-
-	/* Loop all input chars. */
+	/* Encode full lines into chunk and write chunk at a time. */
 	while (srcNdx < numBytes)
 	{
-		int		numRead = deMin32(3, numBytes - srcNdx);
-		deUint8	s0 = data[srcNdx];
-		deUint8	s1 = (numRead >= 2) ? data[srcNdx+1] : 0;
-		deUint8	s2 = (numRead >= 3) ? data[srcNdx+2] : 0;
-		char	d[5];
-
-		srcNdx += numRead;
+		const int		numLineBytes	= deMin32(BYTES_PER_LINE, numBytes - srcNdx);
+		const int		numTailBytes	= numLineBytes % 3;
+		const deUint8*	src				= &data[srcNdx];
+		const deUint8*	srcEnd			= src + (numLineBytes - numTailBytes);
+		char*			dst;
 
-		d[0] = s_base64Table[s0 >> 2];
-		d[1] = s_base64Table[((s0&0x3)<<4) | (s1>>4)];
-		d[2] = s_base64Table[((s1&0xF)<<2) | (s2>>6)];
-		d[3] = s_base64Table[s2&0x3F];
-		d[4] = 0;
+		if (chunkSize + MAX_LINE_LENGTH > CHUNK_SIZE)
+		{
+			if (!writeBytes(writer, chunk, chunkSize))
+				return DE_FALSE;
+			chunkSize = 0;
+		}
 
-		if (numRead < 3) d[3] = '=';
-		if (numRead < 2) d[2] = '=';
+		memcpy(&chunk[chunkSize], indentStr, indentLen);
+		dst = &chunk[chunkSize + indentLen];
 
-		/* Write indent (if needed). */
-		if (writeIndent)
+		for (; src != srcEnd; src += 3, dst += 4)
 		{
-			fprintf(writer->outputFile, "%s", indentStr);
-			writeIndent = DE_FALSE;
-		}
+			const deUint32 bits = ((deUint32)src[0] << 16) | ((deUint32)src[1] << 8) | (deUint32)src[2];
 
-		/* Write data. */
-		fprintf(writer->outputFile, "%s", &d[0]);
+			dst[0] = s_base64Table[bits >> 18];
+			dst[1] = s_base64Table[(bits >> 12) & 0x3F];
+			dst[2] = s_base64Table[(bits >> 6) & 0x3F];
+			dst[3] = s_base64Table[bits & 0x3F];
+		}
 
-		/* EOL every now and then. */
-		numWritten += 4;
-		if (numWritten >= 64)
+		/* Partial group at the end of data. */
+		if (numTailBytes > 0)
 		{
-			fprintf(writer->outputFile, "\n");
-			numWritten = 0;
-			writeIndent = DE_TRUE;
+			const deUint8 s0 = src[0];
+			const deUint8 s1 = (numTailBytes == 2) ? src[1] : 0;
+
+			dst[0] = s_base64Table[s0 >> 2];
+			dst[1] = s_base64Table[((s0&0x3)<<4) | (s1>>4)];
+			dst[2] = (numTailBytes == 2) ? s_base64Table[(s1&0xF)<<2] : '=';
+			dst[3] = '=';
+			dst += 4;
 		}
+
+		*dst++ = '\n';
+
+		chunkSize	= (int)(dst - &chunk[0]);
+		srcNdx		+= numLineBytes;
 	}
 
-	/* Last EOL. */
-	if (numWritten > 0)
-		fprintf(writer->outputFile, "\n");
+	return writeBytes(writer, chunk, chunkSize);
+}
 
-	DE_ASSERT(srcNdx == numBytes);
-	return DE_TRUE;
+deBool qpXmlWriter_writeBase64 (qpXmlWriter* writer, const deUint8* data, int numBytes)
+{
+	DE_ASSERT(writer && data && (numBytes > 0));
+
+	/* Close and pending writes. */
+	closePending(writer);
+
+	return qpXmlWriter_writeBase64AtDepth(writer, writer->xmlElementDepth, data, numBytes);
 }
 
 /* Common helper functions. */
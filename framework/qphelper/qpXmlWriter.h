@@ -89,6 +89,42 @@ DE_INLINE qpXmlAttribute qpSetBoolAttrib (const char* name, deBool value)
  *//*--------------------------------------------------------------------*/
 qpXmlWriter*	qpXmlWriter_createFileWriter (FILE* outFile, deBool useCompression);
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Create a memory buffer based XML Writer instance
+ *
+ * Output is accumulated into a buffer that can be accessed with
+ * qpXmlWriter_getBufferData() and qpXmlWriter_getBufferSize().
+ * \return qpXmlWriter instance, or DE_NULL if out of memory
+ *//*--------------------------------------------------------------------*/
+qpXmlWriter*	qpXmlWriter_createBufferWriter (void);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get data written so far to buffer based writer
+ * \param writer qpXmlWriter instance
+ * \return Pointer to data, or DE_NULL if nothing has been written
+ *//*--------------------------------------------------------------------*/
+const deUint8*	qpXmlWriter_getBufferData (const qpXmlWriter* writer);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get number of bytes written so far to buffer based writer
+ * \param writer qpXmlWriter instance
+ * \return Number of bytes in buffer
+ *//*--------------------------------------------------------------------*/
+int				qpXmlWriter_getBufferSize (const qpXmlWriter* writer);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Discard data written to buffer based writer
+ * \param writer qpXmlWriter instance
+ *//*--------------------------------------------------------------------*/
+void			qpXmlWriter_clearBuffer (qpXmlWriter* writer);
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get number of currently open elements
+ * \param writer qpXmlWriter instance
+ * \return Element depth
+ *//*--------------------------------------------------------------------*/
+int				qpXmlWriter_getElementDepth (const qpXmlWriter* writer);
+
 /*--------------------------------------------------------------------*//*!
  * \brief XML Writer instance
  * \param a	qpXmlWriter instance
@@ -148,6 +184,20 @@ deBool			qpXmlWriter_writeString (qpXmlWriter* writer, const char* content);
  *//*--------------------------------------------------------------------*/
 deBool			qpXmlWriter_writeBase64 (qpXmlWriter* writer, const deUint8* data, int numBytes);
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Write base64 encoded data indented for given element depth
+ *
+ * Element state of the writer is not used or modified. This can be used
+ * for writing contents of an element that was started with another
+ * writer instance.
+ * \param writer		qpXmlWriter instance
+ * \param elementDepth	Element depth used for indentation
+ * \param data			Pointer to data to be written
+ * \param numBytes		Length of data in bytes
+ * \return true on success, false on error
+ *//*--------------------------------------------------------------------*/
+deBool			qpXmlWriter_writeBase64AtDepth (qpXmlWriter* writer, int elementDepth, const deUint8* data, int numBytes);
+
 /*--------------------------------------------------------------------*//*!
  * \brief Convenience function for writing XML element
  * \param writer qpXmlWriter instance
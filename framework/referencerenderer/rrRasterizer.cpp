@@ -411,6 +411,7 @@ bool doesLineSegmentExitDiamond (const SubpixelLineSegment& line, const tcu::Vec
 
 TriangleRasterizer::TriangleRasterizer (const tcu::IVec4& viewport, const int numSamples, const RasterizationState& state)
 	: m_viewport		(viewport)
+	, m_region			(viewport)
 	, m_numSamples		(numSamples)
 	, m_winding			(state.winding)
 	, m_horizontalFill	(state.horizontalFill)
@@ -419,6 +420,19 @@ TriangleRasterizer::TriangleRasterizer (const tcu::IVec4& viewport, const int nu
 {
 }
 
+TriangleRasterizer::TriangleRasterizer (const tcu::IVec4& viewport, const tcu::IVec4& region, const int numSamples, const RasterizationState& state)
+	: m_viewport		(viewport)
+	, m_region			(region)
+	, m_numSamples		(numSamples)
+	, m_winding			(state.winding)
+	, m_horizontalFill	(state.horizontalFill)
+	, m_verticalFill	(state.verticalFill)
+	, m_face			(FACETYPE_LAST)
+{
+	DE_ASSERT(region.x() >= viewport.x() && region.x() + region.z() <= viewport.x() + viewport.z());
+	DE_ASSERT(region.y() >= viewport.y() && region.y() + region.w() <= viewport.y() + viewport.w());
+}
+
 /*--------------------------------------------------------------------*//*!
  * \brief Initialize triangle rasterization
  * \param v0 Screen-space coordinates (x, y, z) and 1/w for vertex 0.
@@ -489,14 +503,54 @@ void TriangleRasterizer::init (const tcu::Vec4& v0, const tcu::Vec4& v1, const t
 	m_bboxMax.x() = de::clamp(m_bboxMax.x(), wX0, wX1);
 	m_bboxMax.y() = de::clamp(m_bboxMax.y(), wY0, wY1);
 
+	// Limit to region. Packets must stay aligned to the viewport-clamped bounding box.
+	{
+		const int	rX0		= m_region.x();
+		const int	rY0		= m_region.y();
+		const int	rX1		= rX0 + m_region.z() - 1;
+		const int	rY1		= rY0 + m_region.w() - 1;
+
+		if (m_bboxMin.x() < rX0)
+			m_bboxMin.x() += (rX0 - m_bboxMin.x()) & ~1;
+		if (m_bboxMin.y() < rY0)
+			m_bboxMin.y() += (rY0 - m_bboxMin.y()) & ~1;
+
+		m_bboxMax.x() = de::min(m_bboxMax.x(), rX1);
+		m_bboxMax.y() = de::min(m_bboxMax.y(), rY1);
+	}
+
 	m_curPos = m_bboxMin;
+
+	initSampleOffsets();
+
+	// Triangle does not touch the region
+	if (m_bboxMin.x() > m_bboxMax.x())
+		m_curPos.y() = m_bboxMax.y() + 1;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get coverage mask of fragments of packet at (x0, y0) that are within region
+ *//*--------------------------------------------------------------------*/
+deUint64 TriangleRasterizer::getRegionCoverageMask (int x0, int y0) const
+{
+	const bool	inX0	= x0	>= m_region.x();
+	const bool	inX1	= x0+1	<  m_region.x() + m_region.z();
+	const bool	inY0	= y0	>= m_region.y();
+	const bool	inY1	= y0+1	<  m_region.y() + m_region.w();
+	deUint64	mask	= 0;
+
+	if (inX0 && inY0)	mask |= getCoverageFragmentSampleBits(m_numSamples, 0, 0);
+	if (inX1 && inY0)	mask |= getCoverageFragmentSampleBits(m_numSamples, 1, 0);
+	if (inX0 && inY1)	mask |= getCoverageFragmentSampleBits(m_numSamples, 0, 1);
+	if (inX1 && inY1)	mask |= getCoverageFragmentSampleBits(m_numSamples, 1, 1);
+
+	return mask;
 }
 
 void TriangleRasterizer::rasterizeSingleSample (FragmentPacket* const fragmentPackets, float* const depthValues, const int maxFragmentPackets, int& numPacketsRasterized)
 {
 	DE_ASSERT(maxFragmentPackets > 0);
 
-	const deUint64	halfPixel	= 1ll << (RASTERIZER_SUBPIXEL_BITS-1);
 	int				packetNdx	= 0;
 
 	while (m_curPos.y() <= m_bboxMax.y() && packetNdx < maxFragmentPackets)
@@ -504,43 +558,16 @@ void TriangleRasterizer::rasterizeSingleSample (FragmentPacket* const fragmentPa
 		const int		x0		= m_curPos.x();
 		const int		y0		= m_curPos.y();
 
-		// Subpixel coords
-		const deInt64	sx0		= toSubpixelCoord(x0)	+ halfPixel;
-		const deInt64	sx1		= toSubpixelCoord(x0+1)	+ halfPixel;
-		const deInt64	sy0		= toSubpixelCoord(y0)	+ halfPixel;
-		const deInt64	sy1		= toSubpixelCoord(y0+1)	+ halfPixel;
-
-		const deInt64	sx[4]	= { sx0, sx1, sx0, sx1 };
-		const deInt64	sy[4]	= { sy0, sy0, sy1, sy1 };
-
-		// Viewport test
-		const bool		outX1	= x0+1 == m_viewport.x()+m_viewport.z();
-		const bool		outY1	= y0+1 == m_viewport.y()+m_viewport.w();
-
 		DE_ASSERT(x0 < m_viewport.x()+m_viewport.z());
 		DE_ASSERT(y0 < m_viewport.y()+m_viewport.w());
 
-		// Edge values
-		tcu::Vector<deInt64, 4>	e01;
-		tcu::Vector<deInt64, 4>	e12;
-		tcu::Vector<deInt64, 4>	e20;
-
-		// Coverage
-		deUint64		coverage	= 0;
+		// Edge values at fragment centers, in coverage bit order
+		deInt64			e01[4];
+		deInt64			e12[4];
+		deInt64			e20[4];
 
-		// Evaluate edge values
-		for (int i = 0; i < 4; i++)
-		{
-			e01[i] = evaluateEdge(m_edge01, sx[i], sy[i]);
-			e12[i] = evaluateEdge(m_edge12, sx[i], sy[i]);
-			e20[i] = evaluateEdge(m_edge20, sx[i], sy[i]);
-		}
-
-		// Compute coverage mask
-		coverage = setCoverageValue(coverage, 1, 0, 0, 0,						isInsideCCW(m_edge01, e01[0]) && isInsideCCW(m_edge12, e12[0]) && isInsideCCW(m_edge20, e20[0]));
-		coverage = setCoverageValue(coverage, 1, 1, 0, 0, !outX1 &&				isInsideCCW(m_edge01, e01[1]) && isInsideCCW(m_edge12, e12[1]) && isInsideCCW(m_edge20, e20[1]));
-		coverage = setCoverageValue(coverage, 1, 0, 1, 0, !outY1 &&				isInsideCCW(m_edge01, e01[2]) && isInsideCCW(m_edge12, e12[2]) && isInsideCCW(m_edge20, e20[2]));
-		coverage = setCoverageValue(coverage, 1, 1, 1, 0, !outX1 && !outY1 &&	isInsideCCW(m_edge01, e01[3]) && isInsideCCW(m_edge12, e12[3]) && isInsideCCW(m_edge20, e20[3]));
+		// Coverage. Region is within viewport, so region test also removes fragments outside viewport.
+		const deUint64	coverage	= evaluateCoverage<1>(x0, y0, e01, e12, e20) & getRegionCoverageMask(x0, y0);
 
 		// Advance to next location
 		m_curPos.x() += 2;
@@ -554,9 +581,9 @@ void TriangleRasterizer::rasterizeSingleSample (FragmentPacket* const fragmentPa
 			continue; // Discard.
 
 		// Floating-point edge values for barycentrics etc.
-		const tcu::Vec4		e01f	= e01.asFloat();
-		const tcu::Vec4		e12f	= e12.asFloat();
-		const tcu::Vec4		e20f	= e20.asFloat();
+		const tcu::Vec4		e01f	((float)e01[0], (float)e01[2], (float)e01[1], (float)e01[3]);
+		const tcu::Vec4		e12f	((float)e12[0], (float)e12[2], (float)e12[1], (float)e12[3]);
+		const tcu::Vec4		e20f	((float)e20[0], (float)e20[2], (float)e20[1], (float)e20[3]);
 
 		// Compute depth values.
 		if (depthValues)
@@ -656,25 +683,91 @@ DE_STATIC_ASSERT(DE_LENGTH_OF_ARRAY(s_samplePos16) == 16*2);
 #undef SAMPLE_POS
 #undef SAMPLE_POS_TO_SUBPIXEL_COORD
 
-template<int NumSamples>
-void TriangleRasterizer::rasterizeMultiSample (FragmentPacket* const fragmentPackets, float* const depthValues, const int maxFragmentPackets, int& numPacketsRasterized)
+/*--------------------------------------------------------------------*//*!
+ * \brief Compute edge value offsets for sample positions of a packet
+ *
+ * Edge functions are linear, so edge value at any sample position of
+ * a packet can be computed exactly by adding a per-sample offset to the
+ * value at packet origin (x0, y0).
+ *//*--------------------------------------------------------------------*/
+void TriangleRasterizer::initSampleOffsets (void)
 {
-	DE_ASSERT(maxFragmentPackets > 0);
-
-	const deInt64*	samplePos	= DE_NULL;
-	const deUint64	halfPixel	= 1ll << (RASTERIZER_SUBPIXEL_BITS-1);
-	int				packetNdx	= 0;
+	const deInt64	halfPixel		= 1ll << (RASTERIZER_SUBPIXEL_BITS-1);
+	const deInt64	centerPos[]		= { halfPixel, halfPixel };
+	const deInt64*	samplePos		= DE_NULL;
 
-	switch (NumSamples)
+	switch (m_numSamples)
 	{
+		case 1:		samplePos = centerPos;		break;
 		case 2:		samplePos = s_samplePos2;	break;
 		case 4:		samplePos = s_samplePos4;	break;
 		case 8:		samplePos = s_samplePos8;	break;
 		case 16:	samplePos = s_samplePos16;	break;
 		default:
 			DE_ASSERT(false);
+			return;
 	}
 
+	for (int fragX = 0; fragX < 2; fragX++)
+	for (int fragY = 0; fragY < 2; fragY++)
+	for (int sampleNdx = 0; sampleNdx < m_numSamples; sampleNdx++)
+	{
+		const int		laneNdx	= getCoverageOffset(m_numSamples, fragX, fragY) + sampleNdx;
+		const deInt64	ox		= toSubpixelCoord(fragX) + samplePos[sampleNdx*2 + 0];
+		const deInt64	oy		= toSubpixelCoord(fragY) + samplePos[sampleNdx*2 + 1];
+
+		m_sampleOffsets[0][laneNdx] = m_edge01.a*ox + m_edge01.b*oy;
+		m_sampleOffsets[1][laneNdx] = m_edge12.a*ox + m_edge12.b*oy;
+		m_sampleOffsets[2][laneNdx] = m_edge20.a*ox + m_edge20.b*oy;
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Evaluate edges and coverage for all samples of packet at (x0, y0)
+ *
+ * Edge values are written in coverage bit order. Loop is kept flat and
+ * branchless so that all samples of the packet can be evaluated with
+ * vector instructions when available. Result is identical to evaluating
+ * each sample with evaluateEdge() and isInsideCCW().
+ *//*--------------------------------------------------------------------*/
+template<int NumSamples>
+inline deUint64 TriangleRasterizer::evaluateCoverage (int x0, int y0, deInt64* e01, deInt64* e12, deInt64* e20) const
+{
+	const deInt64	sx0		= toSubpixelCoord(x0);
+	const deInt64	sy0		= toSubpixelCoord(y0);
+	const deInt64	base01	= evaluateEdge(m_edge01, sx0, sy0);
+	const deInt64	base12	= evaluateEdge(m_edge12, sx0, sy0);
+	const deInt64	base20	= evaluateEdge(m_edge20, sx0, sy0);
+
+	// Inclusive edges accept zero
+	const deInt64	min01	= m_edge01.inclusive ? 0 : 1;
+	const deInt64	min12	= m_edge12.inclusive ? 0 : 1;
+	const deInt64	min20	= m_edge20.inclusive ? 0 : 1;
+
+	deUint64		coverage	= 0;
+
+	DE_ASSERT(NumSamples == m_numSamples);
+
+	for (int laneNdx = 0; laneNdx < 4*NumSamples; laneNdx++)
+	{
+		e01[laneNdx] = base01 + m_sampleOffsets[0][laneNdx];
+		e12[laneNdx] = base12 + m_sampleOffsets[1][laneNdx];
+		e20[laneNdx] = base20 + m_sampleOffsets[2][laneNdx];
+
+		coverage |= (deUint64)((e01[laneNdx] >= min01) & (e12[laneNdx] >= min12) & (e20[laneNdx] >= min20)) << laneNdx;
+	}
+
+	return coverage;
+}
+
+template<int NumSamples>
+void TriangleRasterizer::rasterizeMultiSample (FragmentPacket* const fragmentPackets, float* const depthValues, const int maxFragmentPackets, int& numPacketsRasterized)
+{
+	DE_ASSERT(maxFragmentPackets > 0);
+
+	const deUint64	halfPixel	= 1ll << (RASTERIZER_SUBPIXEL_BITS-1);
+	int				packetNdx	= 0;
+
 	while (m_curPos.y() <= m_bboxMax.y() && packetNdx < maxFragmentPackets)
 	{
 		const int		x0		= m_curPos.x();
@@ -689,43 +782,16 @@ void TriangleRasterizer::rasterizeMultiSample (FragmentPacket* const fragmentPac
 		const deInt64	sx[4]	= { sx0, sx1, sx0, sx1 };
 		const deInt64	sy[4]	= { sy0, sy0, sy1, sy1 };
 
-		// Viewport test
-		const bool		outX1	= x0+1 == m_viewport.x()+m_viewport.z();
-		const bool		outY1	= y0+1 == m_viewport.y()+m_viewport.w();
-
 		DE_ASSERT(x0 < m_viewport.x()+m_viewport.z());
 		DE_ASSERT(y0 < m_viewport.y()+m_viewport.w());
 
-		// Edge values
-		tcu::Vector<deInt64, 4>	e01[NumSamples];
-		tcu::Vector<deInt64, 4>	e12[NumSamples];
-		tcu::Vector<deInt64, 4>	e20[NumSamples];
-
-		// Coverage
-		deUint64		coverage	= 0;
-
-		// Evaluate edge values at sample positions
-		for (int sampleNdx = 0; sampleNdx < NumSamples; sampleNdx++)
-		{
-			const deInt64 ox = samplePos[sampleNdx*2 + 0];
-			const deInt64 oy = samplePos[sampleNdx*2 + 1];
-
-			for (int fragNdx = 0; fragNdx < 4; fragNdx++)
-			{
-				e01[sampleNdx][fragNdx] = evaluateEdge(m_edge01, sx[fragNdx] + ox, sy[fragNdx] + oy);
-				e12[sampleNdx][fragNdx] = evaluateEdge(m_edge12, sx[fragNdx] + ox, sy[fragNdx] + oy);
-				e20[sampleNdx][fragNdx] = evaluateEdge(m_edge20, sx[fragNdx] + ox, sy[fragNdx] + oy);
-			}
-		}
+		// Edge values at sample positions, in coverage bit order
+		deInt64			e01[4*NumSamples];
+		deInt64			e12[4*NumSamples];
+		deInt64			e20[4*NumSamples];
 
-		// Compute coverage mask
-		for (int sampleNdx = 0; sampleNdx < NumSamples; sampleNdx++)
-		{
-			coverage = setCoverageValue(coverage, NumSamples, 0, 0, sampleNdx,						isInsideCCW(m_edge01, e01[sampleNdx][0]) && isInsideCCW(m_edge12, e12[sampleNdx][0]) && isInsideCCW(m_edge20, e20[sampleNdx][0]));
-			coverage = setCoverageValue(coverage, NumSamples, 1, 0, sampleNdx, !outX1 &&			isInsideCCW(m_edge01, e01[sampleNdx][1]) && isInsideCCW(m_edge12, e12[sampleNdx][1]) && isInsideCCW(m_edge20, e20[sampleNdx][1]));
-			coverage = setCoverageValue(coverage, NumSamples, 0, 1, sampleNdx, !outY1 &&			isInsideCCW(m_edge01, e01[sampleNdx][2]) && isInsideCCW(m_edge12, e12[sampleNdx][2]) && isInsideCCW(m_edge20, e20[sampleNdx][2]));
-			coverage = setCoverageValue(coverage, NumSamples, 1, 1, sampleNdx, !outX1 && !outY1 &&	isInsideCCW(m_edge01, e01[sampleNdx][3]) && isInsideCCW(m_edge12, e12[sampleNdx][3]) && isInsideCCW(m_edge20, e20[sampleNdx][3]));
-		}
+		// Coverage. Region is within viewport, so region test also removes fragments outside viewport.
+		const deUint64	coverage	= evaluateCoverage<NumSamples>(x0, y0, e01, e12, e20) & getRegionCoverageMask(x0, y0);
 
 		// Advance to next location
 		m_curPos.x() += 2;
@@ -744,9 +810,13 @@ void TriangleRasterizer::rasterizeMultiSample (FragmentPacket* const fragmentPac
 			for (int sampleNdx = 0; sampleNdx < NumSamples; sampleNdx++)
 			{
 				// Floating-point edge values at sample coordinates.
-				const tcu::Vec4&	e01f	= e01[sampleNdx].asFloat();
-				const tcu::Vec4&	e12f	= e12[sampleNdx].asFloat();
-				const tcu::Vec4&	e20f	= e20[sampleNdx].asFloat();
+				const int			l00		= getCoverageOffset(NumSamples, 0, 0) + sampleNdx;
+				const int			l10		= getCoverageOffset(NumSamples, 1, 0) + sampleNdx;
+				const int			l01		= getCoverageOffset(NumSamples, 0, 1) + sampleNdx;
+				const int			l11		= getCoverageOffset(NumSamples, 1, 1) + sampleNdx;
+				const tcu::Vec4		e01f	((float)e01[l00], (float)e01[l10], (float)e01[l01], (float)e01[l11]);
+				const tcu::Vec4		e12f	((float)e12[l00], (float)e12[l10], (float)e12[l01], (float)e12[l11]);
+				const tcu::Vec4		e20f	((float)e20[l00], (float)e20[l10], (float)e20[l01], (float)e20[l11]);
 
 				const tcu::Vec4		ooSum	= 1.0f / (e01f + e12f + e20f);
 				const tcu::Vec4		z0		= e12f * ooSum;
@@ -977,6 +1047,13 @@ MultiSampleLineRasterizer::MultiSampleLineRasterizer (const int numSamples, cons
 {
 }
 
+MultiSampleLineRasterizer::MultiSampleLineRasterizer (const int numSamples, const tcu::IVec4& viewport, const tcu::IVec4& region)
+	: m_numSamples			(numSamples)
+	, m_triangleRasterizer0 (viewport, region, m_numSamples, RasterizationState())
+	, m_triangleRasterizer1 (viewport, region, m_numSamples, RasterizationState())
+{
+}
+
 MultiSampleLineRasterizer::~MultiSampleLineRasterizer ()
 {
 }
@@ -123,11 +123,18 @@ struct EdgeFunction
  *  - Culling - logic can be implemented outside by querying visible face
  *  - Scissoring (this can be done by controlling viewport rectangle)
  *  - Any per-fragment operations
+ *
+ * Rasterization can be limited to a sub-rectangle (region) of the viewport.
+ * 2x2 fragment packets are still aligned as if the whole viewport was
+ * rasterized, and fragments outside the region are removed from coverage,
+ * so that rasterizing a set of disjoint regions covering the viewport
+ * produces exactly the same fragments as rasterizing the viewport at once.
  *//*--------------------------------------------------------------------*/
 class TriangleRasterizer
 {
 public:
 							TriangleRasterizer		(const tcu::IVec4& viewport, const int numSamples, const RasterizationState& state);
+							TriangleRasterizer		(const tcu::IVec4& viewport, const tcu::IVec4& region, const int numSamples, const RasterizationState& state);
 
 	void					init					(const tcu::Vec4& v0, const tcu::Vec4& v1, const tcu::Vec4& v2);
 
@@ -141,8 +148,15 @@ private:
 	template<int NumSamples>
 	void					rasterizeMultiSample	(FragmentPacket* const fragmentPackets, float* const depthValues, const int maxFragmentPackets, int& numPacketsRasterized);
 
+	template<int NumSamples>
+	deUint64				evaluateCoverage		(int x0, int y0, deInt64* e01, deInt64* e12, deInt64* e20) const;
+
+	void					initSampleOffsets		(void);
+	deUint64				getRegionCoverageMask	(int x0, int y0) const;
+
 	// Constant rasterization state.
 	const tcu::IVec4		m_viewport;
+	const tcu::IVec4		m_region;		//!< Rasterized area, must be contained in viewport.
 	const int				m_numSamples;
 	const Winding			m_winding;
 	const HorizontalFill	m_horizontalFill;
@@ -155,6 +169,7 @@ private:
 	EdgeFunction			m_edge01;
 	EdgeFunction			m_edge12;
 	EdgeFunction			m_edge20;
+	deInt64					m_sampleOffsets[3][4*RASTERIZER_MAX_SAMPLES_PER_FRAGMENT];	//!< Edge value offsets from packet origin for each coverage bit.
 	FaceType				m_face;			//!< Triangle orientation, eg. visible face.
 	tcu::IVec2				m_bboxMin;		//!< Bounding box min (inclusive).
 	tcu::IVec2				m_bboxMax;		//!< Bounding box max (inclusive).
@@ -218,6 +233,7 @@ class MultiSampleLineRasterizer
 {
 public:
 								MultiSampleLineRasterizer	(const int numSamples, const tcu::IVec4& viewport);
+								MultiSampleLineRasterizer	(const int numSamples, const tcu::IVec4& viewport, const tcu::IVec4& region);
 								~MultiSampleLineRasterizer	();
 
 	void						init						(const tcu::Vec4& v0, const tcu::Vec4& v1, float lineWidth);
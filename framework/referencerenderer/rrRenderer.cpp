@@ -28,9 +28,10 @@
 #include "rrPrimitiveAssembler.hpp"
 #include "rrFragmentOperations.hpp"
 #include "rrRasterizer.hpp"
+#include "tcuWorkerPool.hpp"
 #include "deMemory.h"
 
-#include <set>
+#include <algorithm>
 
 namespace rr
 {
@@ -41,12 +42,24 @@ typedef double ClipFloat; // floating point type used in clipping
 
 typedef tcu::Vector<ClipFloat, 4> ClipVec4;
 
+enum
+{
+	RASTERIZATION_TILE_SIZE		= 32,	//!< Tile size in pixels for parallel rasterization
+	VERTEX_SHADING_CHUNK_SIZE	= 256	//!< Number of vertices shaded per work item in parallel vertex shading
+};
+
 struct RasterizationInternalBuffers
 {
 	std::vector<FragmentPacket>		fragmentPackets;
 	std::vector<GenericVec4>		shaderOutputs;
 	std::vector<Fragment>			shadedFragments;
+	std::vector<float>				depthValues;
 	float*							fragmentDepthBuffer;
+
+	RasterizationInternalBuffers (void)
+		: fragmentDepthBuffer(DE_NULL)
+	{
+	}
 };
 
 deUint32 readIndexArray (const IndexType type, const void* ptr, size_t ndx)
@@ -88,16 +101,6 @@ bool isEmpty (const rr::MultisampleConstPixelBufferAccess& access)
 	return access.raw().getWidth() == 0 || access.raw().getHeight() == 0 || access.raw().getDepth() == 0;
 }
 
-struct DrawContext
-{
-	int primitiveID;
-
-	DrawContext (void)
-		: primitiveID(0)
-	{
-	}
-};
-
 /*--------------------------------------------------------------------*//*!
  * \brief Calculates intersection of two rects given as (left, bottom, width, height)
  *//*--------------------------------------------------------------------*/
@@ -471,6 +474,110 @@ void clipTriangleToPlane (std::vector<TriangleVertex>& clippedEdges, const Trian
 
 } // cliputil
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Set of vertex packets
+ *
+ * Open-addressing hash set of packet pointers. Slots are tagged with a
+ * generation stamp so that reset() does not need to clear the table and
+ * the same storage is reused for every primitive list.
+ *//*--------------------------------------------------------------------*/
+class VertexPacketSet
+{
+public:
+								VertexPacketSet	(void) : m_generation(0) {}
+
+	void						reset			(size_t maxPackets);
+	bool						insert			(const VertexPacket* packet); //!< Returns false if packet is already in the set
+
+private:
+	std::vector<const VertexPacket*>	m_packets;
+	std::vector<deUint32>				m_stamps;
+	deUint32							m_generation;
+};
+
+void VertexPacketSet::reset (size_t maxPackets)
+{
+	size_t tableSize = 16;
+
+	// keep load factor at most 1/2
+	while (tableSize < maxPackets*2)
+		tableSize *= 2;
+
+	if (tableSize > m_packets.size())
+	{
+		m_packets.assign(tableSize, DE_NULL);
+		m_stamps.assign(tableSize, 0u);
+		m_generation = 0;
+	}
+
+	if (++m_generation == 0)
+	{
+		// stamp wrapped around, stale slots could match
+		std::fill(m_stamps.begin(), m_stamps.end(), 0u);
+		m_generation = 1;
+	}
+}
+
+bool VertexPacketSet::insert (const VertexPacket* packet)
+{
+	const size_t	mask	= m_packets.size() - 1;
+	size_t			slot	= (size_t)(((deUintptr)packet / sizeof(VertexPacket*)) * 2654435761u) & mask;
+
+	DE_ASSERT(!m_packets.empty());
+
+	for (;;)
+	{
+		if (m_stamps[slot] != m_generation)
+		{
+			m_stamps[slot]	= m_generation;
+			m_packets[slot]	= packet;
+			return true;
+		}
+		else if (m_packets[slot] == packet)
+			return false;
+
+		slot = (slot + 1) & mask;
+	}
+}
+
+} // anonymous
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Scratch buffers for triangle clipping
+ *
+ * Owned by Renderer so that clipping does not allocate per primitive or
+ * per draw.
+ *//*--------------------------------------------------------------------*/
+struct ClipBuffers
+{
+	std::vector<cliputil::SubTriangle>		subTriangles;
+	std::vector<cliputil::SubTriangle>		nextPhaseSubTriangles;
+	std::vector<cliputil::TriangleVertex>	convexPrimitive;
+	std::vector<pa::Triangle>				outputTriangles;
+	std::vector<pa::Line>					outputLines;
+	std::vector<pa::Point>					outputPoints;
+};
+
+namespace
+{
+
+struct DrawContext
+{
+	int						primitiveID;
+	tcu::SharedWorkerPool*	workerPool;		//!< Worker pool for parallel vertex shading and rasterization, or DE_NULL
+	ClipBuffers&			clipBuffers;
+
+	// Scratch buffers reused between primitive lists
+	VertexPacketSet			sharedVertices;
+
+	DrawContext (ClipBuffers& clipBuffers_, tcu::SharedWorkerPool* workerPool_)
+		: primitiveID	(0)
+		, workerPool	(workerPool_)
+		, clipBuffers	(clipBuffers_)
+	{
+	}
+};
+
 tcu::Vec2 to2DCartesian (const tcu::Vec4& p)
 {
 	return tcu::Vec2(p.x(), p.y()) / p.w();
@@ -520,7 +627,8 @@ void flatshadeVertices (const Program& program, ContainerType& list)
 void clipPrimitives (std::vector<pa::Triangle>&		list,
 					 const Program&					program,
 					 bool							clipWithZPlanes,
-					 VertexPacketAllocator&			vpalloc)
+					 VertexPacketAllocator&			vpalloc,
+					 ClipBuffers&					buffers)
 {
 	using namespace cliputil;
 
@@ -535,7 +643,12 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 	const ClipVolumePlane*						planes[]			= { &clipPosX, &clipNegX, &clipPosY, &clipNegY, &clipPosZ, &clipNegZ };
 	const int									numPlanes			= (clipWithZPlanes) ? (6) : (4);
 
-	std::vector<pa::Triangle>					outputTriangles;
+	std::vector<pa::Triangle>&					outputTriangles			= buffers.outputTriangles;
+	std::vector<SubTriangle>&					subTriangles			= buffers.subTriangles;
+	std::vector<SubTriangle>&					nextPhaseSubTriangles	= buffers.nextPhaseSubTriangles;
+	std::vector<TriangleVertex>&				convexPrimitive			= buffers.convexPrimitive;
+
+	outputTriangles.clear();
 
 	for (int inputTriangleNdx = 0; inputTriangleNdx < (int)list.size(); ++inputTriangleNdx)
 	{
@@ -582,8 +695,9 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 
 		// Clip
 		{
-			std::vector<SubTriangle>	subTriangles	(1);
-			SubTriangle&				initialTri		= subTriangles[0];
+			subTriangles.resize(1);
+
+			SubTriangle& initialTri = subTriangles[0];
 
 			initialTri.vertices[0].position = vec4ToClipVec4(list[inputTriangleNdx].v0->position);
 			initialTri.vertices[0].weight[0] = (ClipFloat)1.0;
@@ -603,14 +717,14 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 			// Clip all subtriangles to all relevant planes
 			for (int planeNdx = 0; planeNdx < numPlanes; ++planeNdx)
 			{
-				std::vector<SubTriangle> nextPhaseSubTriangles;
-
 				if (!clippedByPlane[planeNdx])
 					continue;
 
+				nextPhaseSubTriangles.clear();
+
 				for (int subTriangleNdx = 0; subTriangleNdx < (int)subTriangles.size(); ++subTriangleNdx)
 				{
-					std::vector<TriangleVertex> convexPrimitive;
+					convexPrimitive.clear();
 
 					// Clip triangle and form a convex n-gon ( n c {3, 4} )
 					clipTriangleToPlane(convexPrimitive, subTriangles[subTriangleNdx].vertices, *planes[planeNdx]);
@@ -710,7 +824,8 @@ void clipPrimitives (std::vector<pa::Triangle>&		list,
 void clipPrimitives (std::vector<pa::Line>& 		list,
 					 const Program& 				program,
 					 bool 							clipWithZPlanes,
-					 VertexPacketAllocator&			vpalloc)
+					 VertexPacketAllocator&			vpalloc,
+					 ClipBuffers&					buffers)
 {
 	DE_UNREF(vpalloc);
 
@@ -719,12 +834,14 @@ void clipPrimitives (std::vector<pa::Line>& 		list,
 	// Lines are clipped only by the far and the near planes here. Line clipping by other planes done in the rasterization phase
 
 	const std::vector<rr::VertexVaryingInfo>&	fragInputs	= (program.geometryShader) ? (program.geometryShader->getOutputs()) : (program.vertexShader->getOutputs());
-	std::vector<pa::Line>						visibleLines;
+	std::vector<pa::Line>&						visibleLines	= buffers.outputLines;
 
 	// Z-clipping disabled, don't do anything
 	if (!clipWithZPlanes)
 		return;
 
+	visibleLines.clear();
+
 	for (size_t ndx = 0; ndx < list.size(); ++ndx)
 	{
 		pa::Line& l = list[ndx];
@@ -781,17 +898,20 @@ void clipPrimitives (std::vector<pa::Line>& 		list,
 void clipPrimitives (std::vector<pa::Point>&		list,
 					 const Program&					program,
 					 bool							clipWithZPlanes,
-					 VertexPacketAllocator&			vpalloc)
+					 VertexPacketAllocator&			vpalloc,
+					 ClipBuffers&					buffers)
 {
 	DE_UNREF(vpalloc);
 	DE_UNREF(program);
 
-	std::vector<pa::Point> visiblePoints;
+	std::vector<pa::Point>& visiblePoints = buffers.outputPoints;
 
 	// Z-clipping disabled, don't do anything
 	if (!clipWithZPlanes)
 		return;
 
+	visiblePoints.clear();
+
 	for (size_t ndx = 0; ndx < list.size(); ++ndx)
 	{
 		pa::Point& p = list[ndx];
@@ -857,14 +977,10 @@ void transformClipCoordsToWindowCoords (const RenderState& state, ContainerType&
 		transformPrimitiveClipCoordsToWindowCoords(state, *it);
 }
 
-void makeSharedVerticeDistinct (VertexPacket*& packet, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void makeSharedVerticeDistinct (VertexPacket*& packet, VertexPacketSet& vertices, VertexPacketAllocator& vpalloc)
 {
 	// distinct
-	if (vertices.find(packet) == vertices.end())
-	{
-		vertices.insert(packet);
-	}
-	else
+	if (!vertices.insert(packet))
 	{
 		VertexPacket* newPacket = vpalloc.alloc();
 
@@ -881,28 +997,28 @@ void makeSharedVerticeDistinct (VertexPacket*& packet, std::set<VertexPacket*, s
 	}
 }
 
-void makeSharedVerticesDistinct (pa::Triangle& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (pa::Triangle& target, VertexPacketSet& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v1, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v2, vertices, vpalloc);
 }
 
-void makeSharedVerticesDistinct (pa::Line& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (pa::Line& target, VertexPacketSet& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 	makeSharedVerticeDistinct(target.v1, vertices, vpalloc);
 }
 
-void makeSharedVerticesDistinct (pa::Point& target, std::set<VertexPacket*, std::less<void*> >& vertices, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (pa::Point& target, VertexPacketSet& vertices, VertexPacketAllocator& vpalloc)
 {
 	makeSharedVerticeDistinct(target.v0, vertices, vpalloc);
 }
 
 template <typename ContainerType>
-void makeSharedVerticesDistinct (ContainerType& list, VertexPacketAllocator& vpalloc)
+void makeSharedVerticesDistinct (ContainerType& list, VertexPacketAllocator& vpalloc, VertexPacketSet& vertices)
 {
-	std::set<VertexPacket*, std::less<void*> > vertices;
+	vertices.reset(list.size() * 3);
 
 	for (typename ContainerType::iterator it = list.begin(); it != list.end(); ++it)
 		makeSharedVerticesDistinct(*it, vertices, vpalloc);
@@ -1100,12 +1216,13 @@ void rasterizePrimitive (const RenderState&					state,
 						 const Program&						program,
 						 const pa::Triangle&				triangle,
 						 const tcu::IVec4&					renderTargetRect,
+						 const tcu::IVec4&					renderRegion,
 						 RasterizationInternalBuffers&		buffers)
 {
 	const int			numSamples		= renderTarget.colorBuffers[0].getNumSamples();
 	const float			depthClampMin	= de::min(state.viewport.zn, state.viewport.zf);
 	const float			depthClampMax	= de::max(state.viewport.zn, state.viewport.zf);
-	TriangleRasterizer	rasterizer		(renderTargetRect, numSamples, state.rasterization);
+	TriangleRasterizer	rasterizer		(renderTargetRect, renderRegion, numSamples, state.rasterization);
 	float				depthOffset		= 0.0f;
 
 	rasterizer.init(triangle.v0->position, triangle.v1->position, triangle.v2->position);
@@ -1168,6 +1285,7 @@ void rasterizePrimitive (const RenderState&					state,
 						 const Program&						program,
 						 const pa::Line&					line,
 						 const tcu::IVec4&					renderTargetRect,
+						 const tcu::IVec4&					renderRegion,
 						 RasterizationInternalBuffers&		buffers)
 {
 	const int					numSamples			= renderTarget.colorBuffers[0].getNumSamples();
@@ -1175,8 +1293,8 @@ void rasterizePrimitive (const RenderState&					state,
 	const float					depthClampMax		= de::max(state.viewport.zn, state.viewport.zf);
 	const bool					msaa				= numSamples > 1;
 	FragmentShadingContext		shadingContext		(line.v0->outputs, line.v1->outputs, DE_NULL, &buffers.shaderOutputs[0], buffers.fragmentDepthBuffer, line.v1->primitiveID, (int)program.fragmentShader->getOutputs().size(), numSamples);
-	SingleSampleLineRasterizer	aliasedRasterizer	(renderTargetRect);
-	MultiSampleLineRasterizer	msaaRasterizer		(numSamples, renderTargetRect);
+	SingleSampleLineRasterizer	aliasedRasterizer	(renderRegion); // \note Aliased line rasterization does not depend on packet alignment
+	MultiSampleLineRasterizer	msaaRasterizer		(numSamples, renderTargetRect, renderRegion);
 
 	// Initialize rasterization.
 	if (msaa)
@@ -1221,13 +1339,14 @@ void rasterizePrimitive (const RenderState&					state,
 						 const Program&						program,
 						 const pa::Point&					point,
 						 const tcu::IVec4&					renderTargetRect,
+						 const tcu::IVec4&					renderRegion,
 						 RasterizationInternalBuffers&		buffers)
 {
 	const int			numSamples		= renderTarget.colorBuffers[0].getNumSamples();
 	const float			depthClampMin	= de::min(state.viewport.zn, state.viewport.zf);
 	const float			depthClampMax	= de::max(state.viewport.zn, state.viewport.zf);
-	TriangleRasterizer	rasterizer1		(renderTargetRect, numSamples, state.rasterization);
-	TriangleRasterizer	rasterizer2		(renderTargetRect, numSamples, state.rasterization);
+	TriangleRasterizer	rasterizer1		(renderTargetRect, renderRegion, numSamples, state.rasterization);
+	TriangleRasterizer	rasterizer2		(renderTargetRect, renderRegion, numSamples, state.rasterization);
 
 	// draw point as two triangles
 	const float offset				= point.v0->pointSize / 2.0f;
@@ -1281,52 +1400,247 @@ void rasterizePrimitive (const RenderState&					state,
 	}
 }
 
+void allocateRasterizationBuffers (RasterizationInternalBuffers& buffers, const RenderTarget& renderTarget, const Program& program)
+{
+	const int		numSamples			= renderTarget.colorBuffers[0].getNumSamples();
+	const int		numFragmentOutputs	= (int)program.fragmentShader->getOutputs().size();
+	const size_t	maxFragmentPackets	= 128;
+
+	buffers.fragmentPackets.resize(maxFragmentPackets);
+	buffers.shaderOutputs.resize(maxFragmentPackets*4*numFragmentOutputs);
+	buffers.shadedFragments.resize(maxFragmentPackets*4);
+
+	// calculate depth only if we have a depth buffer
+	if (!isEmpty(renderTarget.depthBuffer))
+	{
+		buffers.depthValues.resize(maxFragmentPackets*4*numSamples);
+		buffers.fragmentDepthBuffer = &buffers.depthValues[0];
+	}
+	else
+		buffers.fragmentDepthBuffer = DE_NULL;
+}
+
+tcu::IVec4 getRenderTargetRect (const RenderState& state, const RenderTarget& renderTarget)
+{
+	const tcu::IVec4 viewportRect	= tcu::IVec4(state.viewport.rect.left, state.viewport.rect.bottom, state.viewport.rect.width, state.viewport.rect.height);
+	const tcu::IVec4 bufferRect		= getBufferSize(renderTarget.colorBuffers[0]);
+
+	return rectIntersection(viewportRect, bufferRect);
+}
+
+int getNumTiles (int size)
+{
+	return (de::max(size, 0) + RASTERIZATION_TILE_SIZE - 1) / RASTERIZATION_TILE_SIZE;
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Get conservative window-space bounds (xMin, yMin, xMax, yMax) of a primitive
+ *
+ * Bounds are padded to account for fill rules, line widths and point
+ * sizes. Bounds may contain non-finite values.
+ *//*--------------------------------------------------------------------*/
+tcu::Vec4 getPrimitiveBounds (const RenderState& state, const pa::Triangle& triangle)
+{
+	const float			margin	= 2.0f;
+	const tcu::Vec4&	p0		= triangle.v0->position;
+	const tcu::Vec4&	p1		= triangle.v1->position;
+	const tcu::Vec4&	p2		= triangle.v2->position;
+
+	DE_UNREF(state);
+
+	return tcu::Vec4(de::min(de::min(p0.x(), p1.x()), p2.x()) - margin,
+					 de::min(de::min(p0.y(), p1.y()), p2.y()) - margin,
+					 de::max(de::max(p0.x(), p1.x()), p2.x()) + margin,
+					 de::max(de::max(p0.y(), p1.y()), p2.y()) + margin);
+}
+
+tcu::Vec4 getPrimitiveBounds (const RenderState& state, const pa::Line& line)
+{
+	const float			margin	= state.line.lineWidth + 2.0f;
+	const tcu::Vec4&	p0		= line.v0->position;
+	const tcu::Vec4&	p1		= line.v1->position;
+
+	return tcu::Vec4(de::min(p0.x(), p1.x()) - margin,
+					 de::min(p0.y(), p1.y()) - margin,
+					 de::max(p0.x(), p1.x()) + margin,
+					 de::max(p0.y(), p1.y()) + margin);
+}
+
+tcu::Vec4 getPrimitiveBounds (const RenderState& state, const pa::Point& point)
+{
+	const float			margin	= point.v0->pointSize / 2.0f + 2.0f;
+	const tcu::Vec4&	p0		= point.v0->position;
+
+	DE_UNREF(state);
+
+	return tcu::Vec4(p0.x() - margin, p0.y() - margin, p0.x() + margin, p0.y() + margin);
+}
+
+// \note Comparisons are written so that NaN coordinates map to the widest possible tile range.
+int getMinTileNdx (float coord, int origin, int numTiles)
+{
+	const float t = (coord - (float)origin) / (float)RASTERIZATION_TILE_SIZE;
+	return (t > 0.0f) ? ((t < (float)numTiles) ? ((int)t) : (numTiles-1)) : (0);
+}
+
+int getMaxTileNdx (float coord, int origin, int numTiles)
+{
+	const float t = (coord - (float)origin) / (float)RASTERIZATION_TILE_SIZE;
+	return (t < (float)numTiles) ? ((t > 0.0f) ? ((int)t) : (0)) : (numTiles-1);
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Rasterizes binned primitives of one tile per work item
+ *
+ * Each tile processes its primitives in submission order and only touches
+ * pixels within the tile, thus the result is identical to rasterizing
+ * the whole render target on one thread.
+ *//*--------------------------------------------------------------------*/
+template <typename ContainerType>
+class TileRasterizationJob : public de::WorkerPool::Job
+{
+public:
+	TileRasterizationJob (const RenderState&							state,
+						  const RenderTarget&							renderTarget,
+						  const Program&								program,
+						  const ContainerType&							list,
+						  const tcu::IVec4&								renderTargetRect,
+						  const std::vector<int>&						binOffsets,
+						  const std::vector<int>&						binPrimitives,
+						  std::vector<RasterizationInternalBuffers>&	workerBuffers)
+		: m_state				(state)
+		, m_renderTarget		(renderTarget)
+		, m_program				(program)
+		, m_list				(list)
+		, m_renderTargetRect	(renderTargetRect)
+		, m_numTilesX			(getNumTiles(renderTargetRect.z()))
+		, m_binOffsets			(binOffsets)
+		, m_binPrimitives		(binPrimitives)
+		, m_workerBuffers		(workerBuffers)
+	{
+	}
+
+	void execute (int tileNdx, int workerNdx)
+	{
+		const int			tileX		= tileNdx % m_numTilesX;
+		const int			tileY		= tileNdx / m_numTilesX;
+		const tcu::IVec4	tileRect	= rectIntersection(tcu::IVec4(m_renderTargetRect.x() + tileX*RASTERIZATION_TILE_SIZE,
+																	  m_renderTargetRect.y() + tileY*RASTERIZATION_TILE_SIZE,
+																	  RASTERIZATION_TILE_SIZE,
+																	  RASTERIZATION_TILE_SIZE),
+														   m_renderTargetRect);
+
+		for (int binNdx = m_binOffsets[tileNdx]; binNdx < m_binOffsets[tileNdx+1]; ++binNdx)
+			rasterizePrimitive(m_state, m_renderTarget, m_program, m_list[m_binPrimitives[binNdx]], m_renderTargetRect, tileRect, m_workerBuffers[workerNdx]);
+	}
+
+private:
+	const RenderState&							m_state;
+	const RenderTarget&							m_renderTarget;
+	const Program&								m_program;
+	const ContainerType&						m_list;
+	const tcu::IVec4							m_renderTargetRect;
+	const int									m_numTilesX;
+	const std::vector<int>&						m_binOffsets;
+	const std::vector<int>&						m_binPrimitives;
+	std::vector<RasterizationInternalBuffers>&	m_workerBuffers;
+};
+
+template <typename ContainerType>
+void rasterizeTiled (const RenderState&					state,
+					 const RenderTarget&				renderTarget,
+					 const Program&						program,
+					 const ContainerType&				list,
+					 const tcu::IVec4&					renderTargetRect,
+					 tcu::SharedWorkerPool&				pool)
+{
+	const int									numTilesX		= getNumTiles(renderTargetRect.z());
+	const int									numTilesY		= getNumTiles(renderTargetRect.w());
+	const int									numTiles		= numTilesX*numTilesY;
+	std::vector<tcu::IVec4>						tileRanges		(list.size());
+	std::vector<int>							binOffsets		(numTiles+1, 0);
+	std::vector<int>							binPrimitives;
+	std::vector<RasterizationInternalBuffers>	workerBuffers	(pool.getNumWorkers());
+
+	// Find tiles touched by each primitive and count bin sizes
+	for (size_t primitiveNdx = 0; primitiveNdx < list.size(); ++primitiveNdx)
+	{
+		const tcu::Vec4		bounds	= getPrimitiveBounds(state, list[primitiveNdx]);
+		tcu::IVec4&			range	= tileRanges[primitiveNdx];
+
+		range = tcu::IVec4(getMinTileNdx(bounds.x(), renderTargetRect.x(), numTilesX),
+						   getMinTileNdx(bounds.y(), renderTargetRect.y(), numTilesY),
+						   getMaxTileNdx(bounds.z(), renderTargetRect.x(), numTilesX),
+						   getMaxTileNdx(bounds.w(), renderTargetRect.y(), numTilesY));
+
+		for (int tileY = range.y(); tileY <= range.w(); ++tileY)
+		for (int tileX = range.x(); tileX <= range.z(); ++tileX)
+			binOffsets[tileY*numTilesX + tileX + 1] += 1;
+	}
+
+	for (int tileNdx = 0; tileNdx < numTiles; ++tileNdx)
+		binOffsets[tileNdx+1] += binOffsets[tileNdx];
+
+	// Fill bins, primitives stay in submission order within each bin
+	{
+		std::vector<int> binFill (binOffsets.begin(), binOffsets.end()-1);
+
+		binPrimitives.resize(binOffsets[numTiles]);
+
+		for (size_t primitiveNdx = 0; primitiveNdx < list.size(); ++primitiveNdx)
+		{
+			const tcu::IVec4& range = tileRanges[primitiveNdx];
+
+			for (int tileY = range.y(); tileY <= range.w(); ++tileY)
+			for (int tileX = range.x(); tileX <= range.z(); ++tileX)
+				binPrimitives[binFill[tileY*numTilesX + tileX]++] = (int)primitiveNdx;
+		}
+	}
+
+	// \note Buffers are allocated in-place, RasterizationInternalBuffers must not be copied afterwards
+	for (size_t workerNdx = 0; workerNdx < workerBuffers.size(); ++workerNdx)
+		allocateRasterizationBuffers(workerBuffers[workerNdx], renderTarget, program);
+
+	{
+		TileRasterizationJob<ContainerType> job (state, renderTarget, program, list, renderTargetRect, binOffsets, binPrimitives, workerBuffers);
+		pool.execute(job, numTiles);
+	}
+}
+
 template <typename ContainerType>
 void rasterize (const RenderState&					state,
 				const RenderTarget&					renderTarget,
 				const Program&						program,
-				const ContainerType&				list)
+				const ContainerType&				list,
+				tcu::SharedWorkerPool*				pool)
 {
-	const int						numSamples			= renderTarget.colorBuffers[0].getNumSamples();
-	const int						numFragmentOutputs	= (int)program.fragmentShader->getOutputs().size();
-	const size_t					maxFragmentPackets	= 128;
-
-	const tcu::IVec4				viewportRect		= tcu::IVec4(state.viewport.rect.left, state.viewport.rect.bottom, state.viewport.rect.width, state.viewport.rect.height);
-	const tcu::IVec4				bufferRect			= getBufferSize(renderTarget.colorBuffers[0]);
-	const tcu::IVec4				renderTargetRect	= rectIntersection(viewportRect, bufferRect);
+	const tcu::IVec4				renderTargetRect	= getRenderTargetRect(state, renderTarget);
 
-	// shared buffers for all primitives
-	std::vector<FragmentPacket>		fragmentPackets		(maxFragmentPackets);
-	std::vector<GenericVec4>		shaderOutputs		(maxFragmentPackets*4*numFragmentOutputs);
-	std::vector<Fragment>			shadedFragments		(maxFragmentPackets*4);
-	std::vector<float>				depthValues			(0);
-	float*							depthBufferPointer	= DE_NULL;
-
-	RasterizationInternalBuffers	buffers;
+	if (list.empty())
+		return;
 
-	// calculate depth only if we have a depth buffer
-	if (!isEmpty(renderTarget.depthBuffer))
+	if (pool && getNumTiles(renderTargetRect.z())*getNumTiles(renderTargetRect.w()) > 1)
 	{
-		depthValues.resize(maxFragmentPackets*4*numSamples);
-		depthBufferPointer = &depthValues[0];
+		rasterizeTiled(state, renderTarget, program, list, renderTargetRect, *pool);
 	}
+	else
+	{
+		// shared buffers for all primitives
+		RasterizationInternalBuffers buffers;
 
-	// set buffers
-	buffers.fragmentPackets.swap(fragmentPackets);
-	buffers.shaderOutputs.swap(shaderOutputs);
-	buffers.shadedFragments.swap(shadedFragments);
-	buffers.fragmentDepthBuffer = depthBufferPointer;
+		allocateRasterizationBuffers(buffers, renderTarget, program);
 
-	// rasterize
-	for (typename ContainerType::const_iterator it = list.begin(); it != list.end(); ++it)
-		rasterizePrimitive(state, renderTarget, program, *it, renderTargetRect, buffers);
+		// rasterize
+		for (typename ContainerType::const_iterator it = list.begin(); it != list.end(); ++it)
+			rasterizePrimitive(state, renderTarget, program, *it, renderTargetRect, renderTargetRect, buffers);
+	}
 }
 
 /*--------------------------------------------------------------------*//*!
  * Draws transformed triangles, lines or points to render target
  *//*--------------------------------------------------------------------*/
 template <typename ContainerType>
-void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, ContainerType& primList, VertexPacketAllocator& vpalloc)
+void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, ContainerType& primList, VertexPacketAllocator& vpalloc, DrawContext& drawContext)
 {
 	const bool clipZ = !state.fragOps.depthClampEnabled;
 
@@ -1336,14 +1650,13 @@ void drawBasicPrimitives (const RenderState& state, const RenderTarget& renderTa
 	flatshadeVertices(program, primList);
 
 	// Clipping
-	// \todo [jarkko] is creating & swapping std::vectors really a good solution?
-	clipPrimitives(primList, program, clipZ, vpalloc);
+	clipPrimitives(primList, program, clipZ, vpalloc, drawContext.clipBuffers);
 
 	// Transform vertices to window coords
 	transformClipCoordsToWindowCoords(state, primList);
 
 	// Rasterize and paint
-	rasterize(state, renderTarget, program, primList);
+	rasterize(state, renderTarget, program, primList, drawContext.workerPool);
 }
 
 void copyVertexPacketPointers(const VertexPacket** dst, const pa::Point& in)
@@ -1383,7 +1696,7 @@ void copyVertexPacketPointers(const VertexPacket** dst, const pa::TriangleAdjace
 }
 
 template <PrimitiveType DrawPrimitiveType> // \note DrawPrimitiveType  can only be Points, line_strip, or triangle_strip
-void drawGeometryShaderOutputAsPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, VertexPacket* const* vertices, size_t numVertices, VertexPacketAllocator& vpalloc)
+void drawGeometryShaderOutputAsPrimitives (const RenderState& state, const RenderTarget& renderTarget, const Program& program, VertexPacket* const* vertices, size_t numVertices, VertexPacketAllocator& vpalloc, DrawContext& drawContext)
 {
 	// Run primitive assembly for generated stream
 
@@ -1394,11 +1707,11 @@ void drawGeometryShaderOutputAsPrimitives (const RenderState& state, const Rende
 
 	// Make shared vertices distinct
 
-	makeSharedVerticesDistinct(inputPrimitives, vpalloc);
+	makeSharedVerticesDistinct(inputPrimitives, vpalloc, drawContext.sharedVertices);
 
 	// Draw assembled primitives
 
-	drawBasicPrimitives(state, renderTarget, program, inputPrimitives, vpalloc);
+	drawBasicPrimitives(state, renderTarget, program, inputPrimitives, vpalloc, drawContext);
 }
 
 template <PrimitiveType DrawPrimitiveType>
@@ -1453,9 +1766,9 @@ void drawWithGeometryShader(const RenderState& state, const RenderTarget& render
 
 			switch (program.geometryShader->getOutputType())
 			{
-				case rr::GEOMETRYSHADEROUTPUTTYPE_POINTS:			drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_POINTS>			(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
-				case rr::GEOMETRYSHADEROUTPUTTYPE_LINE_STRIP:		drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_LINE_STRIP>		(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
-				case rr::GEOMETRYSHADEROUTPUTTYPE_TRIANGLE_STRIP:	drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP>	(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_POINTS:			drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_POINTS>			(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc, drawContext); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_LINE_STRIP:		drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_LINE_STRIP>		(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc, drawContext); break;
+				case rr::GEOMETRYSHADEROUTPUTTYPE_TRIANGLE_STRIP:	drawGeometryShaderOutputAsPrimitives<PRIMITIVETYPE_TRIANGLE_STRIP>	(state, renderTarget, program, &emitted[primitiveBegin], primitiveEnd-primitiveBegin, vpalloc, drawContext); break;
 				default:
 					DE_ASSERT(DE_FALSE);
 			}
@@ -1496,14 +1809,142 @@ void drawAsPrimitives (const RenderState& state, const RenderTarget& renderTarge
 		convertPrimitiveToBaseType(basePrimitives, inputPrimitives);
 
 		// Make shared vertices distinct. Needed for that the translation to screen space happens only once per vertex, and for flatshading
-		makeSharedVerticesDistinct(basePrimitives, vpalloc);
+		makeSharedVerticesDistinct(basePrimitives, vpalloc, drawContext.sharedVertices);
 
 		// A primitive ID will be generated even if no geometry shader is active
 		generatePrimitiveIDs(basePrimitives, drawContext);
 
 		// Draw as a basic type
-		drawBasicPrimitives(state, renderTarget, program, basePrimitives, vpalloc);
+		drawBasicPrimitives(state, renderTarget, program, basePrimitives, vpalloc, drawContext);
+	}
+}
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Post-transform vertex cache
+ *
+ * Resolves vertex indices of a run of primitive list elements and maps
+ * them to a compacted list of unique vertices, so that each vertex is
+ * shaded only once per instance. Elements referring to the same vertex
+ * share the same vertex packet. Shared packets are made distinct before
+ * any later stage modifies them.
+ *//*--------------------------------------------------------------------*/
+class VertexCache
+{
+public:
+	int										build			(const PrimitiveList& primitives, size_t firstElement, int numElements, VertexPacket* const* uniquePackets, VertexPacket** elementPackets);
+
+private:
+	std::vector<size_t>						m_indices;
+	std::vector<int>						m_slots;		//!< Unique vertex for each index in range [minIndex, maxIndex], or -1
+	std::vector<std::pair<size_t, int> >	m_sortedIndices;
+};
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Build vertex cache for a run of elements
+ * \param primitives		Primitive list
+ * \param firstElement		First element of the run
+ * \param numElements		Number of elements in the run
+ * \param uniquePackets	Packet storage for unique vertices, must have room for numElements packets
+ * \param elementPackets	Output packet pointer for each element
+ * \return Number of unique vertices. vertexNdx is set for
+ *			uniquePackets[0] ... uniquePackets[numUnique-1].
+ *//*--------------------------------------------------------------------*/
+int VertexCache::build (const PrimitiveList& primitives, size_t firstElement, int numElements, VertexPacket* const* uniquePackets, VertexPacket** elementPackets)
+{
+	size_t	minIndex	= ~(size_t)0;
+	size_t	maxIndex	= 0;
+	int		numUnique	= 0;
+
+	DE_ASSERT(numElements > 0);
+
+	m_indices.resize(numElements);
+
+	for (int elementNdx = 0; elementNdx < numElements; ++elementNdx)
+	{
+		const size_t index = primitives.getIndex(firstElement + (size_t)elementNdx);
+
+		m_indices[elementNdx]	= index;
+		minIndex				= de::min(minIndex, index);
+		maxIndex				= de::max(maxIndex, index);
 	}
+
+	if (maxIndex - minIndex < (size_t)numElements * 4)
+	{
+		// Dense index range, use direct lookup
+		m_slots.assign(maxIndex - minIndex + 1, -1);
+
+		for (int elementNdx = 0; elementNdx < numElements; ++elementNdx)
+		{
+			int& slot = m_slots[m_indices[elementNdx] - minIndex];
+
+			if (slot < 0)
+			{
+				slot = numUnique++;
+				uniquePackets[slot]->vertexNdx = (int)m_indices[elementNdx];
+			}
+
+			elementPackets[elementNdx] = uniquePackets[slot];
+		}
+	}
+	else
+	{
+		// Sparse index range, group equal indices by sorting
+		m_sortedIndices.resize(numElements);
+
+		for (int elementNdx = 0; elementNdx < numElements; ++elementNdx)
+			m_sortedIndices[elementNdx] = std::make_pair(m_indices[elementNdx], elementNdx);
+
+		std::sort(m_sortedIndices.begin(), m_sortedIndices.end());
+
+		for (int sortedNdx = 0; sortedNdx < numElements; ++sortedNdx)
+		{
+			if (sortedNdx == 0 || m_sortedIndices[sortedNdx].first != m_sortedIndices[sortedNdx-1].first)
+				uniquePackets[numUnique++]->vertexNdx = (int)m_sortedIndices[sortedNdx].first;
+
+			elementPackets[m_sortedIndices[sortedNdx].second] = uniquePackets[numUnique-1];
+		}
+	}
+
+	return numUnique;
+}
+
+class VertexShadingJob : public de::WorkerPool::Job
+{
+public:
+	VertexShadingJob (const VertexShader& shader, const VertexAttrib* vertexAttribs, VertexPacket* const* packets, int numPackets)
+		: m_shader			(shader)
+		, m_vertexAttribs	(vertexAttribs)
+		, m_packets			(packets)
+		, m_numPackets		(numPackets)
+	{
+	}
+
+	void execute (int chunkNdx, int workerNdx)
+	{
+		const int first	= chunkNdx * VERTEX_SHADING_CHUNK_SIZE;
+		const int count	= de::min((int)VERTEX_SHADING_CHUNK_SIZE, m_numPackets - first);
+
+		DE_UNREF(workerNdx);
+
+		m_shader.shadeVertices(m_vertexAttribs, m_packets + first, count);
+	}
+
+private:
+	const VertexShader&			m_shader;
+	const VertexAttrib* const	m_vertexAttribs;
+	VertexPacket* const* const	m_packets;
+	const int					m_numPackets;
+};
+
+void shadeVertices (const VertexShader& shader, const VertexAttrib* vertexAttribs, VertexPacket* const* packets, int numPackets, tcu::SharedWorkerPool* pool)
+{
+	if (pool && numPackets > VERTEX_SHADING_CHUNK_SIZE)
+	{
+		VertexShadingJob job (shader, vertexAttribs, packets, numPackets);
+		pool->execute(job, (numPackets + VERTEX_SHADING_CHUNK_SIZE - 1) / VERTEX_SHADING_CHUNK_SIZE);
+	}
+	else
+		shader.shadeVertices(vertexAttribs, packets, numPackets);
 }
 
 bool isValidCommand (const DrawCommand& command, int numInstances)
@@ -1716,6 +2157,14 @@ bool PrimitiveList::isRestartIndex (size_t elementNdx, deUint32 restartIndex) co
 }
 
 Renderer::Renderer (void)
+	: m_maxThreads	(1)
+	, m_clipBuffers	(new ClipBuffers())
+{
+}
+
+Renderer::Renderer (int maxThreads)
+	: m_maxThreads	(de::max(maxThreads, 1))
+	, m_clipBuffers	(new ClipBuffers())
 {
 }
 
@@ -1749,32 +2198,31 @@ void Renderer::drawInstanced (const DrawCommand& command, int numInstances) cons
 	// Prepare transformation
 
 	const size_t				numVaryings = command.program.vertexShader->getOutputs().size();
+	const size_t				numElements	= command.primitives.getNumElements();
+	const bool					useCache	= command.primitives.getIndexType() != INDEXTYPE_LAST;
 	VertexPacketAllocator		vpalloc(numVaryings);
-	std::vector<VertexPacket*>	vertexPackets = vpalloc.allocArray(command.primitives.getNumElements());
-	DrawContext					drawContext;
+	std::vector<VertexPacket*>	uniquePackets = vpalloc.allocArray(numElements);
+	std::vector<VertexPacket*>	vertexPackets (numElements);
+	VertexCache					vertexCache;
+	tcu::SharedWorkerPool		workerPool	(m_maxThreads);
+	DrawContext					drawContext	(*m_clipBuffers, workerPool.getNumWorkers() > 1 ? &workerPool : DE_NULL);	// Pool is used only if there is enough work to split.
 
 	for (int instanceID = 0; instanceID < numInstances; ++instanceID)
 	{
 		// Each instance has its own primitives
 		drawContext.primitiveID = 0;
 
-		for (size_t elementNdx = 0; elementNdx < command.primitives.getNumElements(); ++elementNdx)
+		for (size_t elementNdx = 0; elementNdx < numElements; ++elementNdx)
 		{
-			int numVertexPackets = 0;
+			const size_t	firstElement		= elementNdx;
+			int				numVertexPackets	= 0;
+			int				numUniquePackets	= 0;
 
 			// collect primitive vertices until restart
 
-			while (elementNdx < command.primitives.getNumElements() &&
+			while (elementNdx < numElements &&
 					!(command.state.restart.enabled && command.primitives.isRestartIndex(elementNdx, command.state.restart.restartIndex)))
 			{
-				// input
-				vertexPackets[numVertexPackets]->instanceNdx	= instanceID;
-				vertexPackets[numVertexPackets]->vertexNdx		= (int)command.primitives.getIndex(elementNdx);
-
-				// output
-				vertexPackets[numVertexPackets]->pointSize		= command.state.point.pointSize;	// default value from the current state
-				vertexPackets[numVertexPackets]->position		= tcu::Vec4(0, 0, 0, 0);			// no undefined values
-
 				++numVertexPackets;
 				++elementNdx;
 			}
@@ -1783,11 +2231,34 @@ void Renderer::drawInstanced (const DrawCommand& command, int numInstances) cons
 			if (numVertexPackets == 0)
 				continue;
 
-			// \todo Vertex cache?
+			// Find unique vertices
+
+			if (useCache)
+				numUniquePackets = vertexCache.build(command.primitives, firstElement, numVertexPackets, &uniquePackets[0], &vertexPackets[0]);
+			else
+			{
+				for (int packetNdx = 0; packetNdx < numVertexPackets; ++packetNdx)
+				{
+					uniquePackets[packetNdx]->vertexNdx	= (int)command.primitives.getIndex(firstElement + (size_t)packetNdx);
+					vertexPackets[packetNdx]			= uniquePackets[packetNdx];
+				}
+
+				numUniquePackets = numVertexPackets;
+			}
+
+			for (int packetNdx = 0; packetNdx < numUniquePackets; ++packetNdx)
+			{
+				// input
+				uniquePackets[packetNdx]->instanceNdx	= instanceID;
+
+				// output
+				uniquePackets[packetNdx]->pointSize		= command.state.point.pointSize;	// default value from the current state
+				uniquePackets[packetNdx]->position		= tcu::Vec4(0, 0, 0, 0);			// no undefined values
+			}
 
 			// Transform vertices
 
-			command.program.vertexShader->shadeVertices(command.vertexAttribs, &vertexPackets[0], numVertexPackets);
+			shadeVertices(*command.program.vertexShader, command.vertexAttribs, &uniquePackets[0], numUniquePackets, drawContext.workerPool);
 
 			// Draw primitives
 
@@ -29,10 +29,13 @@
 #include "rrPrimitiveTypes.hpp"
 #include "rrMultisamplePixelBufferAccess.hpp"
 #include "tcuTexture.hpp"
+#include "deUniquePtr.hpp"
 
 namespace rr
 {
 
+struct ClipBuffers;
+
 class RenderTarget
 {
 public:
@@ -127,14 +130,36 @@ public:
 	const PrimitiveList&		primitives;
 };
 
+/*--------------------------------------------------------------------*//*!
+ * \brief Reference renderer
+ *
+ * Indexed draws shade each unique vertex only once per instance, so
+ * vertex shaders must produce the same outputs for the same vertex and
+ * instance index.
+ *
+ * If the renderer is created with maxThreads > 1, vertices are shaded in
+ * parallel chunks and the render target is split into tiles that are
+ * rasterized and shaded in parallel. Output is identical to
+ * single-threaded rendering, but the shaders must support concurrent
+ * shadeVertices() and shadeFragments() calls.
+ *
+ * Worker threads are borrowed from tcu::SharedWorkerPool for each draw.
+ * Clipping buffers are kept for the lifetime of the renderer, so one
+ * renderer must not be used from several threads at once.
+ *//*--------------------------------------------------------------------*/
 class Renderer
 {
 public:
 					Renderer		(void);
+	explicit		Renderer		(int maxThreads);
 					~Renderer		(void);
 
 	void			draw			(const DrawCommand& command) const;
 	void			drawInstanced	(const DrawCommand& command, int numInstances) const;
+
+private:
+	const int							m_maxThreads;	//!< Maximum number of threads borrowed from shared worker pool
+	const de::UniquePtr<ClipBuffers>	m_clipBuffers;	//!< Clipping scratch buffers reused between draws
 };
 
 } // rr
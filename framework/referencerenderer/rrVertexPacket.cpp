@@ -35,7 +35,8 @@ VertexPacket::~VertexPacket (void)
 }
 
 VertexPacketAllocator::VertexPacketAllocator (const size_t numberOfVertexOutputs)
-	: m_numberOfVertexOutputs(numberOfVertexOutputs)
+	: m_numberOfVertexOutputs	(numberOfVertexOutputs)
+	, m_singleAllocPoolSize		(8)
 {
 }
 
@@ -77,10 +78,14 @@ std::vector<VertexPacket*> VertexPacketAllocator::allocArray (size_t count)
 
 VertexPacket* VertexPacketAllocator::alloc (void)
 {
-	const size_t poolSize = 8;
+	const size_t maxPoolSize = 1024;
 
+	// Pool size grows so that allocating many single packets does not hit the heap each time
 	if (m_singleAllocPool.empty())
-		m_singleAllocPool = allocArray(poolSize);
+	{
+		m_singleAllocPool		= allocArray(m_singleAllocPoolSize);
+		m_singleAllocPoolSize	= de::min(m_singleAllocPoolSize * 2, maxPoolSize);
+	}
 
 	VertexPacket* packet = *--m_singleAllocPool.end();
 	m_singleAllocPool.pop_back();
@@ -109,6 +109,7 @@ private:
 	const size_t				m_numberOfVertexOutputs;
 	std::vector<deInt8*>		m_allocations;
 	std::vector<VertexPacket*>	m_singleAllocPool;
+	size_t						m_singleAllocPoolSize;
 };
 
 } // rr
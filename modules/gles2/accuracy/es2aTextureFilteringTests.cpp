@@ -130,7 +130,7 @@ void Texture2DFilteringCase::init (void)
 		if (!m_filenames.empty())
 		{
 			m_textures.reserve(1);
-			m_textures.push_back(glu::Texture2D::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size(), m_filenames));
+			m_textures.push_back(glu::Texture2D::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size(), m_filenames, tcu::CompressedTexture::DecompressionParams(false, &m_testCtx.getDecompressionCache())));
 		}
 		else
 		{
@@ -391,7 +391,7 @@ void TextureCubeFilteringCase::init (void)
 		if (!m_filenames.empty())
 		{
 			m_textures.reserve(1);
-			m_textures.push_back(glu::TextureCube::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size() / 6, m_filenames));
+			m_textures.push_back(glu::TextureCube::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size() / 6, m_filenames, tcu::CompressedTexture::DecompressionParams(false, &m_testCtx.getDecompressionCache())));
 		}
 		else
 		{
@@ -432,7 +432,7 @@ Compressed2DFormatCase::~Compressed2DFormatCase (void)
 void Compressed2DFormatCase::init (void)
 {
 	// Create texture.
-	m_texture = Texture2D::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size(), m_filenames);
+	m_texture = Texture2D::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size(), m_filenames, tcu::CompressedTexture::DecompressionParams(false, &m_testCtx.getDecompressionCache()));
 }
 
 void Compressed2DFormatCase::deinit (void)
@@ -540,7 +540,7 @@ void CompressedCubeFormatCase::init (void)
 {
 	// Create texture.
 	DE_ASSERT(m_filenames.size() % 6 == 0);
-	m_texture = TextureCube::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size()/6, m_filenames);
+	m_texture = TextureCube::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size()/6, m_filenames, tcu::CompressedTexture::DecompressionParams(false, &m_testCtx.getDecompressionCache()));
 
 	m_curFace	= 0;
 	m_isOk		= true;
@@ -394,7 +394,7 @@ Texture2DMipmapCase::IterateResult Texture2DMipmapCase::iterate (void)
 															tcu::getSubregion(referenceFrame.getAccess(), curX, curY, curW, curH),
 															tcu::getSubregion(errorMask.getAccess(), curX, curY, curW, curH),
 															m_texture->getRefTexture(), &texCoord[0], sampleParams,
-															lookupPrec, lodPrec, m_testCtx.getWatchDog());
+															lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, m_testCtx.getWatchDog());
 			}
 		}
 
@@ -718,7 +718,7 @@ TextureCubeMipmapCase::IterateResult TextureCubeMipmapCase::iterate (void)
 														tcu::getSubregion(referenceFrame.getAccess(), curX, curY, curW, curH),
 														tcu::getSubregion(errorMask.getAccess(), curX, curY, curW, curH),
 														m_texture->getRefTexture(), &texCoord[0], params,
-														lookupPrec, lodPrec, m_testCtx.getWatchDog());
+														lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, m_testCtx.getWatchDog());
 		}
 
 		if (numFailedPixels > 0)
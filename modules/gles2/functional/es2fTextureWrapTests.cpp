@@ -132,7 +132,7 @@ void TextureWrapCase::init (void)
 	{
 		DE_ASSERT(m_width == 0 && m_height == 0 && m_format == GL_NONE && m_dataType == GL_NONE);
 
-		m_texture	= glu::Texture2D::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size(), m_filenames);
+		m_texture	= glu::Texture2D::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size(), m_filenames, tcu::CompressedTexture::DecompressionParams(false, &m_testCtx.getDecompressionCache()));
 		m_width		= m_texture->getRefTexture().getWidth();
 		m_height	= m_texture->getRefTexture().getHeight();
 	}
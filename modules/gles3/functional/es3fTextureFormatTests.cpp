@@ -1059,7 +1059,7 @@ Texture2DFileCase::~Texture2DFileCase (void)
 void Texture2DFileCase::init (void)
 {
 	// Create texture.
-	m_texture = glu::Texture2D::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size(), m_filenames);
+	m_texture = glu::Texture2D::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size(), m_filenames, tcu::CompressedTexture::DecompressionParams(false, &m_testCtx.getDecompressionCache()));
 }
 
 void Texture2DFileCase::deinit (void)
@@ -1167,7 +1167,7 @@ void TextureCubeFileCase::init (void)
 {
 	// Create texture.
 	DE_ASSERT(m_filenames.size() % 6 == 0);
-	m_texture = glu::TextureCube::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size()/6, m_filenames);
+	m_texture = glu::TextureCube::create(m_renderCtx, m_renderCtxInfo, m_testCtx.getArchive(), (int)m_filenames.size()/6, m_filenames, tcu::CompressedTexture::DecompressionParams(false, &m_testCtx.getDecompressionCache()));
 
 	m_curFace	= 0;
 	m_isOk		= true;
@@ -438,7 +438,7 @@ Texture2DMipmapCase::IterateResult Texture2DMipmapCase::iterate (void)
 															tcu::getSubregion(referenceFrame.getAccess(), curX, curY, curW, curH),
 															tcu::getSubregion(errorMask.getAccess(), curX, curY, curW, curH),
 															m_texture->getRefTexture(), &texCoord[0], sampleParams,
-															lookupPrec, lodPrec, m_testCtx.getWatchDog());
+															lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, m_testCtx.getWatchDog());
 			}
 		}
 
@@ -757,7 +757,7 @@ TextureCubeMipmapCase::IterateResult TextureCubeMipmapCase::iterate (void)
 														tcu::getSubregion(referenceFrame.getAccess(), curX, curY, curW, curH),
 														tcu::getSubregion(errorMask.getAccess(), curX, curY, curW, curH),
 														m_texture->getRefTexture(), &texCoord[0], params,
-														lookupPrec, lodPrec, m_testCtx.getWatchDog());
+														lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, m_testCtx.getWatchDog());
 		}
 
 		if (numFailedPixels > 0)
@@ -1388,7 +1388,7 @@ Texture3DMipmapCase::IterateResult Texture3DMipmapCase::iterate (void)
 															tcu::getSubregion(referenceFrame.getAccess(), curX, curY, curW, curH),
 															tcu::getSubregion(errorMask.getAccess(), curX, curY, curW, curH),
 															m_texture->getRefTexture(), &texCoord[0], sampleParams,
-															lookupPrec, lodPrec, m_testCtx.getWatchDog());
+															lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, m_testCtx.getWatchDog());
 			}
 		}
 
@@ -1590,7 +1590,7 @@ Texture2DLodControlCase::IterateResult Texture2DLodControlCase::iterate (void)
 															tcu::getSubregion(referenceFrame.getAccess(), curX, curY, curW, curH),
 															tcu::getSubregion(errorMask.getAccess(), curX, curY, curW, curH),
 															m_texture->getRefTexture(), &texCoord[0], sampleParams,
-															lookupPrec, lodPrec, m_testCtx.getWatchDog());
+															lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, m_testCtx.getWatchDog());
 			}
 		}
 
@@ -1906,7 +1906,7 @@ TextureCubeLodControlCase::IterateResult TextureCubeLodControlCase::iterate (voi
 														tcu::getSubregion(referenceFrame.getAccess(), curX, curY, curW, curH),
 														tcu::getSubregion(errorMask.getAccess(), curX, curY, curW, curH),
 														m_texture->getRefTexture(), &texCoord[0], params,
-														lookupPrec, lodPrec, m_testCtx.getWatchDog());
+														lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, m_testCtx.getWatchDog());
 		}
 
 		if (numFailedPixels > 0)
@@ -2222,7 +2222,7 @@ Texture3DLodControlCase::IterateResult Texture3DLodControlCase::iterate (void)
 															tcu::getSubregion(referenceFrame.getAccess(), curX, curY, curW, curH),
 															tcu::getSubregion(errorMask.getAccess(), curX, curY, curW, curH),
 															m_texture->getRefTexture(), &texCoord[0], sampleParams,
-															lookupPrec, lodPrec, m_testCtx.getWatchDog());
+															lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, m_testCtx.getWatchDog());
 			}
 		}
 
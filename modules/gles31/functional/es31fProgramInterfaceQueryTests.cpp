@@ -26,6 +26,7 @@
 #include "es31fProgramInterfaceDefinition.hpp"
 #include "es31fProgramInterfaceDefinitionUtil.hpp"
 #include "tcuTestLog.hpp"
+#include "tcuTestGroupUtil.hpp"
 #include "gluShaderProgram.hpp"
 #include "gluVarTypeUtil.hpp"
 #include "gluStrUtil.hpp"
@@ -4101,6 +4102,47 @@ static void generateUniformCaseRandomCases (Context& context, tcu::TestCaseGroup
 		generateUniformRandomCase(context, targetGroup, ndx);
 }
 
+// Interface subgroups are created with tcu::createTestGroup() so that their
+// cases are generated only when the test executor enters the subgroup.
+
+static void generateGroupChildren (tcu::TestCaseGroup* group, Context* context, void (*generator)(Context&, tcu::TestCaseGroup*))
+{
+	generator(*context, group);
+}
+
+template <typename Arg>
+static void generateGroupChildrenWithArg (tcu::TestCaseGroup* group, Context* context, void (*generator)(Context&, tcu::TestCaseGroup*, Arg), Arg arg)
+{
+	generator(*context, group, arg);
+}
+
+static tcu::TestCaseGroup* createLazyGroup (Context& context, const char* name, const char* description, void (*generator)(Context&, tcu::TestCaseGroup*))
+{
+	return tcu::createTestGroup(context.getTestContext(), name, description, generateGroupChildren, &context, generator);
+}
+
+template <typename Arg>
+static tcu::TestCaseGroup* createLazyGroup (Context& context, const char* name, const char* description, void (*generator)(Context&, tcu::TestCaseGroup*, Arg), Arg arg)
+{
+	return tcu::createTestGroup(context.getTestContext(), name, description, generateGroupChildrenWithArg<Arg>, &context, generator, arg);
+}
+
+static void generateComputeUniformCaseBlocks (tcu::TestCaseGroup* group, Context* context, deUint32 blockFlags, void (*blockContentGenerator)(Context&, const ResourceDefinition::Node::SharedPtr&, tcu::TestCaseGroup* const))
+{
+	const ResourceDefinition::Node::SharedPtr	program			(new ResourceDefinition::Program());
+	const ResourceDefinition::Node::SharedPtr	computeShader	(new ResourceDefinition::Shader(program, glu::SHADERTYPE_COMPUTE, glu::GLSL_VERSION_310_ES));
+
+	generateUniformCaseBlocks(*context, computeShader, group, blockFlags, blockContentGenerator);
+}
+
+static void generateComputeUniformMatrixCaseBlocks (tcu::TestCaseGroup* group, Context* context, void (*blockContentGenerator)(Context&, const ResourceDefinition::Node::SharedPtr&, tcu::TestCaseGroup* const, bool, bool))
+{
+	const ResourceDefinition::Node::SharedPtr	program			(new ResourceDefinition::Program());
+	const ResourceDefinition::Node::SharedPtr	computeShader	(new ResourceDefinition::Shader(program, glu::SHADERTYPE_COMPUTE, glu::GLSL_VERSION_310_ES));
+
+	generateUniformMatrixCaseBlocks(*context, computeShader, group, blockContentGenerator);
+}
+
 class UniformInterfaceTestGroup : public TestCaseGroup
 {
 public:
@@ -4115,99 +4157,44 @@ UniformInterfaceTestGroup::UniformInterfaceTestGroup (Context& context)
 
 void UniformInterfaceTestGroup::init (void)
 {
-	const ResourceDefinition::Node::SharedPtr	program			(new ResourceDefinition::Program());
-	const ResourceDefinition::Node::SharedPtr	computeShader	(new ResourceDefinition::Shader(program, glu::SHADERTYPE_COMPUTE, glu::GLSL_VERSION_310_ES));
-
 	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformResourceListBlockContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "resource_list", "Resource list", generateComputeUniformCaseBlocks, &m_context, BLOCKFLAG_ALL, generateUniformResourceListBlockContents));
 
 	// .array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "array_size", "Query array size");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformBlockArraySizeContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "array_size", "Query array size", generateComputeUniformCaseBlocks, &m_context, BLOCKFLAG_ALL, generateUniformBlockArraySizeContents));
 
 	// .array_stride
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "array_stride", "Query array stride");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformBlockArrayStrideContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "array_stride", "Query array stride", generateComputeUniformCaseBlocks, &m_context, BLOCKFLAG_ALL, generateUniformBlockArrayStrideContents));
 
 	// .atomic_counter_buffer_index
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "atomic_counter_buffer_index", "Query atomic counter buffer index");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_DEFAULT | BLOCKFLAG_NAMED, generateUniformBlockAtomicCounterBufferIndexContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "atomic_counter_buffer_index", "Query atomic counter buffer index", generateComputeUniformCaseBlocks, &m_context, BLOCKFLAG_DEFAULT | BLOCKFLAG_NAMED, generateUniformBlockAtomicCounterBufferIndexContents));
 
 	// .block_index
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "block_index", "Query block index");
-		addChild(blockGroup);
-		generateUniformBlockBlockIndexContents(m_context, blockGroup);
-	}
+	addChild(createLazyGroup(m_context, "block_index", "Query block index", generateUniformBlockBlockIndexContents));
 
 	// .location
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "location", "Query location");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_DEFAULT | BLOCKFLAG_NAMED | BLOCKFLAG_UNNAMED, generateUniformBlockLocationContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "location", "Query location", generateComputeUniformCaseBlocks, &m_context, BLOCKFLAG_DEFAULT | BLOCKFLAG_NAMED | BLOCKFLAG_UNNAMED, generateUniformBlockLocationContents));
 
 	// .matrix_row_major
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "matrix_row_major", "Query matrix row_major");
-		addChild(blockGroup);
-		generateUniformMatrixCaseBlocks(m_context, computeShader, blockGroup, generateUniformMatrixOrderCaseBlockContentCases);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "matrix_row_major", "Query matrix row_major", generateComputeUniformMatrixCaseBlocks, &m_context, generateUniformMatrixOrderCaseBlockContentCases));
 
 	// .matrix_stride
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "matrix_stride", "Query matrix stride");
-		addChild(blockGroup);
-		generateUniformMatrixCaseBlocks(m_context, computeShader, blockGroup, generateUniformMatrixStrideCaseBlockContentCases);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "matrix_stride", "Query matrix stride", generateComputeUniformMatrixCaseBlocks, &m_context, generateUniformMatrixStrideCaseBlockContentCases));
 
 	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "name_length", "Query name length");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformBlockNameLengthContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "name_length", "Query name length", generateComputeUniformCaseBlocks, &m_context, BLOCKFLAG_ALL, generateUniformBlockNameLengthContents));
 
 	// .offset
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "offset", "Query offset");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformBlockOffsetContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "offset", "Query offset", generateComputeUniformCaseBlocks, &m_context, BLOCKFLAG_ALL, generateUniformBlockOffsetContents));
 
 	// .referenced_by_shader
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "referenced_by_shader", "Query referenced by shader");
-		addChild(blockGroup);
-		generateReferencedByShaderCaseBlocks(m_context, blockGroup, generateUniformReferencedByShaderSingleBlockContentCases);
-	}
+	addChild(createLazyGroup(m_context, "referenced_by_shader", "Query referenced by shader", generateReferencedByShaderCaseBlocks, generateUniformReferencedByShaderSingleBlockContentCases));
 
 	// .type
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "type", "Query type");
-		addChild(blockGroup);
-		generateUniformCaseBlocks(m_context, computeShader, blockGroup, BLOCKFLAG_ALL, generateUniformBlockTypeContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "type", "Query type", generateComputeUniformCaseBlocks, &m_context, BLOCKFLAG_ALL, generateUniformBlockTypeContents));
 
 	// .random
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "random", "Random");
-		addChild(blockGroup);
-		generateUniformCaseRandomCases(m_context, blockGroup);
-	}
+	addChild(createLazyGroup(m_context, "random", "Random", generateUniformCaseRandomCases));
 }
 
 static void generateBufferBackedInterfaceResourceListCase (Context& context, const ResourceDefinition::Node::SharedPtr& targetResource, tcu::TestCaseGroup* const targetGroup, ProgramInterface interface, const char* blockName)
@@ -4359,6 +4346,11 @@ static void generateBufferBackedInterfaceResourceBufferDataSizeCases (Context& c
 	targetGroup->addChild(new InterfaceBlockDataSizeTestCase(context, "block_array",	"Block array",		storage,	InterfaceBlockDataSizeTestCase::CASE_BLOCK_ARRAY));
 }
 
+static void generateBufferBackedInterfaceBasicBlockTypeCases (tcu::TestCaseGroup* group, Context* context, glu::Storage storage, void (*blockContentGenerator)(Context&, const ResourceDefinition::Node::SharedPtr&, tcu::TestCaseGroup* const, ProgramInterface interface, const char* blockName))
+{
+	generateBufferBackedInterfaceResourceBasicBlockTypes(*context, group, storage, blockContentGenerator);
+}
+
 class BufferBackedBlockInterfaceTestGroup : public TestCaseGroup
 {
 public:
@@ -4382,52 +4374,27 @@ BufferBackedBlockInterfaceTestGroup::BufferBackedBlockInterfaceTestGroup(Context
 void BufferBackedBlockInterfaceTestGroup::init (void)
 {
 	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateBufferBackedInterfaceResourceBasicBlockTypes(m_context, blockGroup, m_storage, generateBufferBackedInterfaceResourceListCase);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "resource_list", "Resource list", generateBufferBackedInterfaceBasicBlockTypeCases, &m_context, m_storage, generateBufferBackedInterfaceResourceListCase));
 
 	// .active_variables
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "active_variables", "Active variables");
-		addChild(blockGroup);
-		generateBufferBackedInterfaceResourceActiveVariablesCase(m_context, blockGroup, m_storage);
-	}
+	addChild(createLazyGroup(m_context, "active_variables", "Active variables", generateBufferBackedInterfaceResourceActiveVariablesCase, m_storage));
 
 	// .buffer_binding
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "buffer_binding", "Buffer binding");
-		addChild(blockGroup);
-		generateBufferBackedInterfaceResourceBufferBindingCases(m_context, blockGroup, m_storage);
-	}
+	addChild(createLazyGroup(m_context, "buffer_binding", "Buffer binding", generateBufferBackedInterfaceResourceBufferBindingCases, m_storage));
 
 	// .buffer_data_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "buffer_data_size", "Buffer data size");
-		addChild(blockGroup);
-		generateBufferBackedInterfaceResourceBufferDataSizeCases(m_context, blockGroup, m_storage);
-	}
+	addChild(createLazyGroup(m_context, "buffer_data_size", "Buffer data size", generateBufferBackedInterfaceResourceBufferDataSizeCases, m_storage));
 
 	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "name_length", "Name length");
-		addChild(blockGroup);
-		generateBufferBackedInterfaceResourceBasicBlockTypes(m_context, blockGroup, m_storage, generateBufferBackedInterfaceNameLengthCase);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "name_length", "Name length", generateBufferBackedInterfaceBasicBlockTypeCases, &m_context, m_storage, generateBufferBackedInterfaceNameLengthCase));
 
 	// .referenced_by
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "referenced_by", "Referenced by shader");
-		addChild(blockGroup);
-
-		if (m_storage == glu::STORAGE_UNIFORM)
-			generateReferencedByShaderCaseBlocks(m_context, blockGroup, generateBufferBlockReferencedByShaderSingleBlockContentCases<glu::STORAGE_UNIFORM>);
-		else if (m_storage == glu::STORAGE_BUFFER)
-			generateReferencedByShaderCaseBlocks(m_context, blockGroup, generateBufferBlockReferencedByShaderSingleBlockContentCases<glu::STORAGE_BUFFER>);
-		else
-			DE_ASSERT(false);
-	}
+	if (m_storage == glu::STORAGE_UNIFORM)
+		addChild(createLazyGroup(m_context, "referenced_by", "Referenced by shader", generateReferencedByShaderCaseBlocks, generateBufferBlockReferencedByShaderSingleBlockContentCases<glu::STORAGE_UNIFORM>));
+	else if (m_storage == glu::STORAGE_BUFFER)
+		addChild(createLazyGroup(m_context, "referenced_by", "Referenced by shader", generateReferencedByShaderCaseBlocks, generateBufferBlockReferencedByShaderSingleBlockContentCases<glu::STORAGE_BUFFER>));
+	else
+		DE_ASSERT(false);
 }
 
 const char* BufferBackedBlockInterfaceTestGroup::getGroupName (glu::Storage storage)
@@ -5027,6 +4994,16 @@ static void generateProgramOutputTypeBlockContents (Context& context, const Reso
 	}
 }
 
+static void generateProgramInputShaderCaseBlocks (tcu::TestCaseGroup* group, Context* context, bool withCompute, void (*blockContentGenerator)(Context&, const ResourceDefinition::Node::SharedPtr&, tcu::TestCaseGroup*, deUint32))
+{
+	generateProgramInputOutputShaderCaseBlocks(*context, group, withCompute, true, blockContentGenerator);
+}
+
+static void generateProgramOutputShaderCaseBlocks (tcu::TestCaseGroup* group, Context* context, bool withCompute, void (*blockContentGenerator)(Context&, const ResourceDefinition::Node::SharedPtr&, tcu::TestCaseGroup*, deUint32))
+{
+	generateProgramInputOutputShaderCaseBlocks(*context, group, withCompute, false, blockContentGenerator);
+}
+
 class ProgramInputTestGroup : public TestCaseGroup
 {
 public:
@@ -5042,46 +5019,22 @@ ProgramInputTestGroup::ProgramInputTestGroup (Context& context)
 void ProgramInputTestGroup::init (void)
 {
 	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, true, true, generateProgramInputResourceListBlockContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "resource_list", "Resource list", generateProgramInputShaderCaseBlocks, &m_context, true, generateProgramInputResourceListBlockContents));
 
 	// .array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "array_size", "Array size");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, true, generateProgramInputBasicBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "array_size", "Array size", generateProgramInputShaderCaseBlocks, &m_context, false, generateProgramInputBasicBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>));
 
 	// .location
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "location", "Location");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, true, generateProgramInputLocationBlockContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "location", "Location", generateProgramInputShaderCaseBlocks, &m_context, false, generateProgramInputLocationBlockContents));
 
 	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "name_length", "Name length");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, true, generateProgramInputBasicBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "name_length", "Name length", generateProgramInputShaderCaseBlocks, &m_context, false, generateProgramInputBasicBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>));
 
 	// .referenced_by
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "referenced_by", "Reference by shader");
-		addChild(blockGroup);
-		generateProgramInputOutputReferencedByCases(m_context, blockGroup, glu::STORAGE_IN);
-	}
+	addChild(createLazyGroup(m_context, "referenced_by", "Reference by shader", generateProgramInputOutputReferencedByCases, glu::STORAGE_IN));
 
 	// .type
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "type", "Type");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, true, true, generateProgramInputTypeBlockContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "type", "Type", generateProgramInputShaderCaseBlocks, &m_context, true, generateProgramInputTypeBlockContents));
 }
 
 class ProgramOutputTestGroup : public TestCaseGroup
@@ -5099,46 +5052,22 @@ ProgramOutputTestGroup::ProgramOutputTestGroup (Context& context)
 void ProgramOutputTestGroup::init (void)
 {
 	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, true, false, generateProgramOutputResourceListBlockContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "resource_list", "Resource list", generateProgramOutputShaderCaseBlocks, &m_context, true, generateProgramOutputResourceListBlockContents));
 
 	// .array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "array_size", "Array size");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, false, generateProgramOutputBasicBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "array_size", "Array size", generateProgramOutputShaderCaseBlocks, &m_context, false, generateProgramOutputBasicBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>));
 
 	// .location
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "location", "Location");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, false, generateProgramOutputLocationBlockContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "location", "Location", generateProgramOutputShaderCaseBlocks, &m_context, false, generateProgramOutputLocationBlockContents));
 
 	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "name_length", "Name length");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, false, false, generateProgramOutputBasicBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "name_length", "Name length", generateProgramOutputShaderCaseBlocks, &m_context, false, generateProgramOutputBasicBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>));
 
 	// .referenced_by
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "referenced_by", "Reference by shader");
-		addChild(blockGroup);
-		generateProgramInputOutputReferencedByCases(m_context, blockGroup, glu::STORAGE_OUT);
-	}
+	addChild(createLazyGroup(m_context, "referenced_by", "Reference by shader", generateProgramInputOutputReferencedByCases, glu::STORAGE_OUT));
 
 	// .type
-	{
-		tcu::TestCaseGroup* const blockGroup = new tcu::TestCaseGroup(m_testCtx, "type", "Type");
-		addChild(blockGroup);
-		generateProgramInputOutputShaderCaseBlocks(m_context, blockGroup, true, false, generateProgramOutputTypeBlockContents);
-	}
+	addChild(tcu::createTestGroup(m_testCtx, "type", "Type", generateProgramOutputShaderCaseBlocks, &m_context, true, generateProgramOutputTypeBlockContents));
 }
 
 static void generateTransformFeedbackShaderCaseBlocks (Context& context, tcu::TestCaseGroup* targetGroup, void (*blockContentGenerator)(Context&, const ResourceDefinition::Node::SharedPtr&, tcu::TestCaseGroup*))
@@ -5363,32 +5292,16 @@ TransformFeedbackVaryingTestGroup::TransformFeedbackVaryingTestGroup (Context& c
 void TransformFeedbackVaryingTestGroup::init (void)
 {
 	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateTransformFeedbackShaderCaseBlocks(m_context, blockGroup, generateTransformFeedbackResourceListBlockContents);
-	}
+	addChild(createLazyGroup(m_context, "resource_list", "Resource list", generateTransformFeedbackShaderCaseBlocks, generateTransformFeedbackResourceListBlockContents));
 
 	// .array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "array_size", "Array size");
-		addChild(blockGroup);
-		generateTransformFeedbackShaderCaseBlocks(m_context, blockGroup, generateTransformFeedbackVariableBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
-	}
+	addChild(createLazyGroup(m_context, "array_size", "Array size", generateTransformFeedbackShaderCaseBlocks, generateTransformFeedbackVariableBlockContents<PROGRAMRESOURCEPROP_ARRAY_SIZE>));
 
 	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "name_length", "Name length");
-		addChild(blockGroup);
-		generateTransformFeedbackShaderCaseBlocks(m_context, blockGroup, generateTransformFeedbackVariableBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>);
-	}
+	addChild(createLazyGroup(m_context, "name_length", "Name length", generateTransformFeedbackShaderCaseBlocks, generateTransformFeedbackVariableBlockContents<PROGRAMRESOURCEPROP_NAME_LENGTH>));
 
 	// .type
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "type", "Type");
-		addChild(blockGroup);
-		generateTransformFeedbackShaderCaseBlocks(m_context, blockGroup, generateTransformFeedbackVariableTypeBlockContents);
-	}
+	addChild(createLazyGroup(m_context, "type", "Type", generateTransformFeedbackShaderCaseBlocks, generateTransformFeedbackVariableTypeBlockContents));
 }
 
 static void generateBufferVariableBufferCaseBlocks (Context& context, tcu::TestCaseGroup* targetGroup, void (*blockContentGenerator)(Context&, const ResourceDefinition::Node::SharedPtr&, tcu::TestCaseGroup*))
@@ -5900,95 +5813,43 @@ BufferVariableTestGroup::BufferVariableTestGroup (Context& context)
 void BufferVariableTestGroup::init (void)
 {
 	// .resource_list
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "resource_list", "Resource list");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableResourceListBlockContentsProxy);
-	}
+	addChild(createLazyGroup(m_context, "resource_list", "Resource list", generateBufferVariableBufferCaseBlocks, generateBufferVariableResourceListBlockContentsProxy));
 
 	// .array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "array_size", "Array size");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableArrayCases<PROGRAMRESOURCEPROP_ARRAY_SIZE>);
-	}
+	addChild(createLazyGroup(m_context, "array_size", "Array size", generateBufferVariableBufferCaseBlocks, generateBufferVariableArrayCases<PROGRAMRESOURCEPROP_ARRAY_SIZE>));
 
 	// .array_stride
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "array_stride", "Array stride");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableArrayCases<PROGRAMRESOURCEPROP_ARRAY_STRIDE>);
-	}
+	addChild(createLazyGroup(m_context, "array_stride", "Array stride", generateBufferVariableBufferCaseBlocks, generateBufferVariableArrayCases<PROGRAMRESOURCEPROP_ARRAY_STRIDE>));
 
 	// .block_index
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "block_index", "Block index");
-		addChild(blockGroup);
-		generateBufferVariableBlockIndexCases(m_context, blockGroup);
-	}
+	addChild(createLazyGroup(m_context, "block_index", "Block index", generateBufferVariableBlockIndexCases));
 
 	// .is_row_major
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "is_row_major", "Is row major");
-		addChild(blockGroup);
-		generateBufferVariableMatrixCaseBlocks(m_context, blockGroup, generateBufferVariableMatrixCases<PROGRAMRESOURCEPROP_MATRIX_ROW_MAJOR>);
-	}
+	addChild(createLazyGroup(m_context, "is_row_major", "Is row major", generateBufferVariableMatrixCaseBlocks, generateBufferVariableMatrixCases<PROGRAMRESOURCEPROP_MATRIX_ROW_MAJOR>));
 
 	// .matrix_stride
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "matrix_stride", "Matrix stride");
-		addChild(blockGroup);
-		generateBufferVariableMatrixCaseBlocks(m_context, blockGroup, generateBufferVariableMatrixCases<PROGRAMRESOURCEPROP_MATRIX_STRIDE>);
-	}
+	addChild(createLazyGroup(m_context, "matrix_stride", "Matrix stride", generateBufferVariableMatrixCaseBlocks, generateBufferVariableMatrixCases<PROGRAMRESOURCEPROP_MATRIX_STRIDE>));
 
 	// .name_length
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "name_length", "Name length");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableNameLengthCases);
-	}
+	addChild(createLazyGroup(m_context, "name_length", "Name length", generateBufferVariableBufferCaseBlocks, generateBufferVariableNameLengthCases));
 
 	// .offset
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "offset", "Offset");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableOffsetCases);
-	}
+	addChild(createLazyGroup(m_context, "offset", "Offset", generateBufferVariableBufferCaseBlocks, generateBufferVariableOffsetCases));
 
 	// .referenced_by
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "referenced_by", "Referenced by");
-		addChild(blockGroup);
-		generateReferencedByShaderCaseBlocks(m_context, blockGroup, generateBufferVariableReferencedByBlockContents);
-	}
+	addChild(createLazyGroup(m_context, "referenced_by", "Referenced by", generateReferencedByShaderCaseBlocks, generateBufferVariableReferencedByBlockContents));
 
 	// .top_level_array_size
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "top_level_array_size", "Top-level array size");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableTopLevelCases<PROGRAMRESOURCEPROP_TOP_LEVEL_ARRAY_SIZE>);
-	}
+	addChild(createLazyGroup(m_context, "top_level_array_size", "Top-level array size", generateBufferVariableBufferCaseBlocks, generateBufferVariableTopLevelCases<PROGRAMRESOURCEPROP_TOP_LEVEL_ARRAY_SIZE>));
 
 	// .top_level_array_stride
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "top_level_array_stride", "Top-level array stride");
-		addChild(blockGroup);
-		generateBufferVariableBufferCaseBlocks(m_context, blockGroup, generateBufferVariableTopLevelCases<PROGRAMRESOURCEPROP_TOP_LEVEL_ARRAY_STRIDE>);
-	}
+	addChild(createLazyGroup(m_context, "top_level_array_stride", "Top-level array stride", generateBufferVariableBufferCaseBlocks, generateBufferVariableTopLevelCases<PROGRAMRESOURCEPROP_TOP_LEVEL_ARRAY_STRIDE>));
 
 	// .type
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "type", "Type");
-		addChild(blockGroup);
-		generateBufferVariableTypeBlock(m_context, blockGroup);
-	}
+	addChild(createLazyGroup(m_context, "type", "Type", generateBufferVariableTypeBlock));
 
 	// .random
-	{
-		tcu::TestCaseGroup* const blockGroup = new TestCaseGroup(m_context, "random", "Random");
-		addChild(blockGroup);
-		generateBufferVariableRandomCases(m_context, blockGroup);
-	}
+	addChild(createLazyGroup(m_context, "random", "Random", generateBufferVariableRandomCases));
 }
 
 } // anonymous
@@ -36,6 +36,7 @@
 #include "tcuVectorUtil.hpp"
 #include "tcuTexLookupVerifier.hpp"
 #include "tcuTexCompareVerifier.hpp"
+#include "tcuTiledVerifier.hpp"
 #include "tcuCommandLine.hpp"
 #include "deUniquePtr.hpp"
 #include "deStringUtil.hpp"
@@ -568,6 +569,77 @@ static bool isGatherOffsetsCompareResultValid (const tcu::TextureCubeView&		text
 	return tcu::isGatherCompareResultValid(texture, sampler, prec, coord, cmpReference, result);
 }
 
+template <typename ColorScalarType, typename PrecType, typename TexViewT, typename TexCoordT>
+class GatherOffsetsVerifier : public tcu::PixelVerifier
+{
+public:
+	typedef tcu::Vector<ColorScalarType, 4> ColorVec;
+
+	GatherOffsetsVerifier (const ConstPixelBufferAccess&	result,
+						   const TexViewT&					texture,
+						   const TexCoordT					(&texCoords)[4],
+						   const tcu::Sampler&				sampler,
+						   const PrecType&					lookupPrec,
+						   int								componentNdx,
+						   const PixelOffsets&				getPixelOffsets)
+		: m_result			(result)
+		, m_texture			(texture)
+		, m_texCoords		(texCoords)
+		, m_sampler			(sampler)
+		, m_lookupPrec		(lookupPrec)
+		, m_componentNdx	(componentNdx)
+		, m_getPixelOffsets	(getPixelOffsets)
+	{
+	}
+
+	bool isPixelValid (int px, int py) const
+	{
+		IVec2		offsets[4];
+		m_getPixelOffsets(IVec2(px, py), offsets);
+
+		const TexCoordT		texCoord		= getTexCoord(px, py);
+		const ColorVec		resultPix		= m_result.getPixelT<ColorScalarType>(px, py);
+		const ColorVec		idealPix		= gatherOffsets<ColorScalarType>(m_texture, m_sampler, texCoord, m_componentNdx, offsets);
+
+		if (tcu::boolAny(tcu::logicalAnd(m_lookupPrec.colorMask,
+										 tcu::greaterThan(tcu::absDiff(resultPix, idealPix),
+														  m_lookupPrec.colorThreshold.template cast<ColorScalarType>()))))
+			return isGatherOffsetsResultValid(m_texture, m_sampler, m_lookupPrec, texCoord, m_componentNdx, offsets, resultPix);
+		else
+			return true;
+	}
+
+	void computeIdeal (const PixelBufferAccess& ideal) const
+	{
+		for (int py = 0; py < ideal.getHeight(); py++)
+		for (int px = 0; px < ideal.getWidth(); px++)
+		{
+			IVec2 offsets[4];
+			m_getPixelOffsets(IVec2(px, py), offsets);
+
+			ideal.setPixel(gatherOffsets<ColorScalarType>(m_texture, m_sampler, getTexCoord(px, py), m_componentNdx, offsets), px, py);
+		}
+	}
+
+private:
+	TexCoordT getTexCoord (int px, int py) const
+	{
+		const int	width			= m_result.getWidth();
+		const int	height			= m_result.getWidth();
+		const Vec2	viewportCoord	= (Vec2((float)px, (float)py) + 0.5f) / Vec2((float)width, (float)height);
+
+		return triQuadInterpolate(m_texCoords, viewportCoord.x(), viewportCoord.y());
+	}
+
+	const ConstPixelBufferAccess	m_result;
+	const TexViewT&					m_texture;
+	const TexCoordT					(&m_texCoords)[4];
+	const tcu::Sampler&				m_sampler;
+	const PrecType&					m_lookupPrec;
+	const int						m_componentNdx;
+	const PixelOffsets&				m_getPixelOffsets;
+};
+
 template <typename ColorScalarType, typename PrecType, typename TexViewT, typename TexCoordT>
 static bool verifyGatherOffsets (TestLog&						log,
 								 const ConstPixelBufferAccess&	result,
@@ -578,47 +650,20 @@ static bool verifyGatherOffsets (TestLog&						log,
 								 int							componentNdx,
 								 const PixelOffsets&			getPixelOffsets)
 {
-	typedef tcu::Vector<ColorScalarType, 4> ColorVec;
-
 	const int					width			= result.getWidth();
 	const int					height			= result.getWidth();
 	tcu::TextureLevel			ideal			(result.getFormat(), width, height);
-	const PixelBufferAccess		idealAccess		= ideal.getAccess();
 	tcu::Surface				errorMask		(width, height);
-	bool						success			= true;
-
-	tcu::clear(errorMask.getAccess(), tcu::RGBA::green.toVec());
-
-	for (int py = 0; py < height; py++)
-	for (int px = 0; px < width; px++)
-	{
-		IVec2		offsets[4];
-		getPixelOffsets(IVec2(px, py), offsets);
-
-		const Vec2			viewportCoord	= (Vec2((float)px, (float)py) + 0.5f) / Vec2((float)width, (float)height);
-		const TexCoordT		texCoord		= triQuadInterpolate(texCoords, viewportCoord.x(), viewportCoord.y());
-		const ColorVec		resultPix		= result.getPixelT<ColorScalarType>(px, py);
-		const ColorVec		idealPix		= gatherOffsets<ColorScalarType>(texture, sampler, texCoord, componentNdx, offsets);
-
-		idealAccess.setPixel(idealPix, px, py);
-
-		if (tcu::boolAny(tcu::logicalAnd(lookupPrec.colorMask,
-										 tcu::greaterThan(tcu::absDiff(resultPix, idealPix),
-														  lookupPrec.colorThreshold.template cast<ColorScalarType>()))))
-		{
-			if (!isGatherOffsetsResultValid(texture, sampler, lookupPrec, texCoord, componentNdx, offsets, resultPix))
-			{
-				errorMask.setPixel(px, py, tcu::RGBA::red);
-				success = false;
-			}
-		}
-	}
+	const GatherOffsetsVerifier<ColorScalarType, PrecType, TexViewT, TexCoordT>	verifier	(result, texture, texCoords, sampler, lookupPrec, componentNdx, getPixelOffsets);
+	const bool					success			= tcu::verifyPixelsTiled(verifier, errorMask.getAccess(), gls::TextureTestUtil::MAX_VERIFY_FAILED_PIXELS, DE_NULL) == 0;
 
 	log << TestLog::ImageSet("VerifyResult", "Verification result")
 		<< TestLog::Image("Rendered", "Rendered image", result);
 
 	if (!success)
 	{
+		verifier.computeIdeal(ideal.getAccess());
+
 		log << TestLog::Image("Reference", "Ideal reference image", ideal)
 			<< TestLog::Image("ErrorMask", "Error mask", errorMask);
 	}
@@ -648,6 +693,74 @@ private:
 	IVec2 m_renderSize;
 };
 
+template <typename TexViewT, typename TexCoordT>
+class GatherOffsetsCompareVerifier : public tcu::PixelVerifier
+{
+public:
+	GatherOffsetsCompareVerifier (const ConstPixelBufferAccess&		result,
+								  const TexViewT&					texture,
+								  const TexCoordT					(&texCoords)[4],
+								  const tcu::Sampler&				sampler,
+								  const tcu::TexComparePrecision&	compPrec,
+								  const PixelCompareRefZ&			getPixelRefZ,
+								  const PixelOffsets&				getPixelOffsets)
+		: m_result			(result)
+		, m_texture			(texture)
+		, m_texCoords		(texCoords)
+		, m_sampler			(sampler)
+		, m_compPrec		(compPrec)
+		, m_getPixelRefZ	(getPixelRefZ)
+		, m_getPixelOffsets	(getPixelOffsets)
+	{
+	}
+
+	bool isPixelValid (int px, int py) const
+	{
+		IVec2		offsets[4];
+		m_getPixelOffsets(IVec2(px, py), offsets);
+
+		const TexCoordT		texCoord		= getTexCoord(px, py);
+		const float			refZ			= m_getPixelRefZ(IVec2(px, py));
+		const Vec4			resultPix		= m_result.getPixel(px, py);
+		const Vec4			idealPix		= gatherOffsetsCompare(m_texture, m_sampler, refZ, texCoord, offsets);
+
+		if (!tcu::boolAll(tcu::equal(resultPix, idealPix)))
+			return isGatherOffsetsCompareResultValid(m_texture, m_sampler, m_compPrec, texCoord, offsets, refZ, resultPix);
+		else
+			return true;
+	}
+
+	void computeIdeal (const PixelBufferAccess& ideal) const
+	{
+		for (int py = 0; py < ideal.getHeight(); py++)
+		for (int px = 0; px < ideal.getWidth(); px++)
+		{
+			IVec2 offsets[4];
+			m_getPixelOffsets(IVec2(px, py), offsets);
+
+			ideal.setPixel(gatherOffsetsCompare(m_texture, m_sampler, m_getPixelRefZ(IVec2(px, py)), getTexCoord(px, py), offsets), px, py);
+		}
+	}
+
+private:
+	TexCoordT getTexCoord (int px, int py) const
+	{
+		const int	width			= m_result.getWidth();
+		const int	height			= m_result.getWidth();
+		const Vec2	viewportCoord	= (Vec2((float)px, (float)py) + 0.5f) / Vec2((float)width, (float)height);
+
+		return triQuadInterpolate(m_texCoords, viewportCoord.x(), viewportCoord.y());
+	}
+
+	const ConstPixelBufferAccess		m_result;
+	const TexViewT&						m_texture;
+	const TexCoordT						(&m_texCoords)[4];
+	const tcu::Sampler&					m_sampler;
+	const tcu::TexComparePrecision&		m_compPrec;
+	const PixelCompareRefZ&				m_getPixelRefZ;
+	const PixelOffsets&					m_getPixelOffsets;
+};
+
 template <typename TexViewT, typename TexCoordT>
 static bool verifyGatherOffsetsCompare (TestLog&							log,
 										const ConstPixelBufferAccess&		result,
@@ -661,41 +774,17 @@ static bool verifyGatherOffsetsCompare (TestLog&							log,
 	const int					width			= result.getWidth();
 	const int					height			= result.getWidth();
 	tcu::Surface				ideal			(width, height);
-	const PixelBufferAccess		idealAccess		= ideal.getAccess();
 	tcu::Surface				errorMask		(width, height);
-	bool						success			= true;
-
-	tcu::clear(errorMask.getAccess(), tcu::RGBA::green.toVec());
-
-	for (int py = 0; py < height; py++)
-	for (int px = 0; px < width; px++)
-	{
-		IVec2		offsets[4];
-		getPixelOffsets(IVec2(px, py), offsets);
-
-		const Vec2			viewportCoord	= (Vec2((float)px, (float)py) + 0.5f) / Vec2((float)width, (float)height);
-		const TexCoordT		texCoord		= triQuadInterpolate(texCoords, viewportCoord.x(), viewportCoord.y());
-		const float			refZ			= getPixelRefZ(IVec2(px, py));
-		const Vec4			resultPix		= result.getPixel(px, py);
-		const Vec4			idealPix		= gatherOffsetsCompare(texture, sampler, refZ, texCoord, offsets);
-
-		idealAccess.setPixel(idealPix, px, py);
-
-		if (!tcu::boolAll(tcu::equal(resultPix, idealPix)))
-		{
-			if (!isGatherOffsetsCompareResultValid(texture, sampler, compPrec, texCoord, offsets, refZ, resultPix))
-			{
-				errorMask.setPixel(px, py, tcu::RGBA::red);
-				success = false;
-			}
-		}
-	}
+	const GatherOffsetsCompareVerifier<TexViewT, TexCoordT>	verifier	(result, texture, texCoords, sampler, compPrec, getPixelRefZ, getPixelOffsets);
+	const bool					success			= tcu::verifyPixelsTiled(verifier, errorMask.getAccess(), gls::TextureTestUtil::MAX_VERIFY_FAILED_PIXELS, DE_NULL) == 0;
 
 	log << TestLog::ImageSet("VerifyResult", "Verification result")
 		<< TestLog::Image("Rendered", "Rendered image", result);
 
 	if (!success)
 	{
+		verifier.computeIdeal(ideal.getAccess());
+
 		log << TestLog::Image("Reference", "Ideal reference image", ideal)
 			<< TestLog::Image("ErrorMask", "Error mask", errorMask);
 	}
@@ -23,11 +23,17 @@
 
 #include "glsShaderLibrary.hpp"
 #include "glsShaderLibraryCase.hpp"
+#include "glsShaderLibraryCache.hpp"
 #include "gluShaderUtil.hpp"
 #include "tcuResource.hpp"
+#include "tcuCommandLine.hpp"
+#include "tcuTestGroupUtil.hpp"
 #include "glwEnums.hpp"
 
 #include "deInt32.h"
+#include "deSharedPtr.hpp"
+#include "deUniquePtr.hpp"
+#include "deString.h"
 
 #include <string>
 #include <vector>
@@ -84,14 +90,14 @@ DE_INLINE deBool isCaseNameChar (char c)
 	return deInRange32(c, 'a', 'z') || deInRange32(c, 'A', 'Z') || deInRange32(c, '0', '9') || (c == '_') || (c == '-') || (c == '.');
 }
 
-// \todo [2011-02-11 pyry] Should not depend on Context or TestContext!
+//! Parses shader library source into LibraryWriter.
 class ShaderParser
 {
 public:
-							ShaderParser			(tcu::TestContext& testCtx, RenderContext& renderCtx, const glu::ContextInfo& contextInfo, const char* currentDir = DE_NULL);
+							ShaderParser			(LibraryWriter& writer, bool allowImport);
 							~ShaderParser			(void);
 
-	vector<tcu::TestNode*>	parse					(const char* input);
+	void					parse					(const char* input);
 
 private:
 	enum Token
@@ -194,28 +200,24 @@ private:
 	void						parseExpectResult			(ShaderCase::ExpectResult& expectResult);
 	void						parseGLSLVersion			(glu::GLSLVersion& version);
 	void						parsePipelineProgram		(ShaderCase::PipelineProgram& program);
-	void						parseShaderCase				(vector<tcu::TestNode*>& shaderNodeList);
-	void						parseShaderGroup			(vector<tcu::TestNode*>& shaderNodeList);
-	void						parseImport					(vector<tcu::TestNode*>& shaderNodeList);
+	void						parseShaderCase				(void);
+	void						parseShaderGroup			(void);
+	void						parseImport					(void);
 
 	// Member variables.
-	tcu::TestContext&			m_testCtx;
-	RenderContext&				m_renderCtx;
-	const glu::ContextInfo&		m_contextInfo;
+	LibraryWriter&				m_writer;
+	const bool					m_allowImport;
 	std::string					m_input;
 	const char*					m_curPtr;
 	Token						m_curToken;
 	std::string					m_curTokenStr;
-	const char* const			m_currentDir;
 };
 
-ShaderParser::ShaderParser (tcu::TestContext& testCtx, RenderContext& renderCtx, const glu::ContextInfo& contextInfo, const char* currentDir)
-	: m_testCtx			(testCtx)
-	, m_renderCtx		(renderCtx)
-	, m_contextInfo		(contextInfo)
+ShaderParser::ShaderParser (LibraryWriter& writer, bool allowImport)
+	: m_writer			(writer)
+	, m_allowImport		(allowImport)
 	, m_curPtr			(DE_NULL)
 	, m_curToken		(TOKEN_LAST)
-	, m_currentDir		(currentDir)
 {
 }
 
@@ -1121,7 +1123,7 @@ void ShaderParser::parsePipelineProgram (ShaderCase::PipelineProgram& program)
 	program.geometrySources.swap(geometrySources);
 }
 
-void ShaderParser::parseShaderCase (vector<tcu::TestNode*>& shaderNodeList)
+void ShaderParser::parseShaderCase (void)
 {
 	// Parse 'case'.
 	PARSE_DBG(("  parseShaderCase()\n"));
@@ -1241,7 +1243,7 @@ void ShaderParser::parseShaderCase (vector<tcu::TestNode*>& shaderNodeList)
 			ShaderCase::ShaderCaseSpecification spec = ShaderCase::ShaderCaseSpecification::generateSharedSourceVertexCase(expectResult, version, valueBlockList, bothSource);
 			spec.requirements = requirements;
 
-			shaderNodeList.push_back(new ShaderCase(m_testCtx, m_renderCtx, m_contextInfo, (caseName + "_vertex").c_str(), description.c_str(), spec));
+			m_writer.addCase(caseName + "_vertex", description, spec);
 		}
 
 		// fragment
@@ -1249,7 +1251,7 @@ void ShaderParser::parseShaderCase (vector<tcu::TestNode*>& shaderNodeList)
 			ShaderCase::ShaderCaseSpecification spec = ShaderCase::ShaderCaseSpecification::generateSharedSourceFragmentCase(expectResult, version, valueBlockList, bothSource);
 			spec.requirements = requirements;
 
-			shaderNodeList.push_back(new ShaderCase(m_testCtx, m_renderCtx, m_contextInfo, (caseName + "_fragment").c_str(), description.c_str(), spec));
+			m_writer.addCase(caseName + "_fragment", description, spec);
 		}
 	}
 	else if (pipelinePrograms.empty())
@@ -1267,7 +1269,7 @@ void ShaderParser::parseShaderCase (vector<tcu::TestNode*>& shaderNodeList)
 		spec.tessEvalSources.swap(tessellationEvalSources);
 		spec.geometrySources.swap(geometrySources);
 
-		shaderNodeList.push_back(new ShaderCase(m_testCtx, m_renderCtx, m_contextInfo, caseName.c_str(), description.c_str(), spec));
+		m_writer.addCase(caseName, description, spec);
 	}
 	else
 	{
@@ -1290,12 +1292,12 @@ void ShaderParser::parseShaderCase (vector<tcu::TestNode*>& shaderNodeList)
 			spec.valueBlocks.swap(valueBlockList);
 			spec.programs.swap(pipelinePrograms);
 
-			shaderNodeList.push_back(new ShaderCase(m_testCtx, m_renderCtx, m_contextInfo, caseName.c_str(), description.c_str(), spec));
+			m_writer.addCase(caseName, description, spec);
 		}
 	}
 }
 
-void ShaderParser::parseShaderGroup (vector<tcu::TestNode*>& shaderNodeList)
+void ShaderParser::parseShaderGroup (void)
 {
 	// Parse 'case'.
 	PARSE_DBG(("  parseShaderGroup()\n"));
@@ -1310,7 +1312,7 @@ void ShaderParser::parseShaderGroup (vector<tcu::TestNode*>& shaderNodeList)
 	string description = parseStringLiteral(m_curTokenStr.c_str());
 	advanceToken(TOKEN_STRING);
 
-	std::vector<tcu::TestNode*> children;
+	m_writer.beginGroup(name, description);
 
 	// Parse group children.
 	for (;;)
@@ -1318,42 +1320,34 @@ void ShaderParser::parseShaderGroup (vector<tcu::TestNode*>& shaderNodeList)
 		if (m_curToken == TOKEN_END)
 			break;
 		else if (m_curToken == TOKEN_GROUP)
-			parseShaderGroup(children);
+			parseShaderGroup();
 		else if (m_curToken == TOKEN_CASE)
-			parseShaderCase(children);
+			parseShaderCase();
 		else if (m_curToken == TOKEN_IMPORT)
-			parseImport(children);
+			parseImport();
 		else
 			parseError(string("unexpected token while parsing shader group: " + m_curTokenStr));
 	}
 
 	advanceToken(TOKEN_END); // group end
 
-	// Create group node.
-	tcu::TestCaseGroup* groupNode = new tcu::TestCaseGroup(m_testCtx, name.c_str(), description.c_str(), children);
-	shaderNodeList.push_back(groupNode);
+	m_writer.endGroup();
 }
 
-void ShaderParser::parseImport (vector<tcu::TestNode*>& shaderNodeList)
+void ShaderParser::parseImport (void)
 {
-	ShaderLibrary			subLibrary		(m_testCtx, m_renderCtx, m_contextInfo);
-	vector<tcu::TestNode*>	importedCases;
-	std::string				filename;
-
-	if (!m_currentDir)
+	if (!m_allowImport)
 		parseError(string("cannot use import in inline shader source"));
 
 	advanceToken(TOKEN_IMPORT);
 
+	// \note Imported file is loaded when test nodes are created.
 	assumeToken(TOKEN_STRING);
-	filename = m_currentDir + parseStringLiteral(m_curTokenStr.c_str());
+	m_writer.addImport(parseStringLiteral(m_curTokenStr.c_str()));
 	advanceToken(TOKEN_STRING);
-
-	importedCases = subLibrary.loadShaderFile(filename.c_str());
-	shaderNodeList.insert(shaderNodeList.end(), importedCases.begin(), importedCases.end());
 }
 
-vector<tcu::TestNode*> ShaderParser::parse (const char* input)
+void ShaderParser::parse (const char* input)
 {
 	// Initialize parser.
 	m_input			= input;
@@ -1362,18 +1356,16 @@ vector<tcu::TestNode*> ShaderParser::parse (const char* input)
 	m_curTokenStr	= "";
 	advanceToken();
 
-	vector<tcu::TestNode*> nodeList;
-
 	// Parse all cases.
 	PARSE_DBG(("parse()\n"));
 	for (;;)
 	{
 		if (m_curToken == TOKEN_CASE)
-			parseShaderCase(nodeList);
+			parseShaderCase();
 		else if (m_curToken == TOKEN_GROUP)
-			parseShaderGroup(nodeList);
+			parseShaderGroup();
 		else if (m_curToken == TOKEN_IMPORT)
-			parseImport(nodeList);
+			parseImport();
 		else if (m_curToken == TOKEN_EOF)
 			break;
 		else
@@ -1381,8 +1373,212 @@ vector<tcu::TestNode*> ShaderParser::parse (const char* input)
 	}
 
 	assumeToken(TOKEN_EOF);
-//	printf("  parsed %d test cases.\n", caseList.size());
-	return nodeList;
+}
+
+// Test node creation
+
+struct LibraryGroupRef
+{
+	tcu::TestContext*					testCtx;
+	glu::RenderContext*					renderCtx;
+	const glu::ContextInfo*				contextInfo;
+	de::SharedPtr<const LibraryData>	data;
+	std::string							directory;		//!< Directory of library file, for resolving imports.
+	deUint32							offset;
+
+	LibraryGroupRef (void) : testCtx(DE_NULL), renderCtx(DE_NULL), contextInfo(DE_NULL), offset(0) {}
+};
+
+static void createLibraryGroupChildren (tcu::TestCaseGroup* group, LibraryGroupRef ref);
+
+static void createLibraryNodes (const LibraryGroupRef& group, vector<tcu::TestNode*>& dst)
+{
+	const LibraryData&	data		= *group.data;
+	const int			numChildren	= data.getNumChildren(group.offset);
+
+	for (int childNdx = 0; childNdx < numChildren; childNdx++)
+	{
+		const deUint32	childOffset	= data.getChildOffset(group.offset, childNdx);
+		string			name;
+		string			description;
+
+		switch (data.getNodeType(childOffset))
+		{
+			case LIBRARYNODETYPE_GROUP:
+			{
+				LibraryGroupRef childRef = group;
+				childRef.offset = childOffset;
+
+				// Children are created only when executor enters the group.
+				data.readGroup(childOffset, name, description);
+				dst.push_back(tcu::createTestGroup(*group.testCtx, name, description, createLibraryGroupChildren, childRef));
+				break;
+			}
+
+			case LIBRARYNODETYPE_CASE:
+			{
+				ShaderCase::ShaderCaseSpecification spec;
+				data.readCase(childOffset, name, description, spec);
+				dst.push_back(new ShaderCase(*group.testCtx, *group.renderCtx, *group.contextInfo, name.c_str(), description.c_str(), spec));
+				break;
+			}
+
+			case LIBRARYNODETYPE_PIPELINE_CASE:
+			{
+				ShaderCase::PipelineCaseSpecification spec;
+				data.readCase(childOffset, name, description, spec);
+				dst.push_back(new ShaderCase(*group.testCtx, *group.renderCtx, *group.contextInfo, name.c_str(), description.c_str(), spec));
+				break;
+			}
+
+			case LIBRARYNODETYPE_IMPORT:
+			{
+				ShaderLibrary			subLibrary		(*group.testCtx, *group.renderCtx, *group.contextInfo);
+				vector<tcu::TestNode*>	importedNodes;
+
+				data.readImport(childOffset, name);
+				importedNodes = subLibrary.loadShaderFile((group.directory + name).c_str());
+				dst.insert(dst.end(), importedNodes.begin(), importedNodes.end());
+				break;
+			}
+
+			default:
+				DE_ASSERT(false);
+		}
+	}
+}
+
+static vector<tcu::TestNode*> createLibraryNodes (const LibraryGroupRef& group)
+{
+	vector<tcu::TestNode*> nodes;
+
+	try
+	{
+		createLibraryNodes(group, nodes);
+	}
+	catch (...)
+	{
+		for (vector<tcu::TestNode*>::iterator node = nodes.begin(); node != nodes.end(); ++node)
+			delete *node;
+		throw;
+	}
+
+	return nodes;
+}
+
+static void createLibraryGroupChildren (tcu::TestCaseGroup* group, LibraryGroupRef ref)
+{
+	const vector<tcu::TestNode*> children = createLibraryNodes(ref);
+
+	for (int ndx = 0; ndx < (int)children.size(); ndx++)
+		group->addChild(children[ndx]);
+}
+
+static LibraryData* parseLibrary (const char* source, deUint64 sourceSize, deUint64 sourceHash, bool allowImport)
+{
+	LibraryWriter			writer;
+	ShaderParser			parser		(writer, allowImport);
+	std::vector<deUint8>	data;
+
+	parser.parse(source);
+	writer.finish(sourceSize, sourceHash, data);
+
+	return new LibraryData(data);
+}
+
+static std::string getCacheFilename (const char* cacheDir, deUint64 sourceHash)
+{
+	char hashStr[17];
+	deSprintf(hashStr, sizeof(hashStr), "%08x%08x", (deUint32)(sourceHash >> 32), (deUint32)sourceHash);
+	return std::string(cacheDir) + "/" + hashStr + ".slcache";
+}
+
+//! Load parsed library from cache, or parse it and update cache. Cache is not used if cacheDir is null.
+static LibraryData* loadLibrary (const char* source, size_t sourceSize, const char* cacheDir)
+{
+	const deUint64				sourceHash	= computeLibrarySourceHash(source, sourceSize);
+	de::MovePtr<LibraryData>	data;
+
+	// Parsed library is cached by source content; stale or invalid cache files are ignored.
+	if (cacheDir)
+		data = de::MovePtr<LibraryData>(LibraryData::loadCacheFile(getCacheFilename(cacheDir, sourceHash).c_str(), (deUint64)sourceSize, sourceHash));
+
+	if (!data)
+	{
+		data = de::MovePtr<LibraryData>(parseLibrary(source, (deUint64)sourceSize, sourceHash, true));
+
+		if (cacheDir)
+			data->writeCacheFile(getCacheFilename(cacheDir, sourceHash).c_str());
+	}
+
+	return data.release();
+}
+
+//! Append one line per node to dst, describing node path, type and contents.
+static void dumpLibraryNodes (const LibraryData& data, deUint32 groupOffset, const string& pathPrefix, vector<string>& dst)
+{
+	const int numChildren = data.getNumChildren(groupOffset);
+
+	for (int childNdx = 0; childNdx < numChildren; childNdx++)
+	{
+		const deUint32		childOffset	= data.getChildOffset(groupOffset, childNdx);
+		string				name;
+		string				description;
+		ostringstream		line;
+
+		switch (data.getNodeType(childOffset))
+		{
+			case LIBRARYNODETYPE_GROUP:
+				data.readGroup(childOffset, name, description);
+				line << "group " << pathPrefix << name << " \"" << description << "\"";
+				dst.push_back(line.str());
+				dumpLibraryNodes(data, childOffset, pathPrefix + name + ".", dst);
+				break;
+
+			case LIBRARYNODETYPE_CASE:
+			{
+				ShaderCase::ShaderCaseSpecification spec;
+				data.readCase(childOffset, name, description, spec);
+				line << "case " << pathPrefix << name << " \"" << description << "\""
+					 << " expect=" << spec.expectResult << " type=" << spec.caseType << " version=" << spec.targetVersion
+					 << " requirements=" << spec.requirements.size() << " blocks=" << spec.valueBlocks.size();
+
+				for (int ndx = 0; ndx < (int)spec.vertexSources.size(); ndx++)
+					line << "\nvertex:\n" << spec.vertexSources[ndx];
+				for (int ndx = 0; ndx < (int)spec.fragmentSources.size(); ndx++)
+					line << "\nfragment:\n" << spec.fragmentSources[ndx];
+
+				dst.push_back(line.str());
+				break;
+			}
+
+			case LIBRARYNODETYPE_PIPELINE_CASE:
+			{
+				ShaderCase::PipelineCaseSpecification spec;
+				data.readCase(childOffset, name, description, spec);
+				line << "pipeline_case " << pathPrefix << name << " \"" << description << "\""
+					 << " expect=" << spec.expectResult << " version=" << spec.targetVersion << " programs=" << spec.programs.size();
+				dst.push_back(line.str());
+				break;
+			}
+
+			case LIBRARYNODETYPE_IMPORT:
+				data.readImport(childOffset, name);
+				line << "import " << pathPrefix << name;
+				dst.push_back(line.str());
+				break;
+
+			default:
+				DE_TEST_ASSERT(false);
+		}
+	}
+}
+
+static vector<string> dumpLibrary (const LibraryData& data)
+{
+	vector<string> lines;
+	dumpLibraryNodes(data, data.getRootOffset(), "", lines);
+	return lines;
 }
 
 } // sl
@@ -1411,14 +1607,15 @@ ShaderLibrary::~ShaderLibrary (void)
 vector<tcu::TestNode*> ShaderLibrary::loadShaderFile (const char* fileName)
 {
 	tcu::Resource*		resource		= m_testCtx.getArchive().getResource(fileName);
-	std::string			fileDirectory	= getFileDirectory(fileName);
+	const char* const	cacheDir		= m_testCtx.getCommandLine().getShaderLibraryCacheDir();
 	std::vector<char>	buf;
+	int					size			= 0;
 
 /*	printf("  loading '%s'\n", fileName);*/
 
 	try
 	{
-		int size = resource->getSize();
+		size = resource->getSize();
 		buf.resize(size + 1);
 		resource->read((deUint8*)&buf[0], size);
 		buf[size] = '\0';
@@ -1431,18 +1628,110 @@ vector<tcu::TestNode*> ShaderLibrary::loadShaderFile (const char* fileName)
 
 	delete resource;
 
-	sl::ShaderParser parser(m_testCtx, m_renderCtx, m_contextInfo, fileDirectory.c_str());
-	vector<tcu::TestNode*> nodes = parser.parse(&buf[0]);
+	{
+		sl::LibraryGroupRef root;
+
+		root.testCtx		= &m_testCtx;
+		root.renderCtx		= &m_renderCtx;
+		root.contextInfo	= &m_contextInfo;
+		root.data			= de::SharedPtr<const sl::LibraryData>(sl::loadLibrary(&buf[0], (size_t)size, cacheDir));
+		root.offset			= root.data->getRootOffset();
+		root.directory		= getFileDirectory(fileName);
 
-	return nodes;
+		return sl::createLibraryNodes(root);
+	}
 }
 
 vector<tcu::TestNode*> ShaderLibrary::parseShader (const char* shaderSource)
 {
-	sl::ShaderParser parser(m_testCtx, m_renderCtx, m_contextInfo);
-	vector<tcu::TestNode*> nodes = parser.parse(shaderSource);
+	const size_t		size	= strlen(shaderSource);
+	sl::LibraryGroupRef	root;
 
-	return nodes;
+	root.testCtx		= &m_testCtx;
+	root.renderCtx		= &m_renderCtx;
+	root.contextInfo	= &m_contextInfo;
+	root.data			= de::SharedPtr<const sl::LibraryData>(sl::parseLibrary(shaderSource, (deUint64)size, sl::computeLibrarySourceHash(shaderSource, size), false));
+	root.offset			= root.data->getRootOffset();
+
+	return sl::createLibraryNodes(root);
+}
+
+void ShaderLibrary_selfTest (void)
+{
+	static const char* const s_source =
+		"group basic \"Basic cases\"\n"
+		"	case complete\n"
+		"		version 300 es\n"
+		"		desc \"Complete case\"\n"
+		"		values\n"
+		"		{\n"
+		"			input float in0 = [ 0.5 | -1.0 ];\n"
+		"			output float out0 = [ 1.0 | -2.0 ];\n"
+		"		}\n"
+		"		vertex \"\"\n"
+		"			#version 300 es\n"
+		"			${VERTEX_DECLARATIONS}\n"
+		"			void main() { ${VERTEX_OUTPUT} }\n"
+		"		\"\"\n"
+		"		fragment \"\"\n"
+		"			#version 300 es\n"
+		"			${FRAGMENT_DECLARATIONS}\n"
+		"			void main() { out0 = 2.0 * in0; ${FRAGMENT_OUTPUT} }\n"
+		"		\"\"\n"
+		"	end\n"
+		"	group nested \"Nested group\"\n"
+		"		case both\n"
+		"			version 300 es\n"
+		"			expect compile_fail\n"
+		"			both \"\"\n"
+		"				#version 300 es\n"
+		"				${DECLARATIONS}\n"
+		"				void main() { invalid; }\n"
+		"			\"\"\n"
+		"		end\n"
+		"	end\n"
+		"end\n"
+		"import \"imported.test\"\n";
+	static const char* const	s_cacheDir	= ".";
+
+	const size_t			sourceSize		= strlen(s_source);
+	const std::string		cacheFilename	= sl::getCacheFilename(s_cacheDir, sl::computeLibrarySourceHash(s_source, sourceSize));
+	vector<std::string>		uncachedDump;
+	vector<std::string>		coldDump;
+	vector<std::string>		warmDump;
+
+	deDeleteFile(cacheFilename.c_str());
+
+	{
+		const de::UniquePtr<sl::LibraryData> uncached (sl::loadLibrary(s_source, sourceSize, DE_NULL));
+		uncachedDump = sl::dumpLibrary(*uncached);
+		DE_TEST_ASSERT(!deFileExists(cacheFilename.c_str()));
+	}
+
+	// Cold cache: library is parsed and cache file is written.
+	{
+		const de::UniquePtr<sl::LibraryData> cold (sl::loadLibrary(s_source, sourceSize, s_cacheDir));
+		coldDump = sl::dumpLibrary(*cold);
+	}
+
+	DE_TEST_ASSERT(deFileExists(cacheFilename.c_str()));
+
+	// Warm cache: library is loaded from cache file.
+	{
+		const de::UniquePtr<sl::LibraryData> cached (sl::LibraryData::loadCacheFile(cacheFilename.c_str(), (deUint64)sourceSize, sl::computeLibrarySourceHash(s_source, sourceSize)));
+		DE_TEST_ASSERT(cached.get() != DE_NULL);
+	}
+
+	{
+		const de::UniquePtr<sl::LibraryData> warm (sl::loadLibrary(s_source, sourceSize, s_cacheDir));
+		warmDump = sl::dumpLibrary(*warm);
+	}
+
+	DE_TEST_ASSERT(uncachedDump.size() == 6);
+	DE_TEST_ASSERT(coldDump == uncachedDump);
+	DE_TEST_ASSERT(warmDump == coldDump);
+
+	DE_TEST_ASSERT(deDeleteFile(cacheFilename.c_str()));
 }
 
 } // gls
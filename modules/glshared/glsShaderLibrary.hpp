@@ -54,6 +54,8 @@ private:
 	const glu::ContextInfo&		m_contextInfo;
 };
 
+void		ShaderLibrary_selfTest		(void);
+
 } // gls
 } // deqp
 
@@ -0,0 +1,871 @@
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program OpenGL (ES) Module
+ * -----------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Binary form of parsed shader library files.
+ *//*--------------------------------------------------------------------*/
+
+#include "glsShaderLibraryCache.hpp"
+#include "tcuDefs.hpp"
+#include "deClock.h"
+#include "deMemory.h"
+#include "deStringUtil.hpp"
+#include "deUniquePtr.hpp"
+
+#include <cstdio>
+
+using std::string;
+using std::vector;
+
+namespace deqp
+{
+namespace gls
+{
+namespace sl
+{
+
+enum
+{
+	// \note Bump version whenever parser output or encoding changes.
+	LIBRARY_DATA_VERSION	= 1,
+
+	MAGIC_SIZE				= 8,
+	OFFSET_VERSION			= 8,
+	OFFSET_ROOT				= 12,
+	OFFSET_SOURCE_SIZE		= 16,
+	OFFSET_SOURCE_HASH		= 24,
+	OFFSET_DATA_HASH		= 32,
+	HEADER_SIZE				= 40
+};
+
+static const char s_magic[MAGIC_SIZE] = { 'd', 'e', 's', 'l', 'i', 'b', 0, 0 };
+
+// 64-bit FNV-1a
+static deUint64 computeHash (const deUint8* data, size_t size)
+{
+	deUint64 hash = 0xcbf29ce484222325ull;
+
+	for (size_t ndx = 0; ndx < size; ndx++)
+	{
+		hash ^= data[ndx];
+		hash *= 0x100000001b3ull;
+	}
+
+	return hash;
+}
+
+deUint64 computeLibrarySourceHash (const void* data, size_t size)
+{
+	return computeHash((const deUint8*)data, size);
+}
+
+// Encoding
+
+static void setUint32 (deUint8* dst, deUint32 value)
+{
+	for (int ndx = 0; ndx < 4; ndx++)
+		dst[ndx] = (deUint8)(value >> (8*ndx));
+}
+
+static void setUint64 (deUint8* dst, deUint64 value)
+{
+	for (int ndx = 0; ndx < 8; ndx++)
+		dst[ndx] = (deUint8)(value >> (8*ndx));
+}
+
+static void writeUint8 (vector<deUint8>& dst, deUint8 value)
+{
+	dst.push_back(value);
+}
+
+static void writeUint32 (vector<deUint8>& dst, deUint32 value)
+{
+	const size_t offset = dst.size();
+	dst.resize(offset + 4);
+	setUint32(&dst[offset], value);
+}
+
+static void writeInt32 (vector<deUint8>& dst, deInt32 value)
+{
+	writeUint32(dst, (deUint32)value);
+}
+
+static void writeString (vector<deUint8>& dst, const string& str)
+{
+	writeUint32(dst, (deUint32)str.size());
+	dst.insert(dst.end(), str.begin(), str.end());
+}
+
+static void writeStringList (vector<deUint8>& dst, const vector<string>& list)
+{
+	writeUint32(dst, (deUint32)list.size());
+	for (vector<string>::const_iterator str = list.begin(); str != list.end(); ++str)
+		writeString(dst, *str);
+}
+
+static void writeRequirements (vector<deUint8>& dst, const vector<ShaderCase::CaseRequirement>& requirements)
+{
+	writeUint32(dst, (deUint32)requirements.size());
+
+	for (vector<ShaderCase::CaseRequirement>::const_iterator req = requirements.begin(); req != requirements.end(); ++req)
+	{
+		writeUint8(dst, (deUint8)req->getType());
+
+		if (req->getType() == ShaderCase::CaseRequirement::REQUIREMENTTYPE_EXTENSION)
+		{
+			writeStringList(dst, req->getExtensions());
+			writeUint32(dst, req->getAffectedExtensionStageFlags());
+		}
+		else
+		{
+			DE_ASSERT(req->getType() == ShaderCase::CaseRequirement::REQUIREMENTTYPE_IMPLEMENTATION_LIMIT);
+			writeUint32(dst, req->getLimitEnumName());
+			writeInt32(dst, req->getLimitReferenceValue());
+		}
+	}
+}
+
+static void writeValueBlocks (vector<deUint8>& dst, const vector<ShaderCase::ValueBlock>& valueBlocks)
+{
+	writeUint32(dst, (deUint32)valueBlocks.size());
+
+	for (vector<ShaderCase::ValueBlock>::const_iterator block = valueBlocks.begin(); block != valueBlocks.end(); ++block)
+	{
+		writeInt32(dst, block->arrayLength);
+		writeUint32(dst, (deUint32)block->values.size());
+
+		for (vector<ShaderCase::Value>::const_iterator value = block->values.begin(); value != block->values.end(); ++value)
+		{
+			writeUint8(dst, (deUint8)value->storageType);
+			writeString(dst, value->valueName);
+			writeUint32(dst, (deUint32)value->dataType);
+			writeInt32(dst, value->arrayLength);
+			writeUint32(dst, (deUint32)value->elements.size());
+
+			for (vector<ShaderCase::Value::Element>::const_iterator elem = value->elements.begin(); elem != value->elements.end(); ++elem)
+			{
+				deUint32 bits;
+				DE_STATIC_ASSERT(sizeof(bits) == sizeof(ShaderCase::Value::Element));
+				deMemcpy(&bits, &*elem, sizeof(bits));
+				writeUint32(dst, bits);
+			}
+		}
+	}
+}
+
+static void writeNodeHeader (vector<deUint8>& dst, LibraryNodeType type, const string& name, const string& description)
+{
+	writeUint8(dst, (deUint8)type);
+	writeString(dst, name);
+	writeString(dst, description);
+}
+
+LibraryWriter::LibraryWriter (void)
+	: m_data	(HEADER_SIZE, 0)
+	, m_groups	(1)
+{
+}
+
+LibraryWriter::~LibraryWriter (void)
+{
+}
+
+void LibraryWriter::addChildOffset (void)
+{
+	DE_ASSERT(!m_groups.empty());
+	m_groups.back().childOffsets.push_back((deUint32)m_data.size());
+}
+
+void LibraryWriter::writeGroup (const OpenGroup& group)
+{
+	writeNodeHeader(m_data, LIBRARYNODETYPE_GROUP, group.name, group.description);
+	writeUint32(m_data, (deUint32)group.childOffsets.size());
+
+	for (vector<deUint32>::const_iterator offset = group.childOffsets.begin(); offset != group.childOffsets.end(); ++offset)
+		writeUint32(m_data, *offset);
+}
+
+void LibraryWriter::beginGroup (const string& name, const string& description)
+{
+	m_groups.push_back(OpenGroup());
+	m_groups.back().name		= name;
+	m_groups.back().description	= description;
+}
+
+void LibraryWriter::endGroup (void)
+{
+	OpenGroup group;
+
+	DE_ASSERT(m_groups.size() > 1);
+
+	std::swap(group.name, m_groups.back().name);
+	std::swap(group.description, m_groups.back().description);
+	std::swap(group.childOffsets, m_groups.back().childOffsets);
+	m_groups.pop_back();
+
+	addChildOffset();
+	writeGroup(group);
+}
+
+void LibraryWriter::addCase (const string& name, const string& description, const ShaderCase::ShaderCaseSpecification& spec)
+{
+	addChildOffset();
+	writeNodeHeader(m_data, LIBRARYNODETYPE_CASE, name, description);
+
+	writeUint8(m_data, (deUint8)spec.expectResult);
+	writeUint8(m_data, (deUint8)spec.caseType);
+	writeUint32(m_data, (deUint32)spec.targetVersion);
+	writeRequirements(m_data, spec.requirements);
+	writeValueBlocks(m_data, spec.valueBlocks);
+	writeStringList(m_data, spec.vertexSources);
+	writeStringList(m_data, spec.fragmentSources);
+	writeStringList(m_data, spec.tessCtrlSources);
+	writeStringList(m_data, spec.tessEvalSources);
+	writeStringList(m_data, spec.geometrySources);
+}
+
+void LibraryWriter::addCase (const string& name, const string& description, const ShaderCase::PipelineCaseSpecification& spec)
+{
+	addChildOffset();
+	writeNodeHeader(m_data, LIBRARYNODETYPE_PIPELINE_CASE, name, description);
+
+	writeUint8(m_data, (deUint8)spec.expectResult);
+	writeUint8(m_data, (deUint8)spec.caseType);
+	writeUint32(m_data, (deUint32)spec.targetVersion);
+	writeValueBlocks(m_data, spec.valueBlocks);
+	writeUint32(m_data, (deUint32)spec.programs.size());
+
+	for (vector<ShaderCase::PipelineProgram>::const_iterator program = spec.programs.begin(); program != spec.programs.end(); ++program)
+	{
+		writeUint32(m_data, program->activeStageBits);
+		writeRequirements(m_data, program->requirements);
+		writeStringList(m_data, program->vertexSources);
+		writeStringList(m_data, program->fragmentSources);
+		writeStringList(m_data, program->tessCtrlSources);
+		writeStringList(m_data, program->tessEvalSources);
+		writeStringList(m_data, program->geometrySources);
+	}
+}
+
+void LibraryWriter::addImport (const string& filename)
+{
+	addChildOffset();
+	writeNodeHeader(m_data, LIBRARYNODETYPE_IMPORT, filename, "");
+}
+
+void LibraryWriter::finish (deUint64 sourceSize, deUint64 sourceHash, vector<deUint8>& dst)
+{
+	DE_ASSERT(m_groups.size() == 1);
+
+	const deUint32 rootOffset = (deUint32)m_data.size();
+
+	writeGroup(m_groups.back());
+	m_groups.clear();
+
+	deMemcpy(&m_data[0], s_magic, MAGIC_SIZE);
+	setUint32(&m_data[OFFSET_VERSION], LIBRARY_DATA_VERSION);
+	setUint32(&m_data[OFFSET_ROOT], rootOffset);
+	setUint64(&m_data[OFFSET_SOURCE_SIZE], sourceSize);
+	setUint64(&m_data[OFFSET_SOURCE_HASH], sourceHash);
+	setUint64(&m_data[OFFSET_DATA_HASH], computeHash(&m_data[HEADER_SIZE], m_data.size() - HEADER_SIZE));
+
+	dst.swap(m_data);
+	m_data.clear();
+}
+
+// Decoding
+
+static deUint32 getUint32 (const deUint8* src)
+{
+	return (deUint32)src[0] | ((deUint32)src[1] << 8) | ((deUint32)src[2] << 16) | ((deUint32)src[3] << 24);
+}
+
+static deUint64 getUint64 (const deUint8* src)
+{
+	return (deUint64)getUint32(src) | ((deUint64)getUint32(src+4) << 32);
+}
+
+namespace
+{
+
+class DataReader
+{
+public:
+	DataReader (const deUint8* data, size_t size, deUint32 offset)
+		: m_data	(data)
+		, m_size	(size)
+		, m_pos		(offset)
+	{
+	}
+
+	deUint8 readUint8 (void)
+	{
+		check(1);
+		return m_data[m_pos++];
+	}
+
+	deUint32 readUint32 (void)
+	{
+		check(4);
+		m_pos += 4;
+		return getUint32(&m_data[m_pos-4]);
+	}
+
+	deInt32 readInt32 (void)
+	{
+		return (deInt32)readUint32();
+	}
+
+	void readString (string& dst)
+	{
+		const deUint32 len = readUint32();
+		check(len);
+		dst.assign((const char*)&m_data[m_pos], (size_t)len);
+		m_pos += len;
+	}
+
+	void skipString (void)
+	{
+		const deUint32 len = readUint32();
+		check(len);
+		m_pos += len;
+	}
+
+	void readStringList (vector<string>& dst)
+	{
+		const deUint32 count = readUint32();
+		check((size_t)count*4);	// Each string has at least length.
+		dst.resize(count);
+		for (deUint32 ndx = 0; ndx < count; ndx++)
+			readString(dst[ndx]);
+	}
+
+private:
+	void check (size_t numBytes) const
+	{
+		if (numBytes > m_size - m_pos)
+			throw tcu::InternalError("Invalid shader library data", "", __FILE__, __LINE__);
+	}
+
+	const deUint8* const	m_data;
+	const size_t			m_size;
+	size_t					m_pos;
+};
+
+} // anonymous
+
+static void readRequirements (DataReader& reader, vector<ShaderCase::CaseRequirement>& dst)
+{
+	const deUint32 count = reader.readUint32();
+
+	dst.resize(count);
+
+	for (deUint32 ndx = 0; ndx < count; ndx++)
+	{
+		const deUint8 type = reader.readUint8();
+
+		if (type == ShaderCase::CaseRequirement::REQUIREMENTTYPE_EXTENSION)
+		{
+			vector<string>	extensions;
+			deUint32		stageFlags;
+
+			reader.readStringList(extensions);
+			stageFlags = reader.readUint32();
+
+			dst[ndx] = ShaderCase::CaseRequirement::createAnyExtensionRequirement(extensions, stageFlags);
+		}
+		else if (type == ShaderCase::CaseRequirement::REQUIREMENTTYPE_IMPLEMENTATION_LIMIT)
+		{
+			const deUint32	enumName	= reader.readUint32();
+			const int		refValue	= reader.readInt32();
+
+			dst[ndx] = ShaderCase::CaseRequirement::createLimitRequirement(enumName, refValue);
+		}
+		else
+			throw tcu::InternalError("Invalid shader library data", "", __FILE__, __LINE__);
+	}
+}
+
+static void readValueBlocks (DataReader& reader, vector<ShaderCase::ValueBlock>& dst)
+{
+	const deUint32 numBlocks = reader.readUint32();
+
+	dst.resize(numBlocks);
+
+	for (deUint32 blockNdx = 0; blockNdx < numBlocks; blockNdx++)
+	{
+		ShaderCase::ValueBlock&	block		= dst[blockNdx];
+		deUint32				numValues;
+
+		block.arrayLength	= reader.readInt32();
+		numValues			= reader.readUint32();
+		block.values.resize(numValues);
+
+		for (deUint32 valueNdx = 0; valueNdx < numValues; valueNdx++)
+		{
+			ShaderCase::Value&	value		= block.values[valueNdx];
+			deUint32			numElements;
+
+			value.storageType	= (ShaderCase::Value::StorageType)reader.readUint8();
+			reader.readString(value.valueName);
+			value.dataType		= (glu::DataType)reader.readUint32();
+			value.arrayLength	= reader.readInt32();
+			numElements			= reader.readUint32();
+			value.elements.resize(numElements);
+
+			for (deUint32 elemNdx = 0; elemNdx < numElements; elemNdx++)
+			{
+				const deUint32 bits = reader.readUint32();
+				deMemcpy(&value.elements[elemNdx], &bits, sizeof(bits));
+			}
+		}
+	}
+}
+
+static void readNodeHeader (DataReader& reader, LibraryNodeType expectedType, string& name, string& description)
+{
+	if (reader.readUint8() != (deUint8)expectedType)
+		throw tcu::InternalError("Invalid shader library data", "", __FILE__, __LINE__);
+
+	reader.readString(name);
+	reader.readString(description);
+}
+
+LibraryData::LibraryData (vector<deUint8>& data)
+	: m_mapping	(DE_NULL)
+	, m_data	(DE_NULL)
+	, m_size	(0)
+{
+	m_buffer.swap(data);
+	m_data	= m_buffer.empty() ? DE_NULL : &m_buffer[0];
+	m_size	= m_buffer.size();
+}
+
+LibraryData::LibraryData (deFileMapping* mapping)
+	: m_mapping	(mapping)
+	, m_data	((const deUint8*)deFileMapping_getData(mapping))
+	, m_size	((size_t)deFileMapping_getSize(mapping))
+{
+}
+
+LibraryData::~LibraryData (void)
+{
+	if (m_mapping)
+		deFileMapping_destroy(m_mapping);
+}
+
+LibraryData* LibraryData::loadCacheFile (const char* filename, deUint64 sourceSize, deUint64 sourceHash)
+{
+	deFile*				file	= deFile_create(filename, DE_FILEMODE_OPEN|DE_FILEMODE_READ);
+	deFileMapping*		mapping	= DE_NULL;
+	LibraryData*		data	= DE_NULL;
+
+	if (!file)
+		return DE_NULL;
+
+	mapping = deFileMapping_create(file);
+	deFile_destroy(file);
+
+	if (!mapping)
+		return DE_NULL;
+
+	try
+	{
+		data = new LibraryData(mapping);
+	}
+	catch (...)
+	{
+		deFileMapping_destroy(mapping);
+		throw;
+	}
+
+	if (!data->isValid(sourceSize, sourceHash))
+	{
+		delete data;
+		return DE_NULL;
+	}
+
+	return data;
+}
+
+void LibraryData::writeCacheFile (const char* filename) const
+{
+	// Write to temporary file first so that concurrent readers never see partial file. Temporary
+	// file is created exclusively so that concurrent writers can never share it even if names collide.
+	const int		maxAttempts		= 8;
+	const deUint64	timestamp		= deGetMicroseconds();
+	string			tmpFilename;
+	deFile*			file			= DE_NULL;
+	size_t			numWritten		= 0;
+
+	for (int attemptNdx = 0; attemptNdx < maxAttempts && !file; attemptNdx++)
+	{
+		tmpFilename	= string(filename) + "." + de::toString(timestamp) + "." + de::toString(attemptNdx) + ".tmp";
+		file		= deFile_create(tmpFilename.c_str(), DE_FILEMODE_CREATE|DE_FILEMODE_WRITE);
+	}
+
+	if (!file)
+		return;
+
+	while (numWritten < m_size)
+	{
+		deInt64 curWritten = 0;
+
+		if (deFile_write(file, m_data + numWritten, (deInt64)(m_size - numWritten), &curWritten) != DE_FILERESULT_SUCCESS || curWritten <= 0)
+			break;
+
+		numWritten += (size_t)curWritten;
+	}
+
+	deFile_destroy(file);
+
+	if (numWritten != m_size || std::rename(tmpFilename.c_str(), filename) != 0)
+		deDeleteFile(tmpFilename.c_str());
+}
+
+bool LibraryData::isValid (deUint64 sourceSize, deUint64 sourceHash) const
+{
+	return m_size >= HEADER_SIZE															&&
+		   deMemCmp(m_data, s_magic, MAGIC_SIZE) == 0										&&
+		   getUint32(m_data + OFFSET_VERSION) == LIBRARY_DATA_VERSION						&&
+		   getUint32(m_data + OFFSET_ROOT) >= HEADER_SIZE									&&
+		   getUint32(m_data + OFFSET_ROOT) < m_size											&&
+		   getUint64(m_data + OFFSET_SOURCE_SIZE) == sourceSize								&&
+		   getUint64(m_data + OFFSET_SOURCE_HASH) == sourceHash								&&
+		   getUint64(m_data + OFFSET_DATA_HASH) == computeHash(m_data + HEADER_SIZE, m_size - HEADER_SIZE);
+}
+
+deUint32 LibraryData::getRootOffset (void) const
+{
+	DE_ASSERT(m_size >= HEADER_SIZE);
+	return getUint32(m_data + OFFSET_ROOT);
+}
+
+LibraryNodeType LibraryData::getNodeType (deUint32 offset) const
+{
+	DataReader		reader	(m_data, m_size, offset);
+	const deUint8	type	= reader.readUint8();
+
+	if (type >= LIBRARYNODETYPE_LAST)
+		throw tcu::InternalError("Invalid shader library data", "", __FILE__, __LINE__);
+
+	return (LibraryNodeType)type;
+}
+
+int LibraryData::getNumChildren (deUint32 groupOffset) const
+{
+	DataReader reader(m_data, m_size, groupOffset);
+
+	if (reader.readUint8() != LIBRARYNODETYPE_GROUP)
+		throw tcu::InternalError("Invalid shader library data", "", __FILE__, __LINE__);
+
+	reader.skipString();
+	reader.skipString();
+
+	return (int)reader.readUint32();
+}
+
+deUint32 LibraryData::getChildOffset (deUint32 groupOffset, int childNdx) const
+{
+	DataReader	reader		(m_data, m_size, groupOffset);
+	deUint32	numChildren;
+
+	if (reader.readUint8() != LIBRARYNODETYPE_GROUP)
+		throw tcu::InternalError("Invalid shader library data", "", __FILE__, __LINE__);
+
+	reader.skipString();
+	reader.skipString();
+
+	numChildren = reader.readUint32();
+	DE_ASSERT(de::inBounds<int>(childNdx, 0, (int)numChildren));
+	DE_UNREF(numChildren);
+
+	for (int ndx = 0; ndx < childNdx; ndx++)
+		reader.readUint32();
+
+	return reader.readUint32();
+}
+
+void LibraryData::readGroup (deUint32 offset, string& name, string& description) const
+{
+	DataReader reader(m_data, m_size, offset);
+	readNodeHeader(reader, LIBRARYNODETYPE_GROUP, name, description);
+}
+
+void LibraryData::readCase (deUint32 offset, string& name, string& description, ShaderCase::ShaderCaseSpecification& spec) const
+{
+	DataReader reader(m_data, m_size, offset);
+
+	readNodeHeader(reader, LIBRARYNODETYPE_CASE, name, description);
+
+	spec.expectResult	= (ShaderCase::ExpectResult)reader.readUint8();
+	spec.caseType		= (ShaderCase::CaseType)reader.readUint8();
+	spec.targetVersion	= (glu::GLSLVersion)reader.readUint32();
+	readRequirements(reader, spec.requirements);
+	readValueBlocks(reader, spec.valueBlocks);
+	reader.readStringList(spec.vertexSources);
+	reader.readStringList(spec.fragmentSources);
+	reader.readStringList(spec.tessCtrlSources);
+	reader.readStringList(spec.tessEvalSources);
+	reader.readStringList(spec.geometrySources);
+}
+
+void LibraryData::readCase (deUint32 offset, string& name, string& description, ShaderCase::PipelineCaseSpecification& spec) const
+{
+	DataReader	reader		(m_data, m_size, offset);
+	deUint32	numPrograms;
+
+	readNodeHeader(reader, LIBRARYNODETYPE_PIPELINE_CASE, name, description);
+
+	spec.expectResult	= (ShaderCase::ExpectResult)reader.readUint8();
+	spec.caseType		= (ShaderCase::CaseType)reader.readUint8();
+	spec.targetVersion	= (glu::GLSLVersion)reader.readUint32();
+	readValueBlocks(reader, spec.valueBlocks);
+
+	numPrograms = reader.readUint32();
+	spec.programs.resize(numPrograms);
+
+	for (deUint32 programNdx = 0; programNdx < numPrograms; programNdx++)
+	{
+		ShaderCase::PipelineProgram& program = spec.programs[programNdx];
+
+		program.activeStageBits = reader.readUint32();
+		readRequirements(reader, program.requirements);
+		reader.readStringList(program.vertexSources);
+		reader.readStringList(program.fragmentSources);
+		reader.readStringList(program.tessCtrlSources);
+		reader.readStringList(program.tessEvalSources);
+		reader.readStringList(program.geometrySources);
+	}
+}
+
+void LibraryData::readImport (deUint32 offset, string& filename) const
+{
+	DataReader	reader		(m_data, m_size, offset);
+	string		description;
+
+	readNodeHeader(reader, LIBRARYNODETYPE_IMPORT, filename, description);
+}
+
+// Self-test
+
+static void writeTestFile (const char* filename, const vector<deUint8>& data)
+{
+	deFile*	file		= deFile_create(filename, DE_FILEMODE_CREATE|DE_FILEMODE_OPEN|DE_FILEMODE_WRITE|DE_FILEMODE_TRUNCATE);
+	deInt64	numWritten	= 0;
+
+	DE_TEST_ASSERT(file);
+	DE_TEST_ASSERT(deFile_write(file, &data[0], (deInt64)data.size(), &numWritten) == DE_FILERESULT_SUCCESS);
+	DE_TEST_ASSERT(numWritten == (deInt64)data.size());
+
+	deFile_destroy(file);
+}
+
+static void readTestFile (const char* filename, vector<deUint8>& dst)
+{
+	deFile*	file	= deFile_create(filename, DE_FILEMODE_OPEN|DE_FILEMODE_READ);
+	deUint8	buf		[256];
+	deInt64	numRead	= 0;
+
+	DE_TEST_ASSERT(file);
+
+	dst.clear();
+	while (deFile_read(file, &buf[0], (deInt64)sizeof(buf), &numRead) == DE_FILERESULT_SUCCESS)
+		dst.insert(dst.end(), &buf[0], &buf[0] + numRead);
+
+	deFile_destroy(file);
+}
+
+//! Re-encode nodes of src into dst. Output matches original data only if all node contents were decoded correctly.
+static void copyLibraryNodes (const LibraryData& src, deUint32 groupOffset, LibraryWriter& dst)
+{
+	const int numChildren = src.getNumChildren(groupOffset);
+
+	for (int childNdx = 0; childNdx < numChildren; childNdx++)
+	{
+		const deUint32	childOffset	= src.getChildOffset(groupOffset, childNdx);
+		string			name;
+		string			description;
+
+		switch (src.getNodeType(childOffset))
+		{
+			case LIBRARYNODETYPE_GROUP:
+				src.readGroup(childOffset, name, description);
+				dst.beginGroup(name, description);
+				copyLibraryNodes(src, childOffset, dst);
+				dst.endGroup();
+				break;
+
+			case LIBRARYNODETYPE_CASE:
+			{
+				ShaderCase::ShaderCaseSpecification spec;
+				src.readCase(childOffset, name, description, spec);
+				dst.addCase(name, description, spec);
+				break;
+			}
+
+			case LIBRARYNODETYPE_PIPELINE_CASE:
+			{
+				ShaderCase::PipelineCaseSpecification spec;
+				src.readCase(childOffset, name, description, spec);
+				dst.addCase(name, description, spec);
+				break;
+			}
+
+			case LIBRARYNODETYPE_IMPORT:
+				src.readImport(childOffset, name);
+				dst.addImport(name);
+				break;
+
+			default:
+				DE_TEST_ASSERT(false);
+		}
+	}
+}
+
+static void createTestLibraryData (deUint64 sourceSize, deUint64 sourceHash, vector<deUint8>& dst)
+{
+	LibraryWriter							writer;
+	ShaderCase::ShaderCaseSpecification		caseSpec;
+	ShaderCase::PipelineCaseSpecification	pipelineSpec;
+	ShaderCase::ValueBlock					valueBlock;
+	ShaderCase::Value						value;
+
+	value.storageType	= ShaderCase::Value::STORAGE_INPUT;
+	value.valueName		= "in0";
+	value.dataType		= glu::TYPE_FLOAT;
+	value.arrayLength	= 1;
+	value.elements.resize(2);
+	value.elements[0].float32	= 1.5f;
+	value.elements[1].float32	= -2.25f;
+
+	valueBlock.arrayLength	= 2;
+	valueBlock.values.push_back(value);
+
+	caseSpec.expectResult		= ShaderCase::EXPECT_PASS;
+	caseSpec.targetVersion		= glu::GLSL_VERSION_300_ES;
+	caseSpec.caseType			= ShaderCase::CASETYPE_COMPLETE;
+	caseSpec.requirements.push_back(ShaderCase::CaseRequirement::createLimitRequirement(0x8B4A, 16));
+	caseSpec.requirements.push_back(ShaderCase::CaseRequirement::createAnyExtensionRequirement(vector<string>(1, "GL_EXT_test"), 3));
+	caseSpec.valueBlocks.push_back(valueBlock);
+	caseSpec.vertexSources.push_back("vertex source");
+	caseSpec.fragmentSources.push_back("fragment source");
+
+	pipelineSpec.expectResult	= ShaderCase::EXPECT_VALIDATION_FAIL;
+	pipelineSpec.targetVersion	= glu::GLSL_VERSION_310_ES;
+	pipelineSpec.caseType		= ShaderCase::CASETYPE_COMPLETE;
+	pipelineSpec.programs.resize(2);
+	pipelineSpec.programs[0].activeStageBits	= 1;
+	pipelineSpec.programs[0].vertexSources.push_back("vertex source");
+	pipelineSpec.programs[1].activeStageBits	= 2;
+	pipelineSpec.programs[1].fragmentSources.push_back("fragment source");
+
+	writer.beginGroup("group", "Group");
+	writer.beginGroup("empty", "");
+	writer.endGroup();
+	writer.addCase("case", "Case", caseSpec);
+	writer.endGroup();
+	writer.addCase("pipeline", "Pipeline case", pipelineSpec);
+	writer.addImport("imported.test");
+
+	writer.finish(sourceSize, sourceHash, dst);
+}
+
+static bool isValidCacheFile (const char* filename, deUint64 sourceSize, deUint64 sourceHash)
+{
+	const de::UniquePtr<LibraryData> data (LibraryData::loadCacheFile(filename, sourceSize, sourceHash));
+	return data.get() != DE_NULL;
+}
+
+void LibraryData_selfTest (void)
+{
+	const char* const	filename	= "deqp-shader-library-cache-selftest.slcache";
+	const deUint64		sourceSize	= 1234;
+	const deUint64		sourceHash	= computeLibrarySourceHash("source", 6);
+	vector<deUint8>		data;
+
+	createTestLibraryData(sourceSize, sourceHash, data);
+	deDeleteFile(filename);
+
+	// Written cache file round-trips exactly.
+	{
+		vector<deUint8>		dataCopy	= data;
+		vector<deUint8>		fileData;
+		vector<deUint8>		copiedData;
+		LibraryWriter		writer;
+
+		LibraryData(dataCopy).writeCacheFile(filename);
+		readTestFile(filename, fileData);
+		DE_TEST_ASSERT(fileData == data);
+
+		{
+			const de::UniquePtr<LibraryData> loaded (LibraryData::loadCacheFile(filename, sourceSize, sourceHash));
+
+			DE_TEST_ASSERT(loaded.get() != DE_NULL);
+			copyLibraryNodes(*loaded, loaded->getRootOffset(), writer);
+			writer.finish(sourceSize, sourceHash, copiedData);
+			DE_TEST_ASSERT(copiedData == data);
+		}
+	}
+
+	// Missing file and file for different source are rejected.
+	DE_TEST_ASSERT(!isValidCacheFile("deqp-shader-library-cache-selftest-missing.slcache", sourceSize, sourceHash));
+	DE_TEST_ASSERT(!isValidCacheFile(filename, sourceSize+1, sourceHash));
+	DE_TEST_ASSERT(!isValidCacheFile(filename, sourceSize, sourceHash+1));
+
+	// Stale version is rejected.
+	{
+		vector<deUint8> stale = data;
+		setUint32(&stale[OFFSET_VERSION], LIBRARY_DATA_VERSION+1);
+		writeTestFile(filename, stale);
+		DE_TEST_ASSERT(!isValidCacheFile(filename, sourceSize, sourceHash));
+	}
+
+	// Corrupted and truncated files are rejected.
+	{
+		vector<deUint8> corrupted = data;
+		corrupted[0] ^= 0x01;
+		writeTestFile(filename, corrupted);
+		DE_TEST_ASSERT(!isValidCacheFile(filename, sourceSize, sourceHash));
+	}
+
+	for (size_t ndx = HEADER_SIZE; ndx < data.size(); ndx += 7)
+	{
+		vector<deUint8> corrupted = data;
+		corrupted[ndx] ^= 0x80;
+		writeTestFile(filename, corrupted);
+		DE_TEST_ASSERT(!isValidCacheFile(filename, sourceSize, sourceHash));
+	}
+
+	{
+		vector<deUint8> truncated (data.begin(), data.end()-1);
+		writeTestFile(filename, truncated);
+		DE_TEST_ASSERT(!isValidCacheFile(filename, sourceSize, sourceHash));
+
+		truncated.resize(HEADER_SIZE-1);
+		writeTestFile(filename, truncated);
+		DE_TEST_ASSERT(!isValidCacheFile(filename, sourceSize, sourceHash));
+	}
+
+	DE_TEST_ASSERT(deDeleteFile(filename));
+}
+
+} // sl
+} // gls
+} // deqp
@@ -0,0 +1,148 @@
+#ifndef _GLSSHADERLIBRARYCACHE_HPP
+#define _GLSSHADERLIBRARYCACHE_HPP
+/*-------------------------------------------------------------------------
+ * drawElements Quality Program OpenGL (ES) Module
+ * -----------------------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Binary form of parsed shader library files.
+ *//*--------------------------------------------------------------------*/
+
+#include "gluDefs.hpp"
+#include "glsShaderLibraryCase.hpp"
+#include "deFile.h"
+
+#include <string>
+#include <vector>
+
+namespace deqp
+{
+namespace gls
+{
+namespace sl
+{
+
+/*--------------------------------------------------------------------*//*!
+ * \brief Parsed shader library
+ *
+ * Shader library parser emits the parsed case hierarchy in a compact binary
+ * form that test nodes are created from. The same data is written as is
+ * into the shader library cache, so that later runs can skip tokenizing
+ * and parsing by memory-mapping the cache file.
+ *
+ * All integers are little-endian and offsets are from start of data.
+ *
+ *  Header		magic "deslib\0\0", version, root node offset, size and
+ *				hash of the source file, hash of node data
+ *  nodes		written in post-order, i.e. group node follows its
+ *				children and stores their offsets
+ *
+ * Root node is a nameless group containing top-level nodes of the file.
+ * Import nodes store the imported file name as it appears in the source.
+ *//*--------------------------------------------------------------------*/
+
+enum LibraryNodeType
+{
+	LIBRARYNODETYPE_GROUP = 0,
+	LIBRARYNODETYPE_CASE,
+	LIBRARYNODETYPE_PIPELINE_CASE,
+	LIBRARYNODETYPE_IMPORT,
+
+	LIBRARYNODETYPE_LAST
+};
+
+deUint64	computeLibrarySourceHash	(const void* data, size_t size);
+
+class LibraryWriter
+{
+public:
+								LibraryWriter		(void);
+								~LibraryWriter		(void);
+
+	void						beginGroup			(const std::string& name, const std::string& description);
+	void						endGroup			(void);
+
+	void						addCase				(const std::string& name, const std::string& description, const ShaderCase::ShaderCaseSpecification& spec);
+	void						addCase				(const std::string& name, const std::string& description, const ShaderCase::PipelineCaseSpecification& spec);
+	void						addImport			(const std::string& filename);
+
+	//! Write root node and header, and move data to dst. Writer can't be used afterwards.
+	void						finish				(deUint64 sourceSize, deUint64 sourceHash, std::vector<deUint8>& dst);
+
+private:
+								LibraryWriter		(const LibraryWriter&);		// not allowed!
+	LibraryWriter&				operator=			(const LibraryWriter&);		// not allowed!
+
+	struct OpenGroup
+	{
+		std::string				name;
+		std::string				description;
+		std::vector<deUint32>	childOffsets;
+	};
+
+	void						addChildOffset		(void);
+	void						writeGroup			(const OpenGroup& group);
+
+	std::vector<deUint8>		m_data;
+	std::vector<OpenGroup>		m_groups;			//!< Stack of open groups, first one is root.
+};
+
+class LibraryData
+{
+public:
+	//! Takes ownership of contents of data.
+	explicit					LibraryData			(std::vector<deUint8>& data);
+								~LibraryData		(void);
+
+	//! Open cache file. Returns DE_NULL if file can't be opened or is not valid for given source.
+	static LibraryData*			loadCacheFile		(const char* filename, deUint64 sourceSize, deUint64 sourceHash);
+
+	//! Write data to cache file. Failures are ignored as cache is only an optimization.
+	void						writeCacheFile		(const char* filename) const;
+
+	deUint32					getRootOffset		(void) const;
+
+	LibraryNodeType				getNodeType			(deUint32 offset) const;
+	int							getNumChildren		(deUint32 groupOffset) const;
+	deUint32					getChildOffset		(deUint32 groupOffset, int childNdx) const;
+
+	void						readGroup			(deUint32 offset, std::string& name, std::string& description) const;
+	void						readCase			(deUint32 offset, std::string& name, std::string& description, ShaderCase::ShaderCaseSpecification& spec) const;
+	void						readCase			(deUint32 offset, std::string& name, std::string& description, ShaderCase::PipelineCaseSpecification& spec) const;
+	void						readImport			(deUint32 offset, std::string& filename) const;
+
+private:
+								LibraryData			(deFileMapping* mapping);
+								LibraryData			(const LibraryData&);		// not allowed!
+	LibraryData&				operator=			(const LibraryData&);		// not allowed!
+
+	bool						isValid				(deUint64 sourceSize, deUint64 sourceHash) const;
+
+	deFileMapping*				m_mapping;
+	std::vector<deUint8>		m_buffer;
+	const deUint8*				m_data;
+	size_t						m_size;
+};
+
+void	LibraryData_selfTest	(void);
+
+} // sl
+} // gls
+} // deqp
+
+#endif // _GLSSHADERLIBRARYCACHE_HPP
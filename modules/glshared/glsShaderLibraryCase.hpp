@@ -119,6 +119,9 @@ public:
 		RequirementType				getType							(void) const { return m_type; };
 		std::string					getSupportedExtension			(void) const { DE_ASSERT(m_type == REQUIREMENTTYPE_EXTENSION); DE_ASSERT(m_supportedExtensionNdx >= 0); return m_extensions[m_supportedExtensionNdx]; }
 		deUint32					getAffectedExtensionStageFlags	(void) const { DE_ASSERT(m_type == REQUIREMENTTYPE_EXTENSION); return m_effectiveShaderStageFlags; }
+		const std::vector<std::string>&	getExtensions				(void) const { DE_ASSERT(m_type == REQUIREMENTTYPE_EXTENSION); return m_extensions; }
+		deUint32					getLimitEnumName				(void) const { DE_ASSERT(m_type == REQUIREMENTTYPE_IMPLEMENTATION_LIMIT); return m_enumName; }
+		int							getLimitReferenceValue			(void) const { DE_ASSERT(m_type == REQUIREMENTTYPE_IMPLEMENTATION_LIMIT); return m_referenceValue; }
 
 	private:
 		RequirementType				m_type;
@@ -33,6 +33,7 @@
 #include "tcuStringTemplate.hpp"
 #include "tcuTexLookupVerifier.hpp"
 #include "tcuTexCompareVerifier.hpp"
+#include "tcuTiledVerifier.hpp"
 #include "glwEnums.hpp"
 #include "glwFunctions.hpp"
 #include "qpWatchDog.h"
@@ -479,6 +480,12 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 	float		triLod[2]	= { de::clamp(computeNonProjectedTriLod(params.lodMode, dstSize, srcSize, triS[0], triT[0]) + lodBias, params.minLod, params.maxLod),
 								de::clamp(computeNonProjectedTriLod(params.lodMode, dstSize, srcSize, triS[1], triT[1]) + lodBias, params.minLod, params.maxLod) };
 
+	// Sample one row at a time.
+	std::vector<float>		rowS		(dst.getWidth());
+	std::vector<float>		rowT		(dst.getWidth());
+	std::vector<float>		rowLod		(dst.getWidth());
+	std::vector<tcu::Vec4>	rowColor	(dst.getWidth());
+
 	for (int y = 0; y < dst.getHeight(); y++)
 	{
 		for (int x = 0; x < dst.getWidth(); x++)
@@ -490,12 +497,21 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 			float	triX	= triNdx ? 1.0f-xf : xf;
 			float	triY	= triNdx ? 1.0f-yf : yf;
 
-			float	s		= triangleInterpolate(triS[triNdx].x(), triS[triNdx].y(), triS[triNdx].z(), triX, triY);
-			float	t		= triangleInterpolate(triT[triNdx].x(), triT[triNdx].y(), triT[triNdx].z(), triX, triY);
-			float	lod		= triLod[triNdx];
+			rowS[x]		= triangleInterpolate(triS[triNdx].x(), triS[triNdx].y(), triS[triNdx].z(), triX, triY);
+			rowT[x]		= triangleInterpolate(triT[triNdx].x(), triT[triNdx].y(), triT[triNdx].z(), triX, triY);
+			rowLod[x]	= triLod[triNdx];
+		}
 
-			dst.setPixel(execSample(src, params, s, t, lod) * params.colorScale + params.colorBias, x, y);
+		if (params.samplerType == SAMPLERTYPE_SHADOW)
+		{
+			for (int x = 0; x < dst.getWidth(); x++)
+				rowColor[x] = execSample(src, params, rowS[x], rowT[x], rowLod[x]);
 		}
+		else
+			src.sampleBatch(params.sampler, &rowS[0], &rowT[0], &rowLod[0], &rowColor[0], dst.getWidth());
+
+		for (int x = 0; x < dst.getWidth(); x++)
+			dst.setPixel(rowColor[x] * params.colorScale + params.colorBias, x, y);
 	}
 }
 
@@ -799,6 +815,13 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 	float		triLod[2]	= { de::clamp(computeNonProjectedTriLod(params.lodMode, dstSize, srcSize, triS[0], triT[0], triR[0]) + lodBias, params.minLod, params.maxLod),
 								de::clamp(computeNonProjectedTriLod(params.lodMode, dstSize, srcSize, triS[1], triT[1], triR[1]) + lodBias, params.minLod, params.maxLod) };
 
+	// Sample one row at a time.
+	std::vector<float>		rowS		(dst.getWidth());
+	std::vector<float>		rowT		(dst.getWidth());
+	std::vector<float>		rowR		(dst.getWidth());
+	std::vector<float>		rowLod		(dst.getWidth());
+	std::vector<tcu::Vec4>	rowColor	(dst.getWidth());
+
 	for (int y = 0; y < dst.getHeight(); y++)
 	{
 		for (int x = 0; x < dst.getWidth(); x++)
@@ -810,13 +833,16 @@ static void sampleTextureNonProjected (const SurfaceAccess& dst, const tcu::Text
 			float	triX	= triNdx ? 1.0f-xf : xf;
 			float	triY	= triNdx ? 1.0f-yf : yf;
 
-			float	s		= triangleInterpolate(triS[triNdx].x(), triS[triNdx].y(), triS[triNdx].z(), triX, triY);
-			float	t		= triangleInterpolate(triT[triNdx].x(), triT[triNdx].y(), triT[triNdx].z(), triX, triY);
-			float	r		= triangleInterpolate(triR[triNdx].x(), triR[triNdx].y(), triR[triNdx].z(), triX, triY);
-			float	lod		= triLod[triNdx];
-
-			dst.setPixel(src.sample(params.sampler, s, t, r, lod) * params.colorScale + params.colorBias, x, y);
+			rowS[x]		= triangleInterpolate(triS[triNdx].x(), triS[triNdx].y(), triS[triNdx].z(), triX, triY);
+			rowT[x]		= triangleInterpolate(triT[triNdx].x(), triT[triNdx].y(), triT[triNdx].z(), triX, triY);
+			rowR[x]		= triangleInterpolate(triR[triNdx].x(), triR[triNdx].y(), triR[triNdx].z(), triX, triY);
+			rowLod[x]	= triLod[triNdx];
 		}
+
+		src.sampleBatch(params.sampler, &rowS[0], &rowT[0], &rowR[0], &rowLod[0], &rowColor[0], dst.getWidth());
+
+		for (int x = 0; x < dst.getWidth(); x++)
+			dst.setPixel(rowColor[x] * params.colorScale + params.colorBias, x, y);
 	}
 }
 
@@ -1671,218 +1697,243 @@ void computeQuadTexCoordCubeArray (std::vector<float>& dst, tcu::CubeFace face,
 
 // Texture result verification
 
-//! Verifies texture lookup results and returns number of failed pixels.
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture1DView&				baseView,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+/*--------------------------------------------------------------------*//*!
+ * \brief Texture lookup result verifier base
+ *
+ * Result pixel is first compared to ideal reference, and if that fails
+ * the slower lookup verification implemented by isLookupValid() is used.
+ * Verifiers are invoked from multiple threads and must thus be immutable
+ * after construction.
+ *//*--------------------------------------------------------------------*/
+class TextureLookupVerifier : public tcu::PixelVerifier
 {
-	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
-	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
-
-	const tcu::Texture1DView	src		= getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel);
-
-	const tcu::Vec4		sq				= tcu::Vec4(texCoord[0], texCoord[1], texCoord[2], texCoord[3]);
+public:
+	TextureLookupVerifier (const tcu::ConstPixelBufferAccess& result, const tcu::ConstPixelBufferAccess& reference, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec)
+		: m_result			(result)
+		, m_reference		(reference)
+		, m_sampleParams	(sampleParams)
+		, m_lookupPrec		(lookupPrec)
+		, m_lodPrec			(lodPrec)
+		, m_dstW			(float(result.getWidth()))
+		, m_dstH			(float(result.getHeight()))
+		, m_lodBias			((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f)
+	{
+		m_triW[0] = sampleParams.w.swizzle(0, 1, 2);
+		m_triW[1] = sampleParams.w.swizzle(3, 2, 1);
+	}
 
-	const tcu::IVec2	dstSize			= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float			dstW			= float(dstSize.x());
-	const float			dstH			= float(dstSize.y());
-	const int			srcSize			= src.getWidth();
+	bool isPixelValid (int px, int py) const
+	{
+		const tcu::Vec4	resPix	= (m_result.getPixel(px, py)	- m_sampleParams.colorBias) / m_sampleParams.colorScale;
+		const tcu::Vec4	refPix	= (m_reference.getPixel(px, py)	- m_sampleParams.colorBias) / m_sampleParams.colorScale;
 
-	// Coordinates and lod per triangle.
-	const tcu::Vec3		triS[2]			= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triW[2]			= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
+		// Try comparison to ideal reference first, and if that fails use slower verificator.
+		return tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), m_lookupPrec.colorThreshold)) ||
+			   isLookupValid(px, py, resPix);
+	}
 
-	const tcu::Vec2		lodBias			((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
+protected:
+	virtual bool isLookupValid (int px, int py, const tcu::Vec4& resPix) const = 0;
 
-	int					numFailed		= 0;
+	const tcu::ConstPixelBufferAccess	m_result;
+	const tcu::ConstPixelBufferAccess	m_reference;
+	const ReferenceParams&				m_sampleParams;
+	const tcu::LookupPrecision&			m_lookupPrec;
+	const tcu::LodPrecision&			m_lodPrec;
+	const float							m_dstW;
+	const float							m_dstH;
+	const tcu::Vec2						m_lodBias;
+	tcu::Vec3							m_triW[2];	//!< Coordinate w per triangle.
+};
 
-	const tcu::Vec2 lodOffsets[] =
+class Texture1DLookupVerifier : public TextureLookupVerifier
+{
+public:
+	Texture1DLookupVerifier (const tcu::ConstPixelBufferAccess& result, const tcu::ConstPixelBufferAccess& reference, const tcu::Texture1DView& baseView, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec)
+		: TextureLookupVerifier	(result, reference, sampleParams, lookupPrec, lodPrec)
+		, m_src					(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel))
+		, m_srcSize				(m_src.getWidth())
 	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-	};
+		const tcu::Vec4		sq				= tcu::Vec4(texCoord[0], texCoord[1], texCoord[2], texCoord[3]);
 
-	tcu::clear(errorMask, tcu::RGBA::green.toVec());
+		m_triS[0] = sq.swizzle(0, 1, 2);
+		m_triS[1] = sq.swizzle(3, 2, 1);
+	}
 
-	for (int py = 0; py < result.getHeight(); py++)
+protected:
+	bool isLookupValid (int px, int py, const tcu::Vec4& resPix) const
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
-		for (int px = 0; px < result.getWidth(); px++)
+		const tcu::Vec2 lodOffsets[] =
 		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
+			tcu::Vec2(-1,  0),
+			tcu::Vec2(+1,  0),
+			tcu::Vec2( 0, -1),
+			tcu::Vec2( 0, +1),
+		};
 
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
+		const float		wx		= (float)px + 0.5f;
+		const float		wy		= (float)py + 0.5f;
+		const float		nx		= wx / m_dstW;
+		const float		ny		= wy / m_dstH;
 
-				const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
-				const float		triWx	= triNdx ? dstW - wx : wx;
-				const float		triWy	= triNdx ? dstH - wy : wy;
-				const float		triNx	= triNdx ? 1.0f - nx : nx;
-				const float		triNy	= triNdx ? 1.0f - ny : ny;
+		const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
+		const float		triWx	= triNdx ? m_dstW - wx : wx;
+		const float		triWy	= triNdx ? m_dstH - wy : wy;
+		const float		triNx	= triNdx ? 1.0f - nx : nx;
+		const float		triNy	= triNdx ? 1.0f - ny : ny;
 
-				const float		coord		= projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy);
-				const float		coordDx		= triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy) * float(srcSize);
-				const float 	coordDy		= triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx) * float(srcSize);
+		const float		coord		= projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy);
+		const float		coordDx		= triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy) * float(m_srcSize);
+		const float 	coordDy		= triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx) * float(m_srcSize);
 
-				tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx, coordDy, lodPrec);
+		tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx, coordDy, m_lodPrec);
 
-				// Compute lod bounds across lodOffsets range.
-				for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-				{
-					const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-					const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-					const float		nxo		= wxo/dstW;
-					const float		nyo		= wyo/dstH;
+		// Compute lod bounds across lodOffsets range.
+		for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
+		{
+			const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
+			const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
+			const float		nxo		= wxo/m_dstW;
+			const float		nyo		= wyo/m_dstH;
 
-					const float	coordDxo	= triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo) * float(srcSize);
-					const float	coordDyo	= triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo) * float(srcSize);
-					const tcu::Vec2	lodO	= tcu::computeLodBoundsFromDerivates(coordDxo, coordDyo, lodPrec);
+			const float	coordDxo	= triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo) * float(m_srcSize);
+			const float	coordDyo	= triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo) * float(m_srcSize);
+			const tcu::Vec2	lodO	= tcu::computeLodBoundsFromDerivates(coordDxo, coordDyo, m_lodPrec);
 
-					lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-					lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-				}
+			lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+			lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+		}
 
-				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
+		const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+		const bool		isOk		= tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix);
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
-				}
-			}
-		}
+		return isOk;
 	}
 
-	return numFailed;
-}
+private:
+	const tcu::Texture1DView	m_src;
+	const int					m_srcSize;
+	tcu::Vec3					m_triS[2];
+};
 
+//! Verifies texture lookup results and returns number of failed pixels. Verification stops early once maxFailedPixels is reached.
 int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const tcu::ConstPixelBufferAccess&	reference,
 							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture2DView&				baseView,
+							  const tcu::Texture1DView&				baseView,
 							  const float*							texCoord,
-							  const ReferenceParams&					sampleParams,
+							  const ReferenceParams&				sampleParams,
 							  const tcu::LookupPrecision&			lookupPrec,
 							  const tcu::LodPrecision&				lodPrec,
+							  int									maxFailedPixels,
 							  qpWatchDog*							watchDog)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
 
-	const tcu::Texture2DView	src		= getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel);
+	const Texture1DLookupVerifier	verifier	(result, reference, baseView, texCoord, sampleParams, lookupPrec, lodPrec);
 
-	const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[2+0], texCoord[4+0], texCoord[6+0]);
-	const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[2+1], texCoord[4+1], texCoord[6+1]);
-
-	const tcu::IVec2	dstSize			= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float			dstW			= float(dstSize.x());
-	const float			dstH			= float(dstSize.y());
-	const tcu::IVec2	srcSize			= tcu::IVec2(src.getWidth(), src.getHeight());
-
-	// Coordinates and lod per triangle.
-	const tcu::Vec3		triS[2]			= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triT[2]			= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triW[2]			= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
-
-	const tcu::Vec2		lodBias			((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
-
-	int					numFailed		= 0;
+	return tcu::verifyPixelsTiled(verifier, errorMask, maxFailedPixels, watchDog);
+}
 
-	const tcu::Vec2 lodOffsets[] =
+class Texture2DLookupVerifier : public TextureLookupVerifier
+{
+public:
+	Texture2DLookupVerifier (const tcu::ConstPixelBufferAccess& result, const tcu::ConstPixelBufferAccess& reference, const tcu::Texture2DView& baseView, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec)
+		: TextureLookupVerifier	(result, reference, sampleParams, lookupPrec, lodPrec)
+		, m_src					(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel))
+		, m_srcSize				(tcu::IVec2(m_src.getWidth(), m_src.getHeight()))
 	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-	};
+		const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[2+0], texCoord[4+0], texCoord[6+0]);
+		const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[2+1], texCoord[4+1], texCoord[6+1]);
 
-	tcu::clear(errorMask, tcu::RGBA::green.toVec());
+		m_triS[0] = sq.swizzle(0, 1, 2);
+		m_triS[1] = sq.swizzle(3, 2, 1);
+		m_triT[0] = tq.swizzle(0, 1, 2);
+		m_triT[1] = tq.swizzle(3, 2, 1);
+	}
 
-	for (int py = 0; py < result.getHeight(); py++)
+protected:
+	bool isLookupValid (int px, int py, const tcu::Vec4& resPix) const
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
-		for (int px = 0; px < result.getWidth(); px++)
+		const tcu::Vec2 lodOffsets[] =
 		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
+			tcu::Vec2(-1,  0),
+			tcu::Vec2(+1,  0),
+			tcu::Vec2( 0, -1),
+			tcu::Vec2( 0, +1),
+		};
 
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
+		const float		wx		= (float)px + 0.5f;
+		const float		wy		= (float)py + 0.5f;
+		const float		nx		= wx / m_dstW;
+		const float		ny		= wy / m_dstH;
 
-				const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
-				const float		triWx	= triNdx ? dstW - wx : wx;
-				const float		triWy	= triNdx ? dstH - wy : wy;
-				const float		triNx	= triNdx ? 1.0f - nx : nx;
-				const float		triNy	= triNdx ? 1.0f - ny : ny;
+		const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
+		const float		triWx	= triNdx ? m_dstW - wx : wx;
+		const float		triWy	= triNdx ? m_dstH - wy : wy;
+		const float		triNx	= triNdx ? 1.0f - nx : nx;
+		const float		triNy	= triNdx ? 1.0f - ny : ny;
 
-				const tcu::Vec2	coord		(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-											 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy));
-				const tcu::Vec2	coordDx		= tcu::Vec2(triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy),
-														triDerivateX(triT[triNdx], triW[triNdx], wx, dstW, triNy)) * srcSize.asFloat();
-				const tcu::Vec2	coordDy		= tcu::Vec2(triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx),
-														triDerivateY(triT[triNdx], triW[triNdx], wy, dstH, triNx)) * srcSize.asFloat();
+		const tcu::Vec2	coord		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+									 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy));
+		const tcu::Vec2	coordDx		= tcu::Vec2(triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+												triDerivateX(m_triT[triNdx], m_triW[triNdx], wx, m_dstW, triNy)) * m_srcSize.asFloat();
+		const tcu::Vec2	coordDy		= tcu::Vec2(triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+												triDerivateY(m_triT[triNdx], m_triW[triNdx], wy, m_dstH, triNx)) * m_srcSize.asFloat();
 
-				tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDy.x(), coordDy.y(), lodPrec);
+		tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDy.x(), coordDy.y(), m_lodPrec);
 
-				// Compute lod bounds across lodOffsets range.
-				for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-				{
-					const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-					const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-					const float		nxo		= wxo/dstW;
-					const float		nyo		= wyo/dstH;
+		// Compute lod bounds across lodOffsets range.
+		for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
+		{
+			const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
+			const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
+			const float		nxo		= wxo/m_dstW;
+			const float		nyo		= wyo/m_dstH;
+
+			const tcu::Vec2	coordO		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], nxo, nyo),
+										 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], nxo, nyo));
+			const tcu::Vec2	coordDxo	= tcu::Vec2(triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+													triDerivateX(m_triT[triNdx], m_triW[triNdx], wxo, m_dstW, nyo)) * m_srcSize.asFloat();
+			const tcu::Vec2	coordDyo	= tcu::Vec2(triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+													triDerivateY(m_triT[triNdx], m_triW[triNdx], wyo, m_dstH, nxo)) * m_srcSize.asFloat();
+			const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDyo.x(), coordDyo.y(), m_lodPrec);
+
+			lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+			lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+		}
 
-					const tcu::Vec2	coordO		(projectedTriInterpolate(triS[triNdx], triW[triNdx], nxo, nyo),
-												 projectedTriInterpolate(triT[triNdx], triW[triNdx], nxo, nyo));
-					const tcu::Vec2	coordDxo	= tcu::Vec2(triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo),
-															triDerivateX(triT[triNdx], triW[triNdx], wxo, dstW, nyo)) * srcSize.asFloat();
-					const tcu::Vec2	coordDyo	= tcu::Vec2(triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo),
-															triDerivateY(triT[triNdx], triW[triNdx], wyo, dstH, nxo)) * srcSize.asFloat();
-					const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDyo.x(), coordDyo.y(), lodPrec);
+		const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+		const bool		isOk		= tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix);
 
-					lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-					lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-				}
+		return isOk;
+	}
 
-				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
+private:
+	const tcu::Texture2DView	m_src;
+	const tcu::IVec2			m_srcSize;
+	tcu::Vec3					m_triS[2];
+	tcu::Vec3					m_triT[2];
+};
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
-				}
-			}
-		}
-	}
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::Texture2DView&				baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&					sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::LodPrecision&				lodPrec,
+							  int									maxFailedPixels,
+							  qpWatchDog*							watchDog)
+{
+	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
+	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
 
-	return numFailed;
+	const Texture2DLookupVerifier	verifier	(result, reference, baseView, texCoord, sampleParams, lookupPrec, lodPrec);
+
+	return tcu::verifyPixelsTiled(verifier, errorMask, maxFailedPixels, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
@@ -1902,10 +1953,10 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
 
 	sampleTexture(SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
-	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, testCtx.getWatchDog());
+	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, testCtx.getWatchDog());
 
 	if (numFailedPixels > 0)
-		log << TestLog::Message << "ERROR: Result verification failed, got " << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
+		log << TestLog::Message << "ERROR: Result verification failed, got " << (numFailedPixels >= MAX_VERIFY_FAILED_PIXELS ? "at least " : "") << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
 
 	log << TestLog::ImageSet("VerifyResult", "Verification result")
 		<< TestLog::Image("Rendered", "Rendered image", result);
@@ -1938,10 +1989,10 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
 
 	sampleTexture(SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
-	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, testCtx.getWatchDog());
+	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, testCtx.getWatchDog());
 
 	if (numFailedPixels > 0)
-		log << TestLog::Message << "ERROR: Result verification failed, got " << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
+		log << TestLog::Message << "ERROR: Result verification failed, got " << (numFailedPixels >= MAX_VERIFY_FAILED_PIXELS ? "at least " : "") << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
 
 	log << TestLog::ImageSet("VerifyResult", "Verification result")
 		<< TestLog::Image("Rendered", "Rendered image", result);
@@ -1957,7 +2008,121 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	return numFailedPixels == 0;
 }
 
-//! Verifies texture lookup results and returns number of failed pixels.
+class TextureCubeLookupVerifier : public TextureLookupVerifier
+{
+public:
+	TextureCubeLookupVerifier (const tcu::ConstPixelBufferAccess& result, const tcu::ConstPixelBufferAccess& reference, const tcu::TextureCubeView& baseView, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec)
+		: TextureLookupVerifier	(result, reference, sampleParams, lookupPrec, lodPrec)
+		, m_src					(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel))
+		, m_srcSize				(m_src.getSize())
+	{
+		const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[3+0], texCoord[6+0], texCoord[9+0]);
+		const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[3+1], texCoord[6+1], texCoord[9+1]);
+		const tcu::Vec4		rq				= tcu::Vec4(texCoord[0+2], texCoord[3+2], texCoord[6+2], texCoord[9+2]);
+
+		m_triS[0] = sq.swizzle(0, 1, 2);
+		m_triS[1] = sq.swizzle(3, 2, 1);
+		m_triT[0] = tq.swizzle(0, 1, 2);
+		m_triT[1] = tq.swizzle(3, 2, 1);
+		m_triR[0] = rq.swizzle(0, 1, 2);
+		m_triR[1] = rq.swizzle(3, 2, 1);
+	}
+
+protected:
+	bool isLookupValid (int px, int py, const tcu::Vec4& resPix) const
+	{
+		const float			posEps			= 1.0f / float((1<<MIN_SUBPIXEL_BITS) + 1);
+
+		const tcu::Vec2 lodOffsets[] =
+		{
+			tcu::Vec2(-1,  0),
+			tcu::Vec2(+1,  0),
+			tcu::Vec2( 0, -1),
+			tcu::Vec2( 0, +1),
+	
+			// \note Not strictly allowed by spec, but implementations do this in practice.
+			tcu::Vec2(-1, -1),
+			tcu::Vec2(-1, +1),
+			tcu::Vec2(+1, -1),
+			tcu::Vec2(+1, +1),
+		};
+
+		const float		wx		= (float)px + 0.5f;
+		const float		wy		= (float)py + 0.5f;
+		const float		nx		= wx / m_dstW;
+		const float		ny		= wy / m_dstH;
+
+		const bool		tri0	= nx + ny - posEps <= 1.0f;
+		const bool		tri1	= nx + ny + posEps >= 1.0f;
+
+		bool			isOk	= false;
+
+		DE_ASSERT(tri0 || tri1);
+
+		// Pixel can belong to either of the triangles if it lies close enough to the edge.
+		for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
+		{
+			const float		triWx	= triNdx ? m_dstW - wx : wx;
+			const float		triWy	= triNdx ? m_dstH - wy : wy;
+			const float		triNx	= triNdx ? 1.0f - nx : nx;
+			const float		triNy	= triNdx ? 1.0f - ny : ny;
+
+			const tcu::Vec3	coord		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+										 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy),
+										 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], triNx, triNy));
+			const tcu::Vec3	coordDx		(triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+										 triDerivateX(m_triT[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+										 triDerivateX(m_triR[triNdx], m_triW[triNdx], wx, m_dstW, triNy));
+			const tcu::Vec3	coordDy		(triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+										 triDerivateY(m_triT[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+										 triDerivateY(m_triR[triNdx], m_triW[triNdx], wy, m_dstH, triNx));
+
+			tcu::Vec2		lodBounds	= tcu::computeCubeLodBoundsFromDerivates(coord, coordDx, coordDy, m_srcSize, m_lodPrec);
+
+			// Compute lod bounds across lodOffsets range.
+			for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
+			{
+				const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
+				const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
+				const float		nxo		= wxo/m_dstW;
+				const float		nyo		= wyo/m_dstH;
+
+				const tcu::Vec3	coordO		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], nxo, nyo),
+											 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], nxo, nyo),
+											 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], nxo, nyo));
+				const tcu::Vec3	coordDxo	(triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+											 triDerivateX(m_triT[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+											 triDerivateX(m_triR[triNdx], m_triW[triNdx], wxo, m_dstW, nyo));
+				const tcu::Vec3	coordDyo	(triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+											 triDerivateY(m_triT[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+											 triDerivateY(m_triR[triNdx], m_triW[triNdx], wyo, m_dstH, nxo));
+				const tcu::Vec2	lodO		= tcu::computeCubeLodBoundsFromDerivates(coordO, coordDxo, coordDyo, m_srcSize, m_lodPrec);
+
+				lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+				lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+			}
+
+			const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+
+			if (tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix))
+			{
+				isOk = true;
+				break;
+			}
+		}
+
+		return isOk;
+	}
+
+private:
+	const tcu::TextureCubeView	m_src;
+	const int					m_srcSize;
+	tcu::Vec3					m_triS[2];
+	tcu::Vec3					m_triT[2];
+	tcu::Vec3					m_triR[2];
+};
+
+//! Verifies texture lookup results and returns number of failed pixels. Verification stops early once maxFailedPixels is reached.
 int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const tcu::ConstPixelBufferAccess&	reference,
 							  const tcu::PixelBufferAccess&			errorMask,
@@ -1966,177 +2131,162 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const ReferenceParams&				sampleParams,
 							  const tcu::LookupPrecision&			lookupPrec,
 							  const tcu::LodPrecision&				lodPrec,
+							  int									maxFailedPixels,
 							  qpWatchDog*							watchDog)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
 
-	const tcu::TextureCubeView	src		= getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel);
+	const TextureCubeLookupVerifier	verifier	(result, reference, baseView, texCoord, sampleParams, lookupPrec, lodPrec);
 
-	const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[3+0], texCoord[6+0], texCoord[9+0]);
-	const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[3+1], texCoord[6+1], texCoord[9+1]);
-	const tcu::Vec4		rq				= tcu::Vec4(texCoord[0+2], texCoord[3+2], texCoord[6+2], texCoord[9+2]);
+	return tcu::verifyPixelsTiled(verifier, errorMask, maxFailedPixels, watchDog);
+}
 
-	const tcu::IVec2	dstSize			= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float			dstW			= float(dstSize.x());
-	const float			dstH			= float(dstSize.y());
-	const int			srcSize			= src.getSize();
+bool verifyTextureResult (tcu::TestContext&						testCtx,
+						  const tcu::ConstPixelBufferAccess&	result,
+						  const tcu::TextureCubeView&			src,
+						  const float*							texCoord,
+						  const ReferenceParams&				sampleParams,
+						  const tcu::LookupPrecision&			lookupPrec,
+						  const tcu::LodPrecision&				lodPrec,
+						  const tcu::PixelFormat&				pixelFormat)
+{
+	tcu::TestLog&	log				= testCtx.getLog();
+	tcu::Surface	reference		(result.getWidth(), result.getHeight());
+	tcu::Surface	errorMask		(result.getWidth(), result.getHeight());
+	int				numFailedPixels;
 
-	// Coordinates per triangle.
-	const tcu::Vec3		triS[2]			= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triT[2]			= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triR[2]			= { rq.swizzle(0, 1, 2), rq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triW[2]			= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
+	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
 
-	const tcu::Vec2		lodBias			((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
+	sampleTextureMultiFace(SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
+	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, testCtx.getWatchDog());
 
-	const float			posEps			= 1.0f / float((1<<MIN_SUBPIXEL_BITS) + 1);
+	if (numFailedPixels > 0)
+		log << TestLog::Message << "ERROR: Result verification failed, got " << (numFailedPixels >= MAX_VERIFY_FAILED_PIXELS ? "at least " : "") << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
 
-	int					numFailed		= 0;
+	log << TestLog::ImageSet("VerifyResult", "Verification result")
+		<< TestLog::Image("Rendered", "Rendered image", result);
 
-	const tcu::Vec2 lodOffsets[] =
+	if (numFailedPixels > 0)
 	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
+		log << TestLog::Image("Reference", "Ideal reference image", reference)
+			<< TestLog::Image("ErrorMask", "Error mask", errorMask);
+	}
 
-		// \note Not strictly allowed by spec, but implementations do this in practice.
-		tcu::Vec2(-1, -1),
-		tcu::Vec2(-1, +1),
-		tcu::Vec2(+1, -1),
-		tcu::Vec2(+1, +1),
-	};
+	log << TestLog::EndImageSet;
 
-	tcu::clear(errorMask, tcu::RGBA::green.toVec());
+	return numFailedPixels == 0;
+}
 
-	for (int py = 0; py < result.getHeight(); py++)
+class Texture3DLookupVerifier : public TextureLookupVerifier
+{
+public:
+	Texture3DLookupVerifier (const tcu::ConstPixelBufferAccess& result, const tcu::ConstPixelBufferAccess& reference, const tcu::Texture3DView& baseView, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec)
+		: TextureLookupVerifier	(result, reference, sampleParams, lookupPrec, lodPrec)
+		, m_src					(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel))
+		, m_srcSize				(tcu::IVec3(m_src.getWidth(), m_src.getHeight(), m_src.getDepth()))
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
+		const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[3+0], texCoord[6+0], texCoord[9+0]);
+		const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[3+1], texCoord[6+1], texCoord[9+1]);
+		const tcu::Vec4		rq				= tcu::Vec4(texCoord[0+2], texCoord[3+2], texCoord[6+2], texCoord[9+2]);
 
-		for (int px = 0; px < result.getWidth(); px++)
-		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
+		m_triS[0] = sq.swizzle(0, 1, 2);
+		m_triS[1] = sq.swizzle(3, 2, 1);
+		m_triT[0] = tq.swizzle(0, 1, 2);
+		m_triT[1] = tq.swizzle(3, 2, 1);
+		m_triR[0] = rq.swizzle(0, 1, 2);
+		m_triR[1] = rq.swizzle(3, 2, 1);
+	}
 
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
+protected:
+	bool isLookupValid (int px, int py, const tcu::Vec4& resPix) const
+	{
+		const float			posEps			= 1.0f / float((1<<MIN_SUBPIXEL_BITS) + 1);
 
-				const bool		tri0	= nx + ny - posEps <= 1.0f;
-				const bool		tri1	= nx + ny + posEps >= 1.0f;
+		const tcu::Vec2 lodOffsets[] =
+		{
+			tcu::Vec2(-1,  0),
+			tcu::Vec2(+1,  0),
+			tcu::Vec2( 0, -1),
+			tcu::Vec2( 0, +1),
+		};
 
-				bool			isOk	= false;
+		const float		wx		= (float)px + 0.5f;
+		const float		wy		= (float)py + 0.5f;
+		const float		nx		= wx / m_dstW;
+		const float		ny		= wy / m_dstH;
 
-				DE_ASSERT(tri0 || tri1);
+		const bool		tri0	= nx + ny - posEps <= 1.0f;
+		const bool		tri1	= nx + ny + posEps >= 1.0f;
 
-				// Pixel can belong to either of the triangles if it lies close enough to the edge.
-				for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
-				{
-					const float		triWx	= triNdx ? dstW - wx : wx;
-					const float		triWy	= triNdx ? dstH - wy : wy;
-					const float		triNx	= triNdx ? 1.0f - nx : nx;
-					const float		triNy	= triNdx ? 1.0f - ny : ny;
-
-					const tcu::Vec3	coord		(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triR[triNdx], triW[triNdx], triNx, triNy));
-					const tcu::Vec3	coordDx		(triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy),
-												 triDerivateX(triT[triNdx], triW[triNdx], wx, dstW, triNy),
-												 triDerivateX(triR[triNdx], triW[triNdx], wx, dstW, triNy));
-					const tcu::Vec3	coordDy		(triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx),
-												 triDerivateY(triT[triNdx], triW[triNdx], wy, dstH, triNx),
-												 triDerivateY(triR[triNdx], triW[triNdx], wy, dstH, triNx));
-
-					tcu::Vec2		lodBounds	= tcu::computeCubeLodBoundsFromDerivates(coord, coordDx, coordDy, srcSize, lodPrec);
-
-					// Compute lod bounds across lodOffsets range.
-					for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-					{
-						const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-						const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-						const float		nxo		= wxo/dstW;
-						const float		nyo		= wyo/dstH;
-
-						const tcu::Vec3	coordO		(projectedTriInterpolate(triS[triNdx], triW[triNdx], nxo, nyo),
-													 projectedTriInterpolate(triT[triNdx], triW[triNdx], nxo, nyo),
-													 projectedTriInterpolate(triR[triNdx], triW[triNdx], nxo, nyo));
-						const tcu::Vec3	coordDxo	(triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo),
-													 triDerivateX(triT[triNdx], triW[triNdx], wxo, dstW, nyo),
-													 triDerivateX(triR[triNdx], triW[triNdx], wxo, dstW, nyo));
-						const tcu::Vec3	coordDyo	(triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo),
-													 triDerivateY(triT[triNdx], triW[triNdx], wyo, dstH, nxo),
-													 triDerivateY(triR[triNdx], triW[triNdx], wyo, dstH, nxo));
-						const tcu::Vec2	lodO		= tcu::computeCubeLodBoundsFromDerivates(coordO, coordDxo, coordDyo, srcSize, lodPrec);
-
-						lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-						lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-					}
-
-					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix))
-					{
-						isOk = true;
-						break;
-					}
-				}
+		bool			isOk	= false;
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
-				}
-			}
-		}
-	}
+		DE_ASSERT(tri0 || tri1);
 
-	return numFailed;
-}
+		// Pixel can belong to either of the triangles if it lies close enough to the edge.
+		for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
+		{
+			const float		triWx	= triNdx ? m_dstW - wx : wx;
+			const float		triWy	= triNdx ? m_dstH - wy : wy;
+			const float		triNx	= triNdx ? 1.0f - nx : nx;
+			const float		triNy	= triNdx ? 1.0f - ny : ny;
 
-bool verifyTextureResult (tcu::TestContext&						testCtx,
-						  const tcu::ConstPixelBufferAccess&	result,
-						  const tcu::TextureCubeView&			src,
-						  const float*							texCoord,
-						  const ReferenceParams&				sampleParams,
-						  const tcu::LookupPrecision&			lookupPrec,
-						  const tcu::LodPrecision&				lodPrec,
-						  const tcu::PixelFormat&				pixelFormat)
-{
-	tcu::TestLog&	log				= testCtx.getLog();
-	tcu::Surface	reference		(result.getWidth(), result.getHeight());
-	tcu::Surface	errorMask		(result.getWidth(), result.getHeight());
-	int				numFailedPixels;
+			const tcu::Vec3	coord		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+										 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy),
+										 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], triNx, triNy));
+			const tcu::Vec3	coordDx		= tcu::Vec3(triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+													triDerivateX(m_triT[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+													triDerivateX(m_triR[triNdx], m_triW[triNdx], wx, m_dstW, triNy)) * m_srcSize.asFloat();
+			const tcu::Vec3	coordDy		= tcu::Vec3(triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+													triDerivateY(m_triT[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+													triDerivateY(m_triR[triNdx], m_triW[triNdx], wy, m_dstH, triNx)) * m_srcSize.asFloat();
 
-	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
+			tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDx.z(), coordDy.x(), coordDy.y(), coordDy.z(), m_lodPrec);
 
-	sampleTextureMultiFace(SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
-	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, testCtx.getWatchDog());
+			// Compute lod bounds across lodOffsets range.
+			for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
+			{
+				const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
+				const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
+				const float		nxo		= wxo/m_dstW;
+				const float		nyo		= wyo/m_dstH;
+
+				const tcu::Vec3	coordO		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], nxo, nyo),
+											 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], nxo, nyo),
+											 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], nxo, nyo));
+				const tcu::Vec3	coordDxo	= tcu::Vec3(triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+														triDerivateX(m_triT[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+														triDerivateX(m_triR[triNdx], m_triW[triNdx], wxo, m_dstW, nyo)) * m_srcSize.asFloat();
+				const tcu::Vec3	coordDyo	= tcu::Vec3(triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+														triDerivateY(m_triT[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+														triDerivateY(m_triR[triNdx], m_triW[triNdx], wyo, m_dstH, nxo)) * m_srcSize.asFloat();
+				const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDxo.z(), coordDyo.x(), coordDyo.y(), coordDyo.z(), m_lodPrec);
+
+				lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+				lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+			}
 
-	if (numFailedPixels > 0)
-		log << TestLog::Message << "ERROR: Result verification failed, got " << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
+			const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
 
-	log << TestLog::ImageSet("VerifyResult", "Verification result")
-		<< TestLog::Image("Rendered", "Rendered image", result);
+			if (tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix))
+			{
+				isOk = true;
+				break;
+			}
+		}
 
-	if (numFailedPixels > 0)
-	{
-		log << TestLog::Image("Reference", "Ideal reference image", reference)
-			<< TestLog::Image("ErrorMask", "Error mask", errorMask);
+		return isOk;
 	}
 
-	log << TestLog::EndImageSet;
-
-	return numFailedPixels == 0;
-}
+private:
+	const tcu::Texture3DView	m_src;
+	const tcu::IVec3			m_srcSize;
+	tcu::Vec3					m_triS[2];
+	tcu::Vec3					m_triT[2];
+	tcu::Vec3					m_triR[2];
+};
 
-//! Verifies texture lookup results and returns number of failed pixels.
+//! Verifies texture lookup results and returns number of failed pixels. Verification stops early once maxFailedPixels is reached.
 int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const tcu::ConstPixelBufferAccess&	reference,
 							  const tcu::PixelBufferAccess&			errorMask,
@@ -2145,132 +2295,15 @@ int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const ReferenceParams&				sampleParams,
 							  const tcu::LookupPrecision&			lookupPrec,
 							  const tcu::LodPrecision&				lodPrec,
+							  int									maxFailedPixels,
 							  qpWatchDog*							watchDog)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
 
-	const tcu::Texture3DView	src		= getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel);
-
-	const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[3+0], texCoord[6+0], texCoord[9+0]);
-	const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[3+1], texCoord[6+1], texCoord[9+1]);
-	const tcu::Vec4		rq				= tcu::Vec4(texCoord[0+2], texCoord[3+2], texCoord[6+2], texCoord[9+2]);
-
-	const tcu::IVec2	dstSize			= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float			dstW			= float(dstSize.x());
-	const float			dstH			= float(dstSize.y());
-	const tcu::IVec3	srcSize			= tcu::IVec3(src.getWidth(), src.getHeight(), src.getDepth());
-
-	// Coordinates and lod per triangle.
-	const tcu::Vec3		triS[2]			= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triT[2]			= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triR[2]			= { rq.swizzle(0, 1, 2), rq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triW[2]			= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
-
-	const tcu::Vec2		lodBias			((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
-
-	const float			posEps			= 1.0f / float((1<<MIN_SUBPIXEL_BITS) + 1);
-
-	int					numFailed		= 0;
-
-	const tcu::Vec2 lodOffsets[] =
-	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-	};
-
-	tcu::clear(errorMask, tcu::RGBA::green.toVec());
-
-	for (int py = 0; py < result.getHeight(); py++)
-	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
-		for (int px = 0; px < result.getWidth(); px++)
-		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
-
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
-
-				const bool		tri0	= nx + ny - posEps <= 1.0f;
-				const bool		tri1	= nx + ny + posEps >= 1.0f;
+	const Texture3DLookupVerifier	verifier	(result, reference, baseView, texCoord, sampleParams, lookupPrec, lodPrec);
 
-				bool			isOk	= false;
-
-				DE_ASSERT(tri0 || tri1);
-
-				// Pixel can belong to either of the triangles if it lies close enough to the edge.
-				for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
-				{
-					const float		triWx	= triNdx ? dstW - wx : wx;
-					const float		triWy	= triNdx ? dstH - wy : wy;
-					const float		triNx	= triNdx ? 1.0f - nx : nx;
-					const float		triNy	= triNdx ? 1.0f - ny : ny;
-
-					const tcu::Vec3	coord		(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triR[triNdx], triW[triNdx], triNx, triNy));
-					const tcu::Vec3	coordDx		= tcu::Vec3(triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy),
-															triDerivateX(triT[triNdx], triW[triNdx], wx, dstW, triNy),
-															triDerivateX(triR[triNdx], triW[triNdx], wx, dstW, triNy)) * srcSize.asFloat();
-					const tcu::Vec3	coordDy		= tcu::Vec3(triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx),
-															triDerivateY(triT[triNdx], triW[triNdx], wy, dstH, triNx),
-															triDerivateY(triR[triNdx], triW[triNdx], wy, dstH, triNx)) * srcSize.asFloat();
-
-					tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDx.z(), coordDy.x(), coordDy.y(), coordDy.z(), lodPrec);
-
-					// Compute lod bounds across lodOffsets range.
-					for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-					{
-						const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-						const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-						const float		nxo		= wxo/dstW;
-						const float		nyo		= wyo/dstH;
-
-						const tcu::Vec3	coordO		(projectedTriInterpolate(triS[triNdx], triW[triNdx], nxo, nyo),
-													 projectedTriInterpolate(triT[triNdx], triW[triNdx], nxo, nyo),
-													 projectedTriInterpolate(triR[triNdx], triW[triNdx], nxo, nyo));
-						const tcu::Vec3	coordDxo	= tcu::Vec3(triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo),
-																triDerivateX(triT[triNdx], triW[triNdx], wxo, dstW, nyo),
-																triDerivateX(triR[triNdx], triW[triNdx], wxo, dstW, nyo)) * srcSize.asFloat();
-						const tcu::Vec3	coordDyo	= tcu::Vec3(triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo),
-																triDerivateY(triT[triNdx], triW[triNdx], wyo, dstH, nxo),
-																triDerivateY(triR[triNdx], triW[triNdx], wyo, dstH, nxo)) * srcSize.asFloat();
-						const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDxo.z(), coordDyo.x(), coordDyo.y(), coordDyo.z(), lodPrec);
-
-						lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-						lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-					}
-
-					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix))
-					{
-						isOk = true;
-						break;
-					}
-				}
-
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
-				}
-			}
-		}
-	}
-
-	return numFailed;
+	return tcu::verifyPixelsTiled(verifier, errorMask, maxFailedPixels, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
@@ -2290,10 +2323,10 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
 
 	sampleTexture(SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
-	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, testCtx.getWatchDog());
+	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, testCtx.getWatchDog());
 
 	if (numFailedPixels > 0)
-		log << TestLog::Message << "ERROR: Result verification failed, got " << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
+		log << TestLog::Message << "ERROR: Result verification failed, got " << (numFailedPixels >= MAX_VERIFY_FAILED_PIXELS ? "at least " : "") << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
 
 	log << TestLog::ImageSet("VerifyResult", "Verification result")
 		<< TestLog::Image("Rendered", "Rendered image", result);
@@ -2309,224 +2342,208 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	return numFailedPixels == 0;
 }
 
-//! Verifies texture lookup results and returns number of failed pixels.
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture1DArrayView&		src,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+class Texture1DArrayLookupVerifier : public TextureLookupVerifier
 {
-	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
-	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
-
-	const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[2+0], texCoord[4+0], texCoord[6+0]);
-	const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[2+1], texCoord[4+1], texCoord[6+1]);
-
-	const tcu::IVec2	dstSize			= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float			dstW			= float(dstSize.x());
-	const float			dstH			= float(dstSize.y());
-	const float			srcSize			= float(src.getWidth()); // For lod computation, thus #layers is ignored.
-
-	// Coordinates and lod per triangle.
-	const tcu::Vec3		triS[2]			= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triT[2]			= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triW[2]			= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
-
-	const tcu::Vec2		lodBias			((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
-
-	int					numFailed		= 0;
-
-	const tcu::Vec2 lodOffsets[] =
+public:
+	Texture1DArrayLookupVerifier (const tcu::ConstPixelBufferAccess& result, const tcu::ConstPixelBufferAccess& reference, const tcu::Texture1DArrayView& src, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec)
+		: TextureLookupVerifier	(result, reference, sampleParams, lookupPrec, lodPrec)
+		, m_src					(src)
+		, m_srcSize				(float(m_src.getWidth()))
 	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-	};
+		const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[2+0], texCoord[4+0], texCoord[6+0]);
+		const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[2+1], texCoord[4+1], texCoord[6+1]);
 
-	tcu::clear(errorMask, tcu::RGBA::green.toVec());
+		m_triS[0] = sq.swizzle(0, 1, 2);
+		m_triS[1] = sq.swizzle(3, 2, 1);
+		m_triT[0] = tq.swizzle(0, 1, 2);
+		m_triT[1] = tq.swizzle(3, 2, 1);
+	}
 
-	for (int py = 0; py < result.getHeight(); py++)
+protected:
+	bool isLookupValid (int px, int py, const tcu::Vec4& resPix) const
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
-		for (int px = 0; px < result.getWidth(); px++)
+		const tcu::Vec2 lodOffsets[] =
 		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
-
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
-
-				const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
-				const float		triWx	= triNdx ? dstW - wx : wx;
-				const float		triWy	= triNdx ? dstH - wy : wy;
-				const float		triNx	= triNdx ? 1.0f - nx : nx;
-				const float		triNy	= triNdx ? 1.0f - ny : ny;
+			tcu::Vec2(-1,  0),
+			tcu::Vec2(+1,  0),
+			tcu::Vec2( 0, -1),
+			tcu::Vec2( 0, +1),
+		};
 
-				const tcu::Vec2	coord	(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-										 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy));
-				const float	coordDx		= triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy) * srcSize;
-				const float	coordDy		= triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx) * srcSize;
+		const float		wx		= (float)px + 0.5f;
+		const float		wy		= (float)py + 0.5f;
+		const float		nx		= wx / m_dstW;
+		const float		ny		= wy / m_dstH;
 
-				tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx, coordDy, lodPrec);
+		const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
+		const float		triWx	= triNdx ? m_dstW - wx : wx;
+		const float		triWy	= triNdx ? m_dstH - wy : wy;
+		const float		triNx	= triNdx ? 1.0f - nx : nx;
+		const float		triNy	= triNdx ? 1.0f - ny : ny;
 
-				// Compute lod bounds across lodOffsets range.
-				for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-				{
-					const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-					const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-					const float		nxo		= wxo/dstW;
-					const float		nyo		= wyo/dstH;
+		const tcu::Vec2	coord	(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+								 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy));
+		const float	coordDx		= triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy) * m_srcSize;
+		const float	coordDy		= triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx) * m_srcSize;
 
-					const tcu::Vec2	coordO		(projectedTriInterpolate(triS[triNdx], triW[triNdx], nxo, nyo),
-												 projectedTriInterpolate(triT[triNdx], triW[triNdx], nxo, nyo));
-					const float	coordDxo		= triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo) * srcSize;
-					const float	coordDyo		= triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo) * srcSize;
-					const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo, coordDyo, lodPrec);
+		tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx, coordDy, m_lodPrec);
 
-					lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-					lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-				}
+		// Compute lod bounds across lodOffsets range.
+		for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
+		{
+			const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
+			const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
+			const float		nxo		= wxo/m_dstW;
+			const float		nyo		= wyo/m_dstH;
+
+			const tcu::Vec2	coordO		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], nxo, nyo),
+										 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], nxo, nyo));
+			const float	coordDxo		= triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo) * m_srcSize;
+			const float	coordDyo		= triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo) * m_srcSize;
+			const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo, coordDyo, m_lodPrec);
+
+			lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+			lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+		}
 
-				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
+		const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+		const bool		isOk		= tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix);
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
-				}
-			}
-		}
+		return isOk;
 	}
 
-	return numFailed;
-}
+private:
+	const tcu::Texture1DArrayView	m_src;
+	const float						m_srcSize;	//!< For lod computation, thus #layers is ignored.
+	tcu::Vec3						m_triS[2];
+	tcu::Vec3						m_triT[2];
+};
 
-//! Verifies texture lookup results and returns number of failed pixels.
+//! Verifies texture lookup results and returns number of failed pixels. Verification stops early once maxFailedPixels is reached.
 int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
 							  const tcu::ConstPixelBufferAccess&	reference,
 							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::Texture2DArrayView&		src,
+							  const tcu::Texture1DArrayView&		src,
 							  const float*							texCoord,
 							  const ReferenceParams&				sampleParams,
 							  const tcu::LookupPrecision&			lookupPrec,
 							  const tcu::LodPrecision&				lodPrec,
+							  int									maxFailedPixels,
 							  qpWatchDog*							watchDog)
 {
 	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
 	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
 
-	const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[3+0], texCoord[6+0], texCoord[9+0]);
-	const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[3+1], texCoord[6+1], texCoord[9+1]);
-	const tcu::Vec4		rq				= tcu::Vec4(texCoord[0+2], texCoord[3+2], texCoord[6+2], texCoord[9+2]);
+	const Texture1DArrayLookupVerifier	verifier	(result, reference, src, texCoord, sampleParams, lookupPrec, lodPrec);
 
-	const tcu::IVec2	dstSize			= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float			dstW			= float(dstSize.x());
-	const float			dstH			= float(dstSize.y());
-	const tcu::Vec2		srcSize			= tcu::IVec2(src.getWidth(), src.getHeight()).asFloat(); // For lod computation, thus #layers is ignored.
-
-	// Coordinates and lod per triangle.
-	const tcu::Vec3		triS[2]			= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triT[2]			= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triR[2]			= { rq.swizzle(0, 1, 2), rq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triW[2]			= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
-
-	const tcu::Vec2		lodBias			((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
-
-	int					numFailed		= 0;
+	return tcu::verifyPixelsTiled(verifier, errorMask, maxFailedPixels, watchDog);
+}
 
-	const tcu::Vec2 lodOffsets[] =
+class Texture2DArrayLookupVerifier : public TextureLookupVerifier
+{
+public:
+	Texture2DArrayLookupVerifier (const tcu::ConstPixelBufferAccess& result, const tcu::ConstPixelBufferAccess& reference, const tcu::Texture2DArrayView& src, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::LodPrecision& lodPrec)
+		: TextureLookupVerifier	(result, reference, sampleParams, lookupPrec, lodPrec)
+		, m_src					(src)
+		, m_srcSize				(tcu::IVec2(m_src.getWidth(), m_src.getHeight()).asFloat())
 	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-	};
+		const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[3+0], texCoord[6+0], texCoord[9+0]);
+		const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[3+1], texCoord[6+1], texCoord[9+1]);
+		const tcu::Vec4		rq				= tcu::Vec4(texCoord[0+2], texCoord[3+2], texCoord[6+2], texCoord[9+2]);
 
-	tcu::clear(errorMask, tcu::RGBA::green.toVec());
+		m_triS[0] = sq.swizzle(0, 1, 2);
+		m_triS[1] = sq.swizzle(3, 2, 1);
+		m_triT[0] = tq.swizzle(0, 1, 2);
+		m_triT[1] = tq.swizzle(3, 2, 1);
+		m_triR[0] = rq.swizzle(0, 1, 2);
+		m_triR[1] = rq.swizzle(3, 2, 1);
+	}
 
-	for (int py = 0; py < result.getHeight(); py++)
+protected:
+	bool isLookupValid (int px, int py, const tcu::Vec4& resPix) const
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
-
-		for (int px = 0; px < result.getWidth(); px++)
+		const tcu::Vec2 lodOffsets[] =
 		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
-
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
-
-				const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
-				const float		triWx	= triNdx ? dstW - wx : wx;
-				const float		triWy	= triNdx ? dstH - wy : wy;
-				const float		triNx	= triNdx ? 1.0f - nx : nx;
-				const float		triNy	= triNdx ? 1.0f - ny : ny;
+			tcu::Vec2(-1,  0),
+			tcu::Vec2(+1,  0),
+			tcu::Vec2( 0, -1),
+			tcu::Vec2( 0, +1),
+		};
 
-				const tcu::Vec3	coord		(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-											 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy),
-											 projectedTriInterpolate(triR[triNdx], triW[triNdx], triNx, triNy));
-				const tcu::Vec2	coordDx		= tcu::Vec2(triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy),
-														triDerivateX(triT[triNdx], triW[triNdx], wx, dstW, triNy)) * srcSize;
-				const tcu::Vec2	coordDy		= tcu::Vec2(triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx),
-														triDerivateY(triT[triNdx], triW[triNdx], wy, dstH, triNx)) * srcSize;
+		const float		wx		= (float)px + 0.5f;
+		const float		wy		= (float)py + 0.5f;
+		const float		nx		= wx / m_dstW;
+		const float		ny		= wy / m_dstH;
+
+		const int		triNdx	= nx + ny >= 1.0f ? 1 : 0;
+		const float		triWx	= triNdx ? m_dstW - wx : wx;
+		const float		triWy	= triNdx ? m_dstH - wy : wy;
+		const float		triNx	= triNdx ? 1.0f - nx : nx;
+		const float		triNy	= triNdx ? 1.0f - ny : ny;
+
+		const tcu::Vec3	coord		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+									 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy),
+									 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], triNx, triNy));
+		const tcu::Vec2	coordDx		= tcu::Vec2(triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+												triDerivateX(m_triT[triNdx], m_triW[triNdx], wx, m_dstW, triNy)) * m_srcSize;
+		const tcu::Vec2	coordDy		= tcu::Vec2(triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+												triDerivateY(m_triT[triNdx], m_triW[triNdx], wy, m_dstH, triNx)) * m_srcSize;
+
+		tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDy.x(), coordDy.y(), m_lodPrec);
+
+		// Compute lod bounds across lodOffsets range.
+		for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
+		{
+			const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
+			const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
+			const float		nxo		= wxo/m_dstW;
+			const float		nyo		= wyo/m_dstH;
+
+			const tcu::Vec3	coordO		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], nxo, nyo),
+										 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], nxo, nyo),
+										 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], nxo, nyo));
+			const tcu::Vec2	coordDxo	= tcu::Vec2(triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+													triDerivateX(m_triT[triNdx], m_triW[triNdx], wxo, m_dstW, nyo)) * m_srcSize;
+			const tcu::Vec2	coordDyo	= tcu::Vec2(triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+													triDerivateY(m_triT[triNdx], m_triW[triNdx], wyo, m_dstH, nxo)) * m_srcSize;
+			const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDyo.x(), coordDyo.y(), m_lodPrec);
+
+			lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+			lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+		}
 
-				tcu::Vec2		lodBounds	= tcu::computeLodBoundsFromDerivates(coordDx.x(), coordDx.y(), coordDy.x(), coordDy.y(), lodPrec);
+		const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+		const bool		isOk		= tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, coord, clampedLod, resPix);
 
-				// Compute lod bounds across lodOffsets range.
-				for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-				{
-					const float		wxo		= triWx + lodOffsets[lodOffsNdx].x();
-					const float		wyo		= triWy + lodOffsets[lodOffsNdx].y();
-					const float		nxo		= wxo/dstW;
-					const float		nyo		= wyo/dstH;
-
-					const tcu::Vec3	coordO		(projectedTriInterpolate(triS[triNdx], triW[triNdx], nxo, nyo),
-												 projectedTriInterpolate(triT[triNdx], triW[triNdx], nxo, nyo),
-												 projectedTriInterpolate(triR[triNdx], triW[triNdx], nxo, nyo));
-					const tcu::Vec2	coordDxo	= tcu::Vec2(triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo),
-															triDerivateX(triT[triNdx], triW[triNdx], wxo, dstW, nyo)) * srcSize;
-					const tcu::Vec2	coordDyo	= tcu::Vec2(triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo),
-															triDerivateY(triT[triNdx], triW[triNdx], wyo, dstH, nxo)) * srcSize;
-					const tcu::Vec2	lodO		= tcu::computeLodBoundsFromDerivates(coordDxo.x(), coordDxo.y(), coordDyo.x(), coordDyo.y(), lodPrec);
+		return isOk;
+	}
 
-					lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-					lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-				}
+private:
+	const tcu::Texture2DArrayView	m_src;
+	const tcu::Vec2					m_srcSize;	//!< For lod computation, thus #layers is ignored.
+	tcu::Vec3						m_triS[2];
+	tcu::Vec3						m_triT[2];
+	tcu::Vec3						m_triR[2];
+};
 
-				const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-				const bool		isOk		= tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coord, clampedLod, resPix);
+//! Verifies texture lookup results and returns number of failed pixels. Verification stops early once maxFailedPixels is reached.
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::Texture2DArrayView&		src,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::LodPrecision&				lodPrec,
+							  int									maxFailedPixels,
+							  qpWatchDog*							watchDog)
+{
+	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
+	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
-				}
-			}
-		}
-	}
+	const Texture2DArrayLookupVerifier	verifier	(result, reference, src, texCoord, sampleParams, lookupPrec, lodPrec);
 
-	return numFailed;
+	return tcu::verifyPixelsTiled(verifier, errorMask, maxFailedPixels, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
@@ -2546,10 +2563,10 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
 
 	sampleTexture(SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
-	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, testCtx.getWatchDog());
+	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, testCtx.getWatchDog());
 
 	if (numFailedPixels > 0)
-		log << TestLog::Message << "ERROR: Result verification failed, got " << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
+		log << TestLog::Message << "ERROR: Result verification failed, got " << (numFailedPixels >= MAX_VERIFY_FAILED_PIXELS ? "at least " : "") << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
 
 	log << TestLog::ImageSet("VerifyResult", "Verification result")
 		<< TestLog::Image("Rendered", "Rendered image", result);
@@ -2582,10 +2599,10 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
 
 	sampleTexture(SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
-	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, testCtx.getWatchDog());
+	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, lodPrec, MAX_VERIFY_FAILED_PIXELS, testCtx.getWatchDog());
 
 	if (numFailedPixels > 0)
-		log << TestLog::Message << "ERROR: Result verification failed, got " << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
+		log << TestLog::Message << "ERROR: Result verification failed, got " << (numFailedPixels >= MAX_VERIFY_FAILED_PIXELS ? "at least " : "") << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
 
 	log << TestLog::ImageSet("VerifyResult", "Verification result")
 		<< TestLog::Image("Rendered", "Rendered image", result);
@@ -2601,152 +2618,147 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	return numFailedPixels == 0;
 }
 
-//! Verifies texture lookup results and returns number of failed pixels.
-int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
-							  const tcu::ConstPixelBufferAccess&	reference,
-							  const tcu::PixelBufferAccess&			errorMask,
-							  const tcu::TextureCubeArrayView&		baseView,
-							  const float*							texCoord,
-							  const ReferenceParams&				sampleParams,
-							  const tcu::LookupPrecision&			lookupPrec,
-							  const tcu::IVec4&						coordBits,
-							  const tcu::LodPrecision&				lodPrec,
-							  qpWatchDog*							watchDog)
+class TextureCubeArrayLookupVerifier : public TextureLookupVerifier
 {
-	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
-	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
-
-	const tcu::TextureCubeArrayView	src	= getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel);
-
-	// What is the 'q' in all these names? Also a two char name for something that is in scope for ~120 lines and only used twice each seems excessive
-	const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[4+0], texCoord[8+0], texCoord[12+0]);
-	const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[4+1], texCoord[8+1], texCoord[12+1]);
-	const tcu::Vec4		rq				= tcu::Vec4(texCoord[0+2], texCoord[4+2], texCoord[8+2], texCoord[12+2]);
-	const tcu::Vec4		qq				= tcu::Vec4(texCoord[0+3], texCoord[4+3], texCoord[8+3], texCoord[12+3]);
-
-	const tcu::IVec2	dstSize			= tcu::IVec2(result.getWidth(), result.getHeight());
-	const float			dstW			= float(dstSize.x());
-	const float			dstH			= float(dstSize.y());
-	const int			srcSize			= src.getSize();
-
-	// Coordinates per triangle.
-	const tcu::Vec3		triS[2]			= { sq.swizzle(0, 1, 2), sq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triT[2]			= { tq.swizzle(0, 1, 2), tq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triR[2]			= { rq.swizzle(0, 1, 2), rq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triQ[2]			= { qq.swizzle(0, 1, 2), qq.swizzle(3, 2, 1) };
-	const tcu::Vec3		triW[2]			= { sampleParams.w.swizzle(0, 1, 2), sampleParams.w.swizzle(3, 2, 1) };
-
-	const tcu::Vec2		lodBias			((sampleParams.flags & ReferenceParams::USE_BIAS) ? sampleParams.bias : 0.0f);
-
-	const float			posEps			= 1.0f / float((1<<4) + 1); // ES3 requires at least 4 subpixel bits.
-
-	int					numFailed		= 0;
-
-	const tcu::Vec2 lodOffsets[] =
+public:
+	TextureCubeArrayLookupVerifier (const tcu::ConstPixelBufferAccess& result, const tcu::ConstPixelBufferAccess& reference, const tcu::TextureCubeArrayView& baseView, const float* texCoord, const ReferenceParams& sampleParams, const tcu::LookupPrecision& lookupPrec, const tcu::IVec4& coordBits, const tcu::LodPrecision& lodPrec)
+		: TextureLookupVerifier	(result, reference, sampleParams, lookupPrec, lodPrec)
+		, m_src					(getSubView(baseView, sampleParams.baseLevel, sampleParams.maxLevel))
+		, m_srcSize				(m_src.getSize())
+		, m_coordBits			(coordBits)
 	{
-		tcu::Vec2(-1,  0),
-		tcu::Vec2(+1,  0),
-		tcu::Vec2( 0, -1),
-		tcu::Vec2( 0, +1),
-
-		// \note Not strictly allowed by spec, but implementations do this in practice.
-		tcu::Vec2(-1, -1),
-		tcu::Vec2(-1, +1),
-		tcu::Vec2(+1, -1),
-		tcu::Vec2(+1, +1),
-	};
+		// What is the 'q' in all these names? Also a two char name for something that is in scope for ~120 lines and only used twice each seems excessive
+		const tcu::Vec4		sq				= tcu::Vec4(texCoord[0+0], texCoord[4+0], texCoord[8+0], texCoord[12+0]);
+		const tcu::Vec4		tq				= tcu::Vec4(texCoord[0+1], texCoord[4+1], texCoord[8+1], texCoord[12+1]);
+		const tcu::Vec4		rq				= tcu::Vec4(texCoord[0+2], texCoord[4+2], texCoord[8+2], texCoord[12+2]);
+		const tcu::Vec4		qq				= tcu::Vec4(texCoord[0+3], texCoord[4+3], texCoord[8+3], texCoord[12+3]);
 
-	tcu::clear(errorMask, tcu::RGBA::green.toVec());
+		m_triS[0] = sq.swizzle(0, 1, 2);
+		m_triS[1] = sq.swizzle(3, 2, 1);
+		m_triT[0] = tq.swizzle(0, 1, 2);
+		m_triT[1] = tq.swizzle(3, 2, 1);
+		m_triR[0] = rq.swizzle(0, 1, 2);
+		m_triR[1] = rq.swizzle(3, 2, 1);
+		m_triQ[0] = qq.swizzle(0, 1, 2);
+		m_triQ[1] = qq.swizzle(3, 2, 1);
+	}
 
-	for (int py = 0; py < result.getHeight(); py++)
+protected:
+	bool isLookupValid (int px, int py, const tcu::Vec4& resPix) const
 	{
-		// Ugly hack, validation can take way too long at the moment.
-		if (watchDog)
-			qpWatchDog_touch(watchDog);
+		const float			posEps			= 1.0f / float((1<<4) + 1); // ES3 requires at least 4 subpixel bits.
 
-		for (int px = 0; px < result.getWidth(); px++)
+		const tcu::Vec2 lodOffsets[] =
 		{
-			const tcu::Vec4	resPix	= (result.getPixel(px, py)		- sampleParams.colorBias) / sampleParams.colorScale;
-			const tcu::Vec4	refPix	= (reference.getPixel(px, py)	- sampleParams.colorBias) / sampleParams.colorScale;
+			tcu::Vec2(-1,  0),
+			tcu::Vec2(+1,  0),
+			tcu::Vec2( 0, -1),
+			tcu::Vec2( 0, +1),
+	
+			// \note Not strictly allowed by spec, but implementations do this in practice.
+			tcu::Vec2(-1, -1),
+			tcu::Vec2(-1, +1),
+			tcu::Vec2(+1, -1),
+			tcu::Vec2(+1, +1),
+		};
 
-			// Try comparison to ideal reference first, and if that fails use slower verificator.
-			if (!tcu::boolAll(tcu::lessThanEqual(tcu::abs(resPix - refPix), lookupPrec.colorThreshold)))
-			{
-				const float		wx		= (float)px + 0.5f;
-				const float		wy		= (float)py + 0.5f;
-				const float		nx		= wx / dstW;
-				const float		ny		= wy / dstH;
+		const float		wx		= (float)px + 0.5f;
+		const float		wy		= (float)py + 0.5f;
+		const float		nx		= wx / m_dstW;
+		const float		ny		= wy / m_dstH;
 
-				const bool		tri0	= nx + ny - posEps <= 1.0f;
-				const bool		tri1	= nx + ny + posEps >= 1.0f;
+		const bool		tri0	= nx + ny - posEps <= 1.0f;
+		const bool		tri1	= nx + ny + posEps >= 1.0f;
 
-				bool			isOk	= false;
+		bool			isOk	= false;
 
-				DE_ASSERT(tri0 || tri1);
+		DE_ASSERT(tri0 || tri1);
 
-				// Pixel can belong to either of the triangles if it lies close enough to the edge.
-				for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
-				{
-					const float		triWx		= triNdx ? dstW - wx : wx;
-					const float		triWy		= triNdx ? dstH - wy : wy;
-					const float		triNx		= triNdx ? 1.0f - nx : nx;
-					const float		triNy		= triNdx ? 1.0f - ny : ny;
-
-					const tcu::Vec4	coord		(projectedTriInterpolate(triS[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triT[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triR[triNdx], triW[triNdx], triNx, triNy),
-												 projectedTriInterpolate(triQ[triNdx], triW[triNdx], triNx, triNy));
-					const tcu::Vec3	coordDx		(triDerivateX(triS[triNdx], triW[triNdx], wx, dstW, triNy),
-												 triDerivateX(triT[triNdx], triW[triNdx], wx, dstW, triNy),
-												 triDerivateX(triR[triNdx], triW[triNdx], wx, dstW, triNy));
-					const tcu::Vec3	coordDy		(triDerivateY(triS[triNdx], triW[triNdx], wy, dstH, triNx),
-												 triDerivateY(triT[triNdx], triW[triNdx], wy, dstH, triNx),
-												 triDerivateY(triR[triNdx], triW[triNdx], wy, dstH, triNx));
-
-					tcu::Vec2		lodBounds	= tcu::computeCubeLodBoundsFromDerivates(coord.toWidth<3>(), coordDx, coordDy, srcSize, lodPrec);
-
-					// Compute lod bounds across lodOffsets range.
-					for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
-					{
-						const float		wxo			= triWx + lodOffsets[lodOffsNdx].x();
-						const float		wyo			= triWy + lodOffsets[lodOffsNdx].y();
-						const float		nxo			= wxo/dstW;
-						const float		nyo			= wyo/dstH;
-
-						const tcu::Vec3	coordO		(projectedTriInterpolate(triS[triNdx], triW[triNdx], nxo, nyo),
-													 projectedTriInterpolate(triT[triNdx], triW[triNdx], nxo, nyo),
-													 projectedTriInterpolate(triR[triNdx], triW[triNdx], nxo, nyo));
-						const tcu::Vec3	coordDxo	(triDerivateX(triS[triNdx], triW[triNdx], wxo, dstW, nyo),
-													 triDerivateX(triT[triNdx], triW[triNdx], wxo, dstW, nyo),
-													 triDerivateX(triR[triNdx], triW[triNdx], wxo, dstW, nyo));
-						const tcu::Vec3	coordDyo	(triDerivateY(triS[triNdx], triW[triNdx], wyo, dstH, nxo),
-													 triDerivateY(triT[triNdx], triW[triNdx], wyo, dstH, nxo),
-													 triDerivateY(triR[triNdx], triW[triNdx], wyo, dstH, nxo));
-						const tcu::Vec2	lodO		= tcu::computeCubeLodBoundsFromDerivates(coordO, coordDxo, coordDyo, srcSize, lodPrec);
-
-						lodBounds.x() = de::min(lodBounds.x(), lodO.x());
-						lodBounds.y() = de::max(lodBounds.y(), lodO.y());
-					}
-
-					const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + lodBias, tcu::Vec2(sampleParams.minLod, sampleParams.maxLod), lodPrec);
-
-					if (tcu::isLookupResultValid(src, sampleParams.sampler, lookupPrec, coordBits, coord, clampedLod, resPix))
-					{
-						isOk = true;
-						break;
-					}
-				}
+		// Pixel can belong to either of the triangles if it lies close enough to the edge.
+		for (int triNdx = (tri0?0:1); triNdx <= (tri1?1:0); triNdx++)
+		{
+			const float		triWx		= triNdx ? m_dstW - wx : wx;
+			const float		triWy		= triNdx ? m_dstH - wy : wy;
+			const float		triNx		= triNdx ? 1.0f - nx : nx;
+			const float		triNy		= triNdx ? 1.0f - ny : ny;
+
+			const tcu::Vec4	coord		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], triNx, triNy),
+										 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], triNx, triNy),
+										 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], triNx, triNy),
+										 projectedTriInterpolate(m_triQ[triNdx], m_triW[triNdx], triNx, triNy));
+			const tcu::Vec3	coordDx		(triDerivateX(m_triS[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+										 triDerivateX(m_triT[triNdx], m_triW[triNdx], wx, m_dstW, triNy),
+										 triDerivateX(m_triR[triNdx], m_triW[triNdx], wx, m_dstW, triNy));
+			const tcu::Vec3	coordDy		(triDerivateY(m_triS[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+										 triDerivateY(m_triT[triNdx], m_triW[triNdx], wy, m_dstH, triNx),
+										 triDerivateY(m_triR[triNdx], m_triW[triNdx], wy, m_dstH, triNx));
+
+			tcu::Vec2		lodBounds	= tcu::computeCubeLodBoundsFromDerivates(coord.toWidth<3>(), coordDx, coordDy, m_srcSize, m_lodPrec);
+
+			// Compute lod bounds across lodOffsets range.
+			for (int lodOffsNdx = 0; lodOffsNdx < DE_LENGTH_OF_ARRAY(lodOffsets); lodOffsNdx++)
+			{
+				const float		wxo			= triWx + lodOffsets[lodOffsNdx].x();
+				const float		wyo			= triWy + lodOffsets[lodOffsNdx].y();
+				const float		nxo			= wxo/m_dstW;
+				const float		nyo			= wyo/m_dstH;
+
+				const tcu::Vec3	coordO		(projectedTriInterpolate(m_triS[triNdx], m_triW[triNdx], nxo, nyo),
+											 projectedTriInterpolate(m_triT[triNdx], m_triW[triNdx], nxo, nyo),
+											 projectedTriInterpolate(m_triR[triNdx], m_triW[triNdx], nxo, nyo));
+				const tcu::Vec3	coordDxo	(triDerivateX(m_triS[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+											 triDerivateX(m_triT[triNdx], m_triW[triNdx], wxo, m_dstW, nyo),
+											 triDerivateX(m_triR[triNdx], m_triW[triNdx], wxo, m_dstW, nyo));
+				const tcu::Vec3	coordDyo	(triDerivateY(m_triS[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+											 triDerivateY(m_triT[triNdx], m_triW[triNdx], wyo, m_dstH, nxo),
+											 triDerivateY(m_triR[triNdx], m_triW[triNdx], wyo, m_dstH, nxo));
+				const tcu::Vec2	lodO		= tcu::computeCubeLodBoundsFromDerivates(coordO, coordDxo, coordDyo, m_srcSize, m_lodPrec);
+
+				lodBounds.x() = de::min(lodBounds.x(), lodO.x());
+				lodBounds.y() = de::max(lodBounds.y(), lodO.y());
+			}
 
-				if (!isOk)
-				{
-					errorMask.setPixel(tcu::RGBA::red.toVec(), px, py);
-					numFailed += 1;
-				}
+			const tcu::Vec2	clampedLod	= tcu::clampLodBounds(lodBounds + m_lodBias, tcu::Vec2(m_sampleParams.minLod, m_sampleParams.maxLod), m_lodPrec);
+
+			if (tcu::isLookupResultValid(m_src, m_sampleParams.sampler, m_lookupPrec, m_coordBits, coord, clampedLod, resPix))
+			{
+				isOk = true;
+				break;
 			}
 		}
+
+		return isOk;
 	}
 
-	return numFailed;
+private:
+	const tcu::TextureCubeArrayView	m_src;
+	const int						m_srcSize;
+	const tcu::IVec4				m_coordBits;
+	tcu::Vec3						m_triS[2];
+	tcu::Vec3						m_triT[2];
+	tcu::Vec3						m_triR[2];
+	tcu::Vec3						m_triQ[2];
+};
+
+//! Verifies texture lookup results and returns number of failed pixels. Verification stops early once maxFailedPixels is reached.
+int computeTextureLookupDiff (const tcu::ConstPixelBufferAccess&	result,
+							  const tcu::ConstPixelBufferAccess&	reference,
+							  const tcu::PixelBufferAccess&			errorMask,
+							  const tcu::TextureCubeArrayView&		baseView,
+							  const float*							texCoord,
+							  const ReferenceParams&				sampleParams,
+							  const tcu::LookupPrecision&			lookupPrec,
+							  const tcu::IVec4&						coordBits,
+							  const tcu::LodPrecision&				lodPrec,
+							  int									maxFailedPixels,
+							  qpWatchDog*							watchDog)
+{
+	DE_ASSERT(result.getWidth() == reference.getWidth() && result.getHeight() == reference.getHeight());
+	DE_ASSERT(result.getWidth() == errorMask.getWidth() && result.getHeight() == errorMask.getHeight());
+
+	const TextureCubeArrayLookupVerifier	verifier	(result, reference, baseView, texCoord, sampleParams, lookupPrec, coordBits, lodPrec);
+
+	return tcu::verifyPixelsTiled(verifier, errorMask, maxFailedPixels, watchDog);
 }
 
 bool verifyTextureResult (tcu::TestContext&						testCtx,
@@ -2767,10 +2779,10 @@ bool verifyTextureResult (tcu::TestContext&						testCtx,
 	DE_ASSERT(getCompareMask(pixelFormat) == lookupPrec.colorMask);
 
 	sampleTexture(SurfaceAccess(reference, pixelFormat), src, texCoord, sampleParams);
-	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, coordBits, lodPrec, testCtx.getWatchDog());
+	numFailedPixels = computeTextureLookupDiff(result, reference.getAccess(), errorMask.getAccess(), src, texCoord, sampleParams, lookupPrec, coordBits, lodPrec, MAX_VERIFY_FAILED_PIXELS, testCtx.getWatchDog());
 
 	if (numFailedPixels > 0)
-		log << TestLog::Message << "ERROR: Result verification failed, got " << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
+		log << TestLog::Message << "ERROR: Result verification failed, got " << (numFailedPixels >= MAX_VERIFY_FAILED_PIXELS ? "at least " : "") << numFailedPixels << " invalid pixels!" << TestLog::EndMessage;
 
 	log << TestLog::ImageSet("VerifyResult", "Verification result")
 		<< TestLog::Image("Rendered", "Rendered image", result);
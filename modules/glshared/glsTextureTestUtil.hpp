@@ -380,6 +380,11 @@ bool			compareImages				(tcu::TestLog& log, const char* name, const char* desc,
 bool			compareImages				(tcu::TestLog& log, const tcu::Surface& reference, const tcu::Surface& rendered, tcu::RGBA threshold);
 int				measureAccuracy				(tcu::TestLog& log, const tcu::Surface& reference, const tcu::Surface& rendered, int bestScoreDiff, int worstScoreDiff);
 
+enum
+{
+	MAX_VERIFY_FAILED_PIXELS	= 1024	//!< Failed-pixel budget for lookup verification, see tcu::verifyPixelsTiled().
+};
+
 int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
 											 const tcu::ConstPixelBufferAccess&	reference,
 											 const tcu::PixelBufferAccess&		errorMask,
@@ -388,6 +393,7 @@ int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
 											 const ReferenceParams&				sampleParams,
 											 const tcu::LookupPrecision&		lookupPrec,
 											 const tcu::LodPrecision&			lodPrec,
+											 int								maxFailedPixels,
 											 qpWatchDog*						watchDog);
 
 int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
@@ -398,6 +404,7 @@ int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
 											 const ReferenceParams&				sampleParams,
 											 const tcu::LookupPrecision&		lookupPrec,
 											 const tcu::LodPrecision&			lodPrec,
+											 int								maxFailedPixels,
 											 qpWatchDog*						watchDog);
 
 int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
@@ -408,6 +415,7 @@ int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
 											 const ReferenceParams&				sampleParams,
 											 const tcu::LookupPrecision&		lookupPrec,
 											 const tcu::LodPrecision&			lodPrec,
+											 int								maxFailedPixels,
 											 qpWatchDog*						watchDog);
 
 int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
@@ -418,6 +426,7 @@ int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
 											 const ReferenceParams&				sampleParams,
 											 const tcu::LookupPrecision&		lookupPrec,
 											 const tcu::LodPrecision&			lodPrec,
+											 int								maxFailedPixels,
 											 qpWatchDog*						watchDog);
 
 int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
@@ -428,6 +437,7 @@ int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
 											 const ReferenceParams&				sampleParams,
 											 const tcu::LookupPrecision&		lookupPrec,
 											 const tcu::LodPrecision&			lodPrec,
+											 int								maxFailedPixels,
 											 qpWatchDog*						watchDog);
 
 int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
@@ -438,6 +448,7 @@ int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
 											 const ReferenceParams&				sampleParams,
 											 const tcu::LookupPrecision&		lookupPrec,
 											 const tcu::LodPrecision&			lodPrec,
+											 int								maxFailedPixels,
 											 qpWatchDog*						watchDog);
 
 int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
@@ -449,6 +460,7 @@ int				computeTextureLookupDiff	(const tcu::ConstPixelBufferAccess&	result,
 											 const tcu::LookupPrecision&		lookupPrec,
 											 const tcu::IVec4&					coordBits,
 											 const tcu::LodPrecision&			lodPrec,
+											 int								maxFailedPixels,
 											 qpWatchDog*						watchDog);
 
 bool			verifyTextureResult			(tcu::TestContext&					testCtx,
@@ -783,6 +783,9 @@ public:
 	void										shadeVertices				(const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const;
 	void										shadeFragments				(rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const;
 
+	// Shaders only read uniforms and constant attribute info.
+	bool										isThreadSafe				(void) const { return true; }
+
 private:
 	static std::string							genVertexSource				(const glu::RenderContext& ctx, const std::vector<ContextArray*>& arrays);
 	static std::string							genFragmentSource			(const glu::RenderContext& ctx);
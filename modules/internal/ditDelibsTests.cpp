@@ -50,6 +50,7 @@
 #include "deCommandLine.hpp"
 #include "deArrayBuffer.hpp"
 #include "deStringUtil.hpp"
+#include "deWorkerPool.hpp"
 
 namespace dit
 {
@@ -127,6 +128,7 @@ public:
 		addChild(new SelfCheckCase(m_testCtx, "commandline",				"de::cmdline::selfTest()",				de::cmdline::selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "array_buffer",				"de::ArrayBuffer_selfTest()",			de::ArrayBuffer_selfTest));
 		addChild(new SelfCheckCase(m_testCtx, "string_util",				"de::StringUtil_selfTest()",			de::StringUtil_selfTest));
+		addChild(new SelfCheckCase(m_testCtx, "worker_pool",				"de::WorkerPool_selfTest()",			de::WorkerPool_selfTest));
 	}
 };
 
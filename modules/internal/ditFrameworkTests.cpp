@@ -25,6 +25,11 @@
 #include "tcuFloatFormat.hpp"
 #include "tcuTestLog.hpp"
 #include "tcuCommandLine.hpp"
+#include "tcuWorkerPool.hpp"
+#include "tcuTexture.hpp"
+#include "tcuCompressedTexture.hpp"
+#include "tcuTiledVerifier.hpp"
+#include "tcuImageCompare.hpp"
 
 namespace dit
 {
@@ -38,7 +43,7 @@ using tcu::TestLog;
 
 struct MatchCase
 {
-	enum Expected { NO_MATCH, MATCH_GROUP, MATCH_CASE, EXPECTED_LAST };
+	enum Expected { NO_MATCH, MATCH_GROUP, MATCH_CASE, MATCH_GROUP_AND_CASE, EXPECTED_LAST };
 
 	const char*	path;
 	Expected	expected;
@@ -50,7 +55,8 @@ const char* getMatchCaseExpectedDesc (MatchCase::Expected expected)
 	{
 		"no match",
 		"group to match",
-		"case to match"
+		"case to match",
+		"group and case to match"
 	};
 	return de::getSizedArrayElement<MatchCase::EXPECTED_LAST>(descs, expected);
 }
@@ -99,8 +105,8 @@ public:
 			matchGroup	= cmdLine.checkTestGroupName(curCase.path);
 			matchCase	= cmdLine.checkTestCaseName(curCase.path);
 
-			if ((matchGroup	== (curCase.expected == MatchCase::MATCH_GROUP)) &&
-				(matchCase	== (curCase.expected == MatchCase::MATCH_CASE)))
+			if ((matchGroup	== (curCase.expected == MatchCase::MATCH_GROUP || curCase.expected == MatchCase::MATCH_GROUP_AND_CASE)) &&
+				(matchCase	== (curCase.expected == MatchCase::MATCH_CASE || curCase.expected == MatchCase::MATCH_GROUP_AND_CASE)))
 			{
 				log << TestLog::Message << "   pass" << TestLog::EndMessage;
 				numPass += 1;
@@ -278,6 +284,24 @@ public:
 			};
 			addChild(new CaseListParserCase(m_testCtx, "trailing_crlf", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
 		}
+		{
+			static const char* const	caseList	= "{a{*_x,y*,z},b{*}}";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",			MatchCase::MATCH_GROUP	},
+				{ "a.b_x",		MatchCase::MATCH_CASE	},
+				{ "a._x",		MatchCase::MATCH_CASE	},
+				{ "a.x",		MatchCase::NO_MATCH		},
+				{ "a.yb",		MatchCase::MATCH_CASE	},
+				{ "a.z",		MatchCase::MATCH_CASE	},
+				{ "a.zz",		MatchCase::NO_MATCH		},
+				{ "a.y.b",		MatchCase::NO_MATCH		},
+				{ "b.c",		MatchCase::MATCH_CASE	},
+				{ "b.c.d",		MatchCase::NO_MATCH		},
+				{ "c.b_x",		MatchCase::NO_MATCH		},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "wildcard", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
+		}
 
 		// Negative tests
 		addChild(new NegativeCaseListCase(m_testCtx, "empty_string",			""));
@@ -520,6 +544,68 @@ public:
 			};
 			addChild(new CaseListParserCase(m_testCtx, "reparenting", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
 		}
+		{
+			static const char* const	caseList	=
+				"a.c0\na.c1\na.c2\na.c3\na.c4\na.c5\na.c6\na.c7\n"
+				"a.c8\na.c9\na.c10\na.c11\na.c12\na.c13\na.c14\na.c15\n"
+				"a.c16.d\n";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",				MatchCase::MATCH_GROUP	},
+				{ "a.c0",			MatchCase::MATCH_CASE	},
+				{ "a.c9",			MatchCase::MATCH_CASE	},
+				{ "a.c15",			MatchCase::MATCH_CASE	},
+				{ "a.c16",			MatchCase::MATCH_GROUP	},
+				{ "a.c16.d",		MatchCase::MATCH_CASE	},
+				{ "a.c17",			MatchCase::NO_MATCH		},
+				{ "a.c",			MatchCase::NO_MATCH		},
+				{ "a.c1.d",			MatchCase::NO_MATCH		},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "many_cases", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
+		}
+		{
+			static const char* const	caseList	=
+				"a.*.c\n"
+				"a.b.d\n"
+				"x.y*\n";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",				MatchCase::MATCH_GROUP	},
+				{ "a.b",			MatchCase::MATCH_GROUP	},
+				{ "a.e",			MatchCase::MATCH_GROUP	},
+				{ "a.b.c",			MatchCase::MATCH_CASE	},
+				{ "a.b.d",			MatchCase::MATCH_CASE	},
+				{ "a.e.c",			MatchCase::MATCH_CASE	},
+				{ "a.e.d",			MatchCase::NO_MATCH		},
+				{ "a.c",			MatchCase::MATCH_GROUP	},
+				{ "x.yz",			MatchCase::MATCH_CASE	},
+				{ "x.z",			MatchCase::NO_MATCH		},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "wildcard_component", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
+		}
+		{
+			// "**" matches zero or more components. Paths matching the pattern may
+			// also be groups, since "**" can consume further components below them.
+			// \note "b" itself matches "b.**" as a case, because "**" may be empty.
+			static const char* const	caseList	=
+				"a.**.c\n"
+				"b.**\n";
+			static const MatchCase		subCases[]	=
+			{
+				{ "a",				MatchCase::MATCH_GROUP			},
+				{ "a.b",			MatchCase::MATCH_GROUP			},
+				{ "a.b.d",			MatchCase::MATCH_GROUP			},
+				{ "a.c",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "a.x.c",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "a.x.y.c",		MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "b",				MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "b.x",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "b.x.y",			MatchCase::MATCH_GROUP_AND_CASE	},
+				{ "c",				MatchCase::NO_MATCH				},
+				{ "c.a.c",			MatchCase::NO_MATCH				},
+			};
+			addChild(new CaseListParserCase(m_testCtx, "wildcard_recursive", caseList, subCases, DE_LENGTH_OF_ARRAY(subCases)));
+		}
 
 		// Negative tests
 		addChild(new NegativeCaseListCase(m_testCtx, "empty_string",			""));
@@ -556,6 +642,18 @@ public:
 	{
 		addChild(new SelfCheckCase(m_testCtx, "float_format","tcu::FloatFormat_selfTest()",
 								   tcu::FloatFormat_selfTest));
+		addChild(new SelfCheckCase(m_testCtx, "shared_worker_pool","tcu::SharedWorkerPool_selfTest()",
+								   tcu::SharedWorkerPool_selfTest));
+		addChild(new SelfCheckCase(m_testCtx, "pixel_buffer_access","tcu::PixelBufferAccess_selfTest()",
+								   tcu::PixelBufferAccess_selfTest));
+		addChild(new SelfCheckCase(m_testCtx, "texture_batch_sampling","tcu::TextureBatchSampling_selfTest()",
+								   tcu::TextureBatchSampling_selfTest));
+		addChild(new SelfCheckCase(m_testCtx, "compressed_texture","tcu::CompressedTexture_selfTest()",
+								   tcu::CompressedTexture_selfTest));
+		addChild(new SelfCheckCase(m_testCtx, "tiled_verifier","tcu::TiledVerifier_selfTest()",
+								   tcu::TiledVerifier_selfTest));
+		addChild(new SelfCheckCase(m_testCtx, "image_compare","tcu::ImageCompare_selfTest()",
+								   tcu::ImageCompare_selfTest));
 		addChild(new CaseListParserTests(m_testCtx));
 	}
 };
@@ -30,7 +30,12 @@
 #include "tcuTestLog.hpp"
 #include "tcuTextureUtil.hpp"
 #include "tcuRGBA.hpp"
+#include "tcuWorkerPool.hpp"
+#include "deRandom.hpp"
+#include "deMemory.h"
+#include "deString.h"
 #include "deFilePath.hpp"
+#include "deStringUtil.hpp"
 #include "deClock.h"
 
 namespace dit
@@ -150,6 +155,109 @@ private:
 	const bool				m_expectedResult;
 };
 
+class FuzzyCompareThreadingCase : public tcu::TestCase
+{
+public:
+	enum Content
+	{
+		CONTENT_NOISY = 0,	//!< Smooth image and noisy copy of it
+		CONTENT_RANDOM,		//!< Two unrelated random images
+
+		CONTENT_LAST
+	};
+
+	enum
+	{
+		NUM_THREADS	= 4
+	};
+
+	FuzzyCompareThreadingCase (tcu::TestContext& testCtx, const char* name, tcu::TextureFormat::ChannelOrder order, int width, int height, Content content)
+		: tcu::TestCase	(testCtx, name, "")
+		, m_format		(order, tcu::TextureFormat::UNORM_INT8)
+		, m_width		(width)
+		, m_height		(height)
+		, m_content		(content)
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		tcu::TextureLevel		refImg			(m_format, m_width, m_height);
+		tcu::TextureLevel		cmpImg			(m_format, m_width, m_height);
+		tcu::TextureLevel		singleMask		(m_format, m_width, m_height);
+		tcu::TextureLevel		threadedMask	(m_format, m_width, m_height);
+		tcu::FuzzyCompareParams	params;
+		float					singleResult;
+		float					threadedResult;
+
+		generateImages(refImg.getAccess(), cmpImg.getAccess());
+
+		{
+			const tcu::ScopedMaxWorkerThreads maxThreads (1);
+			singleResult = tcu::fuzzyCompare(params, refImg, cmpImg, singleMask);
+		}
+
+		{
+			const tcu::ScopedMaxWorkerThreads maxThreads (NUM_THREADS);
+			threadedResult = tcu::fuzzyCompare(params, refImg, cmpImg, threadedMask);
+		}
+
+		m_testCtx.getLog() << TestLog::Float("Result", "Result metric with 1 worker", "", QP_KEY_TAG_NONE, singleResult)
+						   << TestLog::Float("ThreadedResult", "Result metric with multiple workers", "", QP_KEY_TAG_NONE, threadedResult);
+
+		{
+			// \note Compare bit patterns, metric is NaN if there are no inner pixels.
+			const bool	isResultOk	= deMemCmp(&singleResult, &threadedResult, sizeof(float)) == 0;
+			const bool	isMaskOk	= deMemCmp(singleMask.getAccess().getDataPtr(), threadedMask.getAccess().getDataPtr(), m_width*m_height*m_format.getPixelSize()) == 0;
+
+			if (!isMaskOk)
+				m_testCtx.getLog() << TestLog::Image("SingleMask", "Error mask with 1 worker", singleMask)
+								   << TestLog::Image("ThreadedMask", "Error mask with multiple workers", threadedMask);
+
+			m_testCtx.setTestResult(isResultOk && isMaskOk	? QP_TEST_RESULT_PASS	: QP_TEST_RESULT_FAIL,
+									!isResultOk				? "Result metric depends on number of workers"	:
+									!isMaskOk				? "Error mask depends on number of workers"		: "Pass");
+		}
+
+		return STOP;
+	}
+
+private:
+	void generateImages (const tcu::PixelBufferAccess& ref, const tcu::PixelBufferAccess& cmp) const
+	{
+		const int	numChannels	= m_format.getPixelSize();
+		de::Random	rnd			(deStringHash(getName()));
+
+		for (int y = 0; y < m_height; y++)
+		{
+			deUint8* const refRow = (deUint8*)ref.getDataPtr() + y*ref.getRowPitch();
+			deUint8* const cmpRow = (deUint8*)cmp.getDataPtr() + y*cmp.getRowPitch();
+
+			for (int x = 0; x < m_width; x++)
+			for (int c = 0; c < numChannels; c++)
+			{
+				if (m_content == CONTENT_NOISY)
+				{
+					const int value = (x*3 + y*5 + c*60) % 256;
+
+					refRow[x*numChannels + c] = (deUint8)value;
+					cmpRow[x*numChannels + c] = (deUint8)de::clamp(value + rnd.getInt(-12, 12), 0, 255);
+				}
+				else
+				{
+					refRow[x*numChannels + c] = rnd.getUint8();
+					cmpRow[x*numChannels + c] = rnd.getUint8();
+				}
+			}
+		}
+	}
+
+	const tcu::TextureFormat	m_format;
+	const int					m_width;
+	const int					m_height;
+	const Content				m_content;
+};
+
 class FuzzyComparisonMetricTests : public tcu::TestCaseGroup
 {
 public:
@@ -176,6 +284,60 @@ public:
 	}
 };
 
+class FuzzyCompareThreadingTests : public tcu::TestCaseGroup
+{
+public:
+	FuzzyCompareThreadingTests (tcu::TestContext& testCtx)
+		: tcu::TestCaseGroup(testCtx, "fuzzy_threading", "Fuzzy comparison gives same result with any number of workers")
+	{
+	}
+
+	void init (void)
+	{
+		static const struct
+		{
+			const char*							name;
+			tcu::TextureFormat::ChannelOrder	order;
+		} formats[] =
+		{
+			{ "rgb",	tcu::TextureFormat::RGB		},
+			{ "rgba",	tcu::TextureFormat::RGBA	}
+		};
+		static const struct
+		{
+			const char*							name;
+			FuzzyCompareThreadingCase::Content	content;
+		} contents[] =
+		{
+			{ "noisy",	FuzzyCompareThreadingCase::CONTENT_NOISY	},
+			{ "random",	FuzzyCompareThreadingCase::CONTENT_RANDOM	}
+		};
+		// \note Large sizes are split between workers, see MIN_PIXELS_PER_WORKER in tcuFuzzyImageCompare.cpp.
+		static const struct
+		{
+			int		width;
+			int		height;
+		} sizes[] =
+		{
+			{ 1,	1		},
+			{ 2,	3		},
+			{ 2,	33001	},
+			{ 13,	7		},
+			{ 257,	257		},
+			{ 389,	337		}
+		};
+
+		for (int formatNdx = 0; formatNdx < DE_LENGTH_OF_ARRAY(formats); formatNdx++)
+		for (int contentNdx = 0; contentNdx < DE_LENGTH_OF_ARRAY(contents); contentNdx++)
+		for (int sizeNdx = 0; sizeNdx < DE_LENGTH_OF_ARRAY(sizes); sizeNdx++)
+		{
+			const std::string name = std::string(formats[formatNdx].name) + "_" + contents[contentNdx].name + "_" + de::toString(sizes[sizeNdx].width) + "x" + de::toString(sizes[sizeNdx].height);
+
+			addChild(new FuzzyCompareThreadingCase(m_testCtx, name.c_str(), formats[formatNdx].order, sizes[sizeNdx].width, sizes[sizeNdx].height, contents[contentNdx].content));
+		}
+	}
+};
+
 class BilinearCompareTests : public tcu::TestCaseGroup
 {
 public:
@@ -225,6 +387,7 @@ ImageCompareTests::~ImageCompareTests (void)
 void ImageCompareTests::init (void)
 {
 	addChild(new FuzzyComparisonMetricTests	(m_testCtx));
+	addChild(new FuzzyCompareThreadingTests	(m_testCtx));
 	addChild(new BilinearCompareTests		(m_testCtx));
 }
 
@@ -0,0 +1,358 @@
+/*-------------------------------------------------------------------------
+ * drawElements Internal Test Module
+ * ---------------------------------
+ *
+ * Copyright 2014 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ *//*!
+ * \file
+ * \brief Reference renderer tests.
+ *//*--------------------------------------------------------------------*/
+
+#include "ditReferenceRendererTests.hpp"
+#include "rrRenderer.hpp"
+#include "rrFragmentOperations.hpp"
+#include "rrShadingContext.hpp"
+#include "rrVertexAttrib.hpp"
+#include "tcuTestLog.hpp"
+#include "tcuTexture.hpp"
+#include "tcuImageCompare.hpp"
+#include "tcuWorkerPool.hpp"
+#include "deRandom.hpp"
+#include "deStringUtil.hpp"
+#include "deMemory.h"
+
+#include <vector>
+
+namespace dit
+{
+
+using tcu::TestLog;
+using tcu::Vec4;
+using std::vector;
+
+enum
+{
+	RENDER_WIDTH	= 200,	//!< Not a multiple of tile size, so that partial tiles are covered.
+	RENDER_HEIGHT	= 150,
+	NUM_THREADS		= 4
+};
+
+class ColorShader : public rr::VertexShader, public rr::FragmentShader
+{
+public:
+	enum
+	{
+		ATTRIB_POSITION = 0,
+		ATTRIB_COLOR,
+		ATTRIB_OFFSET,
+
+		ATTRIB_LAST
+	};
+
+	ColorShader (void)
+		: rr::VertexShader		(ATTRIB_LAST, 1)
+		, rr::FragmentShader	(1, 1)
+	{
+		for (int attribNdx = 0; attribNdx < ATTRIB_LAST; attribNdx++)
+			this->rr::VertexShader::m_inputs[attribNdx].type = rr::GENERICVECTYPE_FLOAT;
+
+		this->rr::VertexShader::m_outputs[0].type		= rr::GENERICVECTYPE_FLOAT;
+		this->rr::FragmentShader::m_inputs[0].type		= rr::GENERICVECTYPE_FLOAT;
+		this->rr::FragmentShader::m_outputs[0].type		= rr::GENERICVECTYPE_FLOAT;
+	}
+
+	void shadeVertices (const rr::VertexAttrib* inputs, rr::VertexPacket* const* packets, const int numPackets) const
+	{
+		for (int packetNdx = 0; packetNdx < numPackets; ++packetNdx)
+		{
+			rr::VertexPacket& packet = *packets[packetNdx];
+
+			packet.position		= rr::readVertexAttribFloat(inputs[ATTRIB_POSITION], packet.instanceNdx, packet.vertexNdx)
+								+ rr::readVertexAttribFloat(inputs[ATTRIB_OFFSET], packet.instanceNdx, packet.vertexNdx);
+			packet.outputs[0]	= rr::readVertexAttribFloat(inputs[ATTRIB_COLOR], packet.instanceNdx, packet.vertexNdx);
+		}
+	}
+
+	void shadeFragments (rr::FragmentPacket* packets, const int numPackets, const rr::FragmentShadingContext& context) const
+	{
+		for (int packetNdx = 0; packetNdx < numPackets; ++packetNdx)
+		{
+			for (int fragNdx = 0; fragNdx < 4; ++fragNdx)
+				rr::writeFragmentOutput(context, packetNdx, fragNdx, 0, rr::readVarying<float>(packets[packetNdx], context, 0, fragNdx));
+		}
+	}
+};
+
+class Framebuffer
+{
+public:
+	Framebuffer (void)
+		: m_color	(tcu::TextureFormat(tcu::TextureFormat::RGBA, tcu::TextureFormat::UNORM_INT8), RENDER_WIDTH, RENDER_HEIGHT)
+		, m_depth	(tcu::TextureFormat(tcu::TextureFormat::D, tcu::TextureFormat::FLOAT), RENDER_WIDTH, RENDER_HEIGHT)
+	{
+		const rr::WindowRectangle rect (0, 0, RENDER_WIDTH, RENDER_HEIGHT);
+
+		rr::clearMultisampleColorBuffer(getColorBuffer().raw(), Vec4(0.0f, 0.0f, 0.0f, 1.0f), rect);
+		rr::clearMultisampleDepthBuffer(getDepthBuffer().raw(), 1.0f, rect);
+	}
+
+	rr::MultisamplePixelBufferAccess	getColorBuffer	(void)			{ return rr::MultisamplePixelBufferAccess::fromSinglesampleAccess(m_color.getAccess());	}
+	rr::MultisamplePixelBufferAccess	getDepthBuffer	(void)			{ return rr::MultisamplePixelBufferAccess::fromSinglesampleAccess(m_depth.getAccess());	}
+
+	const tcu::TextureLevel&			getColor		(void) const	{ return m_color;	}
+	const tcu::TextureLevel&			getDepth		(void) const	{ return m_depth;	}
+
+private:
+	tcu::TextureLevel					m_color;
+	tcu::TextureLevel					m_depth;
+};
+
+static rr::RenderState getRenderState (Framebuffer& framebuffer)
+{
+	rr::RenderState state ((rr::ViewportState)(framebuffer.getColorBuffer()));
+
+	state.fragOps.depthTestEnabled			= true;
+	state.fragOps.blendMode					= rr::BLENDMODE_STANDARD;
+	state.fragOps.blendRGBState.srcFunc		= rr::BLENDFUNC_SRC_ALPHA;
+	state.fragOps.blendRGBState.dstFunc		= rr::BLENDFUNC_ONE_MINUS_SRC_ALPHA;
+	state.fragOps.blendAState				= state.fragOps.blendRGBState;
+	state.point.pointSize					= 5.0f;
+
+	return state;
+}
+
+static bool compareFramebuffers (TestLog& log, const Framebuffer& reference, const Framebuffer& result)
+{
+	const int	depthSize	= RENDER_WIDTH*RENDER_HEIGHT*reference.getDepth().getFormat().getPixelSize();
+	const bool	colorOk		= tcu::intThresholdCompare(log, "Color", "Color buffer", reference.getColor(), result.getColor(), tcu::UVec4(0), tcu::COMPARE_LOG_ON_ERROR);
+	const bool	depthOk		= deMemCmp(reference.getDepth().getAccess().getDataPtr(), result.getDepth().getAccess().getDataPtr(), depthSize) == 0;
+
+	if (!depthOk)
+		log << TestLog::Message << "Depth buffers are not identical" << TestLog::EndMessage;
+
+	return colorOk && depthOk;
+}
+
+static void setAttribPointer (rr::VertexAttrib& attrib, const Vec4* data)
+{
+	attrib.type		= rr::VERTEXATTRIBTYPE_FLOAT;
+	attrib.size		= 4;
+	attrib.pointer	= data;
+}
+
+class MultithreadedDrawCase : public tcu::TestCase
+{
+public:
+	enum
+	{
+		NUM_TRIANGLES	= 60,
+		NUM_LINES		= 100,
+		NUM_POINTS		= 100
+	};
+
+	MultithreadedDrawCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "multithreaded_draw", "Compare multithreaded rendering to single-threaded")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const tcu::ScopedMaxWorkerThreads	maxThreads				(NUM_THREADS);	// Shared pool is used even on single-core machines.
+		const rr::Renderer					singleThreadedRenderer;
+		const rr::Renderer					multithreadedRenderer	(NUM_THREADS);
+		Framebuffer							reference;
+		Framebuffer							result;
+
+		render(singleThreadedRenderer, reference);
+		render(multithreadedRenderer, result);
+
+		if (compareFramebuffers(m_testCtx.getLog(), reference, result))
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Multithreaded rendering differs from single-threaded");
+
+		return STOP;
+	}
+
+private:
+	static void render (const rr::Renderer& renderer, Framebuffer& framebuffer)
+	{
+		const ColorShader		shader;
+		const rr::Program		program			(static_cast<const rr::VertexShader*>(&shader), static_cast<const rr::FragmentShader*>(&shader));
+		const rr::RenderTarget	renderTarget	(framebuffer.getColorBuffer(), framebuffer.getDepthBuffer());
+		const rr::RenderState	state			= getRenderState(framebuffer);
+		const int				numVertices		= NUM_TRIANGLES*3 + NUM_LINES*2 + NUM_POINTS;
+		de::Random				rnd				(0x1234);
+		vector<Vec4>			positions		(numVertices);
+		vector<Vec4>			colors			(numVertices);
+		rr::VertexAttrib		attribs			[ColorShader::ATTRIB_LAST];
+
+		// Vertices partially outside viewport and near planes exercise clipping.
+		for (int vtxNdx = 0; vtxNdx < numVertices; vtxNdx++)
+		{
+			positions[vtxNdx]	= Vec4(rnd.getFloat(-1.3f, 1.3f), rnd.getFloat(-1.3f, 1.3f), rnd.getFloat(-1.1f, 1.1f), 1.0f);
+			colors[vtxNdx]		= Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat(0.2f, 1.0f));
+		}
+
+		setAttribPointer(attribs[ColorShader::ATTRIB_POSITION], &positions[0]);
+		setAttribPointer(attribs[ColorShader::ATTRIB_COLOR], &colors[0]);
+		attribs[ColorShader::ATTRIB_OFFSET].type	= rr::VERTEXATTRIBTYPE_DONT_CARE;
+		attribs[ColorShader::ATTRIB_OFFSET].generic	= rr::GenericVec4(Vec4(0.0f));
+
+		renderer.draw(rr::DrawCommand(state, renderTarget, program, ColorShader::ATTRIB_LAST, &attribs[0], rr::PrimitiveList(rr::PRIMITIVETYPE_TRIANGLES, NUM_TRIANGLES*3, 0)));
+		renderer.draw(rr::DrawCommand(state, renderTarget, program, ColorShader::ATTRIB_LAST, &attribs[0], rr::PrimitiveList(rr::PRIMITIVETYPE_LINES, NUM_LINES*2, NUM_TRIANGLES*3)));
+		renderer.draw(rr::DrawCommand(state, renderTarget, program, ColorShader::ATTRIB_LAST, &attribs[0], rr::PrimitiveList(rr::PRIMITIVETYPE_POINTS, NUM_POINTS, NUM_TRIANGLES*3 + NUM_LINES*2)));
+	}
+};
+
+class VertexCacheCase : public tcu::TestCase
+{
+public:
+	enum
+	{
+		GRID_SIZE		= 24,	//!< Enough vertices to be shaded in several chunks.
+		NUM_INSTANCES	= 2
+	};
+
+	VertexCacheCase (tcu::TestContext& testCtx)
+		: tcu::TestCase(testCtx, "vertex_cache", "Compare indexed draws using vertex cache to non-indexed draws")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const tcu::ScopedMaxWorkerThreads	maxThreads			(NUM_THREADS);	// Shared pool is used even on single-core machines.
+		TestLog&							log					= m_testCtx.getLog();
+		const int							numThreads[]		= { 1, NUM_THREADS };
+		const rr::Renderer					referenceRenderer;
+		Framebuffer							reference;
+		bool								allOk				= true;
+
+		render(referenceRenderer, true, reference);
+
+		for (int threadNdx = 0; threadNdx < DE_LENGTH_OF_ARRAY(numThreads); threadNdx++)
+		{
+			const rr::Renderer renderer (numThreads[threadNdx]);
+
+			for (int indexed = 0; indexed < 2; indexed++)
+			{
+				const tcu::ScopedLogSection	section	(log, "Draw", std::string(indexed ? "Indexed" : "Non-indexed") + " draw with " + de::toString(numThreads[threadNdx]) + " thread(s)");
+				Framebuffer					result;
+
+				render(renderer, indexed != 0, result);
+
+				if (!compareFramebuffers(log, reference, result))
+					allOk = false;
+			}
+		}
+
+		if (allOk)
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Image comparison failed");
+
+		return STOP;
+	}
+
+private:
+	static void render (const rr::Renderer& renderer, bool indexed, Framebuffer& framebuffer)
+	{
+		const ColorShader		shader;
+		const rr::Program		program			(static_cast<const rr::VertexShader*>(&shader), static_cast<const rr::FragmentShader*>(&shader));
+		const rr::RenderTarget	renderTarget	(framebuffer.getColorBuffer(), framebuffer.getDepthBuffer());
+		const rr::RenderState	state			= getRenderState(framebuffer);
+		const Vec4				offsets[]		= { Vec4(0.0f), Vec4(0.3f, -0.2f, 0.1f, 0.0f) };
+		de::Random				rnd				(0x4321);
+		vector<Vec4>			positions		(GRID_SIZE*GRID_SIZE);
+		vector<Vec4>			colors			(GRID_SIZE*GRID_SIZE);
+		vector<deUint16>		indices;
+		rr::VertexAttrib		attribs			[ColorShader::ATTRIB_LAST];
+
+		DE_STATIC_ASSERT(DE_LENGTH_OF_ARRAY(offsets) == NUM_INSTANCES);
+
+		// Jittered grid with shared vertices
+		for (int y = 0; y < GRID_SIZE; y++)
+		for (int x = 0; x < GRID_SIZE; x++)
+		{
+			const float fx = (float)x / (float)(GRID_SIZE-1) * 2.0f - 1.0f;
+			const float fy = (float)y / (float)(GRID_SIZE-1) * 2.0f - 1.0f;
+
+			positions[y*GRID_SIZE + x]	= Vec4(fx + rnd.getFloat(-0.05f, 0.05f), fy + rnd.getFloat(-0.05f, 0.05f), rnd.getFloat(-0.9f, 0.9f), 1.0f);
+			colors[y*GRID_SIZE + x]		= Vec4(rnd.getFloat(), rnd.getFloat(), rnd.getFloat(), rnd.getFloat(0.2f, 1.0f));
+		}
+
+		for (int y = 0; y < GRID_SIZE-1; y++)
+		for (int x = 0; x < GRID_SIZE-1; x++)
+		{
+			const deUint16 v00 = (deUint16)(y*GRID_SIZE + x);
+			const deUint16 v10 = (deUint16)(v00 + 1);
+			const deUint16 v01 = (deUint16)(v00 + GRID_SIZE);
+			const deUint16 v11 = (deUint16)(v01 + 1);
+
+			indices.push_back(v00);
+			indices.push_back(v10);
+			indices.push_back(v01);
+			indices.push_back(v01);
+			indices.push_back(v10);
+			indices.push_back(v11);
+		}
+
+		setAttribPointer(attribs[ColorShader::ATTRIB_OFFSET], &offsets[0]);
+		attribs[ColorShader::ATTRIB_OFFSET].instanceDivisor = 1;
+
+		if (indexed)
+		{
+			setAttribPointer(attribs[ColorShader::ATTRIB_POSITION], &positions[0]);
+			setAttribPointer(attribs[ColorShader::ATTRIB_COLOR], &colors[0]);
+
+			renderer.drawInstanced(rr::DrawCommand(state, renderTarget, program, ColorShader::ATTRIB_LAST, &attribs[0], rr::PrimitiveList(rr::PRIMITIVETYPE_TRIANGLES, (int)indices.size(), rr::DrawIndices(&indices[0]))), NUM_INSTANCES);
+		}
+		else
+		{
+			// Same primitives with vertices expanded, so that nothing is shared.
+			vector<Vec4>	expandedPositions	(indices.size());
+			vector<Vec4>	expandedColors		(indices.size());
+
+			for (size_t ndx = 0; ndx < indices.size(); ndx++)
+			{
+				expandedPositions[ndx]	= positions[indices[ndx]];
+				expandedColors[ndx]		= colors[indices[ndx]];
+			}
+
+			setAttribPointer(attribs[ColorShader::ATTRIB_POSITION], &expandedPositions[0]);
+			setAttribPointer(attribs[ColorShader::ATTRIB_COLOR], &expandedColors[0]);
+
+			renderer.drawInstanced(rr::DrawCommand(state, renderTarget, program, ColorShader::ATTRIB_LAST, &attribs[0], rr::PrimitiveList(rr::PRIMITIVETYPE_TRIANGLES, (int)indices.size(), 0)), NUM_INSTANCES);
+		}
+	}
+};
+
+ReferenceRendererTests::ReferenceRendererTests (tcu::TestContext& testCtx)
+	: tcu::TestCaseGroup(testCtx, "reference_renderer", "Reference renderer tests")
+{
+}
+
+ReferenceRendererTests::~ReferenceRendererTests (void)
+{
+}
+
+void ReferenceRendererTests::init (void)
+{
+	addChild(new MultithreadedDrawCase	(m_testCtx));
+	addChild(new VertexCacheCase		(m_testCtx));
+}
+
+} // dit
@@ -23,8 +23,16 @@
 
 #include "ditTestLogTests.hpp"
 #include "tcuTestLog.hpp"
+#include "tcuCommandLine.hpp"
+#include "deRandom.hpp"
+#include "deStringUtil.hpp"
+#include "deFile.h"
 
 #include <limits>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
 
 namespace dit
 {
@@ -69,6 +77,202 @@ public:
 	}
 };
 
+static std::string readFile (const char* fileName)
+{
+	std::ifstream		in		(fileName, std::ios_base::binary);
+	std::ostringstream	data;
+
+	data << in.rdbuf();
+	return data.str();
+}
+
+// Returns values of given attribute in order of appearance.
+static std::vector<std::string> getAttributeValues (const std::string& str, const std::string& attribName)
+{
+	const std::string			prefix	= " " + attribName + "=\"";
+	std::vector<std::string>	values;
+
+	for (size_t pos = str.find(prefix); pos != std::string::npos; pos = str.find(prefix, pos+1))
+	{
+		const size_t begin = pos + prefix.size();
+		values.push_back(str.substr(begin, str.find('"', begin) - begin));
+	}
+
+	return values;
+}
+
+class AsyncOutputCase : public tcu::TestCase
+{
+public:
+	AsyncOutputCase (tcu::TestContext& testCtx)
+		: TestCase(testCtx, "async_output", "Asynchronous log writer produces same output as synchronous one")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const std::string	baseName	= std::string(m_testCtx.getCommandLine().getLogFileName()) + "." + getName();
+		const std::string	syncName	= baseName + ".sync.tmp";
+		const std::string	asyncName	= baseName + ".async.tmp";
+
+		writeLog(syncName.c_str(), 0);
+		writeLog(asyncName.c_str(), QP_TEST_LOG_ASYNC);
+
+		{
+			const std::string	syncData	= readFile(syncName.c_str());
+			const std::string	asyncData	= readFile(asyncName.c_str());
+
+			deDeleteFile(syncName.c_str());
+			deDeleteFile(asyncName.c_str());
+
+			m_testCtx.getLog() << TestLog::Message << "Synchronous log: " << syncData.size() << " bytes, asynchronous log: " << asyncData.size() << " bytes" << TestLog::EndMessage;
+
+			if (syncData.empty() || syncData != asyncData)
+				m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Logs differ");
+			else
+				m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		}
+
+		return STOP;
+	}
+
+private:
+	// Writes cases with all kinds of content, including images that are
+	// compressed and encoded on writer thread in asynchronous mode.
+	static void writeLog (const char* fileName, deUint32 flags)
+	{
+		TestLog					log			(fileName, flags);
+		de::Random				rnd			(0x3e91a7u);
+		const int				width		= 37;
+		const int				height		= 19;
+		const int				stride		= width*4 + 4;
+		std::vector<deUint8>	pixels		(stride*height);
+
+		for (int ndx = 0; ndx < (int)pixels.size(); ndx++)
+			pixels[ndx] = rnd.getUint8();
+
+		for (int caseNdx = 0; caseNdx < 4; caseNdx++)
+		{
+			log.startCase(("dE-IT.testlog.async_output.case" + de::toString(caseNdx)).c_str(), QP_TEST_CASE_TYPE_SELF_VALIDATE);
+
+			log << TestLog::Message << "Message " << caseNdx << TestLog::EndMessage;
+			log << TestLog::Section("Section", "Section with images");
+
+			log.startImageSet("Images", "Image set");
+			log.writeImage("PNG", "PNG image", QP_IMAGE_COMPRESSION_MODE_PNG, QP_IMAGE_FORMAT_RGBA8888, width, height, stride, &pixels[0]);
+			log.writeImage("Raw", "Uncompressed image", QP_IMAGE_COMPRESSION_MODE_NONE, QP_IMAGE_FORMAT_RGB888, width, height, stride, &pixels[0]);
+			log.writeImage("Duplicate", "Same image again", QP_IMAGE_COMPRESSION_MODE_PNG, QP_IMAGE_FORMAT_RGBA8888, width, height, stride, &pixels[0]);
+			log.endImageSet();
+
+			log << TestLog::EndSection;
+			log << TestLog::Float("Value", "Float value", "ms", QP_KEY_TAG_TIME, 1.5f*(float)caseNdx);
+
+			// \note Log can't be written after terminateCase().
+			if (caseNdx == 3)
+				log.terminateCase(QP_TEST_RESULT_CRASH);
+			else
+				log.endCase(QP_TEST_RESULT_PASS, "Pass");
+
+			// Next case gets different image data.
+			pixels[caseNdx] ^= 0xffu;
+		}
+	}
+};
+
+class ImageDeduplicationCase : public tcu::TestCase
+{
+public:
+	ImageDeduplicationCase (tcu::TestContext& testCtx)
+		: TestCase(testCtx, "image_deduplication", "Identical images are written once per test case")
+	{
+	}
+
+	IterateResult iterate (void)
+	{
+		const std::string	fileName	= std::string(m_testCtx.getCommandLine().getLogFileName()) + "." + getName() + ".tmp";
+		const deUint32		flags[]		= { QP_TEST_LOG_DEDUPLICATE_IMAGES, QP_TEST_LOG_DEDUPLICATE_IMAGES|QP_TEST_LOG_ASYNC };
+		bool				allOk		= true;
+
+		for (int flagNdx = 0; flagNdx < DE_LENGTH_OF_ARRAY(flags); flagNdx++)
+		{
+			writeLog(fileName.c_str(), flags[flagNdx]);
+
+			const std::string	data	= readFile(fileName.c_str());
+			const size_t		split	= data.find("#beginTestCaseResult", data.find("#beginTestCaseResult")+1);
+
+			deDeleteFile(fileName.c_str());
+
+			if (split == std::string::npos)
+			{
+				m_testCtx.getLog() << TestLog::Message << "ERROR: Second test case not found" << TestLog::EndMessage;
+				allOk = false;
+				continue;
+			}
+
+			// First case logs A, A, B and A: B differs from A only by one byte.
+			// Second case logs A again and must not refer to images of first case.
+			allOk = checkCase(data.substr(0, split), 2, 2) && allOk;
+			allOk = checkCase(data.substr(split), 1, 0) && allOk;
+		}
+
+		if (allOk)
+			m_testCtx.setTestResult(QP_TEST_RESULT_PASS, "Pass");
+		else
+			m_testCtx.setTestResult(QP_TEST_RESULT_FAIL, "Invalid deduplication");
+
+		return STOP;
+	}
+
+private:
+	bool checkCase (const std::string& caseData, int numExpectedWritten, int numExpectedDuplicates)
+	{
+		const std::vector<std::string>	hashes		= getAttributeValues(caseData, "ContentHash");
+		const std::vector<std::string>	duplicates	= getAttributeValues(caseData, "DuplicateOf");
+		bool							isOk		= (int)hashes.size() == numExpectedWritten && (int)duplicates.size() == numExpectedDuplicates;
+
+		// Duplicates may only refer to images written in the same case.
+		for (int ndx = 0; ndx < (int)duplicates.size(); ndx++)
+		{
+			if (std::find(hashes.begin(), hashes.end(), duplicates[ndx]) == hashes.end())
+				isOk = false;
+		}
+
+		if (!isOk)
+			m_testCtx.getLog() << TestLog::Message << "ERROR: Expected " << numExpectedWritten << " written and " << numExpectedDuplicates << " duplicate images, got "
+												   << hashes.size() << " and " << duplicates.size() << TestLog::EndMessage;
+
+		return isOk;
+	}
+
+	static void writeLog (const char* fileName, deUint32 flags)
+	{
+		TestLog					log			(fileName, flags);
+		de::Random				rnd			(0x81f3c2u);
+		const int				width		= 16;
+		const int				height		= 11;
+		const int				stride		= width*4;
+		std::vector<deUint8>	imageA		(stride*height);
+		std::vector<deUint8>	imageB;
+
+		for (int ndx = 0; ndx < (int)imageA.size(); ndx++)
+			imageA[ndx] = rnd.getUint8();
+
+		imageB = imageA;
+		imageB[stride*height/2] ^= 0x01u;
+
+		log.startCase("dE-IT.testlog.image_deduplication.case0", QP_TEST_CASE_TYPE_SELF_VALIDATE);
+		log.writeImage("A", "Image A", QP_IMAGE_COMPRESSION_MODE_PNG, QP_IMAGE_FORMAT_RGBA8888, width, height, stride, &imageA[0]);
+		log.writeImage("A2", "Image A again", QP_IMAGE_COMPRESSION_MODE_NONE, QP_IMAGE_FORMAT_RGBA8888, width, height, stride, &imageA[0]);
+		log.writeImage("B", "Image B", QP_IMAGE_COMPRESSION_MODE_PNG, QP_IMAGE_FORMAT_RGBA8888, width, height, stride, &imageB[0]);
+		log.writeImage("A3", "Image A again", QP_IMAGE_COMPRESSION_MODE_PNG, QP_IMAGE_FORMAT_RGBA8888, width, height, stride, &imageA[0]);
+		log.endCase(QP_TEST_RESULT_PASS, "Pass");
+
+		log.startCase("dE-IT.testlog.image_deduplication.case1", QP_TEST_CASE_TYPE_SELF_VALIDATE);
+		log.writeImage("A", "Image A in next case", QP_IMAGE_COMPRESSION_MODE_PNG, QP_IMAGE_FORMAT_RGBA8888, width, height, stride, &imageA[0]);
+		log.endCase(QP_TEST_RESULT_PASS, "Pass");
+	}
+};
+
 TestLogTests::TestLogTests (tcu::TestContext& testCtx)
 	: TestCaseGroup(testCtx, "testlog", "Test Log Tests")
 {
@@ -81,6 +285,8 @@ TestLogTests::~TestLogTests (void)
 void TestLogTests::init (void)
 {
 	addChild(new BasicSampleListCase(m_testCtx));
+	addChild(new AsyncOutputCase(m_testCtx));
+	addChild(new ImageDeduplicationCase(m_testCtx));
 }
 
 } // dit
@@ -27,11 +27,37 @@
 #include "ditFrameworkTests.hpp"
 #include "ditImageIOTests.hpp"
 #include "ditImageCompareTests.hpp"
+#include "ditReferenceRendererTests.hpp"
 #include "ditTestLogTests.hpp"
+#include "ditTestCase.hpp"
+
+#if defined(DEQP_SUPPORT_GLES2) || defined(DEQP_SUPPORT_GLES3)
+#	include "glsShaderLibrary.hpp"
+#	include "glsShaderLibraryCache.hpp"
+#endif
 
 namespace dit
 {
 
+#if defined(DEQP_SUPPORT_GLES2) || defined(DEQP_SUPPORT_GLES3)
+
+class ShaderLibraryTests : public tcu::TestCaseGroup
+{
+public:
+	ShaderLibraryTests (tcu::TestContext& testCtx)
+		: tcu::TestCaseGroup(testCtx, "shader_library", "Shader library tests")
+	{
+	}
+
+	void init (void)
+	{
+		addChild(new SelfCheckCase(m_testCtx, "cache_file",		"deqp::gls::sl::LibraryData_selfTest()",	deqp::gls::sl::LibraryData_selfTest));
+		addChild(new SelfCheckCase(m_testCtx, "cold_warm_cache",	"deqp::gls::ShaderLibrary_selfTest()",		deqp::gls::ShaderLibrary_selfTest));
+	}
+};
+
+#endif
+
 class DeqpTests : public tcu::TestCaseGroup
 {
 public:
@@ -42,9 +68,13 @@ public:
 
 	void init (void)
 	{
-		addChild(new TestLogTests		(m_testCtx));
-		addChild(new ImageIOTests		(m_testCtx));
-		addChild(new ImageCompareTests	(m_testCtx));
+		addChild(new TestLogTests			(m_testCtx));
+		addChild(new ImageIOTests			(m_testCtx));
+		addChild(new ImageCompareTests		(m_testCtx));
+		addChild(new ReferenceRendererTests	(m_testCtx));
+#if defined(DEQP_SUPPORT_GLES2) || defined(DEQP_SUPPORT_GLES3)
+		addChild(new ShaderLibraryTests		(m_testCtx));
+#endif
 	}
 };
 